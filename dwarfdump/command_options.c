@@ -395,6 +395,7 @@ static void arg_search_any(void);
 static void arg_search_any_count(void);
 static void arg_search_match(void);
 static void arg_search_match_count(void);
+static void arg_search_index(void);
 #ifdef HAVE_REGEX
 static void arg_search_regex(void);
 static void arg_search_regex_count(void);
@@ -483,6 +484,10 @@ static const char *usage_long_text[] = {
 "     --print-str-offsets Print the .debug_str_offsets section",
 "-y   --print-type        Print pubtypes section",
 "-w   --print-weakname    Print weakname section",
+"     --perf-stats        Print libdwarf work counters",
+"                         (sections loaded, allocations,",
+"                         abbrevs decoded, ...) after the",
+"                         other output",
 " ",
 "----------------------------------------------------------------------",
 "Print Relocations Info",
@@ -638,6 +643,10 @@ static const char *usage_long_text[] = {
 "-Svany=<text>    --search-any-count=<text> print number of occurrences",
 "-S match=<text>  --search-match=<text>     Search matching <text>",
 "-Svmatch=<text>  --search-match-count<text> print number of occurrences",
+"                 --search-index            With match= read only the DIEs",
+"                                           .debug_names, .gdb_index or",
+"                                           .debug_pubnames list. Faster,",
+"                                           but misses unindexed names",
 #ifdef HAVE_REGEX
 "-S regex=<text>  --search-regex=<text>     Use regular expression",
 "                                           matching",
@@ -792,6 +801,7 @@ enum longopts_vals {
   OPT_SEARCH_ANY_COUNT,         /* -Svany=<text>   --search-any-count=<text> */
   OPT_SEARCH_MATCH,             /* -S match=<text> --search-match=<text>     */
   OPT_SEARCH_MATCH_COUNT,       /* -Svmatch=<text> --search-match-count<text>*/
+  OPT_SEARCH_INDEX,             /* --search-index                            */
   OPT_SEARCH_PRINT_CHILDREN,    /* -Wc --search-print-children               */
   OPT_SEARCH_PRINT_PARENT,      /* -Wp --search-print-parent                 */
   OPT_SEARCH_PRINT_TREE,        /* -W  --search-print-tree                   */
@@ -812,6 +822,7 @@ enum longopts_vals {
   /* allocation statistics */
   OPT_ALLOC_PRINT_SUMS,         /* --print-alloc-sums */
   OPT_ALLOC_TREE_OFF,           /* --suppress-de-alloc-tree */
+  OPT_PERF_STATS,               /* --perf-stats */
 
   OPT_END
 };
@@ -944,6 +955,7 @@ static struct dwoption longopts[] =  {
   {"search-any-count",      dwrequired_argument, 0, OPT_SEARCH_ANY_COUNT     },
   {"search-match",          dwrequired_argument, 0, OPT_SEARCH_MATCH         },
   {"search-match-count",    dwrequired_argument, 0, OPT_SEARCH_MATCH_COUNT   },
+  {"search-index",          dwno_argument,       0, OPT_SEARCH_INDEX         },
   {"search-print-children", dwno_argument,       0, OPT_SEARCH_PRINT_CHILDREN},
   {"search-print-parent",   dwno_argument,       0, OPT_SEARCH_PRINT_PARENT  },
   {"search-print-tree",     dwno_argument,       0, OPT_SEARCH_PRINT_TREE    },
@@ -964,6 +976,7 @@ static struct dwoption longopts[] =  {
   /* alloc sums. */
   {"print-alloc-sums", dwno_argument, 0, OPT_ALLOC_PRINT_SUMS},
   {"suppress-de-alloc-tree",dwno_argument,0,OPT_ALLOC_TREE_OFF},
+  {"perf-stats",       dwno_argument, 0, OPT_PERF_STATS},
 
   {0,0,0,0}
 };
@@ -1986,6 +1999,12 @@ void arg_search_match_count(void)
     arg_search_match();
 }
 
+/*  Option '--search-index' */
+void arg_search_index(void)
+{
+    glflags.gf_search_use_index = TRUE;
+}
+
 #ifdef HAVE_REGEX
 /*  Option '-S regex=' */
 void arg_search_regex(void)
@@ -2496,6 +2515,7 @@ set_command_options(int argc, char *argv[])
         case OPT_SEARCH_ANY_COUNT:      arg_search_any_count();      break;
         case OPT_SEARCH_MATCH:          arg_search_match();          break;
         case OPT_SEARCH_MATCH_COUNT:    arg_search_match_count();    break;
+        case OPT_SEARCH_INDEX:          arg_search_index();          break;
         case OPT_SEARCH_PRINT_CHILDREN: arg_search_print_children(); break;
         case OPT_SEARCH_PRINT_PARENT:   arg_search_print_parent();   break;
         case OPT_SEARCH_PRINT_TREE:     arg_search_print_tree();     break;
@@ -2521,6 +2541,9 @@ set_command_options(int argc, char *argv[])
                 record keeping. */
             dwarf_set_de_alloc_flag(FALSE);
             break;
+        case OPT_PERF_STATS:
+            glflags.gf_print_perf_stats = TRUE;
+            break;
 
         default: arg_usage_error = TRUE; break;
         }
@@ -124,6 +124,7 @@ static int process_one_file(int fd, int tiedfd,
     struct dwconf_s *conf);
 
 static int print_gnu_debuglink(Dwarf_Debug dbg,Dwarf_Error *err);
+static void print_perf_stats(Dwarf_Debug dbg);
 
 static int
 open_a_file(const char * name)
@@ -1597,6 +1598,9 @@ process_one_file(int fd, int tiedfd,
             dwarf_errmsg_by_number(
             glflags.gf_error_code_in_name_search_by_address));
     }
+    if (glflags.gf_print_perf_stats) {
+        print_perf_stats(dbg);
+    }
 
     /*  Could finish dbg first. Either order ok. */
     if (dbgtied) {
@@ -1628,6 +1632,92 @@ process_one_file(int fd, int tiedfd,
     return 0;
 }
 
+/*  Reports the per-dbg libdwarf counters (--perf-stats)
+    so one can tell whether a run spent its time
+    reading sections or parsing them. */
+static void
+print_perf_stats(Dwarf_Debug dbg)
+{
+    Dwarf_Perf_Counters pc;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    memset(&pc,0,sizeof(pc));
+    pc.pc_size = sizeof(pc);
+    res = dwarf_get_perf_counters(dbg,&pc,&err);
+    if (res != DW_DLV_OK) {
+        print_error_and_continue(dbg,
+            "dwarf_get_perf_counters failed", res, err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        return;
+    }
+    printf("\nlibdwarf performance counters\n");
+    printf("  sections loaded       %10" DW_PR_DUu "\n",
+        pc.pc_sections_loaded);
+    printf("  section bytes loaded  %10" DW_PR_DUu "\n",
+        pc.pc_section_bytes_loaded);
+    printf("  bytes decompressed    %10" DW_PR_DUu "\n",
+        pc.pc_section_bytes_decompressed);
+    printf("  abbrevs decoded       %10" DW_PR_DUu "\n",
+        pc.pc_abbrev_decodes);
+    printf("  abbrev lookups hit    %10" DW_PR_DUu "\n",
+        pc.pc_abbrev_hits);
+    printf("  CU contexts created   %10" DW_PR_DUu "\n",
+        pc.pc_cu_contexts_created);
+    printf("  line programs decoded %10" DW_PR_DUu "\n",
+        pc.pc_line_programs_decoded);
+    printf("  CIEs parsed           %10" DW_PR_DUu "\n",
+        pc.pc_cie_parses);
+    printf("  FDEs parsed           %10" DW_PR_DUu "\n",
+        pc.pc_fde_parses);
+    printf("  tsearch operations    %10" DW_PR_DUu "\n",
+        pc.pc_tsearch_ops);
+    printf("  allocations           %10" DW_PR_DUu "\n",
+        pc.pc_allocs_total);
+    for (i = 0; ; ++i) {
+        Dwarf_Unsigned count = 0;
+
+        res = dwarf_get_perf_alloc_count(dbg,i,&count,&err);
+        if (res == DW_DLV_ERROR) {
+            DROP_ERROR_INSTANCE(dbg,res,err);
+            break;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (count) {
+            printf("    DW_DLA 0x%02" DW_PR_DUx "        %10"
+                DW_PR_DUu "\n",
+                i, count);
+        }
+    }
+    printf("  per section            loads      bytes"
+        "  decompressed\n");
+    for (i = 0; ; ++i) {
+        const char *name = 0;
+        Dwarf_Unsigned loads = 0;
+        Dwarf_Unsigned bytes = 0;
+        Dwarf_Unsigned decomp = 0;
+
+        res = dwarf_get_section_perf_counters(dbg,i,&name,
+            &loads,&bytes,&decomp,&err);
+        if (res == DW_DLV_ERROR) {
+            DROP_ERROR_INSTANCE(dbg,res,err);
+            break;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (!loads) {
+            continue;
+        }
+        printf("    %-20s %5" DW_PR_DUu " %10" DW_PR_DUu
+            " %12" DW_PR_DUu "\n",
+            sanitized(name),loads,bytes,decomp);
+    }
+}
+
 /* Generic constants for debugging */
 #define DUMP_RANGES_INFO            1   /* Dump RangesInfo Table. */
 #define DUMP_LOCATION_SECTION_INFO  2   /* Dump Location (.debug_loc) Info. */
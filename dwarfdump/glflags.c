@@ -173,6 +173,7 @@ init_global_flags(void)
     /* -S option: strings for 'any' and 'match' */
     glflags.gf_search_is_on         = FALSE;
     glflags.gf_search_print_results = FALSE;
+    glflags.gf_search_use_index     = FALSE;
     glflags.gf_cu_name_flag         = FALSE;
     glflags.gf_show_global_offsets  = FALSE;
     glflags.gf_display_offsets      = TRUE;
@@ -292,6 +293,7 @@ init_global_flags(void)
     glflags.check_error = 0;
 
     glflags.gf_print_alloc_sums = 0;
+    glflags.gf_print_perf_stats = FALSE;
 }
 
 void
@@ -229,6 +229,12 @@ struct glflags_s {
     boolean gf_search_is_on;
 
     boolean gf_search_print_results;
+
+    /*  --search-index: -S match= consults .debug_names,
+        .gdb_index or .debug_pubnames to find the candidate
+        DIEs instead of walking every DIE.  Off by default
+        as unindexed names are then not found. */
+    boolean gf_search_use_index;
     boolean gf_cu_name_flag;
     boolean gf_show_global_offsets;
     boolean gf_display_offsets;
@@ -357,6 +363,8 @@ struct glflags_s {
     int check_error;
 
     int gf_print_alloc_sums;
+    /*  --perf-stats */
+    boolean gf_print_perf_stats;
 };
 
 extern struct glflags_s glflags;
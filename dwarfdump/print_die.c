@@ -45,6 +45,7 @@
 #include "macrocheck.h"
 #include "helpertree.h"
 #include "tag_common.h"
+#include "search_index.h"
 
 /*  Traverse a DIE and attributes to
     check self references */
@@ -73,6 +74,7 @@ static int print_die_and_children_internal(Dwarf_Debug dbg,
     Dwarf_Error *);
 static int print_one_die_section(Dwarf_Debug dbg,
     Dwarf_Bool is_info,
+    struct search_index_s *sindex,
     Dwarf_Error *pod_err);
 static int handle_rnglists(Dwarf_Die die,
     Dwarf_Attribute attrib,
@@ -456,7 +458,22 @@ print_infos(Dwarf_Debug dbg,Dwarf_Bool is_info,
     Dwarf_Error *pi_err)
 {
     int nres = 0;
-    nres = print_one_die_section(dbg,is_info,pi_err);
+    struct search_index_s sindex;
+    struct search_index_s *sip = 0;
+
+    /*  With --search-index an exact -S match= uses a
+        name accelerator to visit only the DIEs that
+        might match. */
+    if (glflags.gf_search_is_on && search_index_applies(is_info)) {
+        if (search_index_build(dbg,glflags.search_match_text,
+            &sindex) == DW_DLV_OK) {
+            sip = &sindex;
+        }
+    }
+    nres = print_one_die_section(dbg,is_info,sip,pi_err);
+    if (sip) {
+        search_index_destructor(sip);
+    }
     return nres;
 }
 
@@ -744,9 +761,170 @@ macro_check_cu(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-/*   */
+/*  A full walk takes the Low PC and High PC that
+    PRINT_CU_INFO() shows from the first DIE of the CU
+    with a non-zero DW_AT_low_pc (and a DW_FORM_addr
+    DW_AT_high_pc), see print_hipc_lopc_attr.c.
+    An indexed search does not visit the DIEs before a
+    candidate, so read those addresses here from the
+    DIEs at or after start_offset and before
+    stop_offset.  Returns TRUE once the walk is done. */
+static boolean
+note_cu_addresses(Dwarf_Debug dbg, Dwarf_Die in_die,
+    Dwarf_Off start_offset, Dwarf_Off stop_offset)
+{
+    Dwarf_Die die = in_die;
+    Dwarf_Error err = 0;
+    boolean done = FALSE;
+
+    while (!done) {
+        Dwarf_Off offset = 0;
+        Dwarf_Die child = 0;
+        Dwarf_Die sibling = 0;
+        int res = 0;
+
+        res = dwarf_dieoffset(die,&offset,&err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        if (res != DW_DLV_OK || offset >= stop_offset) {
+            done = TRUE;
+            break;
+        }
+        if (offset >= start_offset) {
+            Dwarf_Addr addr = 0;
+            Dwarf_Half form = 0;
+            enum Dwarf_Form_Class formclass = DW_FORM_CLASS_UNKNOWN;
+
+            res = dwarf_lowpc(die,&addr,&err);
+            DROP_ERROR_INSTANCE(dbg,res,err);
+            if (res == DW_DLV_OK) {
+                glflags.need_CU_base_address = FALSE;
+                glflags.CU_low_address = addr;
+            }
+            res = dwarf_highpc_b(die,&addr,&form,&formclass,&err);
+            DROP_ERROR_INSTANCE(dbg,res,err);
+            if (res == DW_DLV_OK && glflags.need_CU_high_address &&
+                formclass == DW_FORM_CLASS_ADDRESS) {
+                glflags.need_CU_high_address = FALSE;
+                glflags.CU_high_address = addr;
+            }
+            if (glflags.CU_low_address) {
+                done = TRUE;
+                break;
+            }
+        }
+        res = dwarf_child(die,&child,&err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        if (res == DW_DLV_OK) {
+            done = note_cu_addresses(dbg,child,
+                start_offset,stop_offset);
+            dwarf_dealloc_die(child);
+            if (done) {
+                break;
+            }
+        }
+        res = dwarf_siblingof_b(dbg,die,TRUE,&sibling,&err);
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        if (die != in_die) {
+            dwarf_dealloc_die(die);
+        }
+        if (res != DW_DLV_OK) {
+            return FALSE;
+        }
+        die = sibling;
+    }
+    if (die != in_die) {
+        dwarf_dealloc_die(die);
+    }
+    return done;
+}
+
+/*  For an indexed -S match= search.  Search the CU die,
+    which records the CU name etc for PRINT_CU_INFO(),
+    then each candidate DIE the accelerator named.
+    Nothing is printed unless an attribute matches. */
+static int
+print_search_candidates(Dwarf_Debug dbg,
+    Dwarf_Die cu_die,
+    Dwarf_Off dieprint_cu_goffset,
+    Dwarf_Unsigned next_cu_goffset,
+    struct search_index_cand_s *cands,
+    Dwarf_Unsigned cand_count,
+    char **srcfiles, Dwarf_Signed cnt,
+    Dwarf_Error *err)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Off noted_offset = 0;
+    boolean attribute_matched = FALSE;
+    boolean ignore_die_stack = TRUE;
+    int res = 0;
+
+    local_symbols_already_began = FALSE;
+    SET_DIE_STACK_ENTRY(0,cu_die,dieprint_cu_goffset);
+    res = print_one_die(dbg,cu_die,dieprint_cu_goffset,
+        FALSE,0,srcfiles,cnt,&attribute_matched,
+        ignore_die_stack,err);
+    if (res != DW_DLV_OK) {
+        EMPTY_DIE_STACK_ENTRY(0);
+        return res;
+    }
+    for (i = 0; i < cand_count; ++i) {
+        Dwarf_Unsigned doff = cands[i].sc_die_offset;
+        Dwarf_Die die = 0;
+
+        if (doff <= dieprint_cu_goffset ||
+            doff >= next_cu_goffset) {
+            /*  The CU die, searched above, or not
+                in this CU (a bad index). */
+            continue;
+        }
+        if (!glflags.CU_low_address && doff > noted_offset) {
+            Dwarf_Die child = 0;
+            Dwarf_Error cerr = 0;
+
+            res = dwarf_child(cu_die,&child,&cerr);
+            DROP_ERROR_INSTANCE(dbg,res,cerr);
+            if (res == DW_DLV_OK) {
+                note_cu_addresses(dbg,child,noted_offset,doff);
+                dwarf_dealloc_die(child);
+            }
+        }
+        /*  print_one_die() notes the candidate's own. */
+        noted_offset = doff+1;
+        res = dwarf_offdie_b(dbg,doff,TRUE,&die,err);
+        if (res == DW_DLV_ERROR) {
+            print_error_and_continue(dbg,
+                "ERROR: dwarf_offdie_b failed on an index "
+                "search candidate",
+                res,*err);
+            DROP_ERROR_INSTANCE(dbg,res,*err);
+            continue;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        res = dwarf_die_offsets(die,
+            &glflags.DIE_overall_offset,
+            &glflags.DIE_offset,err);
+        DROP_ERROR_INSTANCE(dbg,res,*err);
+        attribute_matched = FALSE;
+        res = print_one_die(dbg,die,dieprint_cu_goffset,
+            FALSE,1,srcfiles,cnt,&attribute_matched,
+            ignore_die_stack,err);
+        dwarf_dealloc_die(die);
+        if (res == DW_DLV_ERROR) {
+            EMPTY_DIE_STACK_ENTRY(0);
+            return res;
+        }
+    }
+    EMPTY_DIE_STACK_ENTRY(0);
+    return DW_DLV_OK;
+}
+
+/*  sindex is non-null only for an indexed -S match=
+    search. */
 static int
 print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
+    struct search_index_s *sindex,
     Dwarf_Error *pod_err)
 {
     Dwarf_Unsigned cu_header_length = 0;
@@ -789,6 +967,8 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
         Dwarf_Half cu_type = 0;
         Dwarf_Sig8 signature;
         int offres = 0;
+        struct search_index_cand_s *cands = 0;
+        Dwarf_Unsigned cand_count = 0;
 
         signature = zerosig;
         /*  glflags.DIE_overall_offset: in case
@@ -866,6 +1046,19 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
                 continue;
             }
         }
+        if (sindex &&
+            search_index_covers_cu(sindex,dieprint_cu_goffset)) {
+            cand_count = search_index_cu_candidates(sindex,
+                dieprint_cu_goffset,&cands);
+            if (!cand_count) {
+                /*  The accelerator describes this CU and
+                    has nothing by the searched-for name. */
+                dwarf_dealloc_die(cu_die);
+                cu_die = 0;
+                ++cu_count;
+                continue;
+            }
+        }
         {
         /*  Get producer name for this CU and
             update compiler list */
@@ -1028,9 +1221,18 @@ print_one_die_section(Dwarf_Debug dbg,Dwarf_Bool is_info,
                         glflags.DIE_overall_offset;
                     glflags.DIE_CU_offset = glflags.DIE_offset;
                     dieprint_cu_goffset = glflags.DIE_overall_offset;
-                    pres = print_die_and_children(dbg, cu_die2,
-                        dieprint_cu_goffset,is_info,
-                        srcfiles, cnt,pod_err);
+                    if (cand_count && cands[0].sc_die_offset) {
+                        /*  Sorted, so a zero (whole CU)
+                            candidate would come first. */
+                        pres = print_search_candidates(dbg,cu_die2,
+                            dieprint_cu_goffset,next_cu_offset,
+                            cands,cand_count,
+                            srcfiles,cnt,pod_err);
+                    } else {
+                        pres = print_die_and_children(dbg, cu_die2,
+                            dieprint_cu_goffset,is_info,
+                            srcfiles, cnt,pod_err);
+                    }
                     if (srcfiles) {
                         dealloc_all_srcfiles(dbg,srcfiles,cnt);
                         srcfiles = 0;
@@ -175,7 +175,7 @@ process_line_table(Dwarf_Debug dbg,
     }
     for (i = 0; i < linecount; i++) {
         Dwarf_Line line = linebuf[i];
-        char* lsrc_filename = 0;
+        const char* lsrc_filename = 0;
         int nsres = 0;
         Dwarf_Bool found_line_error = FALSE;
         Dwarf_Bool has_is_addr_set = FALSE;
@@ -202,17 +202,16 @@ process_line_table(Dwarf_Debug dbg,
             DWARF_CHECK_COUNT(lines_result,1);
         }
 
-        /*  NO. lsrc_filename is a DW_DLA_STRING, do not assign
-            a static string.
-            lsrc_filename = "<unknown>";
-        */
+        /*  lsrc_filename belongs to the line context,
+            computed once per file, so it is never
+            dealloc'd here. */
         if (!is_actuals_table) {
             Dwarf_Error aterr = 0;
 
-            sres = dwarf_linesrc(line, &lsrc_filename, &aterr);
+            sres = dwarf_linesrc_b(line, &lsrc_filename, &aterr);
             if (sres == DW_DLV_ERROR) {
                 /* Do not terminate processing */
-                where = "dwarf_linesrc()";
+                where = "dwarf_linesrc_b()";
                 record_line_error(where,aterr);
                 found_line_error = TRUE;
                 DROP_ERROR_INSTANCE(dbg,sres,aterr);
@@ -396,8 +395,6 @@ process_line_table(Dwarf_Debug dbg,
             glflags.gf_record_dwarf_error = FALSE;
             /* Due to a fatal error, skip current record */
             if (found_line_error) {
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 continue;
             }
         }
@@ -435,8 +432,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return nsres;
             }
         }
@@ -460,8 +455,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return nsres;
             }
             nsres = dwarf_lineendsequence(line,
@@ -483,8 +476,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return nsres;
             }
         }
@@ -509,8 +500,6 @@ process_line_table(Dwarf_Debug dbg,
                 simple_err_return_action(nsres,
                     esb_get_string(&m));
                 esb_destructor(&m);
-                dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                lsrc_filename = 0;
                 return disres;
             }
             if (prologue_end && !is_actuals_table) {
@@ -541,8 +530,6 @@ process_line_table(Dwarf_Debug dbg,
                         simple_err_return_action(nsres,
                         esb_get_string(&m));
                     esb_destructor(&m);
-                    dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                    lsrc_filename = 0;
                     return disres;
                 }
                 if (call_context) {
@@ -565,8 +552,6 @@ process_line_table(Dwarf_Debug dbg,
                     simple_err_return_action(nsres,
                         esb_get_string(&m));
                     esb_destructor(&m);
-                    dwarf_dealloc(dbg, lsrc_filename, DW_DLA_STRING);
-                    lsrc_filename = 0;
                     return disres;
                 }
                 if (subprog_name && strlen(subprog_name)) {
@@ -606,8 +591,6 @@ process_line_table(Dwarf_Debug dbg,
         if (glflags.gf_do_print_dwarf) {
             printf("\n");
         }
-        dwarf_dealloc(dbg,lsrc_filename, DW_DLA_STRING);
-        lsrc_filename = 0;
     }
     esb_destructor(&lastsrc);
     return DW_DLV_OK;
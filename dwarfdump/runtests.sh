@@ -241,6 +241,11 @@ if [ $r -ne 0 ]
 then
   echo "to update , mv  $top_blddir/dwarfdump/$t $b"
 fi
+f=$srcdir/testpubnamesLE64.elf
+echo "start  dwarfdump --search-index check on $f"
+sh $srcdir/testsearchindex.sh ./dwarfdump $f
+chkres $? "FAIL dwarfdump/runtests.sh testsearchindex.sh $f"
+
 if [ $failcount -ne 0 ]
 then
    echo "FAIL $failcount dwarfdump/runtests.sh"
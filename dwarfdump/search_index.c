@@ -0,0 +1,645 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it and/or
+  modify it under the terms of version 2 of the GNU General
+  Public License as published by the Free Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU General Public
+  License along with this program; if not, write the Free
+  Software Foundation, Inc., 51 Franklin Street - Fifth Floor,
+  Boston MA 02110-1301, USA.
+
+*/
+
+/*  For -S match=<name>: find the CUs and DIEs that can
+    possibly match by asking a name accelerator rather
+    than reading every DIE.  The accelerators consulted,
+    first one present wins:
+        .debug_names    (or a current sidecar, see
+                        dwarf_debugnames_use_sidecar())
+        .gdb_index      (names CUs, not DIEs)
+        .debug_pubnames and .debug_pubtypes (global
+                        names only)
+    A CU the accelerator does not describe is still
+    walked in full by print_die.c.  Names the producer
+    did not index are missed, so this is only done
+    when asked for with --search-index.  */
+
+#include "globals.h"
+#include <ctype.h>
+#include "search_index.h"
+
+boolean
+search_index_applies(Dwarf_Bool is_info)
+{
+    const char *t = glflags.search_match_text;
+
+    if (!is_info || !glflags.gf_search_use_index) {
+        return FALSE;
+    }
+    if (!t || glflags.search_any_text ||
+        glflags.search_regex_text) {
+        return FALSE;
+    }
+    /*  Printing or checking the DIEs means every DIE
+        gets visited anyway. -W/-Wp/-Wc need the
+        die stack the full walk builds. */
+    if (glflags.gf_info_flag || glflags.gf_types_flag ||
+        glflags.gf_do_check_dwarf ||
+        glflags.gf_display_parent_tree ||
+        glflags.gf_display_children_tree ||
+        glflags.gf_line_flag || glflags.gf_macro_flag ||
+        glflags.gf_check_macros || glflags.gf_check_decl_file ||
+        glflags.gf_check_ranges) {
+        return FALSE;
+    }
+    /*  The accelerators only hold names. match= also
+        matches attribute names and numeric values. */
+    if (!strncmp(t,"DW_",3) || isdigit((unsigned char)t[0]) ||
+        t[0] == '-') {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+static int
+add_cu(struct search_index_s *si,Dwarf_Unsigned cu_offset)
+{
+    if (si->si_cu_count == si->si_cu_alloc) {
+        Dwarf_Unsigned newalloc = si->si_cu_alloc?
+            si->si_cu_alloc*2:16;
+        Dwarf_Unsigned *n = (Dwarf_Unsigned *)realloc(si->si_cus,
+            newalloc*sizeof(Dwarf_Unsigned));
+
+        if (!n) {
+            return DW_DLV_ERROR;
+        }
+        si->si_cus = n;
+        si->si_cu_alloc = newalloc;
+    }
+    si->si_cus[si->si_cu_count] = cu_offset;
+    si->si_cu_count++;
+    return DW_DLV_OK;
+}
+
+static int
+add_cand(struct search_index_s *si,Dwarf_Unsigned cu_offset,
+    Dwarf_Unsigned die_offset)
+{
+    if (si->si_cand_count == si->si_cand_alloc) {
+        Dwarf_Unsigned newalloc = si->si_cand_alloc?
+            si->si_cand_alloc*2:8;
+        struct search_index_cand_s *n =
+            (struct search_index_cand_s *)realloc(si->si_cands,
+            newalloc*sizeof(struct search_index_cand_s));
+
+        if (!n) {
+            return DW_DLV_ERROR;
+        }
+        si->si_cands = n;
+        si->si_cand_alloc = newalloc;
+    }
+    si->si_cands[si->si_cand_count].sc_cu_offset = cu_offset;
+    si->si_cands[si->si_cand_count].sc_die_offset = die_offset;
+    si->si_cand_count++;
+    return DW_DLV_OK;
+}
+
+static int
+cmp_cu(const void *l,const void *r)
+{
+    Dwarf_Unsigned a = *(const Dwarf_Unsigned *)l;
+    Dwarf_Unsigned b = *(const Dwarf_Unsigned *)r;
+
+    if (a < b) {
+        return -1;
+    }
+    if (a > b) {
+        return 1;
+    }
+    return 0;
+}
+
+static int
+cmp_cand(const void *l,const void *r)
+{
+    const struct search_index_cand_s *a =
+        (const struct search_index_cand_s *)l;
+    const struct search_index_cand_s *b =
+        (const struct search_index_cand_s *)r;
+
+    if (a->sc_cu_offset != b->sc_cu_offset) {
+        return a->sc_cu_offset < b->sc_cu_offset? -1:1;
+    }
+    if (a->sc_die_offset != b->sc_die_offset) {
+        return a->sc_die_offset < b->sc_die_offset? -1:1;
+    }
+    return 0;
+}
+
+/*  Sort and drop duplicates so candidates are
+    visited in the order the full walk would see them. */
+static void
+sort_index(struct search_index_s *si)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned o = 0;
+
+    if (si->si_cu_count > 1) {
+        qsort(si->si_cus,si->si_cu_count,
+            sizeof(Dwarf_Unsigned),cmp_cu);
+        for (i = 1, o = 1; i < si->si_cu_count; ++i) {
+            if (si->si_cus[i] != si->si_cus[o-1]) {
+                si->si_cus[o++] = si->si_cus[i];
+            }
+        }
+        si->si_cu_count = o;
+    }
+    if (si->si_cand_count > 1) {
+        qsort(si->si_cands,si->si_cand_count,
+            sizeof(struct search_index_cand_s),cmp_cand);
+        for (i = 1, o = 1; i < si->si_cand_count; ++i) {
+            if (cmp_cand(&si->si_cands[i],&si->si_cands[o-1])) {
+                si->si_cands[o++] = si->si_cands[i];
+            }
+        }
+        si->si_cand_count = o;
+    }
+}
+
+static int
+from_debug_names(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si,Dwarf_Error *err)
+{
+    Dwarf_Dnames_Head dnhead = 0;
+    Dwarf_Unsigned index_count = 0;
+    Dwarf_Unsigned ix = 0;
+    Dwarf_Dnames_Match *matches = 0;
+    Dwarf_Unsigned match_count = 0;
+    Dwarf_Unsigned m = 0;
+    int res = 0;
+
+    /*  --search-index asks for accelerators, so a current
+        <objectfile>.dnames sidecar is used too. */
+    res = dwarf_debugnames_use_sidecar(dbg,0,err);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    res = dwarf_debugnames_header(dbg,&dnhead,&index_count,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (ix = 0; ix < index_count; ++ix) {
+        Dwarf_Unsigned cu_count = 0;
+        Dwarf_Unsigned k = 0;
+
+        res = dwarf_debugnames_sizes(dnhead,ix,0,0,0,
+            &cu_count,0,0,0,0,0,0,0,0,err);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc(dbg,dnhead,DW_DLA_DNAMES_HEAD);
+            return res;
+        }
+        for (k = 0; k < cu_count; ++k) {
+            Dwarf_Unsigned offset_count = 0;
+            Dwarf_Unsigned cu_offset = 0;
+            Dwarf_Off cu_die_offset = 0;
+
+            res = dwarf_debugnames_cu_entry(dnhead,ix,k,
+                &offset_count,&cu_offset,err);
+            if (res != DW_DLV_OK) {
+                dwarf_dealloc(dbg,dnhead,DW_DLA_DNAMES_HEAD);
+                return res;
+            }
+            res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+                dbg,cu_offset,TRUE,&cu_die_offset,err);
+            if (res != DW_DLV_OK) {
+                dwarf_dealloc(dbg,dnhead,DW_DLA_DNAMES_HEAD);
+                return res;
+            }
+            if (add_cu(si,cu_die_offset) != DW_DLV_OK) {
+                dwarf_dealloc(dbg,dnhead,DW_DLA_DNAMES_HEAD);
+                return DW_DLV_NO_ENTRY;
+            }
+        }
+    }
+    res = dwarf_debugnames_lookup(dnhead,name,&matches,
+        &match_count,err);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc(dbg,dnhead,DW_DLA_DNAMES_HEAD);
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        /*  The name is not in the index, so no
+            covered CU can match. */
+        match_count = 0;
+        res = DW_DLV_OK;
+    }
+    for (m = 0; m < match_count; ++m) {
+        Dwarf_Off cu_die_offset = 0;
+
+        if (matches[m].dm_is_type_unit) {
+            /*  Type units are not in the CU list so
+                are walked in full. */
+            continue;
+        }
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,matches[m].dm_unit_offset,TRUE,&cu_die_offset,err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (add_cand(si,cu_die_offset,
+            matches[m].dm_die_offset) != DW_DLV_OK) {
+            res = DW_DLV_NO_ENTRY;
+            break;
+        }
+    }
+    dwarf_dealloc_debugnames_matches(matches);
+    dwarf_dealloc(dbg,dnhead,DW_DLA_DNAMES_HEAD);
+    if (res == DW_DLV_OK) {
+        si->si_source = ".debug_names";
+    }
+    return res;
+}
+
+/*  The hash gdb uses for the .gdb_index symbol table
+    (mapped_index_string_hash). */
+static Dwarf_Unsigned
+gdbindex_hash(Dwarf_Unsigned version,const char *name)
+{
+    const unsigned char *s = (const unsigned char *)name;
+    unsigned int r = 0;
+    unsigned int c = 0;
+
+    while ((c = *s++) != 0) {
+        if (version >= 5) {
+            c = tolower(c);
+        }
+        r = r * 67 + c - 113;
+    }
+    return r;
+}
+
+static int
+gdbindex_add_cuvector(Dwarf_Debug dbg,
+    Dwarf_Gdbindex gi,
+    Dwarf_Unsigned cuvec_offset,
+    Dwarf_Unsigned culist_len,
+    struct search_index_s *si,
+    Dwarf_Error *err)
+{
+    Dwarf_Unsigned inner_count = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_cuvector_length(gi,cuvec_offset,
+        &inner_count,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < inner_count; ++i) {
+        Dwarf_Unsigned attr = 0;
+        Dwarf_Unsigned cu_index = 0;
+        Dwarf_Unsigned reserved = 0;
+        Dwarf_Unsigned kind = 0;
+        Dwarf_Unsigned is_static = 0;
+        Dwarf_Unsigned cu_offset = 0;
+        Dwarf_Unsigned cu_length = 0;
+        Dwarf_Off cu_die_offset = 0;
+
+        res = dwarf_gdbindex_cuvector_inner_attributes(gi,
+            cuvec_offset,i,&attr,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_gdbindex_cuvector_instance_expand_value(gi,
+            attr,&cu_index,&reserved,&kind,&is_static,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (cu_index >= culist_len) {
+            /* A type unit, not in the CU list. */
+            continue;
+        }
+        res = dwarf_gdbindex_culist_entry(gi,cu_index,
+            &cu_offset,&cu_length,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,cu_offset,TRUE,&cu_die_offset,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (add_cand(si,cu_die_offset,0) != DW_DLV_OK) {
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+static int
+gdbindex_lookup(Dwarf_Debug dbg,Dwarf_Gdbindex gi,Dwarf_Unsigned version,
+    const char *name,Dwarf_Unsigned culist_len,
+    struct search_index_s *si,Dwarf_Error *err)
+{
+    Dwarf_Unsigned symtab_len = 0;
+    Dwarf_Unsigned slot = 0;
+    Dwarf_Unsigned step = 1;
+    Dwarf_Unsigned probes = 0;
+    Dwarf_Unsigned mask = 0;
+    boolean hashed = FALSE;
+    int res = 0;
+
+    res = dwarf_gdbindex_symboltable_array(gi,&symtab_len,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!symtab_len) {
+        return DW_DLV_OK;
+    }
+    /*  gdb builds an open-addressed table of power of two
+        size.  Anything else gets a linear scan. */
+    if (version >= 5 && !(symtab_len & (symtab_len-1))) {
+        Dwarf_Unsigned h = gdbindex_hash(version,name);
+
+        hashed = TRUE;
+        mask = symtab_len -1;
+        slot = h & mask;
+        step = ((h * 17) & mask) | 1;
+    }
+    for (probes = 0; probes < symtab_len; ++probes) {
+        Dwarf_Unsigned string_offset = 0;
+        Dwarf_Unsigned cuvec_offset = 0;
+        const char *symname = 0;
+
+        res = dwarf_gdbindex_symboltable_entry(gi,slot,
+            &string_offset,&cuvec_offset,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (string_offset || cuvec_offset) {
+            res = dwarf_gdbindex_string_by_offset(gi,
+                string_offset,&symname,err);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (!strcmp(symname,name)) {
+                res = gdbindex_add_cuvector(dbg,gi,cuvec_offset,
+                    culist_len,si,err);
+                if (res != DW_DLV_OK || hashed) {
+                    return res;
+                }
+            }
+        } else if (hashed) {
+            /* Empty slot ends the probe sequence. */
+            return DW_DLV_OK;
+        }
+        if (hashed) {
+            slot = (slot + step) & mask;
+        } else {
+            ++slot;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+static int
+from_gdb_index(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si,Dwarf_Error *err)
+{
+    Dwarf_Gdbindex gi = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Unsigned cu_list_offset = 0;
+    Dwarf_Unsigned types_cu_list_offset = 0;
+    Dwarf_Unsigned address_area_offset = 0;
+    Dwarf_Unsigned symbol_table_offset = 0;
+    Dwarf_Unsigned constant_pool_offset = 0;
+    Dwarf_Unsigned section_size = 0;
+    Dwarf_Unsigned reserved = 0;
+    Dwarf_Unsigned culist_len = 0;
+    Dwarf_Unsigned i = 0;
+    const char *section_name = 0;
+    int res = 0;
+
+    res = dwarf_gdbindex_header(dbg,&gi,&version,
+        &cu_list_offset,&types_cu_list_offset,
+        &address_area_offset,&symbol_table_offset,
+        &constant_pool_offset,&section_size,&reserved,
+        &section_name,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_gdbindex_culist_array(gi,&culist_len,err);
+    if (res != DW_DLV_OK) {
+        dwarf_gdbindex_free(gi);
+        return res;
+    }
+    for (i = 0; i < culist_len; ++i) {
+        Dwarf_Unsigned cu_offset = 0;
+        Dwarf_Unsigned cu_length = 0;
+        Dwarf_Off cu_die_offset = 0;
+
+        res = dwarf_gdbindex_culist_entry(gi,i,
+            &cu_offset,&cu_length,err);
+        if (res == DW_DLV_OK) {
+            res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+                dbg,cu_offset,TRUE,&cu_die_offset,err);
+        }
+        if (res != DW_DLV_OK) {
+            dwarf_gdbindex_free(gi);
+            return res;
+        }
+        if (add_cu(si,cu_die_offset) != DW_DLV_OK) {
+            dwarf_gdbindex_free(gi);
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    res = gdbindex_lookup(dbg,gi,version,name,culist_len,si,err);
+    dwarf_gdbindex_free(gi);
+    if (res == DW_DLV_OK) {
+        si->si_source = ".gdb_index";
+    }
+    return res;
+}
+
+static int
+from_debug_pubnames(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si,Dwarf_Error *err)
+{
+    Dwarf_Global *globs = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_get_globals(dbg,&globs,&count,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Off die_offset = 0;
+        Dwarf_Off cu_die_offset = 0;
+        char *gname = 0;
+
+        res = dwarf_global_name_offsets(globs[i],&gname,
+            &die_offset,&cu_die_offset,err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (add_cu(si,cu_die_offset) != DW_DLV_OK ||
+            (!strcmp(gname,name) &&
+            add_cand(si,cu_die_offset,die_offset) != DW_DLV_OK)) {
+            res = DW_DLV_NO_ENTRY;
+            break;
+        }
+    }
+    dwarf_globals_dealloc(dbg,globs,count);
+    return res;
+}
+
+/*  .debug_pubtypes only adds to what .debug_pubnames found:
+    the CUs it covers are the ones .debug_pubnames covers. */
+static int
+from_debug_pubtypes(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si,Dwarf_Error *err)
+{
+    Dwarf_Type *types = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_get_pubtypes(dbg,&types,&count,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Off die_offset = 0;
+        Dwarf_Off cu_die_offset = 0;
+        char *tname = 0;
+
+        res = dwarf_pubtype_name_offsets(types[i],&tname,
+            &die_offset,&cu_die_offset,err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!strcmp(tname,name) &&
+            add_cand(si,cu_die_offset,die_offset) != DW_DLV_OK) {
+            res = DW_DLV_NO_ENTRY;
+            break;
+        }
+    }
+    dwarf_pubtypes_dealloc(dbg,types,count);
+    return res;
+}
+
+static int
+from_pubnames_pubtypes(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si,Dwarf_Error *err)
+{
+    int res = 0;
+
+    res = from_debug_pubnames(dbg,name,si,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = from_debug_pubtypes(dbg,name,si,err);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    si->si_source = ".debug_pubnames";
+    return DW_DLV_OK;
+}
+
+static void
+reset_index(struct search_index_s *si)
+{
+    si->si_cu_count = 0;
+    si->si_cand_count = 0;
+    si->si_source = 0;
+}
+
+int
+search_index_build(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si)
+{
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    memset(si,0,sizeof(*si));
+    res = from_debug_names(dbg,name,si,&err);
+    if (res != DW_DLV_OK) {
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        reset_index(si);
+        res = from_gdb_index(dbg,name,si,&err);
+    }
+    if (res != DW_DLV_OK) {
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        reset_index(si);
+        res = from_pubnames_pubtypes(dbg,name,si,&err);
+    }
+    if (res != DW_DLV_OK) {
+        DROP_ERROR_INSTANCE(dbg,res,err);
+        search_index_destructor(si);
+        return DW_DLV_NO_ENTRY;
+    }
+    sort_index(si);
+    return DW_DLV_OK;
+}
+
+boolean
+search_index_covers_cu(struct search_index_s *si,
+    Dwarf_Unsigned cu_offset)
+{
+    if (!si->si_cu_count) {
+        return FALSE;
+    }
+    return bsearch(&cu_offset,si->si_cus,si->si_cu_count,
+        sizeof(Dwarf_Unsigned),cmp_cu) != 0;
+}
+
+Dwarf_Unsigned
+search_index_cu_candidates(struct search_index_s *si,
+    Dwarf_Unsigned cu_offset,
+    struct search_index_cand_s **first)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = si->si_cand_count;
+    Dwarf_Unsigned end = 0;
+
+    /* Lower bound of cu_offset. */
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (si->si_cands[mid].sc_cu_offset < cu_offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (end = lo; end < si->si_cand_count &&
+        si->si_cands[end].sc_cu_offset == cu_offset; ++end) {
+    }
+    *first = si->si_cands + lo;
+    return end - lo;
+}
+
+void
+search_index_destructor(struct search_index_s *si)
+{
+    free(si->si_cus);
+    free(si->si_cands);
+    memset(si,0,sizeof(*si));
+}
@@ -0,0 +1,88 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+  Redistribution and use in source and binary forms, with
+  or without modification, are permitted provided that the
+  following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+  CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+  INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+  OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+  CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+  OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+  EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+#ifndef SEARCH_INDEX_H
+#define SEARCH_INDEX_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif /* __cplusplus */
+
+/*  Candidate DIEs for an exact -S match= search, taken
+    from .debug_names, .gdb_index or .debug_pubnames/pubtypes
+    instead of walking every DIE in .debug_info.
+    All offsets are .debug_info section offsets. */
+
+struct search_index_cand_s {
+    /* Offset of the CU die. */
+    Dwarf_Unsigned sc_cu_offset;
+    /*  Zero means the accelerator only names the CU
+        (.gdb_index) so the whole CU must be walked. */
+    Dwarf_Unsigned sc_die_offset;
+};
+
+struct search_index_s {
+    /* The section the candidates came from. */
+    const char *si_source;
+
+    /*  Sorted CU die offsets of the CUs the accelerator
+        describes.  CUs not listed get the full walk. */
+    Dwarf_Unsigned *si_cus;
+    Dwarf_Unsigned  si_cu_count;
+    Dwarf_Unsigned  si_cu_alloc;
+
+    /* Sorted by CU then DIE offset, no duplicates. */
+    struct search_index_cand_s *si_cands;
+    Dwarf_Unsigned  si_cand_count;
+    Dwarf_Unsigned  si_cand_alloc;
+};
+
+/*  TRUE if the options in effect allow an indexed search. */
+boolean search_index_applies(Dwarf_Bool is_info);
+
+/*  Returns DW_DLV_OK if an accelerator was found and read,
+    DW_DLV_NO_ENTRY if the caller must walk every CU.
+    Errors reading an accelerator are dropped and
+    reported as DW_DLV_NO_ENTRY. */
+int  search_index_build(Dwarf_Debug dbg,const char *name,
+    struct search_index_s *si);
+boolean search_index_covers_cu(struct search_index_s *si,
+    Dwarf_Unsigned cu_offset);
+/*  Returns the count of candidates in the CU and sets
+    *first to the first of them. */
+Dwarf_Unsigned search_index_cu_candidates(struct search_index_s *si,
+    Dwarf_Unsigned cu_offset,
+    struct search_index_cand_s **first);
+void search_index_destructor(struct search_index_s *si);
+
+#ifdef __cplusplus
+}
+#endif /* __cplusplus */
+#endif /* SEARCH_INDEX_H */
@@ -0,0 +1,73 @@
+#!/bin/sh
+#
+# Compares dwarfdump -S match= output with and without
+# --search-index on an object with .debug_pubnames and
+# .debug_pubtypes, so the index is used.
+# Run as  testsearchindex.sh <dwarfdump> <object>
+# The output is left in junk.searchindex.* files.
+#
+# A name found only through a reference to it, such as
+# DW_AT_abstract_origin of an inlined or out-of-line
+# instance, is not in the index, so for such names the
+# indexed search prints a subset of the full search.
+# For the others the two must be the same.
+
+dd=$1
+obj=$2
+failcount=0
+
+# Functions with no inlined instances, base types,
+# and a name not in the object.
+same="main int char nosuchname"
+# Inlined functions: their instances are found only
+# by the full search.
+subset="helper middle inner work coldf other"
+
+for n in $same $subset
+do
+  full=junk.searchindex.$n.full
+  indexed=junk.searchindex.$n.indexed
+  $dd -S match=$n $obj > $full
+  if [ $? -ne 0 ]
+  then
+    echo "FAIL $dd -S match=$n $obj"
+    failcount=`expr $failcount + 1`
+    continue
+  fi
+  $dd --search-index -S match=$n $obj > $indexed
+  if [ $? -ne 0 ]
+  then
+    echo "FAIL $dd --search-index -S match=$n $obj"
+    failcount=`expr $failcount + 1`
+    continue
+  fi
+  case " $same " in
+  *" $n "*)
+    diff $full $indexed
+    r=$? ;;
+  *)
+    # Only lines missing from the indexed output, and
+    # it must have found the name itself.
+    r=0
+    if diff $full $indexed | grep '^>'
+    then
+      r=1
+    fi
+    if ! grep "DW_AT_name  *$n\$" $indexed >/dev/null
+    then
+      echo "no DW_AT_name $n in $indexed"
+      r=1
+    fi ;;
+  esac
+  if [ $r -ne 0 ]
+  then
+    echo "FAIL --search-index output differs for match=$n"
+    failcount=`expr $failcount + 1`
+  fi
+done
+if [ $failcount -ne 0 ]
+then
+  echo "FAIL $failcount testsearchindex.sh"
+  exit 1
+fi
+exit 0
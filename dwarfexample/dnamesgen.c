@@ -0,0 +1,210 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  * Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  * Neither the name of the example nor the
+    names of its contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY the libdwarf contributors ''AS IS''
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL the libdwarf
+  contributors BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+/*  dnamesgen.c
+    Builds a DWARF5 .debug_names style name index for an
+    object that has none and writes it next to the object
+    as <objectfile>.dnames, using
+    dwarf_debugnames_write_sidecar().
+    Later sessions on the object that call
+    dwarf_debugnames_use_sidecar() use that file for
+    dwarf_debugnames_lookup() whenever the object has
+    no .debug_names section of its own.
+
+    dnamesgen [-o <sidecarpath>] <objectfile>
+        Writes the sidecar (to sidecarpath if given,
+        but --lookup only reads the default path).
+    dnamesgen --lookup=<name> <objectfile>
+        Looks the name up with the object's .debug_names
+        or its current sidecar and prints the DIEs found.
+*/
+#include "config.h"
+
+/* Windows specific header files */
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for exit(), C89 malloc */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <string.h>     /* For strcmp* */
+#include <stdio.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+static void
+usage(void)
+{
+    printf("Usage: dnamesgen [-o <sidecarpath>] <objectfile>\n");
+    printf("       dnamesgen --lookup=<name> <objectfile>\n");
+}
+
+static void
+fail(const char *msg, int res, Dwarf_Error err)
+{
+    fprintf(stderr,"dnamesgen: %s failed",msg);
+    if (res == DW_DLV_ERROR) {
+        fprintf(stderr,": %s",dwarf_errmsg(err));
+    } else if (res == DW_DLV_NO_ENTRY) {
+        fprintf(stderr,": no entry");
+    }
+    fprintf(stderr,"\n");
+    exit(1);
+}
+
+static int
+write_sidecar(Dwarf_Debug dbg, const char *path,
+    const char *outpath)
+{
+    Dwarf_Unsigned names = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_debugnames_write_sidecar(dbg,outpath,&names,&err);
+    if (res == DW_DLV_NO_ENTRY) {
+        printf("%s: no compilation units, nothing written\n",path);
+        return 0;
+    }
+    if (res != DW_DLV_OK) {
+        fail("dwarf_debugnames_write_sidecar",res,err);
+    }
+    printf("%s: %" DW_PR_DUu " names written to %s%s\n",
+        path,names,outpath?outpath:path,outpath?"":".dnames");
+    return 0;
+}
+
+static int
+lookup_name(Dwarf_Debug dbg, const char *path, const char *name)
+{
+    Dwarf_Dnames_Head dn = 0;
+    Dwarf_Unsigned index_count = 0;
+    Dwarf_Dnames_Match *matches = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_debugnames_use_sidecar(dbg,0,&err);
+    if (res == DW_DLV_ERROR) {
+        fail("dwarf_debugnames_use_sidecar",res,err);
+    }
+    res = dwarf_debugnames_header(dbg,&dn,&index_count,&err);
+    if (res == DW_DLV_NO_ENTRY) {
+        printf("%s: no .debug_names and no current sidecar\n",
+            path);
+        return 1;
+    }
+    if (res != DW_DLV_OK) {
+        fail("dwarf_debugnames_header",res,err);
+    }
+    res = dwarf_debugnames_lookup(dn,name,&matches,&count,&err);
+    if (res == DW_DLV_NO_ENTRY) {
+        printf("%s: %s not found\n",path,name);
+        dwarf_dealloc(dbg,dn,DW_DLA_DNAMES_HEAD);
+        return 1;
+    }
+    if (res != DW_DLV_OK) {
+        fail("dwarf_debugnames_lookup",res,err);
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Dnames_Match *m = matches+i;
+        const char *tagname = "<unknown tag>";
+        Dwarf_Die die = 0;
+        char *diename = 0;
+
+        dwarf_get_TAG_name(m->dm_tag,&tagname);
+        res = dwarf_offdie_b(dbg,m->dm_die_offset,TRUE,&die,&err);
+        if (res != DW_DLV_OK) {
+            fail("dwarf_offdie_b",res,err);
+        }
+        res = dwarf_diename(die,&diename,&err);
+        if (res == DW_DLV_ERROR) {
+            fail("dwarf_diename",res,err);
+        }
+        printf("%s unit 0x%" DW_PR_XZEROS DW_PR_DUx
+            " die 0x%" DW_PR_XZEROS DW_PR_DUx " %s\n",
+            tagname,m->dm_unit_offset,m->dm_die_offset,
+            res == DW_DLV_OK? diename:"<no DW_AT_name>");
+        dwarf_dealloc_die(die);
+    }
+    dwarf_dealloc_debugnames_matches(matches);
+    dwarf_dealloc(dbg,dn,DW_DLA_DNAMES_HEAD);
+    return 0;
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *path = 0;
+    const char *outpath = 0;
+    const char *name = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int curopt = 0;
+    int res = 0;
+    int status = 0;
+
+    for (curopt = 1; curopt < argc; ++curopt) {
+        const char *a = argv[curopt];
+
+        if (!strcmp(a,"-o") && (curopt+1) < argc) {
+            outpath = argv[++curopt];
+        } else if (!strncmp(a,"--lookup=",9)) {
+            name = a+9;
+        } else {
+            break;
+        }
+    }
+    if (curopt != (argc-1) || (name && outpath)) {
+        usage();
+        exit(1);
+    }
+    path = argv[curopt];
+    res = dwarf_init_path(path,0,0,DW_DLC_READ,
+        DW_GROUPNUMBER_ANY,0,0,&dbg,0,0,0,&err);
+    if (res != DW_DLV_OK) {
+        fail("dwarf_init_path",res,err);
+    }
+    if (name) {
+        status = lookup_name(dbg,path,name);
+    } else {
+        status = write_sidecar(dbg,path,outpath);
+    }
+    dwarf_finish(dbg,&err);
+    return status;
+}
@@ -0,0 +1,737 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  * Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  * Neither the name of the example nor the
+    names of its contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY the libdwarf contributors ''AS IS''
+  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED
+  TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A
+  PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL the libdwarf
+  contributors BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+  SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+  NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+  HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE
+  OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+/*  dwarfbench.c
+    Times a fixed set of common libdwarf workloads
+    against an object file and writes one CSV
+    line per workload run, so results from different
+    libdwarf versions (or options) can be compared.
+
+    dwarfbench [--iterations=<n>] [--workload=<name>]
+        [--no-header] <objectfile>
+
+    Workloads, each run on a freshly opened Dwarf_Debug
+    (opening and dwarf_finish() are not timed):
+        cu_headers  dwarf_next_cu_header_d() over all CUs.
+        die_walk    every DIE of every CU, with dwarf_attrlist().
+        srclines    dwarf_srclines_b() for every CU.
+        frames      dwarf_get_fde_list() (or the .eh_frame list)
+                    and the register rules of every row of
+                    every FDE.
+        aranges     dwarf_get_aranges() then a dwarf_get_arange()
+                    lookup for the midpoint of every range.
+        offdie      dwarf_offdie_b() for every DIE offset,
+                    in a shuffled (but reproducible) order.
+
+    CSV columns:
+        workload,file,iteration,items,wall_seconds,
+        user_seconds,peak_rss_kb,allocs,section_bytes_loaded
+    'items' is what the workload counted (CUs, DIEs, lines,
+    rows, lookups). peak_rss_kb is the process high-water mark
+    so it never decreases within a run: use --workload
+    to measure one workload's peak in isolation.
+    allocs and section_bytes_loaded come from
+    dwarf_get_perf_counters().
+*/
+#include "config.h"
+
+/* Windows specific header files */
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for exit(), C89 malloc */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <string.h>     /* For strcmp* */
+#include <stdio.h>
+#include <time.h>       /* For clock() */
+#ifndef _WIN32
+#include <sys/time.h>      /* For gettimeofday() */
+#include <sys/resource.h>  /* For getrusage() */
+#endif /* _WIN32 */
+#include "dwarf.h"
+#include "libdwarf.h"
+
+#ifndef TRUE
+#define TRUE 1
+#define FALSE 0
+#endif /* TRUE */
+
+typedef int (*workload_func)(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+
+struct workload_s {
+    const char    *wl_name;
+    workload_func  wl_func;
+};
+
+static int bench_cu_headers(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+static int bench_die_walk(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+static int bench_srclines(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+static int bench_frames(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+static int bench_aranges(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+static int bench_offdie(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err);
+
+static struct workload_s workloads[] = {
+{"cu_headers",bench_cu_headers},
+{"die_walk",  bench_die_walk},
+{"srclines",  bench_srclines},
+{"frames",    bench_frames},
+{"aranges",   bench_aranges},
+{"offdie",    bench_offdie},
+{0,0}
+};
+
+/*  The .debug_info DIE offsets, gathered once
+    (untimed) for the offdie workload. */
+static Dwarf_Off     *die_offsets;
+static Dwarf_Unsigned die_offsets_count;
+static Dwarf_Unsigned die_offsets_max;
+
+static void
+usage(void)
+{
+    printf("Usage: dwarfbench [--iterations=<n>] "
+        "[--workload=<name>] [--no-header] <objectfile>\n");
+    printf("Workloads:");
+    {
+        struct workload_s *w = workloads;
+        for ( ; w->wl_name; ++w) {
+            printf(" %s",w->wl_name);
+        }
+    }
+    printf("\n");
+}
+
+static double
+wall_seconds(void)
+{
+#ifdef _WIN32
+    return (double)clock()/(double)CLOCKS_PER_SEC;
+#else
+    struct timeval tv;
+
+    gettimeofday(&tv,0);
+    return (double)tv.tv_sec + (double)tv.tv_usec/1000000.0;
+#endif /* _WIN32 */
+}
+
+/*  On Windows we have no getrusage(): report
+    processor time as user time and zero RSS. */
+static void
+process_usage(double *user_secs, long *peak_rss_kb)
+{
+#ifdef _WIN32
+    *user_secs = (double)clock()/(double)CLOCKS_PER_SEC;
+    *peak_rss_kb = 0;
+#else
+    struct rusage ru;
+
+    memset(&ru,0,sizeof(ru));
+    getrusage(RUSAGE_SELF,&ru);
+    *user_secs = (double)ru.ru_utime.tv_sec +
+        (double)ru.ru_utime.tv_usec/1000000.0;
+    /*  Kilobytes on Linux and the BSDs, bytes on MacOS. */
+    *peak_rss_kb = ru.ru_maxrss;
+#ifdef __APPLE__
+    *peak_rss_kb /= 1024;
+#endif
+#endif /* _WIN32 */
+}
+
+static void
+fail(const char *msg, int res, Dwarf_Error err)
+{
+    fprintf(stderr,"dwarfbench: %s failed",msg);
+    if (res == DW_DLV_ERROR) {
+        fprintf(stderr,": %s",dwarf_errmsg(err));
+    }
+    fprintf(stderr,"\n");
+    exit(1);
+}
+
+static Dwarf_Debug
+open_dbg(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_DLC_READ,
+        DW_GROUPNUMBER_ANY,0,0,&dbg,0,0,0,&err);
+    if (res != DW_DLV_OK) {
+        fail("dwarf_init_path",res,err);
+    }
+    return dbg;
+}
+
+/*  Returns DW_DLV_NO_ENTRY past the last CU,
+    which also resets the CU iteration. */
+static int
+next_cu(Dwarf_Debug dbg,Dwarf_Error *err)
+{
+    Dwarf_Unsigned cu_header_length = 0;
+    Dwarf_Half     version_stamp = 0;
+    Dwarf_Off      abbrev_offset = 0;
+    Dwarf_Half     address_size = 0;
+    Dwarf_Half     length_size = 0;
+    Dwarf_Half     extension_size = 0;
+    Dwarf_Sig8     signature;
+    Dwarf_Unsigned typeoffset = 0;
+    Dwarf_Unsigned next_cu_offset = 0;
+    Dwarf_Half     header_cu_type = 0;
+
+    memset(&signature,0,sizeof(signature));
+    return dwarf_next_cu_header_d(dbg,TRUE,
+        &cu_header_length,&version_stamp,&abbrev_offset,
+        &address_size,&length_size,&extension_size,
+        &signature,&typeoffset,&next_cu_offset,
+        &header_cu_type,err);
+}
+
+static int
+cu_die(Dwarf_Debug dbg,Dwarf_Die *die_out,Dwarf_Error *err)
+{
+    return dwarf_siblingof_b(dbg,0,TRUE,die_out,err);
+}
+
+static int
+bench_cu_headers(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    int res = 0;
+
+    for (;;) {
+        res = next_cu(dbg,err);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        (*items)++;
+    }
+    return res == DW_DLV_ERROR? res: DW_DLV_OK;
+}
+
+static void
+record_offset(Dwarf_Off off)
+{
+    if (die_offsets_count >= die_offsets_max) {
+        Dwarf_Unsigned newmax = die_offsets_max?
+            die_offsets_max*2: 1024;
+        Dwarf_Off *n = (Dwarf_Off *)realloc(die_offsets,
+            (size_t)newmax*sizeof(Dwarf_Off));
+
+        if (!n) {
+            fprintf(stderr,"dwarfbench: out of memory\n");
+            exit(1);
+        }
+        die_offsets = n;
+        die_offsets_max = newmax;
+    }
+    die_offsets[die_offsets_count++] = off;
+}
+
+/*  Visits one DIE the way a typical consumer
+    would: fetch the attribute list, then drop it. */
+static int
+visit_die(Dwarf_Debug dbg,Dwarf_Die die,
+    Dwarf_Bool gather,Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    Dwarf_Attribute *atlist = 0;
+    Dwarf_Signed atcount = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    if (gather) {
+        Dwarf_Off off = 0;
+
+        res = dwarf_dieoffset(die,&off,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        record_offset(off);
+    }
+    res = dwarf_attrlist(die,&atlist,&atcount,err);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        for (i = 0; i < atcount; ++i) {
+            dwarf_dealloc(dbg,atlist[i],DW_DLA_ATTR);
+        }
+        dwarf_dealloc(dbg,atlist,DW_DLA_LIST);
+    }
+    (*items)++;
+    return DW_DLV_OK;
+}
+
+/*  Visits die, its children and its later siblings,
+    deallocating each DIE once done with it. */
+static int
+walk_siblings(Dwarf_Debug dbg,Dwarf_Die die,
+    Dwarf_Bool gather,Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        res = visit_die(dbg,die,gather,items,err);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc(dbg,die,DW_DLA_DIE);
+            return res;
+        }
+        res = dwarf_child(die,&child,err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc(dbg,die,DW_DLA_DIE);
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            res = walk_siblings(dbg,child,gather,items,err);
+            if (res != DW_DLV_OK) {
+                dwarf_dealloc(dbg,die,DW_DLA_DIE);
+                return res;
+            }
+        }
+        res = dwarf_siblingof_b(dbg,die,TRUE,&sib,err);
+        dwarf_dealloc(dbg,die,DW_DLA_DIE);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        die = sib;
+    }
+}
+
+static int
+walk_all_dies(Dwarf_Debug dbg,Dwarf_Bool gather,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+
+        res = next_cu(dbg,err);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        res = cu_die(dbg,&cudie,err);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        /*  walk_siblings() deallocs cudie. A CU DIE
+            has no siblings within its CU. */
+        res = walk_siblings(dbg,cudie,gather,items,err);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+static int
+bench_die_walk(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    return walk_all_dies(dbg,FALSE,items,err);
+}
+
+static int
+bench_srclines(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned version = 0;
+        Dwarf_Small table_count = 0;
+        Dwarf_Line_Context context = 0;
+        Dwarf_Line *linebuf = 0;
+        Dwarf_Signed linecount = 0;
+
+        res = next_cu(dbg,err);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        res = cu_die(dbg,&cudie,err);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        res = dwarf_srclines_b(cudie,&version,&table_count,
+            &context,err);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc(dbg,cudie,DW_DLA_DIE);
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_srclines_from_linecontext(context,
+                &linebuf,&linecount,err);
+            if (res == DW_DLV_OK) {
+                *items += linecount;
+            }
+            dwarf_srclines_dealloc_b(context);
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc(dbg,cudie,DW_DLA_DIE);
+                return res;
+            }
+        }
+        dwarf_dealloc(dbg,cudie,DW_DLA_DIE);
+    }
+}
+
+/*  Walk the rows of one FDE, fetching the full
+    register table at each, as an unwinder would. */
+static int
+fde_rows(Dwarf_Fde fde,Dwarf_Regtable3 *tab3,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    Dwarf_Addr lowpc = 0;
+    Dwarf_Unsigned func_length = 0;
+    Dwarf_Ptr fde_bytes = 0;
+    Dwarf_Unsigned fde_byte_length = 0;
+    Dwarf_Off cie_offset = 0;
+    Dwarf_Signed cie_index = 0;
+    Dwarf_Off fde_offset = 0;
+    Dwarf_Addr pc = 0;
+    int res = 0;
+
+    res = dwarf_get_fde_range(fde,&lowpc,&func_length,
+        &fde_bytes,&fde_byte_length,&cie_offset,&cie_index,
+        &fde_offset,err);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    pc = lowpc;
+    for (;;) {
+        Dwarf_Small value_type = 0;
+        Dwarf_Signed offset_relevant = 0;
+        Dwarf_Signed reg = 0;
+        Dwarf_Signed offset_or_block_len = 0;
+        Dwarf_Ptr block_ptr = 0;
+        Dwarf_Addr row_pc = 0;
+        Dwarf_Bool has_more_rows = FALSE;
+        Dwarf_Addr subsequent_pc = 0;
+
+        res = dwarf_get_fde_info_for_cfa_reg3_b(fde,pc,
+            &value_type,&offset_relevant,&reg,
+            &offset_or_block_len,&block_ptr,&row_pc,
+            &has_more_rows,&subsequent_pc,err);
+        if (res != DW_DLV_OK) {
+            return res == DW_DLV_ERROR? res: DW_DLV_OK;
+        }
+        res = dwarf_get_fde_info_for_all_regs3(fde,pc,
+            tab3,&row_pc,err);
+        if (res != DW_DLV_OK) {
+            return res == DW_DLV_ERROR? res: DW_DLV_OK;
+        }
+        (*items)++;
+        if (!has_more_rows || subsequent_pc <= pc ||
+            subsequent_pc >= (lowpc + func_length)) {
+            return DW_DLV_OK;
+        }
+        pc = subsequent_pc;
+    }
+}
+
+static int
+bench_frames(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    Dwarf_Cie *cie_data = 0;
+    Dwarf_Signed cie_count = 0;
+    Dwarf_Fde *fde_data = 0;
+    Dwarf_Signed fde_count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Regtable3 tab3;
+    int rulecount = 0;
+    int res = 0;
+
+    res = dwarf_get_fde_list(dbg,&cie_data,&cie_count,
+        &fde_data,&fde_count,err);
+    if (res == DW_DLV_NO_ENTRY) {
+        res = dwarf_get_fde_list_eh(dbg,&cie_data,&cie_count,
+            &fde_data,&fde_count,err);
+    }
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_ERROR? res: DW_DLV_OK;
+    }
+    /*  1 is arbitrary, we just want the current count. */
+    rulecount = dwarf_set_frame_rule_table_size(dbg,1);
+    dwarf_set_frame_rule_table_size(dbg,rulecount);
+    memset(&tab3,0,sizeof(tab3));
+    tab3.rt3_reg_table_size = rulecount;
+    tab3.rt3_rules = (struct Dwarf_Regtable_Entry3_s *)malloc(
+        sizeof(struct Dwarf_Regtable_Entry3_s)*rulecount);
+    if (!tab3.rt3_rules) {
+        fprintf(stderr,"dwarfbench: out of memory\n");
+        exit(1);
+    }
+    for (i = 0; i < fde_count; ++i) {
+        res = fde_rows(fde_data[i],&tab3,items,err);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+    }
+    free(tab3.rt3_rules);
+    dwarf_fde_cie_list_dealloc(dbg,cie_data,cie_count,
+        fde_data,fde_count);
+    return res == DW_DLV_ERROR? res: DW_DLV_OK;
+}
+
+static int
+bench_aranges(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    Dwarf_Arange *aranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    res = dwarf_get_aranges(dbg,&aranges,&count,err);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_ERROR? res: DW_DLV_OK;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Unsigned segment = 0;
+        Dwarf_Unsigned segment_entry_size = 0;
+        Dwarf_Addr start = 0;
+        Dwarf_Unsigned length = 0;
+        Dwarf_Off cu_die_offset = 0;
+        Dwarf_Arange found = 0;
+
+        res = dwarf_get_arange_info_b(aranges[i],&segment,
+            &segment_entry_size,&start,&length,
+            &cu_die_offset,err);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_NO_ENTRY || !length) {
+            continue;
+        }
+        res = dwarf_get_arange(aranges,count,
+            start + length/2,&found,err);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_get_cu_die_offset(found,&cu_die_offset,err);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+        }
+        (*items)++;
+    }
+    for (i = 0; i < count; ++i) {
+        dwarf_dealloc(dbg,aranges[i],DW_DLA_ARANGE);
+    }
+    dwarf_dealloc(dbg,aranges,DW_DLA_LIST);
+    return res == DW_DLV_ERROR? res: DW_DLV_OK;
+}
+
+static int
+bench_offdie(Dwarf_Debug dbg,
+    Dwarf_Unsigned *items,Dwarf_Error *err)
+{
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; i < die_offsets_count; ++i) {
+        Dwarf_Die die = 0;
+
+        res = dwarf_offdie_b(dbg,die_offsets[i],TRUE,&die,err);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            dwarf_dealloc(dbg,die,DW_DLA_DIE);
+            (*items)++;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Gather all DIE offsets and shuffle them with
+    a fixed-seed generator so every run (and every
+    libdwarf version) sees the same access order. */
+static void
+gather_offsets(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned seed = 0x2545F4914F6CDD1DULL;
+    int res = 0;
+
+    dbg = open_dbg(path);
+    res = walk_all_dies(dbg,TRUE,&count,&err);
+    if (res != DW_DLV_OK) {
+        fail("gathering DIE offsets",res,err);
+    }
+    dwarf_finish(dbg,&err);
+    for (i = die_offsets_count; i > 1; --i) {
+        Dwarf_Unsigned j = 0;
+        Dwarf_Off t = 0;
+
+        seed ^= seed << 13;
+        seed ^= seed >> 7;
+        seed ^= seed << 17;
+        j = seed % i;
+        t = die_offsets[i-1];
+        die_offsets[i-1] = die_offsets[j];
+        die_offsets[j] = t;
+    }
+}
+
+static void
+run_workload(const char *path,struct workload_s *w,
+    unsigned iteration)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error err = 0;
+    Dwarf_Perf_Counters pc;
+    Dwarf_Unsigned items = 0;
+    double wall_start = 0.0;
+    double wall_end = 0.0;
+    double user_start = 0.0;
+    double user_end = 0.0;
+    long peak_rss = 0;
+    int res = 0;
+
+    memset(&pc,0,sizeof(pc));
+    dbg = open_dbg(path);
+    /*  Leave out what opening the object cost. */
+    dwarf_reset_perf_counters(dbg,&err);
+    process_usage(&user_start,&peak_rss);
+    wall_start = wall_seconds();
+    res = w->wl_func(dbg,&items,&err);
+    wall_end = wall_seconds();
+    process_usage(&user_end,&peak_rss);
+    if (res != DW_DLV_OK) {
+        fail(w->wl_name,res,err);
+    }
+    pc.pc_size = sizeof(pc);
+    dwarf_get_perf_counters(dbg,&pc,&err);
+    printf("%s,%s,%u,%" DW_PR_DUu ",%.6f,%.6f,%ld,%"
+        DW_PR_DUu ",%" DW_PR_DUu "\n",
+        w->wl_name,path,iteration,items,
+        wall_end - wall_start,user_end - user_start,
+        peak_rss,pc.pc_allocs_total,pc.pc_section_bytes_loaded);
+    fflush(stdout);
+    dwarf_finish(dbg,&err);
+}
+
+int
+main(int argc, char **argv)
+{
+    const char *path = 0;
+    const char *only = 0;
+    unsigned iterations = 1;
+    unsigned iter = 0;
+    int header = TRUE;
+    int curopt = 0;
+    struct workload_s *w = 0;
+
+    for (curopt = 1; curopt < argc; ++curopt) {
+        const char *a = argv[curopt];
+
+        if (strncmp(a,"--",2)) {
+            break;
+        }
+        if (!strncmp(a,"--iterations=",13)) {
+            iterations = (unsigned)atoi(a+13);
+        } else if (!strncmp(a,"--workload=",11)) {
+            only = a+11;
+        } else if (!strcmp(a,"--no-header")) {
+            header = FALSE;
+        } else {
+            usage();
+            exit(1);
+        }
+    }
+    if (curopt != (argc-1) || !iterations) {
+        usage();
+        exit(1);
+    }
+    path = argv[curopt];
+    if (only) {
+        for (w = workloads; w->wl_name; ++w) {
+            if (!strcmp(w->wl_name,only)) {
+                break;
+            }
+        }
+        if (!w->wl_name) {
+            usage();
+            exit(1);
+        }
+    }
+    if (!only || !strcmp(only,"offdie")) {
+        gather_offsets(path);
+    }
+    if (header) {
+        printf("workload,file,iteration,items,wall_seconds,"
+            "user_seconds,peak_rss_kb,allocs,"
+            "section_bytes_loaded\n");
+    }
+    for (iter = 0; iter < iterations; ++iter) {
+        for (w = workloads; w->wl_name; ++w) {
+            if (only && strcmp(w->wl_name,only)) {
+                continue;
+            }
+            run_workload(path,w,iter);
+        }
+    }
+    free(die_offsets);
+    return 0;
+}
@@ -69,6 +69,26 @@ then
 fi
 chkres $r "running getdebuglink diff against baseline"
 
+echo "dwarfbench test"
+o=junk.dwarfbench
+$blddir/dwarfbench $srcdir/dummyexecutable > $blddir/$o
+chkres $? "running dwarfbench"
+# Timings vary, so just check each workload reported.
+for w in cu_headers die_walk srclines frames aranges offdie
+do
+  grep "^$w," $blddir/$o >/dev/null
+  chkres $? "dwarfbench workload $w missing"
+done
+
+echo "dnamesgen test"
+o=junk.dnamesobj
+rm -f $blddir/$o $blddir/$o.dnames
+cp $srcdir/dummyexecutable $blddir/$o
+$blddir/dnamesgen $blddir/$o > /dev/null
+chkres $? "running dnamesgen"
+$blddir/dnamesgen --lookup=main $blddir/$o | grep "DW_TAG_subprogram .* main$" >/dev/null
+chkres $? "dnamesgen lookup of main through the sidecar"
+
 if [ $failcount -gt 0 ] 
 then
    echo "FAIL $failcount dwarfexample/runtests.sh"
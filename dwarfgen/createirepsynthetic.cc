@@ -0,0 +1,496 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  * Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  * Neither the name of the example nor the
+    names of its contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY the libdwarf contributors ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL the libdwarf contributors BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// createirepsynthetic.cc
+
+// Builds an IRepresentation from a handful of scale
+// knobs rather than from an input object, so that
+// the output of ireptodbg.cc can be made as large (or as
+// deep) as a scaling test needs.
+// Everything is deterministic: the same knobs always
+// produce the same DIEs, lines and frames.
+
+#include "config.h"
+
+#ifdef HAVE_UNUSED_ATTRIBUTE
+#define  UNUSEDARG __attribute__ ((unused))
+#else
+#define  UNUSEDARG
+#endif
+
+/* Windows specific header files */
+#if defined(_WIN32) && defined(HAVE_STDAFX_H)
+#include "stdafx.h"
+#endif /* HAVE_STDAFX_H */
+
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for exit() */
+#endif /* HAVE_STDLIB_H */
+#include <iostream>
+#include <string>
+#include <list>
+#include <map>
+#include <vector>
+#include <string.h> // For memset etc
+#include "strtabdata.h"
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "irepresentation.h"
+#include "createirepsynthetic.h"
+#include "general.h" // For BldName()
+
+using std::string;
+using std::cerr;
+using std::endl;
+using std::vector;
+
+// Each subprogram gets this many bytes of pretend code.
+#define SYN_FUNC_SIZE     0x40
+#define SYN_TEXT_BASE     0x1000
+// Bytes of pretend code per line table row.
+#define SYN_LINE_STEP     4
+#define SYN_VARS_PER_SCOPE 4
+
+// State carried across all the CUs we generate.
+struct SyntheticState {
+    SyntheticState(): nextpc_(SYN_TEXT_BASE),
+        nextfuncnum_(0),nextglobaloff_(0),nextcuoff_(0),
+        remaining_(0) {};
+    Dwarf_Addr nextpc_;
+    // Start address of every subprogram of the CU, for the FDEs.
+    vector<Dwarf_Addr> funcpcs_;
+    // Subprograms are numbered across all CUs, for their names.
+    unsigned nextfuncnum_;
+    // DIE 'offsets' are ordinals. Nothing
+    // in ireptodbg.cc depends on them being real.
+    Dwarf_Unsigned nextglobaloff_;
+    Dwarf_Unsigned nextcuoff_;
+    // DIEs still to be created in the current CU.
+    unsigned remaining_;
+};
+
+bool
+setSyntheticAttrMix(SyntheticParams &params,
+    const std::string &mix)
+{
+    if (mix == "minimal") {
+        params.attrmix = SynAttrMinimal;
+        return true;
+    }
+    if (mix == "typical") {
+        params.attrmix = SynAttrTypical;
+        return true;
+    }
+    if (mix == "full") {
+        params.attrmix = SynAttrFull;
+        return true;
+    }
+    return false;
+}
+
+static IRDie &
+newChildDie(SyntheticState &st, IRDie &parent, Dwarf_Half tag)
+{
+    IRDie child;
+    parent.addChild(child);
+    IRDie &ch = parent.lastChild();
+    ch.setBaseData(tag,st.nextglobaloff_,st.nextcuoff_);
+    ++st.nextglobaloff_;
+    ++st.nextcuoff_;
+    return ch;
+}
+
+static void
+addStringAttr(IRDie &die, Dwarf_Half attrnum, const string &s)
+{
+    IRAttr attr(attrnum,DW_FORM_string,DW_FORM_string);
+    attr.setFormClass(DW_FORM_CLASS_STRING);
+    IRFormString *f = new IRFormString();
+    f->setInitialForm(DW_FORM_string);
+    f->setFinalForm(DW_FORM_string);
+    f->setString(s.c_str());
+    attr.setFormData(f);
+    die.getAttributes().push_back(attr);
+}
+
+static void
+addConstAttr(IRDie &die, Dwarf_Half attrnum, Dwarf_Half form,
+    Dwarf_Unsigned val)
+{
+    IRAttr attr(attrnum,form,form);
+    attr.setFormClass(DW_FORM_CLASS_CONSTANT);
+    IRFormConstant *f = new IRFormConstant(form,form,
+        DW_FORM_CLASS_CONSTANT,
+        IRFormConstant::UNSIGNED,
+        val,0);
+    attr.setFormData(f);
+    die.getAttributes().push_back(attr);
+}
+
+static void
+addFlagAttr(IRDie &die, Dwarf_Half attrnum)
+{
+    IRAttr attr(attrnum,DW_FORM_flag,DW_FORM_flag);
+    attr.setFormClass(DW_FORM_CLASS_FLAG);
+    IRFormFlag *f = new IRFormFlag();
+    f->setInitialForm(DW_FORM_flag);
+    f->setFinalForm(DW_FORM_flag);
+    f->setFlagVal(1);
+    attr.setFormData(f);
+    die.getAttributes().push_back(attr);
+}
+
+static void
+addAddrAttr(IRDie &die, Dwarf_Half attrnum, Dwarf_Addr addr)
+{
+    IRAttr attr(attrnum,DW_FORM_addr,DW_FORM_addr);
+    attr.setFormClass(DW_FORM_CLASS_ADDRESS);
+    IRFormAddress *f = new IRFormAddress();
+    f->setInitialForm(DW_FORM_addr);
+    f->setFinalForm(DW_FORM_addr);
+    f->setAddress(addr);
+    attr.setFormData(f);
+    die.getAttributes().push_back(attr);
+}
+
+static void
+addBlockAttr(IRDie &die, Dwarf_Half attrnum,
+    Dwarf_Small *bytes, Dwarf_Unsigned len)
+{
+    IRAttr attr(attrnum,DW_FORM_block1,DW_FORM_block1);
+    attr.setFormClass(DW_FORM_CLASS_BLOCK);
+    IRFormBlock *f = new IRFormBlock();
+    f->setInitialForm(DW_FORM_block1);
+    f->setFinalForm(DW_FORM_block1);
+    Dwarf_Block bl;
+    bl.bl_len = len;
+    bl.bl_data = bytes;
+    bl.bl_from_loclist = false;
+    bl.bl_section_offset = 0;
+    f->insertBlock(&bl);
+    attr.setFormData(f);
+    die.getAttributes().push_back(attr);
+}
+
+// The target is already in its final place in its
+// std::list, so the pointer stays valid.
+static void
+addTypeRefAttr(IRDie &die, IRDie *target)
+{
+    IRAttr attr(DW_AT_type,DW_FORM_ref4,DW_FORM_ref4);
+    attr.setFormClass(DW_FORM_CLASS_REFERENCE);
+    IRFormReference *r = new IRFormReference();
+    r->setInitialForm(DW_FORM_ref4);
+    r->setFinalForm(DW_FORM_ref4);
+    r->setCUOffset(target->getCURelativeOffset());
+    r->setTargetInDie(target);
+    attr.setFormData(r);
+    die.getAttributes().push_back(attr);
+}
+
+// DWARF2 and 3 high_pc is an address, DWARF4 and later
+// we use the offset-from-low_pc constant form.
+static void
+addPcRange(const SyntheticParams &params, IRDie &die,
+    Dwarf_Addr lowpc, Dwarf_Addr highpc)
+{
+    addAddrAttr(die,DW_AT_low_pc,lowpc);
+    if (params.dwarfversion >= 4) {
+        addConstAttr(die,DW_AT_high_pc,DW_FORM_udata,highpc - lowpc);
+    } else {
+        addAddrAttr(die,DW_AT_high_pc,highpc);
+    }
+}
+
+static void
+addDecl(const SyntheticParams &params, IRDie &die,
+    Dwarf_Unsigned line)
+{
+    if (params.attrmix < SynAttrTypical) {
+        return;
+    }
+    addConstAttr(die,DW_AT_decl_file,DW_FORM_data4,1);
+    addConstAttr(die,DW_AT_decl_line,DW_FORM_data4,line);
+}
+
+static void
+addVariable(const SyntheticParams &params, SyntheticState &st,
+    IRDie &parent, unsigned cuindex, unsigned varindex,
+    IRDie *inttype)
+{
+    IRDie &var = newChildDie(st,parent,DW_TAG_variable);
+    --st.remaining_;
+    string name = BldName(BldName("v",cuindex) + "_",st.nextcuoff_);
+    addStringAttr(var,DW_AT_name,name);
+    addDecl(params,var,st.nextcuoff_);
+    if (params.attrmix >= SynAttrTypical) {
+        addTypeRefAttr(var,inttype);
+    }
+    if (params.attrmix >= SynAttrFull) {
+        // DW_OP_fbreg -8*(n+1)
+        Dwarf_Small expr[16];
+        int nbytes = 0;
+        Dwarf_Signed fboff = -8 * (Dwarf_Signed)(varindex+1);
+
+        expr[0] = DW_OP_fbreg;
+        int res = dwarf_encode_signed_leb128(fboff,&nbytes,
+            (char *)(expr+1),(int)sizeof(expr) -1);
+        if (res != DW_DLV_OK) {
+            cerr << "dwarfgen: Unable to encode fbreg offset" << endl;
+            exit(1);
+        }
+        addBlockAttr(var,DW_AT_location,expr,1+nbytes);
+    }
+}
+
+// Fill one scope (subprogram or lexical block) whose
+// children are at 'level' below the CU DIE.
+static void
+populateScope(const SyntheticParams &params, SyntheticState &st,
+    IRDie &scope, unsigned cuindex, unsigned level,
+    Dwarf_Addr lowpc, Dwarf_Addr highpc, IRDie *inttype)
+{
+    for (unsigned v = 0; v < SYN_VARS_PER_SCOPE && st.remaining_; ++v) {
+        addVariable(params,st,scope,cuindex,v,inttype);
+    }
+    if (level >= params.treedepth || !st.remaining_) {
+        return;
+    }
+    IRDie &block = newChildDie(st,scope,DW_TAG_lexical_block);
+    --st.remaining_;
+    // Keep every nested block inside its parent range.
+    Dwarf_Addr inset = (level < 7)? level*4 : 7*4;
+    Dwarf_Addr blow = lowpc + inset;
+    Dwarf_Addr bhigh = highpc - inset;
+    if (params.attrmix >= SynAttrFull) {
+        addPcRange(params,block,blow,bhigh);
+    }
+    populateScope(params,st,block,cuindex,level+1,blow,bhigh,inttype);
+}
+
+static void
+createSyntheticLines(const SyntheticParams &params,
+    IRCUdata &cu, unsigned cuindex,
+    Dwarf_Addr culow, Dwarf_Addr cuhigh)
+{
+    if (!params.linerows) {
+        return;
+    }
+    std::vector<IRCULine> &lines = cu.getCULines().get_cu_lines();
+    string srcname = BldName("gen_cu",cuindex) + ".c";
+    string hdrname = BldName("gen_cu",cuindex) + ".h";
+    // The last row is always the end_sequence.
+    unsigned rows = (params.linerows < 2)? 2 : params.linerows;
+
+    lines.reserve(rows);
+    for (unsigned r = 0; r < rows -1; ++r) {
+        Dwarf_Addr addr = culow + r*SYN_LINE_STEP;
+        // Every eighth row pretends to come from a header.
+        bool inhdr = (r%8) == 7;
+        IRCULine line(addr,r == 0,
+            inhdr?2:1,
+            10 + r,
+            (r%4) + 1,
+            inhdr?hdrname:srcname,
+            true,false,false,
+            r == 0,false,
+            0,0);
+        lines.push_back(line);
+    }
+    IRCULine endseq(cuhigh,false,1,10 + rows -1,0,srcname,
+        false,false,true,false,false,0,0);
+    lines.push_back(endseq);
+}
+
+static void
+createSyntheticCU(const SyntheticParams &params, SyntheticState &st,
+    IRepresentation &irep, unsigned cuindex)
+{
+    IRDInfo &info = irep.infodata();
+    IRCUdata newcu(0,params.dwarfversion,0,params.addresssize,4,0,0);
+    info.getCUData().push_back(newcu);
+    IRCUdata &cu = info.lastCU();
+    IRDie &cudie = cu.baseDie();
+    Dwarf_Addr culow = st.nextpc_;
+
+    st.nextcuoff_ = 0;
+    st.remaining_ = (params.diespercu < 2)? 0 : params.diespercu -2;
+    cudie.setBaseData(DW_TAG_compile_unit,st.nextglobaloff_,
+        st.nextcuoff_);
+    ++st.nextglobaloff_;
+    ++st.nextcuoff_;
+    addStringAttr(cudie,DW_AT_name,BldName("gen_cu",cuindex) + ".c");
+    addStringAttr(cudie,DW_AT_producer,"dwarfgen synthetic");
+    addStringAttr(cudie,DW_AT_comp_dir,"/tmp/dwarfgen");
+    addConstAttr(cudie,DW_AT_language,DW_FORM_data1,DW_LANG_C99);
+
+    IRDie &inttype = newChildDie(st,cudie,DW_TAG_base_type);
+    addStringAttr(inttype,DW_AT_name,"int");
+    addConstAttr(inttype,DW_AT_byte_size,DW_FORM_data1,4);
+    addConstAttr(inttype,DW_AT_encoding,DW_FORM_data1,DW_ATE_signed);
+
+    while (st.remaining_) {
+        IRDie &func = newChildDie(st,cudie,DW_TAG_subprogram);
+        --st.remaining_;
+        Dwarf_Addr lowpc = st.nextpc_;
+        Dwarf_Addr highpc = lowpc + SYN_FUNC_SIZE;
+
+        st.nextpc_ = highpc;
+        st.funcpcs_.push_back(lowpc);
+        ++st.nextfuncnum_;
+        string name = BldName(BldName("f",cuindex) + "_",
+            st.nextfuncnum_);
+        addStringAttr(func,DW_AT_name,name);
+        addDecl(params,func,st.nextcuoff_);
+        if (params.attrmix >= SynAttrTypical) {
+            addFlagAttr(func,DW_AT_external);
+            addTypeRefAttr(func,&inttype);
+        }
+        if (params.attrmix >= SynAttrFull) {
+            Dwarf_Small cfa = DW_OP_call_frame_cfa;
+
+            addPcRange(params,func,lowpc,highpc);
+            addBlockAttr(func,DW_AT_frame_base,&cfa,1);
+        }
+        if (params.treedepth > 1) {
+            populateScope(params,st,func,cuindex,2,lowpc,highpc,
+                &inttype);
+        }
+    }
+
+    // The CU covers its functions and its line rows,
+    // whichever extends further.
+    Dwarf_Addr cuhigh = culow + params.linerows*SYN_LINE_STEP;
+    if (st.nextpc_ > cuhigh) {
+        cuhigh = st.nextpc_;
+    }
+    if (cuhigh == culow) {
+        cuhigh = culow + SYN_LINE_STEP;
+    }
+    st.nextpc_ = cuhigh;
+    if (params.attrmix >= SynAttrFull) {
+        addPcRange(params,cudie,culow,cuhigh);
+    }
+    createSyntheticLines(params,cu,cuindex,culow,cuhigh);
+}
+
+// One CIE, and FDEs over the subprograms of the CU just
+// built (then over made-up code right after the CU if
+// asked for more FDEs than it has subprograms).
+static void
+createSyntheticFrames(const SyntheticParams &params,
+    SyntheticState &st, IRepresentation &irep)
+{
+    if (!params.fdecount) {
+        return;
+    }
+    // DW_CFA_def_cfa r7 8, DW_CFA_offset r16 1 (x86_64 style).
+    Dwarf_Small cieinstrs[] = {0x0c,0x07,0x08,0x90,0x01};
+    // DW_CFA_advance_loc 1, DW_CFA_def_cfa_offset 16,
+    // DW_CFA_offset r6 2, DW_CFA_advance_loc 3,
+    // DW_CFA_def_cfa_register r6.
+    Dwarf_Small fdeinstrs[] = {0x41,0x0e,0x10,0x86,0x02,0x43,0x0d,0x06};
+    IRCie cie(0,1,"",1,-8,16,cieinstrs,sizeof(cieinstrs));
+    irep.framedata().insert_cie(cie);
+
+    Dwarf_Addr extrapc = st.nextpc_;
+    for (unsigned i = 0; i < params.fdecount; ++i) {
+        Dwarf_Addr lowpc = 0;
+        if (i < st.funcpcs_.size()) {
+            lowpc = st.funcpcs_[i];
+        } else {
+            lowpc = extrapc;
+            extrapc += SYN_FUNC_SIZE;
+        }
+        IRFde fde(lowpc,SYN_FUNC_SIZE,0,0,0,0,0);
+        fde.get_fde_instrs_into_ir(fdeinstrs,sizeof(fdeinstrs));
+        irep.framedata().insert_fde(fde);
+    }
+    st.nextpc_ = extrapc;
+}
+
+// Every CU has the same shape (only its names differ),
+// so building CU 0 once tells how much of the address
+// space, the DIE numbering and the subprogram numbering
+// each CU takes.
+// The address span includes the made-up code for any
+// FDEs beyond the CU's subprograms, so no two CUs'
+// FDEs overlap.
+struct SyntheticCUShape {
+    SyntheticCUShape(): pcspan_(0),dies_(0),funcs_(0) {};
+    Dwarf_Addr pcspan_;
+    Dwarf_Unsigned dies_;
+    unsigned funcs_;
+};
+
+static void
+measureSyntheticCU(const SyntheticParams &params,
+    SyntheticCUShape &shape)
+{
+    SyntheticState st;
+    IRepresentation scratch;
+
+    createSyntheticCU(params,st,scratch,0);
+    shape.pcspan_ = st.nextpc_ - SYN_TEXT_BASE;
+    if (params.fdecount > st.funcpcs_.size()) {
+        shape.pcspan_ += (params.fdecount - st.funcpcs_.size())*
+            SYN_FUNC_SIZE;
+    }
+    shape.dies_ = st.nextglobaloff_;
+    shape.funcs_ = st.nextfuncnum_;
+}
+
+// The producer writes a single CU, so only CU 'selectedcu'
+// of the params.cucount CUs is built. It gets exactly the
+// names, addresses and DIE numbers it would have had with
+// all of them built, and its object's FDEs cover only
+// its own subprograms.
+void
+createIrepSynthetic(const SyntheticParams &params,
+   unsigned selectedcu,
+   IRepresentation & irep)
+{
+    SyntheticState st;
+    SyntheticCUShape shape;
+
+    if (!params.cucount) {
+        cerr << "dwarfgen: --gen-cus must be at least 1" << endl;
+        exit(1);
+    }
+    if (selectedcu >= params.cucount) {
+        cerr << "dwarfgen: -c " << selectedcu <<
+            " is not a CU number below --gen-cus " <<
+            params.cucount << endl;
+        exit(1);
+    }
+    measureSyntheticCU(params,shape);
+    st.nextpc_ = SYN_TEXT_BASE + selectedcu*shape.pcspan_;
+    st.nextglobaloff_ = selectedcu*shape.dies_;
+    st.nextfuncnum_ = selectedcu*shape.funcs_;
+    createSyntheticCU(params,st,irep,selectedcu);
+    createSyntheticFrames(params,st,irep);
+}
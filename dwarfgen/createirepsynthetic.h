@@ -0,0 +1,75 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  Redistribution and use in source and binary forms, with or without
+  modification, are permitted provided that the following conditions are met:
+  * Redistributions of source code must retain the above copyright
+    notice, this list of conditions and the following disclaimer.
+  * Redistributions in binary form must reproduce the above copyright
+    notice, this list of conditions and the following disclaimer in the
+    documentation and/or other materials provided with the distribution.
+  * Neither the name of the example nor the
+    names of its contributors may be used to endorse or promote products
+    derived from this software without specific prior written permission.
+
+  THIS SOFTWARE IS PROVIDED BY the libdwarf contributors ''AS IS'' AND ANY
+  EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+  WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+  DISCLAIMED. IN NO EVENT SHALL the libdwarf contributors BE LIABLE FOR ANY
+  DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+  (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+  LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+  ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+  (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+  SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+// createirepsynthetic.h
+//
+// Scale knobs for building an IRepresentation out of nothing
+// (dwarfgen -t gen) so libdwarf can be exercised on
+// arbitrarily large, but predictable, DWARF.
+
+enum SyntheticAttrMix {
+    // DW_AT_name (and what a base type must have) only.
+    SynAttrMinimal,
+    // Adds decl_file/decl_line, DW_AT_type references
+    // and DW_AT_external.
+    SynAttrTypical,
+    // Adds pc ranges, frame base and location blocks.
+    SynAttrFull
+};
+
+struct SyntheticParams {
+    SyntheticParams():
+        cucount(1),
+        diespercu(64),
+        treedepth(3),
+        attrmix(SynAttrTypical),
+        dwarfversion(2),
+        addresssize(4),
+        linerows(32),
+        fdecount(8)
+        {};
+    unsigned cucount;
+    // Including the CU DIE itself.
+    unsigned diespercu;
+    // Nesting below the CU DIE. 1 means subprograms only.
+    unsigned treedepth;
+    enum SyntheticAttrMix attrmix;
+    unsigned dwarfversion;
+    unsigned addresssize;
+    // Line table rows per CU.
+    unsigned linerows;
+    // FDEs per CU in .debug_frame, all sharing one CIE.
+    unsigned fdecount;
+};
+
+bool setSyntheticAttrMix(SyntheticParams &params,
+    const std::string &mix);
+// Builds only CU 'selectedcu' (below params.cucount)
+// into irep, as its CU 0.
+void createIrepSynthetic(const SyntheticParams &params,
+   unsigned selectedcu,
+   IRepresentation & irep);
@@ -43,7 +43,7 @@
 // demonstrate the various possibilities using the producer
 // library.
 //
-//  dwarfgen [-t def|obj|txt] [-o outpath] [-c cunum]  path
+//  dwarfgen [-t def|obj|txt|gen] [-o outpath] [-c cunum]  path
 
 //  where -t means what sort of input to read
 //         def means predefined (no input is read, the output
@@ -57,6 +57,9 @@
 //             (in a form rather like output by dwarfdump)
 //             that defines the dwarf that is to be output.
 //
+//         gen means no input is read, the DWARF is synthesized
+//             according to the --gen-* options (for scaling tests).
+//
 //  where  -o means specify the pathname of the output object. If not
 //         supplied testout.o is used as the default output path.
 //  where -c supplies a CU number of the obj input to output
@@ -110,6 +113,7 @@
 #include "irepresentation.h"
 #include "ireptodbg.h"
 #include "createirepfrombinary.h"
+#include "createirepsynthetic.h"
 #ifdef _WIN32
 #ifdef HAVE_STDINT_H
 #include <stdint.h>
@@ -272,7 +276,8 @@ static void write_generated_dbg(Dwarf_P_Debug dbg,Elf * elf,
 
 static string outfile("testout.o");
 static string infile;
-static enum  WhichInputSource { OptNone, OptReadText,OptReadBin,OptPredefined}
+static enum  WhichInputSource { OptNone, OptReadText,OptReadBin,OptPredefined,
+    OptGenerate}
     whichinput(OptPredefined);
 
 /*  Use a generic call to open the file, due to issues with Windows */
@@ -564,6 +569,19 @@ create_dw_elf(SectionFromDwarf  &ds,unsigned elfclass)
 }
 
 
+static unsigned
+getgencount(const char *opt, const char *val, unsigned minval)
+{
+    char *endp = 0;
+    unsigned long v = strtoul(val,&endp,10);
+    if (!*val || *endp || v < minval || v > 0xffffffffUL) {
+        cerr << "dwarfgen: Invalid " << opt << " option input " <<
+            val << endl;
+        exit(1);
+    }
+    return (unsigned)v;
+}
+
 static void
 setinput(enum  WhichInputSource *src,
     const string &type,
@@ -581,8 +599,13 @@ setinput(enum  WhichInputSource *src,
         *src = OptPredefined;
         *pathreq = false;
         return;
+    } else if (type == "gen") {
+        *src = OptGenerate;
+        *pathreq = false;
+        return;
     }
-    cout << "dwarfgen: Giving up, only txt obj or def accepted after -t" << endl;
+    cout << "dwarfgen: Giving up, only txt obj def or gen accepted after -t"
+        << endl;
     exit(1);
 }
 
@@ -593,7 +616,10 @@ main(int argc, char **argv)
         int opt;
         bool pathrequired(false);
         long cu_of_input_we_output = -1;
-        bool force_empty_dnames = false;
+        bool add_debug_names = false;
+        bool dedup_types = false;
+        bool tail_merge_strings = false;
+        SyntheticParams genparams;
 
         // Overriding macro constants from pro_line.h
         // so we can choose at runtime
@@ -623,6 +649,7 @@ main(int argc, char **argv)
         static struct dwoption longopts[] = {
             {"adddata16",dwno_argument,0,1000},
             {"force-empty-dnames",dwno_argument,0,1001},
+            {"add-debug-names",dwno_argument,0,1001},
             {"add-implicit-const",dwno_argument,0,1002},
             {"add-frame-advance-loc",dwno_argument,0,1003},
             {"add-sun-func-offsets",dwno_argument,0,1004},
@@ -634,6 +661,14 @@ main(int argc, char **argv)
             {"default-form-strp",dwno_argument,0,'s'},
             {"show-reloc-details",dwno_argument,0,'r'},
             {"high-pc-as-const",dwno_argument,0,'h'},
+            {"gen-cus",dwrequired_argument,0,1007},
+            {"gen-dies-per-cu",dwrequired_argument,0,1008},
+            {"gen-depth",dwrequired_argument,0,1009},
+            {"gen-attr-mix",dwrequired_argument,0,1010},
+            {"gen-line-rows",dwrequired_argument,0,1011},
+            {"gen-fdes",dwrequired_argument,0,1012},
+            {"dedup-types",dwno_argument,0,1013},
+            {"tail-merge-strings",dwno_argument,0,1014},
             {0,0,0,0},
         };
         // -p is pointer size
@@ -657,10 +692,10 @@ main(int argc, char **argv)
                 }
                 break;
             case 1001:
-                // To test having an empty .debug_dnames
-                // section.
-                // libdwarf reading is thus testable.
-                force_empty_dnames = true;
+                // Emit a .debug_names index of the DIEs
+                // (DWARF5 only). force-empty-dnames is the
+                // older name, from when the section was empty.
+                add_debug_names = true;
                 break;
             case 1002:
                 // To test creating DWARF5
@@ -688,6 +723,48 @@ main(int argc, char **argv)
                 //{"add-debug-sup",dwno_argument,0,1006}
                 cmdoptions.adddebugsup = true;
                 break;
+            case 1007:
+                //{"gen-cus",dwrequired_argument,0,1007}
+                genparams.cucount = getgencount("--gen-cus",
+                    dwoptarg,1);
+                break;
+            case 1008:
+                //{"gen-dies-per-cu",dwrequired_argument,0,1008}
+                genparams.diespercu = getgencount("--gen-dies-per-cu",
+                    dwoptarg,1);
+                break;
+            case 1009:
+                //{"gen-depth",dwrequired_argument,0,1009}
+                genparams.treedepth = getgencount("--gen-depth",
+                    dwoptarg,1);
+                break;
+            case 1010:
+                //{"gen-attr-mix",dwrequired_argument,0,1010}
+                if (!setSyntheticAttrMix(genparams,dwoptarg)) {
+                    cerr << "dwarfgen: Invalid --gen-attr-mix option "
+                        "input " << dwoptarg <<
+                        " (minimal, typical or full)" << endl;
+                    exit(1);
+                }
+                break;
+            case 1011:
+                //{"gen-line-rows",dwrequired_argument,0,1011}
+                genparams.linerows = getgencount("--gen-line-rows",
+                    dwoptarg,0);
+                break;
+            case 1012:
+                //{"gen-fdes",dwrequired_argument,0,1012}
+                genparams.fdecount = getgencount("--gen-fdes",
+                    dwoptarg,0);
+                break;
+            case 1013:
+                //{"dedup-types",dwno_argument,0,1013}
+                dedup_types = true;
+                break;
+            case 1014:
+                //{"tail-merge-strings",dwno_argument,0,1014}
+                tail_merge_strings = true;
+                break;
             case 'c':
                 // At present we can only create a single
                 // cu in the output of the libdwarf producer.
@@ -780,6 +857,21 @@ main(int argc, char **argv)
 
         if(whichinput == OptReadBin) {
             createIrepFromBinary(infile,Irep);
+        } else if (whichinput == OptGenerate) {
+            // dwarf_version is "V2" ... "V5".
+            genparams.dwarfversion = atoi(dwarf_version+1);
+            genparams.addresssize =
+                (ptrsizeflagbit == DW_DLC_POINTER64)? 8 : 4;
+            if (cu_of_input_we_output < 0) {
+                // The producer emits one CU, so unless
+                // -c picked one, emit the first.
+                cu_of_input_we_output = 0;
+            }
+            // Only the CU we emit is built, and it
+            // is the only CU in Irep.
+            createIrepSynthetic(genparams,
+                (unsigned)cu_of_input_we_output,Irep);
+            cu_of_input_we_output = 0;
         } else if (whichinput == OptReadText) {
             cerr << "dwarfgen: dwarfgen: text read not supported yet"
                 << endl;
@@ -847,7 +939,7 @@ main(int argc, char **argv)
                 << endl;
             exit(EXIT_FAILURE);
         }
-        if (force_empty_dnames) {
+        if (add_debug_names) {
             res = dwarf_force_debug_names(dbg,&err);
             if (res != DW_DLV_OK) {
                 cerr << "dwarfgen: "
@@ -856,6 +948,24 @@ main(int argc, char **argv)
                 exit(EXIT_FAILURE);
             }
         }
+        if (dedup_types) {
+            res = dwarf_pro_set_type_dedup(dbg,1,&err);
+            if (res != DW_DLV_OK) {
+                cerr << "dwarfgen: "
+                    "Failed dwarf_pro_set_type_dedup"
+                    << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (tail_merge_strings) {
+            res = dwarf_pro_set_string_tail_merge(dbg,1,&err);
+            if (res != DW_DLV_OK) {
+                cerr << "dwarfgen: "
+                    "Failed dwarf_pro_set_string_tail_merge"
+                    << endl;
+                exit(EXIT_FAILURE);
+            }
+        }
         if(cmdoptions.adddebugsup) { 
             create_debug_sup_content(dbg);
         }
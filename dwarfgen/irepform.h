@@ -117,9 +117,9 @@ public:
     Dwarf_Half getInitialForm() { return initialform_;}
     Dwarf_Half getFinalForm() {return finalform_;}
     Dwarf_Addr  getAddress() { return address_;};
+    void setAddress(Dwarf_Addr addr) { address_ = addr; };
     enum Dwarf_Form_Class getFormClass() const { return formclass_; };
 private:
-    void setAddress(Dwarf_Addr addr) { address_ = addr; };
     Dwarf_Half finalform_;
     // In most cases directform == indirect form.
     // Otherwise, directform == DW_FORM_indirect.
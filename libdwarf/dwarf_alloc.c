@@ -73,6 +73,14 @@
 #include "dwarf_dsc.h"
 #include "dwarfstring.h"
 #include "dwarf_str_offsets.h"
+#include "dwarf_inline.h"
+#include "dwarf_type_cache.h"
+#include "dwarf_pubnames_index.h"
+#include "dwarf_range_iter.h"
+
+#if DWARF_PERF_ALLOC_TYPES != ALLOC_AREA_INDEX_TABLE_MAX
+#error DWARF_PERF_ALLOC_TYPES must equal ALLOC_AREA_INDEX_TABLE_MAX
+#endif
 
 /* if DEBUG is defined a lot of stdout is generated here. */
 #undef DEBUG
@@ -205,6 +213,20 @@ struct reserve_data_s {
 };
 #define DW_RESERVE sizeof(struct reserve_size_s)
 
+/*  Drops the pin on .debug_loc every Dwarf_Locdesc
+    holds, see _dwarf_get_locdesc(). */
+static void
+_dwarf_locdesc_destructor(void *m)
+{
+    struct reserve_data_s *r =
+        (struct reserve_data_s *)((char *)m - DW_RESERVE);
+    Dwarf_Debug dbg = (Dwarf_Debug)r->rd_dbg;
+
+    if (dbg) {
+        _dwarf_unpin_section(&dbg->de_debug_loc);
+    }
+}
+
 
 static const
 struct ial_s alloc_instance_basics[ALLOC_AREA_INDEX_TABLE_MAX] = {
@@ -218,7 +240,8 @@ struct ial_s alloc_instance_basics[ALLOC_AREA_INDEX_TABLE_MAX] = {
     { sizeof(Dwarf_Loc),MULTIPLY_NO, 0, 0} ,
 
     /* x3 DW_DLA_LOCDESC */
-    { sizeof(Dwarf_Locdesc),MULTIPLY_NO, 0, 0},
+    { sizeof(Dwarf_Locdesc),MULTIPLY_NO, 0,
+        _dwarf_locdesc_destructor},
 
     /* 0x4 DW_DLA_ELLIST */ /* not used */
     { 1,MULTIPLY_NO, 0, 0},
@@ -551,6 +574,8 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
         r->rd_dbg = dbg;
         r->rd_type = alloc_type;
         r->rd_length = size;
+        dbg->de_perf_counters.pc_allocs_total++;
+        dbg->de_perf_allocs_by_type[type]++;
         if (alloc_instance_basics[type].specialconstructor) {
             int res = alloc_instance_basics[type].
                 specialconstructor(dbg, ret_mem);
@@ -580,6 +605,7 @@ _dwarf_get_alloc(Dwarf_Debug dbg,
             global_de_alloc_tree_total += size;
             global_de_alloc_tree_count++;
 #endif /* HAVE_GLOBAL_ALLOC_SUMS */
+            dbg->de_perf_counters.pc_tsearch_ops++;
             result = dwarf_tsearch((void *)key,
                 &dbg->de_alloc_tree,simple_compare_function);
             if(!result) {
@@ -617,6 +643,8 @@ string_is_in_debug_section(Dwarf_Debug dbg,void * space)
         It is too late to change the documentation. */
 
     void *result = 0;
+
+    dbg->de_perf_counters.pc_tsearch_ops++;
     result = dwarf_tfind((void *)space,
         &dbg->de_alloc_tree,simple_compare_function);
     if(!result) {
@@ -854,6 +882,7 @@ abort();
             is just a few bytes before 'space'. */
         void *key = space;
 
+        dbg->de_perf_counters.pc_tsearch_ops++;
         dwarf_tdelete(key,&dbg->de_alloc_tree,
             simple_compare_function);
         /*  If dwarf_tdelete returns NULL it might mean
@@ -1020,6 +1049,14 @@ _dwarf_free_all_of_one_debug(Dwarf_Debug dbg)
     }
 
     _dwarf_destroy_group_map(dbg);
+    _dwarf_expr_program_cache_destroy(dbg);
+    _dwarf_macro_unit_cache_destroy(dbg);
+    _dwarf_dnames_sidecar_destroy(dbg);
+    _dwarf_inline_index_destroy(dbg);
+    _dwarf_type_cache_destroy(dbg);
+    _dwarf_pubnames_index_destroy(dbg);
+    _dwarf_range_cache_destroy(dbg);
+    _dwarf_frame_scratch_destroy(dbg);
     /*  de_alloc_tree might be NULL if
         global_de_alloc_tree_on is zero. */
     if (dbg->de_alloc_tree) {
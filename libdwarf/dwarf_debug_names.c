@@ -40,6 +40,7 @@
 #include "dwarf_global.h"
 #include "dwarf_debug_names.h"
 #include "dwarfstring.h"
+#include "pro_dnames.h"
 
 #define FALSE 0
 #define TRUE  1
@@ -161,20 +162,21 @@ fill_in_abbrevs_table(struct Dwarf_Dnames_index_header_s * dn,
             idxcount++;
         }
         curdab->da_pairs_count = idxcount;
-        abcur = inner +1;
+        abcur = inner;
         if (!firstdab) {
             firstdab = curdab;
             lastdab  = curdab;
         } else {
             /* Add new on the end, last */
             lastdab->da_next = curdab;
+            lastdab = curdab;
         }
     }
     if (!foundabend) {
         freedabs(firstdab);
         _dwarf_error(dbg, error,
             DW_DLE_DEBUG_NAMES_ABBREV_CORRUPTION);
-        return DW_DLV_OK;
+        return DW_DLV_ERROR;
     }
     {
         unsigned ct = 0;
@@ -444,7 +446,7 @@ read_a_name_index(Dwarf_Dnames_Head dn,
         }
     }
     di_header->din_cu_list = curptr;
-    curptr +=  dbg->de_length_size * comp_unit_count;
+    curptr +=  local_length_size * comp_unit_count;
     if(curptr > end_dnames) {
         free(di_header->din_augmentation_string);
         free(di_header);
@@ -453,7 +455,7 @@ read_a_name_index(Dwarf_Dnames_Head dn,
     }
     di_header->din_local_tu_list = curptr;
 
-    curptr +=  dbg->de_length_size * local_type_unit_count;
+    curptr +=  local_length_size * local_type_unit_count;
     if(curptr > end_dnames) {
         free(di_header->din_augmentation_string);
         free(di_header);
@@ -478,8 +480,9 @@ read_a_name_index(Dwarf_Dnames_Head dn,
         return DW_DLV_ERROR;
     }
 
+    /*  The hashes are 4 bytes each. */
     di_header->din_hash_table = curptr;
-    curptr +=  sizeof(Dwarf_Sig8) * name_count;
+    curptr +=  DWARF_32BIT_SIZE * name_count;
     if(curptr > end_dnames) {
         free(di_header->din_augmentation_string);
         free(di_header);
@@ -488,7 +491,7 @@ read_a_name_index(Dwarf_Dnames_Head dn,
     }
 
     di_header->din_string_offsets = curptr;
-    curptr +=  DWARF_32BIT_SIZE * name_count;
+    curptr +=  local_length_size * name_count;
     if(curptr > end_dnames) {
         free(di_header->din_augmentation_string);
         free(di_header);
@@ -497,7 +500,7 @@ read_a_name_index(Dwarf_Dnames_Head dn,
     }
 
     di_header->din_entry_offsets = curptr;
-    curptr +=  DWARF_32BIT_SIZE * name_count;
+    curptr +=  local_length_size * name_count;
     if(curptr > end_dnames) {
         free(di_header->din_augmentation_string);
         free(di_header);
@@ -518,7 +521,8 @@ read_a_name_index(Dwarf_Dnames_Head dn,
 
     di_header->din_entry_pool_size = end_dnames - curptr;
 
-    *curptr_in = curptr;
+    /*  The entry pool runs to the end of this name index. */
+    *curptr_in = end_dnames;
     *index_header_out = di_header;
     res = fill_in_abbrevs_table(di_header,error);
     if (res != DW_DLV_OK) {
@@ -567,6 +571,7 @@ dwarf_debugnames_header(Dwarf_Debug dbg,
     Dwarf_Small *curptr = 0;
     struct Dwarf_Dnames_index_header_s *inhdr_last = 0;
     struct Dwarf_Dnames_index_header_s *inhdr_first = 0;
+    struct Dwarf_Dnames_Sidecar_s *sidecar = 0;
     unsigned inhdr_count = 0;
     int res = 0;
 
@@ -576,15 +581,22 @@ dwarf_debugnames_header(Dwarf_Debug dbg,
     }
 
     res = _dwarf_load_section(dbg, &dbg->de_debug_names, error);
-    if (res != DW_DLV_OK) {
+    if (res == DW_DLV_ERROR) {
         return res;
     }
-
-    section_size = dbg->de_debug_names.dss_size;
-    if(!section_size){
-        return DW_DLV_NO_ENTRY;
+    if (res == DW_DLV_OK && dbg->de_debug_names.dss_size) {
+        section_size = dbg->de_debug_names.dss_size;
+        start_section = dbg->de_debug_names.dss_data;
+    } else {
+        /*  No .debug_names, use the sidecar file
+            if dwarf_debugnames_use_sidecar() read one. */
+        sidecar = dbg->de_dnames_sidecar;
+        if (!sidecar) {
+            return DW_DLV_NO_ENTRY;
+        }
+        section_size = sidecar->dsc_names_size;
+        start_section = sidecar->dsc_names;
     }
-    start_section = dbg->de_debug_names.dss_data;
     curptr = start_section;
     end_section = start_section + section_size;
     remaining = section_size;
@@ -598,6 +610,10 @@ dwarf_debugnames_header(Dwarf_Debug dbg,
     dn_header->dn_section_size = section_size;
     dn_header->dn_section_end = start_section + section_size;
     dn_header->dn_dbg = dbg;
+    if (sidecar) {
+        dn_header->dn_strings = sidecar->dsc_strings;
+        dn_header->dn_strings_size = sidecar->dsc_strings_size;
+    }
     for( ; curptr < end_section; ) {
         struct Dwarf_Dnames_index_header_s * index_header = 0;
         Dwarf_Small *curptr_start = curptr;
@@ -621,7 +637,7 @@ dwarf_debugnames_header(Dwarf_Debug dbg,
                 a bunch of zero pad? */
             free_inhdr_list(inhdr_first);
             dwarf_dealloc(dbg,dn_header,DW_DLA_DNAMES_HEAD);
-            break;
+            return res;
         }
         /* Add the new one to the list. */
         if(!inhdr_first) {
@@ -635,7 +651,7 @@ dwarf_debugnames_header(Dwarf_Debug dbg,
             inhdr_count++;
         }
         usedspace = curptr - curptr_start;
-        remaining -= - usedspace;
+        remaining -= usedspace;
         if (remaining < 5) {
             /*  No more in here, just padding. Check for zero
                 in padding. */
@@ -664,13 +680,22 @@ dwarf_debugnames_header(Dwarf_Debug dbg,
         dn_header->dn_inhdr_first =
             (struct Dwarf_Dnames_index_header_s *)
             calloc(inhdr_count,sizeof(struct Dwarf_Dnames_index_header_s));
+        if (!dn_header->dn_inhdr_first) {
+            free_inhdr_list(inhdr_first);
+            dwarf_dealloc(dbg,dn_header,DW_DLA_DNAMES_HEAD);
+            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
         for(n = 0,cur = inhdr_first; cur; ++n ) {
-            /*  We are copying these structs so do not
-                free them at this time. */
+            /*  The contents now belong to the array copy,
+                free only the list node. */
             struct Dwarf_Dnames_index_header_s *tmp = cur->din_next;
             dn_header->dn_inhdr_first[n] = *cur;
+            dn_header->dn_inhdr_first[n].din_next = 0;
+            free(cur);
             cur = tmp;
         }
+        dn_header->dn_inhdr_count = inhdr_count;
     }
     *dn_out = dn_header;
     *dn_count_out = inhdr_count;
@@ -881,8 +906,8 @@ dwarf_debugnames_foreign_tu_entry(Dwarf_Dnames_Head dn,
 
     if (signature) {
         Dwarf_Small *ptr = cur->din_foreign_tu_list +
-            sig_number *cur->din_offset_size;
-        Dwarf_Small *endptr = cur->din_hash_table;
+            (sig_number - legal_low) * sizeof(Dwarf_Sig8);
+        Dwarf_Small *endptr = cur->din_buckets;
         if((ptr +sizeof(Dwarf_Sig8)) > endptr) {
             _dwarf_error(dbg, error, DW_DLE_DEBUG_NAMES_BAD_INDEX_ARG);
             return DW_DLV_ERROR;
@@ -943,7 +968,31 @@ int dwarf_debugnames_bucket(Dwarf_Dnames_Head dn,
     return DW_DLV_OK;
 }
 
-/*  Access to the .debug_names name table. */
+/*  The string offset of a name table entry: into
+    .debug_str, or into the string area of a sidecar. */
+static int
+name_string_offset(Dwarf_Dnames_Head dn,
+    struct Dwarf_Dnames_index_header_s *cur,
+    Dwarf_Unsigned name_entry,
+    Dwarf_Unsigned *offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned offsetval = 0;
+    Dwarf_Small *ptr = cur->din_string_offsets +
+        name_entry * cur->din_offset_size;
+    Dwarf_Small *endptr = cur->din_entry_offsets;
+
+    READ_UNALIGNED_CK(dbg, offsetval, Dwarf_Unsigned,
+        ptr, cur->din_offset_size,
+        error,endptr);
+    *offset_out = offsetval;
+    return DW_DLV_OK;
+}
+
+/*  Access to the .debug_names name table.
+    A sidecar index has no .debug_str offsets to
+    return, see dwarf_debugnames_name_string(). */
 int
 dwarf_debugnames_name(Dwarf_Dnames_Head dn,
     Dwarf_Unsigned      index_number,
@@ -967,41 +1016,52 @@ dwarf_debugnames_name(Dwarf_Dnames_Head dn,
 
     if (name_entry >= cur->din_name_count) {
         if (names_count) {
-            *names_count = cur->din_bucket_count;
+            *names_count = cur->din_name_count;
         }
         return DW_DLV_NO_ENTRY;
     }
 
     if (signature) {
+        /*  The 4-byte hash of the name, least significant
+            byte first, the rest zero. */
+        Dwarf_Unsigned hashval = 0;
         Dwarf_Small *ptr = cur->din_hash_table +
-            name_entry *sizeof(Dwarf_Sig8);
-        Dwarf_Small *endptr = cur->din_string_offsets;
-        if ((ptr + sizeof(Dwarf_Sig8)) > endptr) {
-            _dwarf_error(dbg, error, DW_DLE_DEBUG_NAMES_BAD_INDEX_ARG);
-            return DW_DLV_ERROR;
-        }
-        memcpy(signature,ptr,sizeof(Dwarf_Sig8));
-    }
-
-    if (offset_to_debug_str) {
-        Dwarf_Unsigned offsetval = 0;
-        Dwarf_Small *ptr = cur->din_string_offsets +
             name_entry * DWARF_32BIT_SIZE;
-        Dwarf_Small *endptr = cur->din_abbreviations;
+        Dwarf_Small *endptr = cur->din_string_offsets;
 
-        READ_UNALIGNED_CK(dbg, offsetval, Dwarf_Unsigned,
+        READ_UNALIGNED_CK(dbg, hashval, Dwarf_Unsigned,
             ptr, DWARF_32BIT_SIZE,
             error,endptr);
-        *offset_to_debug_str = offsetval;
+        memset(signature,0,sizeof(Dwarf_Sig8));
+        signature->signature[0] = hashval & 0xff;
+        signature->signature[1] = (hashval >> 8) & 0xff;
+        signature->signature[2] = (hashval >> 16) & 0xff;
+        signature->signature[3] = (hashval >> 24) & 0xff;
+    }
+
+    if (offset_to_debug_str) {
+        if (dn->dn_strings) {
+            _dwarf_error_string(dbg, error,
+                DW_DLE_DEBUG_NAMES_SIDECAR_ERROR,
+                "DW_DLE_DEBUG_NAMES_SIDECAR_ERROR: the names of "
+                "a sidecar index are not in .debug_str, "
+                "use dwarf_debugnames_name_string()");
+            return DW_DLV_ERROR;
+        }
+        res = name_string_offset(dn,cur,name_entry,
+            offset_to_debug_str,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
     }
     if (offset_in_entrypool) {
         Dwarf_Unsigned offsetval = 0;
         Dwarf_Small *ptr = cur->din_entry_offsets +
-            name_entry * DWARF_32BIT_SIZE;
+            name_entry * cur->din_offset_size;
         Dwarf_Small *endptr = cur->din_abbreviations;
 
         READ_UNALIGNED_CK(dbg, offsetval, Dwarf_Unsigned,
-            ptr, DWARF_32BIT_SIZE,
+            ptr, cur->din_offset_size,
             error,endptr);
         *offset_in_entrypool = offsetval;
     }
@@ -1167,7 +1227,7 @@ dwarf_debugnames_abbrev_form_by_index(Dwarf_Dnames_Head dn,
     if (abbrev_form_index >= abbrev->da_pairs_count) {
         return DW_DLV_NO_ENTRY;
     }
-    ap = abbrev->da_pairs + abbrev_entry_index;
+    ap = abbrev->da_pairs + abbrev_form_index;
     if(name_index_attr) {
         *name_index_attr = ap->ap_index;
     }
@@ -1233,6 +1293,23 @@ int dwarf_debugnames_entrypool(Dwarf_Dnames_Head dn,
 }
 
 
+/*  DW_IDX_die_offset values are usually a reference
+    form (relative to the unit), decoded like the data
+    form of the same size. */
+static unsigned
+dnames_value_form(unsigned form)
+{
+    switch (form) {
+    case DW_FORM_ref1: return DW_FORM_data1;
+    case DW_FORM_ref2: return DW_FORM_data2;
+    case DW_FORM_ref4: return DW_FORM_data4;
+    case DW_FORM_ref8: return DW_FORM_data8;
+    case DW_FORM_ref_udata: return DW_FORM_udata;
+    default: break;
+    }
+    return form;
+}
+
 /*  Caller, knowing array size needed, passes in arrays
     it allocates of for idx, form, offset-size-values,
     and signature values.  Caller must examine idx-number
@@ -1282,7 +1359,7 @@ int dwarf_debugnames_entrypool_values(Dwarf_Dnames_Head dn,
     }
     poolptr = cur->din_entry_pool + offset_in_entrypool_of_values;
     abbrev = cur->din_abbrev_list + index_of_abbrev;
-    abcount = cur->din_abbrev_list_count;
+    abcount = abbrev->da_pairs_count;
     for(n = 0; n < abcount ; ++n) {
         struct abbrev_pair_s *abp = abbrev->da_pairs +n;
         unsigned idxtype = abp->ap_index;
@@ -1301,10 +1378,11 @@ int dwarf_debugnames_entrypool_values(Dwarf_Dnames_Head dn,
             poolptr += sizeof(Dwarf_Sig8);
             pooloffset += sizeof(Dwarf_Sig8);
             continue;
-        } else if (_dwarf_allow_formudata(form)) {
+        } else if (_dwarf_allow_formudata(dnames_value_form(form))) {
             Dwarf_Unsigned val = 0;
             Dwarf_Unsigned bytesread = 0;
-            res = _dwarf_formudata_internal(dbg,form,poolptr,
+            res = _dwarf_formudata_internal(dbg,
+                dnames_value_form(form),poolptr,
                 endpool,&val,&bytesread,error);
             if(res != DW_DLV_OK) {
                 return res;
@@ -1342,6 +1420,343 @@ int dwarf_debugnames_entrypool_values(Dwarf_Dnames_Head dn,
 
 
 
+/*  Finds the string a name table string offset refers to:
+    in the sidecar string area or in .debug_str. */
+static int
+dnames_string_at(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned offset,
+    const char **string_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+    char *str = 0;
+    Dwarf_Signed len = 0;
+    int res = 0;
+
+    if (dn->dn_strings) {
+        /*  The area ends in a NUL, checked when loaded. */
+        if (offset >= dn->dn_strings_size) {
+            _dwarf_error(dbg, error,
+                DW_DLE_DEBUG_NAMES_SIDECAR_ERROR);
+            return DW_DLV_ERROR;
+        }
+        *string_out = (const char *)(dn->dn_strings + offset);
+        return DW_DLV_OK;
+    }
+    res = dwarf_get_str(dbg,offset,&str,&len,error);
+    if (res == DW_DLV_NO_ENTRY) {
+        _dwarf_error(dbg, error, DW_DLE_DEBUG_STR_OFFSET_BAD);
+        return DW_DLV_ERROR;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *string_out = str;
+    return DW_DLV_OK;
+}
+
+/*  Like dwarf_debugnames_name() but returns the name
+    itself, wherever the string is. */
+int
+dwarf_debugnames_name_string(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned      index_number,
+    Dwarf_Unsigned      name_entry,
+    const char       ** name,
+    Dwarf_Error *       error)
+{
+    struct Dwarf_Dnames_index_header_s *cur = 0;
+    Dwarf_Unsigned stroff = 0;
+    int res = 0;
+
+    res = dwarf_debugnames_name(dn,index_number,name_entry,
+        0,0,0,0,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = get_inhdr_cur(dn,index_number,&cur,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = name_string_offset(dn,cur,name_entry,&stroff,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return dnames_string_at(dn,stroff,name,error);
+}
+
+struct dnames_match_list_s {
+    Dwarf_Dnames_Match *ml_matches;
+    Dwarf_Unsigned      ml_count;
+    Dwarf_Unsigned      ml_allocated;
+};
+
+static int
+dnames_add_match(Dwarf_Debug dbg,
+    struct dnames_match_list_s *ml,
+    Dwarf_Unsigned tag,
+    Dwarf_Unsigned unit_offset,
+    Dwarf_Unsigned die_offset,
+    Dwarf_Bool is_type_unit,
+    Dwarf_Error *error)
+{
+    Dwarf_Dnames_Match *m = 0;
+
+    if (ml->ml_count >= ml->ml_allocated) {
+        Dwarf_Unsigned newcount = ml->ml_allocated?
+            2*ml->ml_allocated:8;
+        Dwarf_Dnames_Match *newm = 0;
+
+        newm = (Dwarf_Dnames_Match *)realloc(ml->ml_matches,
+            newcount*sizeof(Dwarf_Dnames_Match));
+        if (!newm) {
+            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+        ml->ml_matches = newm;
+        ml->ml_allocated = newcount;
+    }
+    m = ml->ml_matches + ml->ml_count;
+    ml->ml_count++;
+    m->dm_tag = tag;
+    m->dm_unit_offset = unit_offset;
+    m->dm_die_offset = unit_offset + die_offset;
+    m->dm_is_type_unit = is_type_unit;
+    return DW_DLV_OK;
+}
+
+/*  Adds every entry of one name to the match list.
+    Entries for foreign type units (in some other object)
+    and entries that do not say which unit they are in
+    are skipped. */
+static int
+dnames_collect_entries(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned index_number,
+    struct Dwarf_Dnames_index_header_s *cur,
+    Dwarf_Unsigned pooloffset,
+    struct dnames_match_list_s *ml,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = dn->dn_dbg;
+
+    for (;;) {
+        Dwarf_Unsigned abbrev_code = 0;
+        Dwarf_Unsigned tag = 0;
+        Dwarf_Unsigned value_count = 0;
+        Dwarf_Unsigned index_of_abbrev = 0;
+        Dwarf_Unsigned valoffset = 0;
+        Dwarf_Unsigned idx[ABB_PAIRS_MAX];
+        Dwarf_Unsigned forms[ABB_PAIRS_MAX];
+        Dwarf_Unsigned values[ABB_PAIRS_MAX];
+        Dwarf_Sig8     sigs[ABB_PAIRS_MAX];
+        Dwarf_Unsigned unit_index = 0;
+        Dwarf_Unsigned die_offset = 0;
+        Dwarf_Unsigned unit_offset = 0;
+        Dwarf_Bool have_cu = FALSE;
+        Dwarf_Bool have_tu = FALSE;
+        Dwarf_Bool have_die = FALSE;
+        Dwarf_Unsigned n = 0;
+        int res = 0;
+
+        res = dwarf_debugnames_entrypool(dn,index_number,
+            pooloffset,&abbrev_code,&tag,&value_count,
+            &index_of_abbrev,&valoffset,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            /*  The 0 that ends the list for this name. */
+            return DW_DLV_OK;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_debugnames_entrypool_values(dn,index_number,
+            index_of_abbrev,valoffset,idx,forms,values,sigs,
+            &pooloffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        for (n = 0; n < value_count; ++n) {
+            switch (idx[n]) {
+            case DW_IDX_compile_unit:
+                unit_index = values[n];
+                have_cu = TRUE;
+                break;
+            case DW_IDX_type_unit:
+                unit_index = values[n];
+                have_tu = TRUE;
+                break;
+            case DW_IDX_die_offset:
+                die_offset = values[n];
+                have_die = TRUE;
+                break;
+            default:
+                break;
+            }
+        }
+        if (!have_die) {
+            continue;
+        }
+        if (!have_cu && !have_tu) {
+            /*  A single-unit index may omit the unit. */
+            if (cur->din_comp_unit_count == 1 &&
+                !cur->din_local_type_unit_count) {
+                have_cu = TRUE;
+            } else if (!cur->din_comp_unit_count &&
+                cur->din_local_type_unit_count == 1) {
+                have_tu = TRUE;
+            } else {
+                continue;
+            }
+        }
+        if (have_tu) {
+            if (unit_index >= cur->din_local_type_unit_count) {
+                continue;
+            }
+            res = dwarf_debugnames_local_tu_entry(dn,index_number,
+                unit_index,0,&unit_offset,error);
+        } else {
+            res = dwarf_debugnames_cu_entry(dn,index_number,
+                unit_index,0,&unit_offset,error);
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dnames_add_match(dbg,ml,tag,unit_offset,
+            die_offset,have_tu,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+static int
+dnames_lookup_in_index(Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned index_number,
+    const char *name,
+    Dwarf_Unsigned hash,
+    struct dnames_match_list_s *ml,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Dnames_index_header_s *cur = 0;
+    Dwarf_Debug dbg = dn->dn_dbg;
+    Dwarf_Unsigned bucket = 0;
+    Dwarf_Unsigned n = 0;
+    int res = 0;
+
+    res = get_inhdr_cur(dn,index_number,&cur,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (cur->din_bucket_count) {
+        Dwarf_Unsigned first = 0;
+
+        bucket = hash % cur->din_bucket_count;
+        res = dwarf_debugnames_bucket(dn,index_number,bucket,
+            0,&first,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!first) {
+            return DW_DLV_OK;
+        }
+        /*  Bucket contents are 1-based name indexes. */
+        n = first - 1;
+    }
+    for ( ; n < cur->din_name_count; ++n) {
+        Dwarf_Unsigned namehash = 0;
+        Dwarf_Unsigned stroff = 0;
+        Dwarf_Unsigned pooloffset = 0;
+        Dwarf_Small *ptr = cur->din_hash_table +
+            n * DWARF_32BIT_SIZE;
+        const char *str = 0;
+
+        READ_UNALIGNED_CK(dbg, namehash, Dwarf_Unsigned,
+            ptr, DWARF_32BIT_SIZE,
+            error,cur->din_string_offsets);
+        if (cur->din_bucket_count &&
+            (namehash % cur->din_bucket_count) != bucket) {
+            /*  Past the end of this bucket. */
+            break;
+        }
+        if (namehash != hash) {
+            continue;
+        }
+        res = dwarf_debugnames_name(dn,index_number,n,
+            0,0,0,&pooloffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = name_string_offset(dn,cur,n,&stroff,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dnames_string_at(dn,stroff,&str,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (strcmp(str,name)) {
+            continue;
+        }
+        res = dnames_collect_entries(dn,index_number,cur,
+            pooloffset,ml,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Looks up an exact (case-sensitive) name in every
+    name index of the head using the hash table.
+    On success *matches_out is a malloc'd array the
+    caller frees with dwarf_dealloc_debugnames_matches().
+    Returns DW_DLV_NO_ENTRY if the name is not indexed. */
+int
+dwarf_debugnames_lookup(Dwarf_Dnames_Head dn,
+    const char *          name,
+    Dwarf_Dnames_Match ** matches_out,
+    Dwarf_Unsigned *      match_count_out,
+    Dwarf_Error *         error)
+{
+    struct dnames_match_list_s ml;
+    Dwarf_Unsigned hash = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (!dn) {
+        _dwarf_error(NULL, error,DW_DLE_DEBUG_NAMES_NULL_POINTER);
+        return DW_DLV_ERROR;
+    }
+    if (!name || !matches_out || !match_count_out) {
+        _dwarf_error(dn->dn_dbg, error,
+            DW_DLE_DEBUG_NAMES_NULL_POINTER);
+        return DW_DLV_ERROR;
+    }
+    memset(&ml,0,sizeof(ml));
+    hash = _dwarf_dnames_hash(name);
+    for (i = 0; i < dn->dn_inhdr_count; ++i) {
+        res = dnames_lookup_in_index(dn,i,name,hash,&ml,error);
+        if (res != DW_DLV_OK) {
+            free(ml.ml_matches);
+            return res;
+        }
+    }
+    if (!ml.ml_count) {
+        free(ml.ml_matches);
+        return DW_DLV_NO_ENTRY;
+    }
+    *matches_out = ml.ml_matches;
+    *match_count_out = ml.ml_count;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_debugnames_matches(Dwarf_Dnames_Match *matches)
+{
+    free(matches);
+}
+
 /*  Frees any Dwarf_Dnames_Head_s data that is directly
     mallocd. */
 void
@@ -102,9 +102,45 @@ struct Dwarf_Dnames_Head_s {
     Dwarf_Unsigned            dn_section_size;
     unsigned                  dn_inhdr_count;
 
+    /*  Non-null when the index came from a sidecar file:
+        name string offsets are then into this area,
+        not into .debug_str, and dwarf_debugnames_name()
+        does not hand them out. */
+    Dwarf_Small             * dn_strings;
+    Dwarf_Unsigned            dn_strings_size;
+
     /*  Becomes an array of these structs, dn_inhdr_count
         of them. */
     struct Dwarf_Dnames_index_header_s * dn_inhdr_first;
 };
 
 void _dwarf_debugnames_destructor(void *m);
+
+/*  A .debug_names sidecar file, as written by
+    dwarf_debugnames_write_sidecar(). All the numbers
+    are in the byte order of the object:
+        8 bytes  DNAMES_SIDECAR_MAGIC
+        8 bytes  the .debug_info size the index describes
+        8 bytes  FNV-1a checksum of .debug_info, .debug_abbrev,
+                 .debug_str and .debug_str_offsets
+        8 bytes  size of the .debug_names image
+        8 bytes  size of the string area
+        the .debug_names image
+        the string area (NUL terminated names)
+    A sidecar whose .debug_info size or checksum does
+    not match is stale and is ignored. */
+#define DNAMES_SIDECAR_MAGIC "LDWDNAM2"
+#define DNAMES_SIDECAR_SUFFIX ".dnames"
+#define DNAMES_SIDECAR_HEADER_SIZE 40
+
+struct Dwarf_Dnames_Sidecar_s {
+    /*  The whole file, malloc'd. The rest point into it. */
+    Dwarf_Small   * dsc_file_data;
+    Dwarf_Unsigned  dsc_file_size;
+    Dwarf_Small   * dsc_names;
+    Dwarf_Unsigned  dsc_names_size;
+    Dwarf_Small   * dsc_strings;
+    Dwarf_Unsigned  dsc_strings_size;
+};
+
+void _dwarf_dnames_sidecar_destroy(Dwarf_Debug dbg);
@@ -48,18 +48,25 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
 #ifdef HAVE_UNISTD_H
 #include <unistd.h> /* getcwd */
 #endif /* HAVE_UNISTD_H */
-#if 0
 #include <sys/types.h> /* for open() */
 #include <sys/stat.h> /* for open() */
 #include <fcntl.h> /* for open() */
-#include <errno.h>
-#endif
+#if defined(_WIN32) && defined(_MSC_VER)
+#include <io.h> /* close() */
+#endif /* _WIN32 && _MSC_VER */
+#ifndef _WIN32
+#include <dirent.h> /* opendir() readdir() */
+#endif /* _WIN32 */
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* For uintptr_t */
+#endif /* HAVE_STDINT_H */
 #include "dwarf_incl.h"
 #include "dwarf_alloc.h"
 #include "dwarf_error.h"
 #include "dwarf_util.h"
 #include "dwarfstring.h"
 #include "dwarf_debuglink.h"
+#include "dwarf_tsearch.h"
 
 #ifndef O_BINARY
 #define O_BINARY 0
@@ -173,7 +180,6 @@ _dwarf_check_string_valid(
 #endif
 
 
-#if 0
 static int
 does_file_exist(char *f)
 {
@@ -187,7 +193,6 @@ does_file_exist(char *f)
     close(fd);
     return DW_DLV_OK;
 }
-#endif
 
 
 static void
@@ -915,3 +920,762 @@ dwarf_add_debuglink_global_path(Dwarf_Debug dbg,
     dbg->de_gnu_global_path_count = glpath_count_out;
     return DW_DLV_OK;
 }
+
+/*  New October 2026. A process-wide cache of separate debug
+    file locations, for callers opening many objects whose
+    debug files live under the same global paths.
+    Keys are "b:<hex build-id>" or "l:<debuglink full path>"
+    and the value is the resolved path of an existing file.
+    Each global path is indexed by reading
+    its .build-id/xx/ directories, so build-id resolution
+    does no per-candidate open() calls.  The st_mtime of
+    each directory read is kept, and a lookup reads again
+    any directory whose st_mtime changed since, so debug
+    files installed or removed later are seen.
+    A link found earlier is checked to still exist before
+    it is returned. A link not found is not remembered:
+    finding out whether it appeared costs as much as
+    looking for it.
+    As with the rest of libdwarf there is no locking here,
+    callers sharing the cache across threads must
+    serialize calls to these functions.  */
+struct Dwarf_Debuglink_Cache_Entry_s {
+    char * dce_key;
+    char * dce_path;
+};
+
+#define DLC_SUBDIR_COUNT 256
+
+/*  A global path indexed.  The st_mtime of
+    <root>/.build-id and of each of its xx subdirectories
+    (by the value of xx) when last read, 0 if absent
+    or never read.  */
+struct Dwarf_Debuglink_Cache_Root_s {
+    char * dcr_path;
+    time_t dcr_mtime;
+    time_t dcr_sub_mtime[DLC_SUBDIR_COUNT];
+};
+
+static void *  dlc_tree;
+static struct Dwarf_Debuglink_Cache_Root_s ** dlc_roots;
+static unsigned dlc_root_count;
+
+#define DLC_BUILDID_PREFIX "b:"
+#define DLC_LINK_PREFIX    "l:"
+#define DLC_BUILDID_DIR    ".build-id"
+#define DLC_FILE_HEADER    "# libdwarf debuglink cache 2"
+#define DLC_LINE_MAX       4000
+
+/*  The Daniel J Bernstein hash, as in pro_init.c */
+static DW_TSHASHTYPE
+dlc_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Debuglink_Cache_Entry_s *e = keyp;
+    const char *str = e->dce_key;
+    DW_TSHASHTYPE hash = 5381;
+    int c  = 0;
+
+    /*  Extra parens suppress warning about assign in test. */
+    while ((c = *str++)) {
+        hash = hash * 33 + c ;
+    }
+    return hash;
+}
+
+static int
+dlc_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Debuglink_Cache_Entry_s *lp = l;
+    const struct Dwarf_Debuglink_Cache_Entry_s *rp = r;
+
+    return strcmp(lp->dce_key,rp->dce_key);
+}
+
+static void
+dlc_free_node(void *nodep)
+{
+    /*  Key and path share one allocation with the entry. */
+    free(nodep);
+}
+
+/*  Returns the entry for key, or NULL. */
+static struct Dwarf_Debuglink_Cache_Entry_s *
+dlc_find(const char *key)
+{
+    struct Dwarf_Debuglink_Cache_Entry_s ekey;
+    void *retval = 0;
+
+    if (!dlc_tree) {
+        return 0;
+    }
+    ekey.dce_key = (char *)key;
+    ekey.dce_path = 0;
+    retval = dwarf_tfind(&ekey,&dlc_tree,dlc_compare);
+    if (!retval) {
+        return 0;
+    }
+    return *(struct Dwarf_Debuglink_Cache_Entry_s **)retval;
+}
+
+/*  Removes the entry e from the tree and frees it. */
+static void
+dlc_remove(struct Dwarf_Debuglink_Cache_Entry_s *e)
+{
+    dwarf_tdelete(e,&dlc_tree,dlc_compare);
+    free(e);
+}
+
+/*  Inserts key/path unless key is already present,
+    in which case the earlier entry wins (global paths are
+    searched in order). */
+static int
+dlc_insert(const char *key, const char *path, int *errcode)
+{
+    struct Dwarf_Debuglink_Cache_Entry_s *e = 0;
+    struct Dwarf_Debuglink_Cache_Entry_s *found = 0;
+    size_t keylen = strlen(key);
+    size_t pathlen = strlen(path);
+    void *retval = 0;
+
+    if (!dlc_tree) {
+        void *initval = dwarf_initialize_search_hash(&dlc_tree,
+            dlc_hashfunc,0);
+        if (!initval) {
+            *errcode = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+    }
+    e = (struct Dwarf_Debuglink_Cache_Entry_s *)
+        malloc(sizeof(*e) + keylen + 1 + pathlen + 1);
+    if (!e) {
+        *errcode = DW_DLE_ALLOC_FAIL;
+        return DW_DLV_ERROR;
+    }
+    e->dce_key = (char *)(e+1);
+    e->dce_path = e->dce_key + keylen + 1;
+    strcpy(e->dce_key,key);
+    strcpy(e->dce_path,path);
+    retval = dwarf_tsearch(e,&dlc_tree,dlc_compare);
+    if (!retval) {
+        free(e);
+        *errcode = DW_DLE_ALLOC_FAIL;
+        return DW_DLV_ERROR;
+    }
+    found = *(struct Dwarf_Debuglink_Cache_Entry_s **)retval;
+    if (found != e) {
+        /*  Already present. */
+        free(e);
+    }
+    return DW_DLV_OK;
+}
+
+static struct Dwarf_Debuglink_Cache_Root_s *
+dlc_find_root(const char *root)
+{
+    unsigned i = 0;
+
+    for (i = 0; i < dlc_root_count; ++i) {
+        if (!strcmp(dlc_roots[i]->dcr_path,root)) {
+            return dlc_roots[i];
+        }
+    }
+    return 0;
+}
+
+/*  Returns the root, adding it (as never read)
+    if it is new. */
+static struct Dwarf_Debuglink_Cache_Root_s *
+dlc_add_root(const char *root, int *errcode)
+{
+    struct Dwarf_Debuglink_Cache_Root_s **newroots = 0;
+    struct Dwarf_Debuglink_Cache_Root_s *r = 0;
+    size_t rootlen = strlen(root);
+
+    r = dlc_find_root(root);
+    if (r) {
+        return r;
+    }
+    newroots = (struct Dwarf_Debuglink_Cache_Root_s **)
+        realloc(dlc_roots,sizeof(*newroots)*(dlc_root_count+1));
+    if (!newroots) {
+        *errcode = DW_DLE_ALLOC_FAIL;
+        return 0;
+    }
+    dlc_roots = newroots;
+    /*  The path shares one allocation with the root. */
+    r = (struct Dwarf_Debuglink_Cache_Root_s *)
+        calloc(1,sizeof(*r) + rootlen + 1);
+    if (!r) {
+        *errcode = DW_DLE_ALLOC_FAIL;
+        return 0;
+    }
+    r->dcr_path = (char *)(r+1);
+    strcpy(r->dcr_path,root);
+    dlc_roots[dlc_root_count] = r;
+    ++dlc_root_count;
+    return r;
+}
+
+/*  The st_mtime of a directory, 0 if it is not one. */
+static time_t
+dlc_dir_mtime(const char *path)
+{
+    struct stat sb;
+
+    if (stat(path,&sb) || !S_ISDIR(sb.st_mode)) {
+        return 0;
+    }
+    return sb.st_mtime;
+}
+
+#ifndef _WIN32
+/*  For dlc_forget_subdir(), collecting the entries
+    to remove as the tree cannot change while walked. */
+static const char *dlc_forget_prefix;
+static struct Dwarf_Debuglink_Cache_Entry_s **dlc_forget_list;
+static unsigned dlc_forget_count;
+static unsigned dlc_forget_max;
+static int dlc_forget_failed;
+
+static void
+dlc_forget_action(const void *nodep,const DW_VISIT which,
+    UNUSEDARG const int depth)
+{
+    struct Dwarf_Debuglink_Cache_Entry_s *e = 0;
+    size_t prefixlen = strlen(dlc_forget_prefix);
+
+    if (which == dwarf_postorder || which == dwarf_endorder) {
+        return;
+    }
+    e = *(struct Dwarf_Debuglink_Cache_Entry_s **)nodep;
+    if (strncmp(e->dce_key,DLC_BUILDID_PREFIX,2) ||
+        strncmp(e->dce_path,dlc_forget_prefix,prefixlen) ||
+        e->dce_path[prefixlen] != joinchar) {
+        return;
+    }
+    if (dlc_forget_count == dlc_forget_max) {
+        unsigned newmax = dlc_forget_max?dlc_forget_max*2:16;
+        struct Dwarf_Debuglink_Cache_Entry_s **newlist =
+            (struct Dwarf_Debuglink_Cache_Entry_s **)
+            realloc(dlc_forget_list,sizeof(*newlist)*newmax);
+
+        if (!newlist) {
+            dlc_forget_failed = TRUE;
+            return;
+        }
+        dlc_forget_list = newlist;
+        dlc_forget_max = newmax;
+    }
+    dlc_forget_list[dlc_forget_count++] = e;
+}
+
+/*  Removes the build-id entries for files in dirpath,
+    before it is read again. */
+static int
+dlc_forget_subdir(const char *dirpath, int *errcode)
+{
+    unsigned i = 0;
+    int res = DW_DLV_OK;
+
+    if (!dlc_tree) {
+        return DW_DLV_OK;
+    }
+    dlc_forget_prefix = dirpath;
+    dlc_forget_count = 0;
+    dlc_forget_failed = FALSE;
+    dwarf_twalk(dlc_tree,dlc_forget_action);
+    if (dlc_forget_failed) {
+        *errcode = DW_DLE_ALLOC_FAIL;
+        res = DW_DLV_ERROR;
+    } else {
+        for (i = 0; i < dlc_forget_count; ++i) {
+            dlc_remove(dlc_forget_list[i]);
+        }
+    }
+    free(dlc_forget_list);
+    dlc_forget_list = 0;
+    dlc_forget_count = 0;
+    dlc_forget_max = 0;
+    dlc_forget_prefix = 0;
+    return res;
+}
+
+/*  Record every <root>/.build-id/xx/yyyy.debug file
+    as key b:xxyyyy.  */
+static int
+dlc_index_buildid_subdir(dwarfstring *dirpath,
+    const char *xx,
+    int *errcode)
+{
+    DIR *d = 0;
+    struct dirent *de = 0;
+    dwarfstring key;
+    dwarfstring full;
+    int res = DW_DLV_OK;
+
+    d = opendir(dwarfstring_string(dirpath));
+    if (!d) {
+        return DW_DLV_NO_ENTRY;
+    }
+    dwarfstring_constructor(&key);
+    dwarfstring_constructor(&full);
+    for (;;) {
+        const char *name = 0;
+        size_t namelen = 0;
+        size_t suffixlen = 6; /* strlen(".debug") */
+
+        de = readdir(d);
+        if (!de) {
+            break;
+        }
+        name = de->d_name;
+        namelen = strlen(name);
+        if (namelen <= suffixlen ||
+            strcmp(name+namelen-suffixlen,".debug")) {
+            continue;
+        }
+        dwarfstring_reset(&key);
+        dwarfstring_append(&key,DLC_BUILDID_PREFIX);
+        dwarfstring_append(&key,(char *)xx);
+        dwarfstring_append_length(&key,(char *)name,
+            namelen-suffixlen);
+        dwarfstring_reset(&full);
+        dwarfstring_append(&full,dwarfstring_string(dirpath));
+        dwarfstring_append(&full,joinstr);
+        dwarfstring_append(&full,(char *)name);
+        res = dlc_insert(dwarfstring_string(&key),
+            dwarfstring_string(&full),errcode);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+    }
+    closedir(d);
+    dwarfstring_destructor(&key);
+    dwarfstring_destructor(&full);
+    return res;
+}
+
+/*  Reads <root>/.build-id/xx again if its st_mtime
+    is not what it was when last read. */
+static int
+dlc_refresh_subdir(struct Dwarf_Debuglink_Cache_Root_s *r,
+    dwarfstring *base,
+    unsigned xx,
+    int *errcode)
+{
+    static const char hexdigits[] = "0123456789abcdef";
+    dwarfstring sub;
+    char name[3];
+    time_t mtime = 0;
+    int res = DW_DLV_OK;
+
+    name[0] = hexdigits[xx >> 4];
+    name[1] = hexdigits[xx & 0xf];
+    name[2] = 0;
+    dwarfstring_constructor(&sub);
+    dwarfstring_append(&sub,dwarfstring_string(base));
+    dwarfstring_append(&sub,joinstr);
+    dwarfstring_append(&sub,name);
+    mtime = dlc_dir_mtime(dwarfstring_string(&sub));
+    if (mtime != r->dcr_sub_mtime[xx]) {
+        res = dlc_forget_subdir(dwarfstring_string(&sub),errcode);
+        if (res == DW_DLV_OK && mtime) {
+            res = dlc_index_buildid_subdir(&sub,name,errcode);
+            if (res == DW_DLV_NO_ENTRY) {
+                /*  Gone since the stat(). */
+                mtime = 0;
+                res = DW_DLV_OK;
+            }
+        }
+        if (res == DW_DLV_OK) {
+            r->dcr_sub_mtime[xx] = mtime;
+        }
+    }
+    dwarfstring_destructor(&sub);
+    return res;
+}
+#endif /* _WIN32 */
+
+/*  Brings the index of root up to date for a lookup
+    of build-ids starting with byte xx: all of
+    <root>/.build-id if its st_mtime changed (a
+    subdirectory was added or removed), else only
+    <root>/.build-id/xx if its st_mtime changed.
+    A root with no .build-id directory costs one stat(). */
+static int
+dlc_refresh_root(const char *root, unsigned xx, int *errcode)
+{
+    struct Dwarf_Debuglink_Cache_Root_s *r = 0;
+#ifndef _WIN32
+    dwarfstring base;
+    dwarfstring tmp;
+    time_t mtime = 0;
+    unsigned i = 0;
+    int res = DW_DLV_OK;
+#endif /* _WIN32 */
+
+    r = dlc_add_root(root,errcode);
+    if (!r) {
+        return DW_DLV_ERROR;
+    }
+#ifndef _WIN32
+    dwarfstring_constructor(&base);
+    dwarfstring_constructor(&tmp);
+    dwarfstring_append(&base,(char *)root);
+    dwarfstring_append(&tmp,DLC_BUILDID_DIR);
+    _dwarf_pathjoinl(&base,&tmp);
+    dwarfstring_destructor(&tmp);
+    mtime = dlc_dir_mtime(dwarfstring_string(&base));
+    if (mtime != r->dcr_mtime) {
+        for (i = 0; i < DLC_SUBDIR_COUNT; ++i) {
+            res = dlc_refresh_subdir(r,&base,i,errcode);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+        }
+        if (res == DW_DLV_OK) {
+            r->dcr_mtime = mtime;
+        }
+    } else if (mtime) {
+        res = dlc_refresh_subdir(r,&base,xx,errcode);
+    }
+    dwarfstring_destructor(&base);
+    return res;
+#else  /* _WIN32 */
+    (void)xx;
+    return DW_DLV_OK;
+#endif /* _WIN32 */
+}
+
+static void
+dlc_buildid_key(dwarfstring *key,
+    unsigned char *buildid,
+    unsigned buildid_length)
+{
+    unsigned bu = 0;
+
+    dwarfstring_append(key,DLC_BUILDID_PREFIX);
+    for (bu = 0; bu < buildid_length; ++bu) {
+        dwarfstring_append_printf_u(key, "%02x",buildid[bu]);
+    }
+}
+
+/*  Resolve using the build-id.
+    Returns DW_DLV_NO_ENTRY if not in any
+    global path. */
+static int
+dlc_resolve_buildid(Dwarf_Debug dbg,
+    unsigned char *buildid,
+    unsigned buildid_length,
+    char **path_out,
+    int *errcode)
+{
+    unsigned g = 0;
+    dwarfstring key;
+    struct Dwarf_Debuglink_Cache_Entry_s *e = 0;
+    int res = 0;
+
+    if (!buildid_length) {
+        return DW_DLV_NO_ENTRY;
+    }
+    for (g = 0; g < dbg->de_gnu_global_path_count; ++g) {
+        res = dlc_refresh_root(dbg->de_gnu_global_paths[g],
+            buildid[0],errcode);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    dwarfstring_constructor(&key);
+    dlc_buildid_key(&key,buildid,buildid_length);
+    e = dlc_find(dwarfstring_string(&key));
+    dwarfstring_destructor(&key);
+    if (!e) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *path_out = e->dce_path;
+    return DW_DLV_OK;
+}
+
+/*  Resolve using the .gnu_debuglink name.
+    A link found before is returned if the file is
+    still there, else we probe the candidate paths
+    and remember the file found, if any. */
+static int
+dlc_resolve_link(Dwarf_Debug dbg,
+    char *link_name,
+    unsigned char *crc,
+    char **path_out,
+    int *errcode)
+{
+    dwarfstring linkfull;
+    dwarfstring key;
+    char **paths = 0;
+    unsigned paths_count = 0;
+    unsigned i = 0;
+    char *found = 0;
+    struct Dwarf_Debuglink_Cache_Entry_s *e = 0;
+    int res = 0;
+
+    dwarfstring_constructor(&linkfull);
+    res = _dwarf_construct_linkedto_path(
+        (char **)dbg->de_gnu_global_paths,
+        dbg->de_gnu_global_path_count,
+        (char *)dbg->de_path,
+        link_name,
+        &linkfull,
+        crc,
+        0,0,
+        &paths,&paths_count,
+        errcode);
+    if (res != DW_DLV_OK) {
+        dwarfstring_destructor(&linkfull);
+        return res;
+    }
+    dwarfstring_constructor(&key);
+    dwarfstring_append(&key,DLC_LINK_PREFIX);
+    dwarfstring_append(&key,dwarfstring_string(&linkfull));
+    dwarfstring_destructor(&linkfull);
+    e = dlc_find(dwarfstring_string(&key));
+    if (e && does_file_exist(e->dce_path) != DW_DLV_OK) {
+        dlc_remove(e);
+        e = 0;
+    }
+    if (!e) {
+        for (i = 0; i < paths_count; ++i) {
+            if (does_file_exist(paths[i]) == DW_DLV_OK) {
+                found = paths[i];
+                break;
+            }
+        }
+        if (found) {
+            res = dlc_insert(dwarfstring_string(&key),found,errcode);
+            if (res != DW_DLV_OK) {
+                free(paths);
+                dwarfstring_destructor(&key);
+                return res;
+            }
+            e = dlc_find(dwarfstring_string(&key));
+        }
+    }
+    free(paths);
+    dwarfstring_destructor(&key);
+    if (!e) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *path_out = e->dce_path;
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Returns, in *resolved_path_out, a path to the separate
+    debug file for dbg, trying the build-id first and
+    the .gnu_debuglink name second.
+    The caller must free() the returned string. */
+int
+dwarf_gnu_debuglink_resolve(Dwarf_Debug dbg,
+    char ** resolved_path_out,
+    Dwarf_Error *error)
+{
+    char *link_name = 0;
+    unsigned char *crc = 0;
+    unsigned buildid_type = 0;
+    char *buildid_owner = 0;
+    unsigned char *buildid = 0;
+    unsigned buildid_length = 0;
+    char *path = 0;
+    char *pathcopy = 0;
+    int res = DW_DLV_NO_ENTRY;
+    int errcode = 0;
+
+    if (!dbg) {
+        _dwarf_error(dbg,error,DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (dbg->de_note_gnu_buildid.dss_size) {
+        res = extract_buildid(dbg,&dbg->de_note_gnu_buildid,
+            &buildid_type,&buildid_owner,
+            &buildid,&buildid_length,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        res = dlc_resolve_buildid(dbg,buildid,buildid_length,
+            &path,&errcode);
+        if (res == DW_DLV_ERROR) {
+            _dwarf_error(dbg,error,errcode);
+            return res;
+        }
+    }
+    if (res == DW_DLV_NO_ENTRY && dbg->de_path &&
+        dbg->de_gnu_debuglink.dss_size) {
+        res = extract_debuglink(dbg,&dbg->de_gnu_debuglink,
+            &link_name,&crc,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        res = dlc_resolve_link(dbg,link_name,crc,&path,&errcode);
+        if (res == DW_DLV_ERROR) {
+            _dwarf_error(dbg,error,errcode);
+            return res;
+        }
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    pathcopy = strdup(path);
+    if (!pathcopy) {
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    *resolved_path_out = pathcopy;
+    return DW_DLV_OK;
+}
+
+/*  Frees everything in the cache. Afterwards global
+    paths will be indexed again on next use. */
+void
+dwarf_debuglink_cache_clear(void)
+{
+    unsigned i = 0;
+
+    if (dlc_tree) {
+        dwarf_tdestroy(dlc_tree,dlc_free_node);
+        dlc_tree = 0;
+    }
+    for (i = 0; i < dlc_root_count; ++i) {
+        free(dlc_roots[i]);
+    }
+    free(dlc_roots);
+    dlc_roots = 0;
+    dlc_root_count = 0;
+}
+
+static FILE *dlc_save_file;
+
+static void
+dlc_save_action(const void *nodep,const DW_VISIT which,
+    UNUSEDARG const int depth)
+{
+    const struct Dwarf_Debuglink_Cache_Entry_s *e = 0;
+
+    if (which == dwarf_postorder || which == dwarf_endorder) {
+        return;
+    }
+    e = *(const struct Dwarf_Debuglink_Cache_Entry_s **)nodep;
+    fprintf(dlc_save_file,"k\t%s\t%s\n",e->dce_key,e->dce_path);
+}
+
+/*  Writes the cache as a text file:
+    one 'r<tab>mtime<tab>root' line per indexed global path,
+    mtime being that of its .build-id directory, and
+    one 'k<tab>key<tab>path' line per resolved file. */
+int
+dwarf_debuglink_cache_save(const char *cache_path,
+    int *errcode)
+{
+    FILE *f = 0;
+    unsigned i = 0;
+
+    if (!cache_path) {
+        *errcode = DW_DLE_NO_FILE_NAME;
+        return DW_DLV_ERROR;
+    }
+    f = fopen(cache_path,"w");
+    if (!f) {
+        *errcode = DW_DLE_OPEN_FAIL;
+        return DW_DLV_ERROR;
+    }
+    fprintf(f,"%s\n",DLC_FILE_HEADER);
+    for (i = 0; i < dlc_root_count; ++i) {
+        fprintf(f,"r\t%lu\t%s\n",
+            (unsigned long)dlc_roots[i]->dcr_mtime,
+            dlc_roots[i]->dcr_path);
+    }
+    if (dlc_tree) {
+        dlc_save_file = f;
+        dwarf_twalk(dlc_tree,dlc_save_action);
+        dlc_save_file = 0;
+    }
+    if (fclose(f)) {
+        *errcode = DW_DLE_FILE_UNAVAILABLE;
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Adds the contents of a file written by
+    dwarf_debuglink_cache_save() to the cache.
+    Roots listed in the file are treated as indexed
+    when their .build-id directory had the mtime
+    recorded.  Their xx subdirectories are read
+    again on first use.
+    Malformed lines are ignored.
+    Returns DW_DLV_NO_ENTRY if the file cannot be opened
+    or is not a cache file. */
+int
+dwarf_debuglink_cache_load(const char *cache_path,
+    int *errcode)
+{
+    FILE *f = 0;
+    char line[DLC_LINE_MAX];
+    int res = DW_DLV_OK;
+
+    if (!cache_path) {
+        *errcode = DW_DLE_NO_FILE_NAME;
+        return DW_DLV_ERROR;
+    }
+    f = fopen(cache_path,"r");
+    if (!f) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!fgets(line,sizeof(line),f) ||
+        strncmp(line,DLC_FILE_HEADER,strlen(DLC_FILE_HEADER))) {
+        fclose(f);
+        return DW_DLV_NO_ENTRY;
+    }
+    while (fgets(line,sizeof(line),f)) {
+        size_t len = strlen(line);
+        char *tab = 0;
+
+        if (!len || line[len-1] != '\n') {
+            /*  Too long (or truncated): skip the rest of it. */
+            int c = 0;
+
+            while (len) {
+                c = getc(f);
+                if (c == EOF || c == '\n') {
+                    break;
+                }
+            }
+            continue;
+        }
+        line[len-1] = 0;
+        if (line[0] == 'r' && line[1] == '\t') {
+            struct Dwarf_Debuglink_Cache_Root_s *r = 0;
+            char *endp = 0;
+            unsigned long mtime = 0;
+
+            mtime = strtoul(line+2,&endp,10);
+            if (endp == line+2 || *endp != '\t' || !endp[1]) {
+                continue;
+            }
+            r = dlc_add_root(endp+1,errcode);
+            if (!r) {
+                res = DW_DLV_ERROR;
+                break;
+            }
+            r->dcr_mtime = (time_t)mtime;
+        } else if (line[0] == 'k' && line[1] == '\t') {
+            tab = strchr(line+2,'\t');
+            if (!tab || !tab[1]) {
+                continue;
+            }
+            *tab = 0;
+            res = dlc_insert(line+2,tab+1,errcode);
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+    }
+    fclose(f);
+    return res;
+}
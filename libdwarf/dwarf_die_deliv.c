@@ -30,6 +30,9 @@
 
 #include "config.h"
 #include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
 #include "dwarf_incl.h"
 #include "dwarf_alloc.h"
 #include "dwarf_error.h"
@@ -688,6 +691,7 @@ _dwarf_make_CU_Context(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return DW_DLV_ERROR;
     }
+    dbg->de_perf_counters.pc_cu_contexts_created++;
     cu_context->cc_dbg = dbg;
     cu_context->cc_is_info = is_info;
 
@@ -1031,6 +1035,174 @@ dwarf_next_cu_header_d(Dwarf_Debug dbg,
     return res;
 }
 
+/*  Reads the unit header at offset into *ue using
+    the same checks as _dwarf_make_CU_Context(), with
+    a scratch context on the stack so nothing is
+    allocated or recorded in dbg. */
+static int
+read_unit_entry(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    Dwarf_Off offset,
+    Dwarf_Unit_Entry *ue,
+    Dwarf_Error *error)
+{
+    struct Dwarf_CU_Context_s scratch;
+    struct Dwarf_Section_s *sec = is_info? &dbg->de_debug_info:
+        &dbg->de_debug_types;
+    Dwarf_Unsigned section_size = sec->dss_size;
+    Dwarf_Byte_Ptr section_end_ptr = sec->dss_data + section_size;
+    Dwarf_Byte_Ptr cu_ptr = sec->dss_data + offset;
+    Dwarf_Unsigned max_cu_global_offset = 0;
+    Dwarf_Unsigned bytes_read = 0;
+    Dwarf_Unsigned types_extra_len = 0;
+    int res = 0;
+
+    memset(&scratch,0,sizeof(scratch));
+    memset(ue,0,sizeof(*ue));
+    if ((offset+4) > section_size) {
+        _dwarf_error(dbg, error, DW_DLE_CU_LENGTH_ERROR);
+        return DW_DLV_ERROR;
+    }
+    res = read_info_area_length_and_check(dbg,&scratch,
+        offset,&cu_ptr,section_size,section_end_ptr,
+        &max_cu_global_offset,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res  = _dwarf_read_cu_version_and_abbrev_offset(dbg,
+        cu_ptr,is_info,dbg->de_groupnumber,
+        scratch.cc_length_size,&scratch,
+        section_end_ptr,&bytes_read,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    cu_ptr += bytes_read;
+    switch(scratch.cc_unit_type) {
+    case DW_UT_split_type:
+    case DW_UT_type:
+        types_extra_len = sizeof(Dwarf_Sig8) +
+            scratch.cc_length_size;
+        break;
+    case DW_UT_skeleton:
+    case DW_UT_split_compile:
+        types_extra_len = sizeof(Dwarf_Sig8);
+        break;
+    default:
+        break;
+    }
+    if (scratch.cc_length < (CU_VERSION_STAMP_SIZE +
+        scratch.cc_length_size + CU_ADDRESS_SIZE_SIZE +
+        types_extra_len)) {
+        _dwarf_error(dbg, error, DW_DLE_CU_LENGTH_ERROR);
+        return DW_DLV_ERROR;
+    }
+    if (types_extra_len) {
+        memcpy(&ue->ue_signature,cu_ptr,sizeof(Dwarf_Sig8));
+        ue->ue_has_signature = TRUE;
+        cu_ptr += sizeof(Dwarf_Sig8);
+        if (types_extra_len > sizeof(Dwarf_Sig8)) {
+            res = _dwarf_read_unaligned_ck_wrapper(dbg,
+                &ue->ue_type_offset,cu_ptr,
+                scratch.cc_length_size,section_end_ptr,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            cu_ptr += scratch.cc_length_size;
+        }
+    }
+    ue->ue_offset = offset;
+    ue->ue_die_offset = offset +
+        (cu_ptr - (sec->dss_data + offset));
+    ue->ue_length = scratch.cc_length;
+    ue->ue_length_size = scratch.cc_length_size;
+    ue->ue_extension_size = scratch.cc_extension_size;
+    ue->ue_version = scratch.cc_version_stamp;
+    ue->ue_unit_type = scratch.cc_unit_type;
+    ue->ue_address_size = scratch.cc_address_size;
+    ue->ue_abbrev_offset = scratch.cc_abbrev_offset;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_get_unit_directory(Dwarf_Debug dbg,
+    Dwarf_Bool is_info,
+    Dwarf_Unit_Entry **units_out,
+    Dwarf_Unsigned *count_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unit_Entry *units = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned alloc = 0;
+    Dwarf_Unsigned section_size = 0;
+    Dwarf_Off offset = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (is_info) {
+        res = _dwarf_load_debug_info(dbg,error);
+        section_size = dbg->de_debug_info.dss_size;
+    } else {
+        res = _dwarf_load_debug_types(dbg,error);
+        section_size = dbg->de_debug_types.dss_size;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    while (offset < section_size) {
+        Dwarf_Unit_Entry *ue = 0;
+        Dwarf_Off next = 0;
+
+        if (count >= alloc) {
+            Dwarf_Unsigned newalloc = alloc? alloc*2 : 64;
+            Dwarf_Unit_Entry *newunits = (Dwarf_Unit_Entry *)
+                realloc(units,newalloc*sizeof(Dwarf_Unit_Entry));
+
+            if (!newunits) {
+                free(units);
+                _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+                    "DW_DLE_ALLOC_FAIL: out of memory listing "
+                    "the unit headers");
+                return DW_DLV_ERROR;
+            }
+            units = newunits;
+            alloc = newalloc;
+        }
+        ue = units + count;
+        res = read_unit_entry(dbg,is_info,offset,ue,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            /* Zero length: padding at the section end. */
+            break;
+        }
+        if (res != DW_DLV_OK) {
+            free(units);
+            return res;
+        }
+        count++;
+        next = offset + ue->ue_length + ue->ue_length_size +
+            ue->ue_extension_size;
+        if (next <= offset) {
+            break;
+        }
+        offset = next;
+    }
+    if (!count) {
+        free(units);
+        return DW_DLV_NO_ENTRY;
+    }
+    *units_out = units;
+    *count_out = count;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dealloc_unit_directory(Dwarf_Unit_Entry *units)
+{
+    free(units);
+}
+
 
 static void
 local_attrlist_dealloc(Dwarf_Debug dbg,
@@ -0,0 +1,694 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Builds a DWARF5 .debug_names index for an object that
+    has none, by reading every CU, and writes it to a
+    sidecar file next to the object. The index itself is
+    built by the producer's .debug_names code (pro_dnames.c).
+    Once dwarf_debugnames_use_sidecar() has read in a
+    sidecar that matches the object, dwarf_debugnames_header()
+    uses it when the object has no .debug_names section,
+    so lookups with dwarf_debugnames_lookup() no longer
+    have to walk every DIE. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <sys/types.h> /* for open() */
+#include <sys/stat.h> /* for open() */
+#include <fcntl.h> /* for open() */
+#ifdef HAVE_UNISTD_H
+#include <unistd.h> /* for close() */
+#elif defined(_WIN32) && defined(_MSC_VER)
+#include <io.h>
+#endif /* HAVE_UNISTD_H */
+#include "dwarf_incl.h"
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_debug_names.h"
+#include "dwarf_object_read_common.h"
+#include "pro_dnames.h"
+
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif /* O_BINARY */
+
+#define TRUE  1
+#define FALSE 0
+
+#define SIDECAR_FIELD_SIZE 8
+
+/*  The sidecar's own string area: each distinct name once. */
+struct sidecar_strings_s {
+    char          *ss_data;
+    Dwarf_Unsigned ss_used;
+    Dwarf_Unsigned ss_allocated;
+};
+
+static int
+sidecar_str_append(void *user_data, const char *name,
+    Dwarf_Unsigned *str_offset, int *errnum)
+{
+    struct sidecar_strings_s *ss =
+        (struct sidecar_strings_s *)user_data;
+    Dwarf_Unsigned len = strlen(name) + 1;
+
+    if ((ss->ss_used + len) > ss->ss_allocated) {
+        Dwarf_Unsigned newsize = ss->ss_allocated?
+            2*ss->ss_allocated:4096;
+        char *newdata = 0;
+
+        while (newsize < (ss->ss_used + len)) {
+            newsize *= 2;
+        }
+        newdata = (char *)realloc(ss->ss_data,newsize);
+        if (!newdata) {
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+        ss->ss_data = newdata;
+        ss->ss_allocated = newsize;
+    }
+    memcpy(ss->ss_data + ss->ss_used,name,len);
+    *str_offset = ss->ss_used;
+    ss->ss_used += len;
+    return DW_DLV_OK;
+}
+
+static int
+is_declaration(Dwarf_Die die, Dwarf_Bool *isdecl,
+    Dwarf_Error *error)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Bool flag = FALSE;
+    int res = 0;
+
+    *isdecl = FALSE;
+    res = dwarf_attr(die,DW_AT_declaration,&attr,error);
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_formflag(attr,&flag,error);
+    dwarf_dealloc_attribute(attr);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *isdecl = flag;
+    return DW_DLV_OK;
+}
+
+static int
+add_name(Dwarf_Debug dbg, struct Dwarf_P_Dnames_s *dn,
+    const char *name, Dwarf_Unsigned cu_index,
+    Dwarf_Off die_offset, Dwarf_Half tag,
+    Dwarf_Error *error)
+{
+    int errnum = 0;
+    int res = 0;
+
+    res = _dwarf_pro_dnames_add_name(dn,name,cu_index,
+        die_offset,tag,&errnum);
+    if (res == DW_DLV_ERROR) {
+        _dwarf_error(dbg,error,errnum);
+    }
+    return res;
+}
+
+/*  Adds the DIE's DW_AT_name and, for functions and
+    variables, its linkage name. An out-of-line definition
+    of a C++ member or of an inlined function carries its
+    names on the DW_AT_specification or DW_AT_abstract_origin
+    DIE, so those are looked up one level. */
+static int
+index_die_names(Dwarf_Debug dbg, struct Dwarf_P_Dnames_s *dn,
+    Dwarf_Unsigned cu_index, Dwarf_Die die,
+    Dwarf_Half tag, Dwarf_Error *error)
+{
+    Dwarf_Off dieoff = 0;
+    Dwarf_Die namedie = die;
+    Dwarf_Die origin = 0;
+    char *name = 0;
+    int res = 0;
+
+    res = dwarf_die_CU_offset(die,&dieoff,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_diename(die,&name,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY &&
+        (tag == DW_TAG_subprogram || tag == DW_TAG_variable)) {
+        Dwarf_Half refattrs[2] = {DW_AT_specification,
+            DW_AT_abstract_origin};
+        unsigned i = 0;
+
+        for (i = 0; i < 2 && !origin; ++i) {
+            Dwarf_Attribute attr = 0;
+            Dwarf_Off refoff = 0;
+
+            res = dwarf_attr(die,refattrs[i],&attr,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            if (res == DW_DLV_NO_ENTRY) {
+                continue;
+            }
+            res = dwarf_global_formref(attr,&refoff,error);
+            dwarf_dealloc_attribute(attr);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+            res = dwarf_offdie_b(dbg,refoff,TRUE,&origin,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+        }
+        if (!origin) {
+            return DW_DLV_OK;
+        }
+        namedie = origin;
+        res = dwarf_diename(namedie,&name,error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_die(origin);
+            return res;
+        }
+    }
+    if (res == DW_DLV_OK) {
+        res = add_name(dbg,dn,name,cu_index,dieoff,tag,error);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_die(origin);
+            return res;
+        }
+    }
+    if (tag == DW_TAG_subprogram || tag == DW_TAG_variable) {
+        Dwarf_Half linkattrs[2] = {DW_AT_linkage_name,
+            DW_AT_MIPS_linkage_name};
+        unsigned i = 0;
+
+        for (i = 0; i < 2; ++i) {
+            Dwarf_Attribute attr = 0;
+            char *linkname = 0;
+
+            res = dwarf_attr(namedie,linkattrs[i],&attr,error);
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_die(origin);
+                return res;
+            }
+            if (res == DW_DLV_NO_ENTRY) {
+                continue;
+            }
+            res = dwarf_formstring(attr,&linkname,error);
+            dwarf_dealloc_attribute(attr);
+            if (res == DW_DLV_OK &&
+                (!name || strcmp(name,linkname))) {
+                res = add_name(dbg,dn,linkname,cu_index,
+                    dieoff,tag,error);
+            }
+            if (res == DW_DLV_ERROR) {
+                dwarf_dealloc_die(origin);
+                return res;
+            }
+            break;
+        }
+    }
+    dwarf_dealloc_die(origin);
+    return DW_DLV_OK;
+}
+
+static int index_children(Dwarf_Debug dbg,
+    struct Dwarf_P_Dnames_s *dn, Dwarf_Unsigned cu_index,
+    Dwarf_Die parent, Dwarf_Error *error);
+
+/*  _dwarf_dnames_tag_indexed() picks the DIEs,
+    declarations are left out. */
+static int
+index_one_die(Dwarf_Debug dbg, struct Dwarf_P_Dnames_s *dn,
+    Dwarf_Unsigned cu_index, Dwarf_Die die, Dwarf_Error *error)
+{
+    Dwarf_Half tag = 0;
+    int indexit = FALSE;
+    int descend = FALSE;
+    int res = 0;
+
+    res = dwarf_tag(die,&tag,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    indexit = _dwarf_dnames_tag_indexed(tag,&descend);
+    if (indexit) {
+        Dwarf_Bool isdecl = FALSE;
+
+        res = is_declaration(die,&isdecl,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!isdecl) {
+            res = index_die_names(dbg,dn,cu_index,die,tag,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+    }
+    if (descend) {
+        return index_children(dbg,dn,cu_index,die,error);
+    }
+    return DW_DLV_OK;
+}
+
+static int
+index_children(Dwarf_Debug dbg, struct Dwarf_P_Dnames_s *dn,
+    Dwarf_Unsigned cu_index, Dwarf_Die parent, Dwarf_Error *error)
+{
+    Dwarf_Die child = 0;
+    int res = 0;
+
+    res = dwarf_child(parent,&child,error);
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (;;) {
+        Dwarf_Die sib = 0;
+
+        res = index_one_die(dbg,dn,cu_index,child,error);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_die(child);
+            return res;
+        }
+        res = dwarf_siblingof_b(dbg,child,TRUE,&sib,error);
+        dwarf_dealloc_die(child);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        child = sib;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Reads every CU of .debug_info into the builder. */
+static int
+index_all_cus(Dwarf_Debug dbg, struct Dwarf_P_Dnames_s *dn,
+    Dwarf_Error *error)
+{
+    for (;;) {
+        Dwarf_Unsigned next_cu_header = 0;
+        Dwarf_Half header_cu_type = 0;
+        Dwarf_Die cudie = 0;
+        Dwarf_Off cu_offset = 0;
+        Dwarf_Off cu_length = 0;
+        Dwarf_Unsigned cu_index = 0;
+        int errnum = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg,TRUE,0,0,0,0,0,0,0,0,
+            &next_cu_header,&header_cu_type,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            return DW_DLV_OK;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_siblingof_b(dbg,0,TRUE,&cudie,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            continue;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_die_CU_offset_range(cudie,&cu_offset,
+            &cu_length,error);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_die(cudie);
+            return res;
+        }
+        res = _dwarf_pro_dnames_add_cu(dn,cu_offset,&cu_index,
+            &errnum);
+        if (res != DW_DLV_OK) {
+            dwarf_dealloc_die(cudie);
+            _dwarf_error(dbg,error,errnum);
+            return res;
+        }
+        res = index_children(dbg,dn,cu_index,cudie,error);
+        dwarf_dealloc_die(cudie);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+}
+
+/*  Writes val in the object's byte order. */
+static void
+sidecar_put_val(Dwarf_Debug dbg, Dwarf_Small *dest,
+    Dwarf_Unsigned val)
+{
+#ifdef WORDS_BIGENDIAN
+    dbg->de_copy_word(dest,((const char *)&val) +
+        sizeof(val) - SIDECAR_FIELD_SIZE,SIDECAR_FIELD_SIZE);
+#else
+    dbg->de_copy_word(dest,(const char *)&val,
+        SIDECAR_FIELD_SIZE);
+#endif
+}
+
+/*  FNV-1a (64 bit) of the sections the index is built
+    from, so a sidecar of an object rebuilt with
+    different DWARF of the same size is seen to be stale.
+    Each section is hashed as soon as it is loaded,
+    before loading the next can evict it. */
+static int
+sidecar_checksum(Dwarf_Debug dbg, Dwarf_Unsigned *sum_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Section_s *secs[4];
+    Dwarf_Unsigned h = 14695981039346656037ULL;
+    unsigned i = 0;
+
+    secs[0] = &dbg->de_debug_info;
+    secs[1] = &dbg->de_debug_abbrev;
+    secs[2] = &dbg->de_debug_str;
+    secs[3] = &dbg->de_debug_str_offsets;
+    for (i = 0; i < 4; ++i) {
+        struct Dwarf_Section_s *sec = secs[i];
+        Dwarf_Small *p = 0;
+        Dwarf_Small *end = 0;
+        int res = 0;
+
+        res = _dwarf_load_section(dbg,sec,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY || !sec->dss_size) {
+            continue;
+        }
+        p = sec->dss_data;
+        end = p + sec->dss_size;
+        for ( ; p < end; ++p) {
+            h ^= *p;
+            h *= 1099511628211ULL;
+        }
+        /*  Ends each section, so moving bytes from one
+            to the next changes the sum. */
+        h ^= 0xff;
+        h *= 1099511628211ULL;
+    }
+    *sum_out = h;
+    return DW_DLV_OK;
+}
+
+static char *
+default_sidecar_path(Dwarf_Debug dbg)
+{
+    char *path = 0;
+    size_t len = 0;
+
+    if (!dbg->de_path) {
+        return 0;
+    }
+    len = strlen(dbg->de_path);
+    path = (char *)malloc(len + sizeof(DNAMES_SIDECAR_SUFFIX));
+    if (!path) {
+        return 0;
+    }
+    strcpy(path,dbg->de_path);
+    strcpy(path+len,DNAMES_SIDECAR_SUFFIX);
+    return path;
+}
+
+/*  Builds a .debug_names index of all the CUs in
+    .debug_info and writes it to sidecar_path, or,
+    if that is null, to the dwarf_init_path() path
+    with ".dnames" appended.
+    This uses dwarf_next_cu_header_d() so do not call it
+    from inside your own loop over the CUs. */
+int
+dwarf_debugnames_write_sidecar(Dwarf_Debug dbg,
+    const char *     sidecar_path,
+    Dwarf_Unsigned * names_count,
+    Dwarf_Error *    error)
+{
+    struct Dwarf_P_Dnames_s dn;
+    struct sidecar_strings_s ss;
+    Dwarf_Small header[DNAMES_SIDECAR_HEADER_SIZE];
+    Dwarf_Small *names = 0;
+    Dwarf_Unsigned names_size = 0;
+    Dwarf_Unsigned checksum = 0;
+    char *path = 0;
+    FILE *f = 0;
+    int errnum = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL,error,DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (sidecar_path) {
+        path = strdup(sidecar_path);
+    } else {
+        path = default_sidecar_path(dbg);
+    }
+    if (!path) {
+        _dwarf_error(dbg,error,DW_DLE_NO_FILE_NAME);
+        return DW_DLV_ERROR;
+    }
+    res = sidecar_checksum(dbg,&checksum,error);
+    if (res != DW_DLV_OK) {
+        free(path);
+        return res;
+    }
+    memset(&dn,0,sizeof(dn));
+    memset(&ss,0,sizeof(ss));
+    res = index_all_cus(dbg,&dn,error);
+    if (res != DW_DLV_OK) {
+        _dwarf_pro_dnames_destroy(&dn);
+        free(path);
+        return res;
+    }
+    if (!dn.dn_cunit_offset.dne_used) {
+        _dwarf_pro_dnames_destroy(&dn);
+        free(path);
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_pro_dnames_serialize(&dn,dbg->de_copy_word,
+        DWARF_32BIT_SIZE,0,
+        sidecar_str_append,&ss,&names,&names_size,&errnum);
+    if (res != DW_DLV_OK) {
+        _dwarf_pro_dnames_destroy(&dn);
+        free(ss.ss_data);
+        free(path);
+        _dwarf_error(dbg,error,errnum);
+        return res;
+    }
+    if (names_count) {
+        *names_count = dn.dn_distinct_names;
+    }
+    _dwarf_pro_dnames_destroy(&dn);
+
+    memcpy(header,DNAMES_SIDECAR_MAGIC,SIDECAR_FIELD_SIZE);
+    sidecar_put_val(dbg,header+8,dbg->de_debug_info.dss_size);
+    sidecar_put_val(dbg,header+16,checksum);
+    sidecar_put_val(dbg,header+24,names_size);
+    sidecar_put_val(dbg,header+32,ss.ss_used);
+    f = fopen(path,"wb");
+    if (!f) {
+        free(names);
+        free(ss.ss_data);
+        free(path);
+        _dwarf_error(dbg,error,DW_DLE_OPEN_FAIL);
+        return DW_DLV_ERROR;
+    }
+    if (fwrite(header,1,sizeof(header),f) != sizeof(header) ||
+        fwrite(names,1,names_size,f) != names_size ||
+        (ss.ss_used &&
+        fwrite(ss.ss_data,1,ss.ss_used,f) != ss.ss_used)) {
+        res = DW_DLV_ERROR;
+    }
+    if (fclose(f)) {
+        res = DW_DLV_ERROR;
+    }
+    free(names);
+    free(ss.ss_data);
+    if (res != DW_DLV_OK) {
+        remove(path);
+        free(path);
+        _dwarf_error(dbg,error,DW_DLE_FILE_UNAVAILABLE);
+        return DW_DLV_ERROR;
+    }
+    free(path);
+    return DW_DLV_OK;
+}
+
+/*  New October 2026.
+    Reads the sidecar at sidecar_path, or if that is
+    null at the dwarf_init_path() path with ".dnames"
+    appended, into dbg->de_dnames_sidecar, replacing
+    any read before.  Returns DW_DLV_NO_ENTRY if there
+    is no such file or it was built from other DWARF
+    than dbg's (a stale sidecar), leaving dbg with
+    no sidecar. */
+int
+dwarf_debugnames_use_sidecar(Dwarf_Debug dbg,
+    const char *     sidecar_path,
+    Dwarf_Error *    error)
+{
+    struct Dwarf_Dnames_Sidecar_s *sc = 0;
+    Dwarf_Small *data = 0;
+    Dwarf_Small *endp = 0;
+    Dwarf_Unsigned info_size = 0;
+    Dwarf_Unsigned file_checksum = 0;
+    Dwarf_Unsigned checksum = 0;
+    Dwarf_Unsigned names_size = 0;
+    Dwarf_Unsigned strings_size = 0;
+    struct stat statbuf;
+    char *path = 0;
+    int fd = -1;
+    int errc = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL,error,DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (dbg->de_dnames_sidecar) {
+        return DW_DLV_OK;
+    }
+    if (sidecar_path) {
+        path = strdup(sidecar_path);
+    } else {
+        path = default_sidecar_path(dbg);
+    }
+    if (!path) {
+        _dwarf_error(dbg,error,DW_DLE_NO_FILE_NAME);
+        return DW_DLV_ERROR;
+    }
+    fd = open(path,O_RDONLY|O_BINARY);
+    free(path);
+    if (fd < 0) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (fstat(fd,&statbuf) ||
+        statbuf.st_size < DNAMES_SIDECAR_HEADER_SIZE) {
+        close(fd);
+        return DW_DLV_NO_ENTRY;
+    }
+    data = (Dwarf_Small *)malloc(statbuf.st_size);
+    if (!data) {
+        close(fd);
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_object_read_random(fd,(char *)data,0,
+        statbuf.st_size,statbuf.st_size,&errc);
+    close(fd);
+    if (res != DW_DLV_OK) {
+        free(data);
+        _dwarf_error(dbg,error,errc);
+        return DW_DLV_ERROR;
+    }
+    if (memcmp(data,DNAMES_SIDECAR_MAGIC,SIDECAR_FIELD_SIZE)) {
+        /*  Not a sidecar of ours. */
+        free(data);
+        return DW_DLV_NO_ENTRY;
+    }
+    endp = data + statbuf.st_size;
+    READ_UNALIGNED_CK(dbg,info_size,Dwarf_Unsigned,data+8,
+        SIDECAR_FIELD_SIZE,error,endp);
+    READ_UNALIGNED_CK(dbg,file_checksum,Dwarf_Unsigned,data+16,
+        SIDECAR_FIELD_SIZE,error,endp);
+    READ_UNALIGNED_CK(dbg,names_size,Dwarf_Unsigned,data+24,
+        SIDECAR_FIELD_SIZE,error,endp);
+    READ_UNALIGNED_CK(dbg,strings_size,Dwarf_Unsigned,data+32,
+        SIDECAR_FIELD_SIZE,error,endp);
+    if (info_size != dbg->de_debug_info.dss_size) {
+        /*  Built from some other version of the object. */
+        free(data);
+        return DW_DLV_NO_ENTRY;
+    }
+    res = sidecar_checksum(dbg,&checksum,error);
+    if (res != DW_DLV_OK) {
+        free(data);
+        return res;
+    }
+    if (checksum != file_checksum) {
+        /*  The same size but other DWARF. */
+        free(data);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (names_size > (Dwarf_Unsigned)statbuf.st_size ||
+        strings_size > (Dwarf_Unsigned)statbuf.st_size ||
+        (DNAMES_SIDECAR_HEADER_SIZE + names_size + strings_size) !=
+            (Dwarf_Unsigned)statbuf.st_size ||
+        (strings_size && endp[-1])) {
+        free(data);
+        _dwarf_error(dbg,error,DW_DLE_DEBUG_NAMES_SIDECAR_ERROR);
+        return DW_DLV_ERROR;
+    }
+    sc = (struct Dwarf_Dnames_Sidecar_s *)calloc(1,sizeof(*sc));
+    if (!sc) {
+        free(data);
+        _dwarf_error(dbg,error,DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    sc->dsc_file_data = data;
+    sc->dsc_file_size = statbuf.st_size;
+    sc->dsc_names = data + DNAMES_SIDECAR_HEADER_SIZE;
+    sc->dsc_names_size = names_size;
+    sc->dsc_strings = sc->dsc_names + names_size;
+    sc->dsc_strings_size = strings_size;
+    dbg->de_dnames_sidecar = sc;
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_dnames_sidecar_destroy(Dwarf_Debug dbg)
+{
+    struct Dwarf_Dnames_Sidecar_s *sc = dbg->de_dnames_sidecar;
+
+    if (!sc) {
+        return;
+    }
+    free(sc->dsc_file_data);
+    free(sc);
+    dbg->de_dnames_sidecar = 0;
+}
@@ -0,0 +1,907 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Split DWARF without a .dwp: an executable whose
+    skeleton units each name a .dwo file.  A
+    Dwarf_Dwo_Session lists the skeleton units once, keyed
+    by DW_AT_dwo_id, by DW_AT_dwo_name with DW_AT_comp_dir
+    and by skeleton CU DIE offset, and opens a .dwo only
+    when a lookup needs it.  At most ds_max_open .dwo
+    files are open at once, the least recently used is
+    closed to make room.  Each lookup holds its .dwo open
+    until dwarf_dwo_session_release(), so a held .dwo is
+    never closed and the limit is exceeded rather than
+    close one.
+
+    Each .dwo opened is tied (dwarf_set_tied_dbg()) to the
+    executable, so DW_FORM_addrx and the like in it read
+    .debug_addr of the executable at the cc_addr_base of
+    the skeleton unit. Every skeleton unit is recorded
+    with the executable's tied signature search when the
+    session is created, so that never reads the executable
+    .debug_info again. */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include <string.h>
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarfstring.h"
+
+#define TRUE  1
+#define FALSE 0
+
+struct Dwarf_Dwo_Unit_s {
+    Dwarf_Off      du_skeleton_offset;
+    Dwarf_Bool     du_has_id;
+    Dwarf_Sig8     du_dwo_id;
+    /* malloc copies, du_comp_dir may be NULL. */
+    char          *du_dwo_name;
+    char          *du_comp_dir;
+
+    /*  Non-zero while the .dwo is open, du_prev and
+        du_next then link it into the LRU list. */
+    Dwarf_Debug    du_dbg;
+    Dwarf_Off      du_dwo_cu_die_offset;
+    struct Dwarf_Dwo_Unit_s *du_prev;
+    struct Dwarf_Dwo_Unit_s *du_next;
+    /*  Set once no .dwo file was found, so a missing
+        file is looked for only once. */
+    Dwarf_Bool     du_missing;
+    /*  Lookups returning du_dbg not yet released.
+        Only a unit with none is closed to make room. */
+    Dwarf_Unsigned du_hold_count;
+};
+
+struct Dwarf_Dwo_Session_s {
+    Dwarf_Debug    ds_dbg;
+    char          *ds_search_dir;
+
+    /* In .debug_info order, so by skeleton offset. */
+    struct Dwarf_Dwo_Unit_s  *ds_units;
+    Dwarf_Unsigned ds_unit_count;
+    /*  ds_units entries sorted by dwo_id (only those
+        with one) and by dwo_name then comp_dir. */
+    struct Dwarf_Dwo_Unit_s **ds_by_id;
+    Dwarf_Unsigned ds_by_id_count;
+    struct Dwarf_Dwo_Unit_s **ds_by_name;
+
+    /*  Most recently used first. ds_max_open zero
+        means no limit. */
+    struct Dwarf_Dwo_Unit_s *ds_lru_head;
+    struct Dwarf_Dwo_Unit_s *ds_lru_tail;
+    Dwarf_Unsigned ds_max_open;
+    Dwarf_Unsigned ds_open_count;
+    Dwarf_Unsigned ds_opens;
+    Dwarf_Unsigned ds_evictions;
+};
+
+static int
+session_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory building the "
+        "split DWARF session");
+    return DW_DLV_ERROR;
+}
+
+static char *
+dup_string(const char *s)
+{
+    size_t len = strlen(s);
+    char *out = (char *)malloc(len+1);
+
+    if (out) {
+        memcpy(out,s,len+1);
+    }
+    return out;
+}
+
+static int
+compare_by_id(const void *l, const void *r)
+{
+    const struct Dwarf_Dwo_Unit_s *lu =
+        *(const struct Dwarf_Dwo_Unit_s *const*)l;
+    const struct Dwarf_Dwo_Unit_s *ru =
+        *(const struct Dwarf_Dwo_Unit_s *const*)r;
+    int res = memcmp(&lu->du_dwo_id,&ru->du_dwo_id,
+        sizeof(Dwarf_Sig8));
+
+    if (res) {
+        return res;
+    }
+    /* Keep .debug_info order among duplicates. */
+    if (lu->du_skeleton_offset < ru->du_skeleton_offset) {
+        return -1;
+    }
+    return lu->du_skeleton_offset > ru->du_skeleton_offset;
+}
+
+static int
+compare_names(const char *lname, const char *ldir,
+    const char *rname, const char *rdir)
+{
+    int res = strcmp(lname,rname);
+
+    if (res) {
+        return res;
+    }
+    if (!ldir || !rdir) {
+        return ldir? 1 : (rdir? -1 : 0);
+    }
+    return strcmp(ldir,rdir);
+}
+
+static int
+compare_by_name(const void *l, const void *r)
+{
+    const struct Dwarf_Dwo_Unit_s *lu =
+        *(const struct Dwarf_Dwo_Unit_s *const*)l;
+    const struct Dwarf_Dwo_Unit_s *ru =
+        *(const struct Dwarf_Dwo_Unit_s *const*)r;
+    int res = compare_names(lu->du_dwo_name,lu->du_comp_dir,
+        ru->du_dwo_name,ru->du_comp_dir);
+
+    if (res) {
+        return res;
+    }
+    if (lu->du_skeleton_offset < ru->du_skeleton_offset) {
+        return -1;
+    }
+    return lu->du_skeleton_offset > ru->du_skeleton_offset;
+}
+
+static void
+session_free(struct Dwarf_Dwo_Session_s *s)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < s->ds_unit_count; ++i) {
+        struct Dwarf_Dwo_Unit_s *u = s->ds_units + i;
+
+        if (u->du_dbg) {
+            dwarf_finish(u->du_dbg,0);
+        }
+        free(u->du_dwo_name);
+        free(u->du_comp_dir);
+    }
+    free(s->ds_units);
+    free(s->ds_by_id);
+    free(s->ds_by_name);
+    free(s->ds_search_dir);
+    free(s);
+}
+
+/*  Appends the skeleton unit of cudie, if it is one,
+    to s->ds_units. */
+static int
+add_unit(struct Dwarf_Dwo_Session_s *s,
+    Dwarf_Die cudie,
+    Dwarf_Off dieoffset,
+    Dwarf_Unsigned *alloc,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = s->ds_dbg;
+    Dwarf_CU_Context context = cudie->di_cu_context;
+    struct Dwarf_Dwo_Unit_s *u = 0;
+    Dwarf_Attribute attr = 0;
+    int res = 0;
+
+    if (!context->cc_dwo_name_present || !context->cc_dwo_name) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (s->ds_unit_count >= *alloc) {
+        Dwarf_Unsigned newalloc = *alloc? *alloc*2 : 16;
+        struct Dwarf_Dwo_Unit_s *newunits =
+            (struct Dwarf_Dwo_Unit_s *)realloc(s->ds_units,
+            newalloc*sizeof(struct Dwarf_Dwo_Unit_s));
+
+        if (!newunits) {
+            return session_alloc_error(dbg,error);
+        }
+        s->ds_units = newunits;
+        *alloc = newalloc;
+    }
+    u = s->ds_units + s->ds_unit_count;
+    memset(u,0,sizeof(*u));
+    u->du_skeleton_offset = dieoffset;
+    if (context->cc_signature_present) {
+        u->du_has_id = TRUE;
+        u->du_dwo_id = context->cc_signature;
+    }
+    u->du_dwo_name = dup_string(context->cc_dwo_name);
+    if (!u->du_dwo_name) {
+        return session_alloc_error(dbg,error);
+    }
+    res = dwarf_attr(cudie,DW_AT_comp_dir,&attr,error);
+    if (res == DW_DLV_ERROR) {
+        free(u->du_dwo_name);
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        char *dir = 0;
+
+        res = dwarf_formstring(attr,&dir,error);
+        dwarf_dealloc_attribute(attr);
+        if (res == DW_DLV_ERROR) {
+            free(u->du_dwo_name);
+            return res;
+        }
+        if (res == DW_DLV_OK) {
+            u->du_comp_dir = dup_string(dir);
+            if (!u->du_comp_dir) {
+                free(u->du_dwo_name);
+                return session_alloc_error(dbg,error);
+            }
+        }
+    }
+    s->ds_unit_count++;
+    /*  Failing to record it (out of memory) just means a
+        slower lookup of the skeleton later. */
+    _dwarf_tied_record_context(dbg,context);
+    return DW_DLV_OK;
+}
+
+static int
+build_units(struct Dwarf_Dwo_Session_s *s, Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = s->ds_dbg;
+    Dwarf_Off offset = 0;
+    Dwarf_Unsigned secsize = 0;
+    Dwarf_Unsigned alloc = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = _dwarf_load_debug_info(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    secsize = dbg->de_debug_info.dss_size;
+    /*  Walk the CU headers by offset rather than with
+        dwarf_next_cu_header_d() so a caller part way
+        through its own CU loop is not disturbed. */
+    while (offset < secsize) {
+        Dwarf_Off dieoffset = 0;
+        Dwarf_Die cudie = 0;
+        Dwarf_CU_Context context = 0;
+        Dwarf_Off next = 0;
+
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,offset,TRUE,&dieoffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_offdie_b(dbg,dieoffset,TRUE,&cudie,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        context = cudie->di_cu_context;
+        next = context->cc_debug_offset + context->cc_length +
+            context->cc_length_size + context->cc_extension_size;
+        res = add_unit(s,cudie,dieoffset,&alloc,error);
+        dwarf_dealloc_die(cudie);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (next <= offset) {
+            break;
+        }
+        offset = next;
+    }
+    if (!s->ds_unit_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    s->ds_by_id = (struct Dwarf_Dwo_Unit_s **)malloc(
+        s->ds_unit_count*sizeof(struct Dwarf_Dwo_Unit_s *));
+    s->ds_by_name = (struct Dwarf_Dwo_Unit_s **)malloc(
+        s->ds_unit_count*sizeof(struct Dwarf_Dwo_Unit_s *));
+    if (!s->ds_by_id || !s->ds_by_name) {
+        return session_alloc_error(dbg,error);
+    }
+    for (i = 0; i < s->ds_unit_count; ++i) {
+        struct Dwarf_Dwo_Unit_s *u = s->ds_units + i;
+
+        if (u->du_has_id) {
+            s->ds_by_id[s->ds_by_id_count++] = u;
+        }
+        s->ds_by_name[i] = u;
+    }
+    qsort(s->ds_by_id,s->ds_by_id_count,
+        sizeof(struct Dwarf_Dwo_Unit_s *),compare_by_id);
+    qsort(s->ds_by_name,s->ds_unit_count,
+        sizeof(struct Dwarf_Dwo_Unit_s *),compare_by_name);
+    return DW_DLV_OK;
+}
+
+static void
+lru_unlink(struct Dwarf_Dwo_Session_s *s,
+    struct Dwarf_Dwo_Unit_s *u)
+{
+    if (u->du_prev) {
+        u->du_prev->du_next = u->du_next;
+    } else {
+        s->ds_lru_head = u->du_next;
+    }
+    if (u->du_next) {
+        u->du_next->du_prev = u->du_prev;
+    } else {
+        s->ds_lru_tail = u->du_prev;
+    }
+    u->du_prev = 0;
+    u->du_next = 0;
+}
+
+static void
+lru_push_front(struct Dwarf_Dwo_Session_s *s,
+    struct Dwarf_Dwo_Unit_s *u)
+{
+    u->du_prev = 0;
+    u->du_next = s->ds_lru_head;
+    if (s->ds_lru_head) {
+        s->ds_lru_head->du_prev = u;
+    } else {
+        s->ds_lru_tail = u;
+    }
+    s->ds_lru_head = u;
+}
+
+static void
+close_unit(struct Dwarf_Dwo_Session_s *s,
+    struct Dwarf_Dwo_Unit_s *u)
+{
+    lru_unlink(s,u);
+    dwarf_finish(u->du_dbg,0);
+    u->du_dbg = 0;
+    u->du_dwo_cu_die_offset = 0;
+    s->ds_open_count--;
+}
+
+/*  Closes least recently used .dwo files not held
+    by a caller until no more than limit are open,
+    or none is left to close. */
+static void
+trim_to(struct Dwarf_Dwo_Session_s *s, Dwarf_Unsigned limit)
+{
+    struct Dwarf_Dwo_Unit_s *u = s->ds_lru_tail;
+
+    while (s->ds_open_count > limit && u) {
+        struct Dwarf_Dwo_Unit_s *prev = u->du_prev;
+
+        if (!u->du_hold_count) {
+            close_unit(s,u);
+            s->ds_evictions++;
+        }
+        u = prev;
+    }
+}
+
+/*  Finds the split compile unit of the newly opened dwo
+    and checks its dwo_id against the skeleton.  Sets
+    *mismatch and returns DW_DLV_NO_ENTRY if it differs. */
+static int
+check_dwo_unit(struct Dwarf_Dwo_Unit_s *u,
+    Dwarf_Debug dwo,
+    Dwarf_Off *cu_die_offset_out,
+    Dwarf_Bool *mismatch,
+    Dwarf_Error *error)
+{
+    Dwarf_Off offset = 0;
+    Dwarf_Unsigned secsize = 0;
+    int res = 0;
+
+    res = _dwarf_load_debug_info(dwo,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    secsize = dwo->de_debug_info.dss_size;
+    while (offset < secsize) {
+        Dwarf_Off dieoffset = 0;
+        Dwarf_Die cudie = 0;
+        Dwarf_CU_Context context = 0;
+        Dwarf_Off next = 0;
+
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dwo,offset,TRUE,&dieoffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_offdie_b(dwo,dieoffset,TRUE,&cudie,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        context = cudie->di_cu_context;
+        dwarf_dealloc_die(cudie);
+        /*  A DWARF5 .dwo can hold split type units
+            too, their signature is a type signature. */
+        if (context->cc_unit_type != DW_UT_type &&
+            context->cc_unit_type != DW_UT_split_type) {
+            if (u->du_has_id && context->cc_signature_present &&
+                memcmp(&u->du_dwo_id,&context->cc_signature,
+                    sizeof(Dwarf_Sig8))) {
+                *mismatch = TRUE;
+                return DW_DLV_NO_ENTRY;
+            }
+            *cu_die_offset_out = dieoffset;
+            return DW_DLV_OK;
+        }
+        next = context->cc_debug_offset + context->cc_length +
+            context->cc_length_size + context->cc_extension_size;
+        if (next <= offset) {
+            break;
+        }
+        offset = next;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  Opens path as the .dwo of u. DW_DLV_NO_ENTRY if
+    there is no such file. */
+static int
+open_path(struct Dwarf_Dwo_Session_s *s,
+    struct Dwarf_Dwo_Unit_s *u,
+    const char *path,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = s->ds_dbg;
+    Dwarf_Debug dwo = 0;
+    Dwarf_Error e = 0;
+    Dwarf_Off cu_die_offset = 0;
+    Dwarf_Bool mismatch = FALSE;
+    int res = 0;
+
+    res = dwarf_init_path(path,0,0,DW_DLC_READ,
+        DW_GROUPNUMBER_ANY,dbg->de_errhand,dbg->de_errarg,
+        &dwo,0,0,0,&e);
+    if (res == DW_DLV_NO_ENTRY) {
+        return res;
+    }
+    if (res == DW_DLV_ERROR) {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_s(&m,
+            "DW_DLE_DWO_OPEN_FAILED: %s: ",(char *)path);
+        dwarfstring_append(&m,e? dwarf_errmsg(e) :
+            "cannot initialize");
+        _dwarf_error_string(dbg,error,DW_DLE_DWO_OPEN_FAILED,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        /*  An error from a failed init has no dbg to
+            free it with, see
+            _dwarf_special_no_dbg_error_malloc(). */
+        return DW_DLV_ERROR;
+    }
+    res = check_dwo_unit(u,dwo,&cu_die_offset,&mismatch,&e);
+    if (res == DW_DLV_OK) {
+        res = dwarf_set_tied_dbg(dwo,dbg,&e);
+    }
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            _dwarf_error_mv_s_to_t(dwo,&e,dbg,error);
+        } else {
+            dwarfstring m;
+
+            dwarfstring_constructor(&m);
+            if (mismatch) {
+                dwarfstring_append_printf_s(&m,
+                    "DW_DLE_DWO_ID_MISMATCH: %s does not have "
+                    "the dwo_id of its skeleton unit",
+                    (char *)path);
+            } else {
+                dwarfstring_append_printf_s(&m,
+                    "DW_DLE_DWO_OPEN_FAILED: %s has no "
+                    "split compilation unit",(char *)path);
+            }
+            _dwarf_error_string(dbg,error,mismatch?
+                DW_DLE_DWO_ID_MISMATCH:DW_DLE_DWO_OPEN_FAILED,
+                dwarfstring_string(&m));
+            dwarfstring_destructor(&m);
+        }
+        dwarf_finish(dwo,0);
+        return DW_DLV_ERROR;
+    }
+    u->du_dbg = dwo;
+    u->du_dwo_cu_die_offset = cu_die_offset;
+    s->ds_open_count++;
+    s->ds_opens++;
+    lru_push_front(s,u);
+    return DW_DLV_OK;
+}
+
+static int
+open_unit(struct Dwarf_Dwo_Session_s *s,
+    struct Dwarf_Dwo_Unit_s *u,
+    Dwarf_Error *error)
+{
+    dwarfstring path;
+    const char *name = u->du_dwo_name;
+    Dwarf_Bool full = _dwarf_file_name_is_full_path(
+        (Dwarf_Small *)name);
+    int res = DW_DLV_NO_ENTRY;
+
+    if (s->ds_max_open) {
+        /* Make room first, open files are the limit. */
+        trim_to(s,s->ds_max_open-1);
+    }
+    dwarfstring_constructor(&path);
+    if (s->ds_search_dir) {
+        const char *base = name;
+
+        if (full) {
+            const char *slash = strrchr(name,'/');
+
+            base = slash? slash+1 : name;
+        }
+        dwarfstring_append(&path,s->ds_search_dir);
+        dwarfstring_append(&path,"/");
+        dwarfstring_append(&path,(char *)base);
+        res = open_path(s,u,dwarfstring_string(&path),error);
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        dwarfstring_reset(&path);
+        if (!full && u->du_comp_dir) {
+            dwarfstring_append(&path,u->du_comp_dir);
+            dwarfstring_append(&path,"/");
+        }
+        dwarfstring_append(&path,(char *)name);
+        res = open_path(s,u,dwarfstring_string(&path),error);
+    }
+    dwarfstring_destructor(&path);
+    if (res == DW_DLV_NO_ENTRY) {
+        u->du_missing = TRUE;
+    }
+    return res;
+}
+
+static int
+use_unit(struct Dwarf_Dwo_Session_s *s,
+    struct Dwarf_Dwo_Unit_s *u,
+    Dwarf_Debug *dwo_dbg_out,
+    Dwarf_Off *dwo_cu_die_offset_out,
+    Dwarf_Error *error)
+{
+    if (u->du_dbg) {
+        if (s->ds_lru_head != u) {
+            lru_unlink(s,u);
+            lru_push_front(s,u);
+        }
+    } else {
+        int res = 0;
+
+        if (u->du_missing) {
+            return DW_DLV_NO_ENTRY;
+        }
+        res = open_unit(s,u,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    u->du_hold_count++;
+    *dwo_dbg_out = u->du_dbg;
+    if (dwo_cu_die_offset_out) {
+        *dwo_cu_die_offset_out = u->du_dwo_cu_die_offset;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dwo_session_create(Dwarf_Debug dbg,
+    const char *search_dir,
+    Dwarf_Unsigned max_open,
+    Dwarf_Dwo_Session *session_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Dwo_Session_s *s = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    s = (struct Dwarf_Dwo_Session_s *)calloc(1,sizeof(*s));
+    if (!s) {
+        return session_alloc_error(dbg,error);
+    }
+    s->ds_dbg = dbg;
+    s->ds_max_open = max_open;
+    if (search_dir && *search_dir) {
+        s->ds_search_dir = dup_string(search_dir);
+        if (!s->ds_search_dir) {
+            session_free(s);
+            return session_alloc_error(dbg,error);
+        }
+    }
+    res = build_units(s,error);
+    if (res != DW_DLV_OK) {
+        session_free(s);
+        return res;
+    }
+    *session_out = s;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_dwo_session_dealloc(Dwarf_Dwo_Session session)
+{
+    if (!session) {
+        return;
+    }
+    session_free(session);
+}
+
+int
+dwarf_dwo_session_set_max_open(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned max_open,
+    Dwarf_Error *error)
+{
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    session->ds_max_open = max_open;
+    if (max_open) {
+        trim_to(session,max_open);
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dwo_session_unit_count(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned *count,
+    Dwarf_Error *error)
+{
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    *count = session->ds_unit_count;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dwo_session_unit(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned index,
+    Dwarf_Off *skeleton_cu_die_offset,
+    Dwarf_Bool *has_dwo_id,
+    Dwarf_Sig8 *dwo_id,
+    const char **dwo_name,
+    const char **comp_dir,
+    Dwarf_Bool *is_open,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Dwo_Unit_s *u = 0;
+
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (index >= session->ds_unit_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    u = session->ds_units + index;
+    if (skeleton_cu_die_offset) {
+        *skeleton_cu_die_offset = u->du_skeleton_offset;
+    }
+    if (has_dwo_id) {
+        *has_dwo_id = u->du_has_id;
+    }
+    if (dwo_id) {
+        *dwo_id = u->du_dwo_id;
+    }
+    if (dwo_name) {
+        *dwo_name = u->du_dwo_name;
+    }
+    if (comp_dir) {
+        *comp_dir = u->du_comp_dir;
+    }
+    if (is_open) {
+        *is_open = u->du_dbg? TRUE : FALSE;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dwo_session_by_id(Dwarf_Dwo_Session session,
+    Dwarf_Sig8 dwo_id,
+    Dwarf_Debug *dwo_dbg_out,
+    Dwarf_Off *dwo_cu_die_offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    hi = session->ds_by_id_count;
+    /* First entry not below dwo_id. */
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+
+        if (memcmp(&session->ds_by_id[mid]->du_dwo_id,&dwo_id,
+            sizeof(Dwarf_Sig8)) < 0) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo >= session->ds_by_id_count ||
+        memcmp(&session->ds_by_id[lo]->du_dwo_id,&dwo_id,
+            sizeof(Dwarf_Sig8))) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return use_unit(session,session->ds_by_id[lo],
+        dwo_dbg_out,dwo_cu_die_offset_out,error);
+}
+
+int
+dwarf_dwo_session_by_name(Dwarf_Dwo_Session session,
+    const char *dwo_name,
+    const char *comp_dir,
+    Dwarf_Debug *dwo_dbg_out,
+    Dwarf_Off *dwo_cu_die_offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!dwo_name) {
+        return DW_DLV_NO_ENTRY;
+    }
+    hi = session->ds_unit_count;
+    /*  First entry not below dwo_name, then the first of
+        those with comp_dir (any with a null comp_dir). */
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+        struct Dwarf_Dwo_Unit_s *u = session->ds_by_name[mid];
+        int res = comp_dir?
+            compare_names(u->du_dwo_name,u->du_comp_dir,
+                dwo_name,comp_dir) :
+            strcmp(u->du_dwo_name,dwo_name);
+
+        if (res < 0) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    for (i = lo; i < session->ds_unit_count; ++i) {
+        struct Dwarf_Dwo_Unit_s *u = session->ds_by_name[i];
+
+        if (strcmp(u->du_dwo_name,dwo_name)) {
+            break;
+        }
+        if (!comp_dir || (u->du_comp_dir &&
+            !strcmp(u->du_comp_dir,comp_dir))) {
+            return use_unit(session,u,dwo_dbg_out,
+                dwo_cu_die_offset_out,error);
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+int
+dwarf_dwo_session_by_skeleton(Dwarf_Dwo_Session session,
+    Dwarf_Off skeleton_cu_die_offset,
+    Dwarf_Debug *dwo_dbg_out,
+    Dwarf_Off *dwo_cu_die_offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    hi = session->ds_unit_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+        Dwarf_Off off = session->ds_units[mid].du_skeleton_offset;
+
+        if (off == skeleton_cu_die_offset) {
+            return use_unit(session,session->ds_units+mid,
+                dwo_dbg_out,dwo_cu_die_offset_out,error);
+        }
+        if (off < skeleton_cu_die_offset) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+int
+dwarf_dwo_session_release(Dwarf_Dwo_Session session,
+    Dwarf_Debug dwo_dbg,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Dwo_Unit_s *u = 0;
+
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    for (u = session->ds_lru_head; u; u = u->du_next) {
+        if (u->du_dbg == dwo_dbg) {
+            break;
+        }
+    }
+    if (!u || !dwo_dbg || !u->du_hold_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    u->du_hold_count--;
+    if (!u->du_hold_count && session->ds_max_open) {
+        /*  Lookups while it was held may have left more
+            open than the limit. */
+        trim_to(session,session->ds_max_open);
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_dwo_session_stats(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned *open_now,
+    Dwarf_Unsigned *opens,
+    Dwarf_Unsigned *evictions,
+    Dwarf_Error *error)
+{
+    if (!session) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (open_now) {
+        *open_now = session->ds_open_count;
+    }
+    if (opens) {
+        *opens = session->ds_opens;
+    }
+    if (evictions) {
+        *evictions = session->ds_evictions;
+    }
+    return DW_DLV_OK;
+}
@@ -271,6 +271,27 @@ elf_load_nolibelf_section (void *obj, Dwarf_Half section_index,
     return DW_DLV_NO_ENTRY;
 }
 
+/*  Gives back the bytes read by elf_load_nolibelf_section()
+    so a section evicted under a section memory budget
+    really releases its memory. The next load
+    reads the section from the file again.
+    New October 2026. */
+static void
+elf_unload_nolibelf_section(void *obj, Dwarf_Half section_index)
+{
+    dwarf_elf_object_access_internals_t *elf =
+        (dwarf_elf_object_access_internals_t*)(obj);
+
+    if (0 < section_index &&
+        section_index < elf->f_loc_shdr.g_count) {
+        struct generic_shdr *sp =
+            elf->f_shdr + section_index;
+
+        free(sp->gh_content);
+        sp->gh_content = 0;
+    }
+}
+
 static int
 _dwarf_get_elf_flags_func_nl(
     void* obj_in,
@@ -626,6 +647,8 @@ _dwarf_elf_nlsetup(int fd,
     }
     intfc = binary_interface->object;
     intfc->f_path = strdup(true_path);
+    (*dbg)->de_section_budget.sb_unload_section =
+        elf_unload_nolibelf_section;
     return res;
 }
 
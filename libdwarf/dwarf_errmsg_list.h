@@ -552,6 +552,33 @@ const char *_dwarf_errmsgs[] = {
     "DW_DLE_DUPLICATE_GNU_DEBUG_PUBTYPES(475) Duplicated section .debug_gnu_pubtypes",
     "DW_DLE_DEBUG_SUP_STRING_ERROR(476) The string in .debug_sup head runs off the end of the section. Corrupt data",
     "DW_DLE_DEBUG_SUP_ERROR(477). .debug_sup data corruption",
+    "DW_DLE_EXPR_STACK_ERROR(478). DWARF expression stack "
+        "underflow or overflow",
+    "DW_DLE_EXPR_UNSUPPORTED_OP(479). DWARF expression operator "
+        "not supported by dwarf_expr_compile",
+    "DW_DLE_EXPR_CALLBACK_FAILED(480). An expression evaluation "
+        "callback is missing or failed",
+    "DW_DLE_EXPR_EVAL_ERROR(481). DWARF expression evaluation "
+        "error (bad branch, division by zero or step limit)",
+    "DW_DLE_MACRO_IMPORT_LOOP(482). A .debug_macro unit "
+        "imports itself, directly or indirectly",
+    "DW_DLE_DEBUG_NAMES_BUILD_ERROR(483). A .debug_names index "
+        "cannot be built (no CUs or an offset over 32 bits)",
+    "DW_DLE_DEBUG_NAMES_SIDECAR_ERROR(484). A .debug_names "
+        "sidecar file is corrupt",
+    "DW_DLE_INLINE_TREE_ERROR(485). The inline frame index "
+        "cannot be built or was misused",
+    "DW_DLE_TYPE_CHAIN_ERROR(486). A DW_AT_type chain is "
+        "too deep (likely a loop) or the type cache was misused",
+    "DW_DLE_DWO_OPEN_FAILED(487). A split DWARF .dwo file "
+        "named by a skeleton unit exists but cannot be read",
+    "DW_DLE_DWO_ID_MISMATCH(488). A .dwo file does not have "
+        "the DW_AT_dwo_id of its skeleton unit (stale .dwo?)",
+    "DW_DLE_UNWIND_ERROR(489). A stack unwinder was misused "
+        "or the frame register table size changed under it",
+    "DW_DLE_PERF_COUNTERS_SIZE(490). The pc_size of the "
+        "Dwarf_Perf_Counters passed to dwarf_get_perf_counters "
+        "was not set",
 
 
 };
@@ -0,0 +1,746 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Compiles a location expression (the Dwarf_Loc_Expr_Op
+    array of a Dwarf_Locdesc_c) once into a flat array of
+    normalized operators and evaluates that against
+    caller-supplied register and memory callbacks.
+    Compiled programs are kept in a dwarf_tsearch tree on
+    the Dwarf_Debug keyed by expression section offset,
+    so a debugger asking about the same variable at
+    many pcs decodes its expression only once. */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* For uintptr_t */
+#endif /* HAVE_STDINT_H */
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_loc.h"
+#include "dwarf_tsearch.h"
+
+#define TRUE  1
+#define FALSE 0
+
+/*  Far more than any compiler generates.
+    Keeps evaluation free of malloc. */
+#define EXPR_STACK_MAX  64
+
+/*  DW_OP_bra can loop. Stop a runaway expression. */
+#define EXPR_STEP_LIMIT 100000
+
+static DW_TSHASHTYPE
+expr_program_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Expr_Program_s *p = keyp;
+
+    return (DW_TSHASHTYPE)(p->ep_section_offset ^
+        ((Dwarf_Unsigned)p->ep_kind << 1) ^ p->ep_is_info);
+}
+
+static int
+expr_program_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Expr_Program_s *lp = l;
+    const struct Dwarf_Expr_Program_s *rp = r;
+
+    if (lp->ep_section_offset < rp->ep_section_offset) {
+        return -1;
+    }
+    if (lp->ep_section_offset > rp->ep_section_offset) {
+        return 1;
+    }
+    if (lp->ep_kind < rp->ep_kind) {
+        return -1;
+    }
+    if (lp->ep_kind > rp->ep_kind) {
+        return 1;
+    }
+    if (lp->ep_is_info < rp->ep_is_info) {
+        return -1;
+    }
+    if (lp->ep_is_info > rp->ep_is_info) {
+        return 1;
+    }
+    return 0;
+}
+
+static void
+expr_program_free(struct Dwarf_Expr_Program_s *p)
+{
+    free(p->ep_ops);
+    free(p->ep_implicit_data);
+    free(p);
+}
+
+static void
+expr_program_free_node(void *nodep)
+{
+    expr_program_free((struct Dwarf_Expr_Program_s *)nodep);
+}
+
+void
+_dwarf_expr_program_cache_destroy(Dwarf_Debug dbg)
+{
+    if (dbg->de_expr_programs) {
+        dwarf_tdestroy(dbg->de_expr_programs,
+            expr_program_free_node);
+        dbg->de_expr_programs = 0;
+    }
+}
+
+/*  Turns a DW_OP_bra/DW_OP_skip byte displacement into
+    the index of the target operator.  Operators are in
+    ascending lr_offset order. A branch to just past the
+    last operator ends the expression. */
+static int
+resolve_branch(Dwarf_Debug dbg,
+    Dwarf_Locdesc_c locdesc,
+    Dwarf_Loc_Expr_Op op,
+    Dwarf_Unsigned *index_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned disp = op->lr_number;
+    Dwarf_Signed target = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = locdesc->ld_cents;
+
+    SIGN_EXTEND(disp,2);
+    /* 1 byte opcode, 2 byte operand. */
+    target = (Dwarf_Signed)op->lr_offset + 3 + (Dwarf_Signed)disp;
+    if (target < 0) {
+        _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+        return DW_DLV_ERROR;
+    }
+    if ((Dwarf_Unsigned)target == locdesc->ld_expr_len) {
+        *index_out = locdesc->ld_cents;
+        return DW_DLV_OK;
+    }
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+        Dwarf_Unsigned moff = locdesc->ld_s[mid].lr_offset;
+
+        if (moff == (Dwarf_Unsigned)target) {
+            *index_out = mid;
+            return DW_DLV_OK;
+        }
+        if (moff < (Dwarf_Unsigned)target) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    /* Into the middle of an operator. */
+    _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+    return DW_DLV_ERROR;
+}
+
+static int
+compile_op(Dwarf_Debug dbg,
+    Dwarf_Locdesc_c locdesc,
+    Dwarf_Loc_Expr_Op op,
+    struct Dwarf_Expr_Program_s *prog,
+    struct Dwarf_Expr_Op_s *out,
+    Dwarf_Unsigned *implicit_used,
+    Dwarf_Error *error)
+{
+    Dwarf_Small atom = op->lr_atom;
+    Dwarf_Loc_Head_c head = locdesc->ld_loclist_head;
+    int res = 0;
+
+    out->eo_atom = atom;
+    out->eo_operand1 = op->lr_number;
+    out->eo_operand2 = op->lr_number2;
+    if (atom >= DW_OP_lit0 && atom <= DW_OP_lit31) {
+        out->eo_atom = DW_OP_constu;
+        out->eo_operand1 = atom - DW_OP_lit0;
+        return DW_DLV_OK;
+    }
+    if (atom >= DW_OP_reg0 && atom <= DW_OP_reg31) {
+        out->eo_atom = DW_OP_regx;
+        out->eo_operand1 = atom - DW_OP_reg0;
+        return DW_DLV_OK;
+    }
+    if (atom >= DW_OP_breg0 && atom <= DW_OP_breg31) {
+        out->eo_atom = DW_OP_bregx;
+        out->eo_operand1 = atom - DW_OP_breg0;
+        out->eo_operand2 = op->lr_number;
+        return DW_DLV_OK;
+    }
+    switch (atom) {
+    case DW_OP_addr:
+    case DW_OP_const1u:
+    case DW_OP_const1s:
+    case DW_OP_const2u:
+    case DW_OP_const2s:
+    case DW_OP_const4u:
+    case DW_OP_const4s:
+    case DW_OP_const8u:
+    case DW_OP_const8s:
+    case DW_OP_constu:
+    case DW_OP_consts:
+        /* The reader already sign-extended the s forms. */
+        out->eo_atom = DW_OP_constu;
+        return DW_DLV_OK;
+    case DW_OP_addrx:
+    case DW_OP_GNU_addr_index:
+    case DW_OP_constx:
+    case DW_OP_GNU_const_index: {
+        Dwarf_Addr addr = 0;
+
+        if (!head->ll_context) {
+            /*  From dwarf_loclist_from_expr_c(): no CU,
+                so no DW_AT_addr_base. */
+            _dwarf_error(dbg, error, DW_DLE_EXPR_UNSUPPORTED_OP);
+            return DW_DLV_ERROR;
+        }
+        res = _dwarf_look_in_local_and_tied_by_index(dbg,
+            head->ll_context,op->lr_number,&addr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        out->eo_atom = DW_OP_constu;
+        out->eo_operand1 = addr;
+        return DW_DLV_OK;
+    }
+    case DW_OP_skip:
+    case DW_OP_bra:
+        return resolve_branch(dbg,locdesc,op,&out->eo_operand1,
+            error);
+    case DW_OP_implicit_value: {
+        Dwarf_Small *src = (Dwarf_Small *)(uintptr_t)op->lr_number2;
+
+        memcpy(prog->ep_implicit_data + *implicit_used,src,
+            op->lr_number);
+        out->eo_operand2 = *implicit_used;
+        *implicit_used += op->lr_number;
+        return DW_DLV_OK;
+    }
+    case DW_OP_regx:
+    case DW_OP_bregx:
+    case DW_OP_fbreg:
+    case DW_OP_dup:
+    case DW_OP_drop:
+    case DW_OP_over:
+    case DW_OP_pick:
+    case DW_OP_swap:
+    case DW_OP_rot:
+    case DW_OP_deref:
+    case DW_OP_deref_size:
+    case DW_OP_abs:
+    case DW_OP_and:
+    case DW_OP_div:
+    case DW_OP_minus:
+    case DW_OP_mod:
+    case DW_OP_mul:
+    case DW_OP_neg:
+    case DW_OP_not:
+    case DW_OP_or:
+    case DW_OP_plus:
+    case DW_OP_plus_uconst:
+    case DW_OP_shl:
+    case DW_OP_shr:
+    case DW_OP_shra:
+    case DW_OP_xor:
+    case DW_OP_eq:
+    case DW_OP_ge:
+    case DW_OP_gt:
+    case DW_OP_le:
+    case DW_OP_lt:
+    case DW_OP_ne:
+    case DW_OP_nop:
+    case DW_OP_call_frame_cfa:
+    case DW_OP_push_object_address:
+    case DW_OP_stack_value:
+        return DW_DLV_OK;
+    default:
+        break;
+    }
+    _dwarf_error(dbg, error, DW_DLE_EXPR_UNSUPPORTED_OP);
+    return DW_DLV_ERROR;
+}
+
+int
+dwarf_expr_compile(Dwarf_Locdesc_c locdesc,
+    Dwarf_Expr_Program *program_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Debug dbg = 0;
+    struct Dwarf_Expr_Program_s key;
+    struct Dwarf_Expr_Program_s *prog = 0;
+    Dwarf_Unsigned implicit_total = 0;
+    Dwarf_Unsigned implicit_used = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Bool cacheable = FALSE;
+    int res = 0;
+
+    if (!locdesc || !locdesc->ld_loclist_head) {
+        _dwarf_error(NULL, error, DW_DLE_LOC_EXPR_BAD);
+        return DW_DLV_ERROR;
+    }
+    head = locdesc->ld_loclist_head;
+    dbg = head->ll_dbg;
+    if (!locdesc->ld_cents) {
+        return DW_DLV_NO_ENTRY;
+    }
+    memset(&key,0,sizeof(key));
+    key.ep_kind = locdesc->ld_kind;
+    key.ep_section_offset = locdesc->ld_section_offset;
+    /*  Without a CU context the section offset is fake
+        (dwarf_loclist_from_expr_c()), so no caching. */
+    if (head->ll_context) {
+        cacheable = TRUE;
+        key.ep_is_info = head->ll_context->cc_is_info;
+    }
+    if (cacheable && dbg->de_expr_programs) {
+        void *found = 0;
+
+        dbg->de_perf_counters.pc_tsearch_ops++;
+        found = dwarf_tfind(&key,&dbg->de_expr_programs,
+            expr_program_compare);
+        if (found) {
+            *program_out =
+                *(struct Dwarf_Expr_Program_s **)found;
+            return DW_DLV_OK;
+        }
+    }
+
+    prog = calloc(1,sizeof(struct Dwarf_Expr_Program_s));
+    if (!prog) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    *prog = key;
+    prog->ep_dbg = dbg;
+    prog->ep_address_size = head->ll_address_size;
+    prog->ep_op_count = locdesc->ld_cents;
+    prog->ep_ops = calloc(locdesc->ld_cents,
+        sizeof(struct Dwarf_Expr_Op_s));
+    for (i = 0; i < locdesc->ld_cents; ++i) {
+        if (locdesc->ld_s[i].lr_atom == DW_OP_implicit_value) {
+            implicit_total += locdesc->ld_s[i].lr_number;
+        }
+    }
+    if (implicit_total) {
+        prog->ep_implicit_data = malloc(implicit_total);
+    }
+    if (!prog->ep_ops || (implicit_total && !prog->ep_implicit_data)) {
+        expr_program_free(prog);
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    for (i = 0; i < locdesc->ld_cents; ++i) {
+        res = compile_op(dbg,locdesc,locdesc->ld_s + i,
+            prog,prog->ep_ops + i,&implicit_used,error);
+        if (res != DW_DLV_OK) {
+            expr_program_free(prog);
+            return res;
+        }
+    }
+
+    if (cacheable) {
+        void *entry = 0;
+
+        if (!dbg->de_expr_programs) {
+            dwarf_initialize_search_hash(&dbg->de_expr_programs,
+                expr_program_hashfunc,0);
+        }
+        if (dbg->de_expr_programs) {
+            dbg->de_perf_counters.pc_tsearch_ops++;
+            entry = dwarf_tsearch(prog,&dbg->de_expr_programs,
+                expr_program_compare);
+        }
+        if (entry) {
+            prog->ep_cached = TRUE;
+        }
+        /*  If out of memory the program is still usable,
+            the caller just owns it. */
+    }
+    *program_out = prog;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_expr_program_dealloc(Dwarf_Expr_Program program)
+{
+    if (!program || program->ep_cached) {
+        return;
+    }
+    expr_program_free(program);
+}
+
+static Dwarf_Signed
+to_signed(Dwarf_Unsigned v, Dwarf_Half address_size)
+{
+    if (address_size < sizeof(Dwarf_Unsigned)) {
+        SIGN_EXTEND(v,address_size);
+    }
+    return (Dwarf_Signed)v;
+}
+
+/*  Calls one of the single-value callbacks. */
+static int
+call_value_callback(Dwarf_Debug dbg,
+    int (*cb)(void *, Dwarf_Unsigned *),
+    void *user_data,
+    Dwarf_Unsigned *value_out,
+    Dwarf_Error *error)
+{
+    int res = 0;
+
+    if (!cb) {
+        _dwarf_error(dbg, error, DW_DLE_EXPR_CALLBACK_FAILED);
+        return DW_DLV_ERROR;
+    }
+    res = cb(user_data,value_out);
+    if (res != DW_DLV_OK) {
+        _dwarf_error(dbg, error, DW_DLE_EXPR_CALLBACK_FAILED);
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+int
+dwarf_expr_evaluate(Dwarf_Expr_Program program,
+    const Dwarf_Expr_Callbacks *callbacks,
+    Dwarf_Expr_Result *result_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Unsigned stack[EXPR_STACK_MAX];
+    Dwarf_Unsigned sp = 0; /* Number of entries on stack. */
+    Dwarf_Unsigned pc = 0;
+    Dwarf_Unsigned steps = 0;
+    Dwarf_Unsigned mask = ~(Dwarf_Unsigned)0;
+    Dwarf_Half asize = 0;
+    Dwarf_Expr_Callbacks nocallbacks;
+    void *ud = 0;
+    int res = 0;
+
+    if (!program) {
+        _dwarf_error(NULL, error, DW_DLE_LOC_EXPR_BAD);
+        return DW_DLV_ERROR;
+    }
+    dbg = program->ep_dbg;
+    if (!callbacks) {
+        memset(&nocallbacks,0,sizeof(nocallbacks));
+        callbacks = &nocallbacks;
+    }
+    ud = callbacks->ec_user_data;
+    asize = program->ep_address_size;
+    if (asize && asize < sizeof(Dwarf_Unsigned)) {
+        mask = (((Dwarf_Unsigned)1) << (asize*8)) - 1;
+    }
+    memset(result_out,0,sizeof(*result_out));
+    result_out->er_kind = DW_EXPR_RESULT_ADDRESS;
+
+/*  Each needs the stack depth checked first. */
+#define NEED(n) \
+    do { \
+        if (sp < (n)) { \
+            _dwarf_error(dbg, error, DW_DLE_EXPR_STACK_ERROR); \
+            return DW_DLV_ERROR; \
+        } \
+    } while (0)
+#define PUSH(v) \
+    do { \
+        Dwarf_Unsigned pushval_ = (v); \
+        if (sp >= EXPR_STACK_MAX) { \
+            _dwarf_error(dbg, error, DW_DLE_EXPR_STACK_ERROR); \
+            return DW_DLV_ERROR; \
+        } \
+        stack[sp] = pushval_ & mask; \
+        ++sp; \
+    } while (0)
+
+    while (pc < program->ep_op_count) {
+        struct Dwarf_Expr_Op_s *op = program->ep_ops + pc;
+        Dwarf_Unsigned a = 0;
+        Dwarf_Unsigned b = 0;
+        Dwarf_Unsigned v = 0;
+
+        if (++steps > EXPR_STEP_LIMIT) {
+            _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+            return DW_DLV_ERROR;
+        }
+        ++pc;
+        switch (op->eo_atom) {
+        case DW_OP_constu:
+            PUSH(op->eo_operand1);
+            break;
+        case DW_OP_regx:
+            /*  A register location description
+                must stand alone. */
+            if (pc != program->ep_op_count) {
+                _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+                return DW_DLV_ERROR;
+            }
+            result_out->er_kind = DW_EXPR_RESULT_REGISTER;
+            result_out->er_value = op->eo_operand1;
+            return DW_DLV_OK;
+        case DW_OP_bregx:
+            if (!callbacks->ec_read_register) {
+                _dwarf_error(dbg, error, DW_DLE_EXPR_CALLBACK_FAILED);
+                return DW_DLV_ERROR;
+            }
+            res = callbacks->ec_read_register(ud,op->eo_operand1,&v);
+            if (res != DW_DLV_OK) {
+                _dwarf_error(dbg, error, DW_DLE_EXPR_CALLBACK_FAILED);
+                return DW_DLV_ERROR;
+            }
+            PUSH(v + op->eo_operand2);
+            break;
+        case DW_OP_fbreg:
+            res = call_value_callback(dbg,callbacks->ec_frame_base,
+                ud,&v,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            PUSH(v + op->eo_operand1);
+            break;
+        case DW_OP_call_frame_cfa:
+            res = call_value_callback(dbg,
+                callbacks->ec_call_frame_cfa,ud,&v,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            PUSH(v);
+            break;
+        case DW_OP_push_object_address:
+            res = call_value_callback(dbg,
+                callbacks->ec_object_address,ud,&v,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            PUSH(v);
+            break;
+        case DW_OP_dup:
+            NEED(1);
+            PUSH(stack[sp-1]);
+            break;
+        case DW_OP_drop:
+            NEED(1);
+            --sp;
+            break;
+        case DW_OP_over:
+            NEED(2);
+            PUSH(stack[sp-2]);
+            break;
+        case DW_OP_pick:
+            NEED(op->eo_operand1+1);
+            PUSH(stack[sp-1-op->eo_operand1]);
+            break;
+        case DW_OP_swap:
+            NEED(2);
+            a = stack[sp-1];
+            stack[sp-1] = stack[sp-2];
+            stack[sp-2] = a;
+            break;
+        case DW_OP_rot:
+            NEED(3);
+            a = stack[sp-1];
+            stack[sp-1] = stack[sp-2];
+            stack[sp-2] = stack[sp-3];
+            stack[sp-3] = a;
+            break;
+        case DW_OP_deref:
+        case DW_OP_deref_size: {
+            Dwarf_Unsigned size = asize;
+
+            NEED(1);
+            if (op->eo_atom == DW_OP_deref_size) {
+                size = op->eo_operand1;
+            }
+            if (!size || size > sizeof(Dwarf_Unsigned)) {
+                _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+                return DW_DLV_ERROR;
+            }
+            if (!callbacks->ec_read_memory) {
+                _dwarf_error(dbg, error, DW_DLE_EXPR_CALLBACK_FAILED);
+                return DW_DLV_ERROR;
+            }
+            a = stack[--sp];
+            res = callbacks->ec_read_memory(ud,a,size,&v);
+            if (res != DW_DLV_OK) {
+                _dwarf_error(dbg, error, DW_DLE_EXPR_CALLBACK_FAILED);
+                return DW_DLV_ERROR;
+            }
+            PUSH(v);
+            break;
+        }
+        case DW_OP_abs: {
+            Dwarf_Signed s = 0;
+
+            NEED(1);
+            s = to_signed(stack[sp-1],asize);
+            if (s < 0) {
+                stack[sp-1] = (0 - stack[sp-1]) & mask;
+            }
+            break;
+        }
+        case DW_OP_neg:
+            NEED(1);
+            stack[sp-1] = (0 - stack[sp-1]) & mask;
+            break;
+        case DW_OP_not:
+            NEED(1);
+            stack[sp-1] = (~stack[sp-1]) & mask;
+            break;
+        case DW_OP_plus_uconst:
+            NEED(1);
+            stack[sp-1] = (stack[sp-1] + op->eo_operand1) & mask;
+            break;
+        case DW_OP_and:
+        case DW_OP_div:
+        case DW_OP_minus:
+        case DW_OP_mod:
+        case DW_OP_mul:
+        case DW_OP_or:
+        case DW_OP_plus:
+        case DW_OP_shl:
+        case DW_OP_shr:
+        case DW_OP_shra:
+        case DW_OP_xor:
+        case DW_OP_eq:
+        case DW_OP_ge:
+        case DW_OP_gt:
+        case DW_OP_le:
+        case DW_OP_lt:
+        case DW_OP_ne: {
+            Dwarf_Signed sa = 0;
+            Dwarf_Signed sb = 0;
+
+            /*  b is the top of stack, a the entry below.
+                The result is a op b. */
+            NEED(2);
+            b = stack[--sp];
+            a = stack[--sp];
+            sa = to_signed(a,asize);
+            sb = to_signed(b,asize);
+            switch (op->eo_atom) {
+            case DW_OP_and:   v = a & b; break;
+            case DW_OP_or:    v = a | b; break;
+            case DW_OP_xor:   v = a ^ b; break;
+            case DW_OP_plus:  v = a + b; break;
+            case DW_OP_minus: v = a - b; break;
+            case DW_OP_mul:   v = a * b; break;
+            case DW_OP_div:
+                if (!b) {
+                    _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+                    return DW_DLV_ERROR;
+                }
+                if (sb == -1) {
+                    /* Avoid INT64_MIN / -1 overflow. */
+                    v = 0 - a;
+                } else {
+                    v = (Dwarf_Unsigned)(sa / sb);
+                }
+                break;
+            case DW_OP_mod:
+                if (!b) {
+                    _dwarf_error(dbg, error, DW_DLE_EXPR_EVAL_ERROR);
+                    return DW_DLV_ERROR;
+                }
+                v = a % b;
+                break;
+            case DW_OP_shl:
+                v = (b >= 64)? 0 : (a << b);
+                break;
+            case DW_OP_shr:
+                v = (b >= 64)? 0 : (a >> b);
+                break;
+            case DW_OP_shra:
+                if (b >= 64) {
+                    v = (sa < 0)? ~(Dwarf_Unsigned)0 : 0;
+                } else if (sa < 0) {
+                    /*  Right shift of a negative value is
+                        implementation defined in C. */
+                    v = ~((~(Dwarf_Unsigned)sa) >> b);
+                } else {
+                    v = (Dwarf_Unsigned)sa >> b;
+                }
+                break;
+            case DW_OP_eq: v = (sa == sb); break;
+            case DW_OP_ne: v = (sa != sb); break;
+            case DW_OP_ge: v = (sa >= sb); break;
+            case DW_OP_gt: v = (sa >  sb); break;
+            case DW_OP_le: v = (sa <= sb); break;
+            case DW_OP_lt: v = (sa <  sb); break;
+            default: break;
+            }
+            PUSH(v);
+            break;
+        }
+        case DW_OP_skip:
+            pc = op->eo_operand1;
+            break;
+        case DW_OP_bra:
+            NEED(1);
+            if (stack[--sp]) {
+                pc = op->eo_operand1;
+            }
+            break;
+        case DW_OP_nop:
+            break;
+        case DW_OP_stack_value:
+            NEED(1);
+            result_out->er_kind = DW_EXPR_RESULT_VALUE;
+            result_out->er_value = stack[sp-1];
+            return DW_DLV_OK;
+        case DW_OP_implicit_value:
+            result_out->er_kind = DW_EXPR_RESULT_IMPLICIT;
+            result_out->er_implicit_length = op->eo_operand1;
+            result_out->er_implicit_data =
+                program->ep_implicit_data + op->eo_operand2;
+            return DW_DLV_OK;
+        default:
+            /* dwarf_expr_compile() let through nothing else. */
+            _dwarf_error(dbg, error, DW_DLE_EXPR_UNSUPPORTED_OP);
+            return DW_DLV_ERROR;
+        }
+    }
+#undef NEED
+#undef PUSH
+    if (!sp) {
+        _dwarf_error(dbg, error, DW_DLE_EXPR_STACK_ERROR);
+        return DW_DLV_ERROR;
+    }
+    result_out->er_value = stack[sp-1];
+    return DW_DLV_OK;
+}
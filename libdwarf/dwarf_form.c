@@ -1640,11 +1640,15 @@ _dwarf_extract_string_offset_via_str_offsets(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-int
-_dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
+/*  return_len may be null.  If not, it is set to the
+    string length, found by the scan that checks the
+    string. */
+static int
+local_str_given_offset(Dwarf_Debug dbg,
     unsigned attrform,
     Dwarf_Unsigned offset,
     char ** return_str,
+    Dwarf_Unsigned * return_len,
     Dwarf_Error * error)
 {
     if (attrform == DW_FORM_strp ||
@@ -1673,6 +1677,7 @@ _dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
             secsize = dbg->de_debug_line_str.dss_size;
             secbegin = dbg->de_debug_line_str.dss_data;
             strbegin= dbg->de_debug_line_str.dss_data + offset;
+            secend = dbg->de_debug_line_str.dss_data + secsize;
         } else {
             /* DW_FORM_strp  etc */
             res = _dwarf_load_section(dbg, &dbg->de_debug_str,error);
@@ -1690,8 +1695,13 @@ _dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
             _dwarf_error(dbg, error, errcode);
             return (DW_DLV_ERROR);
         }
-        res= _dwarf_check_string_valid(dbg,secbegin,strbegin, secend,
-            errcode,error);
+        if (return_len) {
+            res = _dwarf_check_string_valid_len(dbg,secbegin,
+                strbegin,secend,errcode,return_len,error);
+        } else {
+            res = _dwarf_check_string_valid(dbg,secbegin,
+                strbegin,secend,errcode,error);
+        }
         if (res != DW_DLV_OK) {
             return res;
         }
@@ -1706,14 +1716,24 @@ _dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
     return (DW_DLV_ERROR);
 }
 
-/* Contrary to pre-2005 documentation,
-   The string pointer returned thru return_str must
-   never have dwarf_dealloc() applied to it.
-   Documentation fixed July 2005.
-*/
 int
-dwarf_formstring(Dwarf_Attribute attr,
-    char **return_str, Dwarf_Error * error)
+_dwarf_extract_local_debug_str_string_given_offset(Dwarf_Debug dbg,
+    unsigned attrform,
+    Dwarf_Unsigned offset,
+    char ** return_str,
+    Dwarf_Error * error)
+{
+    return local_str_given_offset(dbg,attrform,offset,
+        return_str,0,error);
+}
+
+/*  dwarf_formstring() and, with return_len
+    non-null, dwarf_formstring_view(). */
+static int
+formstring_internal(Dwarf_Attribute attr,
+    char **return_str,
+    Dwarf_Unsigned *return_len,
+    Dwarf_Error * error)
 {
     Dwarf_CU_Context cu_context = 0;
     Dwarf_Debug dbg = 0;
@@ -1749,8 +1769,14 @@ dwarf_formstring(Dwarf_Attribute attr,
     case DW_FORM_string: {
         Dwarf_Small *begin = attr->ar_debug_ptr;
 
-        res= _dwarf_check_string_valid(dbg,secdataptr,begin, secend,
-            DW_DLE_FORM_STRING_BAD_STRING,error);
+        if (return_len) {
+            res = _dwarf_check_string_valid_len(dbg,secdataptr,
+                begin,secend,DW_DLE_FORM_STRING_BAD_STRING,
+                return_len,error);
+        } else {
+            res= _dwarf_check_string_valid(dbg,secdataptr,begin,
+                secend,DW_DLE_FORM_STRING_BAD_STRING,error);
+        }
         if (res != DW_DLV_OK) {
             return res;
         }
@@ -1773,6 +1799,8 @@ dwarf_formstring(Dwarf_Attribute attr,
         if (res != DW_DLV_OK) {
             return res;
         }
+        /*  Rare enough that the view just measures
+            the string. */
         res = _dwarf_get_string_from_tied(dbg, soffset,
             return_str, &alterr);
         if (res == DW_DLV_ERROR) {
@@ -1785,6 +1813,9 @@ dwarf_formstring(Dwarf_Attribute attr,
                     *return_str =
                         (char *)"<DW_FORM_strp_sup-no-tied-file>";
                 }
+                if (return_len) {
+                    *return_len = strlen(*return_str);
+                }
                 return DW_DLV_OK;
             }
             if (error) {
@@ -1801,6 +1832,9 @@ dwarf_formstring(Dwarf_Attribute attr,
                     (char *)"<DW_FORM_strp_sup-no-tied-file>";
             }
         }
+        if (res == DW_DLV_OK && return_len) {
+            *return_len = strlen(*return_str);
+        }
         return res;
     }
     case DW_FORM_GNU_str_index:
@@ -1837,14 +1871,51 @@ dwarf_formstring(Dwarf_Attribute attr,
     }
     /*  Now we have offset so read the string from
         debug_str or debug_line_str. */
-    res = _dwarf_extract_local_debug_str_string_given_offset(dbg,
+    res = local_str_given_offset(dbg,
         attr->ar_attribute_form,
         offset,
         return_str,
+        return_len,
         error);
     return res;
 }
 
+/* Contrary to pre-2005 documentation,
+   The string pointer returned thru return_str must
+   never have dwarf_dealloc() applied to it.
+   Documentation fixed July 2005.
+*/
+int
+dwarf_formstring(Dwarf_Attribute attr,
+    char **return_str, Dwarf_Error * error)
+{
+    return formstring_internal(attr,return_str,0,error);
+}
+
+/*  As dwarf_formstring() but also returns the string
+    length (not counting the NUL).  The length is not
+    stored anywhere: it comes from the one bounded scan
+    for the terminating NUL, which here is also the
+    validity check, so the string is read once rather
+    than checked and then measured with strlen().
+    New October 2026. */
+int
+dwarf_formstring_view(Dwarf_Attribute attr,
+    const char **return_str,
+    Dwarf_Unsigned *return_len,
+    Dwarf_Error * error)
+{
+    char *str = 0;
+    int res = 0;
+
+    res = formstring_internal(attr,&str,return_len,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *return_str = str;
+    return DW_DLV_OK;
+}
+
 
 int
 _dwarf_get_string_from_tied(Dwarf_Debug dbg,
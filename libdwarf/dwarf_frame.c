@@ -129,6 +129,74 @@ dwarf_get_frame_section_name_eh_gnu(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  The working rule table of _dwarf_exec_frame_instr()
+    is kept on the Dwarf_Debug, as are the rows pushed by
+    DW_CFA_remember_state, so computing a row does no
+    allocation once these have grown.  That matters to
+    callers like dwarf_unwind_stack() that compute rows
+    at a high rate.  _dwarf_exec_frame_instr() does not
+    recurse, so one scratch table suffices. */
+static struct Dwarf_Reg_Rule_s *
+frame_scratch_regs(Dwarf_Debug dbg, unsigned reg_count)
+{
+    if (dbg->de_frame_scratch_regs &&
+        dbg->de_frame_scratch_count == reg_count) {
+        return dbg->de_frame_scratch_regs;
+    }
+    free(dbg->de_frame_scratch_regs);
+    dbg->de_frame_scratch_count = 0;
+    dbg->de_frame_scratch_regs = calloc(reg_count? reg_count:1,
+        sizeof(struct Dwarf_Reg_Rule_s));
+    if (dbg->de_frame_scratch_regs) {
+        dbg->de_frame_scratch_count = reg_count;
+    }
+    return dbg->de_frame_scratch_regs;
+}
+
+static Dwarf_Frame
+frame_state_get(Dwarf_Debug dbg, unsigned reg_count)
+{
+    Dwarf_Frame f = dbg->de_frame_state_pool;
+
+    if (f && f->fr_reg_count == reg_count) {
+        dbg->de_frame_state_pool = f->fr_next;
+        f->fr_next = 0;
+        return f;
+    }
+    return (Dwarf_Frame)_dwarf_get_alloc(dbg, DW_DLA_FRAME, 1);
+}
+
+/*  Puts a chain of remembered rows back in the pool. */
+static void
+frame_state_release(Dwarf_Debug dbg, Dwarf_Frame chain)
+{
+    while (chain) {
+        Dwarf_Frame next = chain->fr_next;
+
+        chain->fr_next = dbg->de_frame_state_pool;
+        dbg->de_frame_state_pool = chain;
+        chain = next;
+    }
+}
+
+void
+_dwarf_frame_scratch_destroy(Dwarf_Debug dbg)
+{
+    Dwarf_Frame f = dbg->de_frame_state_pool;
+
+    while (f) {
+        Dwarf_Frame next = f->fr_next;
+
+        f->fr_next = 0;
+        dwarf_dealloc(dbg, f, DW_DLA_FRAME);
+        f = next;
+    }
+    dbg->de_frame_state_pool = 0;
+    free(dbg->de_frame_scratch_regs);
+    dbg->de_frame_scratch_regs = 0;
+    dbg->de_frame_scratch_count = 0;
+}
+
 /*
     This function is the heart of the debug_frame stuff.  Don't even
     think of reading this without reading both the Libdwarf and
@@ -232,7 +300,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
         }                                                    \
     } /*CONSTCOND */ while (0)
 #define SIMPLE_ERROR_RETURN(code) \
-        free(localregtab);        \
+        frame_state_release(dbg,top_stack); \
         _dwarf_error(dbg,error,code); \
         return DW_DLV_ERROR
 
@@ -253,8 +321,8 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
     Dwarf_Unsigned adv_loc = 0;
 
     unsigned reg_count = dbg->de_frame_reg_rules_entry_count;
-    struct Dwarf_Reg_Rule_s *localregtab = calloc(reg_count,
-        sizeof(struct Dwarf_Reg_Rule_s));
+    struct Dwarf_Reg_Rule_s *localregtab =
+        frame_scratch_regs(dbg,reg_count);
 
     struct Dwarf_Reg_Rule_s cfa_reg;
 
@@ -692,8 +760,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
 
         case DW_CFA_remember_state:
             {
-                stack_table = (Dwarf_Frame)
-                    _dwarf_get_alloc(dbg, DW_DLA_FRAME, 1);
+                stack_table = frame_state_get(dbg,reg_count);
                 if (stack_table == NULL) {
                     SIMPLE_ERROR_RETURN(DW_DLE_DF_ALLOC_FAIL);
                 }
@@ -702,8 +769,7 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
                     stack_table->fr_reg[i] = localregtab[i];
                 stack_table->fr_cfa_rule = cfa_reg;
 
-                if (top_stack != NULL)
-                    stack_table->fr_next = top_stack;
+                stack_table->fr_next = top_stack;
                 top_stack = stack_table;
 
                 break;
@@ -721,7 +787,8 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
                     localregtab[i] = stack_table->fr_reg[i];
                 cfa_reg = stack_table->fr_cfa_rule;
 
-                dwarf_dealloc(dbg, stack_table, DW_DLA_FRAME);
+                stack_table->fr_next = 0;
+                frame_state_release(dbg,stack_table);
                 break;
             }
 
@@ -1134,12 +1201,9 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
         table->fr_cfa_rule = cfa_reg;
     }
 
-    /* Dealloc anything remaining on stack. */
-    for (; top_stack != NULL;) {
-        stack_table = top_stack;
-        top_stack = top_stack->fr_next;
-        dwarf_dealloc(dbg, stack_table, DW_DLA_FRAME);
-    }
+    /* Return anything remaining on stack to the pool. */
+    frame_state_release(dbg,top_stack);
+    top_stack = 0;
 
     if (make_instr) {
         /*  Allocate array of Dwarf_Frame_Op structs.  */
@@ -1170,7 +1234,6 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
     } else {
         *returned_count = 0;
     }
-    free(localregtab);
     return DW_DLV_OK;
 #undef ERROR_IF_REG_NUM_TOO_HIGH
 #undef SIMPLE_ERROR_RETURN
@@ -1605,7 +1668,7 @@ dwarf_get_cie_info_b(Dwarf_Cie cie,
 
 /* Return the register rules for all registers at a given pc.
 */
-static int
+int
 _dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
     Dwarf_Addr pc_requested,
     Dwarf_Frame table,
@@ -413,6 +413,19 @@ _dwarf_exec_frame_instr(Dwarf_Bool make_instr,
     Dwarf_Addr  * subsequent_pc,
     Dwarf_Error * error);
 
+/*  Computes the row of fde holding pc_requested into
+    table.  The pc must be within the fde. */
+int
+_dwarf_get_fde_info_for_a_pc_row(Dwarf_Fde fde,
+    Dwarf_Addr pc_requested,
+    Dwarf_Frame table,
+    Dwarf_Half cfa_reg_col_num,
+    Dwarf_Bool * has_more_rows,
+    Dwarf_Addr * subsequent_pc,
+    Dwarf_Error * error);
+
+void _dwarf_frame_scratch_destroy(Dwarf_Debug dbg);
+
 
 int dwarf_read_cie_fde_prefix(Dwarf_Debug dbg,
     Dwarf_Small *frame_ptr_in,
@@ -912,6 +912,7 @@ dwarf_create_cie_from_after_start(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return (DW_DLV_ERROR);
     }
+    dbg->de_perf_counters.pc_cie_parses++;
 
     new_cie->ci_cie_version_number = version;
     new_cie->ci_initial_table = NULL;
@@ -1163,6 +1164,7 @@ dwarf_create_fde_from_after_start(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return (DW_DLV_ERROR);
     }
+    dbg->de_perf_counters.pc_fde_parses++;
 
     new_fde->fd_length = prefix->cf_length;
     new_fde->fd_length_size = prefix->cf_local_length_size;
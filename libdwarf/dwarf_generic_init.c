@@ -128,6 +128,86 @@ set_global_paths_init(Dwarf_Debug dbg, Dwarf_Error* error)
     return res;
 }
 
+static int init_path_internal(const char *path,
+    char *true_path_out_buffer,
+    unsigned true_path_bufferlen,
+    Dwarf_Unsigned access,
+    unsigned groupnumber,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    Dwarf_Debug *ret_dbg,
+    int follow_debuglink,
+    Dwarf_Error *error);
+
+/*  Frees an error made with no Dwarf_Debug (as by a failed
+    init), which dwarf_dealloc() cannot. */
+static void
+drop_init_error(Dwarf_Error err)
+{
+    if (err && err->er_static_alloc == DE_MALLOC) {
+        free(err);
+    }
+}
+
+/*  An ELF object with no .debug_info but a build-id or
+    .gnu_debuglink is replaced by the separate debug file
+    dwarf_gnu_debuglink_resolve() finds.  New October 2026.
+    Failing to find or open that file is not an error:
+    *dbg_io, the object itself, is left as it was.  */
+static void
+follow_to_debug_file(Dwarf_Debug *dbg_io,
+    char *true_path_out_buffer,
+    unsigned true_path_bufferlen,
+    Dwarf_Unsigned access,
+    unsigned groupnumber,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg)
+{
+    Dwarf_Debug dbg = *dbg_io;
+    Dwarf_Debug linkdbg = 0;
+    Dwarf_Error lerror = 0;
+    char *linkpath = 0;
+    int res = 0;
+
+    if (dbg->de_debug_info.dss_size ||
+        (!dbg->de_gnu_debuglink.dss_size &&
+        !dbg->de_note_gnu_buildid.dss_size)) {
+        return;
+    }
+    res = dwarf_gnu_debuglink_resolve(dbg,&linkpath,&lerror);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc(dbg,lerror,DW_DLA_ERROR);
+        return;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return;
+    }
+    if (dbg->de_path && !strcmp(linkpath,dbg->de_path)) {
+        free(linkpath);
+        return;
+    }
+    /*  No handler: a debug file that will not open
+        is not the caller's error. */
+    res = init_path_internal(linkpath,0,0,access,groupnumber,
+        0,0,&linkdbg,FALSE,&lerror);
+    if (res != DW_DLV_OK) {
+        if (res == DW_DLV_ERROR) {
+            drop_init_error(lerror);
+        }
+        free(linkpath);
+        return;
+    }
+    linkdbg->de_errhand = errhand;
+    linkdbg->de_errarg = errarg;
+    if (true_path_out_buffer &&
+        strlen(linkpath) < true_path_bufferlen) {
+        strcpy(true_path_out_buffer,linkpath);
+    }
+    free(linkpath);
+    dwarf_finish(dbg,&lerror);
+    *dbg_io = linkdbg;
+}
+
 /* New in December 2018. */
 int dwarf_init_path(const char *path,
     char *true_path_out_buffer,
@@ -141,6 +221,24 @@ int dwarf_init_path(const char *path,
     UNUSEDARG Dwarf_Unsigned     reserved2,
     UNUSEDARG Dwarf_Unsigned  *  reserved3,
     Dwarf_Error*      error)
+{
+    return init_path_internal(path,
+        true_path_out_buffer,true_path_bufferlen,
+        access,groupnumber,errhand,errarg,ret_dbg,
+        TRUE,error);
+}
+
+static int
+init_path_internal(const char *path,
+    char *true_path_out_buffer,
+    unsigned true_path_bufferlen,
+    Dwarf_Unsigned access,
+    unsigned groupnumber,
+    Dwarf_Handler errhand,
+    Dwarf_Ptr errarg,
+    Dwarf_Debug *ret_dbg,
+    int follow_debuglink,
+    Dwarf_Error *error)
 {
     unsigned       ftype = 0;
     unsigned       endian = 0;
@@ -192,6 +290,11 @@ int dwarf_init_path(const char *path,
         dbg->de_fd = fd;
         dbg->de_owns_fd = TRUE;
         res = set_global_paths_init(dbg,error);
+        if (res == DW_DLV_OK && follow_debuglink) {
+            follow_to_debug_file(&dbg,
+                true_path_out_buffer,true_path_bufferlen,
+                access,groupnumber,errhand,errarg);
+        }
         *ret_dbg = dbg;
         return res;
     }
@@ -806,18 +806,10 @@ int
 dwarf_get_cu_die_offset_given_cu_header_offset(Dwarf_Debug dbg,
     Dwarf_Off in_cu_header_offset,
     Dwarf_Off * out_cu_die_offset,
-    UNUSEDARG Dwarf_Error * err)
+    Dwarf_Error * err)
 {
-    Dwarf_Off headerlen = 0;
-    int cres = 0;
-
-    cres = _dwarf_length_of_cu_header(dbg, in_cu_header_offset,true,
-        &headerlen,err);
-    if (cres != DW_DLV_OK) {
-        return cres;
-    }
-    *out_cu_die_offset = in_cu_header_offset + headerlen;
-    return DW_DLV_OK;
+    return dwarf_get_cu_die_offset_given_cu_header_offset_b(dbg,
+        in_cu_header_offset,true,out_cu_die_offset,err);
 }
 
 /*  The following version new in October 2011, does allow finding
@@ -831,11 +823,28 @@ dwarf_get_cu_die_offset_given_cu_header_offset_b(Dwarf_Debug dbg,
     Dwarf_Off in_cu_header_offset,
     Dwarf_Bool is_info,
     Dwarf_Off * out_cu_die_offset,
-    UNUSEDARG Dwarf_Error * err)
+    Dwarf_Error * err)
 {
     Dwarf_Off headerlen = 0;
+    Dwarf_Unsigned secsize = 0;
     int cres = 0;
 
+    /*  The caller may not have touched the section yet,
+        for example when the offset came from .gdb_index. */
+    if (is_info) {
+        cres = _dwarf_load_debug_info(dbg, err);
+        secsize = dbg->de_debug_info.dss_size;
+    } else {
+        cres = _dwarf_load_debug_types(dbg, err);
+        secsize = dbg->de_debug_types.dss_size;
+    }
+    if (cres != DW_DLV_OK) {
+        return cres;
+    }
+    if (in_cu_header_offset >= secsize) {
+        _dwarf_error(dbg, err, DW_DLE_OFFSET_BAD);
+        return DW_DLV_ERROR;
+    }
     cres = _dwarf_length_of_cu_header(dbg, in_cu_header_offset,is_info,
         &headerlen,err);
     if (cres != DW_DLV_OK) {
@@ -138,6 +138,7 @@ _dwarf_insert_in_group_map(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_GROUP_MAP_ALLOC);
         return DW_DLV_ERROR;
     }
+    dbg->de_perf_counters.pc_tsearch_ops++;
     entry2 = dwarf_tsearch(entry3,&grp->gd_map,grp_compare_function);
     if (!entry2) {
         free(entry3);
@@ -175,6 +176,7 @@ _dwarf_section_get_target_group_from_map(Dwarf_Debug dbg,
     entry.gm_group_number = 0; /* FAKE */
     entry.gm_section_name = ""; /* FAKE */
 
+    dbg->de_perf_counters.pc_tsearch_ops++;
     entry2 = dwarf_tfind(&entry, &grp->gd_map,grp_compare_function);
     if (entry2) {
         struct Dwarf_Group_Map_Entry_s *e2 =
@@ -1847,8 +1847,8 @@ do_decompress_zlib(Dwarf_Debug dbg,
 
 /*  Load the ELF section with the specified index and set its
     dss_data pointer to the memory where it was loaded.  */
-int
-_dwarf_load_section(Dwarf_Debug dbg,
+static int
+load_section_data(Dwarf_Debug dbg,
     struct Dwarf_Section_s *section,
     Dwarf_Error * error)
 {
@@ -1856,10 +1856,6 @@ _dwarf_load_section(Dwarf_Debug dbg,
     int err = 0;
     struct Dwarf_Obj_Access_Interface_s *o = 0;
 
-    /* check to see if the section is already loaded */
-    if (section->dss_data !=  NULL) {
-        return DW_DLV_OK;
-    }
     o = dbg->de_obj_file;
     /*  There is an elf convention that section index 0
         is reserved, and that section is always empty.
@@ -1938,6 +1934,399 @@ _dwarf_load_section(Dwarf_Debug dbg,
     return res;
 }
 
+/*  A section can only be given back if nothing
+    outside the current call points into it and
+    something would actually be freed.
+    Relocated sections are never evicted as the
+    relocation work would have to be redone. */
+static Dwarf_Bool
+section_is_evictable(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *section)
+{
+    if (!section->dss_evictable || !section->dss_data) {
+        return FALSE;
+    }
+    if (section->dss_pin_count || section->dss_pinned_for_life ||
+        section->dss_reloc_size ||
+        section->dss_ignore_reloc_group_sec) {
+        return FALSE;
+    }
+    if (!section->dss_data_was_malloc &&
+        !dbg->de_section_budget.sb_unload_section) {
+        return FALSE;
+    }
+    return TRUE;
+}
+
+/*  Frees what we can of the section data and
+    leaves the section as if never loaded, so
+    _dwarf_load_section() will bring it back. */
+static void
+evict_section(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *section)
+{
+    struct Dwarf_Section_Budget_s *sb = &dbg->de_section_budget;
+    Dwarf_Unsigned freed = 0;
+
+    if (section->dss_data_was_malloc) {
+        free(section->dss_data);
+        section->dss_data_was_malloc = FALSE;
+        freed = section->dss_size;
+    }
+    if (section->dss_did_decompress) {
+        /*  The object still describes the compressed
+            bytes, restore the size that goes with them. */
+        section->dss_size = section->dss_compressed_length;
+        section->dss_did_decompress = FALSE;
+    }
+    if (sb->sb_unload_section) {
+        sb->sb_unload_section(dbg->de_obj_file->object,
+            (Dwarf_Half)section->dss_index);
+        freed = section->dss_resident_bytes;
+    }
+    section->dss_data = 0;
+    section->dss_string_limit = 0;
+    section->dss_was_evicted = TRUE;
+    if (freed > section->dss_resident_bytes) {
+        freed = section->dss_resident_bytes;
+    }
+    section->dss_resident_bytes -= freed;
+    sb->sb_bytes_resident -= freed;
+    sb->sb_bytes_evicted += freed;
+    sb->sb_evictions++;
+}
+
+/*  Evict least-recently-used evictable sections
+    until the evictable sections are within budget
+    (or nothing is left to evict).  Sections that
+    are never evicted do not count, else a small
+    budget would evict on every load.
+    'keep' is the section the caller is
+    about to use, it is never chosen. */
+static void
+enforce_section_budget(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *keep)
+{
+    struct Dwarf_Section_Budget_s *sb = &dbg->de_section_budget;
+
+    while (sb->sb_budget) {
+        struct Dwarf_Section_s *victim = 0;
+        Dwarf_Unsigned evictable_bytes = 0;
+        unsigned i = 0;
+
+        for (i = 0; i < dbg->de_debug_sections_total_entries; ++i) {
+            struct Dwarf_Section_s *s =
+                dbg->de_debug_sections[i].ds_secdata;
+
+            if (!s || !s->dss_evictable) {
+                continue;
+            }
+            evictable_bytes += s->dss_resident_bytes;
+            if (s == keep || !section_is_evictable(dbg,s)) {
+                continue;
+            }
+            if (!victim || s->dss_last_use < victim->dss_last_use) {
+                victim = s;
+            }
+        }
+        if (evictable_bytes <= sb->sb_budget || !victim) {
+            break;
+        }
+        evict_section(dbg,victim);
+    }
+}
+
+/*  Load the section (if not already loaded)
+    and account for the memory it uses.
+    Every use of a section is expected to
+    come through here so the least-recently-used
+    ordering of dss_last_use is meaningful.  */
+/*  Find the last NUL in a string section so every
+    later string check in it is a pointer compare.
+    Normally the final byte is the NUL of the last
+    string and the loop body runs once. */
+static void
+set_string_limit(struct Dwarf_Section_s *section)
+{
+    Dwarf_Small *start = section->dss_data;
+    Dwarf_Small *p = start + section->dss_size;
+
+    section->dss_string_limit = 0;
+    while (p > start) {
+        --p;
+        if (!*p) {
+            section->dss_string_limit = p+1;
+            return;
+        }
+    }
+}
+
+int
+_dwarf_load_section(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *section,
+    Dwarf_Error * error)
+{
+    int res = DW_DLV_ERROR;
+    struct Dwarf_Section_Budget_s *sb = &dbg->de_section_budget;
+    Dwarf_Unsigned bytes = 0;
+
+    sb->sb_tick++;
+    section->dss_last_use = sb->sb_tick;
+    /* check to see if the section is already loaded */
+    if (section->dss_data !=  NULL) {
+        return DW_DLV_OK;
+    }
+    res = load_section_data(dbg,section,error);
+    if (res != DW_DLV_OK || !section->dss_data) {
+        return res;
+    }
+    bytes = section->dss_size;
+    section->dss_load_count++;
+    dbg->de_perf_counters.pc_sections_loaded++;
+    if (section->dss_did_decompress) {
+        bytes += section->dss_compressed_length;
+        section->dss_bytes_loaded += section->dss_compressed_length;
+        section->dss_bytes_decompressed += section->dss_size;
+        dbg->de_perf_counters.pc_section_bytes_loaded +=
+            section->dss_compressed_length;
+        dbg->de_perf_counters.pc_section_bytes_decompressed +=
+            section->dss_size;
+    } else {
+        section->dss_bytes_loaded += section->dss_size;
+        dbg->de_perf_counters.pc_section_bytes_loaded +=
+            section->dss_size;
+    }
+    /*  Whatever survived an earlier eviction is
+        part of 'bytes' now, do not count it twice. */
+    sb->sb_bytes_resident -= section->dss_resident_bytes;
+    section->dss_resident_bytes = bytes;
+    sb->sb_bytes_resident += bytes;
+    if (sb->sb_bytes_resident > sb->sb_bytes_resident_peak) {
+        sb->sb_bytes_resident_peak = sb->sb_bytes_resident;
+    }
+    if (section->dss_was_evicted) {
+        section->dss_was_evicted = FALSE;
+        sb->sb_reloads++;
+    }
+    if (section == &dbg->de_debug_str ||
+        section == &dbg->de_debug_line_str) {
+        set_string_limit(section);
+    }
+    if (section->dss_evictable) {
+        enforce_section_budget(dbg,section);
+    }
+    return res;
+}
+
+void
+_dwarf_pin_section(struct Dwarf_Section_s *section)
+{
+    section->dss_pin_count++;
+}
+
+void
+_dwarf_unpin_section(struct Dwarf_Section_s *section)
+{
+    if (section->dss_pin_count) {
+        section->dss_pin_count--;
+    }
+}
+
+/*  For interfaces returning pointers into the section
+    that nothing ever gives back (dwarf_get_loclist_entry()):
+    the section stays loaded till dwarf_finish(). */
+void
+_dwarf_pin_section_for_life(struct Dwarf_Section_s *section)
+{
+    section->dss_pinned_for_life = TRUE;
+}
+
+/*  Limit the section data held for this dbg.
+    Only .debug_loc, .debug_macro, .debug_str_offsets,
+    .debug_aranges and .debug_ranges are ever given
+    back, and only their bytes count against the
+    budget.  For a compressed section that is the
+    decompressed copy plus the compressed bytes;
+    the copy is freed and decompressed again on reload.
+    Every interface returning a pointer into one of
+    them pins it: till the returned object is
+    dealloc'd (Dwarf_Loc_Head_c, Dwarf_Locdesc,
+    Dwarf_Macro_Context, Dwarf_Str_Offsets_Table) or,
+    where there is no dealloc, for the life of
+    the dbg.  Objects made after a reload pin the
+    reloaded data.  State kept across calls without a
+    pin (a Dwarf_Range_Iter, the cached macro units)
+    holds section offsets, not pointers.
+    Other sections, compressed or not, stay loaded
+    till dwarf_finish(): DIEs, strings and line
+    tables point into them with no pin.
+    A budget of zero turns eviction off.
+    New October 2026. */
+int
+dwarf_set_section_memory_budget(Dwarf_Debug dbg,
+    Dwarf_Unsigned budget_bytes,
+    Dwarf_Error *error)
+{
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_debug_loc.dss_evictable = TRUE;
+    dbg->de_debug_macro.dss_evictable = TRUE;
+    dbg->de_debug_str_offsets.dss_evictable = TRUE;
+    dbg->de_debug_aranges.dss_evictable = TRUE;
+    dbg->de_debug_ranges.dss_evictable = TRUE;
+    dbg->de_section_budget.sb_budget = budget_bytes;
+    enforce_section_budget(dbg,0);
+    return DW_DLV_OK;
+}
+
+/*  Any of the pointers may be NULL if the caller
+    does not want that value.  New October 2026. */
+int
+dwarf_get_section_memory_stats(Dwarf_Debug dbg,
+    Dwarf_Unsigned *bytes_resident,
+    Dwarf_Unsigned *bytes_resident_peak,
+    Dwarf_Unsigned *evictions,
+    Dwarf_Unsigned *bytes_evicted,
+    Dwarf_Unsigned *reloads,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Section_Budget_s *sb = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    sb = &dbg->de_section_budget;
+    if (bytes_resident) {
+        *bytes_resident = sb->sb_bytes_resident;
+    }
+    if (bytes_resident_peak) {
+        *bytes_resident_peak = sb->sb_bytes_resident_peak;
+    }
+    if (evictions) {
+        *evictions = sb->sb_evictions;
+    }
+    if (bytes_evicted) {
+        *bytes_evicted = sb->sb_bytes_evicted;
+    }
+    if (reloads) {
+        *reloads = sb->sb_reloads;
+    }
+    return DW_DLV_OK;
+}
+
+/*  New October 2026. */
+int
+dwarf_get_perf_counters(Dwarf_Debug dbg,
+    Dwarf_Perf_Counters *counters_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned size = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    size = counters_out->pc_size;
+    /*  Whole counters only. */
+    size -= size % sizeof(Dwarf_Unsigned);
+    if (!size) {
+        _dwarf_error(dbg, error, DW_DLE_PERF_COUNTERS_SIZE);
+        return DW_DLV_ERROR;
+    }
+    if (size > sizeof(Dwarf_Perf_Counters)) {
+        size = sizeof(Dwarf_Perf_Counters);
+    }
+    /*  pc_size comes first, the counters follow. */
+    memcpy((char *)counters_out + sizeof(Dwarf_Unsigned),
+        (char *)&dbg->de_perf_counters + sizeof(Dwarf_Unsigned),
+        size - sizeof(Dwarf_Unsigned));
+    counters_out->pc_size = size;
+    return DW_DLV_OK;
+}
+
+/*  New October 2026. */
+int
+dwarf_get_perf_alloc_count(Dwarf_Debug dbg,
+    Dwarf_Unsigned dla_type,
+    Dwarf_Unsigned *alloc_count,
+    Dwarf_Error *error)
+{
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (dla_type >= ALLOC_AREA_INDEX_TABLE_MAX) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *alloc_count = dbg->de_perf_allocs_by_type[dla_type];
+    return DW_DLV_OK;
+}
+
+/*  section_index is an index into de_debug_sections,
+    not an object section number.
+    Any of the output pointers may be NULL.
+    New October 2026. */
+int
+dwarf_get_section_perf_counters(Dwarf_Debug dbg,
+    Dwarf_Unsigned section_index,
+    const char **section_name,
+    Dwarf_Unsigned *load_count,
+    Dwarf_Unsigned *bytes_loaded,
+    Dwarf_Unsigned *bytes_decompressed,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Section_s *s = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (section_index >= dbg->de_debug_sections_total_entries) {
+        return DW_DLV_NO_ENTRY;
+    }
+    s = dbg->de_debug_sections[section_index].ds_secdata;
+    if (section_name) {
+        *section_name = dbg->de_debug_sections[section_index].ds_name;
+    }
+    if (load_count) {
+        *load_count = s->dss_load_count;
+    }
+    if (bytes_loaded) {
+        *bytes_loaded = s->dss_bytes_loaded;
+    }
+    if (bytes_decompressed) {
+        *bytes_decompressed = s->dss_bytes_decompressed;
+    }
+    return DW_DLV_OK;
+}
+
+/*  New October 2026. */
+int
+dwarf_reset_perf_counters(Dwarf_Debug dbg,
+    Dwarf_Error *error)
+{
+    unsigned i = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    memset(&dbg->de_perf_counters,0,sizeof(dbg->de_perf_counters));
+    memset(dbg->de_perf_allocs_by_type,0,
+        sizeof(dbg->de_perf_allocs_by_type));
+    for (i = 0; i < dbg->de_debug_sections_total_entries; ++i) {
+        struct Dwarf_Section_s *s = dbg->de_debug_sections[i].ds_secdata;
+
+        s->dss_load_count = 0;
+        s->dss_bytes_loaded = 0;
+        s->dss_bytes_decompressed = 0;
+    }
+    return DW_DLV_OK;
+}
+
 /* This is a hack so clients can verify offsets.
    Added April 2005 so that debugger can detect broken offsets
    (which happened in an IRIX  -64 executable larger than 2GB
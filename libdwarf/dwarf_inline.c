@@ -0,0 +1,892 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  dwarf_inline_frames(): pc to inlined call chain.
+    See dwarf_inline.h for the layout of the index.
+    Nothing here holds a Dwarf_Die between calls, names
+    are copied, so the index survives section eviction
+    (dwarf_set_section_memory_budget()). */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_inline.h"
+
+#define TRUE  1
+#define FALSE 0
+
+/*  DW_AT_abstract_origin and DW_AT_specification chains
+    are short. A longer one is a loop. */
+#define ORIGIN_HOP_LIMIT 16
+
+static int
+inline_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory building the "
+        "inline frame index");
+    return DW_DLV_ERROR;
+}
+
+static int
+range_append(Dwarf_Debug dbg,
+    struct Dwarf_Inline_Range_Array_s *ra,
+    Dwarf_Addr low, Dwarf_Addr high,
+    Dwarf_Unsigned node, Dwarf_Signed parent,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Inline_Range_s *r = 0;
+
+    if (high <= low) {
+        /* Empty range, nothing to find there. */
+        return DW_DLV_OK;
+    }
+    if (ra->ra_count >= ra->ra_alloc) {
+        Dwarf_Unsigned newalloc = ra->ra_alloc?
+            ra->ra_alloc*2:16;
+        struct Dwarf_Inline_Range_s *newr =
+            (struct Dwarf_Inline_Range_s *)realloc(ra->ra_ranges,
+            newalloc*sizeof(struct Dwarf_Inline_Range_s));
+
+        if (!newr) {
+            return inline_alloc_error(dbg,error);
+        }
+        ra->ra_ranges = newr;
+        ra->ra_alloc = newalloc;
+    }
+    r = ra->ra_ranges + ra->ra_count;
+    r->ir_low = low;
+    r->ir_high = high;
+    r->ir_node = node;
+    r->ir_parent = parent;
+    ra->ra_count++;
+    return DW_DLV_OK;
+}
+
+int
+_dwarf_inline_die_ranges(Dwarf_Debug dbg,
+    Dwarf_Die die,
+    Dwarf_Unsigned node,
+    Dwarf_Signed parent,
+    struct Dwarf_Inline_Range_Array_s *ra,
+    Dwarf_Bool *has_pc_info,
+    Dwarf_Error *error)
+{
+    Dwarf_Range_Iter it;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    int res = 0;
+
+    *has_pc_info = FALSE;
+    res = dwarf_range_iter_begin(die,&it,error);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+    }
+    *has_pc_info = TRUE;
+    while ((res = dwarf_range_iter_next(&it,&low,&high,error)) ==
+        DW_DLV_OK) {
+        res = range_append(dbg,ra,low,high,node,parent,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+}
+
+/*  Copies s into the string space of cu, returning
+    its offset plus one through *offset_out. */
+static int
+cu_save_string(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    const char *s,
+    Dwarf_Unsigned *offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned len = strlen(s) + 1;
+
+    if (cu->ic_strings_size + len > cu->ic_strings_alloc) {
+        Dwarf_Unsigned newalloc = cu->ic_strings_alloc?
+            cu->ic_strings_alloc*2:1024;
+        char *news = 0;
+
+        while (newalloc < cu->ic_strings_size + len) {
+            newalloc *= 2;
+        }
+        news = (char *)realloc(cu->ic_strings,newalloc);
+        if (!news) {
+            return inline_alloc_error(dbg,error);
+        }
+        cu->ic_strings = news;
+        cu->ic_strings_alloc = newalloc;
+    }
+    memcpy(cu->ic_strings + cu->ic_strings_size,s,len);
+    *offset_out = cu->ic_strings_size + 1;
+    cu->ic_strings_size += len;
+    return DW_DLV_OK;
+}
+
+/*  Finds attrnum (or altattrnum if non-zero) as a string
+    on die or, failing that, on the DIEs reached through
+    DW_AT_abstract_origin and DW_AT_specification, and
+    saves it in the string space of cu. *offset_out
+    is left zero if there is no such string. */
+static int
+save_name_through_origin(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Die die,
+    Dwarf_Half attrnum,
+    Dwarf_Half altattrnum,
+    Dwarf_Unsigned *offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Die cur = die;
+    unsigned hops = 0;
+    int res = DW_DLV_OK;
+
+    *offset_out = 0;
+    for (hops = 0; hops < ORIGIN_HOP_LIMIT; ++hops) {
+        Dwarf_Attribute attr = 0;
+        Dwarf_Off refoff = 0;
+        Dwarf_Die next = 0;
+        char *s = 0;
+
+        res = dwarf_attr(cur,attrnum,&attr,error);
+        if (res == DW_DLV_NO_ENTRY && altattrnum) {
+            res = dwarf_attr(cur,altattrnum,&attr,error);
+        }
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_formstring(attr,&s,error);
+            dwarf_dealloc_attribute(attr);
+            if (res == DW_DLV_OK) {
+                res = cu_save_string(dbg,cu,s,offset_out,error);
+            }
+            break;
+        }
+        res = dwarf_attr(cur,DW_AT_abstract_origin,&attr,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            res = dwarf_attr(cur,DW_AT_specification,&attr,error);
+        }
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_global_formref(attr,&refoff,error);
+        dwarf_dealloc_attribute(attr);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_offdie_b(dbg,refoff,TRUE,&next,error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        cur = next;
+    }
+    if (cur != die) {
+        dwarf_dealloc_die(cur);
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        /* No name is not an error. */
+        res = DW_DLV_OK;
+    }
+    return res;
+}
+
+static int
+die_udata_attr(Dwarf_Die die, Dwarf_Half attrnum,
+    Dwarf_Bool *present, Dwarf_Unsigned *value,
+    Dwarf_Error *error)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Half form = 0;
+    int res = 0;
+
+    *present = FALSE;
+    *value = 0;
+    res = dwarf_attr(die,attrnum,&attr,error);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+    }
+    res = dwarf_whatform(attr,&form,error);
+    if (res == DW_DLV_OK) {
+        if (form == DW_FORM_implicit_const) {
+            /*  GCC often uses this for DW_AT_call_file.
+                Only dwarf_formsdata() reads it. */
+            Dwarf_Signed sval = 0;
+
+            res = dwarf_formsdata(attr,&sval,error);
+            *value = (Dwarf_Unsigned)sval;
+        } else {
+            res = dwarf_formudata(attr,value,error);
+        }
+    }
+    dwarf_dealloc_attribute(attr);
+    if (res == DW_DLV_OK) {
+        *present = TRUE;
+    }
+    return res;
+}
+
+static int
+add_node(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Die die,
+    Dwarf_Half tag,
+    Dwarf_Unsigned *node_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Inline_Node_s *n = 0;
+    Dwarf_Bool present = FALSE;
+    int res = 0;
+
+    if (cu->ic_node_count >= cu->ic_node_alloc) {
+        Dwarf_Unsigned newalloc = cu->ic_node_alloc?
+            cu->ic_node_alloc*2:32;
+        struct Dwarf_Inline_Node_s *newn =
+            (struct Dwarf_Inline_Node_s *)realloc(cu->ic_nodes,
+            newalloc*sizeof(struct Dwarf_Inline_Node_s));
+
+        if (!newn) {
+            return inline_alloc_error(dbg,error);
+        }
+        cu->ic_nodes = newn;
+        cu->ic_node_alloc = newalloc;
+    }
+    n = cu->ic_nodes + cu->ic_node_count;
+    memset(n,0,sizeof(*n));
+    n->in_tag = tag;
+    res = dwarf_dieoffset(die,&n->in_die_offset,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = save_name_through_origin(dbg,cu,die,DW_AT_name,0,
+        &n->in_name,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = save_name_through_origin(dbg,cu,die,DW_AT_linkage_name,
+        DW_AT_MIPS_linkage_name,&n->in_linkage_name,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (tag == DW_TAG_inlined_subroutine) {
+        res = die_udata_attr(die,DW_AT_call_file,
+            &n->in_call_file_present,&n->in_call_file,error);
+        if (res == DW_DLV_OK) {
+            res = die_udata_attr(die,DW_AT_call_line,
+                &present,&n->in_call_line,error);
+        }
+        if (res == DW_DLV_OK) {
+            res = die_udata_attr(die,DW_AT_call_column,
+                &present,&n->in_call_column,error);
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    *node_out = cu->ic_node_count;
+    cu->ic_node_count++;
+    return DW_DLV_OK;
+}
+
+/*  TRUE for DIEs whose children may hold subprograms
+    or inlined subroutines with code. Other subtrees
+    (parameters, variables, most types) are skipped. */
+static Dwarf_Bool
+tag_may_enclose_code(Dwarf_Half tag)
+{
+    switch (tag) {
+    case DW_TAG_lexical_block:
+    case DW_TAG_namespace:
+    case DW_TAG_module:
+    case DW_TAG_class_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_union_type:
+    case DW_TAG_interface_type:
+    case DW_TAG_try_block:
+    case DW_TAG_catch_block:
+    case DW_TAG_with_stmt:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static int
+walk_dies(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Die first,
+    Dwarf_Signed parent,
+    unsigned depth,
+    Dwarf_Error *error)
+{
+    Dwarf_Die die = first;
+    int res = DW_DLV_OK;
+
+    if (depth > DW_INLINE_MAX_DEPTH) {
+        dwarf_dealloc_die(first);
+        _dwarf_error_string(dbg, error, DW_DLE_INLINE_TREE_ERROR,
+            "DW_DLE_INLINE_TREE_ERROR: DIE nesting deeper than "
+            "the inline frame index allows");
+        return DW_DLV_ERROR;
+    }
+    while (die) {
+        Dwarf_Half tag = 0;
+        Dwarf_Signed child_parent = parent;
+        Dwarf_Bool descend = FALSE;
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        res = dwarf_tag(die,&tag,error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (tag == DW_TAG_subprogram ||
+            tag == DW_TAG_inlined_subroutine) {
+            Dwarf_Unsigned node = cu->ic_node_count;
+            Dwarf_Unsigned oldcount = cu->ic_ranges.ra_count;
+            Dwarf_Bool has_pc = FALSE;
+
+            res = _dwarf_inline_die_ranges(dbg,die,node,parent,
+                &cu->ic_ranges,&has_pc,error);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+            if (cu->ic_ranges.ra_count > oldcount) {
+                res = add_node(dbg,cu,die,tag,&node,error);
+                if (res != DW_DLV_OK) {
+                    break;
+                }
+                child_parent = (Dwarf_Signed)node;
+                descend = TRUE;
+            }
+            /*  Else a declaration or abstract instance:
+                nothing below it has code either. */
+        } else {
+            descend = tag_may_enclose_code(tag);
+        }
+        if (descend) {
+            res = dwarf_child(die,&child,error);
+            if (res == DW_DLV_ERROR) {
+                break;
+            }
+            if (res == DW_DLV_OK) {
+                res = walk_dies(dbg,cu,child,child_parent,
+                    depth+1,error);
+                if (res != DW_DLV_OK) {
+                    break;
+                }
+            }
+        }
+        res = dwarf_siblingof_b(dbg,die,TRUE,&sib,error);
+        if (res == DW_DLV_ERROR) {
+            break;
+        }
+        dwarf_dealloc_die(die);
+        die = (res == DW_DLV_OK)? sib:0;
+        res = DW_DLV_OK;
+    }
+    if (die) {
+        dwarf_dealloc_die(die);
+    }
+    return res;
+}
+
+static int
+range_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Inline_Range_s *lp = l;
+    const struct Dwarf_Inline_Range_s *rp = r;
+
+    if (lp->ir_parent != rp->ir_parent) {
+        return lp->ir_parent < rp->ir_parent? -1:1;
+    }
+    if (lp->ir_low != rp->ir_low) {
+        return lp->ir_low < rp->ir_low? -1:1;
+    }
+    if (lp->ir_high != rp->ir_high) {
+        return lp->ir_high < rp->ir_high? -1:1;
+    }
+    if (lp->ir_node != rp->ir_node) {
+        return lp->ir_node < rp->ir_node? -1:1;
+    }
+    return 0;
+}
+
+static void
+free_cu_tree(struct Dwarf_Inline_CU_s *cu)
+{
+    free(cu->ic_nodes);
+    cu->ic_nodes = 0;
+    cu->ic_node_count = 0;
+    cu->ic_node_alloc = 0;
+    free(cu->ic_ranges.ra_ranges);
+    cu->ic_ranges.ra_ranges = 0;
+    cu->ic_ranges.ra_count = 0;
+    cu->ic_ranges.ra_alloc = 0;
+    cu->ic_root_count = 0;
+    free(cu->ic_strings);
+    cu->ic_strings = 0;
+    cu->ic_strings_size = 0;
+    cu->ic_strings_alloc = 0;
+    if (cu->ic_line_context) {
+        dwarf_srclines_dealloc_b(cu->ic_line_context);
+        cu->ic_line_context = 0;
+    }
+    cu->ic_line_context_tried = FALSE;
+    free(cu->ic_rows);
+    cu->ic_rows = 0;
+    cu->ic_row_count = 0;
+    cu->ic_rows_built = FALSE;
+    cu->ic_built = FALSE;
+}
+
+int
+_dwarf_inline_build_cu(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Error *error)
+{
+    Dwarf_Die cudie = 0;
+    Dwarf_Die child = 0;
+    Dwarf_Half offset_size = 0;
+    Dwarf_Unsigned i = 0;
+    struct Dwarf_Inline_Range_s *r = 0;
+    int res = 0;
+
+    if (cu->ic_built) {
+        return DW_DLV_OK;
+    }
+    res = dwarf_offdie_b(dbg,cu->ic_cu_die_offset,TRUE,
+        &cudie,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_get_version_of_die(cudie,&cu->ic_version,
+        &offset_size);
+    if (res == DW_DLV_OK) {
+        res = dwarf_child(cudie,&child,error);
+        if (res == DW_DLV_OK) {
+            res = walk_dies(dbg,cu,child,-1,1,error);
+        } else if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+        }
+    }
+    dwarf_dealloc_die(cudie);
+    if (res != DW_DLV_OK) {
+        free_cu_tree(cu);
+        return res;
+    }
+    if (cu->ic_ranges.ra_count) {
+        qsort(cu->ic_ranges.ra_ranges,cu->ic_ranges.ra_count,
+            sizeof(struct Dwarf_Inline_Range_s),range_compare);
+    }
+    /*  Each parent's children are now contiguous, the top
+        level (-1) first. */
+    r = cu->ic_ranges.ra_ranges;
+    for (i = 0; i < cu->ic_ranges.ra_count; ++i) {
+        if (r[i].ir_parent < 0) {
+            cu->ic_root_count++;
+        } else {
+            struct Dwarf_Inline_Node_s *p =
+                cu->ic_nodes + r[i].ir_parent;
+
+            if (!p->in_child_count) {
+                p->in_child_start = i;
+            }
+            p->in_child_count++;
+        }
+    }
+    cu->ic_built = TRUE;
+    return DW_DLV_OK;
+}
+
+/*  Returns the index of the range in r[0..count) that
+    holds pc, or -1. Siblings do not overlap in sane
+    DWARF so the last range starting at or below pc
+    is the only candidate. */
+static Dwarf_Signed
+find_range(const struct Dwarf_Inline_Range_s *r,
+    Dwarf_Unsigned count,
+    Dwarf_Addr pc)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (r[mid].ir_low <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (!lo || pc >= r[lo-1].ir_high) {
+        return -1;
+    }
+    return (Dwarf_Signed)(lo-1);
+}
+
+static int
+build_cu_table(Dwarf_Debug dbg,
+    struct Dwarf_Inline_Index_s *ix,
+    Dwarf_Error *error)
+{
+    Dwarf_Off offset = 0;
+    Dwarf_Unsigned secsize = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = _dwarf_load_debug_info(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    secsize = dbg->de_debug_info.dss_size;
+    /*  Walk the CU headers by offset rather than with
+        dwarf_next_cu_header_d() so a caller part way
+        through its own CU loop is not disturbed. */
+    while (offset < secsize) {
+        Dwarf_Off dieoffset = 0;
+        Dwarf_Die cudie = 0;
+        Dwarf_CU_Context context = 0;
+        Dwarf_Bool has_pc = FALSE;
+        Dwarf_Off next = 0;
+
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,offset,TRUE,&dieoffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_offdie_b(dbg,dieoffset,TRUE,&cudie,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        context = cudie->di_cu_context;
+        next = context->cc_debug_offset + context->cc_length +
+            context->cc_length_size + context->cc_extension_size;
+        if (ix->ii_cu_count >= ix->ii_cu_alloc) {
+            Dwarf_Unsigned newalloc = ix->ii_cu_alloc?
+                ix->ii_cu_alloc*2:16;
+            struct Dwarf_Inline_CU_s *newcus =
+                (struct Dwarf_Inline_CU_s *)realloc(ix->ii_cus,
+                newalloc*sizeof(struct Dwarf_Inline_CU_s));
+
+            if (!newcus) {
+                dwarf_dealloc_die(cudie);
+                return inline_alloc_error(dbg,error);
+            }
+            ix->ii_cus = newcus;
+            ix->ii_cu_alloc = newalloc;
+        }
+        res = _dwarf_inline_die_ranges(dbg,cudie,ix->ii_cu_count,
+            -1,&ix->ii_cu_ranges,&has_pc,error);
+        dwarf_dealloc_die(cudie);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (has_pc) {
+            struct Dwarf_Inline_CU_s *cu =
+                ix->ii_cus + ix->ii_cu_count;
+
+            memset(cu,0,sizeof(*cu));
+            cu->ic_cu_die_offset = dieoffset;
+            ix->ii_cu_count++;
+        }
+        /*  else a type unit, a partial unit or a CU
+            with no code. */
+        if (next <= offset) {
+            break;
+        }
+        offset = next;
+    }
+    if (ix->ii_cu_ranges.ra_count) {
+        struct Dwarf_Inline_Range_s *r = ix->ii_cu_ranges.ra_ranges;
+        Dwarf_Addr maxhigh = 0;
+
+        qsort(r,ix->ii_cu_ranges.ra_count,
+            sizeof(struct Dwarf_Inline_Range_s),range_compare);
+        ix->ii_max_high = (Dwarf_Addr *)malloc(
+            ix->ii_cu_ranges.ra_count*sizeof(Dwarf_Addr));
+        if (!ix->ii_max_high) {
+            return inline_alloc_error(dbg,error);
+        }
+        for (i = 0; i < ix->ii_cu_ranges.ra_count; ++i) {
+            if (r[i].ir_high > maxhigh) {
+                maxhigh = r[i].ir_high;
+            }
+            ix->ii_max_high[i] = maxhigh;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_inline_index_destroy(Dwarf_Debug dbg)
+{
+    struct Dwarf_Inline_Index_s *ix = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (!dbg || !dbg->de_inline_index) {
+        return;
+    }
+    ix = dbg->de_inline_index;
+    for (i = 0; i < ix->ii_cu_count; ++i) {
+        free_cu_tree(ix->ii_cus+i);
+    }
+    free(ix->ii_cus);
+    free(ix->ii_cu_ranges.ra_ranges);
+    free(ix->ii_max_high);
+    free(ix);
+    dbg->de_inline_index = 0;
+}
+
+int
+_dwarf_inline_find_cu(Dwarf_Debug dbg,
+    Dwarf_Addr pc,
+    struct Dwarf_Inline_CU_s **cu_out,
+    struct Dwarf_Inline_Range_s **range_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Inline_Index_s *ix = dbg->de_inline_index;
+    struct Dwarf_Inline_Range_s *r = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+
+    if (!ix) {
+        int res = 0;
+
+        ix = (struct Dwarf_Inline_Index_s *)calloc(1,
+            sizeof(struct Dwarf_Inline_Index_s));
+        if (!ix) {
+            return inline_alloc_error(dbg,error);
+        }
+        dbg->de_inline_index = ix;
+        res = build_cu_table(dbg,ix,error);
+        if (res != DW_DLV_OK) {
+            _dwarf_inline_index_destroy(dbg);
+            return res;
+        }
+    }
+    r = ix->ii_cu_ranges.ra_ranges;
+    hi = ix->ii_cu_ranges.ra_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (r[mid].ir_low <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    /*  CU ranges can overlap (a CU DIE with only a
+        low_pc, or odd linkers), so walk back while
+        some earlier range could still reach pc. */
+    while (lo > 0 && ix->ii_max_high[lo-1] > pc) {
+        --lo;
+        if (pc < r[lo].ir_high) {
+            *cu_out = ix->ii_cus + r[lo].ir_node;
+            if (range_out) {
+                *range_out = r + lo;
+            }
+            return DW_DLV_OK;
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+Dwarf_Line_Context
+_dwarf_inline_cu_line_context(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu)
+{
+    if (!cu->ic_line_context_tried) {
+        Dwarf_Error lerr = 0;
+        Dwarf_Die cudie = 0;
+        Dwarf_Unsigned version = 0;
+        Dwarf_Small table_count = 0;
+        int res = 0;
+
+        cu->ic_line_context_tried = TRUE;
+        res = dwarf_offdie_b(dbg,cu->ic_cu_die_offset,TRUE,
+            &cudie,&lerr);
+        if (res == DW_DLV_OK) {
+            res = dwarf_srclines_b(cudie,&version,&table_count,
+                &cu->ic_line_context,&lerr);
+            dwarf_dealloc_die(cudie);
+        }
+        if (res == DW_DLV_ERROR) {
+            /*  A frame without a file name is
+                still worth returning. */
+            dwarf_dealloc_error(dbg,lerr);
+        }
+    }
+    return cu->ic_line_context;
+}
+
+static const char *
+call_file_path(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    struct Dwarf_Inline_Node_s *n)
+{
+    Dwarf_Line_Context line_context = 0;
+    Dwarf_Error lerr = 0;
+    const char *path = 0;
+    int res = 0;
+
+    if (!n->in_call_file_present) {
+        return 0;
+    }
+    line_context = _dwarf_inline_cu_line_context(dbg,cu);
+    if (!line_context) {
+        return 0;
+    }
+    res = dwarf_srclines_file_path(line_context,
+        (Dwarf_Signed)n->in_call_file,&path,&lerr);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,lerr);
+        return 0;
+    }
+    return res == DW_DLV_OK? path:0;
+}
+
+const char *
+_dwarf_inline_node_string(struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Unsigned off)
+{
+    if (!off) {
+        return 0;
+    }
+    return cu->ic_strings + off - 1;
+}
+
+Dwarf_Unsigned
+_dwarf_inline_chain(struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Addr pc,
+    struct Dwarf_Inline_Range_s **chain)
+{
+    Dwarf_Unsigned depth = 0;
+    Dwarf_Unsigned start = 0;
+    Dwarf_Unsigned count = cu->ic_root_count;
+
+    while (count && depth <= DW_INLINE_MAX_DEPTH) {
+        struct Dwarf_Inline_Range_s *r =
+            cu->ic_ranges.ra_ranges + start;
+        struct Dwarf_Inline_Node_s *n = 0;
+        Dwarf_Signed found = find_range(r,count,pc);
+
+        if (found < 0) {
+            break;
+        }
+        chain[depth++] = r + found;
+        n = cu->ic_nodes + r[found].ir_node;
+        start = n->in_child_start;
+        count = n->in_child_count;
+    }
+    return depth;
+}
+
+int
+dwarf_inline_frames(Dwarf_Debug dbg,
+    Dwarf_Addr pc,
+    Dwarf_Inline_Frame *frames,
+    Dwarf_Unsigned frames_len,
+    Dwarf_Unsigned *frame_count,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Inline_CU_s *cu = 0;
+    struct Dwarf_Inline_Range_s *chain[DW_INLINE_MAX_DEPTH+1];
+    Dwarf_Unsigned depth = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!frame_count || (frames_len && !frames)) {
+        _dwarf_error_string(dbg, error, DW_DLE_INLINE_TREE_ERROR,
+            "DW_DLE_INLINE_TREE_ERROR: dwarf_inline_frames() "
+            "passed a NULL result pointer");
+        return DW_DLV_ERROR;
+    }
+    res = _dwarf_inline_find_cu(dbg,pc,&cu,0,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_inline_build_cu(dbg,cu,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    depth = _dwarf_inline_chain(cu,pc,chain);
+    if (!depth) {
+        return DW_DLV_NO_ENTRY;
+    }
+    /* Innermost first. */
+    for (i = 0; i < depth && i < frames_len; ++i) {
+        struct Dwarf_Inline_Range_s *r = chain[depth - 1 - i];
+        struct Dwarf_Inline_Node_s *n = cu->ic_nodes + r->ir_node;
+        Dwarf_Inline_Frame *f = frames + i;
+
+        f->if_tag = n->in_tag;
+        f->if_die_offset = n->in_die_offset;
+        f->if_cu_die_offset = cu->ic_cu_die_offset;
+        f->if_name = _dwarf_inline_node_string(cu,n->in_name);
+        f->if_linkage_name = _dwarf_inline_node_string(cu,
+            n->in_linkage_name);
+        f->if_lowpc = r->ir_low;
+        f->if_highpc = r->ir_high;
+        f->if_call_file = call_file_path(dbg,cu,n);
+        f->if_call_line = n->in_call_line;
+        f->if_call_column = n->in_call_column;
+    }
+    *frame_count = depth;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_inline_frames_cache_clear(Dwarf_Debug dbg)
+{
+    _dwarf_inline_index_destroy(dbg);
+}
@@ -0,0 +1,186 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The per-Dwarf_Debug index behind dwarf_inline_frames().
+    CUs are found by address through a sorted table of
+    CU DIE pc ranges.  The first query landing in a CU
+    walks its DIEs once and records every
+    DW_TAG_subprogram and DW_TAG_inlined_subroutine with
+    code as a node.  The pc ranges of the children of
+    each node are kept sorted and contiguous, so a query
+    is one binary search per level of inlining. */
+
+#ifndef DWARF_INLINE_H
+#define DWARF_INLINE_H
+
+/*  Deeper nesting than this is treated as corrupt DWARF. */
+#define DW_INLINE_MAX_DEPTH 256
+
+struct Dwarf_Inline_Range_s {
+    Dwarf_Addr     ir_low;
+    /* One past the last address. */
+    Dwarf_Addr     ir_high;
+    /*  Node index in a CU tree, or CU index in the
+        CU table. */
+    Dwarf_Unsigned ir_node;
+    /*  Node index of the enclosing subprogram or inlined
+        subroutine, -1 for the top level. */
+    Dwarf_Signed   ir_parent;
+};
+
+struct Dwarf_Inline_Range_Array_s {
+    struct Dwarf_Inline_Range_s *ra_ranges;
+    Dwarf_Unsigned ra_count;
+    Dwarf_Unsigned ra_alloc;
+};
+
+struct Dwarf_Inline_Node_s {
+    Dwarf_Off      in_die_offset;
+    Dwarf_Half     in_tag;
+    Dwarf_Bool     in_call_file_present;
+    /*  Offsets plus one into ic_strings, zero if
+        the DIE (and its origins) have no such name. */
+    Dwarf_Unsigned in_name;
+    Dwarf_Unsigned in_linkage_name;
+    /* From DW_AT_call_file/line/column. */
+    Dwarf_Unsigned in_call_file;
+    Dwarf_Unsigned in_call_line;
+    Dwarf_Unsigned in_call_column;
+    /*  The ranges of the children of this node are
+        ic_ranges.ra_ranges[in_child_start] on,
+        in_child_count of them, sorted by address. */
+    Dwarf_Unsigned in_child_start;
+    Dwarf_Unsigned in_child_count;
+};
+
+/*  One row of a CU line table as an address range, for
+    dwarf_symbolize_pcs(). */
+struct Dwarf_Inline_Line_Row_s {
+    Dwarf_Addr     lr_low;
+    /* One past the last address. */
+    Dwarf_Addr     lr_high;
+    /*  The largest lr_high of this and all earlier rows,
+        as sequences can overlap. */
+    Dwarf_Addr     lr_max_high;
+    Dwarf_Unsigned lr_file;
+    Dwarf_Unsigned lr_line;
+    Dwarf_Unsigned lr_column;
+};
+
+struct Dwarf_Inline_CU_s {
+    Dwarf_Off      ic_cu_die_offset;
+    Dwarf_Half     ic_version;
+    Dwarf_Bool     ic_built;
+    Dwarf_Bool     ic_line_context_tried;
+
+    struct Dwarf_Inline_Node_s *ic_nodes;
+    Dwarf_Unsigned ic_node_count;
+    Dwarf_Unsigned ic_node_alloc;
+
+    /*  Sorted by parent, then address. The top level
+        (ir_parent -1) comes first: ic_root_count of them. */
+    struct Dwarf_Inline_Range_Array_s ic_ranges;
+    Dwarf_Unsigned ic_root_count;
+
+    /* Names, NUL terminated, malloc space. */
+    char          *ic_strings;
+    Dwarf_Unsigned ic_strings_size;
+    Dwarf_Unsigned ic_strings_alloc;
+
+    /*  Opened on the first query needing a
+        DW_AT_call_file path or a line. */
+    Dwarf_Line_Context ic_line_context;
+
+    /*  The line table rows sorted by address, built on
+        the first dwarf_symbolize_pcs() landing here. */
+    Dwarf_Bool     ic_rows_built;
+    struct Dwarf_Inline_Line_Row_s *ic_rows;
+    Dwarf_Unsigned ic_row_count;
+};
+
+struct Dwarf_Inline_Index_s {
+    struct Dwarf_Inline_CU_s *ii_cus;
+    Dwarf_Unsigned ii_cu_count;
+    Dwarf_Unsigned ii_cu_alloc;
+
+    /*  CU DIE ranges sorted by address, ir_node is the
+        CU index.  ii_max_high[i] is the largest ir_high
+        of entries 0 through i so an address search can
+        stop walking back early when CU ranges overlap. */
+    struct Dwarf_Inline_Range_Array_s ii_cu_ranges;
+    Dwarf_Addr    *ii_max_high;
+};
+
+/*  Appends the pc ranges of die (from DW_AT_low_pc and
+    DW_AT_high_pc, or DW_AT_ranges in .debug_ranges or
+    .debug_rnglists) to ra, tagged with node and parent.
+    Sets *has_pc_info FALSE if die has neither. */
+int _dwarf_inline_die_ranges(Dwarf_Debug dbg,
+    Dwarf_Die die,
+    Dwarf_Unsigned node,
+    Dwarf_Signed parent,
+    struct Dwarf_Inline_Range_Array_s *ra,
+    Dwarf_Bool *has_pc_info,
+    Dwarf_Error *error);
+
+/*  Builds the CU table if needed and returns the
+    CU whose DIE covers pc, DW_DLV_NO_ENTRY if none does.
+    If range_out is non-null it is set to the CU
+    range holding pc. */
+int _dwarf_inline_find_cu(Dwarf_Debug dbg,
+    Dwarf_Addr pc,
+    struct Dwarf_Inline_CU_s **cu_out,
+    struct Dwarf_Inline_Range_s **range_out,
+    Dwarf_Error *error);
+
+/*  Walks the DIEs of cu once to fill in its nodes. */
+int _dwarf_inline_build_cu(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Error *error);
+
+/*  Fills chain with the ranges enclosing pc, outermost
+    first, and returns how many there are (zero if no
+    function of cu covers pc).  chain must have room for
+    DW_INLINE_MAX_DEPTH+1 entries. */
+Dwarf_Unsigned _dwarf_inline_chain(struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Addr pc,
+    struct Dwarf_Inline_Range_s **chain);
+
+/*  Returns a name recorded in cu, NULL for offset zero. */
+const char * _dwarf_inline_node_string(struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Unsigned off);
+
+/*  Returns the line table of cu, opening it on the
+    first call.  NULL if the CU has none or it cannot
+    be read. */
+Dwarf_Line_Context _dwarf_inline_cu_line_context(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu);
+
+void _dwarf_inline_index_destroy(Dwarf_Debug dbg);
+
+#endif /* DWARF_INLINE_H */
@@ -193,6 +193,7 @@ create_fullest_file_path(Dwarf_Debug dbg,
         Dwarf_Unsigned incdirnamelen = 0;
         Dwarf_Unsigned filenamelen = strlen(file_name);
         Dwarf_Unsigned compdirnamelen = 0;
+        unsigned dirbias = 1;
 
         if (line_context->lc_compilation_directory) {
             comp_dir_name =
@@ -200,13 +201,22 @@ create_fullest_file_path(Dwarf_Debug dbg,
             compdirnamelen = strlen(comp_dir_name);
         }
 
-        if (dirno > line_context->lc_include_directories_count) {
+        /*  DWARF 2,3,4 directory 1 is the first listed,
+            DWARF5 lists directory 0 (the compilation
+            directory) too, so no adjustment is needed. */
+        if (line_context->lc_version_number >= DW_LINE_VERSION5 &&
+            line_context->lc_version_number !=
+            EXPERIMENTAL_LINE_TABLES_VERSION) {
+            dirbias = 0;
+        }
+        if (dirno >= dirbias && (dirno - dirbias) >=
+            line_context->lc_include_directories_count) {
             _dwarf_error(dbg, error, DW_DLE_INCL_DIR_NUM_BAD);
             return (DW_DLV_ERROR);
         }
         if (dirno > 0 && fe->fi_dir_index > 0) {
             inc_dir_name = (char *) line_context->lc_include_directories[
-                fe->fi_dir_index - 1];
+                fe->fi_dir_index - dirbias];
             if (!inc_dir_name) {
                 /*  This should never ever happen except in case
                     of a corrupted object file. */
@@ -727,6 +737,7 @@ _dwarf_internal_srclines(Dwarf_Die die,
             }
             return resp;
         }
+        dbg->de_perf_counters.pc_line_programs_decoded++;
         line_ptr_end = line_context->lc_line_ptr_end;
         line_ptr = newlinep;
         if (line_context->lc_actuals_table_offset > 0) {
@@ -1515,13 +1526,88 @@ dwarf_lineoff_b(Dwarf_Line line,
 }
 
 
+/*  Size (or grow) the per-context index of file entries
+    and the memo of full paths so both have
+    lc_file_entry_count entries.  Paths already computed
+    are kept, so pointers handed out stay valid. */
 static int
-dwarf_filename(Dwarf_Line_Context context,
+ensure_file_path_memo(Dwarf_Line_Context context,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = context->lc_dbg;
+    Dwarf_Unsigned count = context->lc_file_entry_count;
+    Dwarf_Unsigned oldcount = context->lc_file_paths_count;
+    Dwarf_File_Entry *entries = 0;
+    char **paths = 0;
+    Dwarf_File_Entry fe = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (count <= oldcount) {
+        return DW_DLV_OK;
+    }
+    entries = (Dwarf_File_Entry *)realloc(
+        context->lc_file_entry_array,
+        count * sizeof(Dwarf_File_Entry));
+    if (!entries) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the file entry index "
+            "of a line table context");
+        return DW_DLV_ERROR;
+    }
+    context->lc_file_entry_array = entries;
+    paths = (char **)realloc(context->lc_file_full_paths,
+        count * sizeof(char *));
+    if (!paths) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL: allocating the file path memo "
+            "of a line table context");
+        return DW_DLV_ERROR;
+    }
+    context->lc_file_full_paths = paths;
+    for (i = oldcount; i < count; ++i) {
+        paths[i] = 0;
+    }
+    fe = context->lc_file_entries;
+    for (i = 0; i < count && fe; ++i, fe = fe->fi_next) {
+        entries[i] = fe;
+    }
+    if (i < count) {
+        /*  The list is shorter than its count.
+            Corrupt context, do not use the memo. */
+        _dwarf_error_string(dbg, error, DW_DLE_NO_FILE_NAME,
+            "DW_DLE_NO_FILE_NAME: the line table file list is "
+            "shorter than its file count");
+        return DW_DLV_ERROR;
+    }
+    context->lc_file_paths_count = count;
+    return DW_DLV_OK;
+}
+
+static void
+free_file_path_memo(Dwarf_Line_Context context)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (context->lc_file_full_paths) {
+        for (i = 0; i < context->lc_file_paths_count; ++i) {
+            free(context->lc_file_full_paths[i]);
+        }
+        free(context->lc_file_full_paths);
+        context->lc_file_full_paths = 0;
+    }
+    free(context->lc_file_entry_array);
+    context->lc_file_entry_array = 0;
+    context->lc_file_paths_count = 0;
+}
+
+/*  Returns the full path of file number fileno_in,
+    computed once per file entry and owned by the
+    line context. */
+static int
+line_context_file_path(Dwarf_Line_Context context,
     Dwarf_Signed fileno_in,
-    char **ret_filename, Dwarf_Error *error)
+    const char **ret_filename, Dwarf_Error *error)
 {
-    Dwarf_Signed i = 0;
-    Dwarf_File_Entry file_entry = 0;
     Dwarf_Debug dbg = context->lc_dbg;
     int res = 0;
     Dwarf_Signed baseindex = 0;
@@ -1530,14 +1616,22 @@ dwarf_filename(Dwarf_Line_Context context,
     /*  Negative values not sensible. Leaving traditional
         signed interfaces in place. */
     Dwarf_Signed fileno = fileno_in;
+    Dwarf_Unsigned index = 0;
     unsigned linetab_version = context->lc_version_number;
+    char *path = 0;
 
     res =  dwarf_srclines_files_indexes(context, &baseindex,
         &file_count, &endindex, error);
     if (res != DW_DLV_OK) {
         return res;
     }
-    if (fileno >= endindex) {
+    if (!fileno && (linetab_version <= DW_LINE_VERSION4 ||
+        linetab_version == EXPERIMENTAL_LINE_TABLES_VERSION)) {
+        /*  DWARF 2,3,4 file 0 means no file.
+            DWARF 5 line index 0 is fine. */
+        return DW_DLV_NO_ENTRY;
+    }
+    if (fileno >= endindex || fileno < baseindex) {
         dwarfstring m;
 
         dwarfstring_constructor(&m);
@@ -1554,26 +1648,68 @@ dwarf_filename(Dwarf_Line_Context context,
             dwarfstring_string(&m));
         dwarfstring_destructor(&m);
         return DW_DLV_ERROR;
-    } else {
-        if (linetab_version <= DW_LINE_VERSION4 ||
-            linetab_version == EXPERIMENTAL_LINE_TABLES_VERSION) {
-            if (!fileno) {
-                return DW_DLV_NO_ENTRY;
-            }
-            /* else ok */
-        }  /* else DWARF 5 line index 0 is fine */
     }
+    res = ensure_file_path_memo(context,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    index = (Dwarf_Unsigned)(fileno - baseindex);
+    if (index >= context->lc_file_paths_count) {
+        _dwarf_error(dbg, error, DW_DLE_NO_FILE_NAME);
+        return DW_DLV_ERROR;
+    }
+    path = context->lc_file_full_paths[index];
+    if (!path) {
+        char *full = 0;
+        size_t len = 0;
 
-    file_entry = context->lc_file_entries;
-    /*  zero fileno allowed for DWARF5 table. For DWARF4,
-        zero fileno handled above. */
-    for (i =  baseindex; i < fileno ; i++) {
-        file_entry = file_entry->fi_next;
+        res = create_fullest_file_path(dbg,
+            context->lc_file_entry_array[index],
+            context, &full,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        len = strlen(full);
+        path = malloc(len+1);
+        if (!path) {
+            dwarf_dealloc(dbg,full,DW_DLA_STRING);
+            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+        memcpy(path,full,len+1);
+        dwarf_dealloc(dbg,full,DW_DLA_STRING);
+        context->lc_file_full_paths[index] = path;
     }
+    *ret_filename = path;
+    return DW_DLV_OK;
+}
 
-    res = create_fullest_file_path(dbg,
-        file_entry,context, ret_filename,error);
-    return res;
+static int
+dwarf_filename(Dwarf_Line_Context context,
+    Dwarf_Signed fileno,
+    char **ret_filename, Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = context->lc_dbg;
+    const char *path = 0;
+    char *copy = 0;
+    size_t len = 0;
+    int res = 0;
+
+    res = line_context_file_path(context,fileno,&path,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    /*  dwarf_linesrc() has always returned a string
+        the caller must dwarf_dealloc(). */
+    len = strlen(path);
+    copy = (char *) _dwarf_get_alloc(dbg, DW_DLA_STRING, len+1);
+    if (!copy) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    memcpy(copy,path,len+1);
+    *ret_filename = copy;
+    return DW_DLV_OK;
 }
 
 int
@@ -1591,6 +1727,45 @@ dwarf_linesrc(Dwarf_Line line, char **ret_linesrc, Dwarf_Error * error)
         line->li_addr_line.li_l_data.li_file, ret_linesrc, error);
 }
 
+/*  Like dwarf_linesrc() but the string returned is owned
+    by the line table context: it is computed once per
+    file entry and stays valid until the context is freed
+    by dwarf_srclines_dealloc_b() (or dwarf_finish()).
+    Do not dwarf_dealloc() it.  New October 2026. */
+int
+dwarf_linesrc_b(Dwarf_Line line, const char **ret_linesrc,
+    Dwarf_Error * error)
+{
+    if (line == NULL) {
+        _dwarf_error(NULL, error, DW_DLE_DWARF_LINE_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (line->li_context == NULL) {
+        _dwarf_error(NULL, error, DW_DLE_LINE_CONTEXT_NULL);
+        return DW_DLV_ERROR;
+    }
+    return line_context_file_path(line->li_context,
+        line->li_addr_line.li_l_data.li_file, ret_linesrc, error);
+}
+
+/*  The full path of file number fileindex (as in
+    dwarf_line_srcfileno()) of the line table, with the
+    same lifetime as for dwarf_linesrc_b().
+    New October 2026. */
+int
+dwarf_srclines_file_path(Dwarf_Line_Context context,
+    Dwarf_Signed fileindex,
+    const char **ret_path,
+    Dwarf_Error * error)
+{
+    if (!context || context->lc_magic != DW_CONTEXT_MAGIC) {
+        _dwarf_error(NULL, error, DW_DLE_LINE_CONTEXT_BOTCH);
+        return DW_DLV_ERROR;
+    }
+    return line_context_file_path(context,fileindex,
+        ret_path,error);
+}
+
 /*  Every line table entry potentially has the basic-block-start
     flag marked 'on'.   This returns thru *return_bool,
     the basic-block-start flag.
@@ -1733,6 +1908,7 @@ delete_line_context_itself(Dwarf_Line_Context context)
         return;
     }
     dbg = context->lc_dbg;
+    free_file_path_memo(context);
     fe = context->lc_file_entries;
     while (fe) {
         Dwarf_File_Entry fenext = fe->fi_next;
@@ -2124,6 +2300,7 @@ _dwarf_line_context_destructor(void *m)
         /* Nothing is safe, do nothing. */
         return;
     }
+    free_file_path_memo(line_context);
     if (line_context->lc_include_directories) {
         free(line_context->lc_include_directories);
         line_context->lc_include_directories = 0;
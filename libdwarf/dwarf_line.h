@@ -213,6 +213,17 @@ struct Dwarf_Line_Context_s {
     /*  Values Easing the process of indexing through lc_file_entries. */
     Dwarf_Unsigned lc_file_entry_baseindex;
     Dwarf_Unsigned lc_file_entry_endindex;
+
+    /*  Filled in lazily by dwarf_srclines_file_path()
+        and dwarf_linesrc_b(). lc_file_entry_array indexes
+        lc_file_entries so no list walk is needed per line.
+        lc_file_full_paths[n] is the full path (malloc space)
+        for that entry, computed on first use and freed
+        with the context.  Both arrays are malloc space
+        with lc_file_paths_count entries. */
+    Dwarf_File_Entry *lc_file_entry_array;
+    char **lc_file_full_paths;
+    Dwarf_Unsigned lc_file_paths_count;
     /* ======== end file names =========*/
 
 
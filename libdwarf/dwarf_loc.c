@@ -297,6 +297,11 @@ _dwarf_get_locdesc(Dwarf_Debug dbg,
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return DW_DLV_ERROR;
     }
+    /*  Operands such as DW_OP_implicit_value of a
+        location list entry point into .debug_loc,
+        so each Dwarf_Locdesc pins that section till
+        it is dealloc'd (see _dwarf_locdesc_destructor()). */
+    _dwarf_pin_section(&dbg->de_debug_loc);
 
     locdesc->ld_cents = op_count;
     locdesc->ld_s = block_loc;
@@ -527,7 +532,7 @@ _dwarf_get_loclist_header_start(Dwarf_Debug dbg,
     if (blkres != DW_DLV_OK) {
         return blkres;
     }
-    if (!dbg->de_debug_loc.dss_data) {
+    {
         int secload = _dwarf_load_section(dbg, &dbg->de_debug_loc,error);
         if (secload != DW_DLV_OK) {
             return secload;
@@ -882,7 +887,6 @@ dwarf_loclist(Dwarf_Attribute attr,
         if (off_res != DW_DLV_OK) {
             return off_res;
         }
-
         /* With dwarf_loclist, just read a single entry */
         blkres = _dwarf_read_loc_section(dbg, &loc_block,
             &lowpc,
@@ -1131,13 +1135,17 @@ dwarf_get_loclist_entry(Dwarf_Debug dbg,
     int res = DW_DLV_ERROR;
     Dwarf_Half ll_op = 0;
 
-    if (!dbg->de_debug_loc.dss_data) {
+    {
         int secload = _dwarf_load_section(dbg,
             &dbg->de_debug_loc,error);
         if (secload != DW_DLV_OK) {
             return secload;
         }
     }
+    /*  *data points into .debug_loc and there is no
+        dealloc for it, so the section may never be
+        evicted once we hand it out. */
+    _dwarf_pin_section_for_life(&dbg->de_debug_loc);
 
     /*  FIXME: DO NOT USE the call. address_size is not necessarily
         the same in every frame. */
@@ -1377,6 +1385,8 @@ _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
     locdesc->ld_s = block_loc;
     locdesc->ld_kind = lkind;
     locdesc->ld_section_offset = loc_block->bl_section_offset;
+    locdesc->ld_expr_len = loc_block->bl_len;
+    locdesc->ld_loclist_head = loc_head;
     locdesc->ld_locdesc_offset = loc_block->bl_locdesc_offset;
     locdesc->ld_rawlow = lowpc;
     locdesc->ld_rawhigh = highpc;
@@ -1708,7 +1718,7 @@ _dwarf_original_expression_build(Dwarf_Debug dbg,
         blkres = dwarf_formexprloc(attr,&loc_blockc.bl_len,
             &loc_blockc.bl_data,error);
         if(blkres != DW_DLV_OK) {
-            dwarf_loc_head_c_dealloc(llhead);
+            /* The caller deallocs llhead. */
             return blkres;
         }
         loc_blockc.bl_kind = llhead->ll_kind;
@@ -1938,7 +1948,8 @@ cook_gnu_loclist_contents(Dwarf_Debug dbg,
 }
 
 
-/* DWARF5 */
+/*  DWARF5.  A .dwo has no .debug_addr of its own,
+    so indexes are looked up in the tied object too. */
 static int
 cook_loclists_contents(Dwarf_Debug dbg,
     Dwarf_Loc_Head_c llhead,
@@ -1965,7 +1976,7 @@ cook_loclists_contents(Dwarf_Debug dbg,
             if (debug_addr_fail) {
                 res = DW_DLV_NO_ENTRY;
             } else {
-                res = _dwarf_extract_address_from_debug_addr(dbg,
+                res = _dwarf_look_in_local_and_tied_by_index(dbg,
                     cucontext,llc->ld_rawlow,&targaddr,error);
             }
             if (res != DW_DLV_OK) {
@@ -1990,7 +2001,7 @@ cook_loclists_contents(Dwarf_Debug dbg,
             if (debug_addr_fail) {
                 res = DW_DLV_NO_ENTRY;
             } else {
-                res = _dwarf_extract_address_from_debug_addr(dbg,
+                res = _dwarf_look_in_local_and_tied_by_index(dbg,
                     cucontext,llc->ld_rawlow,&targaddr,error);
             }
             if (res != DW_DLV_OK) {
@@ -2007,7 +2018,7 @@ cook_loclists_contents(Dwarf_Debug dbg,
             if (debug_addr_fail) {
                 res = DW_DLV_NO_ENTRY;
             } else {
-                res = _dwarf_extract_address_from_debug_addr(dbg,
+                res = _dwarf_look_in_local_and_tied_by_index(dbg,
                     cucontext,llc->ld_rawhigh,&targaddr,error);
             }
             if (res != DW_DLV_OK) {
@@ -2029,7 +2040,7 @@ cook_loclists_contents(Dwarf_Debug dbg,
             if (debug_addr_fail) {
                 res = DW_DLV_NO_ENTRY;
             } else  {
-                res = _dwarf_extract_address_from_debug_addr(dbg,
+                res = _dwarf_look_in_local_and_tied_by_index(dbg,
                     cucontext,llc->ld_rawlow,&targaddr,error);
             }
             if (res != DW_DLV_OK) {
@@ -2103,6 +2114,41 @@ cook_loclists_contents(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+static void
+unknown_location_lkind_error(Dwarf_Debug dbg,
+    unsigned version,
+    Dwarf_Half form,
+    Dwarf_Unsigned attrnum,
+    Dwarf_Bool is_dwo,
+    Dwarf_Error *error)
+{
+    dwarfstring m;
+    const char * formname = "<unknownform>";
+    const char * attrname = "<unknown attribute>";
+
+    dwarfstring_constructor(&m);
+    dwarf_get_FORM_name(form,&formname);
+    dwarf_get_AT_name(attrnum,&attrname);
+    dwarfstring_append_printf_u(&m,
+        "DW_DLE_LOC_EXPR_BAD: For Compilation Unit "
+        "version %u",version);
+    dwarfstring_append_printf_u(&m,
+        ", attribute 0x%x (",attrnum);
+    dwarfstring_append(&m,(char *)attrname);
+    dwarfstring_append_printf_u(&m,
+        ") form 0x%x (",form);
+    dwarfstring_append(&m,(char *)formname);
+    if (is_dwo) {
+        dwarfstring_append(&m,") (the CU is a .dwo) ");
+    } else {
+        dwarfstring_append(&m,") (the CU is not a .dwo) ");
+    }
+    dwarfstring_append(&m," we don't undrstand the location");
+    _dwarf_error_string(dbg,error,DW_DLE_LOC_EXPR_BAD,
+        dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+}
+
 /*  New October 2015
     This interface requires the use of interface functions
     to get data from Dwarf_Locdesc_c.  The structures
@@ -2137,31 +2183,8 @@ dwarf_get_loclist_c(Dwarf_Attribute attr,
     lkind = determine_location_lkind(cuversionstamp,
         form, attrnum, is_dwo);
     if (lkind == DW_LKIND_unknown) {
-        dwarfstring m;
-        const char * formname = "<unknownform>";
-        const char * attrname = "<unknown attribute>";
-
-        dwarfstring_constructor(&m);
-        dwarf_get_FORM_name(form,&formname);
-        dwarf_get_AT_name(attrnum,&attrname);
-        dwarfstring_append_printf_u(&m,
-            "DW_DLE_LOC_EXPR_BAD: For Compilation Unit "
-            "version %u",cuversionstamp);
-        dwarfstring_append_printf_u(&m,
-            ", attribute 0x%x (",attrnum);
-        dwarfstring_append(&m,(char *)attrname);
-        dwarfstring_append_printf_u(&m,
-            ") form 0x%x (",form);
-        dwarfstring_append(&m,(char *)formname);
-        if (is_dwo) {
-            dwarfstring_append(&m,") (the CU is a .dwo) ");
-        } else {
-            dwarfstring_append(&m,") (the CU is not a .dwo) ");
-        }
-        dwarfstring_append(&m," we don't undrstand the location");
-        _dwarf_error_string(dbg,error,DW_DLE_LOC_EXPR_BAD,
-            dwarfstring_string(&m));
-        dwarfstring_destructor(&m);
+        unknown_location_lkind_error(dbg,cuversionstamp,
+            form,attrnum,is_dwo,error);
         return DW_DLV_ERROR;
     }
     /*  Doing this early (first) to avoid repeating the alloc code
@@ -2199,6 +2222,10 @@ dwarf_get_loclist_c(Dwarf_Attribute attr,
             dwarf_loc_head_c_dealloc(llhead);
             return setup_res;
         }
+        /*  The head points into .debug_loc till it
+            is dealloc'd, so keep that section loaded. */
+        _dwarf_pin_section(&dbg->de_debug_loc);
+        llhead->ll_pinned_section = &dbg->de_debug_loc;
         ores = _dwarf_original_loclist_build(dbg,
             llhead, attr, error);
         if (ores != DW_DLV_OK) {
@@ -2245,6 +2272,476 @@ dwarf_get_loclist_c(Dwarf_Attribute attr,
     return DW_DLV_OK;
 }
 
+/*  The one entry of a location list found by
+    dwarf_get_loclist_at_pc(). */
+struct Dwarf_Loc_At_Pc_s {
+    Dwarf_Block_c  lp_block;
+    Dwarf_Half     lp_lle_value;
+    /*  The values as in the section, before any base
+        address or .debug_addr index is applied. */
+    Dwarf_Addr     lp_rawlow;
+    Dwarf_Addr     lp_rawhigh;
+    Dwarf_Addr     lp_lopc;
+    Dwarf_Addr     lp_highpc;
+    Dwarf_Unsigned lp_entrylen;
+};
+
+/*  Translates a .debug_addr index, looking in the
+    tied object too for a .dwo.  A missing or unusable
+    .debug_addr is not an error here, the entry just
+    cannot match. */
+static int
+loc_at_pc_debug_addr(Dwarf_Debug dbg,
+    Dwarf_CU_Context cucontext,
+    Dwarf_Unsigned index,
+    Dwarf_Addr *addr_out,
+    Dwarf_Error *error)
+{
+    int res = 0;
+
+    res = _dwarf_look_in_local_and_tied_by_index(dbg,
+        cucontext,index,addr_out,error);
+    if (res == DW_DLV_ERROR) {
+        if (error) {
+            dwarf_dealloc_error(dbg, *error);
+            *error = 0;
+        }
+        return DW_DLV_NO_ENTRY;
+    }
+    return res;
+}
+
+/*  DWARF2,3,4 .debug_loc.  Walks the entries, decoding
+    no expressions, till one covers pc. */
+static int
+loc_at_pc_original(Dwarf_Debug dbg,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Attribute attr,
+    Dwarf_Addr pc,
+    struct Dwarf_Loc_At_Pc_s *match,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned loclist_offset = 0;
+    Dwarf_Addr baseaddress = llhead->ll_cu_base_address;
+    unsigned address_size = llhead->ll_address_size;
+    int res = 0;
+
+    res = _dwarf_get_loclist_header_start(dbg,
+        attr, &loclist_offset, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    llhead->ll_llearea_offset = loclist_offset;
+    for (;;) {
+        Dwarf_Block_c loc_block;
+        Dwarf_Addr lowpc = 0;
+        Dwarf_Addr highpc = 0;
+        Dwarf_Half lle_val = 0;
+
+        memset(&loc_block,0,sizeof(loc_block));
+        res = _dwarf_read_loc_section(dbg,&loc_block,
+            &lowpc,&highpc,&lle_val,
+            loclist_offset,address_size,
+            llhead->ll_kind,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (lowpc == 0 && highpc == 0) {
+            /* End of list. */
+            return DW_DLV_NO_ENTRY;
+        }
+        if (lowpc == MAX_ADDR) {
+            baseaddress = highpc;
+        } else if (pc >= lowpc + baseaddress &&
+            pc < highpc + baseaddress) {
+            match->lp_block = loc_block;
+            match->lp_lle_value = DW_LLE_offset_pair;
+            match->lp_rawlow = lowpc;
+            match->lp_rawhigh = highpc;
+            match->lp_lopc = lowpc + baseaddress;
+            match->lp_highpc = highpc + baseaddress;
+            match->lp_entrylen = loc_block.bl_section_offset +
+                loc_block.bl_len - loclist_offset;
+            return DW_DLV_OK;
+        }
+        loclist_offset = loc_block.bl_section_offset +
+            loc_block.bl_len;
+    }
+}
+
+/*  The GNU DWARF4 .dwo flavor of .debug_loc. */
+static int
+loc_at_pc_gnu(Dwarf_Debug dbg,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Attribute attr,
+    Dwarf_Addr pc,
+    struct Dwarf_Loc_At_Pc_s *match,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned loclist_offset = 0;
+    Dwarf_Addr baseaddress = llhead->ll_cu_base_address;
+    Dwarf_Bool base_address_fail = FALSE;
+    Dwarf_CU_Context cucontext = llhead->ll_context;
+    unsigned address_size = llhead->ll_address_size;
+    int res = 0;
+
+    res = _dwarf_get_loclist_header_start(dbg,
+        attr, &loclist_offset, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    llhead->ll_llearea_offset = loclist_offset;
+    for (;;) {
+        Dwarf_Block_c loc_block;
+        Dwarf_Addr lowpc = 0;
+        Dwarf_Addr highpc = 0;
+        Dwarf_Addr lopc_cooked = 0;
+        Dwarf_Addr highpc_cooked = 0;
+        Dwarf_Bool at_end = FALSE;
+        Dwarf_Bool usable = FALSE;
+        Dwarf_Half lle_op = 0;
+
+        res = _dwarf_read_loc_section_dwo(dbg,&loc_block,
+            &lowpc,&highpc,&at_end,&lle_op,
+            loclist_offset,address_size,
+            llhead->ll_kind,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (at_end) {
+            return DW_DLV_NO_ENTRY;
+        }
+        switch(lle_op) {
+        case DW_LLEX_base_address_selection_entry:
+            res = loc_at_pc_debug_addr(dbg,cucontext,
+                highpc,&baseaddress,error);
+            base_address_fail = (res != DW_DLV_OK);
+            break;
+        case DW_LLEX_start_length_entry:
+            res = loc_at_pc_debug_addr(dbg,cucontext,
+                lowpc,&lopc_cooked,error);
+            if (res == DW_DLV_OK) {
+                highpc_cooked = lopc_cooked + highpc;
+                usable = TRUE;
+            }
+            break;
+        case DW_LLEX_offset_pair_entry:
+            if (!base_address_fail) {
+                lopc_cooked = lowpc + baseaddress;
+                highpc_cooked = highpc + baseaddress;
+                usable = TRUE;
+            }
+            break;
+        case DW_LLEX_start_end_entry:
+            res = loc_at_pc_debug_addr(dbg,cucontext,
+                lowpc,&lopc_cooked,error);
+            if (res == DW_DLV_OK) {
+                res = loc_at_pc_debug_addr(dbg,cucontext,
+                    highpc,&highpc_cooked,error);
+                usable = (res == DW_DLV_OK);
+            }
+            break;
+        default:
+            break;
+        }
+        if (usable && pc >= lopc_cooked && pc < highpc_cooked) {
+            match->lp_block = loc_block;
+            match->lp_lle_value = lle_op;
+            match->lp_rawlow = lowpc;
+            match->lp_rawhigh = highpc;
+            match->lp_lopc = lopc_cooked;
+            match->lp_highpc = highpc_cooked;
+            match->lp_entrylen = loc_block.bl_section_offset +
+                loc_block.bl_len - loclist_offset;
+            return DW_DLV_OK;
+        }
+        loclist_offset = loc_block.bl_section_offset +
+            loc_block.bl_len;
+    }
+}
+
+/*  DWARF5 .debug_loclists.  A DW_LLE_default_location
+    entry matches only if no bounded entry does. */
+static int
+loc_at_pc_loclists(Dwarf_Debug dbg,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Attribute attr,
+    Dwarf_Addr pc,
+    struct Dwarf_Loc_At_Pc_s *match,
+    Dwarf_Error *error)
+{
+    Dwarf_Small *data = 0;
+    Dwarf_Small *enddata = 0;
+    Dwarf_Unsigned dataoffset = 0;
+    Dwarf_Addr baseaddress = llhead->ll_cu_base_address;
+    Dwarf_Bool base_address_fail = FALSE;
+    Dwarf_Bool debug_addr_fail = FALSE;
+    Dwarf_Bool have_default = FALSE;
+    Dwarf_CU_Context cucontext = llhead->ll_context;
+    int res = 0;
+
+    if (!llhead->ll_cu_base_address_present) {
+        base_address_fail = TRUE;
+    }
+    res = _dwarf_loclists_head_setup(dbg,attr,llhead,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    data = llhead->ll_llepointer;
+    dataoffset = llhead->ll_llearea_offset;
+    enddata = llhead->ll_end_data_area;
+    for (;;) {
+        unsigned entrylen = 0;
+        unsigned code = 0;
+        Dwarf_Unsigned val1 = 0;
+        Dwarf_Unsigned val2 = 0;
+        Dwarf_Unsigned opsblocksize = 0;
+        Dwarf_Unsigned opsoffset = 0;
+        Dwarf_Small *ops = 0;
+        Dwarf_Addr lopc_cooked = 0;
+        Dwarf_Addr highpc_cooked = 0;
+        Dwarf_Bool usable = FALSE;
+
+        if (data >= enddata) {
+            _dwarf_error_string(dbg,error,DW_DLE_LOCLISTS_ERROR,
+                "DW_DLE_LOCLISTS_ERROR: a loclist runs off the "
+                "end of its .debug_loclists table "
+                "without a DW_LLE_end_of_list");
+            return DW_DLV_ERROR;
+        }
+        res = _dwarf_read_single_lle_entry(dbg,
+            data,dataoffset,enddata,
+            llhead->ll_address_size,&entrylen,
+            &code,&val1,&val2,
+            &opsblocksize,&opsoffset,&ops,
+            error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        switch(code) {
+        case DW_LLE_end_of_list:
+            return have_default? DW_DLV_OK:DW_DLV_NO_ENTRY;
+        case DW_LLE_base_addressx:
+            res = DW_DLV_NO_ENTRY;
+            if (!debug_addr_fail) {
+                res = loc_at_pc_debug_addr(dbg,cucontext,
+                    val1,&baseaddress,error);
+            }
+            if (res != DW_DLV_OK) {
+                debug_addr_fail = TRUE;
+                base_address_fail = TRUE;
+            } else {
+                base_address_fail = FALSE;
+            }
+            break;
+        case DW_LLE_startx_endx:
+            res = DW_DLV_NO_ENTRY;
+            if (!debug_addr_fail) {
+                res = loc_at_pc_debug_addr(dbg,cucontext,
+                    val1,&lopc_cooked,error);
+                if (res == DW_DLV_OK) {
+                    res = loc_at_pc_debug_addr(dbg,cucontext,
+                        val2,&highpc_cooked,error);
+                }
+            }
+            if (res != DW_DLV_OK) {
+                debug_addr_fail = TRUE;
+            } else {
+                usable = TRUE;
+            }
+            break;
+        case DW_LLE_startx_length:
+            res = DW_DLV_NO_ENTRY;
+            if (!debug_addr_fail) {
+                res = loc_at_pc_debug_addr(dbg,cucontext,
+                    val1,&lopc_cooked,error);
+            }
+            if (res != DW_DLV_OK) {
+                debug_addr_fail = TRUE;
+            } else {
+                highpc_cooked = lopc_cooked + val2;
+                usable = TRUE;
+            }
+            break;
+        case DW_LLE_offset_pair:
+            if (!base_address_fail) {
+                lopc_cooked = val1 + baseaddress;
+                highpc_cooked = val2 + baseaddress;
+                usable = TRUE;
+            }
+            break;
+        case DW_LLE_base_address:
+            baseaddress = val1;
+            base_address_fail = FALSE;
+            break;
+        case DW_LLE_start_end:
+            lopc_cooked = val1;
+            highpc_cooked = val2;
+            usable = TRUE;
+            break;
+        case DW_LLE_start_length:
+            lopc_cooked = val1;
+            highpc_cooked = val1 + val2;
+            usable = TRUE;
+            break;
+        default:
+            break;
+        }
+        if ((usable && pc >= lopc_cooked && pc < highpc_cooked) ||
+            (code == DW_LLE_default_location && !have_default)) {
+            memset(&match->lp_block,0,sizeof(match->lp_block));
+            match->lp_block.bl_len = opsblocksize;
+            match->lp_block.bl_data = ops;
+            match->lp_block.bl_kind = llhead->ll_kind;
+            match->lp_block.bl_section_offset = opsoffset;
+            match->lp_block.bl_locdesc_offset = dataoffset;
+            match->lp_lle_value = code;
+            match->lp_rawlow = val1;
+            match->lp_rawhigh = val2;
+            match->lp_lopc = lopc_cooked;
+            match->lp_highpc = highpc_cooked;
+            match->lp_entrylen = entrylen;
+            if (code != DW_LLE_default_location) {
+                return DW_DLV_OK;
+            }
+            have_default = TRUE;
+        }
+        data += entrylen;
+        dataoffset += entrylen;
+    }
+}
+
+/*  New October 2026.
+    Like dwarf_get_loclist_c() but the returned head
+    holds just the one entry of the list covering pc,
+    index zero.  Entries are walked in the section
+    bytes and only the expression of the entry
+    returned is decoded.  A location expression
+    (not a list) covers every pc.
+    Returns DW_DLV_NO_ENTRY if no entry covers pc. */
+int
+dwarf_get_loclist_at_pc(Dwarf_Attribute attr,
+    Dwarf_Addr        pc,
+    Dwarf_Loc_Head_c *ll_header_out,
+    Dwarf_Locdesc_c  *locdesc_out,
+    Dwarf_Error      *error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Half form = 0;
+    Dwarf_CU_Context cucontext = 0;
+    Dwarf_Loc_Head_c llhead = 0;
+    Dwarf_Locdesc_c llbuf = 0;
+    struct Dwarf_Loc_At_Pc_s match;
+    int lkind = 0;
+    int res = 0;
+
+    res = _dwarf_setup_loc(attr, &dbg,&cucontext, &form, error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    lkind = determine_location_lkind(cucontext->cc_version_stamp,
+        form, attr->ar_attribute, cucontext->cc_is_dwo);
+    if (lkind == DW_LKIND_unknown) {
+        unknown_location_lkind_error(dbg,
+            cucontext->cc_version_stamp,form,
+            attr->ar_attribute,cucontext->cc_is_dwo,error);
+        return DW_DLV_ERROR;
+    }
+    llhead = (Dwarf_Loc_Head_c)
+        _dwarf_get_alloc(dbg, DW_DLA_LOC_HEAD_C, 1);
+    if (!llhead) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return (DW_DLV_ERROR);
+    }
+    llhead->ll_cuversion = cucontext->cc_version_stamp;
+    llhead->ll_kind = lkind;
+    llhead->ll_attrnum = attr->ar_attribute;
+    llhead->ll_attrform = form;
+    llhead->ll_dbg = dbg;
+    llhead->ll_address_size = cucontext->cc_address_size;
+    llhead->ll_offset_size = cucontext->cc_length_size;
+    llhead->ll_context = cucontext;
+    llhead->ll_at_loclists_base_present =
+        cucontext->cc_loclists_base_present;
+    llhead->ll_at_loclists_base =  cucontext->cc_loclists_base;
+    llhead->ll_cu_base_address_present = cucontext->cc_low_pc_present;
+    llhead->ll_cu_base_address = cucontext->cc_low_pc;
+    llhead->ll_cu_addr_base = cucontext->cc_addr_base;
+    llhead->ll_cu_addr_base_present =
+        cucontext->cc_addr_base_present;
+
+    if (lkind == DW_LKIND_expression) {
+        res = _dwarf_original_expression_build(dbg,
+            llhead, attr, error);
+        if (res != DW_DLV_OK) {
+            dwarf_loc_head_c_dealloc(llhead);
+            return res;
+        }
+        *ll_header_out = llhead;
+        *locdesc_out = llhead->ll_locdesc;
+        return DW_DLV_OK;
+    }
+
+    memset(&match,0,sizeof(match));
+    if (lkind == DW_LKIND_loclist ||
+        lkind == DW_LKIND_GNU_exp_list) {
+        /*  The head points into .debug_loc till it
+            is dealloc'd, so keep that section loaded. */
+        _dwarf_pin_section(&dbg->de_debug_loc);
+        llhead->ll_pinned_section = &dbg->de_debug_loc;
+        if (lkind == DW_LKIND_loclist) {
+            res = loc_at_pc_original(dbg,llhead,attr,pc,
+                &match,error);
+        } else {
+            res = loc_at_pc_gnu(dbg,llhead,attr,pc,
+                &match,error);
+        }
+    } else {
+        res = loc_at_pc_loclists(dbg,llhead,attr,pc,
+            &match,error);
+    }
+    if (res != DW_DLV_OK) {
+        dwarf_loc_head_c_dealloc(llhead);
+        return res;
+    }
+
+    llbuf = (Dwarf_Locdesc_c)
+        _dwarf_get_alloc(dbg, DW_DLA_LOCDESC_C, 1);
+    if (!llbuf) {
+        dwarf_loc_head_c_dealloc(llhead);
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return (DW_DLV_ERROR);
+    }
+    llhead->ll_locdesc = llbuf;
+    llhead->ll_locdesc_count = 1;
+    llhead->ll_bytes_total = match.lp_entrylen;
+    res = _dwarf_fill_in_locdesc_op_c(dbg,
+        0,
+        llhead,
+        &match.lp_block,
+        llhead->ll_address_size,
+        llhead->ll_offset_size,
+        llhead->ll_cuversion,
+        match.lp_rawlow,
+        match.lp_rawhigh,
+        match.lp_lle_value,
+        error);
+    if (res != DW_DLV_OK) {
+        dwarf_loc_head_c_dealloc(llhead);
+        return res;
+    }
+    llbuf->ld_lle_value = match.lp_lle_value;
+    llbuf->ld_lopc = match.lp_lopc;
+    llbuf->ld_highpc = match.lp_highpc;
+    if (lkind == DW_LKIND_loclists) {
+        llbuf->ld_entrylen = match.lp_entrylen;
+        llbuf->ld_opsblock = match.lp_block;
+    }
+    *ll_header_out = llhead;
+    *locdesc_out = llbuf;
+    return DW_DLV_OK;
+}
+
 /*  An interface giving us no cu context!
     This is not going to be quite right. */
 int
@@ -2292,6 +2789,11 @@ dwarf_loclist_from_expr_c(Dwarf_Debug dbg,
     llhead->ll_context = 0; /* Not available! */
     llhead->ll_dbg = dbg;
     llhead->ll_kind = DW_LKIND_expression;
+    /*  No CU context, so as the caller says.
+        dwarf_expr_compile() reads these. */
+    llhead->ll_cuversion = dwarf_version;
+    llhead->ll_address_size = address_size;
+    llhead->ll_offset_size = offset_size;
 
     /*  An empty location description (block length 0)
         means the code generator emitted no variable,
@@ -207,6 +207,10 @@ struct Dwarf_Locdesc_c_s {
     /* Section (not CU) offset where loc-expr begins*/
     Dwarf_Unsigned   ld_section_offset;
 
+    /*  Byte length of the loc-expr. Lets dwarf_expr_compile()
+        recognize a DW_OP_bra or DW_OP_skip to the end. */
+    Dwarf_Unsigned   ld_expr_len;
+
     /* Section (not CU) offset where location descr begins*/
     Dwarf_Unsigned   ld_locdesc_offset;
 
@@ -267,6 +271,10 @@ struct Dwarf_Loc_Head_c_s {
     Dwarf_Small    * ll_llepointer;
     Dwarf_Unsigned   ll_llearea_offset;
     Dwarf_Small    * ll_end_data_area;
+
+    /*  Non-null if this head pinned a section
+        (see _dwarf_pin_section()). New October 2026. */
+    struct Dwarf_Section_s *ll_pinned_section;
 };
 
 int _dwarf_fill_in_locdesc_op_c(Dwarf_Debug dbg,
@@ -291,6 +299,31 @@ int _dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
     Dwarf_Loc_Head_c llhead,
     Dwarf_Error *error);
 
+/*  Sets up llhead for attr, a DWARF5 loclist, as
+    _dwarf_loclists_fill_in_lle_head() does but
+    reads no entries.  ll_llepointer is the first. */
+int _dwarf_loclists_head_setup(Dwarf_Debug dbg,
+    Dwarf_Attribute attr,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Error *error);
+
+/*  Reads the one .debug_loclists entry at data.
+    *ops and *opsblocksize are the counted location
+    description of the entry, if it has one. */
+int _dwarf_read_single_lle_entry(Dwarf_Debug dbg,
+    Dwarf_Small    *data,
+    Dwarf_Unsigned  dataoffset,
+    Dwarf_Small    *enddata,
+    unsigned        address_size,
+    unsigned       *bytes_count_out,
+    unsigned       *entry_kind,
+    Dwarf_Unsigned *entry_operand1,
+    Dwarf_Unsigned *entry_operand2,
+    Dwarf_Unsigned *opsblocksize,
+    Dwarf_Unsigned *opsoffset,
+    Dwarf_Small   **ops,
+    Dwarf_Error    *err);
+
 int _dwarf_loclists_expression_build(Dwarf_Debug dbg,
     Dwarf_Attribute attr,
     Dwarf_Loc_Head_c* llhead,
@@ -317,6 +350,42 @@ int _dwarf_read_loc_expr_op(Dwarf_Debug dbg,
     Dwarf_Error * error);
 void _dwarf_free_loclists_head_content(Dwarf_Loc_Head_c head);
 
+/*  A compiled DWARF expression, see dwarf_expr_compile().
+    Operators are normalized (DW_OP_lit*, DW_OP_const*,
+    DW_OP_addr and DW_OP_addrx all become DW_OP_constu,
+    DW_OP_reg* becomes DW_OP_regx, DW_OP_breg* becomes
+    DW_OP_bregx) and branch operands are op indexes,
+    so evaluation never decodes bytes. */
+struct Dwarf_Expr_Op_s {
+    Dwarf_Small    eo_atom;
+    Dwarf_Unsigned eo_operand1;
+    Dwarf_Unsigned eo_operand2;
+};
+
+struct Dwarf_Expr_Program_s {
+    Dwarf_Debug    ep_dbg;
+
+    /*  The cache key. ep_section_offset is the
+        ld_section_offset of the loc-expr. */
+    Dwarf_Small    ep_kind;
+    Dwarf_Bool     ep_is_info;
+    Dwarf_Unsigned ep_section_offset;
+
+    /*  TRUE if owned by the dbg cache,
+        FALSE if dwarf_expr_program_dealloc() must free it. */
+    Dwarf_Bool     ep_cached;
+
+    Dwarf_Half     ep_address_size;
+    Dwarf_Unsigned ep_op_count;
+    struct Dwarf_Expr_Op_s *ep_ops;
+
+    /*  Copies of DW_OP_implicit_value bytes.  The section
+        data may be unloaded after compilation. */
+    Dwarf_Small   *ep_implicit_data;
+};
+
+void _dwarf_expr_program_cache_destroy(Dwarf_Debug dbg);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
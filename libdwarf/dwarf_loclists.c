@@ -110,8 +110,8 @@ counted_loc_descr(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-static int
-read_single_lle_entry(Dwarf_Debug dbg,
+int
+_dwarf_read_single_lle_entry(Dwarf_Debug dbg,
     Dwarf_Small    *data,
     Dwarf_Unsigned  dataoffset,
     Dwarf_Small    *enddata,
@@ -161,7 +161,7 @@ read_single_lle_entry(Dwarf_Debug dbg,
             dbg,err,enddata);
         count += leblen;
         res = counted_loc_descr(dbg,data,enddata,
-            dataoffset,
+            dataoffset+count,
             &loc_ops_overall_size,
             &loc_ops_count_len,
             &loc_ops_len,
@@ -180,7 +180,7 @@ read_single_lle_entry(Dwarf_Debug dbg,
         int res = 0;
 
         res = counted_loc_descr(dbg,data,enddata,
-            dataoffset,
+            dataoffset+count,
             &loc_ops_overall_size,
             &loc_ops_count_len,
             &loc_ops_len,
@@ -213,7 +213,7 @@ read_single_lle_entry(Dwarf_Debug dbg,
         data += address_size;
         count += address_size;
         res = counted_loc_descr(dbg,data,enddata,
-            dataoffset,
+            dataoffset+count,
             &loc_ops_overall_size,
             &loc_ops_count_len,
             &loc_ops_len,
@@ -238,7 +238,7 @@ read_single_lle_entry(Dwarf_Debug dbg,
             dbg,err,enddata);
         count += leblen;
         res = counted_loc_descr(dbg,data,enddata,
-            dataoffset,
+            dataoffset+count,
             &loc_ops_overall_size,
             &loc_ops_count_len,
             &loc_ops_len,
@@ -775,7 +775,7 @@ int dwarf_get_loclist_lle(
     }
     con = dbg->de_loclists_context[contextnumber];
     address_size = con->lc_address_size;
-    res = read_single_lle_entry(dbg,
+    res = _dwarf_read_single_lle_entry(dbg,
         data,entry_offset,enddata,
         address_size, entrylen,
         entry_kind, entry_operand1, entry_operand2,
@@ -971,7 +971,7 @@ build_array_of_lle(Dwarf_Debug dbg,
         Dwarf_Block_c eops;
 
         memset(&eops,0,sizeof(eops));
-        res = read_single_lle_entry(dbg,
+        res = _dwarf_read_single_lle_entry(dbg,
             data,dataoffset, enddata,
             address_size,&entrylen,
             &code,&val1, &val2,
@@ -997,6 +997,7 @@ build_array_of_lle(Dwarf_Debug dbg,
         e->ld_opsblock = eops;
         bytescounttotal += entrylen;
         data += entrylen;
+        dataoffset += entrylen;
         if (code == DW_LLE_end_of_list) {
             done = TRUE;
             break;
@@ -1150,7 +1151,7 @@ build_array_of_lle(Dwarf_Debug dbg,
             &ldc->ld_opsblock,
             address_size, offset_size,
             rctx->ll_cuversion,
-            ldc->ld_lopc, ldc->ld_highpc,
+            ldc->ld_rawlow, ldc->ld_rawhigh,
             ldc->ld_lle_value,
             error);
         if (res != DW_DLV_OK) {
@@ -1161,12 +1162,11 @@ build_array_of_lle(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-/*  Build a head with all the relevent Entries
-    attached, all the locdescs and for each such,
-    all its expression operators.
-*/
+/*  Finds the loclists context and the start of the
+    loclist of attr and records them in llhead.
+    Reads no entries. */
 int
-_dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
+_dwarf_loclists_head_setup(Dwarf_Debug dbg,
     Dwarf_Attribute attr,
     Dwarf_Loc_Head_c llhead,
     Dwarf_Error         *error)
@@ -1289,7 +1289,25 @@ _dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
     llhead->ll_llearea_offset = lle_global_offset;
     llhead->ll_llepointer = lle_global_offset +
         dbg->de_debug_loclists.dss_data;
+    return DW_DLV_OK;
+}
 
+/*  Build a head with all the relevent Entries
+    attached, all the locdescs and for each such,
+    all its expression operators.
+*/
+int
+_dwarf_loclists_fill_in_lle_head(Dwarf_Debug dbg,
+    Dwarf_Attribute attr,
+    Dwarf_Loc_Head_c llhead,
+    Dwarf_Error         *error)
+{
+    int res = 0;
+
+    res = _dwarf_loclists_head_setup(dbg,attr,llhead,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
     res = build_array_of_lle(dbg,llhead,error);
     if (res != DW_DLV_OK) {
         return res;
@@ -1363,6 +1381,10 @@ _dwarf_free_loclists_head_content(Dwarf_Loc_Head_c head)
         head->ll_locdesc = 0;
         head->ll_locdesc_count = 0;
     }
+    if (head->ll_pinned_section) {
+        _dwarf_unpin_section(head->ll_pinned_section);
+        head->ll_pinned_section = 0;
+    }
 }
 
 /*  dwarf_alloc calls this on dealloc. head is freed there
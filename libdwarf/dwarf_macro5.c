@@ -41,6 +41,10 @@
 #include "dwarf_error.h"
 #include "dwarf_util.h"
 #include "dwarf_macro5.h"
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* For uintptr_t */
+#endif /* HAVE_STDINT_H */
+#include "dwarf_tsearch.h"
 
 #define TRUE 1
 #define FALSE 0
@@ -97,6 +101,11 @@ static int _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
     Dwarf_CU_Context cu_context,
     Dwarf_Error * error);
 
+static int get_macro_unit(Dwarf_Debug dbg,
+    Dwarf_Unsigned offset,
+    struct Dwarf_Macro_Unit_s **unit_out,
+    Dwarf_Error * error);
+
 static int _dwarf_internal_macro_context(Dwarf_Die die,
     Dwarf_Bool offset_specified,
     Dwarf_Unsigned offset,
@@ -362,7 +371,8 @@ _dwarf_get_macro_ops_count_internal(Dwarf_Macro_Context macro_context,
             if(build_ops_array) {
                 curopsentry->mo_opcode = op;
                 curopsentry->mo_form = ourform;
-                curopsentry->mo_data = mdata;
+                curopsentry->mo_data_offset = mdata -
+                    macro_context->mc_macro_header;
             }
             mdata += forms_length;
         } else {
@@ -408,9 +418,8 @@ dwarf_get_macro_op(Dwarf_Macro_Context macro_context,
     curop = macro_context->mc_ops + op_number;
 
     /*  ASSERT: *op_start_section_offset ==
-        (curop->mo_data -1) - dbg->de_debug_macro.dss_data  */
-    *op_start_section_offset =
-        ((curop->mo_data -1) - macro_context->mc_macro_header) +
+        (op data - 1) - dbg->de_debug_macro.dss_data  */
+    *op_start_section_offset = (curop->mo_data_offset -1) +
         macro_context->mc_section_offset;
     *macro_operator = curop->mo_opcode;
     if (curop->mo_form) {
@@ -462,7 +471,7 @@ dwarf_get_macro_defundef(Dwarf_Macro_Context macro_context,
     macop = curop->mo_opcode;
     startptr = macro_context->mc_macro_header;
     endptr = startptr + macro_context->mc_total_length;
-    mdata = curop->mo_data;
+    mdata = macro_context->mc_macro_header + curop->mo_data_offset;
     lformscount = curop->mo_form->mf_formcount;
     if (lformscount != 2) {
         /*_dwarf_error(dbg, error,DW_DLE_MACRO_OPCODE_FORM_BAD);*/
@@ -733,7 +742,7 @@ dwarf_get_macro_startend_file(Dwarf_Macro_Context macro_context,
 
     curop = macro_context->mc_ops + op_number;
     macop = curop->mo_opcode;
-    mdata = curop->mo_data;
+    mdata = macro_context->mc_macro_header + curop->mo_data_offset;
     if (macop != DW_MACRO_start_file && macop != DW_MACRO_end_file) {
         return DW_DLV_NO_ENTRY;
     }
@@ -836,7 +845,7 @@ dwarf_get_macro_import(Dwarf_Macro_Context macro_context,
     }
     curop = macro_context->mc_ops + op_number;
     macop = curop->mo_opcode;
-    mdata = curop->mo_data;
+    mdata = macro_context->mc_macro_header + curop->mo_data_offset;
     if (macop != DW_MACRO_import && macop != DW_MACRO_import_sup) {
         return DW_DLV_NO_ENTRY;
     }
@@ -922,6 +931,8 @@ read_operands_table(Dwarf_Macro_Context macro_context,
     Dwarf_Small operand_table_count = 0;
     unsigned i = 0;
     struct Dwarf_Macro_Forms_s *curformentry = 0;
+    Dwarf_Unsigned all_forms_count = 0;
+    Dwarf_Small *formbytes_copy = 0;
     Dwarf_Debug dbg = 0;
     Dwarf_Byte_Ptr startptr = 0;
     Dwarf_Byte_Ptr endptr = 0;
@@ -974,18 +985,23 @@ read_operands_table(Dwarf_Macro_Context macro_context,
         }
         /* The 1 ubyte forms follow. Step past them. */
         macro_data += formcount;
+        all_forms_count += formcount;
     }
     /* reset for reread. */
     macro_data = table_data_start;
-    /* allocate table */
+    /*  allocate table, with the form bytes copied
+        after it so no pointer into .debug_macro
+        is kept. */
     macro_context->mc_opcode_forms =  (struct Dwarf_Macro_Forms_s *)
-        calloc(operand_table_count,
-            sizeof(struct Dwarf_Macro_Forms_s));
+        calloc(1,operand_table_count *
+            sizeof(struct Dwarf_Macro_Forms_s) + all_forms_count);
     macro_context->mc_opcode_count = operand_table_count;
     if(!macro_context->mc_opcode_forms) {
         _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
         return DW_DLV_ERROR;
     }
+    formbytes_copy = (Dwarf_Small *)(macro_context->mc_opcode_forms +
+        operand_table_count);
 
     curformentry = macro_context->mc_opcode_forms;
     for (i = 0; i < operand_table_count; ++i,++curformentry) {
@@ -1013,7 +1029,9 @@ read_operands_table(Dwarf_Macro_Context macro_context,
             _dwarf_error(dbg, error, DW_DLE_MACRO_OFFSET_BAD);
             return (DW_DLV_ERROR);
         }
-        curformentry->mf_formbytes = macro_data;
+        memcpy(formbytes_copy,macro_data,formcount);
+        curformentry->mf_formbytes = formbytes_copy;
+        formbytes_copy += formcount;
         macro_data += formcount;
         if (opcode_number  > DW_MACRO_undef_strx ) {
             Dwarf_Half k = 0;
@@ -1131,6 +1149,7 @@ _dwarf_internal_macro_context(Dwarf_Die die,
 
     const char *comp_dir = 0;
     const char *comp_name = 0;
+    struct Dwarf_Macro_Unit_s *unit = 0;
 
     /*  ***** BEGIN CODE ***** */
     if (error != NULL) {
@@ -1168,11 +1187,21 @@ _dwarf_internal_macro_context(Dwarf_Die die,
     } else {
         macro_offset = offset_in;
     }
-    lres = dwarf_srcfiles(die,&srcfiles,&srcfiles_count, error);
-    if (lres == DW_DLV_ERROR) {
+    lres = get_macro_unit(dbg,macro_offset,&unit,error);
+    if (lres != DW_DLV_OK) {
         dwarf_dealloc(dbg,macro_attr,DW_DLA_ATTR);
         return lres;
     }
+    /*  The line table file names are only needed to name
+        DW_MACRO_start_file files, and imported units
+        (common headers) seldom have any.  */
+    if (unit->mu_has_start_file) {
+        lres = dwarf_srcfiles(die,&srcfiles,&srcfiles_count, error);
+        if (lres == DW_DLV_ERROR) {
+            dwarf_dealloc(dbg,macro_attr,DW_DLA_ATTR);
+            return lres;
+        }
+    }
     lres = _dwarf_internal_get_die_comp_dir(die, &comp_dir,
         &comp_name,error);
     if (lres == DW_DLV_ERROR) {
@@ -1232,18 +1261,59 @@ _dwarf_internal_macro_context(Dwarf_Die die,
     return lres;
 }
 
+static DW_TSHASHTYPE
+macro_unit_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Macro_Unit_s *u = keyp;
+
+    return (DW_TSHASHTYPE)u->mu_offset;
+}
+
 static int
-_dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
-    Dwarf_Unsigned offset,
-    Dwarf_Unsigned  * version_out,
-    Dwarf_Macro_Context * macro_context_out,
-    Dwarf_Unsigned      * macro_ops_count_out,
-    Dwarf_Unsigned      * macro_ops_data_length,
-    char **srcfiles,
-    Dwarf_Signed srcfilescount,
-    const char *comp_dir,
-    const char *comp_name,
-    Dwarf_CU_Context cu_context,
+macro_unit_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Macro_Unit_s *lu = l;
+    const struct Dwarf_Macro_Unit_s *ru = r;
+
+    if (lu->mu_offset < ru->mu_offset) {
+        return -1;
+    }
+    if (lu->mu_offset > ru->mu_offset) {
+        return 1;
+    }
+    return 0;
+}
+
+static void
+macro_unit_free(struct Dwarf_Macro_Unit_s *u)
+{
+    free(u->mu_template.mc_ops);
+    free(u->mu_template.mc_opcode_forms);
+    free(u->mu_flat);
+    free(u);
+}
+
+static void
+macro_unit_free_node(void *nodep)
+{
+    macro_unit_free((struct Dwarf_Macro_Unit_s *)nodep);
+}
+
+void
+_dwarf_macro_unit_cache_destroy(Dwarf_Debug dbg)
+{
+    if (dbg->de_macro_units) {
+        dwarf_tdestroy(dbg->de_macro_units,macro_unit_free_node);
+        dbg->de_macro_units = 0;
+    }
+}
+
+/*  Reads the header and operators of the macro unit
+    at offset into u->mu_template.  */
+static int
+decode_macro_unit(Dwarf_Debug dbg,
+    Dwarf_Unsigned macro_offset,
+    struct Dwarf_Macro_Unit_s *u,
     Dwarf_Error * error)
 {
     Dwarf_Unsigned line_table_offset = 0;
@@ -1257,26 +1327,15 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
     Dwarf_Small *section_base = 0;
     Dwarf_Small *section_end = 0;
     Dwarf_Unsigned optablesize = 0;
-    Dwarf_Unsigned macro_offset = offset;
+    Dwarf_Unsigned i = 0;
     int res = 0;
-    Dwarf_Macro_Context macro_context = 0;
+    Dwarf_Macro_Context macro_context = &u->mu_template;
     Dwarf_Bool build_ops_array = FALSE;
 
-    res = _dwarf_load_section(dbg, &dbg->de_debug_macro,error);
-    if (res != DW_DLV_OK) {
-        dealloc_macro_srcfiles(srcfiles,srcfilescount);
-        return res;
-    }
-    if (!dbg->de_debug_macro.dss_size) {
-        dealloc_macro_srcfiles(srcfiles,srcfilescount);
-        return (DW_DLV_NO_ENTRY);
-    }
-
     section_base = dbg->de_debug_macro.dss_data;
     section_size = dbg->de_debug_macro.dss_size;
     /*  The '3'  ensures the header initial bytes present too. */
     if ((3+macro_offset) >= section_size) {
-        dealloc_macro_srcfiles(srcfiles,srcfilescount);
         _dwarf_error(dbg, error, DW_DLE_MACRO_OFFSET_BAD);
         return (DW_DLV_ERROR);
     }
@@ -1284,31 +1343,18 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
     macro_data = macro_header;
     section_end = section_base +section_size;
 
-
-    macro_context = (Dwarf_Macro_Context)
-        _dwarf_get_alloc(dbg,DW_DLA_MACRO_CONTEXT,1);
-    if (!macro_context) {
-        dealloc_macro_srcfiles(srcfiles,srcfilescount);
-        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
-
     if ((section_base + DWARF_HALF_SIZE + sizeof(Dwarf_Small)) >                     section_end ) {
-        dealloc_macro_srcfiles(srcfiles,srcfilescount);
-        dwarf_dealloc_macro_context(macro_context);
         _dwarf_error(dbg, error, DW_DLE_MACRO_OFFSET_BAD);
         return DW_DLV_ERROR;
     }
-    /* Note here so if error return we get these freed eventually. */
-    macro_context->mc_srcfiles = srcfiles;
-    macro_context->mc_srcfiles_count = srcfilescount;
-    macro_context->mc_cu_context =  cu_context;
+    u->mu_offset = macro_offset;
+    macro_context->mc_sentinel = 0xada;
+    macro_context->mc_dbg = dbg;
 
     res = _dwarf_read_unaligned_ck_wrapper(dbg,
         &version,macro_data,DWARF_HALF_SIZE,section_end,
         error);
     if (res != DW_DLV_OK) {
-        dwarf_dealloc_macro_context(macro_context);
         return res;
     }
     macro_data +=  DWARF_HALF_SIZE;
@@ -1316,18 +1362,14 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
         &flags,macro_data,sizeof(Dwarf_Small),section_end,
         error);
     if (res != DW_DLV_OK) {
-        dwarf_dealloc_macro_context(macro_context);
         return res;
     }
     macro_data += sizeof(Dwarf_Small);
 
-    macro_context->mc_at_comp_dir = comp_dir;
-    macro_context->mc_at_name = comp_name;
     macro_context->mc_macro_header = macro_header;
     macro_context->mc_section_offset = macro_offset;
     macro_context->mc_version_number = version;
     macro_context->mc_flags = flags;
-    macro_context->mc_dbg = dbg;
     macro_context->mc_offset_size_flag =
         flags& MACRO_OFFSET_SIZE_FLAG?TRUE:FALSE;
     macro_context->mc_debug_line_offset_flag =
@@ -1339,7 +1381,6 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
     if (macro_context->mc_debug_line_offset_flag) {
         cur_offset = (offset_size+ macro_data) - section_base;
         if (cur_offset >= section_size) {
-            dwarf_dealloc_macro_context(macro_context);
             _dwarf_error(dbg, error, DW_DLE_MACRO_OFFSET_BAD);
             return (DW_DLV_ERROR);
         }
@@ -1348,7 +1389,6 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
             offset_size,section_end,
             error);
         if (res != DW_DLV_OK) {
-            dwarf_dealloc_macro_context(macro_context);
             return res;
         }
         macro_data += offset_size;
@@ -1363,7 +1403,6 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
             &optablesize,
             error);
         if (res != DW_DLV_OK) {
-            dwarf_dealloc_macro_context(macro_context);
             return res;
         }
     }
@@ -1377,7 +1416,6 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
         build_ops_array,
         error);
     if (res != DW_DLV_OK) {
-        dwarf_dealloc_macro_context(macro_context);
         return res;
     }
     build_ops_array = TRUE;
@@ -1385,12 +1423,143 @@ _dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
         build_ops_array,
         error);
     if (res != DW_DLV_OK) {
-        dwarf_dealloc_macro_context(macro_context);
         return res;
     }
+    for (i = 0; i < macro_context->mc_macro_ops_count; ++i) {
+        switch(macro_context->mc_ops[i].mo_opcode) {
+        case DW_MACRO_start_file:
+            u->mu_has_start_file = TRUE;
+            break;
+        case DW_MACRO_define_strx:
+        case DW_MACRO_undef_strx:
+            u->mu_has_strx = TRUE;
+            break;
+        default:
+            break;
+        }
+    }
+    /*  The unit keeps offsets only, see
+        point_at_macro_data(). */
+    macro_context->mc_macro_header = 0;
+    macro_context->mc_macro_ops = 0;
+    return DW_DLV_OK;
+}
+
+/*  Points a copy of a unit's mu_template at the
+    .debug_macro data now loaded.  The caller has
+    loaded and pinned the section. */
+static void
+point_at_macro_data(Dwarf_Debug dbg,
+    Dwarf_Macro_Context mc)
+{
+    mc->mc_macro_header = dbg->de_debug_macro.dss_data +
+        mc->mc_section_offset;
+    mc->mc_macro_ops = mc->mc_macro_header +
+        mc->mc_macro_header_length;
+}
+
+/*  Finds the decoded macro unit at offset, decoding
+    and caching it on first use. */
+static int
+get_macro_unit(Dwarf_Debug dbg,
+    Dwarf_Unsigned offset,
+    struct Dwarf_Macro_Unit_s **unit_out,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Macro_Unit_s key;
+    struct Dwarf_Macro_Unit_s *u = 0;
+    void *entry = 0;
+    int res = 0;
+
+    res = _dwarf_load_section(dbg, &dbg->de_debug_macro,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!dbg->de_debug_macro.dss_size) {
+        return (DW_DLV_NO_ENTRY);
+    }
+    if (!dbg->de_macro_units) {
+        dwarf_initialize_search_hash(&dbg->de_macro_units,
+            macro_unit_hashfunc,0);
+        if (!dbg->de_macro_units) {
+            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+    }
+    key.mu_offset = offset;
+    dbg->de_perf_counters.pc_tsearch_ops++;
+    entry = dwarf_tfind(&key,&dbg->de_macro_units,macro_unit_compare);
+    if (entry) {
+        *unit_out = *(struct Dwarf_Macro_Unit_s **)entry;
+        return DW_DLV_OK;
+    }
+
+    u = calloc(1,sizeof(struct Dwarf_Macro_Unit_s));
+    if (!u) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    res = decode_macro_unit(dbg,offset,u,error);
+    if (res != DW_DLV_OK) {
+        macro_unit_free(u);
+        return res;
+    }
+    dbg->de_perf_counters.pc_tsearch_ops++;
+    entry = dwarf_tsearch(u,&dbg->de_macro_units,macro_unit_compare);
+    if (!entry) {
+        macro_unit_free(u);
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    *unit_out = u;
+    return DW_DLV_OK;
+}
+
+static int
+_dwarf_internal_macro_context_by_offset(Dwarf_Debug dbg,
+    Dwarf_Unsigned offset,
+    Dwarf_Unsigned  * version_out,
+    Dwarf_Macro_Context * macro_context_out,
+    Dwarf_Unsigned      * macro_ops_count_out,
+    Dwarf_Unsigned      * macro_ops_data_length,
+    char **srcfiles,
+    Dwarf_Signed srcfilescount,
+    const char *comp_dir,
+    const char *comp_name,
+    Dwarf_CU_Context cu_context,
+    Dwarf_Error * error)
+{
+    struct Dwarf_Macro_Unit_s *unit = 0;
+    int res = 0;
+    Dwarf_Macro_Context macro_context = 0;
+
+    res = get_macro_unit(dbg,offset,&unit,error);
+    if (res != DW_DLV_OK) {
+        dealloc_macro_srcfiles(srcfiles,srcfilescount);
+        return res;
+    }
+    macro_context = (Dwarf_Macro_Context)
+        _dwarf_get_alloc(dbg,DW_DLA_MACRO_CONTEXT,1);
+    if (!macro_context) {
+        dealloc_macro_srcfiles(srcfiles,srcfilescount);
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    *macro_context = unit->mu_template;
+    macro_context->mc_ops_borrowed = TRUE;
+    /*  get_macro_unit() (re)loaded .debug_macro. */
+    _dwarf_pin_section(&dbg->de_debug_macro);
+    macro_context->mc_pinned_section = &dbg->de_debug_macro;
+    point_at_macro_data(dbg,macro_context);
+    macro_context->mc_srcfiles = srcfiles;
+    macro_context->mc_srcfiles_count = srcfilescount;
+    macro_context->mc_cu_context =  cu_context;
+    macro_context->mc_at_comp_dir = comp_dir;
+    macro_context->mc_at_name = comp_name;
+
     *macro_ops_count_out = macro_context->mc_macro_ops_count;
     *macro_ops_data_length = macro_context->mc_ops_data_length;
-    *version_out = version;
+    *version_out = macro_context->mc_version_number;
     *macro_context_out = macro_context;
     return DW_DLV_OK;
 }
@@ -1542,6 +1711,286 @@ dwarf_dealloc_macro_context(Dwarf_Macro_Context mc)
     dwarf_dealloc(dbg,mc,DW_DLA_MACRO_CONTEXT);
 }
 
+/*  A growable array for dwarf_get_macro_flattened(). */
+struct macro_flat_list_s {
+    struct Dwarf_Macro_Flat_s *fl_entries;
+    Dwarf_Unsigned             fl_count;
+    Dwarf_Unsigned             fl_alloc;
+};
+
+static int
+flat_list_append(Dwarf_Debug dbg,
+    struct macro_flat_list_s *fl,
+    const struct Dwarf_Macro_Flat_s *entries,
+    Dwarf_Unsigned count,
+    Dwarf_Error *error)
+{
+    if (!count) {
+        return DW_DLV_OK;
+    }
+    if (fl->fl_count + count > fl->fl_alloc) {
+        Dwarf_Unsigned newalloc = fl->fl_alloc? fl->fl_alloc*2 : 64;
+        struct Dwarf_Macro_Flat_s *newents = 0;
+
+        while (newalloc < fl->fl_count + count) {
+            newalloc *= 2;
+        }
+        newents = realloc(fl->fl_entries,
+            newalloc * sizeof(struct Dwarf_Macro_Flat_s));
+        if (!newents) {
+            _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
+        fl->fl_entries = newents;
+        fl->fl_alloc = newalloc;
+    }
+    memcpy(fl->fl_entries + fl->fl_count,entries,
+        count * sizeof(struct Dwarf_Macro_Flat_s));
+    fl->fl_count += count;
+    return DW_DLV_OK;
+}
+
+/*  Appends the flattened define/undef list of unit to out.
+    A unit's list is memoized on the unit unless it
+    (or something it imports) uses DW_MACRO_*_strx, whose
+    strings depend on the CU. So each common header unit
+    is walked once no matter how many CUs import it.
+    *cu_dependent_out is set if the list depends on the CU.
+    The caller keeps .debug_macro loaded and pinned. */
+static int
+flatten_macro_unit(Dwarf_Debug dbg,
+    Dwarf_CU_Context cu_context,
+    struct Dwarf_Macro_Unit_s *unit,
+    struct macro_flat_list_s *out,
+    Dwarf_Bool *cu_dependent_out,
+    Dwarf_Error *error)
+{
+    struct macro_flat_list_s local;
+    struct Dwarf_Macro_Context_s mc;
+    Dwarf_Bool cu_dependent = unit->mu_has_strx;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (unit->mu_flat_state == MACRO_FLAT_DONE) {
+        *cu_dependent_out = FALSE;
+        return flat_list_append(dbg,out,unit->mu_flat,
+            unit->mu_flat_count,error);
+    }
+    if (unit->mu_flat_state == MACRO_FLAT_IN_PROGRESS) {
+        _dwarf_error(dbg, error, DW_DLE_MACRO_IMPORT_LOOP);
+        return DW_DLV_ERROR;
+    }
+    memset(&local,0,sizeof(local));
+    /*  A private copy so the string lookups see this CU. */
+    mc = unit->mu_template;
+    mc.mc_cu_context = cu_context;
+    point_at_macro_data(dbg,&mc);
+    unit->mu_flat_state = MACRO_FLAT_IN_PROGRESS;
+    for (i = 0; i < mc.mc_macro_ops_count; ++i) {
+        unsigned op = mc.mc_ops[i].mo_opcode;
+
+        switch(op) {
+        case DW_MACRO_define:
+        case DW_MACRO_undef:
+        case DW_MACRO_define_strp:
+        case DW_MACRO_undef_strp:
+        case DW_MACRO_define_strx:
+        case DW_MACRO_undef_strx:
+        case DW_MACRO_define_sup:
+        case DW_MACRO_undef_sup: {
+            struct Dwarf_Macro_Flat_s fx;
+            Dwarf_Macro_Flat_Entry *fe = &fx.fx_entry;
+            Dwarf_Unsigned index = 0;
+            Dwarf_Unsigned offset = 0;
+            Dwarf_Half forms_count = 0;
+
+            memset(&fx,0,sizeof(fx));
+            res = dwarf_get_macro_defundef(&mc,i,&fe->fe_line,
+                &index,&offset,&forms_count,&fe->fe_string,error);
+            if (res == DW_DLV_ERROR) {
+                unit->mu_flat_state = MACRO_FLAT_NONE;
+                free(local.fl_entries);
+                return res;
+            }
+            if (res == DW_DLV_NO_ENTRY) {
+                /*  A form count other than two.
+                    Not a define or undef we can use. */
+                break;
+            }
+            if (op == DW_MACRO_define || op == DW_MACRO_undef) {
+                /*  The string is in .debug_macro. */
+                fx.fx_string_offset = (const Dwarf_Small *)
+                    fe->fe_string - dbg->de_debug_macro.dss_data;
+                fe->fe_string = 0;
+            }
+            fe->fe_op = (op == DW_MACRO_define ||
+                op == DW_MACRO_define_strp ||
+                op == DW_MACRO_define_strx ||
+                op == DW_MACRO_define_sup)?
+                DW_MACRO_define:DW_MACRO_undef;
+            fe->fe_unit_offset = unit->mu_offset;
+            res = flat_list_append(dbg,&local,&fx,1,error);
+            if (res != DW_DLV_OK) {
+                unit->mu_flat_state = MACRO_FLAT_NONE;
+                free(local.fl_entries);
+                return res;
+            }
+            break;
+        }
+        case DW_MACRO_import: {
+            Dwarf_Unsigned target = 0;
+            struct Dwarf_Macro_Unit_s *imported = 0;
+            Dwarf_Bool dep = FALSE;
+
+            res = dwarf_get_macro_import(&mc,i,&target,error);
+            if (res == DW_DLV_OK) {
+                res = get_macro_unit(dbg,target,&imported,error);
+            }
+            if (res == DW_DLV_OK) {
+                res = flatten_macro_unit(dbg,cu_context,imported,
+                    &local,&dep,error);
+            }
+            if (res != DW_DLV_OK) {
+                unit->mu_flat_state = MACRO_FLAT_NONE;
+                free(local.fl_entries);
+                return res;
+            }
+            if (dep) {
+                cu_dependent = TRUE;
+            }
+            break;
+        }
+        default:
+            /*  start_file, end_file, and import_sup (the
+                supplementary object's .debug_macro is not
+                available here) add no entries. */
+            break;
+        }
+    }
+    res = flat_list_append(dbg,out,local.fl_entries,
+        local.fl_count,error);
+    if (res != DW_DLV_OK || cu_dependent) {
+        unit->mu_flat_state = MACRO_FLAT_NONE;
+        free(local.fl_entries);
+        *cu_dependent_out = cu_dependent;
+        return res;
+    }
+    unit->mu_flat = local.fl_entries;
+    unit->mu_flat_count = local.fl_count;
+    unit->mu_flat_state = MACRO_FLAT_DONE;
+    *cu_dependent_out = FALSE;
+    return DW_DLV_OK;
+}
+
+/*  Makes the array returned by dwarf_get_macro_flattened().
+    Strings in .debug_macro are copied in after the
+    entries so the array does not depend on the section
+    staying loaded. */
+static int
+make_flat_entries(Dwarf_Debug dbg,
+    struct macro_flat_list_s *fl,
+    Dwarf_Macro_Flat_Entry **entries_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Small *macro_data = dbg->de_debug_macro.dss_data;
+    Dwarf_Unsigned string_bytes = 0;
+    Dwarf_Macro_Flat_Entry *entries = 0;
+    char *strings = 0;
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < fl->fl_count; ++i) {
+        struct Dwarf_Macro_Flat_s *fx = fl->fl_entries + i;
+
+        if (!fx->fx_entry.fe_string) {
+            string_bytes += strlen((const char *)macro_data +
+                fx->fx_string_offset) + 1;
+        }
+    }
+    entries = malloc(fl->fl_count * sizeof(Dwarf_Macro_Flat_Entry) +
+        string_bytes);
+    if (!entries) {
+        _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    strings = (char *)(entries + fl->fl_count);
+    for (i = 0; i < fl->fl_count; ++i) {
+        struct Dwarf_Macro_Flat_s *fx = fl->fl_entries + i;
+
+        entries[i] = fx->fx_entry;
+        if (!fx->fx_entry.fe_string) {
+            const char *s = (const char *)macro_data +
+                fx->fx_string_offset;
+            size_t len = strlen(s) + 1;
+
+            memcpy(strings,s,len);
+            entries[i].fe_string = strings;
+            strings += len;
+        }
+    }
+    *entries_out = entries;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_get_macro_flattened(Dwarf_Die cu_die,
+    Dwarf_Macro_Flat_Entry **entries_out,
+    Dwarf_Unsigned *entry_count_out,
+    Dwarf_Error *error)
+{
+    Dwarf_CU_Context cu_context = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Attribute macro_attr = 0;
+    Dwarf_Unsigned macro_offset = 0;
+    struct Dwarf_Macro_Unit_s *unit = 0;
+    struct macro_flat_list_s fl;
+    Dwarf_Bool dep = FALSE;
+    int res = 0;
+
+    CHECK_DIE(cu_die, DW_DLV_ERROR);
+    cu_context = cu_die->di_cu_context;
+    dbg = cu_context->cc_dbg;
+    res = dwarf_attr(cu_die, DW_AT_macros, &macro_attr, error);
+    if (res == DW_DLV_NO_ENTRY) {
+        res = dwarf_attr(cu_die, DW_AT_GNU_macros, &macro_attr, error);
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_global_formref(macro_attr, &macro_offset, error);
+    dwarf_dealloc(dbg,macro_attr,DW_DLA_ATTR);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = get_macro_unit(dbg,macro_offset,&unit,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    /*  String lookups load other sections, which must
+        not evict .debug_macro while we walk it. */
+    _dwarf_pin_section(&dbg->de_debug_macro);
+    memset(&fl,0,sizeof(fl));
+    res = flatten_macro_unit(dbg,cu_context,unit,&fl,&dep,error);
+    if (res == DW_DLV_OK) {
+        if (!fl.fl_count) {
+            res = DW_DLV_NO_ENTRY;
+        } else {
+            res = make_flat_entries(dbg,&fl,entries_out,error);
+        }
+    }
+    _dwarf_unpin_section(&dbg->de_debug_macro);
+    if (res == DW_DLV_OK) {
+        *entry_count_out = fl.fl_count;
+    }
+    free(fl.fl_entries);
+    return res;
+}
+
+void
+dwarf_dealloc_macro_flattened(Dwarf_Macro_Flat_Entry *entries)
+{
+    free(entries);
+}
+
 int
 _dwarf_macro_constructor(Dwarf_Debug dbg, void *m)
 {
@@ -1578,10 +2027,16 @@ _dwarf_macro_destructor(void *m)
     mc->mc_srcfiles_count = 0;
     free((void *)mc->mc_file_path);
     mc->mc_file_path = 0;
-    free(mc->mc_ops);
+    if (!mc->mc_ops_borrowed) {
+        free(mc->mc_ops);
+        free(mc->mc_opcode_forms);
+    }
     mc->mc_ops = 0;
-    free(mc->mc_opcode_forms);
     mc->mc_opcode_forms = 0;
+    if (mc->mc_pinned_section) {
+        _dwarf_unpin_section(mc->mc_pinned_section);
+        mc->mc_pinned_section = 0;
+    }
     memset(mc,0,sizeof(*mc));
     /* Just a recognizable sentinel. For debugging.  No real meaning. */
     mc->mc_sentinel = 0xdeadbeef;
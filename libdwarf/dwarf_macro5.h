@@ -35,7 +35,9 @@ struct Dwarf_Macro_Forms_s {
     /* How many entries in mf_formbytes array. */
     Dwarf_Small         mf_formcount;
 
-    /* Never free these, these are in the object file memory */
+    /*  Never free these. They are static data
+        or (for an operands table in the header) copied
+        into the space of the mc_opcode_forms array. */
     const Dwarf_Small * mf_formbytes;
 };
 
@@ -50,9 +52,12 @@ struct Dwarf_Macro_Operator_s {
 
     struct Dwarf_Macro_Forms_s * mo_form;
 
-    /*  Points at the first byte of the data, meaning
-        it points one-past the macro operation code byte. */
-    Dwarf_Small *    mo_data;
+    /*  Offset from mc_macro_header of the first byte
+        of the data, meaning one-past the macro
+        operation code byte.  An offset, not a pointer,
+        so a cached unit survives .debug_macro being
+        evicted and reloaded. */
+    Dwarf_Unsigned   mo_data_offset;
 };
 
 #define MACRO_OFFSET_SIZE_FLAG 1
@@ -135,8 +140,68 @@ struct Dwarf_Macro_Context_s {
 
     Dwarf_Debug      mc_dbg;
     Dwarf_CU_Context mc_cu_context;
+
+    /*  mc_macro_header and the strings returned point
+        into .debug_macro, which stays pinned while the
+        context exists.  New October 2026. */
+    struct Dwarf_Section_s *mc_pinned_section;
+
+    /*  TRUE if mc_ops and mc_opcode_forms belong to
+        the Dwarf_Macro_Unit_s this context was made from,
+        so the destructor must not free them.
+        New October 2026. */
+    Dwarf_Bool mc_ops_borrowed;
+};
+
+/*  A decoded macro unit, kept in the dwarf_tsearch tree
+    de_macro_units of the Dwarf_Debug keyed by its
+    .debug_macro offset. Every Dwarf_Macro_Context for
+    that offset copies mu_template and borrows its
+    operator arrays, so a unit imported by many CUs
+    is decoded once.  A unit holds no pointer into
+    .debug_macro (mu_template.mc_macro_header and
+    mc_macro_ops are zero), so the section may be
+    evicted while units are cached. New October 2026. */
+#define MACRO_FLAT_NONE        0
+#define MACRO_FLAT_IN_PROGRESS 1
+#define MACRO_FLAT_DONE        2
+
+/*  A memoized dwarf_get_macro_flattened() entry.
+    The string of a DW_MACRO_define or DW_MACRO_undef
+    is in .debug_macro, so for those fx_entry.fe_string
+    is zero and fx_string_offset is the .debug_macro
+    offset of the string. */
+struct Dwarf_Macro_Flat_s {
+    Dwarf_Macro_Flat_Entry fx_entry;
+    Dwarf_Unsigned         fx_string_offset;
+};
+struct Dwarf_Macro_Unit_s {
+    Dwarf_Unsigned mu_offset;
+
+    /*  Header and operators only. No srcfiles, no
+        CU context. Owns mc_ops and mc_opcode_forms. */
+    struct Dwarf_Macro_Context_s mu_template;
+
+    /*  Only a unit with DW_MACRO_start_file needs the
+        CU line table file names. */
+    Dwarf_Bool     mu_has_start_file;
+
+    /*  DW_MACRO_*_strx strings depend on the
+        DW_AT_str_offsets_base of the importing CU,
+        so such a unit (or one importing such a unit)
+        cannot memoize its flattened list. */
+    Dwarf_Bool     mu_has_strx;
+
+    /*  The memoized dwarf_get_macro_flattened()
+        entries for this unit with imports expanded. */
+    int            mu_flat_state;
+    Dwarf_Bool     mu_flat_cu_dependent;
+    Dwarf_Unsigned mu_flat_count;
+    struct Dwarf_Macro_Flat_s *mu_flat;
 };
 
+void _dwarf_macro_unit_cache_destroy(Dwarf_Debug dbg);
+
 
 int _dwarf_macro_constructor(Dwarf_Debug dbg, void *m);
 void _dwarf_macro_destructor(void *m);
@@ -385,6 +385,63 @@ struct Dwarf_Section_s {
         space for libdwarf.  */
     Dwarf_Small     dss_ignore_reloc_group_sec;
     char dss_is_rela;
+
+    /*  Section memory budget support. New October 2026.
+        dss_evictable is set (by dwarf_set_section_memory_budget())
+        for the sections that may be given back.
+        dss_pin_count counts live objects that refer
+        into dss_data (Dwarf_Loc_Head_c, Dwarf_Locdesc,
+        Dwarf_Macro_Context, Dwarf_Str_Offsets_Table),
+        a pinned section is never evicted.
+        dss_pinned_for_life is set once an interface
+        returned a pointer into dss_data that has no
+        dealloc to unpin it.
+        dss_last_use is the de_section_budget tick
+        of the latest _dwarf_load_section() call. */
+    Dwarf_Small     dss_evictable;
+    Dwarf_Small     dss_was_evicted;
+    Dwarf_Small     dss_pinned_for_life;
+    Dwarf_Unsigned  dss_pin_count;
+    Dwarf_Unsigned  dss_last_use;
+    Dwarf_Unsigned  dss_resident_bytes;
+
+    /*  See dwarf_get_section_perf_counters().
+        New October 2026. */
+    Dwarf_Unsigned  dss_load_count;
+    Dwarf_Unsigned  dss_bytes_loaded;
+    Dwarf_Unsigned  dss_bytes_decompressed;
+
+    /*  For .debug_str and .debug_line_str: one past the
+        last NUL byte of dss_data, set by _dwarf_load_section().
+        Any string starting below it is terminated within
+        the section, so _dwarf_check_string_valid()
+        need not scan for the NUL.
+        Zero if not computed or the section has no NUL at all.
+        New October 2026. */
+    Dwarf_Small    *dss_string_limit;
+};
+
+/*  Tracks the section data libdwarf has loaded so
+    a dbg can be held to a memory budget.
+    Only sections marked dss_evictable are ever
+    given back, least-recently-used first, and only
+    their bytes count against sb_budget.
+    sb_bytes_resident counts every loaded section.
+    New October 2026. */
+struct Dwarf_Section_Budget_s {
+    /* Zero means no budget: nothing is evicted. */
+    Dwarf_Unsigned sb_budget;
+    Dwarf_Unsigned sb_tick;
+    Dwarf_Unsigned sb_bytes_resident;
+    Dwarf_Unsigned sb_bytes_resident_peak;
+    Dwarf_Unsigned sb_evictions;
+    Dwarf_Unsigned sb_bytes_evicted;
+    Dwarf_Unsigned sb_reloads;
+    /*  Lets the object access code release its copy
+        of a section's bytes. May be NULL, in which
+        case only libdwarf-malloc'd (decompressed)
+        data can be evicted. */
+    void (*sb_unload_section)(void *obj, Dwarf_Half section_index);
 };
 
 /*  Overview: if next_to_use== first, no error slots are used.
@@ -461,6 +518,9 @@ struct Dwarf_dbg_sect_s {
 */
 #define DWARF_MAX_DEBUG_SECTIONS 50
 #define DWARFSTRING_ALLOC_SIZE   200
+/*  ALLOC_AREA_INDEX_TABLE_MAX, which not every includer
+    of this file sees. dwarf_alloc.c checks they agree. */
+#define DWARF_PERF_ALLOC_TYPES   65
 
 
 /*  All the Dwarf_Debug tied-file info in one place.  */
@@ -722,6 +782,55 @@ struct Dwarf_Debug_s {
         and referenced.*/
     struct Dwarf_Tied_Data_s de_tied_data;
 
+    /*  See dwarf_set_section_memory_budget().
+        New October 2026. */
+    struct Dwarf_Section_Budget_s de_section_budget;
+
+    /*  See dwarf_get_perf_counters(). New October 2026. */
+    Dwarf_Perf_Counters de_perf_counters;
+    /*  See dwarf_get_perf_alloc_count(), indexed by
+        DW_DLA_* value. New October 2026. */
+    Dwarf_Unsigned de_perf_allocs_by_type[DWARF_PERF_ALLOC_TYPES];
+
+    /*  dwarf_tsearch tree of compiled expression programs,
+        see dwarf_expr_compile(). New October 2026. */
+    void * de_expr_programs;
+
+    /*  dwarf_tsearch tree of decoded .debug_macro units,
+        see struct Dwarf_Macro_Unit_s.  The units keep
+        .debug_macro offsets, not pointers, so they
+        survive the section being evicted and reloaded.
+        New October 2026. */
+    void * de_macro_units;
+
+    /*  A .debug_names sidecar file read in by
+        dwarf_debugnames_use_sidecar(), used in place of
+        a missing .debug_names. New October 2026. */
+    struct Dwarf_Dnames_Sidecar_s *de_dnames_sidecar;
+
+    /*  CU address table and per-CU inline trees, see
+        dwarf_inline_frames(). New October 2026. */
+    struct Dwarf_Inline_Index_s *de_inline_index;
+
+    /*  Resolved types and formatted type names, see
+        dwarf_type_info(). New October 2026. */
+    struct Dwarf_Type_Cache_s *de_type_cache;
+
+    /*  Sorted and hashed .debug_pubnames and
+        .debug_gnu_pubnames entries, see
+        dwarf_pubnames_lookup(). New October 2026. */
+    struct Dwarf_Pubnames_Index_s *de_pubnames_index;
+
+    /*  Cooked range lists by list offset, see
+        dwarf_range_cache_set_size(). New October 2026. */
+    struct Dwarf_Range_Cache_s *de_range_cache;
+
+    /*  Working space of _dwarf_exec_frame_instr(), kept
+        so computing a frame row does not allocate.
+        New October 2026. */
+    struct Dwarf_Reg_Rule_s *de_frame_scratch_regs;
+    unsigned de_frame_scratch_count;
+    struct Dwarf_Frame_s *de_frame_state_pool;
 };
 
 /* New style. takes advantage of dwarfstrings capability.
@@ -763,6 +872,12 @@ int _dwarf_load_section(Dwarf_Debug,
     struct Dwarf_Section_s *,
     Dwarf_Error *);
 
+/*  Keep a section resident while an object points into
+    its data. Each pin must be matched by one unpin. */
+void _dwarf_pin_section(struct Dwarf_Section_s *);
+void _dwarf_unpin_section(struct Dwarf_Section_s *);
+void _dwarf_pin_section_for_life(struct Dwarf_Section_s *);
+
 void _dwarf_dealloc_rnglists_context(Dwarf_Debug dbg);
 void _dwarf_dealloc_loclists_context(Dwarf_Debug dbg);
 
@@ -781,12 +896,27 @@ int _dwarf_extract_string_offset_via_str_offsets(Dwarf_Debug dbg,
     Dwarf_Error *error);
 
 
+/*  Like dwarf_attr() but fills in a caller-provided
+    attribute, which is never passed to dwarf_dealloc(). */
+int _dwarf_fill_attr(Dwarf_Die die,
+    Dwarf_Half attr,
+    struct Dwarf_Attribute_s *attrib,
+    Dwarf_Error *error);
+
 int _dwarf_extract_address_from_debug_addr(Dwarf_Debug dbg,
     Dwarf_CU_Context context,
     Dwarf_Unsigned index,
     Dwarf_Addr *addr_out,
     Dwarf_Error *error);
 
+/*  As above, but falls back to the tied object if
+    this object has no .debug_addr. */
+int _dwarf_look_in_local_and_tied_by_index(Dwarf_Debug dbg,
+    Dwarf_CU_Context context,
+    Dwarf_Unsigned index,
+    Dwarf_Addr *addr_out,
+    Dwarf_Error *error);
+
 int _dwarf_get_base_and_size_given_signature(
     Dwarf_CU_Context *context,
     Dwarf_Sig8 *signature_in,
@@ -841,6 +971,8 @@ _dwarf_search_for_signature(Dwarf_Debug dbg,
    Dwarf_Sig8 sig,
    Dwarf_CU_Context *context_out,
    Dwarf_Error *error);
+int _dwarf_tied_record_context(Dwarf_Debug tieddbg,
+   Dwarf_CU_Context context);
 
 
 void _dwarf_tied_destroy_free_node(void *node);
@@ -0,0 +1,492 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  dwarf_pubnames_lookup(): exact and prefix name lookup
+    over .debug_pubnames and .debug_gnu_pubnames.
+    See dwarf_pubnames_index.h for the layout.  The
+    sections are read twice when the index is built,
+    once to size the entry array and string arena and
+    once to fill them, so neither moves once built and
+    no memory is allocated per entry or per lookup. */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include <string.h>
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_global.h"
+#include "dwarf_pubnames_index.h"
+
+#define TRUE  1
+#define FALSE 0
+
+/*  Where a pass over the sections stands: sizing
+    (fill FALSE) or filling the arrays sized by the
+    first pass. */
+struct pubnames_pass_s {
+    Dwarf_Bool     fill;
+    Dwarf_Unsigned entry_count;
+    Dwarf_Unsigned string_bytes;
+    Dwarf_Pubname_Match *entries;
+    char          *strings;
+};
+
+static Dwarf_Unsigned
+name_hash(const char *s)
+{
+    Dwarf_Unsigned h = 5381;
+    const unsigned char *p = (const unsigned char *)s;
+
+    for (; *p; ++p) {
+        h = h*33 + *p;
+    }
+    return h;
+}
+
+static int
+pubnames_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory building the "
+        "pubnames index");
+    return DW_DLV_ERROR;
+}
+
+/*  One pass over a .debug_pubnames style section.
+    is_gnu says each DIE offset is followed by a flag
+    byte, as in .debug_gnu_pubnames.  The checks are those
+    of _dwarf_internal_get_pubnames_like_data(). */
+static int
+scan_section(Dwarf_Debug dbg,
+    struct Dwarf_Section_s *sec,
+    Dwarf_Bool is_gnu,
+    int length_err_num,
+    int version_err_num,
+    struct pubnames_pass_s *pass,
+    Dwarf_Error *error)
+{
+    Dwarf_Small *section_data_ptr = sec->dss_data;
+    Dwarf_Unsigned section_length = sec->dss_size;
+    Dwarf_Small *section_end_ptr = section_data_ptr + section_length;
+    Dwarf_Small *ptr = section_data_ptr;
+    int res = 0;
+
+    while (ptr < section_end_ptr) {
+        Dwarf_Unsigned length = 0;
+        int length_size = 0;
+        int extension_size = 0;
+        Dwarf_Unsigned version = 0;
+        Dwarf_Unsigned cu_offset = 0;
+        Dwarf_Unsigned info_length = 0;
+        Dwarf_Unsigned die_offset_in_cu = 0;
+        Dwarf_Small *set_end = 0;
+
+        res = _dwarf_read_area_length_ck_wrapper(dbg,
+            &length,&ptr,&length_size,&extension_size,
+            section_length,section_end_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        set_end = ptr + length;
+        res = _dwarf_read_unaligned_ck_wrapper(dbg,
+            &version,ptr,DWARF_HALF_SIZE,section_end_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        ptr += DWARF_HALF_SIZE;
+        if (version != DW_PUBNAMES_VERSION2) {
+            _dwarf_error(dbg, error, version_err_num);
+            return DW_DLV_ERROR;
+        }
+        res = _dwarf_read_unaligned_ck_wrapper(dbg,
+            &cu_offset,ptr,length_size,section_end_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        ptr += length_size;
+        FIX_UP_OFFSET_IRIX_BUG(dbg,cu_offset,
+            "pubnames cu header offset");
+        res = _dwarf_read_unaligned_ck_wrapper(dbg,
+            &info_length,ptr,length_size,section_end_ptr,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        ptr += length_size;
+        for (;;) {
+            Dwarf_Small flags = 0;
+            size_t namelen = 0;
+
+            res = _dwarf_read_unaligned_ck_wrapper(dbg,
+                &die_offset_in_cu,ptr,length_size,
+                section_end_ptr,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            ptr += length_size;
+            FIX_UP_OFFSET_IRIX_BUG(dbg,die_offset_in_cu,
+                "offset of die in cu");
+            if (!die_offset_in_cu) {
+                break;
+            }
+            if (is_gnu) {
+                if (ptr >= section_end_ptr) {
+                    _dwarf_error(dbg, error, length_err_num);
+                    return DW_DLV_ERROR;
+                }
+                flags = *ptr;
+                ptr++;
+            }
+            res = _dwarf_check_string_valid(dbg,section_data_ptr,
+                ptr,section_end_ptr,
+                DW_DLE_STRING_OFF_END_PUBNAMES_LIKE,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            namelen = strlen((char *)ptr);
+            if (pass->fill) {
+                Dwarf_Pubname_Match *m =
+                    pass->entries + pass->entry_count;
+                char *name = pass->strings + pass->string_bytes;
+
+                memcpy(name,ptr,namelen+1);
+                m->pm_name = name;
+                m->pm_cu_offset = cu_offset;
+                m->pm_die_offset = cu_offset + die_offset_in_cu;
+                m->pm_is_gnu = is_gnu;
+                m->pm_gnu_flags = flags;
+            }
+            pass->entry_count++;
+            pass->string_bytes += namelen+1;
+            ptr += namelen+1;
+        }
+        if (ptr > set_end) {
+            _dwarf_error(dbg, error, length_err_num);
+            return DW_DLV_ERROR;
+        }
+        /*  Skip any padding after the terminating zero. */
+        ptr = set_end;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+scan_all(Dwarf_Debug dbg,
+    struct pubnames_pass_s *pass,
+    Dwarf_Error *error)
+{
+    int res = 0;
+
+    if (dbg->de_debug_pubnames.dss_size) {
+        res = scan_section(dbg,&dbg->de_debug_pubnames,FALSE,
+            DW_DLE_PUBNAMES_LENGTH_BAD,
+            DW_DLE_PUBNAMES_VERSION_ERROR,pass,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (dbg->de_debug_gnu_pubnames.dss_size) {
+        res = scan_section(dbg,&dbg->de_debug_gnu_pubnames,TRUE,
+            DW_DLE_GNU_PUBNAMES_ERROR,
+            DW_DLE_GNU_PUBNAMES_ERROR,pass,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+static int
+compare_entries(const void *l, const void *r)
+{
+    const Dwarf_Pubname_Match *lm = (const Dwarf_Pubname_Match *)l;
+    const Dwarf_Pubname_Match *rm = (const Dwarf_Pubname_Match *)r;
+    int res = strcmp(lm->pm_name,rm->pm_name);
+
+    if (res) {
+        return res;
+    }
+    if (lm->pm_die_offset < rm->pm_die_offset) {
+        return -1;
+    }
+    if (lm->pm_die_offset > rm->pm_die_offset) {
+        return 1;
+    }
+    return (int)lm->pm_is_gnu - (int)rm->pm_is_gnu;
+}
+
+static void
+index_free(struct Dwarf_Pubnames_Index_s *ix)
+{
+    if (!ix) {
+        return;
+    }
+    free(ix->pi_entries);
+    free(ix->pi_strings);
+    free(ix->pi_hash);
+    free(ix);
+}
+
+static int
+load_sections(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    int res = _dwarf_load_section(dbg,&dbg->de_debug_pubnames,error);
+
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    res = _dwarf_load_section(dbg,&dbg->de_debug_gnu_pubnames,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (!dbg->de_debug_pubnames.dss_size &&
+        !dbg->de_debug_gnu_pubnames.dss_size) {
+        return DW_DLV_NO_ENTRY;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+build_index(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    struct Dwarf_Pubnames_Index_s *ix = 0;
+    struct pubnames_pass_s pass;
+    Dwarf_Unsigned distinct = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    res = load_sections(dbg,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    memset(&pass,0,sizeof(pass));
+    res = scan_all(dbg,&pass,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!pass.entry_count) {
+        return DW_DLV_NO_ENTRY;
+    }
+    ix = (struct Dwarf_Pubnames_Index_s *)calloc(1,sizeof(*ix));
+    if (!ix) {
+        return pubnames_alloc_error(dbg,error);
+    }
+    ix->pi_entries = (Dwarf_Pubname_Match *)calloc(
+        pass.entry_count,sizeof(Dwarf_Pubname_Match));
+    ix->pi_strings = (char *)malloc(pass.string_bytes);
+    if (!ix->pi_entries || !ix->pi_strings) {
+        index_free(ix);
+        return pubnames_alloc_error(dbg,error);
+    }
+    pass.fill = TRUE;
+    pass.entries = ix->pi_entries;
+    pass.strings = ix->pi_strings;
+    pass.entry_count = 0;
+    pass.string_bytes = 0;
+    res = scan_all(dbg,&pass,error);
+    if (res != DW_DLV_OK) {
+        index_free(ix);
+        return res;
+    }
+    ix->pi_entry_count = pass.entry_count;
+    qsort(ix->pi_entries,ix->pi_entry_count,
+        sizeof(Dwarf_Pubname_Match),compare_entries);
+
+    for (i = 0; i < ix->pi_entry_count; ++i) {
+        if (!i || strcmp(ix->pi_entries[i-1].pm_name,
+            ix->pi_entries[i].pm_name)) {
+            distinct++;
+        }
+    }
+    ix->pi_hash_size = 16;
+    while (ix->pi_hash_size < distinct*2) {
+        ix->pi_hash_size *= 2;
+    }
+    ix->pi_hash = (Dwarf_Unsigned *)calloc(ix->pi_hash_size,
+        sizeof(Dwarf_Unsigned));
+    if (!ix->pi_hash) {
+        index_free(ix);
+        return pubnames_alloc_error(dbg,error);
+    }
+    for (i = 0; i < ix->pi_entry_count; ++i) {
+        Dwarf_Unsigned slot = 0;
+        const char *name = ix->pi_entries[i].pm_name;
+
+        if (i && !strcmp(ix->pi_entries[i-1].pm_name,name)) {
+            continue;
+        }
+        slot = name_hash(name) & (ix->pi_hash_size-1);
+        while (ix->pi_hash[slot]) {
+            slot = (slot+1) & (ix->pi_hash_size-1);
+        }
+        ix->pi_hash[slot] = i+1;
+    }
+    dbg->de_pubnames_index = ix;
+    return DW_DLV_OK;
+}
+
+static int
+get_index(Dwarf_Debug dbg,
+    struct Dwarf_Pubnames_Index_s **ix_out,
+    Dwarf_Error *error)
+{
+    int res = 0;
+
+    if (!dbg->de_pubnames_index) {
+        res = build_index(dbg,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    *ix_out = dbg->de_pubnames_index;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_pubnames_lookup(Dwarf_Debug dbg,
+    const char *name,
+    const Dwarf_Pubname_Match **matches_out,
+    Dwarf_Unsigned *match_count_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Pubnames_Index_s *ix = 0;
+    Dwarf_Unsigned slot = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!name) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = get_index(dbg,&ix,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    slot = name_hash(name) & (ix->pi_hash_size-1);
+    while (ix->pi_hash[slot]) {
+        Dwarf_Unsigned first = ix->pi_hash[slot] - 1;
+
+        if (!strcmp(ix->pi_entries[first].pm_name,name)) {
+            Dwarf_Unsigned last = first+1;
+
+            while (last < ix->pi_entry_count &&
+                !strcmp(ix->pi_entries[last].pm_name,name)) {
+                last++;
+            }
+            *matches_out = ix->pi_entries + first;
+            *match_count_out = last - first;
+            return DW_DLV_OK;
+        }
+        slot = (slot+1) & (ix->pi_hash_size-1);
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+int
+dwarf_pubnames_lookup_prefix(Dwarf_Debug dbg,
+    const char *prefix,
+    const Dwarf_Pubname_Match **matches_out,
+    Dwarf_Unsigned *match_count_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Pubnames_Index_s *ix = 0;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Unsigned first = 0;
+    size_t len = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!prefix) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = get_index(dbg,&ix,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    len = strlen(prefix);
+    /*  Names starting with prefix sort together: the
+        first is the first name not below prefix, the
+        run ends at the first name not starting with it. */
+    hi = ix->pi_entry_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+
+        if (strcmp(ix->pi_entries[mid].pm_name,prefix) < 0) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    first = lo;
+    hi = ix->pi_entry_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+
+        if (!strncmp(ix->pi_entries[mid].pm_name,prefix,len)) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == first) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *matches_out = ix->pi_entries + first;
+    *match_count_out = lo - first;
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_pubnames_index_destroy(Dwarf_Debug dbg)
+{
+    if (!dbg) {
+        return;
+    }
+    index_free(dbg->de_pubnames_index);
+    dbg->de_pubnames_index = 0;
+}
+
+void
+dwarf_pubnames_index_clear(Dwarf_Debug dbg)
+{
+    _dwarf_pubnames_index_destroy(dbg);
+}
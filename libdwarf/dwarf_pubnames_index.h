@@ -0,0 +1,58 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The per-Dwarf_Debug name index behind
+    dwarf_pubnames_lookup().  Every entry of
+    .debug_pubnames and .debug_gnu_pubnames is read once
+    into one array sorted by name, with the names copied
+    into one string arena, so all matches of an exact name
+    or of a prefix are a contiguous run of the array.
+    Exact names are found through an open addressing hash
+    table of the first entry of each distinct name,
+    prefixes by binary search. */
+
+#ifndef DWARF_PUBNAMES_INDEX_H
+#define DWARF_PUBNAMES_INDEX_H
+
+struct Dwarf_Pubnames_Index_s {
+    /*  Sorted by name, then DIE offset.  pm_name points
+        into pi_strings. */
+    Dwarf_Pubname_Match *pi_entries;
+    Dwarf_Unsigned pi_entry_count;
+    char          *pi_strings;
+
+    /*  pi_hash_size is a power of two.  A slot holds
+        one plus the pi_entries index of the first entry
+        with a name, zero if empty. */
+    Dwarf_Unsigned *pi_hash;
+    Dwarf_Unsigned pi_hash_size;
+};
+
+void _dwarf_pubnames_index_destroy(Dwarf_Debug dbg);
+
+#endif /* DWARF_PUBNAMES_INDEX_H */
@@ -811,6 +811,37 @@ dwarf_diename(Dwarf_Die die,
     return dwarf_die_text(die,DW_AT_name,ret_name,error);
 }
 
+/*  The DW_AT_name of die as a (pointer,length) view.
+    See dwarf_formstring_view().
+    New October 2026. */
+int
+dwarf_diename_view(Dwarf_Die die,
+    const char **ret_name,
+    Dwarf_Unsigned *ret_len,
+    Dwarf_Error * error)
+{
+    Dwarf_Debug dbg = 0;
+    int res = DW_DLV_ERROR;
+    Dwarf_Attribute attr = 0;
+    Dwarf_Error lerr = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+
+    res = dwarf_attr(die,DW_AT_name,&attr,&lerr);
+    dbg = die->di_cu_context->cc_dbg;
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc(dbg,lerr,DW_DLA_ERROR);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return res;
+    }
+    res = dwarf_formstring_view(attr,ret_name,ret_len,error);
+    dwarf_dealloc(dbg,attr, DW_DLA_ATTR);
+    attr = 0;
+    return res;
+}
+
 int
 dwarf_hasattr(Dwarf_Die die,
     Dwarf_Half attr,
@@ -836,38 +867,27 @@ dwarf_hasattr(Dwarf_Die die,
     return DW_DLV_OK;
 }
 
+/*  Fills in *attrib for attr of die without allocating,
+    so internal callers can use the dwarf_form*() calls
+    on an attribute on the stack. */
 int
-dwarf_attr(Dwarf_Die die,
+_dwarf_fill_attr(Dwarf_Die die,
     Dwarf_Half attr,
-    Dwarf_Attribute * ret_attr, Dwarf_Error * error)
+    struct Dwarf_Attribute_s *attrib,
+    Dwarf_Error *error)
 {
     Dwarf_Half attr_form = 0;
-    Dwarf_Attribute attrib = 0;
     Dwarf_Byte_Ptr info_ptr = 0;
-    Dwarf_Debug dbg = 0;
     int res = 0;
     Dwarf_Signed implicit_const = 0;
 
     CHECK_DIE(die, DW_DLV_ERROR);
-    dbg = die->di_cu_context->cc_dbg;
-
     res = _dwarf_get_value_ptr(die, attr, &attr_form,&info_ptr,
         &implicit_const,error);
-    if(res == DW_DLV_ERROR) {
-        return res;
-    }
-    if(res == DW_DLV_NO_ENTRY) {
+    if(res != DW_DLV_OK) {
         return res;
     }
-
-    attrib = (Dwarf_Attribute) _dwarf_get_alloc(dbg, DW_DLA_ATTR, 1);
-    if (!attrib) {
-        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
-            "DW_DLE_ALLOC_FAIL allocating a single Dwarf_Attribute"
-            " in function dwarf_attr().");
-        return DW_DLV_ERROR;
-    }
-
+    memset(attrib,0,sizeof(*attrib));
     attrib->ar_attribute = attr;
     attrib->ar_attribute_form = attr_form;
     attrib->ar_attribute_form_direct = attr_form;
@@ -878,7 +898,33 @@ dwarf_attr(Dwarf_Die die,
     /*  Only nonnull if not DW_FORM_implicit_const */
     attrib->ar_debug_ptr = info_ptr;
     attrib->ar_die = die;
-    attrib->ar_dbg = dbg;
+    attrib->ar_dbg = die->di_cu_context->cc_dbg;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_attr(Dwarf_Die die,
+    Dwarf_Half attr,
+    Dwarf_Attribute * ret_attr, Dwarf_Error * error)
+{
+    struct Dwarf_Attribute_s local;
+    Dwarf_Attribute attrib = 0;
+    Dwarf_Debug dbg = 0;
+    int res = 0;
+
+    res = _dwarf_fill_attr(die,attr,&local,error);
+    if(res != DW_DLV_OK) {
+        return res;
+    }
+    dbg = local.ar_dbg;
+    attrib = (Dwarf_Attribute) _dwarf_get_alloc(dbg, DW_DLA_ATTR, 1);
+    if (!attrib) {
+        _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+            "DW_DLE_ALLOC_FAIL allocating a single Dwarf_Attribute"
+            " in function dwarf_attr().");
+        return DW_DLV_ERROR;
+    }
+    *attrib = local;
     *ret_attr = (attrib);
     return DW_DLV_OK;
 }
@@ -944,7 +990,7 @@ _dwarf_extract_address_from_debug_addr(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
-static int
+int
 _dwarf_look_in_local_and_tied_by_index(
     Dwarf_Debug dbg,
     Dwarf_CU_Context context,
@@ -1141,6 +1187,52 @@ dwarf_dietype_offset(Dwarf_Die die,
 
 
 
+/*  A DWARF5 .debug_str_offsets.dwo contribution (the whole
+    section in a .dwo, one unit's share of it in a .dwp)
+    starts with a unit length, version and padding.
+    DWARF4 GNU split DWARF has no such header. */
+static int
+_dwarf_split_str_offsets_base(Dwarf_Debug dbg,
+    Dwarf_CU_Context context,
+    Dwarf_Unsigned *sbase_out,
+    Dwarf_Error *error)
+{
+    int res = 0;
+    Dwarf_Unsigned fissoff = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Unsigned length = 0;
+    Dwarf_Small *secstart = 0;
+    Dwarf_Small *secend = 0;
+
+    *sbase_out = 0;
+    if (context->cc_version_stamp < DW_CU_VERSION5) {
+        return DW_DLV_OK;
+    }
+    res = _dwarf_load_section(dbg, &dbg->de_debug_str_offsets,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        return DW_DLV_OK;
+    }
+    fissoff = _dwarf_get_dwp_extra_offset(&context->cc_dwp_offsets,
+        DW_SECT_STR_OFFSETS, &size);
+    secstart = dbg->de_debug_str_offsets.dss_data;
+    secend = secstart + dbg->de_debug_str_offsets.dss_size;
+    if (fissoff + 8 > dbg->de_debug_str_offsets.dss_size) {
+        return DW_DLV_OK;
+    }
+    READ_UNALIGNED_CK(dbg,length,Dwarf_Unsigned,
+        secstart + fissoff, 4,error,secend);
+    if (length == DISTINGUISHED_VALUE) {
+        /* 64-bit length, version, padding. */
+        *sbase_out = 16;
+    } else {
+        *sbase_out = 8;
+    }
+    return DW_DLV_OK;
+}
+
 int
 _dwarf_get_string_base_attr_value(Dwarf_Debug dbg,
     Dwarf_CU_Context context,
@@ -1156,7 +1248,8 @@ _dwarf_get_string_base_attr_value(Dwarf_Debug dbg,
         *sbase_out = context->cc_str_offsets_base;
         return DW_DLV_OK;
     }
-    if (context->cc_unit_type == DW_UT_split_compile) {
+    if (context->cc_unit_type == DW_UT_split_compile ||
+        context->cc_unit_type == DW_UT_split_type) {
         /*  DW_AT_str_offsets_base is not part of split full
             compilation units (See "3.1.3 Split Full
             Compilation Unit Entries" in the DWARF5
@@ -1167,8 +1260,18 @@ _dwarf_get_string_base_attr_value(Dwarf_Debug dbg,
             a context if none is found, and we can get here during
             context creation when reading
             DW_AT_dwo_name, which would cause
-            infinite recursion. */
-        *sbase_out = 0;
+            infinite recursion.
+
+            The split unit uses the entries just past the
+            header of its .debug_str_offsets.dwo contribution
+            (section 7.26), so the base is the header size. */
+        res = _dwarf_split_str_offsets_base(dbg,context,
+            sbase_out,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        context->cc_str_offsets_base = *sbase_out;
+        context->cc_str_offsets_base_present = TRUE;
         return DW_DLV_OK;
     }
     cu_die_offset = context->cc_cu_die_global_sec_offset;
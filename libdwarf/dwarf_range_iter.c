@@ -0,0 +1,856 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  dwarf_range_iter_begin() and dwarf_range_iter_next():
+    the pc ranges of a DIE as cooked [low,high) pairs
+    decoded straight from .debug_ranges or .debug_rnglists
+    into caller-owned iterator state, with no allocation
+    per query.  The iterator keeps section offsets, never
+    pointers into section data, as .debug_ranges may be
+    evicted between calls under a section memory budget.
+    See dwarf_range_iter.h for the optional cache of
+    decoded lists. */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarfstring.h"
+#include "dwarf_rnglists.h"
+#include "dwarf_range_iter.h"
+
+#define TRUE  1
+#define FALSE 0
+
+/* Values of ri_kind and ri_raw_kind. */
+#define RI_DONE      0
+#define RI_SINGLE    1
+#define RI_RANGES    2
+#define RI_RNGLISTS  3
+#define RI_CACHED    4
+
+static int
+range_cache_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory in the "
+        "range list cache");
+    return DW_DLV_ERROR;
+}
+
+static void
+free_slots(struct Dwarf_Range_Cache_s *rk)
+{
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < rk->rk_size; ++i) {
+        free(rk->rk_slots[i].rs_pairs);
+    }
+    free(rk->rk_slots);
+    rk->rk_slots = 0;
+    rk->rk_size = 0;
+}
+
+int
+dwarf_range_cache_set_size(Dwarf_Debug dbg,
+    Dwarf_Unsigned list_count,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Range_Cache_s *rk = 0;
+    Dwarf_Unsigned size = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    rk = dbg->de_range_cache;
+    if (!rk) {
+        if (!list_count) {
+            return DW_DLV_OK;
+        }
+        rk = (struct Dwarf_Range_Cache_s *)calloc(1,sizeof(*rk));
+        if (!rk) {
+            return range_cache_alloc_error(dbg,error);
+        }
+        dbg->de_range_cache = rk;
+    }
+    if (list_count) {
+        size = 1;
+        while (size < list_count) {
+            size *= 2;
+        }
+    }
+    if (size == rk->rk_size) {
+        return DW_DLV_OK;
+    }
+    free_slots(rk);
+    if (size) {
+        rk->rk_slots = (struct Dwarf_Range_Cache_Slot_s *)
+            calloc(size,sizeof(struct Dwarf_Range_Cache_Slot_s));
+        if (!rk->rk_slots) {
+            return range_cache_alloc_error(dbg,error);
+        }
+        rk->rk_size = size;
+    }
+    return DW_DLV_OK;
+}
+
+void
+dwarf_range_cache_stats(Dwarf_Debug dbg,
+    Dwarf_Unsigned *hits,
+    Dwarf_Unsigned *misses)
+{
+    struct Dwarf_Range_Cache_s *rk = dbg? dbg->de_range_cache:0;
+
+    if (hits) {
+        *hits = rk? rk->rk_hits:0;
+    }
+    if (misses) {
+        *misses = rk? rk->rk_misses:0;
+    }
+}
+
+void
+_dwarf_range_cache_destroy(Dwarf_Debug dbg)
+{
+    struct Dwarf_Range_Cache_s *rk = 0;
+
+    if (!dbg || !dbg->de_range_cache) {
+        return;
+    }
+    rk = dbg->de_range_cache;
+    free_slots(rk);
+    free(rk);
+    dbg->de_range_cache = 0;
+}
+
+/*  Sets *addr_out from .debug_addr, here or in the tied
+    object.  DW_DLV_NO_ENTRY means there is no .debug_addr
+    to be had (a .dwo without its executable), so the
+    entry cannot be cooked. */
+static int
+iter_debug_addr(Dwarf_Range_Iter *it,
+    Dwarf_Unsigned index,
+    Dwarf_Addr *addr_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Error localerr = 0;
+    int res = 0;
+
+    res = _dwarf_look_in_local_and_tied_by_index(it->ri_dbg,
+        (Dwarf_CU_Context)it->ri_context,index,addr_out,&localerr);
+    if (res == DW_DLV_ERROR) {
+        if (dwarf_errno(localerr) ==
+            DW_DLE_MISSING_NEEDED_DEBUG_ADDR_SECTION) {
+            dwarf_dealloc(it->ri_dbg,localerr,DW_DLA_ERROR);
+            return DW_DLV_NO_ENTRY;
+        }
+        if (error) {
+            _dwarf_error_mv_s_to_t(it->ri_dbg,&localerr,
+                it->ri_dbg,error);
+        } else {
+            dwarf_dealloc(it->ri_dbg,localerr,DW_DLA_ERROR);
+        }
+    }
+    return res;
+}
+
+/*  Sets *data_out to the data of the section it reads,
+    loading it again if it was evicted since the last
+    call. */
+static int
+iter_section_data(Dwarf_Range_Iter *it,
+    Dwarf_Small **data_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Section_s *sec =
+        (struct Dwarf_Section_s *)it->ri_section;
+    int res = 0;
+
+    res = _dwarf_load_section(it->ri_section_dbg,sec,error);
+    if (res != DW_DLV_OK) {
+        it->ri_kind = RI_DONE;
+        return res;
+    }
+    if (it->ri_end_offset > sec->dss_size ||
+        it->ri_offset > it->ri_end_offset) {
+        /*  Cannot happen unless the section changed size
+            on reloading. */
+        it->ri_kind = RI_DONE;
+        _dwarf_error_string(it->ri_dbg,error,
+            DW_DLE_SECTION_SIZE_ERROR,
+            "DW_DLE_SECTION_SIZE_ERROR: a range list section "
+            "is smaller than when the iterator began");
+        return DW_DLV_ERROR;
+    }
+    *data_out = sec->dss_data;
+    return DW_DLV_OK;
+}
+
+/*  The next non-empty pair of a .debug_ranges list. */
+static int
+next_from_ranges(Dwarf_Range_Iter *it,
+    Dwarf_Addr *low_out,
+    Dwarf_Addr *high_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = it->ri_dbg;
+    unsigned address_size = it->ri_address_size;
+    Dwarf_Addr max_addr = (address_size == 8)?
+        0xffffffffffffffffULL:0xffffffff;
+    Dwarf_Small *data = 0;
+    Dwarf_Small *end = 0;
+    int res = 0;
+
+    res = iter_section_data(it,&data,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    end = data + it->ri_end_offset;
+    for (;;) {
+        Dwarf_Addr a1 = 0;
+        Dwarf_Addr a2 = 0;
+        Dwarf_Small *ptr = data + it->ri_offset;
+
+        if (ptr == end) {
+            it->ri_kind = RI_DONE;
+            return DW_DLV_NO_ENTRY;
+        }
+        if ((Dwarf_Unsigned)(end - ptr) < 2*address_size) {
+            it->ri_kind = RI_DONE;
+            _dwarf_error_string(dbg, error,
+                DW_DLE_DEBUG_RANGES_OFFSET_BAD,
+                "DW_DLE_DEBUG_RANGES_OFFSET_BAD: "
+                " Not at the end of the ranges section "
+                " but there is not enough room in the section "
+                " for the next ranges entry");
+            return DW_DLV_ERROR;
+        }
+        READ_UNALIGNED_CK(dbg,a1,Dwarf_Addr,ptr,
+            address_size,error,end);
+        READ_UNALIGNED_CK(dbg,a2,Dwarf_Addr,
+            ptr+address_size,address_size,error,end);
+        it->ri_offset += 2*address_size;
+        if (!a1 && !a2) {
+            it->ri_kind = RI_DONE;
+            return DW_DLV_NO_ENTRY;
+        }
+        if (a1 == max_addr) {
+            it->ri_base = a2;
+            continue;
+        }
+        if (a1 >= a2) {
+            /* Empty. */
+            continue;
+        }
+        *low_out = a1 + it->ri_base;
+        *high_out = a2 + it->ri_base;
+        return DW_DLV_OK;
+    }
+}
+
+/*  The next non-empty pair of a .debug_rnglists list.
+    Entries needing .debug_addr when there is none
+    are skipped, as is an offset pair with no known
+    base address. */
+static int
+next_from_rnglists(Dwarf_Range_Iter *it,
+    Dwarf_Addr *low_out,
+    Dwarf_Addr *high_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = it->ri_dbg;
+    Dwarf_Small *data = 0;
+    int res = 0;
+
+    res = iter_section_data(it,&data,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    for (;;) {
+        unsigned entrylen = 0;
+        unsigned code = 0;
+        Dwarf_Unsigned val1 = 0;
+        Dwarf_Unsigned val2 = 0;
+        Dwarf_Addr low = 0;
+        Dwarf_Addr high = 0;
+        int res2 = DW_DLV_OK;
+
+        if (it->ri_offset >= it->ri_end_offset) {
+            it->ri_kind = RI_DONE;
+            _dwarf_error_string(dbg, error,DW_DLE_RNGLISTS_ERROR,
+                "DW_DLE_RNGLISTS_ERROR: a range list runs off "
+                "the end of .debug_rnglists with no "
+                "DW_RLE_end_of_list");
+            return DW_DLV_ERROR;
+        }
+        res = _dwarf_read_single_rle_entry(dbg,
+            data + it->ri_offset,it->ri_offset,
+            data + it->ri_end_offset,it->ri_address_size,
+            &entrylen,&code,&val1,&val2,error);
+        if (res != DW_DLV_OK) {
+            it->ri_kind = RI_DONE;
+            return res;
+        }
+        it->ri_offset += entrylen;
+        switch (code) {
+        case DW_RLE_end_of_list:
+            it->ri_kind = RI_DONE;
+            return DW_DLV_NO_ENTRY;
+        case DW_RLE_base_addressx:
+            res = iter_debug_addr(it,val1,&low,error);
+            if (res == DW_DLV_ERROR) {
+                it->ri_kind = RI_DONE;
+                return res;
+            }
+            it->ri_base_known = (res == DW_DLV_OK);
+            it->ri_base = low;
+            continue;
+        case DW_RLE_base_address:
+            it->ri_base_known = TRUE;
+            it->ri_base = val1;
+            continue;
+        case DW_RLE_startx_endx:
+            res = iter_debug_addr(it,val1,&low,error);
+            if (res == DW_DLV_OK) {
+                res2 = iter_debug_addr(it,val2,&high,error);
+            }
+            break;
+        case DW_RLE_startx_length:
+            res = iter_debug_addr(it,val1,&low,error);
+            high = low + val2;
+            break;
+        case DW_RLE_offset_pair:
+            res = it->ri_base_known? DW_DLV_OK:DW_DLV_NO_ENTRY;
+            low = it->ri_base + val1;
+            high = it->ri_base + val2;
+            break;
+        case DW_RLE_start_end:
+            low = val1;
+            high = val2;
+            break;
+        case DW_RLE_start_length:
+            low = val1;
+            high = val1 + val2;
+            break;
+        default:
+            /*  _dwarf_read_single_rle_entry() rejects
+                anything else. */
+            break;
+        }
+        if (res == DW_DLV_ERROR || res2 == DW_DLV_ERROR) {
+            it->ri_kind = RI_DONE;
+            return DW_DLV_ERROR;
+        }
+        if (res != DW_DLV_OK || res2 != DW_DLV_OK ||
+            low >= high) {
+            continue;
+        }
+        *low_out = low;
+        *high_out = high;
+        return DW_DLV_OK;
+    }
+}
+
+static int
+next_raw(Dwarf_Range_Iter *it,
+    Dwarf_Addr *low_out,
+    Dwarf_Addr *high_out,
+    Dwarf_Error *error)
+{
+    switch (it->ri_kind) {
+    case RI_SINGLE:
+        it->ri_kind = RI_DONE;
+        *low_out = it->ri_low;
+        *high_out = it->ri_high;
+        return DW_DLV_OK;
+    case RI_RANGES:
+        return next_from_ranges(it,low_out,high_out,error);
+    case RI_RNGLISTS:
+        return next_from_rnglists(it,low_out,high_out,error);
+    default:
+        break;
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  Finds the .debug_rnglists table whose offset array
+    starts at base.  The tables are in section order. */
+static int
+find_rnglists_table(Dwarf_Debug dbg,
+    Dwarf_Unsigned base,
+    Dwarf_Rnglists_Context *rctx_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = dbg->de_rnglists_context_count;
+
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi-lo)/2;
+        Dwarf_Rnglists_Context rcx = dbg->de_rnglists_context[mid];
+
+        if (rcx->rc_offsets_off_in_sect == base) {
+            *rctx_out = rcx;
+            return DW_DLV_OK;
+        }
+        if (rcx->rc_offsets_off_in_sect < base) {
+            lo = mid+1;
+        } else {
+            hi = mid;
+        }
+    }
+    {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_u(&m,
+            "DW_DLE_RNGLISTS_ERROR: rnglists base of "
+            " 0x%" DW_PR_XZEROS DW_PR_DUx ,base);
+        dwarfstring_append(&m,
+            " was not found anywhere in .debug_rnglists "
+            "data. Corrupted data?");
+        _dwarf_error_string(dbg,error,
+            DW_DLE_RNGLISTS_ERROR,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+    }
+    return DW_DLV_ERROR;
+}
+
+/*  Sets *list_offset_out to the .debug_rnglists offset
+    of the list DW_FORM_rnglistx index value names.
+    A split unit has no DW_AT_rnglists_base: its
+    base is just past the header of its own table. */
+static int
+rnglistx_offset(Dwarf_Debug dbg,
+    Dwarf_CU_Context ctx,
+    Dwarf_Unsigned index,
+    Dwarf_Unsigned *list_offset_out,
+    Dwarf_Unsigned *end_offset_out,
+    Dwarf_Half *address_size_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Rnglists_Context rctx = 0;
+    Dwarf_Unsigned entryval = 0;
+    Dwarf_Small *entry = 0;
+    int res = 0;
+
+    if (ctx->cc_rnglists_base_present) {
+        res = find_rnglists_table(dbg,ctx->cc_rnglists_base,
+            &rctx,error);
+    } else if (ctx->cc_unit_type == DW_UT_split_compile ||
+        ctx->cc_unit_type == DW_UT_split_type) {
+        Dwarf_Unsigned size = 0;
+        Dwarf_Unsigned fissoff = _dwarf_get_dwp_extra_offset(
+            &ctx->cc_dwp_offsets,DW_SECT_RNGLISTS,&size);
+        Dwarf_Unsigned i = 0;
+
+        res = DW_DLV_NO_ENTRY;
+        for (i = 0; i < dbg->de_rnglists_context_count; ++i) {
+            if (dbg->de_rnglists_context[i]->rc_header_offset ==
+                fissoff) {
+                rctx = dbg->de_rnglists_context[i];
+                res = DW_DLV_OK;
+                break;
+            }
+        }
+        if (res != DW_DLV_OK) {
+            _dwarf_error_string(dbg,error,DW_DLE_RNGLISTS_ERROR,
+                "DW_DLE_RNGLISTS_ERROR: no .debug_rnglists "
+                "table for a split unit using DW_FORM_rnglistx");
+            return DW_DLV_ERROR;
+        }
+    } else {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_u(&m,
+            "DW_DLE_RNGLISTS_ERROR: rnglists table index of"
+            " %u"  ,index);
+        dwarfstring_append(&m,
+            " is unusable without a DW_AT_rnglists_base.");
+        _dwarf_error_string(dbg,error,DW_DLE_RNGLISTS_ERROR,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        return DW_DLV_ERROR;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (index >= rctx->rc_offset_entry_count) {
+        dwarfstring m;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append_printf_u(&m,
+            "DW_DLE_RNGLISTS_ERROR: rnglists table index of"
+            " %u"  ,index);
+        dwarfstring_append_printf_u(&m,
+            " too large for table of %u "
+            "entries.",rctx->rc_offset_entry_count);
+        _dwarf_error_string(dbg,error,DW_DLE_RNGLISTS_ERROR,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        return DW_DLV_ERROR;
+    }
+    entry = rctx->rc_offsets_array + index*rctx->rc_offset_size;
+    READ_UNALIGNED_CK(dbg,entryval,Dwarf_Unsigned,
+        entry,rctx->rc_offset_size,error,rctx->rc_endaddr);
+    *list_offset_out = rctx->rc_offsets_off_in_sect + entryval;
+    *end_offset_out = rctx->rc_endaddr -
+        dbg->de_debug_rnglists.dss_data;
+    *address_size_out = rctx->rc_address_size;
+    return DW_DLV_OK;
+}
+
+/*  Sets up it to read the DW_AT_ranges list of die,
+    *list_offset_out being its section offset. */
+static int
+begin_range_list(Dwarf_Die die,
+    struct Dwarf_Attribute_s *attr,
+    Dwarf_Range_Iter *it,
+    Dwarf_Unsigned *list_offset_out,
+    Dwarf_Error *error)
+{
+    Dwarf_CU_Context ctx = die->di_cu_context;
+    Dwarf_Debug dbg = ctx->cc_dbg;
+    Dwarf_Half form = attr->ar_attribute_form;
+    Dwarf_Unsigned value = 0;
+    int res = 0;
+
+    if (form == DW_FORM_rnglistx) {
+        res = dwarf_formudata(attr,&value,error);
+    } else {
+        Dwarf_Off off = 0;
+
+        res = dwarf_global_formref(attr,&off,error);
+        value = off;
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (ctx->cc_low_pc_present) {
+        it->ri_base = ctx->cc_low_pc;
+        it->ri_base_known = TRUE;
+    }
+    it->ri_address_size = ctx->cc_address_size;
+    if (ctx->cc_version_stamp >= DW_CU_VERSION5) {
+        struct Dwarf_Section_s *sec = &dbg->de_debug_rnglists;
+
+        res = _dwarf_load_section(dbg,sec,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        it->ri_section_dbg = dbg;
+        it->ri_section = sec;
+        it->ri_end_offset = sec->dss_size;
+        if (form == DW_FORM_rnglistx) {
+            Dwarf_Unsigned end = 0;
+
+            if (!dbg->de_rnglists_context_count) {
+                res = dwarf_load_rnglists(dbg,0,error);
+                if (res != DW_DLV_OK) {
+                    return res;
+                }
+            }
+            res = rnglistx_offset(dbg,ctx,value,&value,&end,
+                &it->ri_address_size,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            it->ri_end_offset = end;
+        }
+        it->ri_kind = RI_RNGLISTS;
+    } else {
+        Dwarf_Debug localdbg = dbg;
+        Dwarf_Unsigned ranges_base = 0;
+        struct Dwarf_Section_s *sec = 0;
+
+        if (dbg->de_tied_data.td_tied_object) {
+            Dwarf_Unsigned addr_base = 0;
+            Dwarf_Error localerr = 0;
+
+            /*  .debug_ranges of a split unit is in the
+                executable, as in dwarf_get_ranges_a(). */
+            res = _dwarf_get_ranges_base_attr_from_tied(dbg,
+                ctx,&ranges_base,&addr_base,&localerr);
+            if (res == DW_DLV_OK) {
+                localdbg = dbg->de_tied_data.td_tied_object;
+            } else {
+                if (res == DW_DLV_ERROR) {
+                    dwarf_dealloc(dbg,localerr,DW_DLA_ERROR);
+                }
+                ranges_base = 0;
+            }
+        }
+        sec = &localdbg->de_debug_ranges;
+        res = _dwarf_load_section(localdbg,sec,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        value += ranges_base;
+        it->ri_section_dbg = localdbg;
+        it->ri_section = sec;
+        it->ri_end_offset = sec->dss_size;
+        it->ri_base_known = TRUE;
+        it->ri_kind = RI_RANGES;
+    }
+    if (value > it->ri_end_offset) {
+        dwarfstring m;
+        int errnum = (it->ri_kind == RI_RANGES)?
+            DW_DLE_DEBUG_RANGES_OFFSET_BAD:DW_DLE_RNGLISTS_ERROR;
+
+        dwarfstring_constructor(&m);
+        dwarfstring_append(&m,(it->ri_kind == RI_RANGES)?
+            "DW_DLE_DEBUG_RANGES_OFFSET_BAD":
+            "DW_DLE_RNGLISTS_ERROR");
+        dwarfstring_append_printf_u(&m,
+            ": DW_AT_ranges offset 0x%" DW_PR_XZEROS DW_PR_DUx,
+            value);
+        dwarfstring_append(&m," is past the end of its section");
+        _dwarf_error_string(dbg,error,errnum,
+            dwarfstring_string(&m));
+        dwarfstring_destructor(&m);
+        it->ri_kind = RI_DONE;
+        return DW_DLV_ERROR;
+    }
+    it->ri_offset = value;
+    *list_offset_out = value;
+    return DW_DLV_OK;
+}
+
+static Dwarf_Unsigned
+slot_index(struct Dwarf_Range_Cache_s *rk,
+    Dwarf_Half kind,
+    Dwarf_Off cu_offset,
+    Dwarf_Unsigned list_offset)
+{
+    Dwarf_Unsigned h = list_offset*0x9e3779b97f4a7c15ULL;
+
+    h ^= cu_offset + kind;
+    h ^= h >> 29;
+    return h & (rk->rk_size-1);
+}
+
+/*  Looks the list it is at up in the cache, decoding
+    it all into the slot on a miss, and points it at the
+    cooked pairs. */
+static int
+use_cache(Dwarf_Range_Iter *it,
+    Dwarf_Unsigned list_offset,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = it->ri_dbg;
+    struct Dwarf_Range_Cache_s *rk = dbg->de_range_cache;
+    Dwarf_CU_Context ctx = (Dwarf_CU_Context)it->ri_context;
+    struct Dwarf_Range_Cache_Slot_s *slot = 0;
+    Dwarf_Unsigned index = slot_index(rk,it->ri_kind,
+        ctx->cc_debug_offset,list_offset);
+    Dwarf_Range_Iter scan;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Addr *pairs = 0;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    int res = 0;
+
+    slot = rk->rk_slots + index;
+    if (slot->rs_used &&
+        slot->rs_kind == it->ri_kind &&
+        slot->rs_list_offset == list_offset &&
+        slot->rs_cu_offset == ctx->cc_debug_offset &&
+        slot->rs_is_info == ctx->cc_is_info) {
+        rk->rk_hits++;
+    } else {
+        rk->rk_misses++;
+        scan = *it;
+        while ((res = next_raw(&scan,&low,&high,error)) ==
+            DW_DLV_OK) {
+            count++;
+        }
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (count) {
+            Dwarf_Unsigned i = 0;
+
+            pairs = (Dwarf_Addr *)malloc(
+                count*2*sizeof(Dwarf_Addr));
+            if (!pairs) {
+                return range_cache_alloc_error(dbg,error);
+            }
+            scan = *it;
+            for (i = 0; i < count; ++i) {
+                res = next_raw(&scan,pairs+2*i,pairs+2*i+1,error);
+                if (res != DW_DLV_OK) {
+                    free(pairs);
+                    return res == DW_DLV_ERROR? res:
+                        range_cache_alloc_error(dbg,error);
+                }
+            }
+        }
+        free(slot->rs_pairs);
+        slot->rs_used = TRUE;
+        slot->rs_kind = it->ri_kind;
+        slot->rs_list_offset = list_offset;
+        slot->rs_cu_offset = ctx->cc_debug_offset;
+        slot->rs_is_info = ctx->cc_is_info;
+        slot->rs_pairs = pairs;
+        slot->rs_count = count;
+        slot->rs_generation = ++rk->rk_generation;
+    }
+    it->ri_raw_kind = it->ri_kind;
+    it->ri_kind = RI_CACHED;
+    it->ri_cached = slot->rs_pairs;
+    it->ri_cached_count = slot->rs_count;
+    it->ri_cached_slot = index;
+    it->ri_cached_generation = slot->rs_generation;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_range_iter_begin(Dwarf_Die die,
+    Dwarf_Range_Iter *it,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Attribute_s attr;
+    Dwarf_CU_Context ctx = 0;
+    Dwarf_Unsigned list_offset = 0;
+    Dwarf_Half form = 0;
+    enum Dwarf_Form_Class formclass = DW_FORM_CLASS_UNKNOWN;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    if (!it) {
+        _dwarf_error_string(die->di_cu_context->cc_dbg,
+            error,DW_DLE_RNGLISTS_ERROR,
+            "DW_DLE_RNGLISTS_ERROR: dwarf_range_iter_begin() "
+            "was passed a null iterator");
+        return DW_DLV_ERROR;
+    }
+    ctx = die->di_cu_context;
+    memset(it,0,sizeof(*it));
+    it->ri_dbg = ctx->cc_dbg;
+    it->ri_context = ctx;
+
+    /*  DW_AT_ranges first: a CU DIE with DW_AT_ranges
+        often has DW_AT_low_pc too, as the base address. */
+    res = _dwarf_fill_attr(die,DW_AT_ranges,&attr,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_OK) {
+        res = begin_range_list(die,&attr,it,&list_offset,error);
+        if (res != DW_DLV_OK) {
+            it->ri_kind = RI_DONE;
+            return res;
+        }
+        if (it->ri_dbg->de_range_cache &&
+            it->ri_dbg->de_range_cache->rk_size) {
+            res = use_cache(it,list_offset,error);
+            if (res != DW_DLV_OK) {
+                it->ri_kind = RI_DONE;
+                return res;
+            }
+        }
+        return DW_DLV_OK;
+    }
+    res = dwarf_lowpc(die,&it->ri_low,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_highpc_b(die,&it->ri_high,&form,&formclass,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    if (res == DW_DLV_NO_ENTRY) {
+        /* A single address. */
+        it->ri_high = it->ri_low + 1;
+    } else if (formclass == DW_FORM_CLASS_CONSTANT) {
+        it->ri_high += it->ri_low;
+    }
+    it->ri_kind = (it->ri_low < it->ri_high)? RI_SINGLE:RI_DONE;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_range_iter_next(Dwarf_Range_Iter *it,
+    Dwarf_Addr *low_out,
+    Dwarf_Addr *high_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    int res = 0;
+
+    if (!it || it->ri_kind == RI_DONE) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (it->ri_kind == RI_CACHED) {
+        struct Dwarf_Range_Cache_s *rk = it->ri_dbg->de_range_cache;
+        Dwarf_Unsigned skip = it->ri_yielded;
+
+        if (it->ri_cached_slot < rk->rk_size &&
+            rk->rk_slots[it->ri_cached_slot].rs_generation ==
+            it->ri_cached_generation) {
+            if (it->ri_yielded >= it->ri_cached_count) {
+                it->ri_kind = RI_DONE;
+                return DW_DLV_NO_ENTRY;
+            }
+            *low_out = it->ri_cached[2*it->ri_yielded];
+            *high_out = it->ri_cached[2*it->ri_yielded+1];
+            it->ri_yielded++;
+            return DW_DLV_OK;
+        }
+        /*  The slot was refilled by a later query: go on
+            from the section bytes, which were left at
+            the start of the list. */
+        it->ri_kind = it->ri_raw_kind;
+        it->ri_cached = 0;
+        for ( ; skip; --skip) {
+            res = next_raw(it,&low,&high,error);
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+        }
+    }
+    res = next_raw(it,&low,&high,error);
+    if (res == DW_DLV_OK) {
+        *low_out = low;
+        *high_out = high;
+        it->ri_yielded++;
+    }
+    return res;
+}
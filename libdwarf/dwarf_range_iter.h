@@ -0,0 +1,66 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The optional per-Dwarf_Debug cache behind
+    dwarf_range_iter_begin().  It is direct mapped:
+    each slot holds the cooked [low,high) pairs of one
+    range list, keyed by the list offset, the section
+    it is in and the CU whose base address applied.
+    Every fill takes a new generation number so an
+    iterator reading a slot can tell it was replaced. */
+
+#ifndef DWARF_RANGE_ITER_H
+#define DWARF_RANGE_ITER_H
+
+struct Dwarf_Range_Cache_Slot_s {
+    Dwarf_Bool     rs_used;
+    Dwarf_Bool     rs_is_info;
+    Dwarf_Half     rs_kind;
+    Dwarf_Off      rs_cu_offset;
+    Dwarf_Unsigned rs_list_offset;
+    Dwarf_Unsigned rs_generation;
+    /* low,high pairs, malloc space. */
+    Dwarf_Addr    *rs_pairs;
+    Dwarf_Unsigned rs_count;
+};
+
+struct Dwarf_Range_Cache_s {
+    /*  rk_size is zero (caching off) or a power
+        of two. */
+    struct Dwarf_Range_Cache_Slot_s *rk_slots;
+    Dwarf_Unsigned rk_size;
+    /*  Never reset, even when the slots are resized,
+        so a stale generation never matches. */
+    Dwarf_Unsigned rk_generation;
+    Dwarf_Unsigned rk_hits;
+    Dwarf_Unsigned rk_misses;
+};
+
+void _dwarf_range_cache_destroy(Dwarf_Debug dbg);
+
+#endif /* DWARF_RANGE_ITER_H */
@@ -88,8 +88,8 @@ free_rnglists_chain(Dwarf_Debug dbg, Dwarf_Chain head)
     }
 }
 
-static int
-read_single_rle_entry(Dwarf_Debug dbg,
+int
+_dwarf_read_single_rle_entry(Dwarf_Debug dbg,
     Dwarf_Small   *data,
     Dwarf_Unsigned dataoffset,
     Dwarf_Small   *enddata,
@@ -422,6 +422,9 @@ int dwarf_load_rnglists(
         if (rnglists_count) {
             *rnglists_count = dbg->de_rnglists_context_count;
         }
+        /*  Already loaded: loading again would leak the
+            first set of contexts. */
+        return DW_DLV_OK;
     }
     if (!dbg->de_debug_rnglists.dss_size) {
         /* nothing there. */
@@ -667,7 +670,7 @@ int dwarf_get_rnglist_rle(
 
     con = dbg->de_rnglists_context[contextnumber];
     address_size = con->rc_address_size;
-    res = read_single_rle_entry(dbg,
+    res = _dwarf_read_single_rle_entry(dbg,
         data,entry_offset,enddata,
         address_size,entrylen,
         entry_kind, entry_operand1, entry_operand2,
@@ -814,6 +817,44 @@ alloc_rle_and_append_to_list(Dwarf_Debug dbg,
     return DW_DLV_OK;
 }
 
+/*  Reads .debug_addr entry index for an rle, here or in
+    the tied object.  DW_DLV_NO_ENTRY, with *unavailable
+    set, when there is no .debug_addr to read (a .dwo
+    with no executable tied to it), so the entry is left
+    uncooked instead of failing the whole list.
+    New October 2026. */
+static int
+rle_debug_addr(Dwarf_Debug dbg,
+    Dwarf_CU_Context ctx,
+    Dwarf_Unsigned index,
+    Dwarf_Bool *unavailable,
+    Dwarf_Addr *addr_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Error localerr = 0;
+    int res = 0;
+
+    if (*unavailable) {
+        return DW_DLV_NO_ENTRY;
+    }
+    res = _dwarf_look_in_local_and_tied_by_index(dbg,ctx,
+        index,addr_out,&localerr);
+    if (res == DW_DLV_ERROR) {
+        if (dwarf_errno(localerr) ==
+            DW_DLE_MISSING_NEEDED_DEBUG_ADDR_SECTION) {
+            dwarf_dealloc(dbg,localerr,DW_DLA_ERROR);
+            *unavailable = TRUE;
+            return DW_DLV_NO_ENTRY;
+        }
+        if (error) {
+            *error = localerr;
+        } else {
+            dwarf_dealloc(dbg,localerr,DW_DLA_ERROR);
+        }
+    }
+    return res;
+}
+
 /*  Read the group of rangelists entries, and
     finally build an array of Dwarf_Rnglists_Entry
     records. Attach to rctx here.
@@ -853,7 +894,7 @@ build_array_of_rle(Dwarf_Debug dbg,
         Dwarf_Addr addr2 = 0;
         Dwarf_Rnglists_Entry e = 0;
 
-        res = read_single_rle_entry(dbg,
+        res = _dwarf_read_single_rle_entry(dbg,
             data,dataoffset, enddata,
             address_size,&entrylen,
             &code,&val1, &val2,error);
@@ -876,15 +917,12 @@ build_array_of_rle(Dwarf_Debug dbg,
         }
         switch(code) {
         case DW_RLE_base_addressx:
-            if(no_debug_addr_available) {
-                res = DW_DLV_NO_ENTRY;
-            } else {
-                res = _dwarf_extract_address_from_debug_addr(
-                    dbg,rctx->rh_context,val1,
-                    &addr1,error);
+            res = rle_debug_addr(dbg,rctx->rh_context,val1,
+                &no_debug_addr_available,&addr1,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
             }
             if (res != DW_DLV_OK) {
-                no_debug_addr_available = TRUE;
                 e->rle_index_failed = TRUE;
                 e->rle_cooked1 = 0;
                 foundbaseaddr = FALSE;
@@ -895,51 +933,34 @@ build_array_of_rle(Dwarf_Debug dbg,
             }
             break;
         case DW_RLE_startx_endx:
-            if(no_debug_addr_available) {
-                res = DW_DLV_NO_ENTRY;
-            } else {
-                res = _dwarf_extract_address_from_debug_addr(
-                    dbg,rctx->rh_context,val1,
-                    &addr1,error);
-            }
-            if (res != DW_DLV_OK) {
-                no_debug_addr_available = TRUE;
-                e->rle_index_failed = TRUE;
-                e->rle_cooked1 = 0;
-            } else {
-                e->rle_cooked1 = addr1;
+            res = rle_debug_addr(dbg,rctx->rh_context,val1,
+                &no_debug_addr_available,&addr1,error);
+            if (res == DW_DLV_OK) {
+                res = rle_debug_addr(dbg,rctx->rh_context,val2,
+                    &no_debug_addr_available,&addr2,error);
             }
-            if(no_debug_addr_available) {
-                res = DW_DLV_NO_ENTRY;
-            } else {
-                res = _dwarf_extract_address_from_debug_addr(
-                    dbg,rctx->rh_context,val2,
-                    &addr2,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
             }
             if (res != DW_DLV_OK) {
-                no_debug_addr_available = TRUE;
                 e->rle_index_failed = TRUE;
+                e->rle_cooked1 = 0;
                 e->rle_cooked2 = 0;
-                return res;
             } else {
+                e->rle_cooked1 = addr1;
                 e->rle_cooked2 = addr2;
             }
             break;
         case DW_RLE_startx_length:
-            if(no_debug_addr_available) {
-                res = DW_DLV_NO_ENTRY;
-            } else {
-                res = _dwarf_extract_address_from_debug_addr(
-                    dbg,rctx->rh_context,val1,
-                    &addr1,error);
+            res = rle_debug_addr(dbg,rctx->rh_context,val1,
+                &no_debug_addr_available,&addr1,error);
+            if (res == DW_DLV_ERROR) {
+                return res;
             }
             if (res != DW_DLV_OK) {
-                no_debug_addr_available = TRUE;
                 e->rle_index_failed = TRUE;
-                e->rle_cooked2 = 0;
                 e->rle_cooked1 = 0;
-                return res;
-
+                e->rle_cooked2 = 0;
             } else {
                 e->rle_cooked1 = addr1;
                 e->rle_cooked2 = val2+addr1;
@@ -1060,6 +1081,16 @@ dwarf_rnglists_get_rle_head(
         if (ctx->cc_rnglists_base_present) {
             offset_in_rnglists = ctx->cc_rnglists_base;
 
+        } else if (ctx->cc_unit_type == DW_UT_split_compile ||
+            ctx->cc_unit_type == DW_UT_split_type) {
+            /*  A split unit has no DW_AT_rnglists_base:
+                its table is the unit's own contribution
+                to .debug_rnglists.dwo, at offset zero
+                in a .dwo.  New October 2026. */
+            Dwarf_Unsigned size = 0;
+
+            offset_in_rnglists = _dwarf_get_dwp_extra_offset(
+                &ctx->cc_dwp_offsets,DW_SECT_RNGLISTS,&size);
         } else {
             /* FIXME: check in tied file for a cc_rnglists_base */
             dwarfstring m;
@@ -138,6 +138,20 @@ struct Dwarf_Rnglists_Head_s {
 
 void _dwarf_rnglists_head_destructor(void *m);
 
+/*  Decodes the one range list entry at data, which is
+    at dataoffset in .debug_rnglists, without applying
+    any base address. */
+int _dwarf_read_single_rle_entry(Dwarf_Debug dbg,
+    Dwarf_Small   *data,
+    Dwarf_Unsigned dataoffset,
+    Dwarf_Small   *enddata,
+    unsigned       address_size,
+    unsigned      *bytes_count_out,
+    unsigned      *entry_kind,
+    Dwarf_Unsigned *entry_operand1,
+    Dwarf_Unsigned *entry_operand2,
+    Dwarf_Error   *err);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -112,6 +112,8 @@ dwarf_open_str_offsets_table_access(Dwarf_Debug dbg,
     local_table_data->so_next_table_offset = 0;
     local_table_data->so_wasted_section_bytes = 0;
     /*  get_alloc zeroed all the bits, no need to repeat that here. */
+    /*  The table points into the section till closed. */
+    _dwarf_pin_section(&dbg->de_debug_str_offsets);
     *table_data = local_table_data;
     return DW_DLV_OK;
 }
@@ -126,6 +128,7 @@ dwarf_close_str_offsets_table_access(
     VALIDATE_SOT(table_data)
     dbg = table_data->so_dbg;
     table_data->so_magic_value = 0xdead;
+    _dwarf_unpin_section(&dbg->de_debug_str_offsets);
     dwarf_dealloc(dbg,table_data, DW_DLA_STR_OFFSETS);
     return DW_DLV_OK;
 }
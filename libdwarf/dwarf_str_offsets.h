@@ -31,8 +31,9 @@
 
 
 struct  Dwarf_Str_Offsets_Table_s {
-    /*  pointers are to dwarf-memory valid till Dwarf_Debug
-        is closed..  None are to be deallocated. */
+    /*  pointers are to dwarf-memory valid till the table
+        is closed (the section stays pinned till then).
+        None are to be deallocated. */
     Dwarf_Unsigned so_magic_value;
     Dwarf_Debug  so_dbg;
 
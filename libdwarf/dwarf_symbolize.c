@@ -0,0 +1,381 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+
+/*  dwarf_symbolize_pcs(): many pcs to function, file,
+    line and column in one pass.  The pcs are sorted so
+    consecutive pcs mostly land in the same CU and the
+    same line table row.  The CU table, the per-CU
+    function trees and the line rows are those of
+    dwarf_inline_frames() (see dwarf_inline.h), so a
+    CU line program is decoded once however many
+    batches touch it. */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include <string.h>
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_line.h"
+#include "dwarf_inline.h"
+
+#define TRUE  1
+#define FALSE 0
+
+struct pc_slot_s {
+    Dwarf_Addr     ps_pc;
+    /* Where the pc is in the caller's arrays. */
+    Dwarf_Unsigned ps_index;
+};
+
+static int
+symbolize_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory in "
+        "dwarf_symbolize_pcs()");
+    return DW_DLV_ERROR;
+}
+
+static int
+pc_slot_compare(const void *l, const void *r)
+{
+    const struct pc_slot_s *lp = (const struct pc_slot_s *)l;
+    const struct pc_slot_s *rp = (const struct pc_slot_s *)r;
+
+    if (lp->ps_pc < rp->ps_pc) {
+        return -1;
+    }
+    if (lp->ps_pc > rp->ps_pc) {
+        return 1;
+    }
+    if (lp->ps_index < rp->ps_index) {
+        return -1;
+    }
+    if (lp->ps_index > rp->ps_index) {
+        return 1;
+    }
+    return 0;
+}
+
+static int
+row_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Inline_Line_Row_s *lp =
+        (const struct Dwarf_Inline_Line_Row_s *)l;
+    const struct Dwarf_Inline_Line_Row_s *rp =
+        (const struct Dwarf_Inline_Line_Row_s *)r;
+
+    if (lp->lr_low < rp->lr_low) {
+        return -1;
+    }
+    if (lp->lr_low > rp->lr_low) {
+        return 1;
+    }
+    if (lp->lr_high < rp->lr_high) {
+        return -1;
+    }
+    if (lp->lr_high > rp->lr_high) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Turns the rows of the CU line table into address
+    ranges: each row covers up to the address of the
+    next row of its sequence.  Rows sharing an address
+    give empty ranges except the last, matching what a
+    debugger reports.  A line table that cannot be read
+    leaves the CU without rows rather than failing the
+    batch. */
+static int
+build_rows(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Error *error)
+{
+    Dwarf_Line_Context line_context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed linecount = 0;
+    Dwarf_Error lerr = 0;
+    struct Dwarf_Inline_Line_Row_s *rows = 0;
+    Dwarf_Unsigned rowcount = 0;
+    Dwarf_Addr maxhigh = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned k = 0;
+    int res = 0;
+
+    cu->ic_rows_built = TRUE;
+    line_context = _dwarf_inline_cu_line_context(dbg,cu);
+    if (!line_context) {
+        return DW_DLV_OK;
+    }
+    res = dwarf_srclines_from_linecontext(line_context,
+        &lines,&linecount,&lerr);
+    if (res == DW_DLV_ERROR) {
+        dwarf_dealloc_error(dbg,lerr);
+        return DW_DLV_OK;
+    }
+    if (res == DW_DLV_NO_ENTRY || linecount < 2) {
+        return DW_DLV_OK;
+    }
+    rows = (struct Dwarf_Inline_Line_Row_s *)malloc(
+        (Dwarf_Unsigned)(linecount-1)*
+        sizeof(struct Dwarf_Inline_Line_Row_s));
+    if (!rows) {
+        return symbolize_alloc_error(dbg,error);
+    }
+    for (i = 0; i+1 < linecount; ++i) {
+        Dwarf_Line line = lines[i];
+        Dwarf_Line next = lines[i+1];
+        struct Dwarf_Inline_Line_Row_s *row = 0;
+
+        if (line->li_addr_line.li_l_data.li_end_sequence) {
+            continue;
+        }
+        if (next->li_address <= line->li_address) {
+            continue;
+        }
+        row = rows + rowcount++;
+        row->lr_low = line->li_address;
+        row->lr_high = next->li_address;
+        row->lr_max_high = 0;
+        row->lr_file = line->li_addr_line.li_l_data.li_file;
+        row->lr_line = line->li_addr_line.li_l_data.li_line;
+        row->lr_column = line->li_addr_line.li_l_data.li_column;
+    }
+    if (!rowcount) {
+        free(rows);
+        return DW_DLV_OK;
+    }
+    /*  Sequences are usually in address order already,
+        but nothing requires it. */
+    qsort(rows,rowcount,sizeof(struct Dwarf_Inline_Line_Row_s),
+        row_compare);
+    for (k = 0; k < rowcount; ++k) {
+        if (rows[k].lr_high > maxhigh) {
+            maxhigh = rows[k].lr_high;
+        }
+        rows[k].lr_max_high = maxhigh;
+    }
+    cu->ic_rows = rows;
+    cu->ic_row_count = rowcount;
+    return DW_DLV_OK;
+}
+
+/*  Returns the row covering pc or -1.  hint is the row
+    found for the previous (lower or equal) pc of the
+    batch, -1 if none. */
+static Dwarf_Signed
+find_row(struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Addr pc,
+    Dwarf_Signed hint)
+{
+    struct Dwarf_Inline_Line_Row_s *rows = cu->ic_rows;
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = cu->ic_row_count;
+
+    if (hint >= 0) {
+        Dwarf_Unsigned h = (Dwarf_Unsigned)hint;
+
+        if (rows[h].lr_low <= pc && pc < rows[h].lr_high &&
+            (h+1 >= hi || rows[h+1].lr_low > pc)) {
+            return hint;
+        }
+        if (h+1 < hi && rows[h+1].lr_low <= pc &&
+            pc < rows[h+1].lr_high &&
+            (h+2 >= hi || rows[h+2].lr_low > pc)) {
+            return hint+1;
+        }
+    }
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (rows[mid].lr_low <= pc) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    /*  Prefer the last row starting at or before pc,
+        walking back only while an earlier, overlapping
+        sequence could still reach pc. */
+    while (lo > 0 && rows[lo-1].lr_max_high > pc) {
+        --lo;
+        if (pc < rows[lo].lr_high) {
+            return (Dwarf_Signed)lo;
+        }
+    }
+    return -1;
+}
+
+static void
+fill_location(Dwarf_Debug dbg,
+    struct Dwarf_Inline_CU_s *cu,
+    Dwarf_Addr pc,
+    Dwarf_Signed *row_hint,
+    Dwarf_Symbolized_Pc *out)
+{
+    struct Dwarf_Inline_Range_s *chain[DW_INLINE_MAX_DEPTH+1];
+    Dwarf_Unsigned depth = 0;
+    Dwarf_Signed rowindex = -1;
+
+    out->sp_cu_die_offset = cu->ic_cu_die_offset;
+    depth = _dwarf_inline_chain(cu,pc,chain);
+    if (depth) {
+        struct Dwarf_Inline_Range_s *r = chain[depth-1];
+        struct Dwarf_Inline_Node_s *n = cu->ic_nodes + r->ir_node;
+
+        out->sp_function = _dwarf_inline_node_string(cu,n->in_name);
+        out->sp_linkage_name = _dwarf_inline_node_string(cu,
+            n->in_linkage_name);
+        out->sp_function_die_offset = n->in_die_offset;
+        out->sp_function_lowpc = r->ir_low;
+        out->sp_status = DW_DLV_OK;
+    }
+    if (cu->ic_row_count) {
+        rowindex = find_row(cu,pc,*row_hint);
+    }
+    *row_hint = rowindex;
+    if (rowindex >= 0) {
+        struct Dwarf_Inline_Line_Row_s *row = cu->ic_rows + rowindex;
+        Dwarf_Error lerr = 0;
+        const char *path = 0;
+        int res = 0;
+
+        res = dwarf_srclines_file_path(cu->ic_line_context,
+            (Dwarf_Signed)row->lr_file,&path,&lerr);
+        if (res == DW_DLV_ERROR) {
+            dwarf_dealloc_error(dbg,lerr);
+            path = 0;
+        } else if (res == DW_DLV_NO_ENTRY) {
+            path = 0;
+        }
+        out->sp_file = path;
+        out->sp_line = row->lr_line;
+        out->sp_column = row->lr_column;
+        out->sp_status = DW_DLV_OK;
+    }
+}
+
+int
+dwarf_symbolize_pcs(Dwarf_Debug dbg,
+    const Dwarf_Addr *pcs,
+    Dwarf_Unsigned count,
+    Dwarf_Symbolized_Pc *results,
+    Dwarf_Error *error)
+{
+    struct pc_slot_s *slots = 0;
+    struct Dwarf_Inline_CU_s *cu = 0;
+    struct Dwarf_Inline_Range_s *curange = 0;
+    Dwarf_Symbolized_Pc *prev = 0;
+    Dwarf_Signed row_hint = -1;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!count) {
+        return DW_DLV_OK;
+    }
+    if (!pcs || !results) {
+        _dwarf_error_string(dbg, error, DW_DLE_INLINE_TREE_ERROR,
+            "DW_DLE_INLINE_TREE_ERROR: dwarf_symbolize_pcs() "
+            "passed a NULL array");
+        return DW_DLV_ERROR;
+    }
+    if (count > ((Dwarf_Unsigned)-1)/sizeof(struct pc_slot_s)) {
+        return symbolize_alloc_error(dbg,error);
+    }
+    slots = (struct pc_slot_s *)malloc(
+        count*sizeof(struct pc_slot_s));
+    if (!slots) {
+        return symbolize_alloc_error(dbg,error);
+    }
+    for (i = 0; i < count; ++i) {
+        slots[i].ps_pc = pcs[i];
+        slots[i].ps_index = i;
+    }
+    qsort(slots,count,sizeof(struct pc_slot_s),pc_slot_compare);
+    for (i = 0; i < count; ++i) {
+        Dwarf_Addr pc = slots[i].ps_pc;
+        Dwarf_Symbolized_Pc *out = results + slots[i].ps_index;
+
+        if (prev && i > 0 && slots[i-1].ps_pc == pc) {
+            *out = *prev;
+            continue;
+        }
+        prev = out;
+        memset(out,0,sizeof(*out));
+        out->sp_status = DW_DLV_NO_ENTRY;
+        if (!curange || pc < curange->ir_low ||
+            pc >= curange->ir_high) {
+            struct Dwarf_Inline_CU_s *newcu = 0;
+
+            res = _dwarf_inline_find_cu(dbg,pc,&newcu,&curange,error);
+            if (res == DW_DLV_ERROR) {
+                free(slots);
+                return res;
+            }
+            if (res == DW_DLV_NO_ENTRY) {
+                cu = 0;
+                curange = 0;
+                continue;
+            }
+            if (newcu != cu) {
+                cu = newcu;
+                row_hint = -1;
+            }
+            res = _dwarf_inline_build_cu(dbg,cu,error);
+            if (res != DW_DLV_OK) {
+                free(slots);
+                return res;
+            }
+            if (!cu->ic_rows_built) {
+                res = build_rows(dbg,cu,error);
+                if (res != DW_DLV_OK) {
+                    free(slots);
+                    return res;
+                }
+            }
+        }
+        fill_location(dbg,cu,pc,&row_hint,out);
+    }
+    free(slots);
+    return DW_DLV_OK;
+}
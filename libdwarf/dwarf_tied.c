@@ -191,6 +191,7 @@ _dwarf_loop_reading_debug_info_for_cu(
                 return DW_DLV_NO_ENTRY;
             }
             /* Insert this signature and context. */
+            tieddbg->de_perf_counters.pc_tsearch_ops++;
             retval = dwarf_tsearch(entry,
                 &tieddbg->de_tied_data.td_tied_search,
                 _dwarf_tied_compare_function);
@@ -239,6 +240,7 @@ _dwarf_search_for_signature(Dwarf_Debug tieddbg,
     }
     entry.dt_key = sig;
     entry.dt_context = 0;
+    tieddbg->de_perf_counters.pc_tsearch_ops++;
     entry2 = dwarf_tfind(&entry,
         &tied->td_tied_search,
         _dwarf_tied_compare_function);
@@ -257,6 +259,7 @@ _dwarf_search_for_signature(Dwarf_Debug tieddbg,
     if (res == DW_DLV_ERROR) {
         return res;
     }
+    tieddbg->de_perf_counters.pc_tsearch_ops++;
     entry2 = dwarf_tfind(&entry,
         &tied->td_tied_search,
         _dwarf_tied_compare_function);
@@ -268,3 +271,44 @@ _dwarf_search_for_signature(Dwarf_Debug tieddbg,
     }
     return DW_DLV_NO_ENTRY;
 }
+
+/*  Records the signature of context, a unit of tieddbg
+    found some other way, so a later
+    _dwarf_search_for_signature() finds it without
+    reading the units of tieddbg in order.
+    If out of memory just return DW_DLV_NO_ENTRY. */
+int
+_dwarf_tied_record_context(Dwarf_Debug tieddbg,
+    Dwarf_CU_Context context)
+{
+    struct Dwarf_Tied_Data_s * tied = &tieddbg->de_tied_data;
+    struct Dwarf_Tied_Entry_s *entry = 0;
+    void *retval = 0;
+
+    if (!context->cc_signature_present) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!tied->td_tied_search) {
+        dwarf_initialize_search_hash(&tied->td_tied_search,
+            _dwarf_tied_data_hashfunc,0);
+        if (!tied->td_tied_search) {
+            return DW_DLV_NO_ENTRY;
+        }
+    }
+    entry = _dwarf_tied_make_entry(&context->cc_signature,context);
+    if (!entry) {
+        return DW_DLV_NO_ENTRY;
+    }
+    tieddbg->de_perf_counters.pc_tsearch_ops++;
+    retval = dwarf_tsearch(entry,&tied->td_tied_search,
+        _dwarf_tied_compare_function);
+    if (!retval) {
+        free(entry);
+        return DW_DLV_NO_ENTRY;
+    }
+    if (*(struct Dwarf_Tied_Entry_s **)retval != entry) {
+        /* Already recorded. */
+        free(entry);
+    }
+    return DW_DLV_OK;
+}
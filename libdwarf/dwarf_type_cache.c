@@ -0,0 +1,1705 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+
+/*  dwarf_type_info(): memoized DW_AT_type resolution
+    and C/C++ type name formatting.
+    See dwarf_type_cache.h for the layout of the cache.
+    Names are copied out of the string sections, so
+    the cache survives section eviction
+    (dwarf_set_section_memory_budget()). */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* For uintptr_t */
+#endif /* HAVE_STDINT_H */
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarfstring.h"
+#include "dwarf_tsearch.h"
+#include "dwarf_type_cache.h"
+
+#define TRUE  1
+#define FALSE 0
+
+static int format_node(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    const char *inner,
+    dwarfstring *out,
+    int depth,
+    Dwarf_Error *error);
+static int format_qualified(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Half qtag,
+    struct Dwarf_Type_Ref_s *ref,
+    const char *inner,
+    dwarfstring *out,
+    int depth,
+    Dwarf_Error *error);
+
+static int
+type_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory in the type cache");
+    return DW_DLV_ERROR;
+}
+
+static int
+chain_error(Dwarf_Debug dbg, Dwarf_Off offset, Dwarf_Error *error)
+{
+    dwarfstring m;
+
+    dwarfstring_constructor(&m);
+    dwarfstring_append_printf_u(&m,
+        "DW_DLE_TYPE_CHAIN_ERROR: the type at DIE offset 0x%"
+        DW_PR_XZEROS DW_PR_DUx,offset);
+    dwarfstring_append_printf_i(&m,
+        " nests more than %d levels deep, likely a loop",
+        DW_TYPE_CHAIN_LIMIT);
+    _dwarf_error_string(dbg, error, DW_DLE_TYPE_CHAIN_ERROR,
+        dwarfstring_string(&m));
+    dwarfstring_destructor(&m);
+    return DW_DLV_ERROR;
+}
+
+static DW_TSHASHTYPE
+type_node_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Type_Node_s *n = keyp;
+
+    return (DW_TSHASHTYPE)(n->tn_offset ^ n->tn_is_info);
+}
+
+static int
+type_node_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Type_Node_s *lp = l;
+    const struct Dwarf_Type_Node_s *rp = r;
+
+    if (lp->tn_offset < rp->tn_offset) {
+        return -1;
+    }
+    if (lp->tn_offset > rp->tn_offset) {
+        return 1;
+    }
+    if (lp->tn_is_info < rp->tn_is_info) {
+        return -1;
+    }
+    if (lp->tn_is_info > rp->tn_is_info) {
+        return 1;
+    }
+    return 0;
+}
+
+static DW_TSHASHTYPE
+type_cu_hashfunc(const void *keyp)
+{
+    const struct Dwarf_Type_CU_s *c = keyp;
+
+    return (DW_TSHASHTYPE)(c->tu_offset ^ c->tu_is_info);
+}
+
+static int
+type_cu_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Type_CU_s *lp = l;
+    const struct Dwarf_Type_CU_s *rp = r;
+
+    if (lp->tu_offset < rp->tu_offset) {
+        return -1;
+    }
+    if (lp->tu_offset > rp->tu_offset) {
+        return 1;
+    }
+    if (lp->tu_is_info < rp->tu_is_info) {
+        return -1;
+    }
+    if (lp->tu_is_info > rp->tu_is_info) {
+        return 1;
+    }
+    return 0;
+}
+
+static void
+type_node_free(void *nodep)
+{
+    struct Dwarf_Type_Node_s *n = (struct Dwarf_Type_Node_s *)nodep;
+
+    free(n->tn_name);
+    free(n->tn_dims);
+    free(n->tn_params);
+    free(n->tn_formatted);
+    free(n->tn_canonical_formatted);
+    free(n);
+}
+
+static void
+type_cu_free(void *cup)
+{
+    struct Dwarf_Type_CU_s *c = (struct Dwarf_Type_CU_s *)cup;
+    Dwarf_Unsigned i = 0;
+
+    for (i = 0; i < c->tu_scope_count; ++i) {
+        free(c->tu_scopes[i].ts_prefix);
+    }
+    free(c->tu_scopes);
+    free(c);
+}
+
+void
+_dwarf_type_cache_destroy(Dwarf_Debug dbg)
+{
+    struct Dwarf_Type_Cache_s *cache = 0;
+
+    if (!dbg || !dbg->de_type_cache) {
+        return;
+    }
+    cache = dbg->de_type_cache;
+    if (cache->tc_nodes) {
+        dwarf_tdestroy(cache->tc_nodes,type_node_free);
+    }
+    if (cache->tc_cus) {
+        dwarf_tdestroy(cache->tc_cus,type_cu_free);
+    }
+    free(cache->tc_sigs);
+    free(cache);
+    dbg->de_type_cache = 0;
+}
+
+static Dwarf_Bool
+is_cplusplus(Dwarf_Unsigned lang)
+{
+    switch(lang) {
+    case DW_LANG_C_plus_plus:
+    case DW_LANG_C_plus_plus_03:
+    case DW_LANG_C_plus_plus_11:
+    case DW_LANG_C_plus_plus_14:
+    case DW_LANG_ObjC_plus_plus:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static Dwarf_Bool
+is_c(Dwarf_Unsigned lang)
+{
+    switch(lang) {
+    case DW_LANG_C89:
+    case DW_LANG_C:
+    case DW_LANG_C99:
+    case DW_LANG_C11:
+    case DW_LANG_ObjC:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static Dwarf_Bool
+is_fortran(Dwarf_Unsigned lang)
+{
+    switch(lang) {
+    case DW_LANG_Fortran77:
+    case DW_LANG_Fortran90:
+    case DW_LANG_Fortran95:
+    case DW_LANG_Fortran03:
+    case DW_LANG_Fortran08:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static Dwarf_Bool
+is_qualifier_tag(Dwarf_Half tag)
+{
+    switch(tag) {
+    case DW_TAG_typedef:
+    case DW_TAG_const_type:
+    case DW_TAG_volatile_type:
+    case DW_TAG_restrict_type:
+    case DW_TAG_atomic_type:
+    case DW_TAG_immutable_type:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static Dwarf_Bool
+is_pointer_tag(Dwarf_Half tag)
+{
+    switch(tag) {
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_reference_type:
+    case DW_TAG_ptr_to_member_type:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+/*  Reads a constant class attribute.  *present is FALSE
+    if the attribute is absent or not a constant
+    (a DW_AT_upper_bound may be an expression or a
+    reference for a variable length array). */
+static int
+die_constant(Dwarf_Die die,
+    Dwarf_Half attrnum,
+    Dwarf_Bool *present,
+    Dwarf_Signed *value,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = die->di_cu_context->cc_dbg;
+    Dwarf_Attribute attr = 0;
+    Dwarf_Half form = 0;
+    int res = 0;
+
+    *present = FALSE;
+    res = dwarf_attr(die,attrnum,&attr,error);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+    }
+    res = dwarf_whatform(attr,&form,error);
+    if (res == DW_DLV_OK) {
+        switch(form) {
+        case DW_FORM_sdata:
+        case DW_FORM_implicit_const:
+            res = dwarf_formsdata(attr,value,error);
+            *present = (res == DW_DLV_OK);
+            break;
+        case DW_FORM_data1:
+        case DW_FORM_data2:
+        case DW_FORM_data4:
+        case DW_FORM_data8:
+        case DW_FORM_udata: {
+            Dwarf_Unsigned uval = 0;
+
+            res = dwarf_formudata(attr,&uval,error);
+            *value = (Dwarf_Signed)uval;
+            *present = (res == DW_DLV_OK);
+            break;
+        }
+        default:
+            break;
+        }
+    }
+    dwarf_dealloc(dbg,attr,DW_DLA_ATTR);
+    return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+}
+
+static int
+sig_compare(const void *l, const void *r)
+{
+    const struct Dwarf_Type_Sig_s *lp = l;
+    const struct Dwarf_Type_Sig_s *rp = r;
+
+    return memcmp(&lp->tg_sig,&rp->tg_sig,sizeof(Dwarf_Sig8));
+}
+
+/*  Records the signature of every type unit in one
+    section, walking unit headers by offset so a CU loop
+    of the caller is not disturbed. */
+static int
+build_sigs_in(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Bool is_info,
+    Dwarf_Error *error)
+{
+    Dwarf_Off offset = 0;
+    Dwarf_Unsigned secsize = is_info?
+        dbg->de_debug_info.dss_size:
+        dbg->de_debug_types.dss_size;
+    int res = 0;
+
+    while (offset < secsize) {
+        Dwarf_Off dieoffset = 0;
+        Dwarf_Die udie = 0;
+        Dwarf_CU_Context context = 0;
+        Dwarf_Off next = 0;
+
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,offset,is_info,&dieoffset,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        res = dwarf_offdie_b(dbg,dieoffset,is_info,&udie,error);
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        context = udie->di_cu_context;
+        next = context->cc_debug_offset + context->cc_length +
+            context->cc_length_size + context->cc_extension_size;
+        if (context->cc_signature_present &&
+            (!is_info || context->cc_unit_type == DW_UT_type ||
+            context->cc_unit_type == DW_UT_split_type)) {
+            struct Dwarf_Type_Sig_s *sg = 0;
+
+            if (cache->tc_sig_count >= cache->tc_sig_alloc) {
+                Dwarf_Unsigned newalloc = cache->tc_sig_alloc?
+                    cache->tc_sig_alloc*2:16;
+                struct Dwarf_Type_Sig_s *newsigs =
+                    (struct Dwarf_Type_Sig_s *)realloc(
+                    cache->tc_sigs,
+                    newalloc*sizeof(struct Dwarf_Type_Sig_s));
+
+                if (!newsigs) {
+                    dwarf_dealloc_die(udie);
+                    return type_alloc_error(dbg,error);
+                }
+                cache->tc_sigs = newsigs;
+                cache->tc_sig_alloc = newalloc;
+            }
+            sg = cache->tc_sigs + cache->tc_sig_count++;
+            sg->tg_sig = context->cc_signature;
+            sg->tg_is_info = is_info;
+            sg->tg_type_offset = context->cc_debug_offset +
+                context->cc_signature_offset;
+        }
+        dwarf_dealloc_die(udie);
+        if (next <= offset) {
+            break;
+        }
+        offset = next;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+find_sig(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Sig8 *sig,
+    struct Dwarf_Type_Ref_s *ref,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Sig_s key;
+    struct Dwarf_Type_Sig_s *found = 0;
+    int res = 0;
+
+    if (!cache->tc_sigs_built) {
+        cache->tc_sigs_built = TRUE;
+        res = _dwarf_load_debug_info(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        res = _dwarf_load_debug_types(dbg,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        res = build_sigs_in(dbg,cache,TRUE,error);
+        if (res == DW_DLV_OK) {
+            res = build_sigs_in(dbg,cache,FALSE,error);
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (cache->tc_sig_count) {
+            qsort(cache->tc_sigs,cache->tc_sig_count,
+                sizeof(struct Dwarf_Type_Sig_s),sig_compare);
+        }
+    }
+    ref->tr_present = TRUE;
+    ref->tr_offset = 0;
+    if (!cache->tc_sig_count) {
+        return DW_DLV_OK;
+    }
+    memset(&key,0,sizeof(key));
+    key.tg_sig = *sig;
+    found = (struct Dwarf_Type_Sig_s *)bsearch(&key,
+        cache->tc_sigs,cache->tc_sig_count,
+        sizeof(struct Dwarf_Type_Sig_s),sig_compare);
+    if (found) {
+        ref->tr_is_info = found->tg_is_info;
+        ref->tr_offset = found->tg_type_offset;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Reads a reference attribute of die, following
+    DW_FORM_ref_sig8 to its type unit. */
+static int
+read_ref(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Die die,
+    Dwarf_Half attrnum,
+    struct Dwarf_Type_Ref_s *ref,
+    Dwarf_Error *error)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Half form = 0;
+    int res = 0;
+
+    memset(ref,0,sizeof(*ref));
+    res = dwarf_attr(die,attrnum,&attr,error);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+    }
+    res = dwarf_whatform(attr,&form,error);
+    if (res == DW_DLV_OK) {
+        if (form == DW_FORM_ref_sig8) {
+            Dwarf_Sig8 sig;
+
+            memset(&sig,0,sizeof(sig));
+            res = dwarf_formsig8(attr,&sig,error);
+            if (res == DW_DLV_OK) {
+                res = find_sig(dbg,cache,&sig,ref,error);
+            }
+        } else {
+            res = dwarf_global_formref(attr,&ref->tr_offset,error);
+            if (res == DW_DLV_OK) {
+                ref->tr_present = TRUE;
+                ref->tr_is_info = die->di_cu_context->cc_is_info;
+            }
+        }
+    }
+    dwarf_dealloc(dbg,attr,DW_DLA_ATTR);
+    return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+}
+
+static int
+get_cache(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s **cache_out,
+    Dwarf_Error *error)
+{
+    if (!dbg->de_type_cache) {
+        dbg->de_type_cache = (struct Dwarf_Type_Cache_s *)calloc(1,
+            sizeof(struct Dwarf_Type_Cache_s));
+        if (!dbg->de_type_cache) {
+            return type_alloc_error(dbg,error);
+        }
+    }
+    *cache_out = dbg->de_type_cache;
+    return DW_DLV_OK;
+}
+
+static int
+get_cu(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Die die,
+    struct Dwarf_Type_CU_s **cu_out,
+    Dwarf_Error *error)
+{
+    Dwarf_CU_Context context = die->di_cu_context;
+    struct Dwarf_Type_CU_s key;
+    struct Dwarf_Type_CU_s *cu = 0;
+    Dwarf_Off cudieoff = 0;
+    Dwarf_Die cudie = 0;
+    void *found = 0;
+    int res = 0;
+
+    memset(&key,0,sizeof(key));
+    key.tu_offset = context->cc_debug_offset;
+    key.tu_is_info = context->cc_is_info;
+    if (cache->tc_cus) {
+        dbg->de_perf_counters.pc_tsearch_ops++;
+        found = dwarf_tfind(&key,&cache->tc_cus,type_cu_compare);
+        if (found) {
+            *cu_out = *(struct Dwarf_Type_CU_s **)found;
+            return DW_DLV_OK;
+        }
+    }
+    cu = (struct Dwarf_Type_CU_s *)calloc(1,
+        sizeof(struct Dwarf_Type_CU_s));
+    if (!cu) {
+        return type_alloc_error(dbg,error);
+    }
+    *cu = key;
+    cu->tu_address_size = context->cc_address_size;
+    res = dwarf_CU_dieoffset_given_die(die,&cudieoff,error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_offdie_b(dbg,cudieoff,context->cc_is_info,
+            &cudie,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_srclang(cudie,&cu->tu_language,error);
+        dwarf_dealloc_die(cudie);
+    }
+    if (res == DW_DLV_ERROR) {
+        free(cu);
+        return res;
+    }
+    if (!cache->tc_cus) {
+        dwarf_initialize_search_hash(&cache->tc_cus,
+            type_cu_hashfunc,0);
+    }
+    found = 0;
+    if (cache->tc_cus) {
+        dbg->de_perf_counters.pc_tsearch_ops++;
+        found = dwarf_tsearch(cu,&cache->tc_cus,type_cu_compare);
+    }
+    if (!found) {
+        free(cu);
+        return type_alloc_error(dbg,error);
+    }
+    *cu_out = cu;
+    return DW_DLV_OK;
+}
+
+static int
+append_dim(Dwarf_Debug dbg,
+    struct Dwarf_Type_Node_s *node,
+    Dwarf_Signed dim,
+    Dwarf_Error *error)
+{
+    Dwarf_Signed *newdims = (Dwarf_Signed *)realloc(node->tn_dims,
+        (node->tn_dim_count+1)*sizeof(Dwarf_Signed));
+
+    if (!newdims) {
+        return type_alloc_error(dbg,error);
+    }
+    node->tn_dims = newdims;
+    node->tn_dims[node->tn_dim_count++] = dim;
+    return DW_DLV_OK;
+}
+
+static int
+append_param(Dwarf_Debug dbg,
+    struct Dwarf_Type_Node_s *node,
+    struct Dwarf_Type_Ref_s *ref,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Ref_s *newparams =
+        (struct Dwarf_Type_Ref_s *)realloc(node->tn_params,
+        (node->tn_param_count+1)*sizeof(struct Dwarf_Type_Ref_s));
+
+    if (!newparams) {
+        return type_alloc_error(dbg,error);
+    }
+    node->tn_params = newparams;
+    node->tn_params[node->tn_param_count++] = *ref;
+    return DW_DLV_OK;
+}
+
+/*  One array dimension from a DW_TAG_subrange_type,
+    -1 if not a constant. */
+static int
+subrange_dim(Dwarf_Die child,
+    struct Dwarf_Type_Node_s *node,
+    Dwarf_Signed *dim,
+    Dwarf_Error *error)
+{
+    Dwarf_Bool present = FALSE;
+    Dwarf_Signed value = 0;
+    Dwarf_Signed lower = is_fortran(node->tn_cu->tu_language)?1:0;
+    int res = 0;
+
+    *dim = -1;
+    res = die_constant(child,DW_AT_count,&present,&value,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (present) {
+        *dim = value;
+        return DW_DLV_OK;
+    }
+    res = die_constant(child,DW_AT_lower_bound,&present,&value,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (present) {
+        lower = value;
+    }
+    res = die_constant(child,DW_AT_upper_bound,&present,&value,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (present && value >= lower - 1) {
+        *dim = value - lower + 1;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Array dimensions and subroutine parameters. */
+static int
+read_children(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Die die,
+    struct Dwarf_Type_Node_s *node,
+    Dwarf_Error *error)
+{
+    Dwarf_Die child = 0;
+    int res = 0;
+
+    res = dwarf_child(die,&child,error);
+    if (res != DW_DLV_OK) {
+        return res == DW_DLV_NO_ENTRY? DW_DLV_OK:res;
+    }
+    while (child) {
+        Dwarf_Die sib = 0;
+        Dwarf_Half tag = 0;
+
+        res = dwarf_tag(child,&tag,error);
+        if (res == DW_DLV_OK) {
+            if (node->tn_tag == DW_TAG_array_type &&
+                (tag == DW_TAG_subrange_type ||
+                tag == DW_TAG_enumeration_type)) {
+                Dwarf_Signed dim = -1;
+
+                if (tag == DW_TAG_subrange_type) {
+                    res = subrange_dim(child,node,&dim,error);
+                }
+                if (res == DW_DLV_OK) {
+                    res = append_dim(dbg,node,dim,error);
+                }
+            } else if (node->tn_tag == DW_TAG_subroutine_type &&
+                tag == DW_TAG_formal_parameter) {
+                struct Dwarf_Type_Ref_s ref;
+
+                res = read_ref(dbg,cache,child,DW_AT_type,&ref,
+                    error);
+                if (res == DW_DLV_OK) {
+                    res = append_param(dbg,node,&ref,error);
+                }
+            } else if (node->tn_tag == DW_TAG_subroutine_type &&
+                tag == DW_TAG_unspecified_parameters) {
+                node->tn_varargs = TRUE;
+            }
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_siblingof_b(dbg,child,node->tn_is_info,
+                &sib,error);
+        }
+        dwarf_dealloc_die(child);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        child = sib;
+    }
+    return DW_DLV_OK;
+}
+
+static int
+load_node(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    Dwarf_Error *error)
+{
+    Dwarf_Die die = 0;
+    char *name = 0;
+    Dwarf_Bool present = FALSE;
+    Dwarf_Signed value = 0;
+    int res = 0;
+
+    res = dwarf_offdie_b(dbg,node->tn_offset,node->tn_is_info,
+        &die,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_tag(die,&node->tn_tag,error);
+    if (res == DW_DLV_OK) {
+        res = get_cu(dbg,cache,die,&node->tn_cu,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_diename(die,&name,error);
+        if (res == DW_DLV_OK) {
+            node->tn_name = strdup(name);
+            if (!node->tn_name) {
+                res = type_alloc_error(dbg,error);
+            }
+        } else if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+        }
+    }
+    if (res == DW_DLV_OK) {
+        res = read_ref(dbg,cache,die,DW_AT_type,&node->tn_target,
+            error);
+    }
+    if (res == DW_DLV_OK &&
+        node->tn_tag == DW_TAG_ptr_to_member_type) {
+        res = read_ref(dbg,cache,die,DW_AT_containing_type,
+            &node->tn_containing,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = read_ref(dbg,cache,die,DW_AT_specification,
+            &node->tn_specification,error);
+    }
+    if (res == DW_DLV_OK) {
+        res = die_constant(die,DW_AT_byte_size,&present,&value,
+            error);
+        if (res == DW_DLV_OK && present) {
+            node->tn_has_byte_size = TRUE;
+            node->tn_byte_size = (Dwarf_Unsigned)value;
+        }
+    }
+    if (res == DW_DLV_OK && node->tn_tag == DW_TAG_base_type) {
+        res = die_constant(die,DW_AT_encoding,&present,&value,error);
+        if (res == DW_DLV_OK && present) {
+            node->tn_encoding = (Dwarf_Half)value;
+        }
+    }
+    if (res == DW_DLV_OK && node->tn_tag == DW_TAG_subroutine_type) {
+        Dwarf_Attribute attr = 0;
+
+        res = dwarf_attr(die,DW_AT_prototyped,&attr,error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_formflag(attr,&node->tn_prototyped,error);
+            dwarf_dealloc(dbg,attr,DW_DLA_ATTR);
+        } else if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+        }
+    }
+    if (res == DW_DLV_OK && (node->tn_tag == DW_TAG_array_type ||
+        node->tn_tag == DW_TAG_subroutine_type)) {
+        res = read_children(dbg,cache,die,node,error);
+    }
+    dwarf_dealloc_die(die);
+    return res;
+}
+
+static int
+get_node(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Off offset,
+    Dwarf_Bool is_info,
+    struct Dwarf_Type_Node_s **node_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Node_s key;
+    struct Dwarf_Type_Node_s *node = 0;
+    void *found = 0;
+    int res = 0;
+
+    memset(&key,0,sizeof(key));
+    key.tn_offset = offset;
+    key.tn_is_info = is_info;
+    if (cache->tc_nodes) {
+        dbg->de_perf_counters.pc_tsearch_ops++;
+        found = dwarf_tfind(&key,&cache->tc_nodes,type_node_compare);
+        if (found) {
+            *node_out = *(struct Dwarf_Type_Node_s **)found;
+            return DW_DLV_OK;
+        }
+    }
+    node = (struct Dwarf_Type_Node_s *)calloc(1,
+        sizeof(struct Dwarf_Type_Node_s));
+    if (!node) {
+        return type_alloc_error(dbg,error);
+    }
+    node->tn_offset = offset;
+    node->tn_is_info = is_info;
+    res = load_node(dbg,cache,node,error);
+    if (res != DW_DLV_OK) {
+        type_node_free(node);
+        return res;
+    }
+    if (!cache->tc_nodes) {
+        dwarf_initialize_search_hash(&cache->tc_nodes,
+            type_node_hashfunc,0);
+    }
+    found = 0;
+    if (cache->tc_nodes) {
+        dbg->de_perf_counters.pc_tsearch_ops++;
+        found = dwarf_tsearch(node,&cache->tc_nodes,
+            type_node_compare);
+    }
+    if (!found) {
+        type_node_free(node);
+        return type_alloc_error(dbg,error);
+    }
+    *node_out = node;
+    return DW_DLV_OK;
+}
+
+static int
+append_scope(Dwarf_Debug dbg,
+    struct Dwarf_Type_CU_s *cu,
+    Dwarf_Off start,
+    Dwarf_Off end,
+    Dwarf_Signed parent,
+    const char *name,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Scope_s *s = 0;
+    const char *pprefix = parent < 0? "":
+        cu->tu_scopes[parent].ts_prefix;
+    size_t plen = strlen(pprefix);
+    size_t nlen = name? strlen(name):0;
+
+    if (cu->tu_scope_count >= cu->tu_scope_alloc) {
+        Dwarf_Unsigned newalloc = cu->tu_scope_alloc?
+            cu->tu_scope_alloc*2:16;
+        struct Dwarf_Type_Scope_s *newscopes =
+            (struct Dwarf_Type_Scope_s *)realloc(cu->tu_scopes,
+            newalloc*sizeof(struct Dwarf_Type_Scope_s));
+
+        if (!newscopes) {
+            return type_alloc_error(dbg,error);
+        }
+        cu->tu_scopes = newscopes;
+        cu->tu_scope_alloc = newalloc;
+        /* The parent prefix moved with the array. */
+        pprefix = parent < 0? "": cu->tu_scopes[parent].ts_prefix;
+    }
+    s = cu->tu_scopes + cu->tu_scope_count;
+    s->ts_start = start;
+    s->ts_end = end;
+    s->ts_parent = parent;
+    /*  An anonymous struct or union adds nothing
+        to the names inside it. */
+    s->ts_prefix = (char *)malloc(plen + nlen + 3);
+    if (!s->ts_prefix) {
+        return type_alloc_error(dbg,error);
+    }
+    memcpy(s->ts_prefix,pprefix,plen);
+    if (name) {
+        memcpy(s->ts_prefix+plen,name,nlen);
+        memcpy(s->ts_prefix+plen+nlen,"::",3);
+    } else {
+        s->ts_prefix[plen] = 0;
+    }
+    cu->tu_scope_count++;
+    return DW_DLV_OK;
+}
+
+/*  Records the scopes among die and its siblings,
+    descending into namespaces and classes only. */
+static int
+walk_scopes(Dwarf_Debug dbg,
+    struct Dwarf_Type_CU_s *cu,
+    Dwarf_Die die,
+    Dwarf_Off parent_end,
+    Dwarf_Signed parent,
+    int depth,
+    Dwarf_Error *error)
+{
+    int res = DW_DLV_OK;
+
+    if (depth > DW_TYPE_CHAIN_LIMIT) {
+        dwarf_dealloc_die(die);
+        return chain_error(dbg,cu->tu_offset,error);
+    }
+    while (die) {
+        Dwarf_Die sib = 0;
+        Dwarf_Half tag = 0;
+        Dwarf_Off start = 0;
+        Dwarf_Off end = parent_end;
+
+        res = dwarf_siblingof_b(dbg,die,cu->tu_is_info,&sib,error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_dieoffset(sib,&end,error);
+        } else if (res == DW_DLV_NO_ENTRY) {
+            res = DW_DLV_OK;
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_dieoffset(die,&start,error);
+        }
+        if (res == DW_DLV_OK) {
+            res = dwarf_tag(die,&tag,error);
+        }
+        if (res == DW_DLV_OK && (tag == DW_TAG_namespace ||
+            tag == DW_TAG_class_type ||
+            tag == DW_TAG_structure_type ||
+            tag == DW_TAG_union_type ||
+            tag == DW_TAG_interface_type)) {
+            char *name = 0;
+            Dwarf_Die child = 0;
+            Dwarf_Signed me = (Dwarf_Signed)cu->tu_scope_count;
+
+            res = dwarf_diename(die,&name,error);
+            if (res == DW_DLV_NO_ENTRY) {
+                name = tag == DW_TAG_namespace?
+                    "(anonymous namespace)":0;
+                res = DW_DLV_OK;
+            }
+            if (res == DW_DLV_OK) {
+                res = append_scope(dbg,cu,start,end,parent,name,
+                    error);
+            }
+            if (res == DW_DLV_OK) {
+                res = dwarf_child(die,&child,error);
+                if (res == DW_DLV_OK) {
+                    res = walk_scopes(dbg,cu,child,end,me,depth+1,
+                        error);
+                } else if (res == DW_DLV_NO_ENTRY) {
+                    res = DW_DLV_OK;
+                }
+            }
+        }
+        dwarf_dealloc_die(die);
+        if (res != DW_DLV_OK) {
+            if (sib) {
+                dwarf_dealloc_die(sib);
+            }
+            return res;
+        }
+        die = sib;
+    }
+    return DW_DLV_OK;
+}
+
+/*  The "ns::Class::" qualifier of a C++ DIE at offset,
+    "" if it is at the top level. */
+static int
+scope_prefix(Dwarf_Debug dbg,
+    struct Dwarf_Type_CU_s *cu,
+    Dwarf_Off offset,
+    const char **prefix_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lo = 0;
+    Dwarf_Unsigned hi = 0;
+    Dwarf_Signed i = 0;
+    int res = 0;
+
+    if (!cu->tu_scopes_built) {
+        Dwarf_Off cudieoff = 0;
+        Dwarf_Off cu_end = 0;
+        Dwarf_Die cudie = 0;
+        Dwarf_Die child = 0;
+        Dwarf_CU_Context context = 0;
+
+        cu->tu_scopes_built = TRUE;
+        res = dwarf_get_cu_die_offset_given_cu_header_offset_b(
+            dbg,cu->tu_offset,cu->tu_is_info,&cudieoff,error);
+        if (res == DW_DLV_OK) {
+            res = dwarf_offdie_b(dbg,cudieoff,cu->tu_is_info,
+                &cudie,error);
+        }
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        context = cudie->di_cu_context;
+        cu_end = context->cc_debug_offset + context->cc_length +
+            context->cc_length_size + context->cc_extension_size;
+        res = dwarf_child(cudie,&child,error);
+        dwarf_dealloc_die(cudie);
+        if (res == DW_DLV_OK) {
+            res = walk_scopes(dbg,cu,child,cu_end,-1,0,error);
+        }
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    *prefix_out = "";
+    hi = cu->tu_scope_count;
+    while (lo < hi) {
+        Dwarf_Unsigned mid = lo + (hi - lo)/2;
+
+        if (cu->tu_scopes[mid].ts_start < offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    /*  Scopes nest, so the one holding offset (if any)
+        is the last one starting before it or one of
+        its parents. */
+    for (i = (Dwarf_Signed)lo - 1; i >= 0;
+        i = cu->tu_scopes[i].ts_parent) {
+        if (offset < cu->tu_scopes[i].ts_end) {
+            *prefix_out = cu->tu_scopes[i].ts_prefix;
+            break;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Appends word, then a space and the declarator so far
+    unless that is empty or an array bound. */
+static void
+append_with_inner(dwarfstring *out,
+    const char *word,
+    const char *inner)
+{
+    dwarfstring_append(out,(char *)word);
+    if (inner[0]) {
+        if (inner[0] != '[') {
+            dwarfstring_append(out," ");
+        }
+        dwarfstring_append(out,(char *)inner);
+    }
+}
+
+/*  The C++ qualifier of node, from where its
+    DW_AT_specification declaration (if any) sits. */
+static int
+node_scope_prefix(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    const char **prefix_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Node_s *decl = node;
+    int hops = 0;
+    int res = 0;
+
+    while (decl->tn_specification.tr_present &&
+        decl->tn_specification.tr_offset) {
+        if (++hops > DW_TYPE_CHAIN_LIMIT) {
+            return chain_error(dbg,node->tn_offset,error);
+        }
+        res = get_node(dbg,cache,decl->tn_specification.tr_offset,
+            decl->tn_specification.tr_is_info,&decl,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    return scope_prefix(dbg,decl->tn_cu,decl->tn_offset,
+        prefix_out,error);
+}
+
+/*  The name of a type that does not nest another
+    (a base type, typedef, struct and so on). */
+static int
+append_named(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    const char *inner,
+    dwarfstring *out,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned lang = node->tn_cu->tu_language;
+    const char *keyword = 0;
+    const char *prefix = "";
+    dwarfstring word;
+    int res = 0;
+
+    switch(node->tn_tag) {
+    case DW_TAG_structure_type: keyword = "struct"; break;
+    case DW_TAG_class_type:     keyword = "class"; break;
+    case DW_TAG_union_type:     keyword = "union"; break;
+    case DW_TAG_enumeration_type: keyword = "enum"; break;
+    case DW_TAG_interface_type: keyword = "interface"; break;
+    default: break;
+    }
+    dwarfstring_constructor(&word);
+    if (!node->tn_name) {
+        if (keyword) {
+            dwarfstring_append(&word,(char *)keyword);
+            dwarfstring_append(&word," {...}");
+        } else if (node->tn_tag == DW_TAG_unspecified_type) {
+            dwarfstring_append(&word,"void");
+        } else {
+            dwarfstring_append(&word,"<unknown type>");
+        }
+        append_with_inner(out,dwarfstring_string(&word),inner);
+        dwarfstring_destructor(&word);
+        return DW_DLV_OK;
+    }
+    if (is_cplusplus(lang) && (keyword ||
+        node->tn_tag == DW_TAG_typedef)) {
+        res = node_scope_prefix(dbg,cache,node,&prefix,error);
+        if (res != DW_DLV_OK) {
+            dwarfstring_destructor(&word);
+            return res;
+        }
+    } else if (is_c(lang) && keyword) {
+        dwarfstring_append(&word,(char *)keyword);
+        dwarfstring_append(&word," ");
+    }
+    dwarfstring_append(&word,(char *)prefix);
+    dwarfstring_append(&word,node->tn_name);
+    append_with_inner(out,dwarfstring_string(&word),inner);
+    dwarfstring_destructor(&word);
+    return DW_DLV_OK;
+}
+
+/*  The full name of node, formatted once. */
+static int
+formatted_name(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    const char **name_out,
+    int depth,
+    Dwarf_Error *error)
+{
+    dwarfstring ds;
+    int res = 0;
+
+    if (!node->tn_formatted) {
+        dwarfstring_constructor(&ds);
+        res = format_node(dbg,cache,node,"",&ds,depth,error);
+        if (res != DW_DLV_OK) {
+            dwarfstring_destructor(&ds);
+            return res;
+        }
+        node->tn_formatted = strdup(dwarfstring_string(&ds));
+        dwarfstring_destructor(&ds);
+        if (!node->tn_formatted) {
+            return type_alloc_error(dbg,error);
+        }
+    }
+    *name_out = node->tn_formatted;
+    return DW_DLV_OK;
+}
+
+static int
+format_ref(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Ref_s *ref,
+    const char *inner,
+    dwarfstring *out,
+    int depth,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Node_s *node = 0;
+    int res = 0;
+
+    if (!ref->tr_present) {
+        append_with_inner(out,"void",inner);
+        return DW_DLV_OK;
+    }
+    if (!ref->tr_offset) {
+        append_with_inner(out,"<unknown type>",inner);
+        return DW_DLV_OK;
+    }
+    res = get_node(dbg,cache,ref->tr_offset,ref->tr_is_info,
+        &node,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!inner[0]) {
+        const char *name = 0;
+
+        res = formatted_name(dbg,cache,node,&name,depth,error);
+        if (res == DW_DLV_OK) {
+            dwarfstring_append(out,(char *)name);
+        }
+        return res;
+    }
+    return format_node(dbg,cache,node,inner,out,depth,error);
+}
+
+/*  A declarator wrapped in parentheses if it starts with
+    a pointer, as in int (*)[4] or void (*)(int). */
+static void
+append_wrapped(dwarfstring *d, const char *inner)
+{
+    if (inner[0] == '*' || inner[0] == '&') {
+        dwarfstring_append(d,"(");
+        dwarfstring_append(d,(char *)inner);
+        dwarfstring_append(d,")");
+    } else {
+        dwarfstring_append(d,(char *)inner);
+    }
+}
+
+/*  The keyword of a qualifier tag. */
+static const char *
+qualifier_word(Dwarf_Half tag)
+{
+    switch(tag) {
+    case DW_TAG_const_type:     return "const";
+    case DW_TAG_volatile_type:  return "volatile";
+    case DW_TAG_restrict_type:  return "restrict";
+    case DW_TAG_atomic_type:    return "_Atomic";
+    case DW_TAG_immutable_type: return "immutable";
+    default: break;
+    }
+    return "";
+}
+
+/*  Sets *has if ref, looking through typedefs and other
+    qualifiers, is already qualified by qtag. */
+static int
+ref_has_qualifier(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Ref_s *ref,
+    Dwarf_Half qtag,
+    Dwarf_Bool *has,
+    Dwarf_Error *error)
+{
+    int hops = 0;
+
+    *has = FALSE;
+    while (ref->tr_present && ref->tr_offset) {
+        struct Dwarf_Type_Node_s *node = 0;
+        int res = 0;
+
+        res = get_node(dbg,cache,ref->tr_offset,ref->tr_is_info,
+            &node,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (node->tn_tag == qtag) {
+            *has = TRUE;
+            return DW_DLV_OK;
+        }
+        if (!is_qualifier_tag(node->tn_tag)) {
+            break;
+        }
+        if (++hops > DW_TYPE_CHAIN_LIMIT) {
+            return chain_error(dbg,node->tn_offset,error);
+        }
+        ref = &node->tn_target;
+    }
+    return DW_DLV_OK;
+}
+
+/*  Formats an array of node's element type.  A qualifier
+    on an array qualifies its elements, so a qtag other
+    than zero is moved onto the element type (unless the
+    element already has it): the const on an array of
+    char *const prints as char *const [3], not
+    const char *const [3]. */
+static int
+format_array(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    Dwarf_Half qtag,
+    const char *inner,
+    dwarfstring *out,
+    int depth,
+    Dwarf_Error *error)
+{
+    dwarfstring d;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Bool has = FALSE;
+    int res = DW_DLV_OK;
+
+    dwarfstring_constructor(&d);
+    append_wrapped(&d,inner);
+    if (!node->tn_dim_count) {
+        dwarfstring_append(&d,"[]");
+    }
+    for (i = 0; i < node->tn_dim_count; ++i) {
+        if (node->tn_dims[i] < 0) {
+            dwarfstring_append(&d,"[]");
+        } else {
+            dwarfstring_append_printf_u(&d,"[%" DW_PR_DUu "]",
+                (Dwarf_Unsigned)node->tn_dims[i]);
+        }
+    }
+    if (!node->tn_target.tr_present) {
+        append_with_inner(out,"<unknown type>",
+            dwarfstring_string(&d));
+    } else {
+        if (qtag) {
+            res = ref_has_qualifier(dbg,cache,&node->tn_target,
+                qtag,&has,error);
+        }
+        if (res == DW_DLV_OK && qtag && !has) {
+            res = format_qualified(dbg,cache,qtag,&node->tn_target,
+                dwarfstring_string(&d),out,depth+1,error);
+        } else if (res == DW_DLV_OK) {
+            res = format_ref(dbg,cache,&node->tn_target,
+                dwarfstring_string(&d),out,depth+1,error);
+        }
+    }
+    dwarfstring_destructor(&d);
+    return res;
+}
+
+/*  Formats ref qualified by qtag as a declaration of
+    inner.  The qualifier follows a pointer (char *const)
+    and moves into an array (see format_array()). */
+static int
+format_qualified(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    Dwarf_Half qtag,
+    struct Dwarf_Type_Ref_s *ref,
+    const char *inner,
+    dwarfstring *out,
+    int depth,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Node_s *target = 0;
+    const char *qual = qualifier_word(qtag);
+    int res = DW_DLV_OK;
+
+    if (depth > DW_TYPE_CHAIN_LIMIT) {
+        return chain_error(dbg,ref->tr_offset,error);
+    }
+    if (ref->tr_present && ref->tr_offset) {
+        res = get_node(dbg,cache,ref->tr_offset,ref->tr_is_info,
+            &target,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (target && is_pointer_tag(target->tn_tag)) {
+        dwarfstring d;
+
+        /* char *const, the pointer is qualified. */
+        dwarfstring_constructor(&d);
+        dwarfstring_append(&d,(char *)qual);
+        if (inner[0]) {
+            dwarfstring_append(&d," ");
+            dwarfstring_append(&d,(char *)inner);
+        }
+        res = format_node(dbg,cache,target,
+            dwarfstring_string(&d),out,depth+1,error);
+        dwarfstring_destructor(&d);
+        return res;
+    }
+    if (target && target->tn_tag == DW_TAG_array_type) {
+        return format_array(dbg,cache,target,qtag,inner,out,
+            depth+1,error);
+    }
+    dwarfstring_append(out,(char *)qual);
+    dwarfstring_append(out," ");
+    return format_ref(dbg,cache,ref,inner,out,depth+1,error);
+}
+
+/*  Formats node as a C declaration of inner, the
+    declarator built so far by the enclosing types
+    (so "*" for a pointer to node), the way the
+    declaration reads inside out. */
+static int
+format_node(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    const char *inner,
+    dwarfstring *out,
+    int depth,
+    Dwarf_Error *error)
+{
+    dwarfstring d;
+    Dwarf_Unsigned i = 0;
+    int res = DW_DLV_OK;
+
+    if (depth > DW_TYPE_CHAIN_LIMIT) {
+        return chain_error(dbg,node->tn_offset,error);
+    }
+    dwarfstring_constructor(&d);
+    switch(node->tn_tag) {
+    case DW_TAG_pointer_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_rvalue_reference_type:
+        dwarfstring_append(&d,
+            node->tn_tag == DW_TAG_pointer_type? "*":
+            node->tn_tag == DW_TAG_reference_type? "&":"&&");
+        dwarfstring_append(&d,(char *)inner);
+        res = format_ref(dbg,cache,&node->tn_target,
+            dwarfstring_string(&d),out,depth+1,error);
+        break;
+    case DW_TAG_ptr_to_member_type: {
+        const char *cname = "<unknown type>";
+        struct Dwarf_Type_Node_s *cnode = 0;
+
+        if (node->tn_containing.tr_present &&
+            node->tn_containing.tr_offset) {
+            res = get_node(dbg,cache,node->tn_containing.tr_offset,
+                node->tn_containing.tr_is_info,&cnode,error);
+            if (res == DW_DLV_OK) {
+                res = formatted_name(dbg,cache,cnode,&cname,
+                    depth+1,error);
+            }
+        }
+        if (res == DW_DLV_OK) {
+            dwarfstring_append(&d,(char *)cname);
+            dwarfstring_append(&d,"::*");
+            dwarfstring_append(&d,(char *)inner);
+            res = format_ref(dbg,cache,&node->tn_target,
+                dwarfstring_string(&d),out,depth+1,error);
+        }
+        break;
+    }
+    case DW_TAG_const_type:
+    case DW_TAG_volatile_type:
+    case DW_TAG_restrict_type:
+    case DW_TAG_atomic_type:
+    case DW_TAG_immutable_type:
+        res = format_qualified(dbg,cache,node->tn_tag,
+            &node->tn_target,inner,out,depth,error);
+        break;
+    case DW_TAG_array_type:
+        res = format_array(dbg,cache,node,0,inner,out,depth,error);
+        break;
+    case DW_TAG_subroutine_type:
+        append_wrapped(&d,inner);
+        dwarfstring_append(&d,"(");
+        for (i = 0; i < node->tn_param_count && res == DW_DLV_OK;
+            ++i) {
+            if (i) {
+                dwarfstring_append(&d,", ");
+            }
+            res = format_ref(dbg,cache,node->tn_params+i,"",&d,
+                depth+1,error);
+        }
+        if (node->tn_varargs && !node->tn_param_count &&
+            !node->tn_prototyped &&
+            !is_cplusplus(node->tn_cu->tu_language)) {
+            /*  An unprototyped C function, int (*)(). */
+        } else if (node->tn_varargs) {
+            dwarfstring_append(&d,node->tn_param_count?
+                ", ...":"...");
+        } else if (!node->tn_param_count && node->tn_prototyped &&
+            !is_cplusplus(node->tn_cu->tu_language)) {
+            dwarfstring_append(&d,"void");
+        }
+        dwarfstring_append(&d,")");
+        if (res == DW_DLV_OK) {
+            res = format_ref(dbg,cache,&node->tn_target,
+                dwarfstring_string(&d),out,depth+1,error);
+        }
+        break;
+    default:
+        res = append_named(dbg,cache,node,inner,out,error);
+        break;
+    }
+    dwarfstring_destructor(&d);
+    return res;
+}
+
+/*  Fills in tn_info: peels typedefs and qualifiers to
+    the canonical type and takes its size, encoding and
+    target, deriving a size where DWARF leaves it out
+    (pointers, arrays, enumerations). */
+static int
+resolve_node(Dwarf_Debug dbg,
+    struct Dwarf_Type_Cache_s *cache,
+    struct Dwarf_Type_Node_s *node,
+    int depth,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Node_s *canon = node;
+    Dwarf_Type_Info *info = &node->tn_info;
+    const char *name = 0;
+    int hops = 0;
+    int res = 0;
+
+    if (node->tn_resolved) {
+        return DW_DLV_OK;
+    }
+    if (depth > DW_TYPE_CHAIN_LIMIT) {
+        return chain_error(dbg,node->tn_offset,error);
+    }
+    memset(info,0,sizeof(*info));
+    info->ti_offset = node->tn_offset;
+    info->ti_is_info = node->tn_is_info;
+    info->ti_tag = node->tn_tag;
+    while (canon && is_qualifier_tag(canon->tn_tag)) {
+        struct Dwarf_Type_Ref_s *t = &canon->tn_target;
+
+        if (!t->tr_present || !t->tr_offset) {
+            /*  void, or a type unit that is missing. */
+            canon = 0;
+            break;
+        }
+        if (++hops > DW_TYPE_CHAIN_LIMIT) {
+            return chain_error(dbg,node->tn_offset,error);
+        }
+        res = get_node(dbg,cache,t->tr_offset,t->tr_is_info,
+            &canon,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+    }
+    if (canon) {
+        struct Dwarf_Type_Ref_s *t = &canon->tn_target;
+
+        info->ti_canonical_offset = canon->tn_offset;
+        info->ti_canonical_is_info = canon->tn_is_info;
+        info->ti_canonical_tag = canon->tn_tag;
+        info->ti_encoding = canon->tn_encoding;
+        if (t->tr_present && t->tr_offset) {
+            info->ti_has_target = TRUE;
+            info->ti_target_offset = t->tr_offset;
+            info->ti_target_is_info = t->tr_is_info;
+        }
+        if (canon->tn_has_byte_size) {
+            info->ti_has_byte_size = TRUE;
+            info->ti_byte_size = canon->tn_byte_size;
+        } else if (is_pointer_tag(canon->tn_tag) &&
+            canon->tn_tag != DW_TAG_ptr_to_member_type) {
+            info->ti_has_byte_size = TRUE;
+            info->ti_byte_size = canon->tn_cu->tu_address_size;
+        } else if (info->ti_has_target &&
+            (canon->tn_tag == DW_TAG_array_type ||
+            canon->tn_tag == DW_TAG_enumeration_type)) {
+            struct Dwarf_Type_Node_s *elem = 0;
+
+            res = get_node(dbg,cache,t->tr_offset,t->tr_is_info,
+                &elem,error);
+            if (res == DW_DLV_OK) {
+                res = resolve_node(dbg,cache,elem,depth+1,error);
+            }
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            if (canon->tn_tag == DW_TAG_enumeration_type) {
+                info->ti_has_byte_size = elem->tn_info.ti_has_byte_size;
+                info->ti_byte_size = elem->tn_info.ti_byte_size;
+                info->ti_encoding = elem->tn_info.ti_encoding;
+            } else if (elem->tn_info.ti_has_byte_size &&
+                canon->tn_dim_count) {
+                Dwarf_Unsigned size = elem->tn_info.ti_byte_size;
+                Dwarf_Unsigned i = 0;
+
+                info->ti_has_byte_size = TRUE;
+                for (i = 0; i < canon->tn_dim_count; ++i) {
+                    if (canon->tn_dims[i] < 0) {
+                        info->ti_has_byte_size = FALSE;
+                        break;
+                    }
+                    size *= (Dwarf_Unsigned)canon->tn_dims[i];
+                }
+                info->ti_byte_size = info->ti_has_byte_size? size:0;
+            }
+        }
+        if (canon->tn_tag == DW_TAG_enumeration_type &&
+            !info->ti_encoding && info->ti_has_target) {
+            struct Dwarf_Type_Node_s *under = 0;
+
+            res = get_node(dbg,cache,t->tr_offset,t->tr_is_info,
+                &under,error);
+            if (res == DW_DLV_OK) {
+                res = resolve_node(dbg,cache,under,depth+1,error);
+            }
+            if (res != DW_DLV_OK) {
+                return res;
+            }
+            info->ti_encoding = under->tn_info.ti_encoding;
+        }
+        res = formatted_name(dbg,cache,canon,&name,depth+1,error);
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        info->ti_canonical_name = name;
+    } else {
+        info->ti_canonical_name = "void";
+    }
+    res = formatted_name(dbg,cache,node,&name,depth+1,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    info->ti_name = name;
+    node->tn_resolved = TRUE;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_type_info(Dwarf_Debug dbg,
+    Dwarf_Off type_offset,
+    Dwarf_Bool is_info,
+    Dwarf_Type_Info *info,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Type_Cache_s *cache = 0;
+    struct Dwarf_Type_Node_s *node = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!info) {
+        _dwarf_error_string(dbg, error, DW_DLE_TYPE_CHAIN_ERROR,
+            "DW_DLE_TYPE_CHAIN_ERROR: dwarf_type_info() "
+            "passed a NULL result pointer");
+        return DW_DLV_ERROR;
+    }
+    res = get_cache(dbg,&cache,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = get_node(dbg,cache,type_offset,is_info,&node,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = resolve_node(dbg,cache,node,0,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    *info = node->tn_info;
+    return DW_DLV_OK;
+}
+
+int
+dwarf_die_type_info(Dwarf_Die die,
+    Dwarf_Type_Info *info,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = 0;
+    struct Dwarf_Type_Cache_s *cache = 0;
+    struct Dwarf_Type_Ref_s ref;
+    int res = 0;
+
+    CHECK_DIE(die, DW_DLV_ERROR);
+    dbg = die->di_cu_context->cc_dbg;
+    res = get_cache(dbg,&cache,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = read_ref(dbg,cache,die,DW_AT_type,&ref,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    if (!ref.tr_present) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!ref.tr_offset) {
+        _dwarf_error(dbg, error, DW_DLE_REF_SIG8_NOT_HANDLED);
+        return DW_DLV_ERROR;
+    }
+    return dwarf_type_info(dbg,ref.tr_offset,ref.tr_is_info,info,
+        error);
+}
+
+int
+dwarf_type_name(Dwarf_Debug dbg,
+    Dwarf_Off type_offset,
+    Dwarf_Bool is_info,
+    const char **name,
+    Dwarf_Error *error)
+{
+    Dwarf_Type_Info info;
+    int res = 0;
+
+    if (!name) {
+        _dwarf_error_string(dbg, error, DW_DLE_TYPE_CHAIN_ERROR,
+            "DW_DLE_TYPE_CHAIN_ERROR: dwarf_type_name() "
+            "passed a NULL result pointer");
+        return DW_DLV_ERROR;
+    }
+    res = dwarf_type_info(dbg,type_offset,is_info,&info,error);
+    if (res == DW_DLV_OK) {
+        *name = info.ti_name;
+    }
+    return res;
+}
+
+void
+dwarf_type_cache_clear(Dwarf_Debug dbg)
+{
+    _dwarf_type_cache_destroy(dbg);
+}
@@ -0,0 +1,139 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The per-Dwarf_Debug cache behind dwarf_type_info().
+    Every type DIE reached is read once into a
+    Dwarf_Type_Node_s keyed by section offset, which is
+    unique across CUs and type units, so one table serves
+    every CU.  Following DW_AT_type chains, resolving the
+    canonical type and formatting a C/C++ name then work
+    from the nodes without reading .debug_info again.
+    A second table keeps per-CU facts (language, address
+    size and, for C++, the namespace and class scopes
+    that qualify type names). */
+
+#ifndef DWARF_TYPE_CACHE_H
+#define DWARF_TYPE_CACHE_H
+
+/*  Longer DW_AT_type chains, or deeper nesting of
+    declarators or scopes, are treated as corrupt DWARF. */
+#define DW_TYPE_CHAIN_LIMIT 64
+
+/*  A DW_AT_type style reference.  tr_offset zero (never
+    a DIE offset) means a DW_FORM_ref_sig8 whose type unit
+    is not present. */
+struct Dwarf_Type_Ref_s {
+    Dwarf_Bool     tr_present;
+    Dwarf_Bool     tr_is_info;
+    Dwarf_Off      tr_offset;
+};
+
+struct Dwarf_Type_Scope_s {
+    Dwarf_Off      ts_start;
+    /* One past the last DIE in the scope. */
+    Dwarf_Off      ts_end;
+    Dwarf_Signed   ts_parent;
+    /*  "a::b::" for this scope, malloc space. */
+    char          *ts_prefix;
+};
+
+struct Dwarf_Type_CU_s {
+    /* The unit header offset. */
+    Dwarf_Off      tu_offset;
+    Dwarf_Bool     tu_is_info;
+    Dwarf_Unsigned tu_language;
+    Dwarf_Small    tu_address_size;
+
+    /*  Namespace, class, struct and union DIEs in
+        preorder (so sorted by ts_start), built on the
+        first C++ name needing a qualifier. */
+    Dwarf_Bool     tu_scopes_built;
+    struct Dwarf_Type_Scope_s *tu_scopes;
+    Dwarf_Unsigned tu_scope_count;
+    Dwarf_Unsigned tu_scope_alloc;
+};
+
+struct Dwarf_Type_Node_s {
+    Dwarf_Off      tn_offset;
+    Dwarf_Bool     tn_is_info;
+    Dwarf_Half     tn_tag;
+    struct Dwarf_Type_CU_s *tn_cu;
+
+    /* DW_AT_name, malloc space, NULL if absent. */
+    char          *tn_name;
+    struct Dwarf_Type_Ref_s tn_target;
+    /* For DW_TAG_ptr_to_member_type. */
+    struct Dwarf_Type_Ref_s tn_containing;
+    /*  DW_AT_specification: the declaration whose scope
+        qualifies the name.  GCC type units define types
+        at the top level this way. */
+    struct Dwarf_Type_Ref_s tn_specification;
+    Dwarf_Bool     tn_has_byte_size;
+    Dwarf_Unsigned tn_byte_size;
+    Dwarf_Half     tn_encoding;
+    Dwarf_Bool     tn_prototyped;
+
+    /*  Array bounds from the DW_TAG_subrange_type
+        children, -1 where unknown. */
+    Dwarf_Signed  *tn_dims;
+    Dwarf_Unsigned tn_dim_count;
+    /*  Formal parameter types of a subroutine type,
+        tn_varargs for DW_TAG_unspecified_parameters. */
+    struct Dwarf_Type_Ref_s *tn_params;
+    Dwarf_Unsigned tn_param_count;
+    Dwarf_Bool     tn_varargs;
+
+    /*  Filled in by the first dwarf_type_info() on
+        this node.  The names are malloc space. */
+    Dwarf_Bool     tn_resolved;
+    Dwarf_Type_Info tn_info;
+    char          *tn_formatted;
+    char          *tn_canonical_formatted;
+};
+
+/*  Type unit signatures, sorted, for DW_FORM_ref_sig8. */
+struct Dwarf_Type_Sig_s {
+    Dwarf_Sig8     tg_sig;
+    Dwarf_Bool     tg_is_info;
+    Dwarf_Off      tg_type_offset;
+};
+
+struct Dwarf_Type_Cache_s {
+    /* dwarf_tsearch trees of the structs above. */
+    void          *tc_nodes;
+    void          *tc_cus;
+
+    Dwarf_Bool     tc_sigs_built;
+    struct Dwarf_Type_Sig_s *tc_sigs;
+    Dwarf_Unsigned tc_sig_count;
+    Dwarf_Unsigned tc_sig_alloc;
+};
+
+void _dwarf_type_cache_destroy(Dwarf_Debug dbg);
+
+#endif /* DWARF_TYPE_CACHE_H */
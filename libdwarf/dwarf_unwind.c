@@ -0,0 +1,550 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  dwarf_unwind_stack(): a CFI stack walker built on
+    dwarf_get_fde_at_pc() and the row computation behind
+    dwarf_get_fde_info_for_all_regs3().  All the space a
+    walk needs is allocated by dwarf_unwinder_create(),
+    see dwarf_unwind.h for the row cache. */
+
+#include "config.h"
+#include "dwarf_incl.h"
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h> /* for free(). */
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_MALLOC_H
+/* Useful include for some Windows compilers. */
+#include <malloc.h>
+#endif /* HAVE_MALLOC_H */
+#include <stdio.h>
+#include <string.h>
+#include "dwarf_alloc.h"
+#include "dwarf_error.h"
+#include "dwarf_util.h"
+#include "dwarf_frame.h"
+#include "dwarf_unwind.h"
+
+#define TRUE  1
+#define FALSE 0
+
+static int
+unwind_alloc_error(Dwarf_Debug dbg, Dwarf_Error *error)
+{
+    _dwarf_error_string(dbg, error, DW_DLE_ALLOC_FAIL,
+        "DW_DLE_ALLOC_FAIL: out of memory creating a "
+        "stack unwinder");
+    return DW_DLV_ERROR;
+}
+
+void
+dwarf_unwinder_dealloc(Dwarf_Unwinder uw)
+{
+    Dwarf_Debug dbg = 0;
+
+    if (!uw) {
+        return;
+    }
+    dbg = uw->uw_dbg;
+    if (uw->uw_eh_fde_data) {
+        dwarf_fde_cie_list_dealloc(dbg,
+            uw->uw_eh_cie_data,uw->uw_eh_cie_count,
+            uw->uw_eh_fde_data,uw->uw_eh_fde_count);
+    }
+    if (uw->uw_fde_data) {
+        dwarf_fde_cie_list_dealloc(dbg,
+            uw->uw_cie_data,uw->uw_cie_count,
+            uw->uw_fde_data,uw->uw_fde_count);
+    }
+    if (uw->uw_table) {
+        dwarf_dealloc(dbg,uw->uw_table,DW_DLA_FRAME);
+    }
+    free(uw->uw_work.ur_rules);
+    free(uw->uw_slots);
+    free(uw->uw_regs[0]);
+    free(uw->uw_regs[1]);
+    free(uw->uw_valid[0]);
+    free(uw->uw_valid[1]);
+    free(uw);
+}
+
+int
+dwarf_unwinder_create(Dwarf_Debug dbg,
+    Dwarf_Half sp_regnum,
+    Dwarf_Unsigned row_cache_size,
+    Dwarf_Unwinder *unwinder_out,
+    Dwarf_Error *error)
+{
+    struct Dwarf_Unwinder_s *uw = 0;
+    unsigned reg_count = 0;
+    Dwarf_Unsigned i = 0;
+    int res = 0;
+
+    if (!dbg) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    if (!unwinder_out) {
+        _dwarf_error_string(dbg, error, DW_DLE_UNWIND_ERROR,
+            "DW_DLE_UNWIND_ERROR: dwarf_unwinder_create() "
+            "was passed a null unwinder_out");
+        return DW_DLV_ERROR;
+    }
+    reg_count = dbg->de_frame_reg_rules_entry_count;
+    if (!reg_count) {
+        _dwarf_error_string(dbg, error, DW_DLE_UNWIND_ERROR,
+            "DW_DLE_UNWIND_ERROR: the frame register table "
+            "has no registers");
+        return DW_DLV_ERROR;
+    }
+    uw = (struct Dwarf_Unwinder_s *)calloc(1,sizeof(*uw));
+    if (!uw) {
+        return unwind_alloc_error(dbg,error);
+    }
+    uw->uw_dbg = dbg;
+    uw->uw_sp_regnum = sp_regnum;
+    uw->uw_reg_count = reg_count;
+
+    res = dwarf_get_fde_list_eh(dbg,
+        &uw->uw_eh_cie_data,&uw->uw_eh_cie_count,
+        &uw->uw_eh_fde_data,&uw->uw_eh_fde_count,error);
+    if (res == DW_DLV_ERROR) {
+        dwarf_unwinder_dealloc(uw);
+        return res;
+    }
+    res = dwarf_get_fde_list(dbg,
+        &uw->uw_cie_data,&uw->uw_cie_count,
+        &uw->uw_fde_data,&uw->uw_fde_count,error);
+    if (res == DW_DLV_ERROR) {
+        dwarf_unwinder_dealloc(uw);
+        return res;
+    }
+    if (!uw->uw_eh_fde_data && !uw->uw_fde_data) {
+        dwarf_unwinder_dealloc(uw);
+        return DW_DLV_NO_ENTRY;
+    }
+
+    uw->uw_table = (Dwarf_Frame)_dwarf_get_alloc(dbg,
+        DW_DLA_FRAME, 1);
+    uw->uw_work.ur_rules = (struct Dwarf_Unwind_Rule_s *)
+        calloc(reg_count,sizeof(struct Dwarf_Unwind_Rule_s));
+    for (i = 0; i < 2; ++i) {
+        uw->uw_regs[i] = (Dwarf_Unsigned *)calloc(reg_count,
+            sizeof(Dwarf_Unsigned));
+        uw->uw_valid[i] = (Dwarf_Small *)calloc(reg_count,1);
+    }
+    if (!uw->uw_table || !uw->uw_work.ur_rules ||
+        !uw->uw_regs[0] || !uw->uw_regs[1] ||
+        !uw->uw_valid[0] || !uw->uw_valid[1]) {
+        dwarf_unwinder_dealloc(uw);
+        return unwind_alloc_error(dbg,error);
+    }
+    if (row_cache_size) {
+        Dwarf_Unsigned size = 1;
+
+        while (size < row_cache_size) {
+            size *= 2;
+        }
+        uw->uw_slots = (struct Dwarf_Unwind_Slot_s *)
+            calloc(size,sizeof(struct Dwarf_Unwind_Slot_s));
+        if (!uw->uw_slots) {
+            dwarf_unwinder_dealloc(uw);
+            return unwind_alloc_error(dbg,error);
+        }
+        uw->uw_slot_count = size;
+        for (i = 0; i < size; ++i) {
+            uw->uw_slots[i].us_row.ur_rules =
+                uw->uw_slots[i].us_rules;
+        }
+    }
+    *unwinder_out = uw;
+    return DW_DLV_OK;
+}
+
+void
+dwarf_unwinder_stats(Dwarf_Unwinder uw,
+    Dwarf_Unsigned *hits,
+    Dwarf_Unsigned *misses)
+{
+    if (hits) {
+        *hits = uw? uw->uw_hits:0;
+    }
+    if (misses) {
+        *misses = uw? uw->uw_misses:0;
+    }
+}
+
+void
+dwarf_unwinder_set_load_bias(Dwarf_Unwinder uw,
+    Dwarf_Addr load_bias)
+{
+    if (uw) {
+        uw->uw_load_bias = load_bias;
+    }
+}
+
+static Dwarf_Unsigned
+slot_index(struct Dwarf_Unwinder_s *uw, Dwarf_Addr pc)
+{
+    Dwarf_Unsigned h = pc*0x9e3779b97f4a7c15ULL;
+
+    h ^= h >> 29;
+    return h & (uw->uw_slot_count-1);
+}
+
+/*  Sets *row_out to the CFI row covering pc, from the
+    cache or computed into uw_work.  DW_DLV_NO_ENTRY if
+    no FDE covers pc. */
+static int
+find_row(struct Dwarf_Unwinder_s *uw,
+    Dwarf_Addr pc,
+    struct Dwarf_Unwind_Row_s **row_out,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = uw->uw_dbg;
+    struct Dwarf_Unwind_Slot_s *slot = 0;
+    struct Dwarf_Unwind_Row_s *row = &uw->uw_work;
+    Dwarf_Fde fde = 0;
+    Dwarf_Cie cie = 0;
+    Dwarf_Bool has_more_rows = FALSE;
+    Dwarf_Addr subsequent_pc = 0;
+    Dwarf_Addr fde_high = 0;
+    struct Dwarf_Reg_Rule_s *r = 0;
+    int initial = dbg->de_frame_rule_initial_value;
+    unsigned i = 0;
+    int res = DW_DLV_NO_ENTRY;
+
+    if (uw->uw_slot_count) {
+        slot = &uw->uw_slots[slot_index(uw,pc)];
+        if (slot->us_row.ur_high && slot->us_row.ur_low <= pc &&
+            pc < slot->us_row.ur_high) {
+            uw->uw_hits++;
+            *row_out = &slot->us_row;
+            return DW_DLV_OK;
+        }
+    }
+    uw->uw_misses++;
+    if (uw->uw_eh_fde_data) {
+        res = dwarf_get_fde_at_pc(uw->uw_eh_fde_data,pc,&fde,
+            0,0,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    if (res == DW_DLV_NO_ENTRY && uw->uw_fde_data) {
+        res = dwarf_get_fde_at_pc(uw->uw_fde_data,pc,&fde,
+            0,0,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = _dwarf_get_fde_info_for_a_pc_row(fde,pc,uw->uw_table,
+        dbg->de_frame_cfa_col_number,&has_more_rows,
+        &subsequent_pc,error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+
+    cie = fde->fd_cie;
+    fde_high = fde->fd_initial_location + fde->fd_address_range;
+    row->ur_low = uw->uw_table->fr_loc;
+    row->ur_high = fde_high;
+    if (has_more_rows && subsequent_pc > pc &&
+        subsequent_pc < fde_high) {
+        row->ur_high = subsequent_pc;
+    }
+    if (row->ur_low > pc) {
+        row->ur_low = pc;
+    }
+    row->ur_cfa = uw->uw_table->fr_cfa_rule;
+    row->ur_ra_column = cie->ci_return_address_register;
+    row->ur_address_size = cie->ci_address_size;
+    row->ur_signal_frame = cie->ci_augmentation &&
+        strchr(cie->ci_augmentation,'S') != 0;
+    row->ur_rule_count = 0;
+    r = uw->uw_table->fr_reg;
+    for (i = 0; i < uw->uw_reg_count; ++i, ++r) {
+        struct Dwarf_Unwind_Rule_s *ur = 0;
+
+        if (r->ru_value_type == DW_EXPR_OFFSET && !r->ru_is_off &&
+            r->ru_register == initial) {
+            continue;
+        }
+        ur = &row->ur_rules[row->ur_rule_count++];
+        ur->ur_regnum = (Dwarf_Half)i;
+        ur->ur_rule = *r;
+    }
+
+    if (slot && row->ur_rule_count <= DW_UNWIND_SLOT_RULES) {
+        struct Dwarf_Unwind_Row_s *srow = &slot->us_row;
+        struct Dwarf_Unwind_Rule_s *rules = srow->ur_rules;
+
+        *srow = *row;
+        srow->ur_rules = rules;
+        memcpy(rules,row->ur_rules,
+            row->ur_rule_count*sizeof(struct Dwarf_Unwind_Rule_s));
+        row = srow;
+    }
+    *row_out = row;
+    return DW_DLV_OK;
+}
+
+/*  Applies one rule of the callee frame (registers regs,
+    valid, of which only the first live are meaningful)
+    to compute a caller register.  Returns FALSE if the
+    value is not available. */
+static Dwarf_Bool
+apply_rule(struct Dwarf_Unwinder_s *uw,
+    const Dwarf_Unwind_Callbacks *cb,
+    struct Dwarf_Unwind_Row_s *row,
+    Dwarf_Half regnum,
+    struct Dwarf_Reg_Rule_s *r,
+    Dwarf_Addr cfa,
+    const Dwarf_Unsigned *regs,
+    const Dwarf_Small *valid,
+    unsigned live,
+    Dwarf_Unsigned *value_out)
+{
+    Dwarf_Debug dbg = uw->uw_dbg;
+    Dwarf_Unsigned value = 0;
+    int res = 0;
+
+    switch (r->ru_value_type) {
+    case DW_EXPR_OFFSET:
+        if (r->ru_is_off) {
+            if (!cb->uc_read_memory) {
+                return FALSE;
+            }
+            res = cb->uc_read_memory(cb->uc_user_data,
+                cfa + r->ru_offset_or_block_len,
+                row->ur_address_size,value_out);
+            return res == DW_DLV_OK;
+        }
+        if (r->ru_register == dbg->de_frame_same_value_number) {
+            if (regnum >= live || !valid[regnum]) {
+                return FALSE;
+            }
+            *value_out = regs[regnum];
+            return TRUE;
+        }
+        if (r->ru_register >= live || !valid[r->ru_register]) {
+            /* Undefined, or a register we do not have. */
+            return FALSE;
+        }
+        *value_out = regs[r->ru_register];
+        return TRUE;
+    case DW_EXPR_VAL_OFFSET:
+        *value_out = cfa + r->ru_offset_or_block_len;
+        return TRUE;
+    case DW_EXPR_EXPRESSION:
+    case DW_EXPR_VAL_EXPRESSION:
+        if (!cb->uc_eval_expression) {
+            return FALSE;
+        }
+        res = cb->uc_eval_expression(cb->uc_user_data,
+            r->ru_block,r->ru_offset_or_block_len,TRUE,cfa,
+            regs,valid,live,&value);
+        if (res != DW_DLV_OK) {
+            return FALSE;
+        }
+        if (r->ru_value_type == DW_EXPR_VAL_EXPRESSION) {
+            *value_out = value;
+            return TRUE;
+        }
+        if (!cb->uc_read_memory) {
+            return FALSE;
+        }
+        res = cb->uc_read_memory(cb->uc_user_data,value,
+            row->ur_address_size,value_out);
+        return res == DW_DLV_OK;
+    default:
+        return FALSE;
+    }
+}
+
+int
+dwarf_unwind_stack(Dwarf_Unwinder uw,
+    const Dwarf_Unwind_Callbacks *cb,
+    Dwarf_Addr pc,
+    const Dwarf_Unsigned *registers,
+    const Dwarf_Small *registers_valid,
+    Dwarf_Unsigned register_count,
+    Dwarf_Unsigned max_depth,
+    Dwarf_Addr *pcs_out,
+    Dwarf_Unsigned *pc_count,
+    Dwarf_Error *error)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned *regs = 0;
+    Dwarf_Small *valid = 0;
+    unsigned reg_count = 0;
+    /*  Registers at and above live are invalid in both
+        arrays, so only the first live are copied from
+        frame to frame. */
+    unsigned live = 0;
+    unsigned cur = 0;
+    unsigned i = 0;
+    Dwarf_Bool exact_pc = TRUE;
+    Dwarf_Bool same_is_initial = FALSE;
+    Dwarf_Addr prev_cfa = 0;
+
+    if (!uw) {
+        _dwarf_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg = uw->uw_dbg;
+    if (!cb || !pc_count || (max_depth && !pcs_out) ||
+        (register_count && !registers)) {
+        _dwarf_error_string(dbg, error, DW_DLE_UNWIND_ERROR,
+            "DW_DLE_UNWIND_ERROR: dwarf_unwind_stack() was "
+            "passed a null argument");
+        return DW_DLV_ERROR;
+    }
+    reg_count = uw->uw_reg_count;
+    if (dbg->de_frame_reg_rules_entry_count != reg_count) {
+        _dwarf_error_string(dbg, error, DW_DLE_UNWIND_ERROR,
+            "DW_DLE_UNWIND_ERROR: the frame register table "
+            "size changed after dwarf_unwinder_create()");
+        return DW_DLV_ERROR;
+    }
+    same_is_initial = dbg->de_frame_rule_initial_value ==
+        dbg->de_frame_same_value_number;
+
+    regs = uw->uw_regs[0];
+    valid = uw->uw_valid[0];
+    live = register_count < reg_count? (unsigned)register_count:
+        reg_count;
+    for (i = 0; i < live; ++i) {
+        regs[i] = registers[i];
+        valid[i] = registers_valid? (registers_valid[i] != 0):1;
+    }
+
+    while (count < max_depth) {
+        struct Dwarf_Unwind_Row_s *row = 0;
+        struct Dwarf_Reg_Rule_s *cr = 0;
+        Dwarf_Unsigned *nregs = uw->uw_regs[1-cur];
+        Dwarf_Small *nvalid = uw->uw_valid[1-cur];
+        Dwarf_Addr cfa = 0;
+        Dwarf_Addr next_pc = 0;
+        Dwarf_Half ra = 0;
+        Dwarf_Unsigned r = 0;
+        unsigned new_live = live;
+        int res = 0;
+
+        pcs_out[count++] = pc;
+        if (count >= max_depth) {
+            break;
+        }
+        /*  A return address is normally just past the
+            call, which may be the last instruction of its
+            function or of a row, so look up the call. */
+        res = find_row(uw,(exact_pc? pc:pc-1) - uw->uw_load_bias,
+            &row,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+        if (res == DW_DLV_NO_ENTRY) {
+            break;
+        }
+
+        cr = &row->ur_cfa;
+        if (cr->ru_value_type == DW_EXPR_OFFSET && cr->ru_is_off) {
+            if (cr->ru_register >= live || !valid[cr->ru_register]) {
+                break;
+            }
+            cfa = regs[cr->ru_register] + cr->ru_offset_or_block_len;
+        } else if (cr->ru_value_type == DW_EXPR_EXPRESSION) {
+            if (!cb->uc_eval_expression) {
+                break;
+            }
+            res = cb->uc_eval_expression(cb->uc_user_data,
+                cr->ru_block,cr->ru_offset_or_block_len,
+                FALSE,0,regs,valid,live,&cfa);
+            if (res != DW_DLV_OK) {
+                break;
+            }
+        } else {
+            break;
+        }
+
+        /*  The rules are in register number order. */
+        if (uw->uw_sp_regnum < reg_count &&
+            uw->uw_sp_regnum >= new_live) {
+            new_live = uw->uw_sp_regnum + 1;
+        }
+        if (row->ur_rule_count &&
+            row->ur_rules[row->ur_rule_count-1].ur_regnum >=
+            new_live) {
+            new_live = row->ur_rules[row->ur_rule_count-1].ur_regnum
+                + 1;
+        }
+        if (same_is_initial) {
+            memcpy(nregs,regs,live*sizeof(Dwarf_Unsigned));
+            memcpy(nvalid,valid,live);
+            memset(nvalid+live,0,new_live-live);
+        } else {
+            memset(nvalid,0,new_live);
+        }
+        if (uw->uw_sp_regnum < reg_count) {
+            nregs[uw->uw_sp_regnum] = cfa;
+            nvalid[uw->uw_sp_regnum] = 1;
+        }
+        for (r = 0; r < row->ur_rule_count; ++r) {
+            struct Dwarf_Unwind_Rule_s *ur = &row->ur_rules[r];
+
+            nvalid[ur->ur_regnum] = (Dwarf_Small)apply_rule(uw,cb,
+                row,ur->ur_regnum,&ur->ur_rule,cfa,regs,valid,live,
+                &nregs[ur->ur_regnum]);
+        }
+
+        ra = row->ur_ra_column;
+        if (ra >= new_live || !nvalid[ra]) {
+            break;
+        }
+        next_pc = nregs[ra];
+        if (!next_pc) {
+            break;
+        }
+        if (count > 1 && next_pc == pc && cfa == prev_cfa) {
+            /* No progress: the CFI loops. */
+            break;
+        }
+        prev_cfa = cfa;
+        exact_pc = row->ur_signal_frame;
+        pc = next_pc;
+        cur = 1-cur;
+        regs = nregs;
+        valid = nvalid;
+        live = new_live;
+    }
+    *pc_count = count;
+    return DW_DLV_OK;
+}
@@ -0,0 +1,105 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The state behind dwarf_unwind_stack().  A CFI row is
+    kept compactly as the CFA rule plus the rules of the
+    registers whose rule is not the initial one.  Rows
+    are cached direct mapped by pc; a slot answers any pc
+    in [ur_low,ur_high), the addresses the row covers. */
+
+#ifndef DWARF_UNWIND_H
+#define DWARF_UNWIND_H
+
+/*  Rows with more non-initial rules than this are not
+    cached. */
+#define DW_UNWIND_SLOT_RULES 24
+
+struct Dwarf_Unwind_Rule_s {
+    Dwarf_Half     ur_regnum;
+    struct Dwarf_Reg_Rule_s ur_rule;
+};
+
+struct Dwarf_Unwind_Row_s {
+    Dwarf_Addr     ur_low;
+    /*  One past the last address, zero in an unused
+        slot. */
+    Dwarf_Addr     ur_high;
+    struct Dwarf_Reg_Rule_s ur_cfa;
+    Dwarf_Half     ur_ra_column;
+    Dwarf_Half     ur_address_size;
+    /* The CIE augmentation has 'S'. */
+    Dwarf_Bool     ur_signal_frame;
+    Dwarf_Unsigned ur_rule_count;
+    struct Dwarf_Unwind_Rule_s *ur_rules;
+};
+
+struct Dwarf_Unwind_Slot_s {
+    struct Dwarf_Unwind_Row_s us_row;
+    struct Dwarf_Unwind_Rule_s us_rules[DW_UNWIND_SLOT_RULES];
+};
+
+struct Dwarf_Unwinder_s {
+    Dwarf_Debug    uw_dbg;
+    Dwarf_Half     uw_sp_regnum;
+    /*  Subtracted from each pc to get the address in
+        the object. */
+    Dwarf_Addr     uw_load_bias;
+    /*  dbg->de_frame_reg_rules_entry_count when the
+        unwinder was created. */
+    unsigned       uw_reg_count;
+
+    Dwarf_Cie     *uw_eh_cie_data;
+    Dwarf_Signed   uw_eh_cie_count;
+    Dwarf_Fde     *uw_eh_fde_data;
+    Dwarf_Signed   uw_eh_fde_count;
+    Dwarf_Cie     *uw_cie_data;
+    Dwarf_Signed   uw_cie_count;
+    Dwarf_Fde     *uw_fde_data;
+    Dwarf_Signed   uw_fde_count;
+
+    /*  The full row as computed from the frame
+        instructions, and its compact form when it
+        does not go in a slot (uw_work.ur_rules has
+        room for uw_reg_count rules). */
+    Dwarf_Frame    uw_table;
+    struct Dwarf_Unwind_Row_s uw_work;
+
+    /*  uw_slot_count is zero (no cache) or a power
+        of two. */
+    struct Dwarf_Unwind_Slot_s *uw_slots;
+    Dwarf_Unsigned uw_slot_count;
+    Dwarf_Unsigned uw_hits;
+    Dwarf_Unsigned uw_misses;
+
+    /*  Registers of the frame being unwound and of its
+        caller, swapped at each step. */
+    Dwarf_Unsigned *uw_regs[2];
+    Dwarf_Small    *uw_valid[2];
+};
+
+#endif /* DWARF_UNWIND_H */
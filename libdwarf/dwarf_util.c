@@ -733,6 +733,7 @@ _dwarf_get_abbrev_for_code(Dwarf_CU_Context cu_context,
         hash_abbrev_entry->abl_code != code;
         hash_abbrev_entry = hash_abbrev_entry->abl_next);
     if (hash_abbrev_entry) {
+        dbg->de_perf_counters.pc_abbrev_hits++;
         /*  This returns a pointer to an abbrev
             list entry, not the list itself. */
         *highest_known_code =
@@ -817,6 +818,7 @@ _dwarf_get_abbrev_for_code(Dwarf_CU_Context cu_context,
             _dwarf_error(dbg, error, DW_DLE_ALLOC_FAIL);
             return DW_DLV_ERROR;
         }
+        dbg->de_perf_counters.pc_abbrev_decodes++;
 
         new_hashable_val = abbrev_code;
         if (abbrev_code > cu_context->cc_highest_known_code) {
@@ -869,12 +871,39 @@ _dwarf_get_abbrev_for_code(Dwarf_CU_Context cu_context,
 }
 
 
+/*  If [start,end) lies within a string section whose
+    last NUL has been found at load time
+    return that section, else return 0. */
+static struct Dwarf_Section_s *
+string_section_of_area(Dwarf_Debug dbg,
+    Dwarf_Small *start, Dwarf_Small *end)
+{
+    struct Dwarf_Section_s *sec = 0;
+
+    sec = &dbg->de_debug_str;
+    if (sec->dss_string_limit && start >= sec->dss_data &&
+        end <= sec->dss_data + sec->dss_size) {
+        return sec;
+    }
+    sec = &dbg->de_debug_line_str;
+    if (sec->dss_string_limit && start >= sec->dss_data &&
+        end <= sec->dss_data + sec->dss_size) {
+        return sec;
+    }
+    return 0;
+}
+
 /*
     We check that:
         areaptr <= strptr.
         a NUL byte (*p) exists at p < end.
     and return DW_DLV_ERROR if a check fails.
 
+    In .debug_str and .debug_line_str the NUL is
+    known to exist when strptr is below the section's
+    dss_string_limit, so no scan is needed there.
+    Elsewhere memchr() does the scan.
+
     de_assume_string_in_bounds
 */
 int
@@ -886,6 +915,7 @@ _dwarf_check_string_valid(Dwarf_Debug dbg,void *areaptr,
     Dwarf_Small *start = areaptr;
     Dwarf_Small *p = strptr;
     Dwarf_Small *end = areaendptr;
+    struct Dwarf_Section_s *strsec = 0;
 
     if (p < start) {
         _dwarf_error(dbg,error,suggested_error);
@@ -900,16 +930,57 @@ _dwarf_check_string_valid(Dwarf_Debug dbg,void *areaptr,
             to live dangerously and just assume strings ok. */
         return DW_DLV_OK;
     }
-    while (p < end) {
-        if (*p == 0) {
+    strsec = string_section_of_area(dbg,start,end);
+    if (strsec && strsec->dss_string_limit <= end) {
+        if (p < strsec->dss_string_limit) {
             return DW_DLV_OK;
         }
-        ++p;
+        /*  No NUL at or after p anywhere in the
+            section, so none before end either. */
+        _dwarf_error(dbg,error,DW_DLE_STRING_NOT_TERMINATED);
+        return DW_DLV_ERROR;
+    }
+    if (memchr(p,0,end - p)) {
+        return DW_DLV_OK;
     }
     _dwarf_error(dbg,error,DW_DLE_STRING_NOT_TERMINATED);
     return DW_DLV_ERROR;
 }
 
+/*  As _dwarf_check_string_valid() but also sets
+    *len_out to the string length (not counting the
+    NUL).  The one bounded scan finding the NUL is
+    both the check and the measurement, even where
+    _dwarf_check_string_valid() would need no scan. */
+int
+_dwarf_check_string_valid_len(Dwarf_Debug dbg,void *areaptr,
+    void *strptr, void *areaendptr,
+    int suggested_error,
+    Dwarf_Unsigned *len_out,
+    Dwarf_Error*error)
+{
+    Dwarf_Small *start = areaptr;
+    Dwarf_Small *p = strptr;
+    Dwarf_Small *end = areaendptr;
+    Dwarf_Small *nul = 0;
+
+    if (p < start || p >= end) {
+        _dwarf_error(dbg,error,suggested_error);
+        return DW_DLV_ERROR;
+    }
+    if (dbg->de_assume_string_in_bounds) {
+        *len_out = strlen((const char *)p);
+        return DW_DLV_OK;
+    }
+    nul = (Dwarf_Small *)memchr(p,0,end - p);
+    if (!nul) {
+        _dwarf_error(dbg,error,DW_DLE_STRING_NOT_TERMINATED);
+        return DW_DLV_ERROR;
+    }
+    *len_out = (Dwarf_Unsigned)(nul - p);
+    return DW_DLV_OK;
+}
+
 
 /*  Return non-zero if the start/end are not valid for the
     die's section.
@@ -397,6 +397,10 @@ int _dwarf_get_abbrev_for_code(Dwarf_CU_Context cu_context,
 int _dwarf_check_string_valid(Dwarf_Debug dbg,void *areaptr,
     void *startptr, void *endptr,
     int suggested_error, Dwarf_Error *error);
+int _dwarf_check_string_valid_len(Dwarf_Debug dbg,void *areaptr,
+    void *startptr, void *endptr,
+    int suggested_error, Dwarf_Unsigned *len_out,
+    Dwarf_Error *error);
 
 int _dwarf_length_of_cu_header(Dwarf_Debug dbg, Dwarf_Unsigned offset,
     Dwarf_Bool is_info,
@@ -222,6 +222,118 @@ recent changes.
 
 .H 2 "Items Changed"
 .P
+Added dwarf_unwinder_create() and dwarf_unwind_stack(),
+which walk a stack through the CFI from a register set
+and a memory-read callback, with a cache of computed
+rows.  Computing a frame row no longer allocates.
+(October 19, 2026);
+.P
+Added dwarf_get_loclist_at_pc(), which returns
+only the location list entry covering a pc,
+decoding just that entry's expression.
+DWARF5 .debug_loclists offset pair entries
+no longer have the base address added twice.
+(October 19, 2026);
+.P
+Added dwarf_range_iter_begin() and dwarf_range_iter_next(),
+which return the pc ranges of a DIE from .debug_ranges
+or .debug_rnglists without allocating, and an optional
+cache of decoded range lists,
+dwarf_range_cache_set_size().
+(October 19, 2026);
+.P
+Added dwarf_pubnames_lookup() and
+dwarf_pubnames_lookup_prefix(), hashed and prefix
+name lookup over .debug_pubnames and .debug_gnu_pubnames.
+(October 19, 2026);
+.P
+Added dwarf_get_unit_directory() listing every unit
+header of .debug_info or .debug_types without building
+CU contexts or reading unit DIEs.
+(October 19, 2026);
+.P
+Added dwarf_dwo_session_create() and related
+functions which open the .dwo files of a split
+DWARF executable on demand, keeping a bounded number
+open.  A lookup holds its .dwo open until
+dwarf_dwo_session_release().  Strings in a DWARF5 .dwo are now read past
+the .debug_str_offsets.dwo header.
+(October 19, 2026);
+.P
+Added dwarf_type_info(), dwarf_die_type_info(),
+dwarf_type_name() and dwarf_type_cache_clear()
+which resolve and name types from a cache that
+reads each type DIE once.
+(October 19, 2026);
+.P
+Added dwarf_symbolize_pcs() resolving an array
+of pcs to function, file, line and column in
+one address-ordered pass, reading each CU
+line table at most once.
+(October 19, 2026);
+.P
+Added dwarf_inline_frames() and
+dwarf_inline_frames_cache_clear()
+returning the chain of inlined subroutines
+at a pc from a per-CU tree built once.
+DWARF5 full source paths no longer use the wrong
+include directory for directory indexes above zero.
+(October 19, 2026);
+.P
+Added dwarf_linesrc_b() and dwarf_srclines_file_path()
+which return a full source path owned by the line
+table context, computed once per file entry.
+dwarf_linesrc() now copies from the same memo.
+(October 19, 2026);
+.P
+Added dwarf_debugnames_lookup(),
+dwarf_debugnames_name_string(),
+dwarf_dealloc_debugnames_matches(),
+dwarf_debugnames_write_sidecar() and
+dwarf_debugnames_use_sidecar()
+so objects without .debug_names can be given
+a prebuilt name index.
+(October 19, 2026);
+.P
+Added dwarf_get_macro_flattened() and
+dwarf_dealloc_macro_flattened().
+DWARF5 macro units are now decoded once per
+Dwarf_Debug however many CUs import them.
+(October 19, 2026);
+.P
+Added dwarf_expr_compile(), dwarf_expr_evaluate() and
+dwarf_expr_program_dealloc() to evaluate location
+expressions through caller callbacks, with the
+compiled form cached per expression.
+(October 19, 2026);
+.P
+Added dwarf_formstring_view() and dwarf_diename_view()
+returning a string with its length.
+String checks in .debug_str and .debug_line_str
+no longer scan for the terminating NUL each time.
+(October 19, 2026);
+.P
+Added dwarf_get_perf_counters(),
+dwarf_get_perf_alloc_count(),
+dwarf_get_section_perf_counters(), and
+dwarf_reset_perf_counters()
+reporting per-Dwarf_Debug work counters.
+(October 19, 2026);
+.P
+Added dwarf_set_section_memory_budget()
+and dwarf_get_section_memory_stats()
+so long-running readers can bound the memory
+held in loaded section data.
+(October 19, 2026);
+.P
+Added dwarf_gnu_debuglink_resolve() which finds
+the separate debug file for an object through
+a process-wide cache, and
+dwarf_debuglink_cache_save(),
+dwarf_debuglink_cache_load(), and
+dwarf_debuglink_cache_clear() to manage that cache.
+(October 19, 2026);
+.P
 The documentation of dwarf_init_path()
 was basically correct but omitted
 meaningful mention of the dbg argument
@@ -2251,6 +2363,24 @@ Or use
 instead  of
 \f(CWdwarf_init_path()\fP
 .P
+An ELF object with no
+\f(CW.debug_info\fP
+but with a
+\f(CW.note.gnu.build-id\fP
+or
+\f(CW.gnu_debuglink\fP
+section is followed to its separate debug file
+with \f(CWdwarf_gnu_debuglink_resolve()\fP,
+looking in \f(CW/usr/lib/debug\fP
+and in the directory of the object.
+If the debug file opens the returned Dwarf_Debug
+is for it, and its path is copied into
+\f(CWtrue_path_out_buffer\fP
+if that is passed in and is big enough.
+Otherwise the Dwarf_Debug is for the object itself.
+\f(CWdwarf_init_b()\fP
+never does this.
+.P
 Pass in the usual DW_DLC_READ
 (which only ever applied to libelf)
 to
@@ -3450,6 +3580,174 @@ The function is the same as \f(CWdwarf_get_section_max_offsets_b()\fP
 except it is missing the \f(CWdebug_types_size()\fP argument.
 Though obsolete it is still supported.
 
+.H 3 "dwarf_set_section_memory_budget()"
+.DS
+\f(CWint dwarf_set_section_memory_budget(Dwarf_Debug dbg,
+    Dwarf_Unsigned budget_bytes,
+    Dwarf_Error *error);\fP
+.DE
+.P
+Section data is loaded when first needed and
+normally kept until \f(CWdwarf_finish()\fP.
+This sets a limit, in bytes, on the loaded
+data of the sections
+\f(CW.debug_loc\fP,
+\f(CW.debug_macro\fP,
+\f(CW.debug_str_offsets\fP,
+\f(CW.debug_aranges\fP, and
+\f(CW.debug_ranges\fP
+(counting both the compressed and
+the decompressed copy of a compressed section).
+When loading one of these takes their total over
+\f(CWbudget_bytes\fP the least-recently-used
+of them are freed until the total is within the budget.
+For a compressed section the decompressed copy is
+freed, and a freed section is read (and decompressed)
+again the next time it is needed.
+Other sections, compressed or not,
+do not count against the budget
+and are never freed as
+returned data (such as a \f(CWDwarf_Die\fP or
+a string) may point into them.
+.P
+A section is not freed while an object
+referring to it exists
+(a \f(CWDwarf_Loc_Head_c\fP,
+a \f(CWDwarf_Locdesc\fP from
+\f(CWdwarf_loclist_n()\fP or
+\f(CWdwarf_loclist()\fP,
+a \f(CWDwarf_Macro_Context\fP, or
+an open \f(CWDwarf_Str_Offsets_Table\fP),
+nor if relocations were applied to it.
+Such an object made after a section was
+freed and read again refers to the new copy.
+Once
+\f(CWdwarf_get_loclist_entry()\fP
+has returned data from
+\f(CW.debug_loc\fP
+that section is never freed, as there is
+no dealloc telling libdwarf the caller is done
+with the pointer returned.
+So the budget is a target, not a hard limit.
+.P
+Only the libdwarf ELF reader
+(as used by \f(CWdwarf_init_path()\fP and
+\f(CWdwarf_init_b()\fP without libelf)
+gives the raw section bytes back.
+With other object readers only decompressed
+data is freed.
+.P
+A \f(CWbudget_bytes\fP of zero turns eviction off.
+The function returns \f(CWDW_DLV_OK\fP
+unless \f(CWdbg\fP is NULL.
+
+.H 3 "dwarf_get_section_memory_stats()"
+.DS
+\f(CWint dwarf_get_section_memory_stats(Dwarf_Debug dbg,
+    Dwarf_Unsigned *bytes_resident,
+    Dwarf_Unsigned *bytes_resident_peak,
+    Dwarf_Unsigned *evictions,
+    Dwarf_Unsigned *bytes_evicted,
+    Dwarf_Unsigned *reloads,
+    Dwarf_Error *error);\fP
+.DE
+.P
+Returns, through the pointers, the section data
+bytes now loaded, the most ever loaded at once,
+how many times a section was freed under the budget
+and the bytes so freed, and how many times
+a freed section had to be read again.
+Pass NULL for any value not wanted.
+The counts are kept whether or not a budget is set.
+
+.H 3 "dwarf_get_perf_counters()"
+.DS
+\f(CWint dwarf_get_perf_counters(Dwarf_Debug dbg,
+    Dwarf_Perf_Counters *counters_out,
+    Dwarf_Error *error);\fP
+.DE
+.P
+Every \f(CWDwarf_Debug\fP counts the work done
+on its behalf.
+The counting is always on and costs an increment
+at each counted event.
+This copies the counters into the caller's
+\f(CWDwarf_Perf_Counters\fP struct (see libdwarf.h).
+Set its \f(CWpc_size\fP to
+\f(CWsizeof(Dwarf_Perf_Counters)\fP first.
+No more than \f(CWpc_size\fP bytes are filled in
+and \f(CWpc_size\fP is set to the bytes that were,
+so a caller built against an older or newer
+libdwarf.h gets the counters both know of.
+A \f(CWpc_size\fP less than one counter
+is a \f(CWDW_DLE_PERF_COUNTERS_SIZE\fP error.
+.P
+The counters record sections loaded
+with the bytes read and the bytes produced
+by decompression,
+abbreviations decoded and abbreviation lookups
+satisfied from those already decoded,
+CU contexts created,
+line table programs decoded,
+CIEs and FDEs parsed,
+search tree (\f(CWdwarf_tsearch()\fP) operations,
+and allocations in total.
+.P
+Comparing bytes loaded to
+abbreviation and line work
+shows whether a workload is bound by
+I/O or by parsing.
+\f(CWdwarfdump --perf-stats\fP prints these.
+
+.H 3 "dwarf_get_perf_alloc_count()"
+.DS
+\f(CWint dwarf_get_perf_alloc_count(Dwarf_Debug dbg,
+    Dwarf_Unsigned   dla_type,
+    Dwarf_Unsigned * alloc_count,
+    Dwarf_Error *    error);\fP
+.DE
+.P
+Returns the number of allocations of
+the \f(CWDW_DLA_*\fP type \f(CWdla_type\fP.
+Once \f(CWdla_type\fP is past the last type
+libdwarf has it returns \f(CWDW_DLV_NO_ENTRY\fP,
+so callers loop from zero till they get that.
+
+.H 3 "dwarf_get_section_perf_counters()"
+.DS
+\f(CWint dwarf_get_section_perf_counters(Dwarf_Debug dbg,
+    Dwarf_Unsigned   section_index,
+    const char **    section_name,
+    Dwarf_Unsigned * load_count,
+    Dwarf_Unsigned * bytes_loaded,
+    Dwarf_Unsigned * bytes_decompressed,
+    Dwarf_Error *    error);\fP
+.DE
+.P
+Returns the load counters of one DWARF section.
+\f(CWsection_index\fP counts from zero over
+the DWARF sections libdwarf found in the
+object (it is not an object section number).
+Once \f(CWsection_index\fP is past
+the last such section the function returns
+\f(CWDW_DLV_NO_ENTRY\fP, so callers simply
+loop till they get that.
+A section reloaded after
+\f(CWdwarf_set_section_memory_budget()\fP
+evicted it counts each load.
+Pass NULL for any value not wanted.
+
+.H 3 "dwarf_reset_perf_counters()"
+.DS
+\f(CWint dwarf_reset_perf_counters(Dwarf_Debug dbg,
+    Dwarf_Error *error);\fP
+.DE
+.P
+Sets all the counters above to zero,
+for example to measure one phase of a program.
+It does not change the memory figures of
+\f(CWdwarf_get_section_memory_stats()\fP.
+
 .H 2 "Printf Callbacks"
 .P
 This is new in August 2013.
@@ -3797,6 +4095,86 @@ will be in \f(CW.debug_types\fP, but in
 and the Debug Fission (ie Split Dwarf) \f(CW.debug_info.dwo\fP
 sections .
 
+.H 3 "dwarf_get_unit_directory()"
+.DS
+\f(CW
+typedef struct Dwarf_Unit_Entry_s {
+    Dwarf_Off       ue_offset;
+    Dwarf_Off       ue_die_offset;
+    Dwarf_Unsigned  ue_length;
+    Dwarf_Half      ue_length_size;
+    Dwarf_Half      ue_extension_size;
+    Dwarf_Half      ue_version;
+    Dwarf_Half      ue_unit_type;
+    Dwarf_Half      ue_address_size;
+    Dwarf_Unsigned  ue_abbrev_offset;
+    Dwarf_Bool      ue_has_signature;
+    Dwarf_Sig8      ue_signature;
+    Dwarf_Unsigned  ue_type_offset;
+} Dwarf_Unit_Entry;
+
+int dwarf_get_unit_directory(Dwarf_Debug dbg,
+    Dwarf_Bool          is_info,
+    Dwarf_Unit_Entry ** units_out,
+    Dwarf_Unsigned *    count_out,
+    Dwarf_Error *       error);
+void dwarf_dealloc_unit_directory(Dwarf_Unit_Entry *units);
+\fP
+.DE
+New October 2026.
+On success
+\f(CWdwarf_get_unit_directory()\fP
+returns
+\f(CWDW_DLV_OK\fP
+and sets
+\f(CW*units_out\fP
+to an array of
+\f(CW*count_out\fP
+entries, one per unit header in .debug_info (if
+\f(CWis_info\fP
+is non-zero) or .debug_types, in section order.
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if the section is absent or holds no unit.
+.P
+Only the header bytes of each unit are read.
+Where
+\f(CWdwarf_next_cu_header_d()\fP
+builds a CU context and reads the unit DIE of every
+unit it passes, nothing is built or recorded here, so
+a tool wanting just the unit map of a large
+.debug_info reads a few bytes per unit.
+The context is built when a unit is first opened,
+for example by passing its
+\f(CWue_die_offset\fP
+to
+\f(CWdwarf_offdie_b()\fP.
+Neither is the position of a
+\f(CWdwarf_next_cu_header_d()\fP
+loop changed.
+.P
+The fields are those of the header.
+\f(CWue_length\fP
+is the unit_length, so the unit takes
+\f(CWue_length + ue_length_size + ue_extension_size\fP
+bytes.
+\f(CWue_unit_type\fP
+is that of a DWARF5 header; for earlier versions it is
+\f(CWDW_UT_compile\fP
+in .debug_info and
+\f(CWDW_UT_type\fP
+in .debug_types, as telling a DWARF4 partial or
+split unit apart takes its unit DIE.
+\f(CWue_signature\fP
+holds the type signature of a type unit (with
+\f(CWue_type_offset\fP)
+or the dwo_id of a DWARF5 skeleton or split compile unit.
+\f(CWue_abbrev_offset\fP
+is not adjusted by a .dwp index.
+.P
+Free the array with
+\f(CWdwarf_dealloc_unit_directory()\fP.
+
 .H 3 "dwarf_next_cu_header_c()"
 .DS
 \f(CWint dwarf_next_cu_header_c(
@@ -4395,6 +4773,21 @@ It returns \f(CWDW_DLV_NO_ENTRY\fP if
 It returns \f(CWDW_DLV_ERROR\fP if
 an error occurred.
 
+.H 3 "dwarf_diename_view()"
+.DS
+\f(CWint dwarf_diename_view(
+    Dwarf_Die die,
+    const char  ** return_name,
+    Dwarf_Unsigned * return_length,
+    Dwarf_Error *error)\fP
+.DE
+New October 2026.
+Exactly like \f(CWdwarf_diename()\fP
+but on success also sets
+\f(CW*return_length\fP to the length of the
+name (not counting the terminating NUL).
+See \f(CWdwarf_formstring_view()\fP.
+
 .H 3 "dwarf_die_text()"
 .DS
 \f(CWint dwarf_die_text(
@@ -5297,6 +5690,38 @@ existing DWARF memory and the pointer becomes stale/invalid
 after a call to \f(CWdwarf_finish\fP.
 \f(CWdwarf_formstring()\fP returns \f(CWDW_DLV_ERROR\fP on error.
 
+.H 3 "dwarf_formstring_view()"
+.DS
+\f(CWint dwarf_formstring_view(
+        Dwarf_Attribute attr,
+        const char  **  return_string,
+        Dwarf_Unsigned * return_length,
+        Dwarf_Error *error)\fP
+.DE
+New October 2026.
+Exactly like \f(CWdwarf_formstring()\fP
+but on success also sets
+\f(CW*return_length\fP to the length of the
+string (not counting the terminating NUL).
+The string is still NUL terminated.
+The length is not stored in the DWARF, so it is found
+by one scan for the NUL bounded by the end of the
+section, and that scan is also the check that the
+string is terminated.
+The string is read once, where
+\f(CWdwarf_formstring()\fP
+followed by
+\f(CWstrlen()\fP
+would read an inline string twice.
+.P
+\f(CWdwarf_formstring()\fP
+itself checks strings in \f(CW.debug_str\fP and
+\f(CW.debug_line_str\fP
+against the position of the last NUL
+in the section, found once when the section is loaded,
+so that check costs the same regardless
+of the string length.
+
 .H 3 "dwarf_formsig8()"
 .DS
 \f(CWint dwarf_formsig8(
@@ -6098,6 +6523,76 @@ void example_loclistcv5(Dwarf_Debug dbg,Dwarf_Attribute someattr)
 }
 \fP
 .DE
+.H 3 "dwarf_get_loclist_at_pc()"
+.DS
+\f(CW
+int dwarf_get_loclist_at_pc(Dwarf_Attribute attr,
+   Dwarf_Addr         pc,
+   Dwarf_Loc_Head_c * loclist_head,
+   Dwarf_Locdesc_c  * locdesc,
+   Dwarf_Error      * error);
+\fP
+.DE
+New October 2026.
+This is
+\f(CWdwarf_get_loclist_c()\fP
+for a caller that wants the location of
+a variable at one
+\f(CWpc\fP,
+as a profiler or debugger sampling
+variables does.
+The entries of the list are walked in the
+.debug_loc or .debug_loclists bytes and
+only the expression of the entry whose
+range covers
+\f(CWpc\fP
+is decoded, so the cost no longer grows
+with the length of the list.
+.P
+On success this returns
+\f(CWDW_DLV_OK\fP,
+sets
+\f(CW*loclist_head\fP
+to a head holding exactly one entry, index zero,
+and sets
+\f(CW*locdesc\fP
+to that entry.
+Use
+\f(CWdwarf_get_locdesc_entry_d()\fP
+and
+\f(CWdwarf_get_location_op_value_d()\fP
+on it as on any entry from
+\f(CWdwarf_get_loclist_c()\fP,
+or pass
+\f(CW*locdesc\fP
+to
+\f(CWdwarf_expr_compile()\fP
+(the compiled program is cached by the
+expression's section offset so repeated queries
+landing on the same entry share it).
+Free the head with
+\f(CWdwarf_loc_head_c_dealloc()\fP.
+.P
+If
+\f(CWattr\fP
+is a location expression rather than a list
+that expression is returned whatever
+\f(CWpc\fP is.
+A DWARF5
+\f(CWDW_LLE_default_location\fP
+entry is returned only if no bounded entry
+covers
+\f(CWpc\fP.
+For a .dwo the .debug_addr of the tied
+object is used when the .dwo has none.
+.P
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if no entry of the list covers
+\f(CWpc\fP
+and
+\f(CWDW_DLV_ERROR\fP
+on error.
 .H 3 "dwarf_get_locdesc_entry_d()"
 Earlier versions of this work with earlier
 versions of DWARF. This works with all
@@ -6358,6 +6853,184 @@ value.
 is probably not a possible return value, but
 please test for it anyway.
 
+.H 3 "dwarf_expr_compile()"
+.DS
+\f(CW
+int dwarf_expr_compile(Dwarf_Locdesc_c locdesc,
+    Dwarf_Expr_Program * program_out,
+    Dwarf_Error        * error);
+\fP
+.DE
+New October 2026.
+The function
+\f(CWdwarf_expr_compile()\fP
+translates the operators of
+\f(CWlocdesc\fP
+(from
+\f(CWdwarf_get_locdesc_entry_d()\fP)
+into a compact program for
+\f(CWdwarf_expr_evaluate()\fP
+and returns it through
+\f(CW*program_out\fP.
+Literal and constant operators
+(including
+\f(CWDW_OP_addrx\fP
+and
+\f(CWDW_OP_constx\fP,
+which are looked up in .debug_addr now)
+are folded into one form and branch
+targets are resolved, so evaluation
+does not decode any bytes.
+.P
+The program is remembered in the
+\f(CWDwarf_Debug\fP
+by the section offset of the expression,
+so compiling the same expression again
+(for example for the same variable at
+another pc) returns the same program at
+the cost of a lookup.
+Such a program stays valid after
+\f(CWdwarf_loc_head_c_dealloc()\fP
+and is freed by
+\f(CWdwarf_finish()\fP.
+An expression from
+\f(CWdwarf_loclist_from_expr_c()\fP
+has no section offset and is not remembered;
+free it with
+\f(CWdwarf_expr_program_dealloc()\fP.
+.P
+Operators the evaluator cannot handle
+(\f(CWDW_OP_piece\fP,
+\f(CWDW_OP_bit_piece\fP,
+\f(CWDW_OP_entry_value\fP,
+\f(CWDW_OP_call*\fP,
+the typed-stack operators and the like)
+cause
+\f(CWDW_DLV_ERROR\fP
+with the error
+\f(CWDW_DLE_EXPR_UNSUPPORTED_OP\fP.
+\f(CWDW_DLV_NO_ENTRY\fP
+is returned if the expression has no operators.
+
+.H 3 "dwarf_expr_evaluate()"
+.DS
+\f(CW
+typedef struct Dwarf_Expr_Callbacks_s {
+    void *ec_user_data;
+    int (*ec_read_register)(void *user_data,
+        Dwarf_Unsigned regnum, Dwarf_Unsigned *value_out);
+    int (*ec_read_memory)(void *user_data,
+        Dwarf_Addr addr, Dwarf_Unsigned size,
+        Dwarf_Unsigned *value_out);
+    int (*ec_frame_base)(void *user_data,
+        Dwarf_Unsigned *value_out);
+    int (*ec_call_frame_cfa)(void *user_data,
+        Dwarf_Unsigned *value_out);
+    int (*ec_object_address)(void *user_data,
+        Dwarf_Unsigned *value_out);
+} Dwarf_Expr_Callbacks;
+
+typedef struct Dwarf_Expr_Result_s {
+    Dwarf_Small        er_kind;
+    Dwarf_Unsigned     er_value;
+    Dwarf_Unsigned     er_implicit_length;
+    const Dwarf_Small *er_implicit_data;
+} Dwarf_Expr_Result;
+
+int dwarf_expr_evaluate(Dwarf_Expr_Program program,
+    const Dwarf_Expr_Callbacks * callbacks,
+    Dwarf_Expr_Result  * result_out,
+    Dwarf_Error        * error);
+\fP
+.DE
+New October 2026.
+The function
+\f(CWdwarf_expr_evaluate()\fP
+runs
+\f(CWprogram\fP
+and on success returns
+\f(CWDW_DLV_OK\fP
+and fills in
+\f(CW*result_out\fP.
+Values on the stack are
+address-size values of the compilation unit.
+.P
+Target state comes from the callbacks,
+each of which is passed
+\f(CWec_user_data\fP
+and must return
+\f(CWDW_DLV_OK\fP
+after setting
+\f(CW*value_out\fP.
+\f(CWec_read_register\fP
+serves the
+\f(CWDW_OP_breg*\fP
+operators,
+\f(CWec_read_memory\fP
+serves
+\f(CWDW_OP_deref\fP
+and
+\f(CWDW_OP_deref_size\fP
+(returning
+\f(CWsize\fP
+bytes as a host value),
+\f(CWec_frame_base\fP
+serves
+\f(CWDW_OP_fbreg\fP
+(the caller evaluates the function's
+\f(CWDW_AT_frame_base\fP),
+\f(CWec_call_frame_cfa\fP
+serves
+\f(CWDW_OP_call_frame_cfa\fP
+and
+\f(CWec_object_address\fP
+serves
+\f(CWDW_OP_push_object_address\fP.
+Callbacks an expression does not need
+may be NULL.
+A NULL or failing callback the expression does
+need results in
+\f(CWDW_DLE_EXPR_CALLBACK_FAILED\fP.
+.P
+\f(CWer_kind\fP
+is one of
+.in +2
+.DS
+\f(CWDW_EXPR_RESULT_ADDRESS\fP: \f(CWer_value\fP is
+the memory address of the object.
+\f(CWDW_EXPR_RESULT_REGISTER\fP: the object is in
+register number \f(CWer_value\fP.
+\f(CWDW_EXPR_RESULT_VALUE\fP: \f(CWer_value\fP is the
+value of the object (\f(CWDW_OP_stack_value\fP).
+\f(CWDW_EXPR_RESULT_IMPLICIT\fP: the value is the
+\f(CWer_implicit_length\fP bytes at
+\f(CWer_implicit_data\fP (\f(CWDW_OP_implicit_value\fP).
+.DE
+.in -2
+.P
+Stack underflow or overflow results in
+\f(CWDW_DLE_EXPR_STACK_ERROR\fP.
+Division by zero, a misplaced register operator or
+an expression that runs too long
+(a loop made with \f(CWDW_OP_bra\fP)
+results in
+\f(CWDW_DLE_EXPR_EVAL_ERROR\fP.
+Evaluation allocates no memory.
+
+.H 3 "dwarf_expr_program_dealloc()"
+.DS
+\f(CW
+void dwarf_expr_program_dealloc(Dwarf_Expr_Program program);
+\fP
+.DE
+New October 2026.
+Frees a program
+\f(CWdwarf_expr_compile()\fP
+could not cache.
+For a cached program this does nothing,
+so it is safe to call on every program
+when done with it.
+
 .H 3 "dwarf_loclist_from_expr_c()"
 This is now obsolete, though it works as
 well as ever, so if it works for your object
@@ -7365,6 +8038,30 @@ pointer.
 \f(CWDW_DLV_NO_ENTRY\fP
 will not be returned.
 
+.H 3 "dwarf_srclines_file_path()"
+.DS
+\f(CW
+int dwarf_srclines_file_path(Dwarf_Line_Context line_context,
+    Dwarf_Signed     index,
+    const char **    returned_path,
+    Dwarf_Error   *  error);
+\fP
+.DE
+New October 2026.
+On success returns
+\f(CWDW_DLV_OK\fP and sets
+\f(CW*returned_path\fP to the full path
+of file \f(CWindex\fP
+(from \f(CWbaseindex\fP up to but not including
+\f(CWendindex\fP as returned by
+\f(CWdwarf_srclines_files_indexes()\fP),
+built exactly as \f(CWdwarf_linesrc()\fP builds it.
+The string has the lifetime described under
+\f(CWdwarf_linesrc_b()\fP.
+An index out of range is an error.
+For a DWARF2,3,4 table an index of zero
+returns \f(CWDW_DLV_NO_ENTRY\fP.
+
 
 
 .H 3 "dwarf_srclines_files_count()"
@@ -7939,6 +8636,32 @@ the allocation type
 \f(CWDW_DLA_STRING\fP when no longer of interest.
 It never returns \f(CWDW_DLV_NO_ENTRY\fP.
 
+.H 3 "dwarf_linesrc_b()"
+.DS
+\f(CWint dwarf_linesrc_b(
+    Dwarf_Line line,
+    const char ** return_linesrc,
+    Dwarf_Error *error)\fP
+.DE
+New October 2026.
+The function \f(CWdwarf_linesrc_b()\fP
+is identical to \f(CWdwarf_linesrc()\fP
+except that the string returned through
+\f(CW*return_linesrc\fP belongs to the
+line table context.
+The full path is computed once per
+file entry of the line table header
+so printing or symbolizing every line
+of a table does not allocate per line.
+.P
+The string remains valid until the line table
+context is freed by
+\f(CWdwarf_srclines_dealloc_b()\fP
+(or by \f(CWdwarf_finish()\fP).
+Do not call \f(CWdwarf_dealloc()\fP on it.
+For a DWARF2,3,4 line whose file number is zero
+\f(CWDW_DLV_NO_ENTRY\fP is returned.
+
 .H 3 "dwarf_lineblock()"
 .DS
 \f(CWint dwarf_lineblock(
@@ -8358,6 +9081,87 @@ and the name-pointer returned points to the empty string.
 A zero is never a valid DIE offset, so zero always
 means this is an uninteresting (Dwarf_Global).
 
+.H 4 "dwarf_pubnames_lookup()"
+.DS
+\f(CWtypedef struct Dwarf_Pubname_Match_s {
+    const char    *pm_name;
+    Dwarf_Off      pm_cu_offset;
+    Dwarf_Off      pm_die_offset;
+    Dwarf_Bool     pm_is_gnu;
+    Dwarf_Small    pm_gnu_flags;
+} Dwarf_Pubname_Match;
+
+int dwarf_pubnames_lookup(Dwarf_Debug dbg,
+    const char *name,
+    const Dwarf_Pubname_Match **matches_out,
+    Dwarf_Unsigned *match_count_out,
+    Dwarf_Error *error)\fP
+.DE
+The function \f(CWdwarf_pubnames_lookup()\fP
+looks up \f(CWname\fP in both .debug_pubnames
+and .debug_gnu_pubnames.
+On success it returns \f(CWDW_DLV_OK\fP,
+sets \f(CW*match_count_out\fP to the number of
+entries with exactly that name and
+\f(CW*matches_out\fP to the first of them.
+It returns \f(CWDW_DLV_NO_ENTRY\fP if
+there is no such name or neither section
+is present, and \f(CWDW_DLV_ERROR\fP if
+a section is corrupt.
+.P
+The first call reads every entry of both sections
+into one array sorted by name and then by DIE offset,
+with the names in one string area, and builds a hash table
+of the names.
+Later calls allocate nothing and take constant time
+plus the number of matches.
+Unlike \f(CWdwarf_get_globals()\fP no
+\f(CWDwarf_Global\fP is created per entry.
+.P
+\f(CWpm_cu_offset\fP is the .debug_info offset of the
+CU header and \f(CWpm_die_offset\fP the global
+offset of the DIE, suitable for \f(CWdwarf_offdie_b()\fP.
+\f(CWpm_is_gnu\fP is non-zero for an entry
+from .debug_gnu_pubnames, and \f(CWpm_gnu_flags\fP
+is then its GDB index kind and static byte.
+.P
+The matches point into the index, which belongs
+to \f(CWdbg\fP.
+Do not free them.
+They remain valid until
+\f(CWdwarf_pubnames_index_clear()\fP or
+\f(CWdwarf_finish()\fP.
+The function is new in October 2026.
+
+.H 4 "dwarf_pubnames_lookup_prefix()"
+.DS
+\f(CWint dwarf_pubnames_lookup_prefix(Dwarf_Debug dbg,
+    const char *prefix,
+    const Dwarf_Pubname_Match **matches_out,
+    Dwarf_Unsigned *match_count_out,
+    Dwarf_Error *error)\fP
+.DE
+The function \f(CWdwarf_pubnames_lookup_prefix()\fP
+is like \f(CWdwarf_pubnames_lookup()\fP
+but returns every entry whose name starts with
+\f(CWprefix\fP, in name order.
+An empty \f(CWprefix\fP returns every entry.
+It is found by binary search in the same index.
+The function is new in October 2026.
+
+.H 4 "dwarf_pubnames_index_clear()"
+.DS
+\f(CWvoid dwarf_pubnames_index_clear(Dwarf_Debug dbg)\fP
+.DE
+The function \f(CWdwarf_pubnames_index_clear()\fP
+frees the index built by
+\f(CWdwarf_pubnames_lookup()\fP.
+Any matches returned earlier become invalid.
+The next lookup builds the index again.
+\f(CWdwarf_finish()\fP frees the index
+so calling this is never required.
+The function is new in October 2026.
+
 .H 3 "Accelerated Access Pubtypes"
 Section ".debug_pubtypes" is in DWARF3 and DWARF4.
 .P
@@ -9536,6 +10340,170 @@ Allows retrieving detailed
 data from a portion of the entrypool
 by index and offset.
 
+.H 3 " dwarf_debugnames_name_string()"
+.DS
+\f(CW int dwarf_debugnames_name_string(
+    Dwarf_Dnames_Head dn,
+    Dwarf_Unsigned      index_number,
+    Dwarf_Unsigned      name_entry,
+    const char       ** name,
+    Dwarf_Error *       error)
+\fP
+.DE
+On success sets
+\f(CW*name\fP
+to the string of entry
+\f(CWname_entry\fP
+(counting from one as in
+\f(CWdwarf_debugnames_name()\fP)
+of name index
+\f(CWindex_number\fP.
+The string belongs to libdwarf, do not free it.
+
+.H 3 " dwarf_debugnames_lookup()"
+.DS
+\f(CW typedef struct Dwarf_Dnames_Match_s {
+    Dwarf_Unsigned dm_tag;
+    Dwarf_Unsigned dm_unit_offset;
+    Dwarf_Unsigned dm_die_offset;
+    Dwarf_Bool     dm_is_type_unit;
+} Dwarf_Dnames_Match;
+
+int dwarf_debugnames_lookup(Dwarf_Dnames_Head dn,
+    const char *          name,
+    Dwarf_Dnames_Match ** matches_out,
+    Dwarf_Unsigned *      match_count_out,
+    Dwarf_Error *         error)
+\fP
+.DE
+Looks up
+\f(CWname\fP
+(an exact, case sensitive match)
+through the hash table of every
+name index in
+\f(CWdn\fP
+so only the names in one bucket
+are compared.
+On success returns
+\f(CWDW_DLV_OK\fP
+and an array of
+\f(CW*match_count_out\fP
+matches, one per entry.
+Both offsets in a match are
+global section offsets and
+\f(CWdm_die_offset\fP
+can be passed directly to
+\f(CWdwarf_offdie_b()\fP.
+Returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if the name is not present.
+.P
+Free the array with
+\f(CWdwarf_dealloc_debugnames_matches()\fP.
+
+.H 3 " dwarf_dealloc_debugnames_matches()"
+.DS
+\f(CW void dwarf_dealloc_debugnames_matches(
+    Dwarf_Dnames_Match * m)
+\fP
+.DE
+Frees an array returned by
+\f(CWdwarf_debugnames_lookup()\fP.
+A NULL argument is harmless.
+
+.H 3 " dwarf_debugnames_write_sidecar()"
+.DS
+\f(CW int dwarf_debugnames_write_sidecar(
+    Dwarf_Debug dbg,
+    const char *     sidecar_path,
+    Dwarf_Unsigned * names_count,
+    Dwarf_Error *    error)
+\fP
+.DE
+Walks every compilation unit in
+\f(CW.debug_info\fP
+and writes a DWARF5
+\f(CW.debug_names\fP
+index of it, with the name strings,
+to the file
+\f(CWsidecar_path\fP.
+If
+\f(CWsidecar_path\fP
+is NULL the path given to
+\f(CWdwarf_init_path()\fP
+with
+\f(CW.dnames\fP
+appended is used.
+On success
+\f(CW*names_count\fP
+is set to the number of distinct names written.
+Returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if there are no compilation units.
+.P
+Named types, enumerators, namespaces,
+and global functions and variables are indexed.
+Type units and names local to a
+function body are not.
+Where a subprogram has a
+linkage name it is indexed under
+that name as well.
+
+.H 3 " dwarf_debugnames_use_sidecar()"
+.DS
+\f(CW int dwarf_debugnames_use_sidecar(
+    Dwarf_Debug dbg,
+    const char *     sidecar_path,
+    Dwarf_Error *    error)
+\fP
+.DE
+Reads the sidecar file
+\f(CWsidecar_path\fP
+(or, if that is NULL, the path given to
+\f(CWdwarf_init_path()\fP
+with
+\f(CW.dnames\fP
+appended) written by
+\f(CWdwarf_debugnames_write_sidecar()\fP.
+From then on, if the object has no
+\f(CW.debug_names\fP
+section,
+\f(CWdwarf_debugnames_header()\fP
+returns the index in the sidecar.
+libdwarf never reads a sidecar unless
+this is called.
+.P
+The sidecar records the size of
+\f(CW.debug_info\fP
+and a checksum of
+\f(CW.debug_info\fP,
+\f(CW.debug_abbrev\fP,
+\f(CW.debug_str\fP
+and
+\f(CW.debug_str_offsets\fP.
+If either differs from the object
+the sidecar is stale and
+\f(CWDW_DLV_NO_ENTRY\fP
+is returned, as it is when there is no such file.
+Once a sidecar has been read in
+later calls return
+\f(CWDW_DLV_OK\fP
+and keep it.
+.P
+The name strings of a sidecar index
+are in the sidecar, not in
+\f(CW.debug_str\fP,
+so
+\f(CWdwarf_debugnames_name()\fP
+returns
+\f(CWDW_DLV_ERROR\fP
+if asked for the
+\f(CW.debug_str\fP
+offset of one.
+Use
+\f(CWdwarf_debugnames_name_string()\fP
+instead.
+
 .H 2 "Names Fast Access .debug_gnu_pubnames"
 The sections
 \f(CW.debug_gnu_pubnames\fP
@@ -10498,6 +11466,95 @@ is returned and
 the error details are returned through the pointer
 \f(CWerror\fP.
 
+.H 4 "dwarf_get_macro_flattened()"
+.DS
+\f(CWtypedef struct Dwarf_Macro_Flat_Entry_s {
+    Dwarf_Half     fe_op;
+    Dwarf_Unsigned fe_line;
+    const char    *fe_string;
+    Dwarf_Unsigned fe_unit_offset;
+} Dwarf_Macro_Flat_Entry;
+
+int dwarf_get_macro_flattened(Dwarf_Die cu_die,
+    Dwarf_Macro_Flat_Entry ** entries_out,
+    Dwarf_Unsigned         *  entry_count_out,
+    Dwarf_Error            *  error);\fP
+.DE
+New October 2026.
+Given a Compilation Unit (CU) die
+\f(CWdwarf_get_macro_flattened()\fP
+returns, through
+\f(CW*entries_out\fP,
+an array of all the defines and undefines
+of the CU in order, with each
+\f(CWDW_MACRO_import\fP
+replaced by the operations of the imported unit
+(recursively).
+Applying the entries in order gives the
+macro definitions in effect at the end of the CU.
+.P
+\f(CWfe_op\fP
+is
+\f(CWDW_MACRO_define\fP
+or
+\f(CWDW_MACRO_undef\fP
+whatever form the operation had in the section,
+\f(CWfe_line\fP
+is its line number,
+\f(CWfe_string\fP
+the macro string (as from
+\f(CWdwarf_get_macro_defundef()\fP)
+and
+\f(CWfe_unit_offset\fP
+the .debug_macro offset of the
+macro unit the operation is in.
+\f(CWDW_MACRO_import_sup\fP
+is not followed.
+.P
+Each macro unit is decoded once per
+\f(CWDwarf_Debug\fP
+(this applies to
+\f(CWdwarf_get_macro_context()\fP
+and
+\f(CWdwarf_get_macro_context_by_offset()\fP
+too) and the flattened
+list of an imported unit is remembered,
+so a unit imported by many CUs is
+walked once.
+Units using
+\f(CWDW_MACRO_define_strx\fP
+or
+\f(CWDW_MACRO_undef_strx\fP
+depend on the CU and are walked for each CU.
+.P
+Free the array with
+\f(CWdwarf_dealloc_macro_flattened()\fP.
+The strings remain valid until then.
+Strings from .debug_macro itself are
+copied into the array, so the array does not
+depend on that section staying loaded (see
+\f(CWdwarf_set_section_memory_budget()\fP).
+.P
+\f(CWDW_DLV_NO_ENTRY\fP
+is returned if the CU has no
+\f(CWDW_AT_macros\fP
+(or
+\f(CWDW_AT_GNU_macros\fP)
+attribute or there are no defines or undefines.
+An import loop results in
+\f(CWDW_DLV_ERROR\fP
+with the error
+\f(CWDW_DLE_MACRO_IMPORT_LOOP\fP.
+
+.H 4 "dwarf_dealloc_macro_flattened()"
+.DS
+\f(CWvoid dwarf_dealloc_macro_flattened(
+    Dwarf_Macro_Flat_Entry * entries);\fP
+.DE
+New October 2026.
+Frees the array returned by
+\f(CWdwarf_get_macro_flattened()\fP.
+
 
 .H 2 "Macro Information Operations (DWARF2, DWARF3, DWARF4)"
 This section refers to DWARF2,DWARF3,and DWARF4
@@ -11950,6 +13007,130 @@ void examples(Dwarf_Debug dbg,Dwarf_Cie cie,
 \fP
 .DE
 .in -2
+.H 3 "dwarf_unwinder_create()"
+.DS
+\f(CWint dwarf_unwinder_create(Dwarf_Debug dbg,
+    Dwarf_Half sp_regnum,
+    Dwarf_Unsigned row_cache_size,
+    Dwarf_Unwinder *unwinder_out,
+    Dwarf_Error *error)
+void dwarf_unwinder_set_load_bias(Dwarf_Unwinder unwinder,
+    Dwarf_Addr load_bias)
+void dwarf_unwinder_stats(Dwarf_Unwinder unwinder,
+    Dwarf_Unsigned *row_cache_hits,
+    Dwarf_Unsigned *row_cache_misses)
+void dwarf_unwinder_dealloc(Dwarf_Unwinder unwinder)\fP
+.DE
+New October 2026.
+\f(CWdwarf_unwinder_create()\fP
+loads the \f(CW.eh_frame\fP and \f(CW.debug_frame\fP
+FDE lists of \f(CWdbg\fP (either may be absent)
+and allocates everything
+\f(CWdwarf_unwind_stack()\fP needs,
+then sets \f(CW*unwinder_out\fP.
+\f(CWsp_regnum\fP is the DWARF register number of
+the stack pointer, which is given the CFA as its
+value in each caller frame unless the CFI has a rule
+for it.
+Up to \f(CWrow_cache_size\fP computed CFI rows,
+rounded up to a power of two, are kept
+by pc so that pcs seen before skip the FDE search
+and the frame instructions.
+Zero turns the row cache off.
+It returns \f(CWDW_DLV_NO_ENTRY\fP if \f(CWdbg\fP
+has no FDEs.
+.P
+The register table size
+(see \f(CWdwarf_set_frame_rule_table_size()\fP)
+must be set before the unwinder is created and not
+changed while it exists.
+.P
+\f(CWdwarf_unwinder_set_load_bias()\fP sets the
+amount the object was relocated by in the target
+(zero by default), see
+\f(CWdwarf_unwind_stack()\fP.
+Cached rows do not depend on it, so one unwinder
+can serve samples from many processes.
+.P
+\f(CWdwarf_unwinder_stats()\fP returns the row cache
+hit and miss counts so far.
+\f(CWdwarf_unwinder_dealloc()\fP frees the unwinder,
+which must be done before \f(CWdwarf_finish()\fP.
+
+.H 3 "dwarf_unwind_stack()"
+.DS
+\f(CWint dwarf_unwind_stack(Dwarf_Unwinder unwinder,
+    const Dwarf_Unwind_Callbacks *callbacks,
+    Dwarf_Addr pc,
+    const Dwarf_Unsigned *registers,
+    const Dwarf_Small *registers_valid,
+    Dwarf_Unsigned register_count,
+    Dwarf_Unsigned max_depth,
+    Dwarf_Addr *pcs_out,
+    Dwarf_Unsigned *pc_count,
+    Dwarf_Error *error)\fP
+.DE
+New October 2026.
+\f(CWdwarf_unwind_stack()\fP walks the stack of
+a thread stopped at \f(CWpc\fP whose registers are
+\f(CWregisters[0]\fP through
+\f(CWregisters[register_count-1]\fP,
+indexed by DWARF register number.
+If \f(CWregisters_valid\fP is non-null, register
+\f(CWi\fP is known only if
+\f(CWregisters_valid[i]\fP is nonzero.
+For each frame it finds the CFI row for the pc,
+computes the CFA, applies the register rules
+to get the registers of the caller
+and takes the return address register
+of the CIE as the caller's pc.
+For frames other than the first
+(and those called by a signal frame)
+the row is looked up at the return address
+minus one, so a call that is the last
+instruction of a function is found in that function.
+.P
+\f(CWpcs_out[0]\fP is \f(CWpc\fP
+and each later entry a return address.
+At most \f(CWmax_depth\fP pcs are written and
+\f(CW*pc_count\fP is set to the number written.
+The walk ends quietly, returning \f(CWDW_DLV_OK\fP,
+when no FDE covers a pc,
+the CFA or the return address cannot be computed
+or read, the return address is zero, or a frame
+repeats.
+It returns \f(CWDW_DLV_ERROR\fP only for bad
+arguments or corrupt CFI.
+.P
+The target is reached through \f(CWcallbacks\fP.
+Each callback returns \f(CWDW_DLV_OK\fP with the
+value set; anything else means the value is not
+available.
+\f(CWuc_read_memory\fP returns
+\f(CWsize\fP bytes (the address size of the CIE)
+at an address, converted to a host value.
+\f(CWuc_eval_expression\fP evaluates the DWARF
+expression of a
+\f(CWDW_CFA_def_cfa_expression\fP,
+\f(CWDW_CFA_expression\fP or
+\f(CWDW_CFA_val_expression\fP
+against the registers of the frame being unwound,
+with the CFA pushed first when \f(CWpush_cfa\fP is
+true.
+It may be NULL, and then such rules are treated as
+unavailable.
+.P
+The pc, registers and memory are those of the
+target.
+Each pc has the load bias set by
+\f(CWdwarf_unwinder_set_load_bias()\fP subtracted
+before its CFI is looked up, so the walk ends at the
+first pc outside the object \f(CWdbg\fP describes.
+.P
+Nothing is allocated per call or per frame, other
+than the first time a CIE is used.
+Frame rows come from the row cache when possible.
+
 .H 3 "dwarf_get_fde_exception_info()"
 .DS
 \f(CWint dwarf_get_fde_exception_info(
@@ -13789,6 +14970,714 @@ to a block of \f(CWDwarf_Ranges\fP array and the
 number of structures in the block.
 It frees all the data in the array of structures.
 
+.H 2 "Range iteration operations"
+New October 2026.
+These functions return the pc ranges of a DIE
+as [low,high) address pairs, whatever the DWARF
+version, decoding .debug_ranges or .debug_rnglists
+directly.
+Unlike
+\f(CWdwarf_get_ranges_a()\fP and
+\f(CWdwarf_rnglists_get_rle_head()\fP
+they allocate nothing: the iterator state is a
+\f(CWDwarf_Range_Iter\fP owned by the caller,
+usually a local variable.
+
+.H 3 "dwarf_range_iter_begin()"
+.DS
+\f(CWint dwarf_range_iter_begin(Dwarf_Die die,
+    Dwarf_Range_Iter *it,
+    Dwarf_Error *error)\fP
+.DE
+The function \f(CWdwarf_range_iter_begin()\fP
+sets up \f(CW*it\fP to return the ranges of
+\f(CWdie\fP.
+If \f(CWdie\fP has \f(CWDW_AT_ranges\fP
+these are the entries of that list, in list order.
+Otherwise if it has \f(CWDW_AT_low_pc\fP
+they are the one range from
+\f(CWDW_AT_low_pc\fP to
+\f(CWDW_AT_high_pc\fP
+(or a single address if there is no
+\f(CWDW_AT_high_pc\fP).
+It returns \f(CWDW_DLV_NO_ENTRY\fP
+if \f(CWdie\fP has none of these
+and \f(CWDW_DLV_ERROR\fP on error.
+.P
+Base address entries, \f(CWDW_FORM_rnglistx\fP
+(including in a DWARF5 split unit)
+and the \f(CWDW_RLE_*x*\fP forms
+indexing .debug_addr (found through the tied object
+for a .dwo, see \f(CWdwarf_set_tied_dbg()\fP)
+are all applied, so only cooked addresses are returned.
+Entries needing .debug_addr when there is none
+available are skipped.
+
+.H 3 "dwarf_range_iter_next()"
+.DS
+\f(CWint dwarf_range_iter_next(Dwarf_Range_Iter *it,
+    Dwarf_Addr *low,
+    Dwarf_Addr *high,
+    Dwarf_Error *error)\fP
+.DE
+The function \f(CWdwarf_range_iter_next()\fP
+returns \f(CWDW_DLV_OK\fP and the next range
+as \f(CW*low\fP (the first address)
+and \f(CW*high\fP (one past the last).
+Empty ranges are skipped.
+It returns \f(CWDW_DLV_NO_ENTRY\fP
+after the last range and
+\f(CWDW_DLV_ERROR\fP
+if the list is corrupt.
+.P
+The iterator remains usable only as long as
+the \f(CWDwarf_Debug\fP
+is open.
+It records its place as a section offset,
+not a pointer, and each call reloads
+the section if it was evicted meanwhile
+(see \f(CWdwarf_set_section_memory_budget()\fP),
+so any other libdwarf calls may be made
+between calls.
+Stopping part way through a list is fine.
+
+.H 3 "dwarf_range_cache_set_size()"
+.DS
+\f(CWint dwarf_range_cache_set_size(Dwarf_Debug dbg,
+    Dwarf_Unsigned list_count,
+    Dwarf_Error *error)
+void dwarf_range_cache_stats(Dwarf_Debug dbg,
+    Dwarf_Unsigned *hits,
+    Dwarf_Unsigned *misses)\fP
+.DE
+The function \f(CWdwarf_range_cache_set_size()\fP
+turns on a cache of decoded range lists for
+\f(CWdbg\fP, for applications
+asking for the same lists repeatedly.
+With the cache on,
+\f(CWdwarf_range_iter_begin()\fP
+looks the list up by its section offset
+and CU and, on a miss, decodes the whole list
+once into the cache.
+\f(CWdwarf_range_iter_next()\fP then
+returns the cached pairs.
+The cache is direct mapped with
+\f(CWlist_count\fP slots, rounded up to a power
+of two.
+An iterator whose list was replaced in the cache
+by a later query carries on from the section data,
+so iterators may be interleaved freely.
+Passing zero (the default) turns caching off
+and frees the cached lists.
+\f(CWdwarf_finish()\fP frees the cache.
+.P
+\f(CWdwarf_range_cache_stats()\fP
+returns the cache hit and miss counts so far.
+
+.H 2 "Inline frame operations"
+New October 2026.
+These functions map a pc to the chain of
+\f(CWDW_TAG_inlined_subroutine\fP
+DIEs containing it, out to the
+\f(CWDW_TAG_subprogram\fP,
+without the caller walking DIEs.
+.P
+On the first call libdwarf reads the CU DIE
+of every CU in .debug_info
+(by offset, so a CU loop in progress with
+\f(CWdwarf_next_cu_header_d()\fP
+is not disturbed) and records their
+pc ranges.
+The first query landing in a CU reads that CU once,
+keeping every subprogram and inlined subroutine
+with code, its name (following
+\f(CWDW_AT_abstract_origin\fP
+and
+\f(CWDW_AT_specification\fP
+as needed) and its call site,
+as a tree of nested address ranges.
+Later queries in that CU do one binary search
+per level of inlining and do not read
+.debug_info.
+CUs whose DIE has neither
+\f(CWDW_AT_ranges\fP
+nor
+\f(CWDW_AT_low_pc\fP
+are not searched.
+Skeleton CUs of split DWARF have no
+function DIEs here, so
+pcs in them return
+\f(CWDW_DLV_NO_ENTRY\fP.
+
+.H 3 "dwarf_inline_frames()"
+.DS
+\f(CW
+typedef struct Dwarf_Inline_Frame_s {
+    Dwarf_Half      if_tag;
+    Dwarf_Off       if_die_offset;
+    Dwarf_Off       if_cu_die_offset;
+    const char    * if_name;
+    const char    * if_linkage_name;
+    Dwarf_Addr      if_lowpc;
+    Dwarf_Addr      if_highpc;
+    const char    * if_call_file;
+    Dwarf_Unsigned  if_call_line;
+    Dwarf_Unsigned  if_call_column;
+} Dwarf_Inline_Frame;
+
+int dwarf_inline_frames(Dwarf_Debug dbg,
+    Dwarf_Addr           pc,
+    Dwarf_Inline_Frame * frames,
+    Dwarf_Unsigned       frames_len,
+    Dwarf_Unsigned *     frame_count,
+    Dwarf_Error *        error);
+\fP
+.DE
+On success
+\f(CWdwarf_inline_frames()\fP
+returns
+\f(CWDW_DLV_OK\fP,
+sets
+\f(CW*frame_count\fP
+to the depth of the chain at
+\f(CWpc\fP
+and fills in up to
+\f(CWframes_len\fP
+entries of
+\f(CWframes\fP,
+innermost first.
+The last frame is the
+\f(CWDW_TAG_subprogram\fP.
+If
+\f(CW*frame_count\fP
+is larger than
+\f(CWframes_len\fP
+call again with a larger array.
+.P
+\f(CWif_lowpc\fP
+and
+\f(CWif_highpc\fP
+are the range of the DIE holding
+\f(CWpc\fP
+(\f(CWif_highpc\fP is one past its end).
+For an inlined subroutine
+\f(CWif_call_file\fP
+(a full path, as from
+\f(CWdwarf_linesrc()\fP),
+\f(CWif_call_line\fP
+and
+\f(CWif_call_column\fP
+say where the next frame out called it.
+They are NULL and zero for the subprogram.
+The strings belong to the
+\f(CWDwarf_Debug\fP
+and stay valid until
+\f(CWdwarf_inline_frames_cache_clear()\fP
+or
+\f(CWdwarf_finish()\fP.
+.P
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if no function covers
+\f(CWpc\fP
+and
+\f(CWDW_DLV_ERROR\fP
+on error.
+
+.H 3 "dwarf_symbolize_pcs()"
+.DS
+\f(CW
+typedef struct Dwarf_Symbolized_Pc_s {
+    int             sp_status;
+    Dwarf_Off       sp_cu_die_offset;
+    const char    * sp_function;
+    const char    * sp_linkage_name;
+    Dwarf_Off       sp_function_die_offset;
+    Dwarf_Addr      sp_function_lowpc;
+    const char    * sp_file;
+    Dwarf_Unsigned  sp_line;
+    Dwarf_Unsigned  sp_column;
+} Dwarf_Symbolized_Pc;
+
+int dwarf_symbolize_pcs(Dwarf_Debug dbg,
+    const Dwarf_Addr *    pcs,
+    Dwarf_Unsigned        count,
+    Dwarf_Symbolized_Pc * results,
+    Dwarf_Error *         error);
+\fP
+.DE
+\f(CWdwarf_symbolize_pcs()\fP
+resolves the
+\f(CWcount\fP
+addresses in
+\f(CWpcs\fP
+at once, as a profiler with many samples
+would want, filling in
+\f(CWresults[i]\fP
+for
+\f(CWpcs[i]\fP.
+The pcs need not be sorted or distinct.
+libdwarf sorts a copy of them and works through
+them in address order, so the CU holding a pc
+is searched for only when a pc falls outside the
+previous CU, and repeated pcs cost a copy.
+It uses the same CU table and per-CU function trees as
+\f(CWdwarf_inline_frames()\fP.
+The first pc landing in a CU also reads that
+CU line table and keeps its rows sorted
+by address, so no line program is
+decoded more than once however many pcs and
+calls land in it.
+.P
+\f(CWsp_function\fP
+and
+\f(CWsp_linkage_name\fP
+name the innermost function at the pc,
+which is an inlined subroutine if the code was
+inlined, as that is the function the line table
+row refers to.
+\f(CWsp_function_die_offset\fP
+and
+\f(CWsp_function_lowpc\fP
+are its DIE and the start of its range
+holding the pc.
+\f(CWsp_file\fP
+(a full path, as from
+\f(CWdwarf_linesrc_b()\fP),
+\f(CWsp_line\fP
+and
+\f(CWsp_column\fP
+come from the line table row holding the pc.
+Either part may be missing (NULL and zero).
+\f(CWsp_status\fP
+is
+\f(CWDW_DLV_OK\fP
+if either was found and
+\f(CWDW_DLV_NO_ENTRY\fP
+if neither was, in which case all other fields are zero.
+The strings belong to the
+\f(CWDwarf_Debug\fP
+and stay valid until
+\f(CWdwarf_inline_frames_cache_clear()\fP
+or
+\f(CWdwarf_finish()\fP.
+.P
+A CU line table that cannot be read leaves its
+pcs without a line rather than failing the call.
+It returns
+\f(CWDW_DLV_OK\fP
+once every pc has a result and
+\f(CWDW_DLV_ERROR\fP
+on error, in which case
+\f(CWresults\fP
+is incomplete.
+
+.H 3 "dwarf_inline_frames_cache_clear()"
+.DS
+\f(CWvoid dwarf_inline_frames_cache_clear(Dwarf_Debug dbg);\fP
+.DE
+Frees everything built by
+\f(CWdwarf_inline_frames()\fP
+and
+\f(CWdwarf_symbolize_pcs()\fP,
+including the line tables the latter keeps,
+for
+\f(CWdbg\fP.
+A later query starts over.
+There is no need to call this before
+\f(CWdwarf_finish()\fP.
+
+.H 2 "Type cache operations"
+New October 2026.
+These functions resolve a type DIE (usually the
+\f(CWDW_AT_type\fP
+of a variable, parameter or member) without the caller
+following
+\f(CWDW_AT_type\fP
+chains through typedefs, qualifiers, pointers
+and arrays.
+.P
+Each type DIE reached is read once per
+\f(CWDwarf_Debug\fP
+and kept in a table keyed by its section offset,
+which is unique across all CUs and type units.
+Later calls on that type, or on any type whose
+chain passes through it, use the cached copy and
+do not read
+.debug_info.
+\f(CWDW_FORM_ref_sig8\fP
+references are followed to their type units
+(the first such reference records the signature of
+every type unit).
+For C++ the namespaces and classes enclosing a type
+are recorded on the first name needing them, by one
+walk of the CU that skips function bodies.
+
+.H 3 "dwarf_type_info()"
+.DS
+\f(CW
+typedef struct Dwarf_Type_Info_s {
+    Dwarf_Off       ti_offset;
+    Dwarf_Bool      ti_is_info;
+    Dwarf_Half      ti_tag;
+    Dwarf_Off       ti_canonical_offset;
+    Dwarf_Bool      ti_canonical_is_info;
+    Dwarf_Half      ti_canonical_tag;
+    Dwarf_Bool      ti_has_byte_size;
+    Dwarf_Unsigned  ti_byte_size;
+    Dwarf_Half      ti_encoding;
+    Dwarf_Bool      ti_has_target;
+    Dwarf_Off       ti_target_offset;
+    Dwarf_Bool      ti_target_is_info;
+    const char    * ti_name;
+    const char    * ti_canonical_name;
+} Dwarf_Type_Info;
+
+int dwarf_type_info(Dwarf_Debug dbg,
+    Dwarf_Off         type_offset,
+    Dwarf_Bool        is_info,
+    Dwarf_Type_Info * info,
+    Dwarf_Error *     error);
+\fP
+.DE
+On success
+\f(CWdwarf_type_info()\fP
+returns
+\f(CWDW_DLV_OK\fP
+and fills in
+\f(CW*info\fP
+for the type DIE at
+\f(CWtype_offset\fP
+(in .debug_info if
+\f(CWis_info\fP
+is non-zero, else in .debug_types).
+.P
+The canonical type is the one under any
+typedefs and
+\f(CWconst\fP,
+\f(CWvolatile\fP,
+\f(CWrestrict\fP
+and
+\f(CW_Atomic\fP
+qualifiers.
+Its offset and tag are zero if that is
+\f(CWvoid\fP.
+\f(CWti_byte_size\fP,
+\f(CWti_encoding\fP
+(a
+\f(CWDW_ATE_*\fP
+value for base types and enumerations)
+and the target (the pointee, array element,
+referenced, underlying or return type, the
+\f(CWDW_AT_type\fP
+of the canonical type) describe the canonical type.
+Where
+\f(CWDW_AT_byte_size\fP
+is absent the size of a pointer or reference is the
+CU address size, that of an array with constant bounds
+is computed from its element, and that of an
+enumeration is that of its underlying type.
+.P
+\f(CWti_name\fP
+and
+\f(CWti_canonical_name\fP
+are C or C++ declarations, such as
+\f(CWconst ns::Node *\fP,
+\f(CWchar *const\fP,
+\f(CWint (*)[4]\fP
+or
+\f(CWint (*)(int, char *)\fP.
+In C, structure, union and enumeration names
+carry their keyword.
+In C++, names are qualified by their namespaces and
+classes and the keyword is left out.
+The strings belong to the
+\f(CWDwarf_Debug\fP
+and stay valid until
+\f(CWdwarf_type_cache_clear()\fP
+or
+\f(CWdwarf_finish()\fP.
+.P
+It returns
+\f(CWDW_DLV_ERROR\fP
+on error, including
+\f(CWDW_DLE_TYPE_CHAIN_ERROR\fP
+if a chain of types is more than 64 deep
+(which in practice means it loops).
+
+.H 3 "dwarf_die_type_info()"
+.DS
+\f(CWint dwarf_die_type_info(Dwarf_Die die,
+    Dwarf_Type_Info * info,
+    Dwarf_Error *     error);\fP
+.DE
+Calls
+\f(CWdwarf_type_info()\fP
+on the type named by the
+\f(CWDW_AT_type\fP
+of
+\f(CWdie\fP,
+in whichever form it is.
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if
+\f(CWdie\fP
+has no
+\f(CWDW_AT_type\fP.
+
+.H 3 "dwarf_type_name()"
+.DS
+\f(CWint dwarf_type_name(Dwarf_Debug dbg,
+    Dwarf_Off     type_offset,
+    Dwarf_Bool    is_info,
+    const char ** name,
+    Dwarf_Error * error);\fP
+.DE
+Sets
+\f(CW*name\fP
+to the
+\f(CWti_name\fP
+that
+\f(CWdwarf_type_info()\fP
+would return.
+
+.H 3 "dwarf_type_cache_clear()"
+.DS
+\f(CWvoid dwarf_type_cache_clear(Dwarf_Debug dbg);\fP
+.DE
+Frees everything built by the functions above for
+\f(CWdbg\fP.
+There is no need to call this before
+\f(CWdwarf_finish()\fP.
+
+.H 2 "Split DWARF session operations"
+New October 2026.
+An executable built with split DWARF and no .dwp
+has one skeleton unit per compilation unit, naming
+a .dwo file
+(\f(CWDW_AT_dwo_name\fP,
+relative to
+\f(CWDW_AT_comp_dir\fP)
+that holds the real DWARF for it.
+\f(CWdwarf_set_tied_dbg()\fP
+links one .dwo to the executable.
+A session does that for all of them: it lists the
+skeleton units once and opens the .dwo of a unit
+only when a lookup needs it, so a lookup opens just
+the one file it needs.
+At most a configurable number of .dwo files
+(and so file descriptors) are open at once;
+the least recently used one is closed to make room.
+.P
+Each .dwo opened is tied to the executable, so
+\f(CWDW_FORM_addrx\fP,
+\f(CWDW_OP_addrx\fP
+and the like in it read the executable's .debug_addr at
+the
+\f(CWDW_AT_addr_base\fP
+of the skeleton unit.
+The skeleton units are recorded when the session
+is created so this never rereads the executable's
+.debug_info, and the session reads units by
+offset, so a caller part way through a
+\f(CWdwarf_next_cu_header_d()\fP
+loop on the executable is not disturbed.
+
+.H 3 "dwarf_dwo_session_create()"
+.DS
+\f(CWint dwarf_dwo_session_create(Dwarf_Debug dbg,
+    const char *        search_dir,
+    Dwarf_Unsigned      max_open,
+    Dwarf_Dwo_Session * session_out,
+    Dwarf_Error *       error);\fP
+.DE
+On success it returns
+\f(CWDW_DLV_OK\fP
+and sets
+\f(CW*session_out\fP
+to a session on the skeleton units of
+\f(CWdbg\fP.
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if
+\f(CWdbg\fP
+has none.
+No .dwo is opened here.
+.P
+A .dwo is looked for first in
+\f(CWsearch_dir\fP
+(if it is non-null), by its
+\f(CWDW_AT_dwo_name\fP
+(just the last path component if that is a full
+path), then at its
+\f(CWDW_AT_dwo_name\fP
+taken relative to the
+\f(CWDW_AT_comp_dir\fP
+of the skeleton unit.
+\f(CWmax_open\fP
+is the limit on open .dwo files, zero for no limit.
+.P
+Call
+\f(CWdwarf_dwo_session_dealloc()\fP
+before
+\f(CWdwarf_finish()\fP
+of
+\f(CWdbg\fP.
+
+.H 3 "dwarf_dwo_session_dealloc()"
+.DS
+\f(CWvoid dwarf_dwo_session_dealloc(Dwarf_Dwo_Session session);\fP
+.DE
+Closes every .dwo the session opened,
+including any still held,
+and frees the session.
+
+.H 3 "dwarf_dwo_session_set_max_open()"
+.DS
+\f(CWint dwarf_dwo_session_set_max_open(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned max_open,
+    Dwarf_Error *  error);\fP
+.DE
+Changes the limit on open .dwo files, closing the
+least recently used ones not held by a caller
+at once if more are open.
+
+.H 3 "dwarf_dwo_session_unit_count()"
+.DS
+\f(CWint dwarf_dwo_session_unit_count(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned * count,
+    Dwarf_Error *    error);\fP
+.DE
+Sets
+\f(CW*count\fP
+to the number of skeleton units.
+
+.H 3 "dwarf_dwo_session_unit()"
+.DS
+\f(CWint dwarf_dwo_session_unit(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned index,
+    Dwarf_Off *    skeleton_cu_die_offset,
+    Dwarf_Bool *   has_dwo_id,
+    Dwarf_Sig8 *   dwo_id,
+    const char **  dwo_name,
+    const char **  comp_dir,
+    Dwarf_Bool *   is_open,
+    Dwarf_Error *  error);\fP
+.DE
+Describes skeleton unit
+\f(CWindex\fP
+(zero through the count less one, in .debug_info
+order) without opening its .dwo.
+Any of the pointer arguments may be null.
+\f(CW*comp_dir\fP
+is set to null if the skeleton unit has no
+\f(CWDW_AT_comp_dir\fP.
+The strings belong to the session.
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if
+\f(CWindex\fP
+is out of range.
+
+.H 3 "dwarf_dwo_session_by_id()"
+.DS
+\f(CWint dwarf_dwo_session_by_id(Dwarf_Dwo_Session session,
+    Dwarf_Sig8     dwo_id,
+    Dwarf_Debug *  dwo_dbg,
+    Dwarf_Off *    dwo_cu_die_offset,
+    Dwarf_Error *  error);
+int dwarf_dwo_session_by_name(Dwarf_Dwo_Session session,
+    const char *   dwo_name,
+    const char *   comp_dir,
+    Dwarf_Debug *  dwo_dbg,
+    Dwarf_Off *    dwo_cu_die_offset,
+    Dwarf_Error *  error);
+int dwarf_dwo_session_by_skeleton(Dwarf_Dwo_Session session,
+    Dwarf_Off      skeleton_cu_die_offset,
+    Dwarf_Debug *  dwo_dbg,
+    Dwarf_Off *    dwo_cu_die_offset,
+    Dwarf_Error *  error);\fP
+.DE
+These find a skeleton unit by its dwo_id
+(the unit header field in DWARF5,
+\f(CWDW_AT_GNU_dwo_id\fP
+in DWARF4), by its
+\f(CWDW_AT_dwo_name\fP
+and
+\f(CWDW_AT_comp_dir\fP
+(a null
+\f(CWcomp_dir\fP
+matches any), or by the offset of its CU DIE in
+the executable, and set
+\f(CW*dwo_dbg\fP
+to its .dwo, opening it if it is not open.
+If
+\f(CWdwo_cu_die_offset\fP
+is non-null it is set to the offset of the split
+compilation unit DIE in that .dwo, ready for
+\f(CWdwarf_offdie_b()\fP.
+Each is a binary search.
+.P
+They return
+\f(CWDW_DLV_NO_ENTRY\fP
+if there is no such skeleton unit or no file is
+found for it (a missing file is looked for only once).
+An error
+\f(CWDW_DLE_DWO_OPEN_FAILED\fP
+means the file found could not be read,
+\f(CWDW_DLE_DWO_ID_MISMATCH\fP
+that its dwo_id is not that of the skeleton unit
+(usually a .dwo rebuilt after the executable was linked).
+.P
+The returned
+\f(CWDwarf_Debug\fP
+belongs to the session.
+Do not call
+\f(CWdwarf_finish()\fP
+on it.
+Each
+\f(CWDW_DLV_OK\fP
+return holds the .dwo open until a matching call of
+\f(CWdwarf_dwo_session_release()\fP.
+A held .dwo is never closed to make room, so while
+callers hold more .dwo files than the limit the
+limit is exceeded.
+Do not use the
+\f(CWDwarf_Debug\fP,
+or anything obtained from it, once released.
+
+.H 3 "dwarf_dwo_session_release()"
+.DS
+\f(CWint dwarf_dwo_session_release(Dwarf_Dwo_Session session,
+    Dwarf_Debug    dwo_dbg,
+    Dwarf_Error *  error);\fP
+.DE
+Ends one hold on
+\f(CWdwo_dbg\fP,
+which must have been returned by a lookup in
+\f(CWsession\fP.
+Once no hold is left it may be closed by a later
+lookup, or right away if the session is over its
+limit.
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if
+\f(CWdwo_dbg\fP
+is not held in the session.
+
+.H 3 "dwarf_dwo_session_stats()"
+.DS
+\f(CWint dwarf_dwo_session_stats(Dwarf_Dwo_Session session,
+    Dwarf_Unsigned * open_now,
+    Dwarf_Unsigned * opens,
+    Dwarf_Unsigned * evictions,
+    Dwarf_Error *    error);\fP
+.DE
+Reports how many .dwo files are open now, how many
+times one was opened and how many times one was
+closed to stay within the limit.
+Any of the pointer arguments may be null.
+
 .H 2 "Gdb Index operations"
 These functions get access to the fast lookup tables
 defined by gdb and gcc and stored in the
@@ -14609,6 +16498,98 @@ after adding the path
 to the global list recorded in the
 \f(CWDwarf_Debug\fP.
 
+.H 3 "dwarf_gnu_debuglink_resolve()"
+.DS
+\f(CWint dwarf_gnu_debuglink_resolve(Dwarf_Debug dbg,
+    char      **resolved_path_out,
+    Dwarf_Error* error);\fP
+.DE
+On success it returns
+\f(CWDW_DLV_OK\fP
+and sets
+\f(CW*resolved_path_out\fP
+to the path of an existing separate debug file.
+The caller must free() the string.
+.P
+The build-id (from \f(CW.note.gnu.build-id\fP)
+is looked up first.
+The first time a global path
+(see \f(CWdwarf_add_debuglink_global_path()\fP)
+is used its
+\f(CW.build-id/xx/\fP
+directories are read and every
+\f(CWxx/yyyy.debug\fP
+file found is recorded.
+The modification times of those directories
+are recorded too.
+A later lookup does a \f(CWstat()\fP of
+\f(CW.build-id\fP and of the one
+\f(CWxx\fP directory the build-id
+would be in.
+If \f(CW.build-id\fP changed all its
+\f(CWxx\fP directories are checked,
+and any changed directory is read again.
+Debug files installed or removed while
+the process runs are therefore seen.
+If that fails and there is a
+\f(CW.gnu_debuglink\fP
+section the candidate paths 
+\f(CWdwarf_gnu_debuglink()\fP
+would return are opened in order and
+the file found is
+remembered for that debuglink,
+to be returned while it still exists.
+.P
+\f(CWdwarf_init_path()\fP
+uses this for an ELF object
+with no \f(CW.debug_info\fP
+(a stripped executable, say),
+returning a Dwarf_Debug for
+the debug file found instead.
+.P
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if no debug file is found.
+.P
+The cache is shared by every
+\f(CWDwarf_Debug\fP
+in the process and is not freed by
+\f(CWdwarf_finish()\fP.
+There is no locking: callers using
+threads must serialize calls.
+.H 3 "dwarf_debuglink_cache_save()"
+.DS
+\f(CWint dwarf_debuglink_cache_save(const char *cache_path,
+    int *errcode);
+int dwarf_debuglink_cache_load(const char *cache_path,
+    int *errcode);
+void dwarf_debuglink_cache_clear(void);\fP
+.DE
+\f(CWdwarf_debuglink_cache_save()\fP
+writes the indexed global paths, with the
+modification times of their
+\f(CW.build-id\fP directories,
+and every resolved file to a text file.
+\f(CWdwarf_debuglink_cache_load()\fP
+adds such a file to the cache.
+A global path named in it is not read again
+unless its \f(CW.build-id\fP directory
+has changed since.
+Each \f(CWxx\fP directory is read again
+on first use.
+It returns
+\f(CWDW_DLV_NO_ENTRY\fP
+if the file does not exist or is not
+a cache file.
+On error these return
+\f(CWDW_DLV_ERROR\fP
+and set
+\f(CW*errcode\fP.
+.P
+\f(CWdwarf_debuglink_cache_clear()\fP
+frees the cache so that global paths are
+read again on next use.
+
 
 
 .H 2 "DWARF5 .debug_sup section access"
@@ -260,6 +260,18 @@ the new function dwarf_add_debug_sup() is added.
 dwarfgen can call this function, though dwarfgen
 presently only fills out a bogus .debug_sup
 section to enable simple testing.
+.LI "October 19, 2026"
+dwarf_force_debug_names() now results in a complete
+DWARF5 .debug_names name index rather than an
+empty section.
+The new function dwarf_pro_set_type_dedup()
+removes repeated copies of type subtrees
+from .debug_info.
+The new function dwarf_pro_set_job_runner()
+lets .debug_line be generated concurrently with
+.debug_info.
+The new function dwarf_pro_set_string_tail_merge()
+shrinks .debug_str by sharing string tails.
 .LE
 
 .H 1 "Type Definitions"
@@ -918,6 +930,155 @@ appears exactly once.
 On success it returns \f(CWDW_DLV_OK\fP.
 On error it returns \f(CWDW_DLV_ERROR\fP.
 
+.H 3 "dwarf_pro_set_type_dedup()"
+
+.DS
+\f(CWint dwarf_pro_set_type_dedup(
+    Dwarf_P_Debug dbg,
+    int           enable,
+    Dwarf_Error  *error) \fP
+.DE
+.P
+If \f(CWenable\fP is non-zero
+\f(CWdwarf_transform_to_disk_form_a()\fP
+looks for type subtrees
+(base, structure, class, union, enumeration,
+typedef, pointer, const, array and the other
+type tags) that repeat, attribute for attribute
+and child for child, an earlier subtree with the
+same parent DIE.
+Each repeat is left out of
+\f(CW.debug_info\fP
+and every reference to a DIE in it
+(attributes, pubnames-style entries and
+the DIE given with an fde)
+is changed to refer to the matching DIE
+of the copy kept.
+Attribute order and
+\f(CWDW_AT_sibling\fP
+do not matter in the comparison.
+Types referring to each other, such as a
+structure with a member pointing to the structure,
+are compared together so such groups are merged too.
+.P
+A subtree containing a DIE given a marker
+with
+\f(CWdwarf_add_die_marker_a()\fP
+is never left out.
+DIEs left out remain valid
+\f(CWDwarf_P_Die\fP
+pointers until
+\f(CWdwarf_producer_finish_a()\fP
+but have no section offset.
+.P
+Only one compilation unit is produced so the
+type units and
+\f(CWDW_FORM_ref_sig8\fP
+references a multi-unit producer would use
+are not needed.
+The default is not to look for repeats.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+On error it returns \f(CWDW_DLV_ERROR\fP.
+This function is new in October 2026.
+
+.H 3 "dwarf_pro_set_string_tail_merge()"
+
+.DS
+\f(CWint dwarf_pro_set_string_tail_merge(
+    Dwarf_P_Debug dbg,
+    int           enable,
+    Dwarf_Error  *error) \fP
+.DE
+.P
+If \f(CWenable\fP is non-zero
+\f(CWdwarf_transform_to_disk_form_a()\fP
+drops each string of
+\f(CW.debug_str\fP
+(and of
+\f(CW.debug_line_str\fP)
+that is the tail of a longer string there,
+such as
+\f(CW"count"\fP
+in
+\f(CW"max_count"\fP,
+and makes the
+\f(CWDW_FORM_strp\fP
+attributes using it
+refer into the longer string,
+as linkers do for mergeable string sections.
+Strings added while the sections are generated
+(the line table header and
+\f(CW.debug_names\fP)
+come after the merge and are only shared when
+identical to a string already present.
+.P
+Identical strings are always stored once
+whether or not this is enabled.
+The default is not to merge tails.
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+On error it returns \f(CWDW_DLV_ERROR\fP.
+This function is new in October 2026.
+
+.H 3 "dwarf_pro_set_job_runner()"
+
+.DS
+\f(CWtypedef void (*Dwarf_P_Job_Runner)(
+    void *   user_data,
+    unsigned count,
+    void   (*job)(void *job_arg,unsigned index),
+    void *   job_arg);
+
+int dwarf_pro_set_job_runner(
+    Dwarf_P_Debug      dbg,
+    Dwarf_P_Job_Runner runner,
+    void              *user_data,
+    Dwarf_Error       *error) \fP
+.DE
+.P
+Libdwarf creates no threads itself.
+With a non-null \f(CWrunner\fP
+\f(CWdwarf_transform_to_disk_form_a()\fP
+hands independent pieces of section generation
+to the runner, which must call
+\f(CWjob(job_arg,i)\fP
+once for each \f(CWi\fP from 0 to
+\f(CWcount\fP-1,
+on whatever threads it likes,
+and return only once all those calls have returned.
+\f(CWuser_data\fP is passed to the runner unchanged.
+.P
+At present
+\f(CW.debug_line\fP
+is generated concurrently with
+\f(CW.debug_frame\fP,
+\f(CW.debug_macinfo\fP,
+\f(CW.debug_info\fP
+and
+\f(CW.debug_names\fP,
+which must be generated in that order.
+The remaining sections depend on those
+and are generated afterwards.
+The buffers returned by
+\f(CWdwarf_get_section_bytes_a()\fP
+and the relocations are identical to
+those produced without a runner.
+If the section numbers returned by the
+section callback would not keep the
+buffers identical the runner is not used.
+.P
+An error handler passed to
+\f(CWdwarf_producer_init()\fP
+may be called from a job.
+Pass a null \f(CWrunner\fP
+to generate everything on the calling thread
+(the default).
+.P
+On success it returns \f(CWDW_DLV_OK\fP.
+On error it returns \f(CWDW_DLV_ERROR\fP.
+This function is new in October 2026.
+
 .H 3 "dwarf_transform_to_disk_form_a()"
 .DS
 \f(CWint dwarf_transform_to_disk_form_a(
@@ -4216,6 +4377,47 @@ of an error, and
 \f(CW*error\fP is set as usual in libdwarf.
 
 
+.H 2 "DWARF5 .debug_names section creation"
+.H 3 "dwarf_force_debug_names()"
+.DS
+\f(CWint dwarf_force_debug_names(
+    Dwarf_P_Debug dbg,
+    Dwarf_Error *error)\fP
+.DE
+When producing DWARF5 this requests a
+\f(CW.debug_names\fP
+section.
+The index is built by
+\f(CWdwarf_transform_to_disk_form()\fP
+from the DIE tree, once DIE offsets are known,
+so nothing need be added name by name.
+It holds the named types, enumerators,
+namespaces and the functions and variables
+not inside a function body
+(the DIEs the DWARF5 standard section 6.1.1.1 lists).
+Declarations are left out.
+A function or variable is also indexed by
+its DW_AT_linkage_name
+and one with no name of its own
+(an out of line definition with
+DW_AT_specification
+or DW_AT_abstract_origin)
+by the names of the DIE referred to.
+.P
+The name strings are placed in
+\f(CW.debug_str\fP
+and the index uses the DWARF5 hash
+so consumers can look names up
+without reading
+\f(CW.debug_info\fP.
+The CU offset and the string offsets
+get relocations like other section offsets.
+.sp
+For DWARF versions before 5 the call
+has no effect.
+.sp
+\f(CWDW_DLV_NO ENTRY\fP is never returned.
+
 .H 2 "Fast Access (pubnames) Operations"
 These functions operate on the .debug_pubnames section.
 .sp
@@ -35,6 +35,7 @@
 #include "libdwarf.h"
 #include "pro_opaque.h"
 #include "pro_alloc.h"
+#include "pro_strpool.h"
 #ifdef HAVE_STDLIB_H
 #include <stdlib.h>
 #endif /* HAVE_STDLIB_H */
@@ -51,7 +52,6 @@
 #ifdef HAVE_INTTYPES_H
 #include <inttypes.h>
 #endif /* HAVE_INTTYPES_H */
-#include "dwarf_tsearch.h"
 
 /*  When each block is allocated, there is a two-word structure
     allocated at the beginning so the block can go on a list.
@@ -116,6 +116,24 @@ _dwarf_p_get_alloc(Dwarf_P_Debug dbg, Dwarf_Unsigned size)
     return sp;
 }
 
+/*  other was allocated with a NULL dbg, so it heads its
+    own list.  Splice that whole list, header included,
+    into the list of dbg.  other stays valid memory
+    until dbg is finished. */
+void
+_dwarf_p_alloc_adopt(Dwarf_P_Debug dbg, Dwarf_P_Debug other)
+{
+    memory_list_t *dbglp = BLOCK_TO_LIST(dbg);
+    memory_list_t *first = BLOCK_TO_LIST(other);
+    memory_list_t *last = first->prev;
+    memory_list_t *nextblock = dbglp->next;
+
+    dbglp->next = first;
+    first->prev = dbglp;
+    last->next = nextblock;
+    nextblock->prev = last;
+}
+
 /*
   This routine is only here in case a caller of an older version of the
   library is calling this for some reason.
@@ -176,13 +194,6 @@ _dwarf_p_dealloc(UNUSEDARG Dwarf_P_Debug dbg,
 }
 
 
-static void
-_dwarf_str_hashtab_freenode(void * nodep)
-{
-    free(nodep);
-}
-
-
 /*
   This routine deallocates all the nodes on the dbg list,
   and then deallocates the dbg structure itself.
@@ -199,6 +210,12 @@ _dwarf_p_dealloc_all(Dwarf_P_Debug dbg)
         return;
     }
 
+    /*  The string section structs are on the list,
+        their data is not. */
+    _dwarf_pro_strpool_free(&dbg->de_debug_str_pool,
+        dbg->de_debug_str);
+    _dwarf_pro_strpool_free(&dbg->de_debug_line_str_pool,
+        dbg->de_debug_line_str);
     base_dbglp = BLOCK_TO_LIST(dbg);
     dbglp = base_dbglp->next;
 
@@ -208,9 +225,5 @@ _dwarf_p_dealloc_all(Dwarf_P_Debug dbg)
         _dwarf_p_dealloc(dbg, LIST_TO_BLOCK(dbglp));
         dbglp = next;
     }
-    dwarf_tdestroy(dbg->de_debug_str_hashtab,
-        _dwarf_str_hashtab_freenode);
-    dwarf_tdestroy(dbg->de_debug_line_str_hashtab,
-        _dwarf_str_hashtab_freenode);
     free((void *)base_dbglp);
 }
@@ -40,6 +40,10 @@ void _dwarf_p_dealloc(Dwarf_P_Debug,Dwarf_Small * ptr);
 
 void _dwarf_p_dealloc_all(Dwarf_P_Debug dbg);
 
+/*  Moves every block allocated on other, and other
+    itself, to dbg so they are freed with dbg. */
+void _dwarf_p_alloc_adopt(Dwarf_P_Debug dbg, Dwarf_P_Debug other);
+
 #ifdef __cplusplus
 }
 #endif /* __cplusplus */
@@ -0,0 +1,794 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  Structural deduplication of type DIEs.
+
+    Compilers and JITs using the producer often repeat
+    an identical type subtree (a struct with its members,
+    a pointer to it, a typedef of it) several times
+    under the same parent.  This pass, run once before
+    .debug_info is generated, keeps the first copy of
+    each such subtree and removes the others, pointing
+    every reference to a removed DIE (attribute
+    references, pubnames-style entries, fde DIEs) at the
+    corresponding DIE of the copy that is kept.
+
+    Subtrees are compared structurally: tag, children
+    in order, and attributes in any order (DW_AT_sibling
+    is ignored).  A reference to a DIE inside the subtree
+    compares by its position in the subtree, a reference
+    outside compares by target, except that a reference
+    to a sibling type subtree may instead point at an
+    identical copy of it, so type cycles (a struct with
+    a member pointing to the struct) merge whole.  Subtrees containing a
+    DIE with a marker (dwarf_add_die_marker()) are never
+    removed as the caller expects to find those DIEs.
+
+    Merging one type can make its users identical
+    (two copies of a struct each pointing at its own
+    copy of a typedef) so passes repeat until one
+    removes nothing. */
+
+#include "config.h"
+#include "libdwarfdefs.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* For uintptr_t */
+#endif /* HAVE_STDINT_H */
+#include "pro_incl.h"
+#include <stddef.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "pro_opaque.h"
+#include "pro_error.h"
+#include "pro_alloc.h"
+#include "pro_frame.h"
+#include "pro_dedup.h"
+#include "dwarf_tsearch.h"
+
+/*  One kept subtree.  Distinct subtrees with the same
+    parent and hash are chained on dd_next. */
+struct dedup_entry_s {
+    Dwarf_P_Die    dd_parent;
+    Dwarf_Unsigned dd_hash;
+    Dwarf_P_Die    dd_die;
+    struct dedup_entry_s *dd_next;
+};
+
+/*  Per-pass state. While a pass runs di_offset holds
+    the preorder index (from 1) of each DIE; the
+    real offsets are assigned later by
+    _dwarf_pro_generate_debuginfo(). */
+struct dedup_state_s {
+    Dwarf_Unsigned  ds_count;
+    /* Indexed by preorder index. */
+    Dwarf_P_Die    *ds_nodes;
+    /* Preorder index of the last DIE of the subtree. */
+    Dwarf_Unsigned *ds_end;
+    /*  For a DIE in a removed subtree, the DIE
+        to use instead. Zero otherwise. */
+    Dwarf_P_Die    *ds_repl;
+    /* Roots of the subtrees to unlink. */
+    Dwarf_P_Die    *ds_removed;
+    Dwarf_Unsigned  ds_removed_count;
+    /*  Sibling subtrees assumed identical while comparing
+        two candidates, the first pair being the candidates.
+        ds_keep[i] is kept and ds_dup[i] removed if the
+        comparison succeeds. */
+    Dwarf_P_Die    *ds_keep;
+    Dwarf_P_Die    *ds_dup;
+    Dwarf_Unsigned  ds_pair_count;
+};
+
+int
+dwarf_pro_set_type_dedup(Dwarf_P_Debug dbg,
+    int enable,
+    Dwarf_Error * error)
+{
+    if (dbg == NULL) {
+        _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_type_dedup = enable?1:0;
+    return DW_DLV_OK;
+}
+
+static int
+is_dedup_type_tag(Dwarf_Tag tag)
+{
+    switch (tag) {
+    case DW_TAG_array_type:
+    case DW_TAG_atomic_type:
+    case DW_TAG_base_type:
+    case DW_TAG_class_type:
+    case DW_TAG_const_type:
+    case DW_TAG_enumeration_type:
+    case DW_TAG_pointer_type:
+    case DW_TAG_ptr_to_member_type:
+    case DW_TAG_reference_type:
+    case DW_TAG_restrict_type:
+    case DW_TAG_rvalue_reference_type:
+    case DW_TAG_set_type:
+    case DW_TAG_string_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_subrange_type:
+    case DW_TAG_subroutine_type:
+    case DW_TAG_typedef:
+    case DW_TAG_union_type:
+    case DW_TAG_unspecified_type:
+    case DW_TAG_volatile_type:
+        return true;
+    default:
+        break;
+    }
+    return false;
+}
+
+/* Preorder successor of die in the whole tree. */
+static Dwarf_P_Die
+next_die(Dwarf_P_Die die)
+{
+    if (die->di_child) {
+        return die->di_child;
+    }
+    for ( ; die; die = die->di_parent) {
+        if (die->di_right) {
+            return die->di_right;
+        }
+    }
+    return NULL;
+}
+
+static Dwarf_Unsigned
+hash_mix(Dwarf_Unsigned h, Dwarf_Unsigned v)
+{
+    /* djb2 style, applied a byte at a time. */
+    unsigned i = 0;
+
+    for ( ; i < sizeof(v); ++i) {
+        h = (h << 5) + h + (v & 0xff);
+        v >>= 8;
+    }
+    return h;
+}
+
+static Dwarf_Unsigned
+hash_bytes(Dwarf_Unsigned h, const char *p, Dwarf_Unsigned len)
+{
+    Dwarf_Unsigned i = 0;
+
+    for ( ; i < len; ++i) {
+        h = (h << 5) + h + (unsigned char)p[i];
+    }
+    return h;
+}
+
+/*  The preorder index of die if it is in the tree
+    (as the pass numbered it), else zero. */
+static Dwarf_Unsigned
+die_index(struct dedup_state_s *ds, Dwarf_P_Die die)
+{
+    Dwarf_Unsigned ix = die->di_offset;
+
+    if (ix == 0 || ix > ds->ds_count || ds->ds_nodes[ix] != die) {
+        return 0;
+    }
+    return ix;
+}
+
+/*  True if a reference from the subtree at rootix to
+    target may match a reference to a copy of target:
+    target is a sibling type subtree. */
+static int
+pairable(struct dedup_state_s *ds, Dwarf_P_Die target,
+    Dwarf_Unsigned rootix)
+{
+    return die_index(ds,target) &&
+        target->di_parent == ds->ds_nodes[rootix]->di_parent &&
+        is_dedup_type_tag(target->di_tag);
+}
+
+/*  The DIE a reference to die will end up at,
+    following replacements made earlier in this pass. */
+static Dwarf_P_Die
+final_die(struct dedup_state_s *ds, Dwarf_P_Die die)
+{
+    Dwarf_Unsigned ix = die_index(ds,die);
+
+    if (ix && ds->ds_repl[ix]) {
+        return ds->ds_repl[ix];
+    }
+    return die;
+}
+
+static Dwarf_Unsigned
+hash_attr(struct dedup_state_s *ds, Dwarf_P_Attribute a,
+    Dwarf_Unsigned rootix)
+{
+    Dwarf_Unsigned h = 5381;
+
+    h = hash_mix(h,a->ar_attribute);
+    h = hash_mix(h,a->ar_attribute_form);
+    if (a->ar_ref_die) {
+        Dwarf_P_Die target = final_die(ds,a->ar_ref_die);
+        Dwarf_Unsigned tix = die_index(ds,target);
+
+        if (tix >= rootix && tix <= ds->ds_end[rootix]) {
+            /* Inside the subtree: by relative position. */
+            h = hash_mix(h,1);
+            h = hash_mix(h,tix - rootix);
+        } else if (pairable(ds,target,rootix)) {
+            /*  Copies of target must hash alike,
+                so only the tag is used. */
+            h = hash_mix(h,2);
+            h = hash_mix(h,target->di_tag);
+        } else {
+            h = hash_mix(h,3);
+            h = hash_mix(h,tix);
+        }
+        return h;
+    }
+    if (a->ar_attribute_form == DW_FORM_implicit_const) {
+        h = hash_mix(h,(Dwarf_Unsigned)a->ar_implicit_const);
+    }
+    h = hash_mix(h,a->ar_rel_type);
+    h = hash_mix(h,a->ar_rel_symidx);
+    if (a->ar_data) {
+        h = hash_bytes(h,a->ar_data,a->ar_nbytes);
+    }
+    return h;
+}
+
+static Dwarf_Unsigned
+hash_subtree(struct dedup_state_s *ds, Dwarf_P_Die die,
+    Dwarf_Unsigned rootix)
+{
+    Dwarf_Unsigned h = 5381;
+    Dwarf_Unsigned attrsum = 0;
+    Dwarf_P_Attribute a = 0;
+    Dwarf_P_Die child = 0;
+
+    h = hash_mix(h,die->di_tag);
+    /*  Attribute order is not significant, so sum
+        the attribute hashes. */
+    for (a = die->di_attrs; a; a = a->ar_next) {
+        if (a->ar_attribute == DW_AT_sibling) {
+            continue;
+        }
+        attrsum += hash_attr(ds,a,rootix);
+    }
+    h = hash_mix(h,attrsum);
+    for (child = die->di_child; child; child = child->di_right) {
+        h = hash_mix(h,hash_subtree(ds,child,rootix));
+    }
+    /* Closes the child list so nesting is part of the hash. */
+    h = hash_mix(h,0);
+    return h;
+}
+
+static Dwarf_P_Attribute
+find_attr(Dwarf_P_Die die, Dwarf_Half attrnum)
+{
+    Dwarf_P_Attribute a = die->di_attrs;
+
+    for ( ; a; a = a->ar_next) {
+        if (a->ar_attribute == attrnum) {
+            return a;
+        }
+    }
+    return NULL;
+}
+
+static int same_subtree(struct dedup_state_s *ds,
+    Dwarf_P_Die a, Dwarf_Unsigned aroot,
+    Dwarf_P_Die b, Dwarf_Unsigned broot);
+
+/*  Compares sibling subtrees keep and dup, assuming
+    they are identical while doing so (which is what
+    lets a cycle of references compare equal).
+    A DIE may be paired with only one other, and the
+    kept one must come first so a later pass cannot
+    undo the merge. */
+static int
+same_pair(struct dedup_state_s *ds, Dwarf_P_Die keep,
+    Dwarf_P_Die dup)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned kix = die_index(ds,keep);
+    Dwarf_Unsigned dix = die_index(ds,dup);
+
+    for (i = 0; i < ds->ds_pair_count; ++i) {
+        if (ds->ds_keep[i] == keep && ds->ds_dup[i] == dup) {
+            return true;
+        }
+        if (ds->ds_keep[i] == keep || ds->ds_dup[i] == dup ||
+            ds->ds_keep[i] == dup || ds->ds_dup[i] == keep) {
+            return false;
+        }
+    }
+    if (kix >= dix || ds->ds_repl[dix] ||
+        ds->ds_pair_count >= ds->ds_count) {
+        return false;
+    }
+    ds->ds_keep[ds->ds_pair_count] = keep;
+    ds->ds_dup[ds->ds_pair_count] = dup;
+    ds->ds_pair_count++;
+    return same_subtree(ds,keep,kix,dup,dix);
+}
+
+static int
+same_attr(struct dedup_state_s *ds,
+    Dwarf_P_Attribute a, Dwarf_Unsigned aroot,
+    Dwarf_P_Attribute b, Dwarf_Unsigned broot)
+{
+    if (a->ar_attribute_form != b->ar_attribute_form) {
+        return false;
+    }
+    if (a->ar_ref_die || b->ar_ref_die) {
+        Dwarf_P_Die at = 0;
+        Dwarf_P_Die bt = 0;
+        Dwarf_Unsigned aix = 0;
+        Dwarf_Unsigned bix = 0;
+        int ain = false;
+        int bin = false;
+
+        if (!a->ar_ref_die || !b->ar_ref_die) {
+            return false;
+        }
+        at = final_die(ds,a->ar_ref_die);
+        bt = final_die(ds,b->ar_ref_die);
+        aix = die_index(ds,at);
+        bix = die_index(ds,bt);
+        ain = aix >= aroot && aix <= ds->ds_end[aroot];
+        bin = bix >= broot && bix <= ds->ds_end[broot];
+        if (ain != bin) {
+            return false;
+        }
+        if (ain) {
+            return (aix - aroot) == (bix - broot);
+        }
+        if (at == bt) {
+            return true;
+        }
+        if (!pairable(ds,at,aroot) || !pairable(ds,bt,broot)) {
+            return false;
+        }
+        return same_pair(ds,at,bt);
+    }
+    if (a->ar_attribute_form == DW_FORM_implicit_const &&
+        a->ar_implicit_const != b->ar_implicit_const) {
+        return false;
+    }
+    if (a->ar_nbytes != b->ar_nbytes ||
+        a->ar_rel_type != b->ar_rel_type ||
+        a->ar_rel_symidx != b->ar_rel_symidx ||
+        a->ar_rel_offset != b->ar_rel_offset ||
+        a->ar_reloc_len != b->ar_reloc_len) {
+        return false;
+    }
+    if (a->ar_nbytes && (!a->ar_data || !b->ar_data)) {
+        return a->ar_data == b->ar_data;
+    }
+    if (a->ar_nbytes &&
+        memcmp(a->ar_data,b->ar_data,a->ar_nbytes)) {
+        return false;
+    }
+    return true;
+}
+
+static int
+same_subtree(struct dedup_state_s *ds,
+    Dwarf_P_Die a, Dwarf_Unsigned aroot,
+    Dwarf_P_Die b, Dwarf_Unsigned broot)
+{
+    Dwarf_P_Attribute at = 0;
+    Dwarf_P_Attribute bt = 0;
+    unsigned acount = 0;
+    unsigned bcount = 0;
+    Dwarf_P_Die achild = 0;
+    Dwarf_P_Die bchild = 0;
+
+    if (a->di_tag != b->di_tag) {
+        return false;
+    }
+    /*  Both subtrees have the same shape if the preorder
+        offsets line up, which the recursion checks. */
+    if ((die_index(ds,a) - aroot) != (die_index(ds,b) - broot)) {
+        return false;
+    }
+    for (at = a->di_attrs; at; at = at->ar_next) {
+        if (at->ar_attribute == DW_AT_sibling) {
+            continue;
+        }
+        ++acount;
+        bt = find_attr(b,at->ar_attribute);
+        if (!bt || !same_attr(ds,at,aroot,bt,broot)) {
+            return false;
+        }
+    }
+    for (bt = b->di_attrs; bt; bt = bt->ar_next) {
+        if (bt->ar_attribute != DW_AT_sibling) {
+            ++bcount;
+        }
+    }
+    if (acount != bcount) {
+        return false;
+    }
+    achild = a->di_child;
+    bchild = b->di_child;
+    for ( ; achild && bchild;
+        achild = achild->di_right, bchild = bchild->di_right) {
+        if (!same_subtree(ds,achild,aroot,bchild,broot)) {
+            return false;
+        }
+    }
+    return achild == bchild;
+}
+
+static DW_TSHASHTYPE
+dedup_hashfunc(const void *keyp)
+{
+    const struct dedup_entry_s *e = keyp;
+
+    return (DW_TSHASHTYPE)(e->dd_hash ^ (uintptr_t)e->dd_parent);
+}
+
+static int
+dedup_compare(const void *l, const void *r)
+{
+    const struct dedup_entry_s *le = l;
+    const struct dedup_entry_s *re = r;
+
+    if (le->dd_parent != re->dd_parent) {
+        return (le->dd_parent < re->dd_parent)? -1:1;
+    }
+    if (le->dd_hash != re->dd_hash) {
+        return (le->dd_hash < re->dd_hash)? -1:1;
+    }
+    return 0;
+}
+
+static void
+dedup_entry_free(void *e)
+{
+    struct dedup_entry_s *entry = e;
+
+    while (entry) {
+        struct dedup_entry_s *next = entry->dd_next;
+
+        free(entry);
+        entry = next;
+    }
+}
+
+/*  Records that the subtree at dup (same shape as the
+    one at keep) is to be replaced by keep. */
+static void
+map_subtree(struct dedup_state_s *ds, Dwarf_P_Die dup,
+    Dwarf_P_Die keep)
+{
+    Dwarf_P_Die dchild = dup->di_child;
+    Dwarf_P_Die kchild = keep->di_child;
+
+    ds->ds_repl[dup->di_offset] = keep;
+    for ( ; dchild && kchild;
+        dchild = dchild->di_right, kchild = kchild->di_right) {
+        map_subtree(ds,dchild,kchild);
+    }
+}
+
+static int
+subtree_has_marker(struct dedup_state_s *ds, Dwarf_Unsigned ix)
+{
+    Dwarf_Unsigned end = ds->ds_end[ix];
+
+    for ( ; ix <= end; ++ix) {
+        if (ds->ds_nodes[ix]->di_marker) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int
+pairs_have_marker(struct dedup_state_s *ds)
+{
+    Dwarf_Unsigned i = 0;
+
+    for ( ; i < ds->ds_pair_count; ++i) {
+        if (subtree_has_marker(ds,ds->ds_dup[i]->di_offset)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static int
+removed_die(struct dedup_state_s *ds, Dwarf_P_Die die)
+{
+    Dwarf_Unsigned ix = die_index(ds,die);
+
+    return ix && ds->ds_repl[ix];
+}
+
+/*  Points references at kept DIEs and unlinks
+    the removed subtrees. */
+static void
+apply_replacements(Dwarf_P_Debug dbg, struct dedup_state_s *ds)
+{
+    Dwarf_Unsigned ix = 1;
+    Dwarf_P_Fde fde = 0;
+    int k = 0;
+
+    for ( ; ix <= ds->ds_count; ++ix) {
+        Dwarf_P_Die die = ds->ds_nodes[ix];
+        Dwarf_P_Attribute a = 0;
+        Dwarf_P_Attribute prev = 0;
+        Dwarf_P_Attribute next = 0;
+
+        if (ds->ds_repl[ix]) {
+            continue;
+        }
+        for (a = die->di_attrs; a; a = next) {
+            next = a->ar_next;
+            if (!a->ar_ref_die || !removed_die(ds,a->ar_ref_die)) {
+                prev = a;
+                continue;
+            }
+            if (a->ar_attribute == DW_AT_sibling) {
+                /*  The sibling is going away, so the
+                    next remaining one follows. */
+                Dwarf_P_Die sib = a->ar_ref_die;
+
+                while (sib && removed_die(ds,sib)) {
+                    sib = sib->di_right;
+                }
+                if (sib) {
+                    a->ar_ref_die = sib;
+                    prev = a;
+                    continue;
+                }
+                /*  No sibling left. Drop the attribute,
+                    the memory goes with the dbg. */
+                if (prev) {
+                    prev->ar_next = next;
+                } else {
+                    die->di_attrs = next;
+                }
+                if (die->di_last_attr == a) {
+                    die->di_last_attr = prev;
+                }
+                die->di_n_attr--;
+                continue;
+            }
+            a->ar_ref_die = final_die(ds,a->ar_ref_die);
+            prev = a;
+        }
+    }
+    for (k = 0; k < dwarf_snk_entrycount; ++k) {
+        Dwarf_P_Simple_nameentry sne =
+            dbg->de_simple_name_headers[k].sn_head;
+
+        for ( ; sne; sne = sne->sne_next) {
+            if (sne->sne_die) {
+                sne->sne_die = final_die(ds,sne->sne_die);
+            }
+        }
+    }
+    for (fde = dbg->de_frame_fdes; fde; fde = fde->fde_next) {
+        if (fde->fde_die) {
+            fde->fde_die = final_die(ds,fde->fde_die);
+        }
+    }
+    for (ix = 0; ix < ds->ds_removed_count; ++ix) {
+        Dwarf_P_Die die = ds->ds_removed[ix];
+        Dwarf_P_Die parent = die->di_parent;
+
+        if (die->di_left) {
+            die->di_left->di_right = die->di_right;
+        } else {
+            parent->di_child = die->di_right;
+        }
+        if (die->di_right) {
+            die->di_right->di_left = die->di_left;
+        } else {
+            parent->di_last_child = die->di_left;
+        }
+        die->di_parent = NULL;
+        die->di_left = NULL;
+        die->di_right = NULL;
+    }
+}
+
+static void
+dedup_state_free(struct dedup_state_s *ds)
+{
+    free(ds->ds_nodes);
+    free(ds->ds_end);
+    free(ds->ds_repl);
+    free(ds->ds_removed);
+    free(ds->ds_keep);
+    free(ds->ds_dup);
+}
+
+/*  One pass over the tree. Sets *removed to the count
+    of DIEs removed. */
+static int
+dedup_pass(Dwarf_P_Debug dbg, Dwarf_Unsigned *removed,
+    Dwarf_Error *error)
+{
+    struct dedup_state_s ds;
+    void *tree = 0;
+    Dwarf_P_Die die = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned ix = 0;
+    Dwarf_Unsigned removed_dies = 0;
+    int res = DW_DLV_OK;
+
+    memset(&ds,0,sizeof(ds));
+    for (die = dbg->de_dies; die; die = next_die(die)) {
+        ++count;
+    }
+    ds.ds_count = count;
+    ds.ds_nodes = (Dwarf_P_Die *)calloc(count+1,sizeof(Dwarf_P_Die));
+    ds.ds_end = (Dwarf_Unsigned *)calloc(count+1,
+        sizeof(Dwarf_Unsigned));
+    ds.ds_repl = (Dwarf_P_Die *)calloc(count+1,sizeof(Dwarf_P_Die));
+    ds.ds_removed = (Dwarf_P_Die *)calloc(count+1,
+        sizeof(Dwarf_P_Die));
+    ds.ds_keep = (Dwarf_P_Die *)calloc(count+1,sizeof(Dwarf_P_Die));
+    ds.ds_dup = (Dwarf_P_Die *)calloc(count+1,sizeof(Dwarf_P_Die));
+    if (!ds.ds_nodes || !ds.ds_end || !ds.ds_repl ||
+        !ds.ds_removed || !ds.ds_keep || !ds.ds_dup) {
+        dedup_state_free(&ds);
+        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
+    ix = 0;
+    for (die = dbg->de_dies; die; die = next_die(die)) {
+        ++ix;
+        die->di_offset = ix;
+        ds.ds_nodes[ix] = die;
+    }
+    for (ix = 1; ix <= count; ++ix) {
+        Dwarf_P_Die last = ds.ds_nodes[ix];
+
+        while (last->di_last_child) {
+            last = last->di_last_child;
+        }
+        ds.ds_end[ix] = last->di_offset;
+    }
+    /*  If this fails dwarf_tsearch() below fails too
+        and reports it. */
+    dwarf_initialize_search_hash(&tree,dedup_hashfunc,count);
+
+    for (ix = 1; ix <= count; ++ix) {
+        struct dedup_entry_s *entry = 0;
+        struct dedup_entry_s *found = 0;
+        struct dedup_entry_s *e = 0;
+        void *retval = 0;
+
+        die = ds.ds_nodes[ix];
+        if (ds.ds_repl[ix] || !die->di_parent ||
+            !is_dedup_type_tag(die->di_tag)) {
+            continue;
+        }
+        entry = (struct dedup_entry_s *)
+            calloc(1,sizeof(struct dedup_entry_s));
+        if (!entry) {
+            _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            res = DW_DLV_ERROR;
+            break;
+        }
+        entry->dd_parent = die->di_parent;
+        entry->dd_hash = hash_subtree(&ds,die,ix);
+        entry->dd_die = die;
+        retval = dwarf_tsearch(entry,&tree,dedup_compare);
+        if (!retval) {
+            free(entry);
+            _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            res = DW_DLV_ERROR;
+            break;
+        }
+        found = *(struct dedup_entry_s **)retval;
+        if (found == entry) {
+            continue;
+        }
+        for (e = found; e; e = e->dd_next) {
+            Dwarf_P_Die keep = e->dd_die;
+
+            if (ds.ds_repl[keep->di_offset]) {
+                /* Removed as part of an earlier match. */
+                continue;
+            }
+            ds.ds_pair_count = 0;
+            if (same_pair(&ds,keep,die) && !pairs_have_marker(&ds)) {
+                break;
+            }
+        }
+        if (e) {
+            Dwarf_Unsigned i = 0;
+
+            free(entry);
+            for (i = 0; i < ds.ds_pair_count; ++i) {
+                Dwarf_P_Die dup = ds.ds_dup[i];
+                Dwarf_Unsigned dix = dup->di_offset;
+
+                map_subtree(&ds,dup,ds.ds_keep[i]);
+                ds.ds_removed[ds.ds_removed_count++] = dup;
+                removed_dies += ds.ds_end[dix] - dix + 1;
+            }
+            continue;
+        }
+        /* Same hash, different tree: keep both. */
+        entry->dd_next = found->dd_next;
+        found->dd_next = entry;
+    }
+    dwarf_tdestroy(tree,dedup_entry_free);
+    if (res == DW_DLV_OK && ds.ds_removed_count) {
+        apply_replacements(dbg,&ds);
+    }
+    /* The real offsets are set when .debug_info is generated. */
+    for (ix = 1; ix <= count; ++ix) {
+        ds.ds_nodes[ix]->di_offset = 0;
+    }
+    dedup_state_free(&ds);
+    *removed = removed_dies;
+    return res;
+}
+
+int
+_dwarf_pro_dedup_types(Dwarf_P_Debug dbg,
+    Dwarf_Unsigned *dies_removed,
+    Dwarf_Error *error)
+{
+    Dwarf_Unsigned total = 0;
+
+    if (!dbg->de_dies) {
+        *dies_removed = 0;
+        return DW_DLV_OK;
+    }
+    for (;;) {
+        Dwarf_Unsigned removed = 0;
+        int res = dedup_pass(dbg,&removed,error);
+
+        if (res != DW_DLV_OK) {
+            return res;
+        }
+        if (!removed) {
+            break;
+        }
+        total += removed;
+    }
+    *dies_removed = total;
+    return DW_DLV_OK;
+}
@@ -53,7 +53,7 @@
 #include "pro_alloc.h"
 #include "pro_die.h"
 #include "pro_section.h"
-#include "dwarf_tsearch.h"
+#include "pro_strpool.h"
 
 #ifndef R_MIPS_NONE
 #define R_MIPS_NONE 0
@@ -361,154 +361,7 @@ _dwarf_pro_add_AT_stmt_list(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
-static int
-_dwarf_debug_str_compare_func(const void *l,const void *r)
-{
-    const struct Dwarf_P_debug_str_entry_s*el = l;
-    const struct Dwarf_P_debug_str_entry_s*er = r;
-    char *lname =  0;
-    char *rname =  0;
-    int ir = 0;
-
-    if (el->dse_has_table_offset) {
-        /*  When set the name is in the debug_str table. */
-        /*  ASSERT: dse_dbg->de_debug_str->ds_data
-            is non-zero.
-            ASSERT: dse_name NULL. */
-        lname = el->dse_dbg->de_debug_str->ds_data +
-            el->dse_table_offset;
-    } else {
-        /*  ASSERT: dse_name non-null */
-        lname = el->dse_name;
-    }
-    if (er->dse_has_table_offset) {
-        /*  When set the name is in the debug_str table. */
-        /*  ASSERT: dse_dbg->de_debug_str->ds_data
-            is non-zero.
-            ASSERT: dse_name NULL. */
-        rname = er->dse_dbg->de_debug_str->ds_data +
-            er->dse_table_offset;
-    } else {
-        /*  ASSERT: dse_name non-null */
-        rname = er->dse_name;
-    }
-    ir = strcmp(lname,rname);
-    return ir;
-}
-
-static  void
-debug_str_entry_free_func(void *m)
-{
-    free(m);
-}
-
-static int
-make_debug_str_entry(Dwarf_P_Debug dbg,
-    struct Dwarf_P_debug_str_entry_s **mt_out,
-    char *name,
-    unsigned slen,
-    unsigned char has_offset,
-    Dwarf_Unsigned offset_in_table,
-    Dwarf_Error *error)
-{
-    struct Dwarf_P_debug_str_entry_s *mt =
-        (struct  Dwarf_P_debug_str_entry_s *)calloc(
-        sizeof(struct Dwarf_P_debug_str_entry_s),1);
-    if (!mt) {
-        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
-
-    mt->dse_slen = slen;
-    mt->dse_table_offset = 0;
-    mt->dse_dbg = dbg;
-    if (has_offset) {
-        mt->dse_has_table_offset = TRUE;
-        mt->dse_table_offset = offset_in_table;
-        mt->dse_name = 0;
-    } else {
-        /* ASSERT: name != NULL */
-        mt->dse_has_table_offset = FALSE;
-        /* We just set dse_table_offset so it has
-            a known value, though nothing should refer
-            to dse_table_offset because
-            dse_has_table_offset is FALSE.*/
-        mt->dse_table_offset = 0;
-        mt->dse_name = name;
-    }
-    *mt_out = mt;
-    return DW_DLV_OK;
-}
-#define STRTAB_BASE_ALLOC_SIZE 2048
-static int
-insert_debug_str_data_string(Dwarf_P_Debug dbg,
-    char *name,
-    unsigned slen,
-    Dwarf_P_Section_Data sd,
-    Dwarf_Unsigned*adding_at_offset,
-    Dwarf_Error *  error)
-{
-    Dwarf_Unsigned current_offset = 0;
-
-    if (!sd->ds_data) {
-        Dwarf_Unsigned initial_alloc = STRTAB_BASE_ALLOC_SIZE;
-        Dwarf_Unsigned base_insert_offset = 0;
-
-        /*  Inserting our first string.
-            The GNU linker refuses to commonize strings
-            if the section starts with a NUL byte,
-            so start with real string, using a
-            base_insert_offset of 0. */
-        if ( (slen + base_insert_offset) >= STRTAB_BASE_ALLOC_SIZE) {
-            initial_alloc = slen *2+ base_insert_offset;
-        }
-        if (initial_alloc < slen) {
-            _dwarf_p_error(dbg, error, DW_DLE_SIZE_WRAPAROUND);
-            return DW_DLV_ERROR;
-        }
-        sd->ds_data = calloc(1,initial_alloc);
-        if (!sd->ds_data) {
-            _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
-            return DW_DLV_ERROR;
-        }
-        sd->ds_orig_alloc = initial_alloc;
-        *adding_at_offset = base_insert_offset;
-        sd->ds_nbytes = slen + base_insert_offset;
-        strcpy(sd->ds_data+base_insert_offset,name);
-        return DW_DLV_OK;
-    }
-    current_offset = sd->ds_nbytes;
-    if ( (current_offset + slen) >= sd->ds_orig_alloc) {
-        unsigned updated_length = sd->ds_orig_alloc;
-        char *newbuf = 0;
-        if (slen > updated_length) {
-            /*  Very long string passed in. */
-            updated_length = slen *2;
-        } else {
-            updated_length = updated_length *2;
-        }
-        if (updated_length < sd->ds_orig_alloc) {
-            _dwarf_p_error(dbg, error, DW_DLE_SIZE_WRAPAROUND);
-            return DW_DLV_ERROR;
-        }
-        newbuf = calloc(1,updated_length);
-        if (!newbuf) {
-            _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
-            return DW_DLV_ERROR;
-        }
-        memcpy(newbuf,sd->ds_data,sd->ds_nbytes);
-        free(sd->ds_data);
-        sd->ds_data = newbuf;
-        sd->ds_orig_alloc = updated_length;
-        newbuf = 0;
-    }
-    strcpy(sd->ds_data + current_offset,name);
-    sd->ds_nbytes += slen;
-    *adding_at_offset = current_offset;
-    return DW_DLV_OK;
-}
-
-/*  Find the string offset using the hash table,
+/*  Find the string offset using the string pool,
     and if not known, insert the new string. */
 int
 _dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
@@ -518,24 +371,20 @@ _dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
     Dwarf_Unsigned *offset_in_debug_str,
     Dwarf_Error *error)
 {
-    struct Dwarf_P_debug_str_entry_s *mt = 0;
-    struct Dwarf_P_debug_str_entry_s *mt2 = 0;
-    struct Dwarf_P_debug_str_entry_s *retval = 0;
-    struct Dwarf_P_debug_str_entry_s *re = 0;
     int res = 0;
-    Dwarf_Unsigned adding_at_offset = 0;
-    void **hashtab = 0;
+    int found = FALSE;
+    struct Dwarf_P_Str_Pool_s *pool = 0;
     Dwarf_P_Section_Data sd = 0;
     struct Dwarf_P_Str_stats_s * stats =  0;
 
     switch (whash) {
     case _dwarf_hash_debug_str:
-        hashtab =  &dbg->de_debug_str_hashtab;
+        pool =  &dbg->de_debug_str_pool;
         sd =  dbg->de_debug_str;
         stats = &dbg->de_stats.ps_strp;
         break;
     case _dwarf_hash_debug_line_str:
-        hashtab =  &dbg->de_debug_line_str_hashtab;
+        pool =  &dbg->de_debug_line_str_pool;
         sd =  dbg->de_debug_line_str;
         stats = &dbg->de_stats.ps_line_strp;
         break;
@@ -545,68 +394,18 @@ _dwarf_insert_or_find_in_debug_str(Dwarf_P_Debug dbg,
         _dwarf_p_error(dbg, error, DW_DLE_STRING_HASHTAB_IDENTITY_ERROR);
         return DW_DLV_ERROR;
     }
-    res = make_debug_str_entry(dbg,&mt,name,
-        slen,FALSE, 0, error);
+    res = _dwarf_pro_strpool_insert(dbg,pool,sd,name,slen,
+        offset_in_debug_str,&found,error);
     if (res != DW_DLV_OK) {
         return res;
     }
-    /*  We do a find as we do not want the string pointer passed in
-        to be in the hash table, we want a pointer into the
-        debug_str table in the hash table. */
-    retval = dwarf_tfind(mt,(void *const*)hashtab,
-        _dwarf_debug_str_compare_func);
-    if (retval) {
-
+    if (found) {
         stats->ps_strp_reused_count++;
         stats->ps_strp_reused_len += slen;
-
-        re = *(struct Dwarf_P_debug_str_entry_s **)retval;
-        *offset_in_debug_str = re->dse_table_offset;
-        debug_str_entry_free_func(mt);
-        return DW_DLV_OK;
-    }
-
-    /*  We know the string is not in .debug_str data yet.
-        Insert it into the big string table and get that
-        offset. */
-
-    debug_str_entry_free_func(mt);
-    mt = 0;
-    res = insert_debug_str_data_string(dbg,name,slen,sd,
-        &adding_at_offset, error);
-    if (res != DW_DLV_OK) {
-        return res;
-    }
-
-    /*  The name is in the string table itself, so use that pointer
-        and offset for the string. */
-    res = make_debug_str_entry(dbg,&mt2, 0,
-        slen,TRUE,adding_at_offset,error);
-    if (res != DW_DLV_OK) {
-        return res;
-    }
-    retval = dwarf_tsearch(mt2,
-        (void *)hashtab,
-        _dwarf_debug_str_compare_func);
-    if (!retval) {
-        debug_str_entry_free_func(mt2);
-        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
-
-    /* This indirection is one of the surprises in using tsearch... */
-    re = *(struct Dwarf_P_debug_str_entry_s **)retval;
-    if (re != mt2) {
-        debug_str_entry_free_func(mt2);
-        /*  Found it in hash tab: illogical as the tsearch_find should
-            have found it. */
-        _dwarf_p_error(dbg, error, DW_DLE_ILLOGICAL_TSEARCH);
-        return DW_DLV_ERROR;
+    } else {
+        stats->ps_strp_count_debug_str++;
+        stats->ps_strp_len_debug_str += slen;
     }
-    stats->ps_strp_count_debug_str++;
-    stats->ps_strp_len_debug_str += slen;
-    /* we added it to hash, do not free mt2 (which == re). */
-    *offset_in_debug_str = re->dse_table_offset;
     return DW_DLV_OK;
 }
 
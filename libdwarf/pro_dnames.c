@@ -30,6 +30,12 @@
 #include "libdwarfdefs.h"
 #include <stdio.h>
 #include <string.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* For uintptr_t */
+#endif /* HAVE_STDINT_H */
 #ifdef HAVE_ELFACCESS_H
 #include <elfaccess.h>
 #endif
@@ -44,6 +50,8 @@
 #include "pro_section.h"
 #include "pro_reloc.h"
 #include "pro_dnames.h"
+#include "pro_encode_nm.h"
+#include "dwarf_tsearch.h"
 
 #define FALSE 0
 #define TRUE  1
@@ -61,16 +69,715 @@ dwarf_force_debug_names(Dwarf_P_Debug dbg,
         return DW_DLV_ERROR;
     }
 
-    dn = (Dwarf_P_Dnames)
-        _dwarf_p_get_alloc(dbg, sizeof(struct Dwarf_P_Dnames_s));
-    if (dn == NULL) {
-        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
-        return DW_DLV_ERROR;
-    }
-    if (!dbg->de_dnames) {
+    dn = dbg->de_dnames;
+    if (!dn) {
+        dn = (Dwarf_P_Dnames)
+            _dwarf_p_get_alloc(dbg, sizeof(struct Dwarf_P_Dnames_s));
+        if (dn == NULL) {
+            _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+            return DW_DLV_ERROR;
+        }
         dbg->de_dnames = dn;
     }
     dn->dn_create_section = TRUE;
 
     return DW_DLV_OK;
 }
+
+/*  The DWARF5 name hash (DWARF5 section 7.33): the DJB hash
+    of the name. Like other producers we case-fold first so
+    languages with case-insensitive names can use the same
+    table. Only ASCII is folded here. */
+Dwarf_Unsigned
+_dwarf_dnames_hash(const char *name)
+{
+    Dwarf_Unsigned h = 5381;
+    const unsigned char *cp = (const unsigned char *)name;
+
+    for ( ; *cp; ++cp) {
+        unsigned c = *cp;
+
+        if (c >= 'A' && c <= 'Z') {
+            c += 'a' - 'A';
+        }
+        h = ((h << 5) + h + c) & 0xffffffff;
+    }
+    return h;
+}
+
+/*  The DIEs DWARF5 6.1.1.1 expects in a name index:
+    named types, namespaces, and functions and
+    variables at namespace scope. Nothing inside a
+    function body is indexed. */
+int
+_dwarf_dnames_tag_indexed(Dwarf_Unsigned tag, int *descend)
+{
+    *descend = FALSE;
+    switch (tag) {
+    case DW_TAG_namespace:
+    case DW_TAG_module:
+    case DW_TAG_class_type:
+    case DW_TAG_structure_type:
+    case DW_TAG_union_type:
+    case DW_TAG_interface_type:
+    case DW_TAG_enumeration_type:
+        *descend = TRUE;
+        return TRUE;
+    case DW_TAG_base_type:
+    case DW_TAG_typedef:
+    case DW_TAG_subrange_type:
+    case DW_TAG_unspecified_type:
+    case DW_TAG_enumerator:
+    case DW_TAG_subprogram:
+    case DW_TAG_variable:
+    case DW_TAG_constant:
+        return TRUE;
+    default:
+        break;
+    }
+    return FALSE;
+}
+
+static DW_TSHASHTYPE
+dn_name_hashfunc(const void *keyp)
+{
+    return (DW_TSHASHTYPE)_dwarf_dnames_hash((const char *)keyp);
+}
+
+static int
+dn_name_compare(const void *l, const void *r)
+{
+    return strcmp((const char *)l,(const char *)r);
+}
+
+static void
+dn_name_free(void *nodep)
+{
+    free(nodep);
+}
+
+static int
+dn_grow_uarray(struct Dwarf_P_Dnames_uarray_s *a)
+{
+    dn_type newcount = a->dne_allocated? 2*a->dne_allocated:16;
+    dn_type *newv = 0;
+
+    newv = (dn_type *)realloc(a->dne_values,
+        newcount*sizeof(dn_type));
+    if (!newv) {
+        return DW_DLV_ERROR;
+    }
+    a->dne_values = newv;
+    a->dne_allocated = newcount;
+    return DW_DLV_OK;
+}
+
+int
+_dwarf_pro_dnames_add_cu(struct Dwarf_P_Dnames_s *dn,
+    Dwarf_Unsigned cu_offset,
+    Dwarf_Unsigned *cu_index,
+    int *errnum)
+{
+    struct Dwarf_P_Dnames_uarray_s *a = &dn->dn_cunit_offset;
+
+    if (a->dne_used >= a->dne_allocated) {
+        if (dn_grow_uarray(a) != DW_DLV_OK) {
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+    }
+    a->dne_values[a->dne_used] = cu_offset;
+    *cu_index = a->dne_used;
+    a->dne_used++;
+    return DW_DLV_OK;
+}
+
+int
+_dwarf_pro_dnames_add_name(struct Dwarf_P_Dnames_s *dn,
+    const char *name,
+    Dwarf_Unsigned cu_index,
+    Dwarf_Unsigned die_offset,
+    Dwarf_Unsigned tag,
+    int *errnum)
+{
+    struct Dwarf_P_Dnames_earray_s *a = &dn->dn_entries;
+    struct Dwarf_P_Dnames_entry_s *e = 0;
+    void *retval = 0;
+    const char *interned = 0;
+
+    if (!name || !*name) {
+        return DW_DLV_NO_ENTRY;
+    }
+    if (!dn->dn_name_tree) {
+        dwarf_initialize_search_hash(&dn->dn_name_tree,
+            dn_name_hashfunc,0);
+        if (!dn->dn_name_tree) {
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+    }
+    retval = dwarf_tfind(name,&dn->dn_name_tree,dn_name_compare);
+    if (retval) {
+        interned = *(const char **)retval;
+    } else {
+        char *copy = strdup(name);
+
+        if (!copy) {
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+        retval = dwarf_tsearch(copy,&dn->dn_name_tree,
+            dn_name_compare);
+        if (!retval) {
+            free(copy);
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+        interned = copy;
+        dn->dn_distinct_names++;
+    }
+    if (a->dne_used >= a->dne_allocated) {
+        dn_type newcount = a->dne_allocated?
+            2*a->dne_allocated:64;
+        struct Dwarf_P_Dnames_entry_s *newv = 0;
+
+        newv = (struct Dwarf_P_Dnames_entry_s *)realloc(
+            a->dne_values,newcount*sizeof(*newv));
+        if (!newv) {
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+        a->dne_values = newv;
+        a->dne_allocated = newcount;
+    }
+    e = a->dne_values + a->dne_used;
+    a->dne_used++;
+    e->dne_name = interned;
+    e->dne_hash = _dwarf_dnames_hash(interned);
+    e->dne_bucket = 0;
+    e->dne_cu_index = cu_index;
+    e->dne_die_offset = die_offset;
+    e->dne_tag = tag;
+    return DW_DLV_OK;
+}
+
+/*  Orders entries by bucket then hash, so each bucket
+    is contiguous as DWARF5 requires, then by name so
+    equal names are adjacent, then by DIE so the
+    output does not depend on insertion order. */
+static int
+dn_entry_compare(const void *l, const void *r)
+{
+    const struct Dwarf_P_Dnames_entry_s *a =
+        (const struct Dwarf_P_Dnames_entry_s *)l;
+    const struct Dwarf_P_Dnames_entry_s *b =
+        (const struct Dwarf_P_Dnames_entry_s *)r;
+    int res = 0;
+
+    if (a->dne_bucket != b->dne_bucket) {
+        return a->dne_bucket < b->dne_bucket? -1:1;
+    }
+    if (a->dne_hash != b->dne_hash) {
+        return a->dne_hash < b->dne_hash? -1:1;
+    }
+    if (a->dne_name != b->dne_name) {
+        res = strcmp(a->dne_name,b->dne_name);
+        if (res) {
+            return res;
+        }
+    }
+    if (a->dne_cu_index != b->dne_cu_index) {
+        return a->dne_cu_index < b->dne_cu_index? -1:1;
+    }
+    if (a->dne_die_offset != b->dne_die_offset) {
+        return a->dne_die_offset < b->dne_die_offset? -1:1;
+    }
+    if (a->dne_tag != b->dne_tag) {
+        return a->dne_tag < b->dne_tag? -1:1;
+    }
+    return 0;
+}
+
+/*  Fewer buckets than names keeps the table small,
+    the chains stay short because the hash is good. */
+static dn_type
+dn_bucket_count(dn_type name_count)
+{
+    if (name_count > 1024) {
+        return name_count/4;
+    }
+    if (name_count > 16) {
+        return name_count/2;
+    }
+    return name_count;
+}
+
+/*  tags[] is sorted and holds the tag. */
+static dn_type
+dn_abbrev_code(dn_type *tags, dn_type tagcount, dn_type tag)
+{
+    dn_type lo = 0;
+    dn_type hi = tagcount;
+
+    while (lo < hi) {
+        dn_type mid = lo + (hi - lo)/2;
+
+        if (tags[mid] < tag) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo + 1;
+}
+
+static unsigned
+dn_uleb_size(Dwarf_Unsigned val)
+{
+    unsigned len = 1;
+
+    while (val >= 0x80) {
+        val >>= 7;
+        len++;
+    }
+    return len;
+}
+
+static Dwarf_Small *
+dn_put_uleb(Dwarf_Small *dest, Dwarf_Unsigned val)
+{
+    int nbytes = 0;
+
+    _dwarf_pro_encode_leb128_nm(val,&nbytes,(char *)dest,
+        ENCODE_SPACE_NEEDED);
+    return dest + nbytes;
+}
+
+/*  Writes val in the target byte order, the same
+    way WRITE_UNALIGNED does. */
+static Dwarf_Small *
+dn_put_val(void (*copy_word)(void *, const void *, unsigned long),
+    Dwarf_Small *dest, Dwarf_Unsigned val, unsigned len)
+{
+#ifdef WORDS_BIGENDIAN
+    copy_word(dest,((const char *)&val) + sizeof(val) - len,len);
+#else
+    copy_word(dest,(const char *)&val,len);
+#endif
+    return dest + len;
+}
+
+#define DN_OFFSET_MAX 0xffffffff
+#define DN_HEADER_SIZE (2 + 2 + 7*DWARF_32BIT_SIZE)
+
+/*  Builds a complete DWARF5 .debug_names name index
+    (one index covering every CU added) into a malloc'd
+    buffer the caller frees.
+    offset_size is 4 or 8, extension_size is 4 when
+    the 64-bit length escape is wanted, otherwise 0.
+    A CU index (DW_IDX_compile_unit, DW_FORM_udata) is
+    only present when there is more than one CU.
+    DIE offsets are DW_IDX_die_offset, DW_FORM_ref4. */
+int
+_dwarf_pro_dnames_serialize(struct Dwarf_P_Dnames_s *dn,
+    void (*copy_word)(void *, const void *, unsigned long),
+    unsigned offset_size,
+    unsigned extension_size,
+    _dwarf_pro_dnames_strfunc strfunc,
+    void *user_data,
+    Dwarf_Small **data_out,
+    Dwarf_Unsigned *len_out,
+    int *errnum)
+{
+    struct Dwarf_P_Dnames_entry_s *ents = dn->dn_entries.dne_values;
+    dn_type entcount = dn->dn_entries.dne_used;
+    dn_type cucount = dn->dn_cunit_offset.dne_used;
+    dn_type namecount = dn->dn_distinct_names;
+    dn_type bucketcount = dn_bucket_count(namecount);
+    /*  Distinct tags, ascending. Abbrev code is index+1. */
+    dn_type *tags = 0;
+    dn_type tagcount = 0;
+    int with_cu_index = cucount > 1;
+    Dwarf_Unsigned abbrevsize = 0;
+    Dwarf_Unsigned poolsize = 0;
+    Dwarf_Unsigned total = 0;
+    Dwarf_Small *data = 0;
+    Dwarf_Small *p = 0;
+    Dwarf_Small *stroffp = 0;
+    Dwarf_Small *entoffp = 0;
+    Dwarf_Small *hashp = 0;
+    Dwarf_Small *bucketp = 0;
+    Dwarf_Small *poolstart = 0;
+    Dwarf_Unsigned offset_max = DN_OFFSET_MAX;
+    dn_type i = 0;
+    dn_type n = 0;
+
+    if (!cucount) {
+        *errnum = DW_DLE_DEBUG_NAMES_BUILD_ERROR;
+        return DW_DLV_ERROR;
+    }
+    if (offset_size == DWARF_64BIT_SIZE) {
+        offset_max = ~(Dwarf_Unsigned)0;
+    }
+    for (i = 0; i < cucount; ++i) {
+        if (dn->dn_cunit_offset.dne_values[i] > offset_max) {
+            *errnum = DW_DLE_DEBUG_NAMES_BUILD_ERROR;
+            return DW_DLV_ERROR;
+        }
+    }
+    if (entcount) {
+        tags = (dn_type *)malloc(entcount*sizeof(dn_type));
+        if (!tags) {
+            *errnum = DW_DLE_ALLOC_FAIL;
+            return DW_DLV_ERROR;
+        }
+    }
+    for (i = 0; i < entcount; ++i) {
+        struct Dwarf_P_Dnames_entry_s *e = ents+i;
+        dn_type t = 0;
+
+        if (e->dne_die_offset > DN_OFFSET_MAX ||
+            e->dne_cu_index >= cucount) {
+            free(tags);
+            *errnum = DW_DLE_DEBUG_NAMES_BUILD_ERROR;
+            return DW_DLV_ERROR;
+        }
+        e->dne_bucket = e->dne_hash % bucketcount;
+        /*  Insertion into the sorted distinct-tag list. */
+        for (t = 0; t < tagcount; ++t) {
+            if (tags[t] >= e->dne_tag) {
+                break;
+            }
+        }
+        if (t == tagcount || tags[t] != e->dne_tag) {
+            memmove(tags+t+1,tags+t,(tagcount-t)*sizeof(dn_type));
+            tags[t] = e->dne_tag;
+            tagcount++;
+        }
+    }
+    if (entcount) {
+        qsort(ents,entcount,sizeof(*ents),dn_entry_compare);
+    }
+
+    /*  Abbreviation table: code, tag, the index
+        attribute/form pairs, 0,0. Then a final 0. */
+    for (i = 0; i < tagcount; ++i) {
+        abbrevsize += dn_uleb_size(i+1) + dn_uleb_size(tags[i]);
+        if (with_cu_index) {
+            abbrevsize += dn_uleb_size(DW_IDX_compile_unit) +
+                dn_uleb_size(DW_FORM_udata);
+        }
+        abbrevsize += dn_uleb_size(DW_IDX_die_offset) +
+            dn_uleb_size(DW_FORM_ref4) + 2;
+    }
+    abbrevsize += 1;
+
+    /*  Entry pool: per name, its entries then a 0. */
+    poolsize = namecount;
+    for (i = 0; i < entcount; ++i) {
+        struct Dwarf_P_Dnames_entry_s *e = ents+i;
+
+        poolsize += dn_uleb_size(dn_abbrev_code(tags,tagcount,
+            e->dne_tag)) + DWARF_32BIT_SIZE;
+        if (with_cu_index) {
+            poolsize += dn_uleb_size(e->dne_cu_index);
+        }
+    }
+
+    /*  Hashes are always 4 bytes, the CU list, string
+        offsets and entry offsets are offset_size. */
+    total = extension_size + offset_size + DN_HEADER_SIZE +
+        cucount*offset_size +
+        bucketcount*DWARF_32BIT_SIZE +
+        namecount*DWARF_32BIT_SIZE +
+        2*namecount*offset_size +
+        abbrevsize + poolsize;
+    if ((total - offset_size - extension_size) > offset_max) {
+        free(tags);
+        *errnum = DW_DLE_DEBUG_NAMES_BUILD_ERROR;
+        return DW_DLV_ERROR;
+    }
+    data = (Dwarf_Small *)calloc(1,total);
+    if (!data) {
+        free(tags);
+        *errnum = DW_DLE_ALLOC_FAIL;
+        return DW_DLV_ERROR;
+    }
+    p = data;
+    if (extension_size) {
+        p = dn_put_val(copy_word,p,DISTINGUISHED_VALUE,
+            extension_size);
+    }
+    p = dn_put_val(copy_word,p,
+        total - offset_size - extension_size,offset_size);
+    p = dn_put_val(copy_word,p,5,DWARF_HALF_SIZE);
+    p = dn_put_val(copy_word,p,0,DWARF_HALF_SIZE);
+    p = dn_put_val(copy_word,p,cucount,DWARF_32BIT_SIZE);
+    /*  No local or foreign type units. */
+    p = dn_put_val(copy_word,p,0,DWARF_32BIT_SIZE);
+    p = dn_put_val(copy_word,p,0,DWARF_32BIT_SIZE);
+    p = dn_put_val(copy_word,p,bucketcount,DWARF_32BIT_SIZE);
+    p = dn_put_val(copy_word,p,namecount,DWARF_32BIT_SIZE);
+    p = dn_put_val(copy_word,p,abbrevsize,DWARF_32BIT_SIZE);
+    /*  No augmentation string. */
+    p = dn_put_val(copy_word,p,0,DWARF_32BIT_SIZE);
+    dn->dn_cu_list_offset = p - data;
+    for (i = 0; i < cucount; ++i) {
+        p = dn_put_val(copy_word,p,
+            dn->dn_cunit_offset.dne_values[i],offset_size);
+    }
+    bucketp = p;
+    hashp = bucketp + bucketcount*DWARF_32BIT_SIZE;
+    stroffp = hashp + namecount*DWARF_32BIT_SIZE;
+    entoffp = stroffp + namecount*offset_size;
+    p = entoffp + namecount*offset_size;
+    dn->dn_string_offsets_offset = stroffp - data;
+    for (i = 0; i < tagcount; ++i) {
+        p = dn_put_uleb(p,i+1);
+        p = dn_put_uleb(p,tags[i]);
+        if (with_cu_index) {
+            p = dn_put_uleb(p,DW_IDX_compile_unit);
+            p = dn_put_uleb(p,DW_FORM_udata);
+        }
+        p = dn_put_uleb(p,DW_IDX_die_offset);
+        p = dn_put_uleb(p,DW_FORM_ref4);
+        *p++ = 0;
+        *p++ = 0;
+    }
+    *p++ = 0;
+    poolstart = p;
+
+    /*  Buckets (already zero), hashes, string offsets,
+        entry offsets and the entry pool, one name at a time. */
+    for (i = 0, n = 0; i < entcount; ) {
+        struct Dwarf_P_Dnames_entry_s *first = ents+i;
+        Dwarf_Unsigned stroff = 0;
+        Dwarf_Small *bp = bucketp + first->dne_bucket*DWARF_32BIT_SIZE;
+        int res = 0;
+
+        res = strfunc(user_data,first->dne_name,&stroff,errnum);
+        if (res != DW_DLV_OK || stroff > offset_max) {
+            free(data);
+            free(tags);
+            if (res == DW_DLV_OK) {
+                *errnum = DW_DLE_DEBUG_NAMES_BUILD_ERROR;
+            }
+            return DW_DLV_ERROR;
+        }
+        if (!i || first->dne_bucket != ents[i-1].dne_bucket) {
+            /*  1-based index of the first name in the bucket. */
+            dn_put_val(copy_word,bp,n+1,DWARF_32BIT_SIZE);
+        }
+        dn_put_val(copy_word,hashp + n*DWARF_32BIT_SIZE,
+            first->dne_hash,DWARF_32BIT_SIZE);
+        dn_put_val(copy_word,stroffp + n*offset_size,
+            stroff,offset_size);
+        dn_put_val(copy_word,entoffp + n*offset_size,
+            (Dwarf_Unsigned)(p - poolstart),offset_size);
+        for ( ; i < entcount && ents[i].dne_name == first->dne_name;
+            ++i) {
+            struct Dwarf_P_Dnames_entry_s *e = ents+i;
+
+            p = dn_put_uleb(p,dn_abbrev_code(tags,tagcount,
+                e->dne_tag));
+            if (with_cu_index) {
+                p = dn_put_uleb(p,e->dne_cu_index);
+            }
+            p = dn_put_val(copy_word,p,e->dne_die_offset,
+                DWARF_32BIT_SIZE);
+        }
+        *p++ = 0;
+        n++;
+    }
+    free(tags);
+    *data_out = data;
+    *len_out = total;
+    return DW_DLV_OK;
+}
+
+/*  Frees what the builder functions malloc'd,
+    not the Dwarf_P_Dnames_s itself. */
+void
+_dwarf_pro_dnames_destroy(struct Dwarf_P_Dnames_s *dn)
+{
+    if (!dn) {
+        return;
+    }
+    free(dn->dn_cunit_offset.dne_values);
+    dn->dn_cunit_offset.dne_values = 0;
+    dn->dn_cunit_offset.dne_used = 0;
+    dn->dn_cunit_offset.dne_allocated = 0;
+    free(dn->dn_entries.dne_values);
+    dn->dn_entries.dne_values = 0;
+    dn->dn_entries.dne_used = 0;
+    dn->dn_entries.dne_allocated = 0;
+    if (dn->dn_name_tree) {
+        dwarf_tdestroy(dn->dn_name_tree,dn_name_free);
+        dn->dn_name_tree = 0;
+    }
+    dn->dn_distinct_names = 0;
+}
+
+/*  Reverses WRITE_UNALIGNED. */
+static Dwarf_Unsigned
+dn_get_val(Dwarf_P_Debug dbg, const char *src, unsigned len)
+{
+    Dwarf_Unsigned val = 0;
+
+#ifdef WORDS_BIGENDIAN
+    dbg->de_copy_word(((char *)&val) + sizeof(val) - len,src,len);
+#else
+    dbg->de_copy_word((char *)&val,src,len);
+#endif
+    return val;
+}
+
+static Dwarf_P_Attribute
+dn_find_attr(Dwarf_P_Die die, Dwarf_Half attrnum)
+{
+    Dwarf_P_Attribute a = die->di_attrs;
+
+    for ( ; a; a = a->ar_next) {
+        if (a->ar_attribute == attrnum) {
+            return a;
+        }
+    }
+    return 0;
+}
+
+/*  The producer keeps names as DW_FORM_string
+    or as DW_FORM_strp into de_debug_str. */
+static const char *
+dn_attr_string(Dwarf_P_Debug dbg, Dwarf_P_Attribute a)
+{
+    Dwarf_P_Section_Data sd = dbg->de_debug_str;
+    Dwarf_Unsigned off = 0;
+
+    if (!a || !a->ar_data) {
+        return 0;
+    }
+    if (a->ar_attribute_form == DW_FORM_string) {
+        return a->ar_data;
+    }
+    if (a->ar_attribute_form != DW_FORM_strp) {
+        return 0;
+    }
+    off = dn_get_val(dbg,a->ar_data,a->ar_nbytes);
+    if (!sd->ds_data || off >= sd->ds_nbytes) {
+        return 0;
+    }
+    return sd->ds_data + off;
+}
+
+static int
+dn_is_declaration(Dwarf_P_Die die)
+{
+    Dwarf_P_Attribute a = dn_find_attr(die,DW_AT_declaration);
+
+    if (!a) {
+        return FALSE;
+    }
+    if (a->ar_attribute_form == DW_FORM_flag_present) {
+        return TRUE;
+    }
+    return a->ar_nbytes && a->ar_data && a->ar_data[0];
+}
+
+/*  The producer twin of index_die_names() in
+    dwarf_dnames_sidecar.c. */
+static int
+dn_index_die_names(Dwarf_P_Debug dbg, Dwarf_P_Die die,
+    int *errnum)
+{
+    struct Dwarf_P_Dnames_s *dn = dbg->de_dnames;
+    Dwarf_P_Die namedie = die;
+    Dwarf_Tag tag = die->di_tag;
+    const char *name = 0;
+    int res = 0;
+
+    name = dn_attr_string(dbg,dn_find_attr(die,DW_AT_name));
+    if (!name &&
+        (tag == DW_TAG_subprogram || tag == DW_TAG_variable)) {
+        Dwarf_P_Attribute ref =
+            dn_find_attr(die,DW_AT_specification);
+
+        if (!ref) {
+            ref = dn_find_attr(die,DW_AT_abstract_origin);
+        }
+        if (!ref || !ref->ar_ref_die) {
+            return DW_DLV_OK;
+        }
+        namedie = ref->ar_ref_die;
+        name = dn_attr_string(dbg,dn_find_attr(namedie,DW_AT_name));
+    }
+    if (name) {
+        res = _dwarf_pro_dnames_add_name(dn,name,0,
+            die->di_offset,tag,errnum);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    if (tag == DW_TAG_subprogram || tag == DW_TAG_variable) {
+        Dwarf_P_Attribute link =
+            dn_find_attr(namedie,DW_AT_linkage_name);
+        const char *linkname = 0;
+
+        if (!link) {
+            link = dn_find_attr(namedie,DW_AT_MIPS_linkage_name);
+        }
+        linkname = dn_attr_string(dbg,link);
+        if (linkname && (!name || strcmp(name,linkname))) {
+            res = _dwarf_pro_dnames_add_name(dn,linkname,0,
+                die->di_offset,tag,errnum);
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+        }
+    }
+    return DW_DLV_OK;
+}
+
+static int
+dn_index_children(Dwarf_P_Debug dbg, Dwarf_P_Die parent,
+    int *errnum)
+{
+    Dwarf_P_Die die = parent->di_child;
+
+    for ( ; die; die = die->di_right) {
+        int descend = FALSE;
+
+        if (_dwarf_dnames_tag_indexed(die->di_tag,&descend)) {
+            if (!dn_is_declaration(die)) {
+                int res = dn_index_die_names(dbg,die,errnum);
+
+                if (res == DW_DLV_ERROR) {
+                    return res;
+                }
+            }
+        }
+        if (descend) {
+            int res = dn_index_children(dbg,die,errnum);
+
+            if (res == DW_DLV_ERROR) {
+                return res;
+            }
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  The producer writes one CU, at .debug_info offset
+    zero, so DIE offsets are also CU-relative. */
+int
+_dwarf_pro_dnames_index_dies(Dwarf_P_Debug dbg, int *errnum)
+{
+    struct Dwarf_P_Dnames_s *dn = dbg->de_dnames;
+    Dwarf_Unsigned cu_index = 0;
+    int res = 0;
+
+    res = _dwarf_pro_dnames_add_cu(dn,0,&cu_index,errnum);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    return dn_index_children(dbg,dbg->de_dies,errnum);
+}
@@ -60,6 +60,24 @@ struct Dwarf_P_Dnames_sarray_s {
 };
 
 
+/*  One (name, DIE) pair to be indexed.
+    dne_name points at the copy interned in dn_name_tree,
+    so equal names have equal pointers. */
+struct Dwarf_P_Dnames_entry_s {
+    const char    *dne_name;
+    dn_type        dne_hash;
+    dn_type        dne_bucket;
+    dn_type        dne_cu_index;
+    /*  Relative to the start of the CU. */
+    dn_type        dne_die_offset;
+    dn_type        dne_tag;
+};
+struct Dwarf_P_Dnames_earray_s {
+    dn_type  dne_allocated;
+    dn_type  dne_used;
+    struct Dwarf_P_Dnames_entry_s *dne_values;
+};
+
 struct Dwarf_P_Dnames_s {
     Dwarf_Small dn_create_section;
     struct Dwarf_P_Dnames_Head_s dn_header;
@@ -78,4 +96,58 @@ struct Dwarf_P_Dnames_s {
     Dwarf_Small  dn_index_entry_pool_size;
     Dwarf_Small  dn_index_entry_pool_used;
 
+    /*  Filled in by _dwarf_pro_dnames_add_name(),
+        turned into the section by _dwarf_pro_dnames_serialize(). */
+    struct Dwarf_P_Dnames_earray_s dn_entries;
+    void    *dn_name_tree;
+    dn_type  dn_distinct_names;
+
+    /*  Set by _dwarf_pro_dnames_serialize(): where the CU
+        list and the string offsets start in the index,
+        so the producer can attach relocations. */
+    dn_type  dn_cu_list_offset;
+    dn_type  dn_string_offsets_offset;
 };
+
+/*  The builder below uses only malloc, not the producer
+    allocator, so the consumer can use it too
+    (see dwarf_debugnames_write_sidecar()).
+    Errors are returned as DW_DLV_ERROR with a DW_DLE
+    code in *errnum, the caller reports them. */
+
+/*  Sets *str_offset to the offset of name in the string
+    section the index refers to. Called once per distinct
+    name, in name table order. */
+typedef int (*_dwarf_pro_dnames_strfunc)(void *user_data,
+    const char *name, Dwarf_Unsigned *str_offset, int *errnum);
+
+Dwarf_Unsigned _dwarf_dnames_hash(const char *name);
+/*  TRUE if DIEs with this tag go in a name index
+    (DWARF5 6.1.1.1). *descend is set TRUE if the
+    children of such a DIE should be looked at too. */
+int _dwarf_dnames_tag_indexed(Dwarf_Unsigned tag, int *descend);
+int _dwarf_pro_dnames_add_cu(struct Dwarf_P_Dnames_s *dn,
+    Dwarf_Unsigned cu_offset,
+    Dwarf_Unsigned *cu_index,
+    int *errnum);
+int _dwarf_pro_dnames_add_name(struct Dwarf_P_Dnames_s *dn,
+    const char *name,
+    Dwarf_Unsigned cu_index,
+    Dwarf_Unsigned die_offset,
+    Dwarf_Unsigned tag,
+    int *errnum);
+int _dwarf_pro_dnames_serialize(struct Dwarf_P_Dnames_s *dn,
+    void (*copy_word)(void *, const void *, unsigned long),
+    unsigned offset_size,
+    unsigned extension_size,
+    _dwarf_pro_dnames_strfunc strfunc,
+    void *user_data,
+    Dwarf_Small **data_out,
+    Dwarf_Unsigned *len_out,
+    int *errnum);
+void _dwarf_pro_dnames_destroy(struct Dwarf_P_Dnames_s *dn);
+
+/*  Producer only: adds the CU and every indexed DIE
+    of dbg->de_dies to dbg->de_dnames. DIE offsets
+    must already have been assigned. */
+int _dwarf_pro_dnames_index_dies(Dwarf_P_Debug dbg, int *errnum);
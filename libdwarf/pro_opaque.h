@@ -361,20 +361,22 @@ struct Dwarf_P_Per_Sect_String_Attrs_s {
     Dwarf_P_String_Attr sect_sa_list;
 };
 
-struct Dwarf_P_debug_str_entry_s {
-    Dwarf_P_Debug  dse_dbg;
-    /*  Name used initially with tfind. */
-    char *dse_name;
-
-    Dwarf_Unsigned dse_slen; /* includes space for NUL terminator */
-
-    /*  See dse_has_table_offset below. */
-    Dwarf_Unsigned dse_table_offset;
+/*  One string of a .debug_str or .debug_line_str pool.
+    sps_offset is one more than the offset of the string
+    in the section data, so zero marks an empty slot. */
+struct Dwarf_P_Str_Pool_Slot_s {
+    Dwarf_Unsigned sps_offset;
+    unsigned sps_hash;
+    unsigned sps_len; /* includes space for NUL terminator */
+};
 
-    /*  For tsearch a hash table exists and we have a table offset.
-        dse_dbg->de_debug_str->ds_data + dse_table_offset
-        points to the string iff dse_has_table_offset != 0. */
-    unsigned char  dse_has_table_offset;
+/*  Open addressing table of the strings in a string
+    section.  The bytes themselves live only in the
+    section data, which grows as one arena. */
+struct Dwarf_P_Str_Pool_s {
+    struct Dwarf_P_Str_Pool_Slot_s *sp_slots;
+    Dwarf_Unsigned sp_size;  /* Zero or a power of two. */
+    Dwarf_Unsigned sp_count;
 };
 
 struct Dwarf_P_Str_stats_s {
@@ -423,13 +425,26 @@ struct Dwarf_P_Debug_s {
         This intended for the .debug_info section. */
     int de_debug_default_str_form;
 
+    /*  Non-zero if dwarf_pro_set_type_dedup() asked for
+        duplicate type subtrees to be removed. */
+    int de_type_dedup;
+
+    /*  Set by dwarf_pro_set_job_runner() to generate
+        independent sections concurrently. */
+    Dwarf_P_Job_Runner de_job_runner;
+    void *de_job_runner_data;
+
+    /*  Non-zero if dwarf_pro_set_string_tail_merge() asked
+        for strings to share the tails of longer ones. */
+    int de_string_tail_merge;
+
     /* If form DW_FORM_strp */
     Dwarf_P_Section_Data de_debug_str;
-    void *de_debug_str_hashtab; /* for tsearch */
+    struct Dwarf_P_Str_Pool_s de_debug_str_pool;
 
     /* .debug_line_str section data if form DW_FORM_line_strp */
     Dwarf_P_Section_Data de_debug_line_str;
-    void *de_debug_line_str_hashtab; /* for tsearch */
+    struct Dwarf_P_Str_Pool_s de_debug_line_str_pool;
 
     /*  Pointer to the 'current active' section */
     Dwarf_P_Section_Data de_current_active_section;
@@ -566,7 +581,8 @@ struct Dwarf_P_Debug_s {
 
     /*  Add new fields at the END of this struct to preserve some hope
         of sensible behavior on dbg passing between DSOs linked with
-        mismatched libdwarf producer versions. */
+        mismatched libdwarf producer versions.
+        List every new field in PRO_DEBUG_FIELDS below too. */
 
     Dwarf_P_Marker de_markers;  /* pointer to array of markers */
     unsigned de_marker_n_alloc;
@@ -581,6 +597,96 @@ struct Dwarf_P_Debug_s {
     struct Dwarf_P_Stats_s de_stats;
 };
 
+/*  Every field of Dwarf_P_Debug_s, in declaration order.
+    The dbg that generates .debug_line concurrently with
+    .debug_info (see generate_line_and_info_parallel() in
+    pro_section.c) gets a copy of the copy() fields, which
+    _dwarf_pro_generate_debugline() and the buffer,
+    relocation and error code under it read.  Of
+    de_reloc_sect only the DEBUG_LINE entry is joined back.
+    The zero() fields, the string pools, DIEs, frames and
+    output sections among them, stay zero there, so the
+    line job cannot see or alter what the info group
+    changes.  test_line_job checks that this list covers
+    the whole struct, so a new field must be added here,
+    copied or not. */
+#define PRO_DEBUG_FIELDS(copy,zero) \
+    copy(de_version_magic_number) \
+    copy(de_errhand) \
+    copy(de_user_data) \
+    copy(de_errarg) \
+    copy(de_callback_func) \
+    copy(de_flags) \
+    zero(de_debug_sects) \
+    zero(de_debug_default_str_form) \
+    zero(de_type_dedup) \
+    zero(de_job_runner) \
+    zero(de_job_runner_data) \
+    zero(de_string_tail_merge) \
+    zero(de_debug_str) \
+    zero(de_debug_str_pool) \
+    zero(de_debug_line_str) \
+    zero(de_debug_line_str_pool) \
+    zero(de_current_active_section) \
+    zero(de_n_debug_sect) \
+    copy(de_file_entries) \
+    copy(de_last_file_entry) \
+    copy(de_n_file_entries) \
+    copy(de_inc_dirs) \
+    copy(de_last_inc_dir) \
+    copy(de_n_inc_dirs) \
+    copy(de_lines) \
+    copy(de_last_line) \
+    zero(de_frame_cies) \
+    zero(de_last_cie) \
+    zero(de_n_cie) \
+    zero(de_frame_fdes) \
+    zero(de_last_fde) \
+    zero(de_n_fde) \
+    zero(de_debug_sup) \
+    zero(de_dies) \
+    zero(de_arange) \
+    zero(de_last_arange) \
+    zero(de_arange_count) \
+    zero(de_dnames) \
+    zero(de_dnames_sect) \
+    zero(de_first_macinfo) \
+    zero(de_current_macinfo) \
+    zero(de_first_debug_sect) \
+    zero(de_simple_name_headers) \
+    copy(de_reloc_sect) \
+    zero(de_reloc_next_to_return) \
+    copy(de_elf_sects) \
+    copy(de_sect_name_idx) \
+    copy(de_offset_reloc) \
+    copy(de_exc_reloc) \
+    copy(de_ptr_reloc) \
+    zero(de_irix_exc_augmentation) \
+    copy(de_dwarf_offset_size) \
+    copy(de_elf_offset_size) \
+    copy(de_pointer_size) \
+    copy(de_segment_selector_size) \
+    copy(de_relocation_record_size) \
+    copy(de_64bit_extension) \
+    copy(de_output_version) \
+    copy(de_big_endian) \
+    zero(de_ar_data_attribute_form) \
+    zero(de_ar_ref_attr_form) \
+    copy(de_relocate_by_name_symbol) \
+    copy(de_relocate_pair_by_symbol) \
+    copy(de_transform_relocs_to_disk) \
+    zero(de_compose_avail) \
+    zero(de_compose_used_len) \
+    copy(de_same_endian) \
+    copy(de_copy_word) \
+    zero(de_markers) \
+    zero(de_marker_n_alloc) \
+    zero(de_marker_n_used) \
+    zero(de_sect_sa_next_to_return) \
+    zero(de_sect_string_attr) \
+    copy(de_line_inits) \
+    zero(de_stats)
+
 #define CURRENT_VERSION_STAMP   2
 
 int _dwarf_add_simple_name_entry(Dwarf_P_Debug dbg,
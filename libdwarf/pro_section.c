@@ -45,9 +45,7 @@
 /* Useful include for some Windows compilers. */
 #include <malloc.h>
 #endif /* HAVE_MALLOC_H */
-#ifdef HAVE_STDDEF_H
-#include <stddef.h>
-#endif /* HAVE_STDDEF_H */
+#include <stddef.h> /* For offsetof() */
 #include "pro_incl.h"
 #include "dwarf.h"
 #include "libdwarf.h"
@@ -63,6 +61,8 @@
 #include "pro_macinfo.h"
 #include "pro_types.h"
 #include "pro_dnames.h"
+#include "pro_dedup.h"
+#include "pro_strpool.h"
 
 
 #ifndef SHN_UNDEF
@@ -231,6 +231,8 @@ static int _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     Dwarf_Signed *nbufs, Dwarf_Error * error);
 static int _dwarf_pro_generate_debugsup(Dwarf_P_Debug dbg,
     Dwarf_Signed *nbufs, Dwarf_Error * error);
+static int generate_line_and_info(Dwarf_P_Debug dbg,
+    Dwarf_Signed *nbufs, Dwarf_Error * error);
 
 
 #if 0
@@ -364,6 +366,9 @@ dwarf_need_debug_names_section(Dwarf_P_Debug dbg)
     if (!dbg->de_dnames->dn_create_section) {
         return FALSE;
     }
+    if (!dbg->de_dies) {
+        return FALSE;
+    }
     return TRUE;
 }
 
@@ -408,6 +413,25 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Signed *count,
         DWARF_P_DBG_ERROR(dbg, DW_DLE_IA, DW_DLV_ERROR);
     }
 
+    /*  Before anything records DIE pointers or offsets
+        (DW_AT_MIPS_fde, markers, name tables). */
+    if (dbg->de_type_dedup && dbg->de_dies) {
+        Dwarf_Unsigned removed = 0;
+
+        err = _dwarf_pro_dedup_types(dbg,&removed,error);
+        if (err != DW_DLV_OK) {
+            return err;
+        }
+    }
+    /*  After dedup, while only DIE attributes hold
+        string offsets. */
+    if (dbg->de_string_tail_merge) {
+        err = _dwarf_pro_tail_merge_strings(dbg,error);
+        if (err != DW_DLV_OK) {
+            return err;
+        }
+    }
+
     /* Create dwarf section headers */
     for (sect = 0; sect < NUM_DEBUG_SECTIONS; sect++) {
         long flags = 0;
@@ -464,7 +488,10 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Signed *count,
             break;
 
         case DEBUG_STR:
-            if (dbg->de_debug_str->ds_data == NULL) {
+            /*  .debug_names adds its strings to .debug_str
+                once DIE offsets are known. */
+            if (dbg->de_debug_str->ds_data == NULL &&
+                dwarf_need_debug_names_section(dbg) == FALSE) {
                 continue;
             }
             break;
@@ -568,31 +595,8 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Signed *count,
         }
     }
 
-    if (dwarf_need_debug_line_section(dbg) == TRUE) {
-        int res = _dwarf_pro_generate_debugline(dbg,&nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
-        }
-    }
-
-    if (dbg->de_frame_cies) {
-        int res = _dwarf_pro_generate_debugframe(dbg,&nbufs,error);
-        if (res == DW_DLV_ERROR) {
-            return res;
-        }
-    }
-    if (dbg->de_first_macinfo) {
-        /* For DWARF 2,3,4 only */
-        /* Need new code for DWARF5 macro info. FIXME*/
-        int res  = _dwarf_pro_transform_macro_info_to_disk(dbg,
-            &nbufs,error);
-        if (res == DW_DLV_ERROR) {
-            return res;
-        }
-    }
-
-    if (dbg->de_dies) {
-        int res= _dwarf_pro_generate_debuginfo(dbg, &nbufs, error);
+    {
+        int res = generate_line_and_info(dbg,&nbufs,error);
         if (res == DW_DLV_ERROR) {
             return res;
         }
@@ -684,12 +688,6 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Signed *count,
             }
         }
     }
-    if (dwarf_need_debug_names_section(dbg) == TRUE) {
-        int res = _dwarf_pro_generate_debug_names(dbg,&nbufs, error);
-        if (res == DW_DLV_ERROR) {
-            return res;
-        }
-    }
 #if 0  /* FIXME: TODO new sections */
     if (dwarf_need_debug_macro_section(dbg) == TRUE) {
         int res = _dwarf_pro_generate_debug_macro(dbg,&nbufs, error);
@@ -726,6 +724,298 @@ dwarf_transform_to_disk_form_a(Dwarf_P_Debug dbg, Dwarf_Signed *count,
     return DW_DLV_OK;
 }
 
+int
+dwarf_pro_set_job_runner(Dwarf_P_Debug dbg,
+    Dwarf_P_Job_Runner runner,
+    void *user_data,
+    Dwarf_Error * error)
+{
+    if (dbg == NULL) {
+        _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_job_runner = runner;
+    dbg->de_job_runner_data = user_data;
+    return DW_DLV_OK;
+}
+
+/*  .debug_line depends on nothing generated here. */
+static int
+generate_line_group(Dwarf_P_Debug dbg,
+    Dwarf_Signed *nbufs,
+    Dwarf_Error * error)
+{
+    if (dwarf_need_debug_line_section(dbg) == TRUE) {
+        int res = _dwarf_pro_generate_debugline(dbg,nbufs, error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  .debug_frame adds DW_AT_MIPS_fde to DIEs and
+    .debug_macinfo clears de_first_macinfo, both before
+    .debug_info reads them, so the order here matters. */
+static int
+generate_info_group(Dwarf_P_Debug dbg,
+    Dwarf_Signed *nbufs,
+    Dwarf_Error * error)
+{
+    if (dbg->de_frame_cies) {
+        int res = _dwarf_pro_generate_debugframe(dbg,nbufs,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    if (dbg->de_first_macinfo) {
+        /* For DWARF 2,3,4 only */
+        /* Need new code for DWARF5 macro info. FIXME*/
+        int res  = _dwarf_pro_transform_macro_info_to_disk(dbg,
+            nbufs,error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+
+    if (dbg->de_dies) {
+        int res= _dwarf_pro_generate_debuginfo(dbg, nbufs, error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    /*  Needs the DIE offsets and must precede .debug_str. */
+    if (dwarf_need_debug_names_section(dbg) == TRUE) {
+        int res = _dwarf_pro_generate_debug_names(dbg,nbufs, error);
+        if (res == DW_DLV_ERROR) {
+            return res;
+        }
+    }
+    return DW_DLV_OK;
+}
+
+/*  Parallel generation.  The line group runs on a
+    separate Dwarf_P_Debug_s holding only what the line
+    generator reads, plus its own buffer chain and
+    allocation list, while the info group runs on dbg
+    itself.  Neither group touches what the other writes.
+    Afterwards the line buffers are linked in where the
+    serial order would have put them, so the buffers
+    (and the bytes) returned by dwarf_get_section_bytes_a()
+    are the same as without a runner. */
+#define GEN_JOB_LINE  0
+#define GEN_JOB_INFO  1
+#define GEN_JOB_COUNT 2
+
+struct gen_job_s {
+    Dwarf_P_Debug gj_dbg;
+    Dwarf_Signed  gj_nbufs;
+    int           gj_res;
+    Dwarf_Error   gj_error;
+    /*  Null if the caller passed no Dwarf_Error,
+        to get the same error handler behavior. */
+    Dwarf_Error  *gj_errorp;
+};
+
+static void
+run_gen_job(void *job_arg, unsigned index)
+{
+    struct gen_job_s *job = 0;
+
+    if (index >= GEN_JOB_COUNT) {
+        return;
+    }
+    job = (struct gen_job_s *)job_arg + index;
+    if (index == GEN_JOB_LINE) {
+        job->gj_res = generate_line_group(job->gj_dbg,
+            &job->gj_nbufs,job->gj_errorp);
+    } else {
+        job->gj_res = generate_info_group(job->gj_dbg,
+            &job->gj_nbufs,job->gj_errorp);
+    }
+}
+
+/*  Chunks are only shared by consecutive writes to the
+    same elf section number, so the line buffers match
+    the serial ones only if no other section generated
+    around them has the same number. */
+static int
+line_sect_is_distinct(Dwarf_P_Debug dbg)
+{
+    int linesect = dbg->de_elf_sects[DEBUG_LINE];
+    int k = 0;
+
+    for ( ; k < NUM_DEBUG_SECTIONS; ++k) {
+        if (k != DEBUG_LINE && dbg->de_elf_sects[k] == linesect) {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+/*  DW_FORM_strp and DW_FORM_line_strp file and directory
+    names would go into the string pools, which the info
+    group adds to at the same time.  Such a line table is
+    generated serially. */
+static int
+line_uses_string_pools(Dwarf_P_Debug dbg)
+{
+    struct Dwarf_P_Line_Inits_s *inits = &dbg->de_line_inits;
+    unsigned k = 0;
+
+    for (k = 0; k < inits->pi_directory_entry_format_count &&
+        k < DW_LINE_FORMATS_MAX; ++k) {
+        unsigned form = inits->pi_incformats[k].def_form_code;
+
+        if (form == DW_FORM_strp || form == DW_FORM_line_strp) {
+            return TRUE;
+        }
+    }
+    for (k = 0; k < inits->pi_file_entry_format_count &&
+        k < DW_LINE_FORMATS_MAX; ++k) {
+        unsigned form = inits->pi_fileformats[k].def_form_code;
+
+        if (form == DW_FORM_strp || form == DW_FORM_line_strp) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+struct line_job_field_s {
+    size_t lf_offset;
+    size_t lf_size;
+};
+#define LINE_JOB_COPY(f) \
+    { offsetof(struct Dwarf_P_Debug_s,f), \
+    sizeof(((struct Dwarf_P_Debug_s *)0)->f) },
+#define LINE_JOB_ZERO(f)
+static const struct line_job_field_s line_job_fields[] = {
+    PRO_DEBUG_FIELDS(LINE_JOB_COPY,LINE_JOB_ZERO)
+};
+#undef LINE_JOB_COPY
+#undef LINE_JOB_ZERO
+
+/*  Copies into the zeroed linedbg the fields
+    PRO_DEBUG_FIELDS (pro_opaque.h) marks copy(). */
+static void
+init_line_job_dbg(Dwarf_P_Debug linedbg, Dwarf_P_Debug dbg)
+{
+    unsigned k = 0;
+
+    for (k = 0; k < sizeof(line_job_fields)/
+        sizeof(line_job_fields[0]); ++k) {
+        const struct line_job_field_s *f = &line_job_fields[k];
+
+        memcpy((char *)linedbg + f->lf_offset,
+            (char *)dbg + f->lf_offset,f->lf_size);
+    }
+}
+
+static int
+generate_line_and_info_parallel(Dwarf_P_Debug dbg,
+    Dwarf_Signed *nbufs,
+    Dwarf_Error * error)
+{
+    struct gen_job_s jobs[GEN_JOB_COUNT];
+    Dwarf_P_Debug linedbg = 0;
+    Dwarf_P_Section_Data before = dbg->de_current_active_section;
+    Dwarf_P_Section_Data empty = 0;
+    unsigned k = 0;
+
+    linedbg = (Dwarf_P_Debug)
+        _dwarf_p_get_alloc(NULL, sizeof(struct Dwarf_P_Debug_s));
+    if (linedbg == NULL) {
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+    }
+    init_line_job_dbg(linedbg,dbg);
+    empty = (Dwarf_P_Section_Data)
+        _dwarf_p_get_alloc(linedbg,
+        sizeof(struct Dwarf_P_Section_Data_s));
+    if (empty == NULL) {
+        _dwarf_p_alloc_adopt(dbg,linedbg);
+        DWARF_P_DBG_ERROR(dbg, DW_DLE_ALLOC_FAIL, DW_DLV_ERROR);
+    }
+    empty->ds_elf_sect_no = MAGIC_SECT_NO;
+    linedbg->de_debug_sects = empty;
+    linedbg->de_first_debug_sect = empty;
+    linedbg->de_current_active_section = empty;
+    linedbg->de_n_debug_sect = 0;
+
+    memset(jobs,0,sizeof(jobs));
+    jobs[GEN_JOB_LINE].gj_dbg = linedbg;
+    jobs[GEN_JOB_INFO].gj_dbg = dbg;
+    for (k = 0; k < GEN_JOB_COUNT; ++k) {
+        jobs[k].gj_errorp = error? &jobs[k].gj_error : NULL;
+    }
+    dbg->de_job_runner(dbg->de_job_runner_data,GEN_JOB_COUNT,
+        run_gen_job,jobs);
+
+    /*  Join the line results to dbg. */
+    dbg->de_reloc_sect[DEBUG_LINE] = linedbg->de_reloc_sect[DEBUG_LINE];
+    if (linedbg->de_debug_sects != empty) {
+        Dwarf_P_Section_Data first = linedbg->de_debug_sects;
+        Dwarf_P_Section_Data last = linedbg->de_current_active_section;
+
+        if (before->ds_elf_sect_no == MAGIC_SECT_NO) {
+            /*  Nothing was generated before, so the
+                line buffers come first. */
+            if (dbg->de_debug_sects->ds_elf_sect_no == MAGIC_SECT_NO) {
+                dbg->de_current_active_section = last;
+            } else {
+                last->ds_next = dbg->de_debug_sects;
+            }
+            dbg->de_debug_sects = first;
+            dbg->de_first_debug_sect = first;
+        } else {
+            last->ds_next = before->ds_next;
+            before->ds_next = first;
+            if (dbg->de_current_active_section == before) {
+                dbg->de_current_active_section = last;
+            }
+        }
+    }
+    dbg->de_n_debug_sect += linedbg->de_n_debug_sect;
+    _dwarf_p_alloc_adopt(dbg,linedbg);
+
+    /* Report the error the serial order would have hit first. */
+    for (k = 0; k < GEN_JOB_COUNT; ++k) {
+        if (jobs[k].gj_res == DW_DLV_ERROR) {
+            if (error) {
+                *error = jobs[k].gj_error;
+            }
+            return DW_DLV_ERROR;
+        }
+    }
+    *nbufs = dbg->de_n_debug_sect;
+    return DW_DLV_OK;
+}
+
+/*  Generates .debug_line, then .debug_frame, .debug_macinfo,
+    .debug_info and .debug_names, the first concurrently
+    with the rest if the caller gave a job runner. */
+static int
+generate_line_and_info(Dwarf_P_Debug dbg,
+    Dwarf_Signed *nbufs,
+    Dwarf_Error * error)
+{
+    int res = 0;
+
+    if (dbg->de_job_runner &&
+        dwarf_need_debug_line_section(dbg) == TRUE &&
+        (dbg->de_frame_cies || dbg->de_first_macinfo ||
+        dbg->de_dies) &&
+        line_sect_is_distinct(dbg) &&
+        !line_uses_string_pools(dbg)) {
+        return generate_line_and_info_parallel(dbg,nbufs,error);
+    }
+    res = generate_line_group(dbg,nbufs,error);
+    if (res == DW_DLV_ERROR) {
+        return res;
+    }
+    return generate_info_group(dbg,nbufs,error);
+}
+
 static int
 write_fixed_size(Dwarf_Unsigned val,
     Dwarf_P_Debug dbg,
@@ -3551,21 +3841,97 @@ _dwarf_pro_generate_debuginfo(Dwarf_P_Debug dbg,
     return DW_DLV_OK;
 }
 
+struct dnames_str_data_s {
+    Dwarf_P_Debug  dsd_dbg;
+    Dwarf_Error   *dsd_error;
+    int            dsd_reported;
+};
+
+/*  Name strings of the index live in .debug_str. */
+static int
+dnames_debug_str_offset(void *user_data, const char *name,
+    Dwarf_Unsigned *str_offset, int *errnum)
+{
+    struct dnames_str_data_s *sd =
+        (struct dnames_str_data_s *)user_data;
+    int res = 0;
+
+    res = _dwarf_insert_or_find_in_debug_str(sd->dsd_dbg,
+        (char *)name,_dwarf_hash_debug_str,
+        strlen(name)+1,str_offset,sd->dsd_error);
+    if (res != DW_DLV_OK) {
+        sd->dsd_reported = TRUE;
+        *errnum = DW_DLE_DEBUG_NAMES_BUILD_ERROR;
+    }
+    return res;
+}
+
 static int
 _dwarf_pro_generate_debug_names(Dwarf_P_Debug dbg,
-    UNUSEDARG Dwarf_Signed *nbufs,
-    Dwarf_Error * error UNUSEDARG)
+    Dwarf_Signed *nbufs,
+    Dwarf_Error * error)
 {
-#if 0
     int elfsectno_of_debug_names =  dbg->de_elf_sects[DEBUG_NAMES];
-    FIXME: Needs implementation
+    struct Dwarf_P_Dnames_s *dn = dbg->de_dnames;
+    struct dnames_str_data_s strdata;
+    unsigned offset_size = dbg->de_dwarf_offset_size;
+    unsigned extension_size = dbg->de_64bit_extension ? 4 : 0;
+    Dwarf_Small *names = 0;
+    Dwarf_Unsigned names_size = 0;
     unsigned char *data = 0;
+    Dwarf_Unsigned i = 0;
+    int errnum = 0;
+    int res = 0;
 
-    GET_CHUNK(dbg, elfsectno_of_debug_names, data,
-        dbg->de_debug_names->ds_nbytes,
-        error);
-    memcpy(data,dbg->de_debug_names->ds_data,dbg->de_debug_names->ds_nbytes);
-#endif
+    res = _dwarf_pro_dnames_index_dies(dbg,&errnum);
+    if (res == DW_DLV_ERROR) {
+        _dwarf_pro_dnames_destroy(dn);
+        _dwarf_p_error(dbg, error, errnum);
+        return res;
+    }
+    strdata.dsd_dbg = dbg;
+    strdata.dsd_error = error;
+    strdata.dsd_reported = FALSE;
+    res = _dwarf_pro_dnames_serialize(dn,dbg->de_copy_word,
+        offset_size,extension_size,
+        dnames_debug_str_offset,&strdata,
+        &names,&names_size,&errnum);
+    if (res != DW_DLV_OK) {
+        _dwarf_pro_dnames_destroy(dn);
+        if (!strdata.dsd_reported) {
+            _dwarf_p_error(dbg, error, errnum);
+        }
+        return DW_DLV_ERROR;
+    }
+
+    data = _dwarf_pro_buffer(dbg,elfsectno_of_debug_names,
+        names_size);
+    if (!data) {
+        free(names);
+        _dwarf_pro_dnames_destroy(dn);
+        DWARF_P_DBG_ERROR(dbg,DW_DLE_CHUNK_ALLOC,DW_DLV_ERROR);
+    }
+    memcpy(data,names,names_size);
+    free(names);
+
+    /*  The CU offset and the string offsets are
+        section offsets, relocate them. */
+    res = dbg->de_relocate_by_name_symbol(dbg,
+        DEBUG_NAMES, dn->dn_cu_list_offset,
+        dbg->de_sect_name_idx[DEBUG_INFO],
+        dwarf_drt_data_reloc, offset_size);
+    for (i = 0; res == DW_DLV_OK && i < dn->dn_distinct_names; ++i) {
+        res = dbg->de_relocate_by_name_symbol(dbg,
+            DEBUG_NAMES,
+            dn->dn_string_offsets_offset + i*offset_size,
+            dbg->de_sect_name_idx[DEBUG_STR],
+            dwarf_drt_data_reloc, offset_size);
+    }
+    _dwarf_pro_dnames_destroy(dn);
+    if (res != DW_DLV_OK) {
+        _dwarf_p_error(dbg, error, DW_DLE_ALLOC_FAIL);
+        return DW_DLV_ERROR;
+    }
     *nbufs = dbg->de_n_debug_sect;
     return DW_DLV_OK;
 }
@@ -0,0 +1,527 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  String pools for .debug_str and .debug_line_str.
+
+    Each string is stored once, in the section data
+    itself, which grows by doubling like an arena.
+    An open addressing table of (offset, hash, length)
+    finds a string already present without any
+    per-string allocation.
+
+    Optionally (dwarf_pro_set_string_tail_merge())
+    a string that is the tail of another one, such
+    as "count" in "max_count", is dropped and its
+    users pointed into the longer string, as linkers
+    do when merging string sections.  Offsets are
+    handed out as attributes are added, so the merge
+    runs when dwarf_transform_to_disk_form() starts
+    and rewrites the offsets held in DIE attributes.
+    Strings added after that (for the line table header
+    and .debug_names) are appended to the merged
+    section as usual. */
+
+#include "config.h"
+#include "libdwarfdefs.h"
+#include <stdio.h>
+#include <string.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include "pro_incl.h"
+#include <stddef.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "pro_opaque.h"
+#include "pro_error.h"
+#include "pro_alloc.h"
+#include "pro_section.h"
+#include "pro_strpool.h"
+
+#ifndef TRUE
+#define TRUE 1
+#endif /* TRUE */
+#ifndef FALSE
+#define FALSE 0
+#endif /* FALSE */
+
+#define STRTAB_BASE_ALLOC_SIZE 2048
+#define STRPOOL_BASE_SLOTS 256
+
+int
+dwarf_pro_set_string_tail_merge(Dwarf_P_Debug dbg,
+    int enable,
+    Dwarf_Error * error)
+{
+    if (dbg == NULL) {
+        _dwarf_p_error(NULL, error, DW_DLE_DBG_NULL);
+        return DW_DLV_ERROR;
+    }
+    dbg->de_string_tail_merge = enable?1:0;
+    return DW_DLV_OK;
+}
+
+/*  FNV-1a.  slen includes the NUL, which is not hashed. */
+static unsigned
+strpool_hash(const char *name, unsigned slen)
+{
+    const unsigned char *p = (const unsigned char *)name;
+    const unsigned char *end = p + slen - 1;
+    unsigned h = 2166136261U;
+
+    for ( ; p < end; ++p) {
+        h ^= *p;
+        h *= 16777619U;
+    }
+    return h;
+}
+
+static int
+strpool_grow(struct Dwarf_P_Str_Pool_s *pool)
+{
+    Dwarf_Unsigned newsize = pool->sp_size?
+        pool->sp_size*2:STRPOOL_BASE_SLOTS;
+    struct Dwarf_P_Str_Pool_Slot_s *newslots = 0;
+    Dwarf_Unsigned i = 0;
+
+    if (newsize < pool->sp_size ||
+        newsize > ((Dwarf_Unsigned)(size_t)-1)/
+            sizeof(struct Dwarf_P_Str_Pool_Slot_s)) {
+        return DW_DLE_SIZE_WRAPAROUND;
+    }
+    newslots = (struct Dwarf_P_Str_Pool_Slot_s *)
+        calloc(newsize,sizeof(struct Dwarf_P_Str_Pool_Slot_s));
+    if (!newslots) {
+        return DW_DLE_ALLOC_FAIL;
+    }
+    /*  The stored hashes are enough, the strings
+        are not looked at. */
+    for (i = 0; i < pool->sp_size; ++i) {
+        struct Dwarf_P_Str_Pool_Slot_s *old = pool->sp_slots+i;
+        Dwarf_Unsigned j = 0;
+
+        if (!old->sps_offset) {
+            continue;
+        }
+        j = old->sps_hash & (newsize-1);
+        while (newslots[j].sps_offset) {
+            j = (j+1) & (newsize-1);
+        }
+        newslots[j] = *old;
+    }
+    free(pool->sp_slots);
+    pool->sp_slots = newslots;
+    pool->sp_size = newsize;
+    return DW_DLV_OK;
+}
+
+/*  Appends the string to the section data.
+    The GNU linker refuses to commonize strings
+    if the section starts with a NUL byte,
+    so the first string goes at offset 0. */
+static int
+strpool_append(Dwarf_P_Section_Data sd,
+    const char *name,
+    unsigned slen,
+    Dwarf_Unsigned *offset_out)
+{
+    Dwarf_Unsigned need = sd->ds_nbytes + slen;
+
+    if (need < sd->ds_nbytes ||
+        need != (Dwarf_Unsigned)(unsigned long)need) {
+        return DW_DLE_SIZE_WRAPAROUND;
+    }
+    if (!sd->ds_data || need > sd->ds_orig_alloc) {
+        Dwarf_Unsigned newalloc = sd->ds_orig_alloc?
+            sd->ds_orig_alloc:STRTAB_BASE_ALLOC_SIZE;
+        char *newbuf = 0;
+
+        while (newalloc < need) {
+            if (newalloc*2 < newalloc) {
+                return DW_DLE_SIZE_WRAPAROUND;
+            }
+            newalloc *= 2;
+        }
+        if (newalloc != (Dwarf_Unsigned)(size_t)newalloc ||
+            newalloc != (Dwarf_Unsigned)(unsigned long)newalloc) {
+            return DW_DLE_SIZE_WRAPAROUND;
+        }
+        newbuf = (char *)realloc(sd->ds_data,(size_t)newalloc);
+        if (!newbuf) {
+            return DW_DLE_ALLOC_FAIL;
+        }
+        sd->ds_data = newbuf;
+        sd->ds_orig_alloc = newalloc;
+    }
+    memcpy(sd->ds_data + sd->ds_nbytes,name,slen);
+    *offset_out = sd->ds_nbytes;
+    sd->ds_nbytes = need;
+    return DW_DLV_OK;
+}
+
+int
+_dwarf_pro_strpool_insert(Dwarf_P_Debug dbg,
+    struct Dwarf_P_Str_Pool_s *pool,
+    Dwarf_P_Section_Data sd,
+    const char *name,
+    unsigned slen,
+    Dwarf_Unsigned *offset_out,
+    int *found,
+    Dwarf_Error *error)
+{
+    unsigned h = 0;
+    Dwarf_Unsigned mask = 0;
+    Dwarf_Unsigned i = 0;
+    struct Dwarf_P_Str_Pool_Slot_s *slot = 0;
+    Dwarf_Unsigned offset = 0;
+    int res = 0;
+
+    if (!slen) {
+        _dwarf_p_error(dbg, error, DW_DLE_STRING_HASHTAB_IDENTITY_ERROR);
+        return DW_DLV_ERROR;
+    }
+    /*  Keep the table at most half full. */
+    if ((pool->sp_count+1)*2 > pool->sp_size) {
+        res = strpool_grow(pool);
+        if (res != DW_DLV_OK) {
+            _dwarf_p_error(dbg, error, res);
+            return DW_DLV_ERROR;
+        }
+    }
+    h = strpool_hash(name,slen);
+    mask = pool->sp_size-1;
+    for (i = h & mask; ; i = (i+1) & mask) {
+        slot = pool->sp_slots+i;
+        if (!slot->sps_offset) {
+            break;
+        }
+        if (slot->sps_hash == h && slot->sps_len == slen &&
+            !memcmp(sd->ds_data + slot->sps_offset-1,name,slen)) {
+            *offset_out = slot->sps_offset-1;
+            *found = TRUE;
+            return DW_DLV_OK;
+        }
+    }
+    res = strpool_append(sd,name,slen,&offset);
+    if (res != DW_DLV_OK) {
+        _dwarf_p_error(dbg, error, res);
+        return DW_DLV_ERROR;
+    }
+    slot->sps_offset = offset+1;
+    slot->sps_hash = h;
+    slot->sps_len = slen;
+    pool->sp_count++;
+    *offset_out = offset;
+    *found = FALSE;
+    return DW_DLV_OK;
+}
+
+void
+_dwarf_pro_strpool_free(struct Dwarf_P_Str_Pool_s *pool,
+    Dwarf_P_Section_Data sd)
+{
+    free(pool->sp_slots);
+    pool->sp_slots = 0;
+    pool->sp_size = 0;
+    pool->sp_count = 0;
+    if (sd) {
+        free(sd->ds_data);
+        sd->ds_data = 0;
+        sd->ds_nbytes = 0;
+        sd->ds_orig_alloc = 0;
+    }
+}
+
+/*  One distinct string while merging. */
+struct tail_ent_s {
+    Dwarf_Unsigned te_old;
+    Dwarf_Unsigned te_new;
+    /* Points at the terminating NUL. */
+    const unsigned char *te_end;
+    unsigned te_len;
+    /*  The kept string this one is a tail of,
+        or this entry itself. */
+    struct tail_ent_s *te_keep;
+    struct Dwarf_P_Str_Pool_Slot_s *te_slot;
+};
+
+struct tail_map_s {
+    struct tail_ent_s *tm_ents; /* sorted by te_old */
+    Dwarf_Unsigned tm_count;
+};
+
+static int
+tail_old_cmp(const void *l, const void *r)
+{
+    const struct tail_ent_s *a = (const struct tail_ent_s *)l;
+    const struct tail_ent_s *b = (const struct tail_ent_s *)r;
+
+    if (a->te_old < b->te_old) {
+        return -1;
+    }
+    if (a->te_old > b->te_old) {
+        return 1;
+    }
+    return 0;
+}
+
+/*  Compares the strings backwards, last character
+    first, sorting so a string that is the tail of
+    another comes after it, and after every string in
+    between, which all end with it too. */
+static int
+tail_rev_cmp(const void *l, const void *r)
+{
+    const struct tail_ent_s *a = *(struct tail_ent_s *const *)l;
+    const struct tail_ent_s *b = *(struct tail_ent_s *const *)r;
+    const unsigned char *pa = a->te_end;
+    const unsigned char *pb = b->te_end;
+    unsigned la = a->te_len-1;
+    unsigned lb = b->te_len-1;
+
+    for ( ; la && lb; --la, --lb) {
+        --pa;
+        --pb;
+        if (*pa != *pb) {
+            return (*pa > *pb)? -1: 1;
+        }
+    }
+    if (la) {
+        return -1;
+    }
+    if (lb) {
+        return 1;
+    }
+    return tail_old_cmp(a,b);
+}
+
+static int
+tail_merge_section(struct Dwarf_P_Str_Pool_s *pool,
+    Dwarf_P_Section_Data sd,
+    struct tail_map_s *map)
+{
+    struct tail_ent_s *ents = 0;
+    struct tail_ent_s **order = 0;
+    struct tail_ent_s *keep = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Unsigned cursor = 0;
+
+    if (pool->sp_count < 2) {
+        return DW_DLV_NO_ENTRY;
+    }
+    ents = (struct tail_ent_s *)calloc(pool->sp_count,
+        sizeof(struct tail_ent_s));
+    order = (struct tail_ent_s **)calloc(pool->sp_count,
+        sizeof(struct tail_ent_s *));
+    if (!ents || !order) {
+        free(ents);
+        free(order);
+        return DW_DLE_ALLOC_FAIL;
+    }
+    for (i = 0; i < pool->sp_size; ++i) {
+        struct Dwarf_P_Str_Pool_Slot_s *slot = pool->sp_slots+i;
+        struct tail_ent_s *te = 0;
+
+        if (!slot->sps_offset) {
+            continue;
+        }
+        te = ents+count;
+        te->te_old = slot->sps_offset-1;
+        te->te_len = slot->sps_len;
+        te->te_slot = slot;
+        ++count;
+    }
+    qsort(ents,count,sizeof(struct tail_ent_s),tail_old_cmp);
+    for (i = 0; i < count; ++i) {
+        ents[i].te_end = (const unsigned char *)sd->ds_data +
+            ents[i].te_old + ents[i].te_len-1;
+        order[i] = ents+i;
+    }
+    qsort(order,count,sizeof(struct tail_ent_s *),tail_rev_cmp);
+    for (i = 0; i < count; ++i) {
+        struct tail_ent_s *te = order[i];
+
+        if (keep && te->te_len <= keep->te_len &&
+            !memcmp(keep->te_end-(te->te_len-1),
+                te->te_end-(te->te_len-1),te->te_len-1)) {
+            te->te_keep = keep;
+        } else {
+            te->te_keep = te;
+            keep = te;
+        }
+    }
+    free(order);
+
+    /*  Kept strings stay in their original order, each
+        moving down, so compacting in place is safe. */
+    for (i = 0; i < count; ++i) {
+        struct tail_ent_s *te = ents+i;
+
+        if (te->te_keep != te) {
+            continue;
+        }
+        te->te_new = cursor;
+        if (cursor != te->te_old) {
+            memmove(sd->ds_data+cursor,sd->ds_data+te->te_old,
+                te->te_len);
+        }
+        cursor += te->te_len;
+    }
+    for (i = 0; i < count; ++i) {
+        struct tail_ent_s *te = ents+i;
+
+        if (te->te_keep != te) {
+            te->te_new = te->te_keep->te_new +
+                te->te_keep->te_len - te->te_len;
+        }
+        te->te_end = 0;
+        te->te_slot->sps_offset = te->te_new+1;
+    }
+    sd->ds_nbytes = cursor;
+    map->tm_ents = ents;
+    map->tm_count = count;
+    return DW_DLV_OK;
+}
+
+static int
+tail_map_offset(struct tail_map_s *map, Dwarf_Unsigned old,
+    Dwarf_Unsigned *new_out)
+{
+    struct tail_ent_s key;
+    struct tail_ent_s *te = 0;
+
+    if (!map->tm_ents) {
+        *new_out = old;
+        return DW_DLV_OK;
+    }
+    key.te_old = old;
+    te = (struct tail_ent_s *)bsearch(&key,map->tm_ents,
+        map->tm_count,sizeof(struct tail_ent_s),tail_old_cmp);
+    if (!te) {
+        return DW_DLV_ERROR;
+    }
+    *new_out = te->te_new;
+    return DW_DLV_OK;
+}
+
+/* Preorder successor of die in the whole tree. */
+static Dwarf_P_Die
+next_die(Dwarf_P_Die die)
+{
+    if (die->di_child) {
+        return die->di_child;
+    }
+    for ( ; die; die = die->di_parent) {
+        if (die->di_right) {
+            return die->di_right;
+        }
+    }
+    return NULL;
+}
+
+static int
+remap_die_strings(Dwarf_P_Debug dbg,
+    struct tail_map_s *strmap,
+    struct tail_map_s *linestrmap)
+{
+    Dwarf_P_Die die = 0;
+
+    for (die = dbg->de_dies; die; die = next_die(die)) {
+        Dwarf_P_Attribute a = 0;
+
+        for (a = die->di_attrs; a; a = a->ar_next) {
+            struct tail_map_s *map = 0;
+            Dwarf_Unsigned val = 0;
+            Dwarf_Unsigned newval = 0;
+
+            if (a->ar_attribute_form == DW_FORM_strp) {
+                map = strmap;
+            } else if (a->ar_attribute_form == DW_FORM_line_strp) {
+                map = linestrmap;
+            } else {
+                continue;
+            }
+            if (!a->ar_data || !a->ar_nbytes ||
+                a->ar_nbytes > sizeof(val)) {
+                return DW_DLV_ERROR;
+            }
+#ifdef WORDS_BIGENDIAN
+            dbg->de_copy_word(((char *)&val) + sizeof(val) -
+                a->ar_nbytes,a->ar_data,a->ar_nbytes);
+#else
+            dbg->de_copy_word((char *)&val,a->ar_data,a->ar_nbytes);
+#endif
+            if (tail_map_offset(map,val,&newval) != DW_DLV_OK) {
+                return DW_DLV_ERROR;
+            }
+            WRITE_UNALIGNED(dbg, (void *) a->ar_data,
+                (const void *) &newval, sizeof(newval),
+                a->ar_nbytes);
+        }
+    }
+    return DW_DLV_OK;
+}
+
+int
+_dwarf_pro_tail_merge_strings(Dwarf_P_Debug dbg,
+    Dwarf_Error *error)
+{
+    struct tail_map_s strmap;
+    struct tail_map_s linestrmap;
+    int res = 0;
+    int errnum = 0;
+
+    memset(&strmap,0,sizeof(strmap));
+    memset(&linestrmap,0,sizeof(linestrmap));
+    res = tail_merge_section(&dbg->de_debug_str_pool,
+        dbg->de_debug_str,&strmap);
+    if (res != DW_DLV_OK && res != DW_DLV_NO_ENTRY) {
+        errnum = res;
+    }
+    if (!errnum) {
+        res = tail_merge_section(&dbg->de_debug_line_str_pool,
+            dbg->de_debug_line_str,&linestrmap);
+        if (res != DW_DLV_OK && res != DW_DLV_NO_ENTRY) {
+            errnum = res;
+        }
+    }
+    if (!errnum && (strmap.tm_ents || linestrmap.tm_ents)) {
+        res = remap_die_strings(dbg,&strmap,&linestrmap);
+        if (res != DW_DLV_OK) {
+            errnum = DW_DLE_STRING_HASHTAB_IDENTITY_ERROR;
+        }
+    }
+    free(strmap.tm_ents);
+    free(linestrmap.tm_ents);
+    if (errnum) {
+        _dwarf_p_error(dbg, error, errnum);
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
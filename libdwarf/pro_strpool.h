@@ -0,0 +1,51 @@
+/*
+  Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+  This program is free software; you can redistribute it
+  and/or modify it under the terms of version 2.1 of the
+  GNU Lesser General Public License as published by the Free
+  Software Foundation.
+
+  This program is distributed in the hope that it would be
+  useful, but WITHOUT ANY WARRANTY; without even the implied
+  warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+  PURPOSE.
+
+  Further, this software is distributed without any warranty
+  that it is free of the rightful claim of any third person
+  regarding infringement or the like.  Any license provided
+  herein, whether implied or otherwise, applies only to this
+  software file.  Patent licenses, if any, provided herein
+  do not apply to combinations of this program with other
+  software, or any other product whatsoever.
+
+  You should have received a copy of the GNU Lesser General
+  Public License along with this program; if not, write the
+  Free Software Foundation, Inc., 51 Franklin Street - Fifth
+  Floor, Boston MA 02110-1301, USA.
+
+*/
+
+/*  The string pools behind .debug_str and .debug_line_str. */
+
+/*  Returns the offset of the string, adding it to the
+    section data if it is not there yet.  *found is set
+    non-zero if it was already there. */
+int _dwarf_pro_strpool_insert(Dwarf_P_Debug dbg,
+    struct Dwarf_P_Str_Pool_s *pool,
+    Dwarf_P_Section_Data sd,
+    const char *name,
+    unsigned slen, /* includes space for trailing NUL */
+    Dwarf_Unsigned *offset_out,
+    int *found,
+    Dwarf_Error *error);
+
+/*  Suffix merging of both string sections, run by
+    dwarf_transform_to_disk_form() before .debug_info
+    is generated when dwarf_pro_set_string_tail_merge()
+    asked for it. */
+int _dwarf_pro_tail_merge_strings(Dwarf_P_Debug dbg,
+    Dwarf_Error *error);
+
+void _dwarf_pro_strpool_free(struct Dwarf_P_Str_Pool_s *pool,
+    Dwarf_P_Section_Data sd);
@@ -0,0 +1,101 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  See test_consumer.h. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+int test_failcount = 0;
+
+void
+test_check(int cond, const char *msg, int line)
+{
+    if (!cond) {
+        printf("FAIL line %d: %s\n", line, msg);
+        ++test_failcount;
+    }
+}
+
+const char *
+test_fixture_path(int argc, char **argv, int argi, const char *name)
+{
+    static char path[2000];
+    const char *top = getenv("DWTOPSRCDIR");
+
+    if (argc > argi) {
+        snprintf(path, sizeof(path), "%s", argv[argi]);
+    } else if (top && *top) {
+        snprintf(path, sizeof(path), "%s/libdwarf/%s", top, name);
+    } else {
+        snprintf(path, sizeof(path), "%s", name);
+    }
+    return path;
+}
+
+Dwarf_Debug
+test_open_path(const char *path)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_init_path(path, 0, 0, DW_DLC_READ,
+        DW_GROUPNUMBER_ANY, 0, 0, &dbg, 0, 0, 0, &error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL cannot open %s\n", path);
+        exit(1);
+    }
+    return dbg;
+}
+
+Dwarf_Debug
+test_open_fixture(int argc, char **argv, int argi, const char *name)
+{
+    return test_open_path(test_fixture_path(argc, argv, argi, name));
+}
+
+int
+test_report(const char *testname)
+{
+    if (test_failcount) {
+        printf("FAIL %s, %d failures\n", testname, test_failcount);
+        return 1;
+    }
+    printf("PASS %s\n", testname);
+    return 0;
+}
@@ -0,0 +1,64 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+#ifndef TEST_CONSUMER_H
+#define TEST_CONSUMER_H
+
+/*  For the consumer check programs: counting failed
+    checks, finding the fixture objects kept in libdwarf/
+    and reporting the result.  A check program includes
+    dwarf.h and libdwarf.h first. */
+
+extern int test_failcount;
+
+void test_check(int cond, const char *msg, int line);
+#define CHECK(c) test_check((c), #c, __LINE__)
+
+/*  The path of a fixture: argv[argi] if the test was
+    given that argument, else name under
+    $DWTOPSRCDIR/libdwarf, else name in the current
+    directory.  Returns a static buffer the next call
+    overwrites. */
+const char *test_fixture_path(int argc, char **argv, int argi,
+    const char *name);
+
+/*  dwarf_init_path() on path.  Exits, after printing
+    FAIL, if the object cannot be opened. */
+Dwarf_Debug test_open_path(const char *path);
+
+/*  test_open_path(test_fixture_path(...)). */
+Dwarf_Debug test_open_fixture(int argc, char **argv, int argi,
+    const char *name);
+
+/*  Prints PASS or FAIL for testname.  Returns the exit
+    status for main(). */
+int test_report(const char *testname);
+
+#endif /* TEST_CONSUMER_H */
@@ -0,0 +1,247 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Builds a DWARF5 CU with the producer, asks for a
+    .debug_names index, reads the generated sections back
+    through the consumer and looks every name up with
+    dwarf_debugnames_lookup().  Indexed names must find
+    exactly their DIE; members, locals and declarations
+    must not be found.  Done once with DW_FORM_string and
+    once with DW_FORM_strp DW_AT_name.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+
+#define NFUNCS 40
+
+static int failcount = 0;
+
+static void
+check(int cond, const char *msg, int line)
+{
+    if (!cond) {
+        printf("FAIL line %d: %s\n", line, msg);
+        ++failcount;
+    }
+}
+#define CHECK(c) check((c), #c, __LINE__)
+
+static Dwarf_P_Die
+new_die(Dwarf_P_Debug pdbg, Dwarf_Half tag, Dwarf_P_Die parent,
+    const char *name)
+{
+    Dwarf_P_Die die = 0;
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_new_die_a(pdbg, tag, parent, 0, 0, 0, &die,
+        &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_new_die_a\n");
+        exit(1);
+    }
+    if (name && dwarf_add_AT_name_a(die, (char *)name, &attr,
+        &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_add_AT_name_a %s\n", name);
+        exit(1);
+    }
+    return die;
+}
+
+static void
+produce(struct test_prodobj_s *po, int form)
+{
+    Dwarf_P_Debug pdbg = 0;
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die parent = 0;
+    Dwarf_P_Die die = 0;
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Error error = 0;
+    int i = 0;
+
+    if (dwarf_producer_init(DW_DLC_WRITE | DW_DLC_POINTER64 |
+        DW_DLC_OFFSET32 | DW_DLC_SYMBOLIC_RELOCATIONS |
+        DW_DLC_TARGET_LITTLEENDIAN, test_prodobj_callback, 0, 0,
+        po, "x86_64", "V5", 0, &pdbg, &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init\n");
+        exit(1);
+    }
+    CHECK(dwarf_pro_set_default_string_form(pdbg, form,
+        &error) == DW_DLV_OK);
+    CHECK(dwarf_force_debug_names(pdbg, &error) == DW_DLV_OK);
+
+    cu = new_die(pdbg, DW_TAG_compile_unit, 0, "t.c");
+    new_die(pdbg, DW_TAG_base_type, cu, "int");
+    parent = new_die(pdbg, DW_TAG_structure_type, cu, "Point");
+    new_die(pdbg, DW_TAG_member, parent, "not_a_member");
+    parent = new_die(pdbg, DW_TAG_subprogram, cu, "main");
+    new_die(pdbg, DW_TAG_variable, parent, "not_a_local");
+    new_die(pdbg, DW_TAG_variable, cu, "gvar");
+    die = new_die(pdbg, DW_TAG_variable, cu, "not_a_definition");
+    CHECK(dwarf_add_AT_flag_a(pdbg, die, DW_AT_declaration, 1,
+        &attr, &error) == DW_DLV_OK);
+    parent = new_die(pdbg, DW_TAG_namespace, cu, "outer");
+    new_die(pdbg, DW_TAG_class_type, parent, "Widget");
+    for (i = 0; i < NFUNCS; ++i) {
+        char name[32];
+
+        snprintf(name, sizeof(name), "func_%02d", i);
+        new_die(pdbg, DW_TAG_subprogram, cu, name);
+    }
+    CHECK(dwarf_add_die_to_debug_a(pdbg, cu, &error) == DW_DLV_OK);
+    if (dwarf_transform_to_disk_form_a(pdbg, &count, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_transform_to_disk_form_a\n");
+        exit(1);
+    }
+    CHECK(test_prodobj_collect(po, pdbg, count) == DW_DLV_OK);
+    dwarf_producer_finish_a(pdbg, &error);
+}
+
+/*  Expects exactly one match, the DIE with that tag
+    and name. */
+static void
+check_indexed(Dwarf_Debug dbg, Dwarf_Dnames_Head dn,
+    const char *name, Dwarf_Half tag)
+{
+    Dwarf_Dnames_Match *matches = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Half dtag = 0;
+    char *dname = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_debugnames_lookup(dn, name, &matches, &count, &error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL %s not found\n", name);
+        ++failcount;
+        return;
+    }
+    CHECK(count == 1);
+    CHECK(matches[0].dm_tag == tag);
+    CHECK(matches[0].dm_is_type_unit == 0);
+    res = dwarf_offdie_b(dbg, matches[0].dm_die_offset, 1, &die,
+        &error);
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        CHECK(dwarf_tag(die, &dtag, &error) == DW_DLV_OK);
+        CHECK(dtag == tag);
+        CHECK(dwarf_diename(die, &dname, &error) == DW_DLV_OK);
+        CHECK(dname && !strcmp(dname, name));
+        dwarf_dealloc_die(die);
+    }
+    dwarf_dealloc_debugnames_matches(matches);
+}
+
+static void
+check_not_indexed(Dwarf_Dnames_Head dn, const char *name)
+{
+    Dwarf_Dnames_Match *matches = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_debugnames_lookup(dn, name, &matches, &count, &error);
+    CHECK(res == DW_DLV_NO_ENTRY);
+    if (res == DW_DLV_OK) {
+        printf("FAIL %s should not be indexed\n", name);
+        dwarf_dealloc_debugnames_matches(matches);
+    }
+}
+
+static void
+run(int form)
+{
+    struct test_prodobj_s po;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Dnames_Head dn = 0;
+    Dwarf_Unsigned index_count = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+    int i = 0;
+
+    memset(&po, 0, sizeof(po));
+    produce(&po, form);
+    CHECK(test_prodobj_section(&po, ".debug_names", &size) != 0);
+    CHECK(size > 0);
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL cannot read back the producer output\n");
+        exit(1);
+    }
+    if (dwarf_debugnames_header(dbg, &dn, &index_count, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL no .debug_names index read back\n");
+        exit(1);
+    }
+    CHECK(index_count == 1);
+
+    check_indexed(dbg, dn, "int", DW_TAG_base_type);
+    check_indexed(dbg, dn, "Point", DW_TAG_structure_type);
+    check_indexed(dbg, dn, "main", DW_TAG_subprogram);
+    check_indexed(dbg, dn, "gvar", DW_TAG_variable);
+    check_indexed(dbg, dn, "outer", DW_TAG_namespace);
+    check_indexed(dbg, dn, "Widget", DW_TAG_class_type);
+    for (i = 0; i < NFUNCS; ++i) {
+        char name[32];
+
+        snprintf(name, sizeof(name), "func_%02d", i);
+        check_indexed(dbg, dn, name, DW_TAG_subprogram);
+    }
+    check_not_indexed(dn, "t.c");
+    check_not_indexed(dn, "not_a_member");
+    check_not_indexed(dn, "not_a_local");
+    check_not_indexed(dn, "not_a_definition");
+    check_not_indexed(dn, "func_99");
+
+    dwarf_dealloc(dbg, dn, DW_DLA_DNAMES_HEAD);
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+}
+
+int
+main(void)
+{
+    run(DW_FORM_string);
+    run(DW_FORM_strp);
+    if (failcount) {
+        printf("FAIL test_debug_names, %d failures\n", failcount);
+        exit(1);
+    }
+    printf("PASS test_debug_names\n");
+    return 0;
+}
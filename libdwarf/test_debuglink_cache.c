@@ -0,0 +1,503 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Writes small stripped ELF objects, each with only an
+    empty .eh_frame and a .gnu_debuglink and/or a
+    .note.gnu.build-id, into junk_debuglink/ and a copy of
+    testobjO2DW4.elf as their separate debug file.
+    Checks that dwarf_init_path() opens the debug file
+    named by the .gnu_debuglink once it exists, and the
+    object itself before it does and after it is removed.
+    Then, with dwarf_gnu_debuglink_resolve() on the
+    build-id, that the .build-id index sees a
+    subdirectory added, and files removed from and added
+    to a subdirectory already read, by their directory
+    mtimes.  And that a saved cache loads back.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#ifndef _WIN32
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <utime.h>
+#include <fcntl.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif /* HAVE_UNISTD_H */
+#endif /* _WIN32 */
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+#ifndef TRUE
+#define TRUE 1
+#endif /* TRUE */
+#ifndef FALSE
+#define FALSE 0
+#endif /* FALSE */
+
+#ifndef _WIN32
+
+#define DIR_NAME      "junk_debuglink"
+#define BUILDID_DIR   DIR_NAME "/.build-id"
+#define BUILDID_SUB   BUILDID_DIR "/ab"
+#define BUILDID_FILE  BUILDID_SUB \
+    "/cdef0102030405060708090a0b0c0d0e0f1011.debug"
+#define LINK_OBJ      DIR_NAME "/linked"
+#define LINK_NAME     "linked.debug"
+#define LINK_FILE     DIR_NAME "/" LINK_NAME
+#define BUILDID_OBJ   DIR_NAME "/withid"
+#define CACHE_FILE    DIR_NAME "/cache"
+
+/*  Directory mtimes the test sets, so a change
+    never falls in the second of the previous read. */
+#define OLD_TIME  1000000000
+#define NEW_TIME  1100000000
+
+static const unsigned char buildid[20] = {
+    0xab,0xcd,0xef,0x01,0x02,0x03,0x04,0x05,0x06,0x07,
+    0x08,0x09,0x0a,0x0b,0x0c,0x0d,0x0e,0x0f,0x10,0x11 };
+
+struct bytes_s {
+    unsigned char b_data[1024];
+    unsigned      b_len;
+};
+
+static void
+put_byte(struct bytes_s *b, unsigned v)
+{
+    b->b_data[b->b_len++] = (unsigned char)v;
+}
+
+static void
+put_u16(struct bytes_s *b, unsigned v)
+{
+    put_byte(b, v & 0xff);
+    put_byte(b, (v >> 8) & 0xff);
+}
+
+static void
+put_u32(struct bytes_s *b, unsigned v)
+{
+    put_u16(b, v & 0xffff);
+    put_u16(b, (v >> 16) & 0xffff);
+}
+
+static void
+put_u64(struct bytes_s *b, Dwarf_Unsigned v)
+{
+    put_u32(b, (unsigned)(v & 0xffffffff));
+    put_u32(b, (unsigned)(v >> 32));
+}
+
+static void
+put_bytes(struct bytes_s *b, const void *p, unsigned len)
+{
+    memcpy(b->b_data + b->b_len, p, len);
+    b->b_len += len;
+}
+
+static void
+put_align(struct bytes_s *b, unsigned align)
+{
+    while (b->b_len % align) {
+        put_byte(b, 0);
+    }
+}
+
+struct section_s {
+    const char *s_name;
+    unsigned    s_type;
+    unsigned    s_name_offset;
+    unsigned    s_offset;
+    unsigned    s_size;
+};
+
+#define SHT_PROGBITS_ 1
+#define SHT_STRTAB_   3
+#define SHT_NOTE_     7
+
+/*  A little-endian ELF64 x86-64 executable with just the
+    sections a stripped one keeps for debuggers: an empty
+    .eh_frame, which makes libdwarf open it, and the two
+    pointing at the separate debug file. */
+static int
+write_stripped(const char *path, int with_link, int with_buildid)
+{
+    struct bytes_s b;
+    struct section_s sect[5];
+    unsigned count = 0;
+    unsigned shstrtab = 0;
+    unsigned shoff = 0;
+    unsigned i = 0;
+    FILE *f = 0;
+
+    memset(&b, 0, sizeof(b));
+    memset(sect, 0, sizeof(sect));
+    b.b_len = 64;
+    ++count; /* The null section. */
+
+    sect[count].s_name = ".eh_frame";
+    sect[count].s_type = SHT_PROGBITS_;
+    sect[count].s_offset = b.b_len;
+    put_u32(&b, 0);
+    sect[count].s_size = b.b_len - sect[count].s_offset;
+    ++count;
+    if (with_buildid) {
+        put_align(&b, 4);
+        sect[count].s_name = ".note.gnu.build-id";
+        sect[count].s_type = SHT_NOTE_;
+        sect[count].s_offset = b.b_len;
+        put_u32(&b, 4);
+        put_u32(&b, sizeof(buildid));
+        put_u32(&b, 3); /* NT_GNU_BUILD_ID */
+        put_bytes(&b, "GNU", 4);
+        put_bytes(&b, buildid, sizeof(buildid));
+        sect[count].s_size = b.b_len - sect[count].s_offset;
+        ++count;
+    }
+    if (with_link) {
+        put_align(&b, 4);
+        sect[count].s_name = ".gnu_debuglink";
+        sect[count].s_type = SHT_PROGBITS_;
+        sect[count].s_offset = b.b_len;
+        put_bytes(&b, LINK_NAME, sizeof(LINK_NAME));
+        put_align(&b, 4);
+        put_u32(&b, 0); /* The CRC, not checked. */
+        sect[count].s_size = b.b_len - sect[count].s_offset;
+        ++count;
+    }
+    sect[count].s_name = ".shstrtab";
+    sect[count].s_type = SHT_STRTAB_;
+    shstrtab = count;
+    ++count;
+    sect[shstrtab].s_offset = b.b_len;
+    put_byte(&b, 0);
+    for (i = 1; i < count; ++i) {
+        sect[i].s_name_offset = b.b_len - sect[shstrtab].s_offset;
+        put_bytes(&b, sect[i].s_name,
+            (unsigned)strlen(sect[i].s_name) + 1);
+    }
+    sect[shstrtab].s_size = b.b_len - sect[shstrtab].s_offset;
+    put_align(&b, 8);
+    shoff = b.b_len;
+    for (i = 0; i < count; ++i) {
+        put_u32(&b, sect[i].s_name_offset);
+        put_u32(&b, sect[i].s_type);
+        put_u64(&b, 0);  /* flags */
+        put_u64(&b, 0);  /* addr */
+        put_u64(&b, sect[i].s_offset);
+        put_u64(&b, sect[i].s_size);
+        put_u32(&b, 0);  /* link */
+        put_u32(&b, 0);  /* info */
+        put_u64(&b, i?4:0); /* addralign */
+        put_u64(&b, 0);  /* entsize */
+    }
+
+    /*  The ELF header. */
+    i = b.b_len;
+    b.b_len = 0;
+    put_bytes(&b, "\177ELF", 4);
+    put_byte(&b, 2);  /* ELFCLASS64 */
+    put_byte(&b, 1);  /* ELFDATA2LSB */
+    put_byte(&b, 1);  /* EV_CURRENT */
+    while (b.b_len < 16) {
+        put_byte(&b, 0);
+    }
+    put_u16(&b, 2);   /* ET_EXEC */
+    put_u16(&b, 62);  /* EM_X86_64 */
+    put_u32(&b, 1);   /* EV_CURRENT */
+    put_u64(&b, 0);   /* entry */
+    put_u64(&b, 0);   /* phoff */
+    put_u64(&b, shoff);
+    put_u32(&b, 0);   /* flags */
+    put_u16(&b, 64);  /* ehsize */
+    put_u16(&b, 0);   /* phentsize */
+    put_u16(&b, 0);   /* phnum */
+    put_u16(&b, 64);  /* shentsize */
+    put_u16(&b, count);
+    put_u16(&b, shstrtab);
+    b.b_len = i;
+
+    f = fopen(path, "wb");
+    if (!f) {
+        return FALSE;
+    }
+    if (fwrite(b.b_data, 1, b.b_len, f) != b.b_len) {
+        fclose(f);
+        return FALSE;
+    }
+    return !fclose(f);
+}
+
+static int
+copy_file(const char *from, const char *to)
+{
+    char buf[4096];
+    FILE *in = 0;
+    FILE *out = 0;
+    size_t n = 0;
+    int ok = TRUE;
+
+    in = fopen(from, "rb");
+    if (!in) {
+        return FALSE;
+    }
+    out = fopen(to, "wb");
+    if (!out) {
+        fclose(in);
+        return FALSE;
+    }
+    while ((n = fread(buf, 1, sizeof(buf), in)) > 0) {
+        if (fwrite(buf, 1, n, out) != n) {
+            ok = FALSE;
+            break;
+        }
+    }
+    fclose(in);
+    if (fclose(out)) {
+        ok = FALSE;
+    }
+    return ok;
+}
+
+static void
+set_mtime(const char *path, time_t t)
+{
+    struct utimbuf ut;
+
+    ut.actime = t;
+    ut.modtime = t;
+    CHECK(!utime(path, &ut));
+}
+
+static void
+clean_dir(void)
+{
+    unlink(BUILDID_FILE);
+    rmdir(BUILDID_SUB);
+    rmdir(BUILDID_DIR);
+    unlink(LINK_OBJ);
+    unlink(LINK_FILE);
+    unlink(BUILDID_OBJ);
+    unlink(CACHE_FILE);
+    rmdir(DIR_NAME);
+}
+
+static int
+ends_with(const char *s, const char *suffix)
+{
+    size_t slen = strlen(s);
+    size_t sufflen = strlen(suffix);
+
+    return slen >= sufflen && !strcmp(s + slen - sufflen, suffix);
+}
+
+/*  Opens path with dwarf_init_path(), which must give
+    a Dwarf_Debug for a file whose name ends in expect,
+    with DWARF (a CU) only if expect_cu. */
+static void
+check_init_path(const char *path, const char *expect,
+    int expect_cu)
+{
+    char true_path[2000];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    true_path[0] = 0;
+    res = dwarf_init_path(path, true_path, sizeof(true_path),
+        DW_DLC_READ, DW_GROUPNUMBER_ANY, 0, 0, &dbg, 0, 0, 0, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    if (!ends_with(true_path, expect)) {
+        printf("FAIL %s opened as %s, expected ...%s\n", path,
+            true_path, expect);
+        ++test_failcount;
+    }
+    res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, &error);
+    CHECK(res == (expect_cu? DW_DLV_OK : DW_DLV_NO_ENTRY));
+    dwarf_finish(dbg, &error);
+}
+
+/*  dwarf_gnu_debuglink_resolve() on BUILDID_OBJ, which has
+    no usable path so only its build-id is used, with
+    DIR_NAME as the global path. */
+static int
+resolve_buildid(char **path_out)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int fd = -1;
+    int res = 0;
+
+    *path_out = 0;
+    fd = open(BUILDID_OBJ, O_RDONLY);
+    CHECK(fd >= 0);
+    if (fd < 0) {
+        return DW_DLV_ERROR;
+    }
+    res = dwarf_init_b(fd, DW_DLC_READ, DW_GROUPNUMBER_ANY, 0, 0,
+        &dbg, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        close(fd);
+        return res;
+    }
+    res = dwarf_add_debuglink_global_path(dbg, DIR_NAME, &error);
+    CHECK(res == DW_DLV_OK);
+    res = dwarf_gnu_debuglink_resolve(dbg, path_out, &error);
+    if (res == DW_DLV_ERROR) {
+        printf("FAIL resolve: %s\n", dwarf_errmsg(error));
+        ++test_failcount;
+        dwarf_dealloc_error(dbg, error);
+    }
+    dwarf_finish(dbg, &error);
+    close(fd);
+    return res;
+}
+
+static void
+expect_buildid(const char *what, int expect_res)
+{
+    char *path = 0;
+    int res = 0;
+
+    res = resolve_buildid(&path);
+    if (res != expect_res ||
+        (res == DW_DLV_OK && !ends_with(path, BUILDID_FILE))) {
+        printf("FAIL %s: res %d path %s, expected res %d\n", what,
+            res, path? path : "none", expect_res);
+        ++test_failcount;
+    }
+    free(path);
+}
+
+static void
+check_link(const char *fixture)
+{
+    CHECK(write_stripped(LINK_OBJ, TRUE, FALSE));
+    check_init_path(LINK_OBJ, "/linked", FALSE);
+    /*  A link not found is not remembered. */
+    CHECK(copy_file(fixture, LINK_FILE));
+    check_init_path(LINK_OBJ, "/" LINK_NAME, TRUE);
+    check_init_path(LINK_OBJ, "/" LINK_NAME, TRUE);
+    /*  Nor one found once that is gone. */
+    CHECK(!unlink(LINK_FILE));
+    check_init_path(LINK_OBJ, "/linked", FALSE);
+    /*  The debug file itself opens as itself. */
+    CHECK(copy_file(fixture, LINK_FILE));
+    check_init_path(LINK_FILE, "/" LINK_NAME, TRUE);
+}
+
+static void
+check_buildid(const char *fixture)
+{
+    int errcode = 0;
+
+    CHECK(write_stripped(BUILDID_OBJ, FALSE, TRUE));
+    expect_buildid("no .build-id", DW_DLV_NO_ENTRY);
+
+    CHECK(!mkdir(BUILDID_DIR, 0755));
+    set_mtime(BUILDID_DIR, OLD_TIME);
+    expect_buildid("empty .build-id", DW_DLV_NO_ENTRY);
+
+    /*  A new subdirectory changes .build-id. */
+    CHECK(!mkdir(BUILDID_SUB, 0755));
+    CHECK(copy_file(fixture, BUILDID_FILE));
+    set_mtime(BUILDID_SUB, OLD_TIME);
+    set_mtime(BUILDID_DIR, NEW_TIME);
+    expect_buildid("new subdirectory", DW_DLV_OK);
+
+    /*  Files gone from, or back in, a subdirectory
+        change only that. */
+    CHECK(!unlink(BUILDID_FILE));
+    set_mtime(BUILDID_SUB, NEW_TIME);
+    expect_buildid("file removed", DW_DLV_NO_ENTRY);
+    CHECK(copy_file(fixture, BUILDID_FILE));
+    set_mtime(BUILDID_SUB, OLD_TIME);
+    expect_buildid("file added", DW_DLV_OK);
+    expect_buildid("nothing changed", DW_DLV_OK);
+
+    /*  A saved cache loads back, and its subdirectories
+        are read again on first use. */
+    CHECK(dwarf_debuglink_cache_save(CACHE_FILE, &errcode) ==
+        DW_DLV_OK);
+    dwarf_debuglink_cache_clear();
+    CHECK(dwarf_debuglink_cache_load(CACHE_FILE, &errcode) ==
+        DW_DLV_OK);
+    expect_buildid("loaded cache", DW_DLV_OK);
+    dwarf_debuglink_cache_clear();
+    CHECK(dwarf_debuglink_cache_load(CACHE_FILE, &errcode) ==
+        DW_DLV_OK);
+    CHECK(!unlink(BUILDID_FILE));
+    set_mtime(BUILDID_SUB, NEW_TIME);
+    expect_buildid("loaded cache, file removed", DW_DLV_NO_ENTRY);
+    dwarf_debuglink_cache_clear();
+}
+
+int
+main(int argc, char **argv)
+{
+    char fixture[2000];
+    const char *fp = 0;
+
+    fp = test_fixture_path(argc, argv, 1, "testobjO2DW4.elf");
+    if (strlen(fp) >= sizeof(fixture)) {
+        printf("FAIL fixture path too long\n");
+        return 1;
+    }
+    strcpy(fixture, fp);
+    clean_dir();
+    if (mkdir(DIR_NAME, 0755)) {
+        printf("FAIL cannot create " DIR_NAME "\n");
+        return 1;
+    }
+    check_link(fixture);
+    check_buildid(fixture);
+    clean_dir();
+    return test_report("test_debuglink_cache");
+}
+
+#else /* _WIN32 */
+
+int
+main(void)
+{
+    /*  No .build-id trees or directory mtimes here. */
+    return test_report("test_debuglink_cache");
+}
+#endif /* _WIN32 */
@@ -0,0 +1,240 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Writes a .debug_names sidecar for a copy of
+    testobjO2DW4.elf (which has no .debug_names) and
+    checks that dwarf_debugnames_header() ignores it
+    until dwarf_debugnames_use_sidecar() is called, that
+    lookups then work, and that sidecar string offsets
+    are not handed out as .debug_str offsets.  A copy
+    whose .debug_str differs in one byte, so every
+    section keeps its size, must find the sidecar stale,
+    as must testobjO2DW5.elf.  The copies are written
+    to the current directory.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+#define COPY     "test_dnames_sidecar.elf"
+#define SIDECAR  "test_dnames_sidecar.elf.dnames"
+#define STALE    "test_dnames_sidecar_stale.elf"
+
+/*  Reads path into a malloc'd buffer. */
+static unsigned char *
+read_file(const char *path, size_t *size_out)
+{
+    FILE *f = fopen(path, "rb");
+    unsigned char *data = 0;
+    long size = 0;
+
+    if (!f || fseek(f, 0, SEEK_END) || (size = ftell(f)) <= 0 ||
+        fseek(f, 0, SEEK_SET)) {
+        printf("FAIL cannot read %s\n", path);
+        exit(1);
+    }
+    data = (unsigned char *)malloc((size_t)size);
+    if (!data || fread(data, 1, (size_t)size, f) != (size_t)size) {
+        printf("FAIL cannot read %s\n", path);
+        exit(1);
+    }
+    fclose(f);
+    *size_out = (size_t)size;
+    return data;
+}
+
+static void
+write_file(const char *path, const unsigned char *data, size_t size)
+{
+    FILE *f = fopen(path, "wb");
+
+    if (!f || fwrite(data, 1, size, f) != size || fclose(f)) {
+        printf("FAIL cannot write %s\n", path);
+        exit(1);
+    }
+}
+
+/*  Turns the -O2 in the DW_AT_producer string, which is
+    only in .debug_str, into -O3. */
+static int
+change_producer(unsigned char *data, size_t size)
+{
+    const char *key = "-O2 -fasynchronous-unwind-tables";
+    size_t keylen = strlen(key);
+    size_t i = 0;
+
+    for (i = 0; i + keylen <= size; ++i) {
+        if (!memcmp(data + i, key, keylen)) {
+            data[i + 2] = '3';
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static Dwarf_Unsigned
+section_size(Dwarf_Debug dbg, const char *name)
+{
+    Dwarf_Addr addr = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_get_section_info_by_name(dbg, name, &addr, &size,
+        &error) == DW_DLV_OK);
+    return size;
+}
+
+/*  The sidecar in use: lookups find the DIE and names
+    come from its string area. */
+static void
+check_lookup(Dwarf_Debug dbg)
+{
+    Dwarf_Dnames_Head dn = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Dnames_Match *matches = 0;
+    Dwarf_Unsigned nmatches = 0;
+    Dwarf_Unsigned stroff = 0;
+    const char *name = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_debugnames_header(dbg, &dn, &count, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    CHECK(count == 1);
+    CHECK(dwarf_debugnames_lookup(dn, "main", &matches, &nmatches,
+        &error) == DW_DLV_OK);
+    CHECK(nmatches == 1);
+    if (nmatches == 1) {
+        Dwarf_Die die = 0;
+        char *diename = 0;
+
+        CHECK(matches[0].dm_tag == DW_TAG_subprogram);
+        CHECK(dwarf_offdie_b(dbg, matches[0].dm_die_offset, 1, &die,
+            &error) == DW_DLV_OK);
+        CHECK(dwarf_diename(die, &diename, &error) == DW_DLV_OK);
+        CHECK(diename && !strcmp(diename, "main"));
+        dwarf_dealloc_die(die);
+    }
+    dwarf_dealloc_debugnames_matches(matches);
+    CHECK(dwarf_debugnames_lookup(dn, "no_such_name", &matches,
+        &nmatches, &error) == DW_DLV_NO_ENTRY);
+
+    CHECK(dwarf_debugnames_name_string(dn, 0, 1, &name, &error) ==
+        DW_DLV_OK);
+    CHECK(name && name[0]);
+    /*  Not a .debug_str offset, so not returned. */
+    res = dwarf_debugnames_name(dn, 0, 1, 0, 0, &stroff, 0, &error);
+    CHECK(res == DW_DLV_ERROR);
+    if (res == DW_DLV_ERROR) {
+        CHECK(dwarf_errno(error) == DW_DLE_DEBUG_NAMES_SIDECAR_ERROR);
+        dwarf_dealloc_error(dbg, error);
+        error = 0;
+    }
+    CHECK(dwarf_debugnames_name(dn, 0, 1, 0, 0, 0, 0, &error) ==
+        DW_DLV_OK);
+    dwarf_dealloc(dbg, dn, DW_DLA_DNAMES_HEAD);
+}
+
+static void
+check_stale(Dwarf_Debug dbg)
+{
+    Dwarf_Dnames_Head dn = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_debugnames_use_sidecar(dbg, SIDECAR, &error) ==
+        DW_DLV_NO_ENTRY);
+    CHECK(dwarf_debugnames_header(dbg, &dn, &count, &error) ==
+        DW_DLV_NO_ENTRY);
+}
+
+int
+main(int argc, char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Debug stale = 0;
+    Dwarf_Dnames_Head dn = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+    unsigned char *data = 0;
+    size_t size = 0;
+
+    data = read_file(test_fixture_path(argc, argv, 1,
+        "testobjO2DW4.elf"), &size);
+    write_file(COPY, data, size);
+    CHECK(change_producer(data, size));
+    write_file(STALE, data, size);
+    free(data);
+
+    dbg = test_open_path(COPY);
+    CHECK(dwarf_debugnames_write_sidecar(dbg, 0, &count, &error) ==
+        DW_DLV_OK);
+    CHECK(count > 5);
+    dwarf_finish(dbg, &error);
+
+    /*  Not read unless asked for. */
+    dbg = test_open_path(COPY);
+    CHECK(dwarf_debugnames_header(dbg, &dn, &count, &error) ==
+        DW_DLV_NO_ENTRY);
+    CHECK(dwarf_debugnames_use_sidecar(dbg, 0, &error) == DW_DLV_OK);
+    check_lookup(dbg);
+    /*  A second call keeps the sidecar. */
+    CHECK(dwarf_debugnames_use_sidecar(dbg, "no_such_file",
+        &error) == DW_DLV_OK);
+    check_lookup(dbg);
+
+    /*  Same section sizes, other DWARF. */
+    stale = test_open_path(STALE);
+    CHECK(section_size(dbg, ".debug_info") ==
+        section_size(stale, ".debug_info"));
+    CHECK(section_size(dbg, ".debug_str") ==
+        section_size(stale, ".debug_str"));
+    check_stale(stale);
+    dwarf_finish(stale, &error);
+    dwarf_finish(dbg, &error);
+
+    stale = test_open_fixture(argc, argv, 2, "testobjO2DW5.elf");
+    check_stale(stale);
+    dwarf_finish(stale, &error);
+
+    remove(SIDECAR);
+    remove(COPY);
+    remove(STALE);
+    return test_report("test_dnames_sidecar");
+}
@@ -0,0 +1,224 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Opens testobjsplit.elf, whose three skeleton units
+    name testobjsplit1.dwo through testobjsplit3.dwo,
+    with a session limited to one open .dwo.  A .dwo
+    returned by a lookup must stay open and readable
+    while held, even when later lookups would otherwise
+    close it to stay within the limit, and be closed
+    only once released. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+/*  Opens the executable and sets dir to the directory
+    holding it and its .dwo files. */
+static Dwarf_Debug
+open_fixture(int argc, char **argv, char *dir, size_t dirlen)
+{
+    const char *path = test_fixture_path(argc, argv, 1,
+        "testobjsplit.elf");
+    char *slash = 0;
+
+    snprintf(dir, dirlen, "%s", path);
+    slash = strrchr(dir, '/');
+    if (slash) {
+        *slash = 0;
+    } else {
+        snprintf(dir, dirlen, ".");
+    }
+    return test_open_path(path);
+}
+
+/*  The split unit at cu_off of dwo must define the
+    function expected, its DW_AT_low_pc read through
+    the executable it is tied to. */
+static void
+check_function(Dwarf_Debug dwo, Dwarf_Off cu_off,
+    const char *expected, int line)
+{
+    Dwarf_Die cu_die = 0;
+    Dwarf_Die child = 0;
+    Dwarf_Error error = 0;
+    int found = 0;
+
+    if (dwarf_offdie_b(dwo, cu_off, 1, &cu_die, &error) !=
+        DW_DLV_OK) {
+        test_check(0, "dwarf_offdie_b", line);
+        return;
+    }
+    if (dwarf_child(cu_die, &child, &error) != DW_DLV_OK) {
+        child = 0;
+    }
+    while (child) {
+        Dwarf_Die sib = 0;
+        Dwarf_Addr low = 0;
+        char *name = 0;
+
+        if (dwarf_diename(child, &name, &error) == DW_DLV_OK &&
+            !strcmp(name, expected) &&
+            dwarf_lowpc(child, &low, &error) == DW_DLV_OK &&
+            low) {
+            found = 1;
+        }
+        if (dwarf_siblingof_b(dwo, child, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            sib = 0;
+        }
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    test_check(found, expected, line);
+    dwarf_dealloc_die(cu_die);
+}
+
+/*  Looks up skeleton unit index by its offset and
+    checks its .dwo. */
+static Dwarf_Debug
+lookup(Dwarf_Dwo_Session session, Dwarf_Unsigned index,
+    Dwarf_Off *cu_off, const char *expected, int line)
+{
+    Dwarf_Off skeleton = 0;
+    Dwarf_Debug dwo = 0;
+    Dwarf_Error error = 0;
+
+    test_check(dwarf_dwo_session_unit(session, index, &skeleton,
+        0, 0, 0, 0, 0, &error) == DW_DLV_OK,
+        "dwarf_dwo_session_unit", line);
+    if (dwarf_dwo_session_by_skeleton(session, skeleton, &dwo,
+        cu_off, &error) != DW_DLV_OK) {
+        printf("FAIL cannot open the .dwo of unit %u\n",
+            (unsigned)index);
+        exit(1);
+    }
+    check_function(dwo, *cu_off, expected, line);
+    return dwo;
+}
+#define LOOKUP(i,o,e) lookup(session, (i), (o), (e), __LINE__)
+#define READABLE(d,o,e) check_function((d), (o), (e), __LINE__)
+
+static void
+stats(Dwarf_Dwo_Session session, Dwarf_Unsigned open_now,
+    Dwarf_Unsigned opens, Dwarf_Unsigned evictions, int line)
+{
+    Dwarf_Unsigned o = 0;
+    Dwarf_Unsigned n = 0;
+    Dwarf_Unsigned e = 0;
+    Dwarf_Error error = 0;
+
+    test_check(dwarf_dwo_session_stats(session, &o, &n, &e,
+        &error) == DW_DLV_OK, "dwarf_dwo_session_stats", line);
+    test_check(o == open_now, "open_now", line);
+    test_check(n == opens, "opens", line);
+    test_check(e == evictions, "evictions", line);
+}
+#define STATS(o,n,e) stats(session, (o), (n), (e), __LINE__)
+
+int
+main(int argc, char **argv)
+{
+    char dir[2000];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Dwo_Session session = 0;
+    Dwarf_Debug dwo1 = 0;
+    Dwarf_Debug dwo2 = 0;
+    Dwarf_Debug dwo3 = 0;
+    Dwarf_Off off1 = 0;
+    Dwarf_Off off2 = 0;
+    Dwarf_Off off3 = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Bool is_open = 0;
+    Dwarf_Error error = 0;
+
+    dbg = open_fixture(argc, argv, dir, sizeof(dir));
+    if (dwarf_dwo_session_create(dbg, dir, 1, &session, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_dwo_session_create\n");
+        exit(1);
+    }
+    CHECK(dwarf_dwo_session_unit_count(session, &count, &error) ==
+        DW_DLV_OK);
+    CHECK(count == 3);
+
+    /*  Held, so the second lookup cannot close it and
+        two are open despite the limit of one. */
+    dwo1 = LOOKUP(0, &off1, "main");
+    dwo2 = LOOKUP(1, &off2, "part2");
+    STATS(2, 2, 0);
+    READABLE(dwo1, off1, "main");
+
+    /*  A second hold on the same .dwo. */
+    CHECK(LOOKUP(0, &off1, "main") == dwo1);
+    STATS(2, 2, 0);
+
+    /*  Releasing dwo2 brings the session back to
+        its limit. */
+    CHECK(dwarf_dwo_session_release(session, dwo2, &error) ==
+        DW_DLV_OK);
+    STATS(1, 2, 1);
+    CHECK(dwarf_dwo_session_unit(session, 1, 0, 0, 0, 0, 0,
+        &is_open, &error) == DW_DLV_OK);
+    CHECK(!is_open);
+    CHECK(dwarf_dwo_session_release(session, dwo2, &error) ==
+        DW_DLV_NO_ENTRY);
+
+    /*  dwo1 is held twice: one release leaves it open. */
+    CHECK(dwarf_dwo_session_release(session, dwo1, &error) ==
+        DW_DLV_OK);
+    dwo3 = LOOKUP(2, &off3, "part3");
+    STATS(2, 3, 1);
+    READABLE(dwo1, off1, "main");
+
+    /*  Now unheld, dwo1 is closed for the next open. */
+    CHECK(dwarf_dwo_session_release(session, dwo1, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_dwo_session_release(session, dwo3, &error) ==
+        DW_DLV_OK);
+    STATS(1, 3, 2);
+    CHECK(dwarf_dwo_session_release(session, dwo1, &error) ==
+        DW_DLV_NO_ENTRY);
+    CHECK(dwarf_dwo_session_release(session, dbg, &error) ==
+        DW_DLV_NO_ENTRY);
+    dwo2 = LOOKUP(1, &off2, "part2");
+    STATS(1, 4, 3);
+
+    /*  dealloc closes a .dwo even if held. */
+    dwarf_dwo_session_dealloc(session);
+    dwarf_finish(dbg, &error);
+    return test_report("test_dwo_session");
+}
@@ -0,0 +1,684 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Checks dwarf_expr_compile() and dwarf_expr_evaluate()
+    on expressions given as bytes (through
+    dwarf_loclist_from_expr_c(), so never cached).  That
+    reads only from a loaded section, so each expression is
+    copied into the DW_AT_location of a hand-built CU first.
+    Covered are arithmetic and stack operators, DW_OP_bra
+    and DW_OP_skip forwards, backwards and to the end, the
+    register, memory, frame base, CFA and object address
+    callbacks, a failing and a missing callback, stack
+    errors and the step limit on an endless loop.
+    Then, on testobjO2DW4.elf, that compiling the
+    expression of a DIE's location again, even from a
+    new loclist head, returns the cached program. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+#include "test_consumer.h"
+
+#define ALL_ONES (~(Dwarf_Unsigned)0)
+
+/*  What the callbacks were asked for, and how
+    they answer. */
+struct target_s {
+    int            tg_fail;
+    unsigned       tg_register_reads;
+    Dwarf_Unsigned tg_last_regnum;
+    unsigned       tg_memory_reads;
+    Dwarf_Addr     tg_last_addr;
+    Dwarf_Unsigned tg_last_size;
+};
+
+#define REG_BASE    0x1000
+#define MEMORY_XOR  0x5a5a
+#define FRAME_BASE  0x7000
+#define CFA         0x8000
+#define OBJECT_ADDR 0x9000
+
+static int
+read_register(void *user_data, Dwarf_Unsigned regnum,
+    Dwarf_Unsigned *value_out)
+{
+    struct target_s *t = (struct target_s *)user_data;
+
+    ++t->tg_register_reads;
+    t->tg_last_regnum = regnum;
+    if (t->tg_fail) {
+        return DW_DLV_ERROR;
+    }
+    *value_out = REG_BASE + regnum;
+    return DW_DLV_OK;
+}
+
+static int
+read_memory(void *user_data, Dwarf_Addr addr, Dwarf_Unsigned size,
+    Dwarf_Unsigned *value_out)
+{
+    struct target_s *t = (struct target_s *)user_data;
+
+    ++t->tg_memory_reads;
+    t->tg_last_addr = addr;
+    t->tg_last_size = size;
+    if (t->tg_fail) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *value_out = addr ^ MEMORY_XOR;
+    return DW_DLV_OK;
+}
+
+static int
+frame_base(void *user_data, Dwarf_Unsigned *value_out)
+{
+    (void)user_data;
+    *value_out = FRAME_BASE;
+    return DW_DLV_OK;
+}
+
+static int
+call_frame_cfa(void *user_data, Dwarf_Unsigned *value_out)
+{
+    (void)user_data;
+    *value_out = CFA;
+    return DW_DLV_OK;
+}
+
+static int
+object_address(void *user_data, Dwarf_Unsigned *value_out)
+{
+    (void)user_data;
+    *value_out = OBJECT_ADDR;
+    return DW_DLV_OK;
+}
+
+struct bytes_s {
+    unsigned char b_data[256];
+    unsigned      b_len;
+};
+
+static void
+put_byte(struct bytes_s *b, unsigned v)
+{
+    b->b_data[b->b_len++] = (unsigned char)v;
+}
+
+static void
+put_u16(struct bytes_s *b, unsigned v)
+{
+    put_byte(b, v & 0xff);
+    put_byte(b, (v >> 8) & 0xff);
+}
+
+static void
+put_u32(struct bytes_s *b, unsigned v)
+{
+    put_u16(b, v & 0xffff);
+    put_u16(b, (v >> 16) & 0xffff);
+}
+
+/*  Room for the longest expression below. */
+#define SCRATCH_LEN 64
+
+/*  A DWARF4 CU whose one DIE has a DW_AT_location of
+    SCRATCH_LEN DW_OP_nop.  *scratch_off is where those
+    start in .debug_info. */
+static void
+put_scratch_cu(struct bytes_s *info, struct bytes_s *abbrev,
+    unsigned *scratch_off)
+{
+    unsigned i = 0;
+
+    put_byte(abbrev, 1);
+    put_byte(abbrev, DW_TAG_compile_unit);
+    put_byte(abbrev, DW_CHILDREN_no);
+    put_byte(abbrev, DW_AT_location);
+    put_byte(abbrev, DW_FORM_exprloc);
+    put_byte(abbrev, 0);
+    put_byte(abbrev, 0);
+    put_byte(abbrev, 0);
+
+    put_u32(info, 0);
+    put_u16(info, 4);
+    put_u32(info, 0);
+    put_byte(info, 8);
+    put_byte(info, 1);
+    put_byte(info, SCRATCH_LEN);
+    *scratch_off = info->b_len;
+    for (i = 0; i < SCRATCH_LEN; ++i) {
+        put_byte(info, DW_OP_nop);
+    }
+    i = info->b_len;
+    info->b_len = 0;
+    put_u32(info, i - 4);
+    info->b_len = i;
+}
+
+/*  The scratch DW_OP_nop in the section data the
+    Dwarf_Debug reads. */
+static Dwarf_Small *scratch;
+
+static struct target_s target;
+/*  What dwarf_loclist_from_expr_c() is told. */
+static Dwarf_Half address_size = 8;
+static Dwarf_Expr_Callbacks callbacks;
+
+/*  DW_OP_implicit_value data belongs to the program,
+    evaluate() copies it here before freeing that. */
+static Dwarf_Small implicit_copy[32];
+
+/*  Compiles and evaluates the expression in bytes,
+    returning the result of whichever fails first, or
+    of the evaluation.  On error *errnum is the error
+    number. */
+static int
+evaluate(Dwarf_Debug dbg, const Dwarf_Small *bytes,
+    Dwarf_Unsigned len, const Dwarf_Expr_Callbacks *cb,
+    Dwarf_Expr_Result *result, Dwarf_Unsigned *errnum)
+{
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Unsigned listlen = 0;
+    Dwarf_Small lle = 0;
+    Dwarf_Unsigned rawlow = 0;
+    Dwarf_Unsigned rawhigh = 0;
+    Dwarf_Bool unavailable = 0;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Unsigned opcount = 0;
+    Dwarf_Locdesc_c locdesc = 0;
+    Dwarf_Small source = 0;
+    Dwarf_Unsigned exproff = 0;
+    Dwarf_Unsigned locdescoff = 0;
+    Dwarf_Expr_Program program = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    *errnum = 0;
+    memset(result, 0, sizeof(*result));
+    if (len > SCRATCH_LEN) {
+        printf("FAIL expression of %u bytes\n", (unsigned)len);
+        ++test_failcount;
+        return DW_DLV_ERROR;
+    }
+    memcpy(scratch, bytes, len);
+    res = dwarf_loclist_from_expr_c(dbg, scratch, len,
+        address_size, 4, 4, &head, &listlen, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_get_locdesc_entry_d(head, 0, &lle, &rawlow, &rawhigh,
+        &unavailable, &low, &high, &opcount, &locdesc, &source,
+        &exproff, &locdescoff, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        res = dwarf_expr_compile(locdesc, &program, &error);
+    }
+    if (res == DW_DLV_OK) {
+        res = dwarf_expr_evaluate(program, cb, result, &error);
+        if (res == DW_DLV_OK &&
+            result->er_kind == DW_EXPR_RESULT_IMPLICIT &&
+            result->er_implicit_length <= sizeof(implicit_copy)) {
+            memcpy(implicit_copy, result->er_implicit_data,
+                result->er_implicit_length);
+            result->er_implicit_data = implicit_copy;
+        }
+        dwarf_expr_program_dealloc(program);
+    }
+    if (res == DW_DLV_ERROR) {
+        *errnum = dwarf_errno(error);
+        dwarf_dealloc(dbg, error, DW_DLA_ERROR);
+    }
+    dwarf_loc_head_c_dealloc(head);
+    return res;
+}
+
+/*  The expression must evaluate to kind and value. */
+static void
+expect_value(Dwarf_Debug dbg, const char *what,
+    const Dwarf_Small *bytes, Dwarf_Unsigned len,
+    int kind, Dwarf_Unsigned value)
+{
+    Dwarf_Expr_Result result;
+    Dwarf_Unsigned errnum = 0;
+    int res = 0;
+
+    res = evaluate(dbg, bytes, len, &callbacks, &result, &errnum);
+    if (res != DW_DLV_OK || result.er_kind != kind ||
+        result.er_value != value) {
+        printf("FAIL %s: res %d error %llu kind %u value 0x%llx, "
+            "expected kind %d value 0x%llx\n", what, res,
+            (unsigned long long)errnum, result.er_kind,
+            (unsigned long long)result.er_value, kind,
+            (unsigned long long)value);
+        ++test_failcount;
+    }
+}
+
+/*  The expression must fail with errnum. */
+static void
+expect_error(Dwarf_Debug dbg, const char *what,
+    const Dwarf_Small *bytes, Dwarf_Unsigned len,
+    const Dwarf_Expr_Callbacks *cb, Dwarf_Unsigned errnum)
+{
+    Dwarf_Expr_Result result;
+    Dwarf_Unsigned got = 0;
+    int res = 0;
+
+    res = evaluate(dbg, bytes, len, cb, &result, &got);
+    if (res != DW_DLV_ERROR || got != errnum) {
+        printf("FAIL %s: res %d error %llu, expected error %llu\n",
+            what, res, (unsigned long long)got,
+            (unsigned long long)errnum);
+        ++test_failcount;
+    }
+}
+
+#define ADDR  DW_EXPR_RESULT_ADDRESS
+#define VALUE DW_EXPR_RESULT_VALUE
+#define EXPECT(what, kind, value, ...) \
+    do { \
+        static const Dwarf_Small b_[] = { __VA_ARGS__ }; \
+        expect_value(dbg, what, b_, sizeof(b_), kind, value); \
+    } while (0)
+#define EXPECT_ERROR(what, cb, errnum, ...) \
+    do { \
+        static const Dwarf_Small b_[] = { __VA_ARGS__ }; \
+        expect_error(dbg, what, b_, sizeof(b_), cb, errnum); \
+    } while (0)
+
+#define L(n) (DW_OP_lit0 + (n))
+
+static void
+check_arithmetic(Dwarf_Debug dbg)
+{
+    EXPECT("plus", VALUE, 8, L(5), L(3), DW_OP_plus,
+        DW_OP_stack_value);
+    EXPECT("minus", ADDR, 7, L(10), L(3), DW_OP_minus);
+    EXPECT("minus below zero", ADDR, ALL_ONES, L(1), L(2),
+        DW_OP_minus);
+    EXPECT("mul", ADDR, 42, L(6), L(7), DW_OP_mul);
+    EXPECT("signed div", ADDR, (Dwarf_Unsigned)-3,
+        DW_OP_const1s, 0xf9, L(2), DW_OP_div);
+    EXPECT("div by -1", ADDR, 7, DW_OP_const1s, 0xf9,
+        DW_OP_const1s, 0xff, DW_OP_div);
+    EXPECT("mod", ADDR, 1, L(7), L(3), DW_OP_mod);
+    EXPECT("plus_uconst", ADDR, 129, L(1), DW_OP_plus_uconst,
+        0x80, 0x01);
+    EXPECT("neg", ADDR, (Dwarf_Unsigned)-5, L(5), DW_OP_neg);
+    EXPECT("abs", ADDR, 5, DW_OP_const1s, 0xfb, DW_OP_abs);
+    EXPECT("abs positive", ADDR, 5, L(5), DW_OP_abs);
+    EXPECT("not", ADDR, ALL_ONES, L(0), DW_OP_not);
+    EXPECT("and", ADDR, 0x4, L(12), L(6), DW_OP_and);
+    EXPECT("or", ADDR, 0xe, L(12), L(6), DW_OP_or);
+    EXPECT("xor", ADDR, 0xa, L(12), L(6), DW_OP_xor);
+    EXPECT("shl", ADDR, 16, L(1), L(4), DW_OP_shl);
+    EXPECT("shr", ADDR, 8, DW_OP_const1u, 0x80, L(4), DW_OP_shr);
+    EXPECT("shr of a negative", ADDR, ALL_ONES >> 4,
+        DW_OP_const1s, 0xf0, L(4), DW_OP_shr);
+    EXPECT("shra", ADDR, (Dwarf_Unsigned)-4, DW_OP_const1s, 0xf0,
+        L(2), DW_OP_shra);
+    EXPECT("lt", ADDR, 1, L(1), L(2), DW_OP_lt);
+    EXPECT("lt is signed", ADDR, 1, DW_OP_const1s, 0xff, L(0),
+        DW_OP_lt);
+    EXPECT("gt", ADDR, 0, L(1), L(2), DW_OP_gt);
+    EXPECT("le", ADDR, 1, L(2), L(2), DW_OP_le);
+    EXPECT("ge", ADDR, 0, L(1), L(2), DW_OP_ge);
+    EXPECT("eq", ADDR, 1, L(2), L(2), DW_OP_eq);
+    EXPECT("ne", ADDR, 0, L(2), L(2), DW_OP_ne);
+
+    EXPECT("dup", ADDR, 4, L(1), L(2), DW_OP_dup, DW_OP_plus);
+    EXPECT("drop", ADDR, 1, L(1), L(2), DW_OP_drop);
+    EXPECT("over", ADDR, 1, L(1), L(2), DW_OP_over);
+    EXPECT("pick", ADDR, 1, L(1), L(2), L(3), DW_OP_pick, 2);
+    EXPECT("swap", ADDR, 1, L(1), L(2), DW_OP_swap);
+    /*  1 2 3 rotates to 3 1 2. */
+    EXPECT("rot", ADDR, 2, L(1), L(2), L(3), DW_OP_rot);
+    EXPECT("rot second", ADDR, 1, L(1), L(2), L(3), DW_OP_rot,
+        DW_OP_drop);
+    EXPECT("rot third", ADDR, 3, L(1), L(2), L(3), DW_OP_rot,
+        DW_OP_drop, DW_OP_drop);
+    EXPECT("nop", ADDR, 3, L(3), DW_OP_nop);
+    address_size = 4;
+    EXPECT("minus below zero, 4 byte address", ADDR, 0xffffffff,
+        L(1), L(2), DW_OP_minus);
+    EXPECT("shra, 4 byte address", ADDR, 0xfffffffc,
+        DW_OP_const1s, 0xf0, L(2), DW_OP_shra);
+    address_size = 8;
+    {
+        Dwarf_Expr_Result result;
+        Dwarf_Unsigned errnum = 0;
+        static const Dwarf_Small b[] = { DW_OP_implicit_value, 4,
+            0xde, 0xad, 0xbe, 0xef };
+
+        CHECK(evaluate(dbg, b, sizeof(b), &callbacks, &result,
+            &errnum) == DW_DLV_OK);
+        CHECK(result.er_kind == DW_EXPR_RESULT_IMPLICIT);
+        CHECK(result.er_implicit_length == 4);
+        CHECK(result.er_implicit_data &&
+            !memcmp(result.er_implicit_data, b + 2, 4));
+    }
+
+    EXPECT_ERROR("plus of nothing", &callbacks,
+        DW_DLE_EXPR_STACK_ERROR, DW_OP_plus);
+    EXPECT_ERROR("plus of one", &callbacks,
+        DW_DLE_EXPR_STACK_ERROR, L(1), DW_OP_plus);
+    EXPECT_ERROR("pick too deep", &callbacks,
+        DW_DLE_EXPR_STACK_ERROR, L(1), DW_OP_pick, 1);
+    EXPECT_ERROR("empty result", &callbacks,
+        DW_DLE_EXPR_STACK_ERROR, DW_OP_nop);
+    EXPECT_ERROR("div by zero", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, L(1), L(0), DW_OP_div);
+    EXPECT_ERROR("mod by zero", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, L(1), L(0), DW_OP_mod);
+    EXPECT_ERROR("piece", &callbacks,
+        DW_DLE_EXPR_UNSUPPORTED_OP, DW_OP_reg0, DW_OP_piece, 4);
+}
+
+static void
+check_branches(Dwarf_Debug dbg)
+{
+    /*  Displacements count from the byte after the
+        two byte operand. */
+    EXPECT("skip", ADDR, 1, L(1), DW_OP_skip, 1, 0, L(2));
+    EXPECT("skip to the end", ADDR, 1, L(1), DW_OP_skip, 0, 0);
+    EXPECT("skip backwards", ADDR, 5,
+        DW_OP_skip, 4, 0,
+        L(5), DW_OP_skip, 4, 0,
+        DW_OP_skip, 0xf9, 0xff,
+        L(9));
+    EXPECT("bra taken", ADDR, 5, L(5), L(1), DW_OP_bra, 1, 0, L(2));
+    EXPECT("bra not taken", ADDR, 2, L(5), L(0), DW_OP_bra, 1, 0,
+        L(2));
+    /*  Counts 3 down to 0: the bra at offset 4 goes
+        back to the lit1 at offset 1 while the copy of
+        the counter is non-zero. */
+    EXPECT("bra loop", ADDR, 0,
+        L(3), L(1), DW_OP_minus, DW_OP_dup, DW_OP_bra, 0xfa, 0xff);
+    /*  Sums 4+3+2+1 the same way, keeping the sum
+        under the counter. */
+    EXPECT("bra loop sum", ADDR, 10,
+        L(0), L(4),
+        DW_OP_dup, DW_OP_rot, DW_OP_plus, DW_OP_swap,
+        L(1), DW_OP_minus, DW_OP_dup, DW_OP_bra, 0xf6, 0xff,
+        DW_OP_drop);
+    EXPECT_ERROR("bra of nothing", &callbacks,
+        DW_DLE_EXPR_STACK_ERROR, DW_OP_bra, 0, 0, L(1));
+    EXPECT_ERROR("skip into an operand", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, L(1), DW_OP_skip, 1, 0,
+        DW_OP_const1u, 5);
+    EXPECT_ERROR("skip before the start", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, DW_OP_skip, 0xf0, 0xff);
+    /*  Skips to itself for ever. */
+    EXPECT_ERROR("step limit", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, DW_OP_skip, 0xfd, 0xff);
+    EXPECT_ERROR("step limit with bra", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, L(1), DW_OP_dup, DW_OP_bra,
+        0xfc, 0xff);
+}
+
+static void
+check_callbacks(Dwarf_Debug dbg)
+{
+    Dwarf_Expr_Callbacks none;
+
+    memset(&target, 0, sizeof(target));
+    EXPECT("breg6", ADDR, REG_BASE + 6 - 16, DW_OP_breg6, 0x70);
+    CHECK(target.tg_register_reads == 1);
+    CHECK(target.tg_last_regnum == 6);
+    EXPECT("bregx", ADDR, REG_BASE + 33 + 8, DW_OP_bregx, 33, 8);
+    CHECK(target.tg_register_reads == 2);
+    CHECK(target.tg_last_regnum == 33);
+    EXPECT("reg5", DW_EXPR_RESULT_REGISTER, 5, DW_OP_reg5);
+    EXPECT("regx", DW_EXPR_RESULT_REGISTER, 40, DW_OP_regx, 40);
+    CHECK(target.tg_register_reads == 2);
+
+    EXPECT("deref", ADDR, 0x2000 ^ MEMORY_XOR, DW_OP_const2u,
+        0x00, 0x20, DW_OP_deref);
+    CHECK(target.tg_memory_reads == 1);
+    CHECK(target.tg_last_addr == 0x2000);
+    CHECK(target.tg_last_size == 8);
+    EXPECT("deref_size", ADDR, (REG_BASE + 7 + 4) ^ MEMORY_XOR,
+        DW_OP_breg7, 4, DW_OP_deref_size, 4);
+    CHECK(target.tg_memory_reads == 2);
+    CHECK(target.tg_last_addr == REG_BASE + 7 + 4);
+    CHECK(target.tg_last_size == 4);
+
+    EXPECT("fbreg", ADDR, FRAME_BASE - 8, DW_OP_fbreg, 0x78);
+    EXPECT("call_frame_cfa", ADDR, CFA + 16, DW_OP_call_frame_cfa,
+        DW_OP_plus_uconst, 16);
+    EXPECT("push_object_address", ADDR, OBJECT_ADDR + 8,
+        DW_OP_push_object_address, DW_OP_plus_uconst, 8);
+
+    EXPECT_ERROR("deref_size 0", &callbacks,
+        DW_DLE_EXPR_EVAL_ERROR, L(1), DW_OP_deref_size, 0);
+    target.tg_fail = 1;
+    EXPECT_ERROR("failing register read", &callbacks,
+        DW_DLE_EXPR_CALLBACK_FAILED, DW_OP_breg6, 0);
+    EXPECT_ERROR("failing memory read", &callbacks,
+        DW_DLE_EXPR_CALLBACK_FAILED, L(8), DW_OP_deref);
+    target.tg_fail = 0;
+
+    memset(&none, 0, sizeof(none));
+    EXPECT_ERROR("no register callback", &none,
+        DW_DLE_EXPR_CALLBACK_FAILED, DW_OP_breg6, 0);
+    EXPECT_ERROR("no memory callback", &none,
+        DW_DLE_EXPR_CALLBACK_FAILED, L(8), DW_OP_deref);
+    EXPECT_ERROR("no frame base callback", &none,
+        DW_DLE_EXPR_CALLBACK_FAILED, DW_OP_fbreg, 0);
+    EXPECT_ERROR("no callbacks at all", 0,
+        DW_DLE_EXPR_CALLBACK_FAILED, DW_OP_call_frame_cfa);
+}
+
+/*  The first DIE below die (depth first) with a
+    DW_AT_location whose first expression compiles.
+    Returns it, the caller deallocs it. */
+static Dwarf_Die
+find_location_die(Dwarf_Debug dbg, Dwarf_Die die)
+{
+    Dwarf_Die child = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_child(die, &child, &error) != DW_DLV_OK) {
+        return 0;
+    }
+    while (child) {
+        Dwarf_Die sib = 0;
+        Dwarf_Die found = 0;
+        Dwarf_Bool has = 0;
+
+        if (dwarf_hasattr(child, DW_AT_location, &has, &error) ==
+            DW_DLV_OK && has) {
+            return child;
+        }
+        found = find_location_die(dbg, child);
+        if (found) {
+            dwarf_dealloc_die(child);
+            return found;
+        }
+        if (dwarf_siblingof_b(dbg, child, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            sib = 0;
+        }
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    return 0;
+}
+
+/*  Compiles the first expression of the DW_AT_location
+    of die from a new loclist head.  The head is freed
+    before returning. */
+static int
+compile_location(Dwarf_Die die, Dwarf_Expr_Program *program)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Small lle = 0;
+    Dwarf_Unsigned rawlow = 0;
+    Dwarf_Unsigned rawhigh = 0;
+    Dwarf_Bool unavailable = 0;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Unsigned opcount = 0;
+    Dwarf_Locdesc_c locdesc = 0;
+    Dwarf_Small source = 0;
+    Dwarf_Unsigned exproff = 0;
+    Dwarf_Unsigned locdescoff = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_attr(die, DW_AT_location, &attr, &error);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_get_loclist_c(attr, &head, &count, &error);
+    dwarf_dealloc_attribute(attr);
+    if (res != DW_DLV_OK) {
+        return res;
+    }
+    res = dwarf_get_locdesc_entry_d(head, 0, &lle, &rawlow, &rawhigh,
+        &unavailable, &low, &high, &opcount, &locdesc, &source,
+        &exproff, &locdescoff, &error);
+    if (res == DW_DLV_OK) {
+        res = dwarf_expr_compile(locdesc, program, &error);
+    }
+    dwarf_loc_head_c_dealloc(head);
+    return res;
+}
+
+static void
+check_cache(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned next = 0;
+    Dwarf_Error error = 0;
+    int checked = 0;
+
+    while (!checked && dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0,
+        0, 0, 0, 0, &next, 0, &error) == DW_DLV_OK) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Die die = 0;
+        Dwarf_Expr_Program first = 0;
+        Dwarf_Expr_Program again = 0;
+        Dwarf_Expr_Result r1;
+        Dwarf_Expr_Result r2;
+
+        if (dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) !=
+            DW_DLV_OK) {
+            break;
+        }
+        die = find_location_die(dbg, cu_die);
+        dwarf_dealloc_die(cu_die);
+        if (!die) {
+            continue;
+        }
+        if (compile_location(die, &first) == DW_DLV_OK) {
+            checked = 1;
+            CHECK(compile_location(die, &again) == DW_DLV_OK);
+            CHECK(again == first);
+            /*  A no-op for a cached program. */
+            dwarf_expr_program_dealloc(first);
+            CHECK(compile_location(die, &again) == DW_DLV_OK);
+            CHECK(again == first);
+            memset(&r1, 0, sizeof(r1));
+            memset(&r2, 0, sizeof(r2));
+            CHECK(dwarf_expr_evaluate(first, &callbacks, &r1,
+                &error) == dwarf_expr_evaluate(again, &callbacks,
+                &r2, &error));
+            CHECK(r1.er_kind == r2.er_kind);
+            CHECK(r1.er_value == r2.er_value);
+        }
+        dwarf_dealloc_die(die);
+    }
+    CHECK(checked);
+}
+
+int
+main(int argc, char **argv)
+{
+    struct test_prodobj_s po;
+    struct bytes_s info;
+    struct bytes_s abbrev;
+    unsigned scratch_off = 0;
+    Dwarf_Unsigned next = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    callbacks.ec_user_data = &target;
+    callbacks.ec_read_register = read_register;
+    callbacks.ec_read_memory = read_memory;
+    callbacks.ec_frame_base = frame_base;
+    callbacks.ec_call_frame_cfa = call_frame_cfa;
+    callbacks.ec_object_address = object_address;
+
+    memset(&po, 0, sizeof(po));
+    memset(&info, 0, sizeof(info));
+    memset(&abbrev, 0, sizeof(abbrev));
+    put_scratch_cu(&info, &abbrev, &scratch_off);
+    if (test_prodobj_add_section(&po, ".debug_info",
+            info.b_data, info.b_len) != DW_DLV_OK ||
+        test_prodobj_add_section(&po, ".debug_abbrev",
+            abbrev.b_data, abbrev.b_len) != DW_DLV_OK) {
+        printf("FAIL building the sections\n");
+        return 1;
+    }
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL test_prodobj_open\n");
+        return 1;
+    }
+    /*  Loads .debug_info. */
+    res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        &next, 0, &error);
+    CHECK(res == DW_DLV_OK);
+    scratch = (Dwarf_Small *)test_prodobj_section(&po,
+        ".debug_info", &size) + scratch_off;
+    if (res == DW_DLV_OK) {
+        check_arithmetic(dbg);
+        check_branches(dbg);
+        check_callbacks(dbg);
+    }
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    check_cache(dbg);
+    dwarf_finish(dbg, &error);
+    return test_report("test_expr_eval");
+}
@@ -0,0 +1,182 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  For every string attribute of every DIE in the
+    objects named (by default testobjO2DW4.elf, with
+    DW_FORM_strp and DW_FORM_string, and
+    testobjsplit1.dwo, with DW_FORM_strx), checks that
+    dwarf_formstring_view() returns the pointer
+    dwarf_formstring() does and its strlen(), and that
+    dwarf_diename_view() agrees with dwarf_diename(). */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+static int strings_checked = 0;
+static int forms_seen[3];
+
+static void
+check_die(Dwarf_Debug dbg, Dwarf_Die die)
+{
+    Dwarf_Attribute *attrs = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    const char *view = 0;
+    Dwarf_Unsigned len = 0;
+    char *name = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_diename(die, &name, &error);
+    if (res == DW_DLV_OK) {
+        CHECK(dwarf_diename_view(die, &view, &len, &error) ==
+            DW_DLV_OK);
+        CHECK(view == name);
+        CHECK(len == strlen(name));
+    } else {
+        CHECK(dwarf_diename_view(die, &view, &len, &error) == res);
+    }
+    if (dwarf_attrlist(die, &attrs, &count, &error) != DW_DLV_OK) {
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Half form = 0;
+        char *str = 0;
+
+        CHECK(dwarf_whatform(attrs[i], &form, &error) == DW_DLV_OK);
+        if (dwarf_formstring(attrs[i], &str, &error) == DW_DLV_OK) {
+            view = 0;
+            len = 0;
+            CHECK(dwarf_formstring_view(attrs[i], &view, &len,
+                &error) == DW_DLV_OK);
+            CHECK(view == str);
+            CHECK(len == strlen(str));
+            ++strings_checked;
+            if (form == DW_FORM_string) {
+                forms_seen[0] = 1;
+            } else if (form == DW_FORM_strp) {
+                forms_seen[1] = 1;
+            } else if (form == DW_FORM_strx ||
+                form == DW_FORM_strx1 || form == DW_FORM_strx2 ||
+                form == DW_FORM_GNU_str_index) {
+                forms_seen[2] = 1;
+            }
+        } else if (error) {
+            dwarf_dealloc_error(dbg, error);
+            error = 0;
+        }
+        dwarf_dealloc_attribute(attrs[i]);
+    }
+    dwarf_dealloc(dbg, attrs, DW_DLA_LIST);
+}
+
+static void
+walk(Dwarf_Debug dbg, Dwarf_Die die)
+{
+    Dwarf_Die cur = die;
+    Dwarf_Error error = 0;
+
+    for (;;) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        check_die(dbg, cur);
+        if (dwarf_child(cur, &child, &error) == DW_DLV_OK) {
+            walk(dbg, child);
+        }
+        if (dwarf_siblingof_b(dbg, cur, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            break;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        cur = sib;
+    }
+    if (cur != die) {
+        dwarf_dealloc_die(cur);
+    }
+    dwarf_dealloc_die(die);
+}
+
+static void
+check_file(const char *path)
+{
+    Dwarf_Debug dbg = test_open_path(path);
+    Dwarf_Error error = 0;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        if (dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) !=
+            DW_DLV_OK) {
+            CHECK(0);
+            break;
+        }
+        walk(dbg, cu_die);
+    }
+    dwarf_finish(dbg, &error);
+}
+
+int
+main(int argc, char **argv)
+{
+    int i = 0;
+
+    if (argc > 1) {
+        for (i = 1; i < argc; ++i) {
+            check_file(argv[i]);
+        }
+    } else {
+        check_file(test_fixture_path(argc, argv, 1,
+            "testobjO2DW4.elf"));
+        check_file(test_fixture_path(argc, argv, 2,
+            "testobjsplit1.dwo"));
+    }
+    CHECK(strings_checked > 0);
+    CHECK(forms_seen[0]);
+    CHECK(forms_seen[1]);
+    CHECK(forms_seen[2]);
+    return test_report("test_formstring_view");
+}
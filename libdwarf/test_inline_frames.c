@@ -0,0 +1,481 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Reads testobjO2DW4.elf and testobjO2DW5.elf and, for
+    every address in their line tables (and the byte after
+    each), compares dwarf_inline_frames() with a chain found
+    the long way round: a walk down the DIE tree through
+    every DW_TAG_subprogram and DW_TAG_inlined_subroutine
+    whose low/high pc or DW_AT_ranges cover the address.
+    DW_AT_ranges is read from .debug_ranges for DWARF4 and
+    from .debug_rnglists for DWARF5, where the inlined
+    subroutines of the fixture use it.  Both fixtures
+    inline inner() into middle() into work(), so some
+    address must report that three deep chain.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+#define MAXPAIRS 64
+#define MAXDEPTH 32
+#define MAXPCS   4096
+
+struct ref_frame_s {
+    Dwarf_Off      rf_die_offset;
+    Dwarf_Half     rf_tag;
+    Dwarf_Unsigned rf_call_line;
+    char           rf_name[64];
+    int            rf_pair_count;
+    Dwarf_Addr     rf_pairs[2*MAXPAIRS];
+};
+
+/*  Count of DW_AT_ranges read from .debug_rnglists. */
+static int rnglists_seen = 0;
+
+/*  The cooked pairs of the DWARF5 .debug_rnglists
+    list attr refers to.  Returns the pair count. */
+static int
+rnglists_pairs(Dwarf_Attribute attr, Dwarf_Addr *pairs)
+{
+    Dwarf_Half form = 0;
+    Dwarf_Unsigned value = 0;
+    Dwarf_Rnglists_Head head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned global_offset = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int n = 0;
+    int res = 0;
+
+    CHECK(dwarf_whatform(attr, &form, &error) == DW_DLV_OK);
+    if (form == DW_FORM_rnglistx) {
+        res = dwarf_formudata(attr, &value, &error);
+    } else {
+        Dwarf_Off off = 0;
+
+        res = dwarf_global_formref(attr, &off, &error);
+        value = off;
+    }
+    CHECK(res == DW_DLV_OK);
+    res = dwarf_rnglists_get_rle_head(attr, form, value, &head,
+        &count, &global_offset, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return 0;
+    }
+    ++rnglists_seen;
+    for (i = 0; i < count; ++i) {
+        unsigned entrylen = 0;
+        unsigned code = 0;
+        Dwarf_Unsigned raw1 = 0;
+        Dwarf_Unsigned raw2 = 0;
+        Dwarf_Bool unavailable = 0;
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+
+        res = dwarf_get_rnglists_entry_fields_a(head, i, &entrylen,
+            &code, &raw1, &raw2, &unavailable, &low, &high, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK || code == DW_RLE_end_of_list) {
+            break;
+        }
+        if (code == DW_RLE_base_addressx ||
+            code == DW_RLE_base_address || low >= high) {
+            continue;
+        }
+        if (n < MAXPAIRS) {
+            pairs[2*n] = low;
+            pairs[2*n+1] = high;
+            ++n;
+        }
+    }
+    dwarf_dealloc_rnglists_head(head);
+    return n;
+}
+
+/*  The pc ranges of die, from low/high pc or from
+    DW_AT_ranges with the CU low pc as base.
+    Returns the pair count. */
+static int
+die_pairs(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Addr cu_base,
+    Dwarf_Addr *pairs)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Half form = 0;
+    Dwarf_Half version = 0;
+    Dwarf_Half offset_size = 0;
+    enum Dwarf_Form_Class fclass = DW_FORM_CLASS_UNKNOWN;
+    Dwarf_Error error = 0;
+    int n = 0;
+
+    if (dwarf_lowpc(die, &low, &error) == DW_DLV_OK &&
+        dwarf_highpc_b(die, &high, &form, &fclass, &error) ==
+        DW_DLV_OK) {
+        if (fclass == DW_FORM_CLASS_CONSTANT) {
+            high += low;
+        }
+        if (low >= high) {
+            return 0;
+        }
+        pairs[0] = low;
+        pairs[1] = high;
+        return 1;
+    }
+    if (dwarf_attr(die, DW_AT_ranges, &attr, &error) ==
+        DW_DLV_OK) {
+        Dwarf_Off off = 0;
+        Dwarf_Ranges *ranges = 0;
+        Dwarf_Signed count = 0;
+        Dwarf_Signed i = 0;
+        Dwarf_Unsigned bytes = 0;
+        Dwarf_Addr base = cu_base;
+
+        CHECK(dwarf_get_version_of_die(die, &version,
+            &offset_size) == DW_DLV_OK);
+        if (version >= 5) {
+            n = rnglists_pairs(attr, pairs);
+            dwarf_dealloc_attribute(attr);
+            return n;
+        }
+        CHECK(dwarf_global_formref(attr, &off, &error) ==
+            DW_DLV_OK);
+        dwarf_dealloc_attribute(attr);
+        if (dwarf_get_ranges_a(dbg, off, die, &ranges, &count,
+            &bytes, &error) != DW_DLV_OK) {
+            CHECK(0);
+            return 0;
+        }
+        for (i = 0; i < count; ++i) {
+            if (ranges[i].dwr_type == DW_RANGES_ADDRESS_SELECTION) {
+                base = ranges[i].dwr_addr2;
+                continue;
+            }
+            if (ranges[i].dwr_type != DW_RANGES_ENTRY ||
+                ranges[i].dwr_addr1 >= ranges[i].dwr_addr2) {
+                continue;
+            }
+            if (n < MAXPAIRS) {
+                pairs[2*n] = ranges[i].dwr_addr1 + base;
+                pairs[2*n+1] = ranges[i].dwr_addr2 + base;
+                ++n;
+            }
+        }
+        dwarf_ranges_dealloc(dbg, ranges, count);
+    }
+    return n;
+}
+
+/*  The name of die, following DW_AT_abstract_origin. */
+static void
+die_name(Dwarf_Debug dbg, Dwarf_Die die, char *out, size_t len)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Off off = 0;
+    Dwarf_Die origin = 0;
+    char *name = 0;
+    Dwarf_Error error = 0;
+
+    out[0] = 0;
+    if (dwarf_diename(die, &name, &error) == DW_DLV_OK) {
+        snprintf(out, len, "%s", name);
+        return;
+    }
+    if (dwarf_attr(die, DW_AT_abstract_origin, &attr, &error) !=
+        DW_DLV_OK) {
+        return;
+    }
+    if (dwarf_global_formref(attr, &off, &error) == DW_DLV_OK &&
+        dwarf_offdie_b(dbg, off, 1, &origin, &error) == DW_DLV_OK) {
+        die_name(dbg, origin, out, len);
+        dwarf_dealloc_die(origin);
+    }
+    dwarf_dealloc_attribute(attr);
+}
+
+/*  Appends to chain, outermost first, the subprogram or
+    inlined subroutine among the children of parent
+    (looking through other DIEs such as lexical blocks)
+    covering pc, then recurses into it.  Returns 1 if one
+    was found. */
+static int
+ref_chain(Dwarf_Debug dbg, Dwarf_Die parent, Dwarf_Addr cu_base,
+    Dwarf_Addr pc, struct ref_frame_s *chain, int *depth)
+{
+    Dwarf_Die child = 0;
+    Dwarf_Error error = 0;
+    int found = 0;
+
+    if (dwarf_child(parent, &child, &error) != DW_DLV_OK) {
+        return 0;
+    }
+    while (child && !found) {
+        Dwarf_Die sib = 0;
+        Dwarf_Half tag = 0;
+
+        CHECK(dwarf_tag(child, &tag, &error) == DW_DLV_OK);
+        if (tag == DW_TAG_subprogram ||
+            tag == DW_TAG_inlined_subroutine) {
+            struct ref_frame_s *f = chain + *depth;
+            int i = 0;
+
+            memset(f, 0, sizeof(*f));
+            f->rf_pair_count = die_pairs(dbg, child, cu_base,
+                f->rf_pairs);
+            for (i = 0; i < f->rf_pair_count; ++i) {
+                if (f->rf_pairs[2*i] <= pc &&
+                    pc < f->rf_pairs[2*i+1]) {
+                    found = 1;
+                }
+            }
+            if (found && *depth < MAXDEPTH) {
+                Dwarf_Attribute attr = 0;
+
+                CHECK(dwarf_dieoffset(child, &f->rf_die_offset,
+                    &error) == DW_DLV_OK);
+                f->rf_tag = tag;
+                die_name(dbg, child, f->rf_name,
+                    sizeof(f->rf_name));
+                if (dwarf_attr(child, DW_AT_call_line, &attr,
+                    &error) == DW_DLV_OK) {
+                    CHECK(dwarf_formudata(attr, &f->rf_call_line,
+                        &error) == DW_DLV_OK);
+                    dwarf_dealloc_attribute(attr);
+                }
+                ++*depth;
+                ref_chain(dbg, child, cu_base, pc, chain, depth);
+            }
+        } else {
+            found = ref_chain(dbg, child, cu_base, pc, chain, depth);
+        }
+        if (found) {
+            dwarf_dealloc_die(child);
+            break;
+        }
+        if (dwarf_siblingof_b(dbg, child, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            sib = 0;
+        }
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+    return found;
+}
+
+/*  Every line table address of cu_die, and the byte after. */
+static Dwarf_Unsigned
+line_pcs(Dwarf_Die cu_die, Dwarf_Addr *pcs, Dwarf_Unsigned n)
+{
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned version = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_srclines_b(cu_die, &version, &table_count, &context,
+        &error) != DW_DLV_OK) {
+        return n;
+    }
+    if (dwarf_srclines_from_linecontext(context, &lines, &count,
+        &error) == DW_DLV_OK) {
+        for (i = 0; i < count && n + 2 <= MAXPCS; ++i) {
+            Dwarf_Addr addr = 0;
+
+            CHECK(dwarf_lineaddr(lines[i], &addr, &error) ==
+                DW_DLV_OK);
+            pcs[n++] = addr;
+            pcs[n++] = addr + 1;
+        }
+    }
+    dwarf_srclines_dealloc_b(context);
+    return n;
+}
+
+static void
+compare_at(Dwarf_Debug dbg, Dwarf_Die cu_die, Dwarf_Addr cu_base,
+    Dwarf_Addr pc, int *saw_inlined_chain)
+{
+    struct ref_frame_s chain[MAXDEPTH];
+    Dwarf_Inline_Frame frames[MAXDEPTH];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+    int depth = 0;
+    int res = 0;
+    int i = 0;
+
+    ref_chain(dbg, cu_die, cu_base, pc, chain, &depth);
+    memset(frames, 0, sizeof(frames));
+    res = dwarf_inline_frames(dbg, pc, frames, MAXDEPTH, &count,
+        &error);
+    if (!depth) {
+        CHECK(res == DW_DLV_NO_ENTRY);
+        return;
+    }
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    CHECK(count == (Dwarf_Unsigned)depth);
+    if (count != (Dwarf_Unsigned)depth) {
+        printf("FAIL pc 0x%llx: %llu frames, expected %d\n",
+            (unsigned long long)pc, (unsigned long long)count,
+            depth);
+        return;
+    }
+    for (i = 0; i < depth; ++i) {
+        struct ref_frame_s *r = chain + depth - 1 - i;
+        Dwarf_Inline_Frame *f = frames + i;
+        int p = 0;
+        int pair_match = 0;
+
+        CHECK(f->if_die_offset == r->rf_die_offset);
+        CHECK(f->if_tag == r->rf_tag);
+        CHECK(f->if_name && !strcmp(f->if_name, r->rf_name));
+        CHECK(f->if_lowpc <= pc && pc < f->if_highpc);
+        for (p = 0; p < r->rf_pair_count; ++p) {
+            if (r->rf_pairs[2*p] == f->if_lowpc &&
+                r->rf_pairs[2*p+1] == f->if_highpc) {
+                pair_match = 1;
+            }
+        }
+        CHECK(pair_match);
+        if (r->rf_tag == DW_TAG_inlined_subroutine) {
+            CHECK(f->if_call_line == r->rf_call_line);
+            CHECK(f->if_call_line != 0);
+        }
+    }
+    /*  The outermost frame is always the subprogram. */
+    CHECK(frames[depth-1].if_tag == DW_TAG_subprogram);
+    if (depth == 3 && !strcmp(frames[0].if_name, "inner") &&
+        !strcmp(frames[1].if_name, "middle") &&
+        !strcmp(frames[2].if_name, "work")) {
+        *saw_inlined_chain = 1;
+    }
+
+    /*  Too small an array still reports the full depth,
+        and fills in the innermost frames. */
+    memset(frames, 0, sizeof(frames));
+    count = 0;
+    CHECK(dwarf_inline_frames(dbg, pc, frames, 1, &count, &error) ==
+        DW_DLV_OK);
+    CHECK(count == (Dwarf_Unsigned)depth);
+    CHECK(frames[0].if_die_offset == chain[depth-1].rf_die_offset);
+    CHECK(frames[1].if_die_offset == 0);
+    count = 0;
+    CHECK(dwarf_inline_frames(dbg, pc, 0, 0, &count, &error) ==
+        DW_DLV_OK);
+    CHECK(count == (Dwarf_Unsigned)depth);
+}
+
+/*  Compares every line table address of every CU.
+    Returns the number of addresses compared. */
+static Dwarf_Unsigned
+compare_all(Dwarf_Debug dbg, int *saw_inlined_chain)
+{
+    static Dwarf_Addr pcs[MAXPCS];
+    Dwarf_Unsigned total = 0;
+    Dwarf_Error error = 0;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Addr cu_base = 0;
+        Dwarf_Unsigned pccount = 0;
+        Dwarf_Unsigned i = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        if (dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) !=
+            DW_DLV_OK) {
+            CHECK(0);
+            break;
+        }
+        if (dwarf_lowpc(cu_die, &cu_base, &error) != DW_DLV_OK) {
+            cu_base = 0;
+        }
+        pccount = line_pcs(cu_die, pcs, 0);
+        for (i = 0; i < pccount; ++i) {
+            compare_at(dbg, cu_die, cu_base, pcs[i],
+                saw_inlined_chain);
+        }
+        total += pccount;
+        dwarf_dealloc_die(cu_die);
+    }
+    return total;
+}
+
+static void
+check_object(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned total = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Inline_Frame frame;
+    Dwarf_Error error = 0;
+    int saw_inlined_chain = 0;
+
+    total = compare_all(dbg, &saw_inlined_chain);
+    CHECK(total > 0);
+    CHECK(saw_inlined_chain);
+    /*  Nothing covers address zero. */
+    CHECK(dwarf_inline_frames(dbg, 0, &frame, 1, &count, &error) ==
+        DW_DLV_NO_ENTRY);
+    /*  A cleared cache is rebuilt by the next query. */
+    dwarf_inline_frames_cache_clear(dbg);
+    saw_inlined_chain = 0;
+    CHECK(compare_all(dbg, &saw_inlined_chain) == total);
+    CHECK(saw_inlined_chain);
+    dwarf_finish(dbg, &error);
+}
+
+int
+main(int argc, char **argv)
+{
+    check_object(test_open_fixture(argc, argv, 1,
+        "testobjO2DW4.elf"));
+    CHECK(rnglists_seen == 0);
+    check_object(test_open_fixture(argc, argv, 2,
+        "testobjO2DW5.elf"));
+    CHECK(rnglists_seen > 0);
+    return test_report("test_inline_frames");
+}
@@ -0,0 +1,361 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Builds a DWARF4 and a DWARF5 CU by hand, each with a
+    line table naming a.c in the compilation directory and
+    stdio.h in /usr/include, and checks the paths
+    dwarf_linesrc() gives for their rows.  A DWARF4 table
+    does not list the compilation directory, so /usr/include
+    is its directory 1 as the first listed.  A DWARF5 table
+    lists the compilation directory as directory 0, so
+    /usr/include is directory 1 as the second listed, and
+    must not be read as the first. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+#include "test_consumer.h"
+
+struct bytes_s {
+    unsigned char b_data[512];
+    unsigned      b_len;
+};
+
+static void
+put_byte(struct bytes_s *b, unsigned v)
+{
+    b->b_data[b->b_len++] = (unsigned char)v;
+}
+
+static void
+put_u16(struct bytes_s *b, unsigned v)
+{
+    put_byte(b, v & 0xff);
+    put_byte(b, (v >> 8) & 0xff);
+}
+
+static void
+put_u32(struct bytes_s *b, unsigned v)
+{
+    put_u16(b, v & 0xffff);
+    put_u16(b, (v >> 16) & 0xffff);
+}
+
+static void
+put_u64(struct bytes_s *b, Dwarf_Unsigned v)
+{
+    put_u32(b, (unsigned)(v & 0xffffffff));
+    put_u32(b, (unsigned)(v >> 32));
+}
+
+static void
+put_string(struct bytes_s *b, const char *s)
+{
+    size_t len = strlen(s) + 1;
+
+    memcpy(b->b_data + b->b_len, s, len);
+    b->b_len += (unsigned)len;
+}
+
+/*  Writes v at offset, where a placeholder was put. */
+static void
+patch_u32(struct bytes_s *b, unsigned offset, unsigned v)
+{
+    unsigned len = b->b_len;
+
+    b->b_len = offset;
+    put_u32(b, v);
+    b->b_len = len;
+}
+
+#define COMP_DIR "/comp"
+#define INC_DIR  "/usr/include"
+#define LOW_PC   0x1000
+
+/*  min_inst_length through standard_opcode_lengths,
+    the same in both versions. */
+static void
+put_line_params(struct bytes_s *b)
+{
+    static const unsigned char oplens[12] =
+        {0,1,1,1,1,0,0,0,1,0,0,1};
+    unsigned i = 0;
+
+    put_byte(b, 1);
+    put_byte(b, 1);
+    put_byte(b, 1);
+    put_byte(b, (unsigned)-5 & 0xff);
+    put_byte(b, 14);
+    put_byte(b, 13);
+    for (i = 0; i < sizeof(oplens); ++i) {
+        put_byte(b, oplens[i]);
+    }
+}
+
+/*  A row for file a_file, then one for file h_file
+    four bytes on. */
+static void
+put_line_program(struct bytes_s *b, unsigned a_file,
+    unsigned h_file)
+{
+    put_byte(b, 0);
+    put_byte(b, 9);
+    put_byte(b, DW_LNE_set_address);
+    put_u64(b, LOW_PC);
+    put_byte(b, DW_LNS_set_file);
+    put_byte(b, a_file);
+    put_byte(b, DW_LNS_copy);
+    put_byte(b, DW_LNS_set_file);
+    put_byte(b, h_file);
+    put_byte(b, DW_LNS_advance_pc);
+    put_byte(b, 4);
+    put_byte(b, DW_LNS_copy);
+    put_byte(b, DW_LNS_advance_pc);
+    put_byte(b, 4);
+    put_byte(b, 0);
+    put_byte(b, 1);
+    put_byte(b, DW_LNE_end_sequence);
+}
+
+static void
+put_line_table_v4(struct bytes_s *b)
+{
+    unsigned start = b->b_len;
+    unsigned hdrlen_at = 0;
+    unsigned hdr_start = 0;
+
+    put_u32(b, 0);
+    put_u16(b, 4);
+    hdrlen_at = b->b_len;
+    put_u32(b, 0);
+    hdr_start = b->b_len;
+    put_line_params(b);
+    put_string(b, INC_DIR);
+    put_byte(b, 0);
+    put_string(b, "a.c");
+    put_byte(b, 0);
+    put_byte(b, 0);
+    put_byte(b, 0);
+    put_string(b, "stdio.h");
+    put_byte(b, 1);
+    put_byte(b, 0);
+    put_byte(b, 0);
+    put_byte(b, 0);
+    patch_u32(b, hdrlen_at, b->b_len - hdr_start);
+    /*  Files are numbered from 1. */
+    put_line_program(b, 1, 2);
+    patch_u32(b, start, b->b_len - start - 4);
+}
+
+static void
+put_line_table_v5(struct bytes_s *b)
+{
+    unsigned start = b->b_len;
+    unsigned hdrlen_at = 0;
+    unsigned hdr_start = 0;
+
+    put_u32(b, 0);
+    put_u16(b, 5);
+    put_byte(b, 8);
+    put_byte(b, 0);
+    hdrlen_at = b->b_len;
+    put_u32(b, 0);
+    hdr_start = b->b_len;
+    put_line_params(b);
+    put_byte(b, 1);
+    put_byte(b, DW_LNCT_path);
+    put_byte(b, DW_FORM_string);
+    put_byte(b, 2);
+    put_string(b, COMP_DIR);
+    put_string(b, INC_DIR);
+    put_byte(b, 2);
+    put_byte(b, DW_LNCT_path);
+    put_byte(b, DW_FORM_string);
+    put_byte(b, DW_LNCT_directory_index);
+    put_byte(b, DW_FORM_udata);
+    put_byte(b, 2);
+    put_string(b, "a.c");
+    put_byte(b, 0);
+    put_string(b, "stdio.h");
+    put_byte(b, 1);
+    patch_u32(b, hdrlen_at, b->b_len - hdr_start);
+    /*  Files are numbered from 0. */
+    put_line_program(b, 0, 1);
+    patch_u32(b, start, b->b_len - start - 4);
+}
+
+static void
+put_abbrev(struct bytes_s *b)
+{
+    put_byte(b, 1);
+    put_byte(b, DW_TAG_compile_unit);
+    put_byte(b, DW_CHILDREN_no);
+    put_byte(b, DW_AT_name);
+    put_byte(b, DW_FORM_string);
+    put_byte(b, DW_AT_comp_dir);
+    put_byte(b, DW_FORM_string);
+    put_byte(b, DW_AT_stmt_list);
+    put_byte(b, DW_FORM_sec_offset);
+    put_byte(b, DW_AT_low_pc);
+    put_byte(b, DW_FORM_addr);
+    put_byte(b, 0);
+    put_byte(b, 0);
+    put_byte(b, 0);
+}
+
+static void
+put_cu(struct bytes_s *b, unsigned version, unsigned stmt_list)
+{
+    unsigned start = b->b_len;
+
+    put_u32(b, 0);
+    put_u16(b, version);
+    if (version >= 5) {
+        put_byte(b, DW_UT_compile);
+        put_byte(b, 8);
+        put_u32(b, 0);
+    } else {
+        put_u32(b, 0);
+        put_byte(b, 8);
+    }
+    put_byte(b, 1);
+    put_string(b, "a.c");
+    put_string(b, COMP_DIR);
+    put_u32(b, stmt_list);
+    put_u64(b, LOW_PC);
+    patch_u32(b, start, b->b_len - start - 4);
+}
+
+static void
+check_cu(Dwarf_Debug dbg, unsigned version)
+{
+    Dwarf_Unsigned next = 0;
+    Dwarf_Die cu_die = 0;
+    Dwarf_Unsigned lineversion = 0;
+    Dwarf_Small table_count = 0;
+    Dwarf_Line_Context context = 0;
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Error error = 0;
+    char *name = 0;
+    int res = 0;
+
+    res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0,
+        0, 0, &next, 0, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    res = dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    res = dwarf_srclines_b(cu_die, &lineversion, &table_count,
+        &context, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        CHECK(lineversion == version);
+        res = dwarf_srclines_from_linecontext(context, &lines, &count,
+            &error);
+        CHECK(res == DW_DLV_OK);
+        CHECK(count == 3);
+        if (res == DW_DLV_OK && count == 3) {
+            res = dwarf_linesrc(lines[0], &name, &error);
+            CHECK(res == DW_DLV_OK);
+            if (res == DW_DLV_OK) {
+                if (strcmp(name, COMP_DIR "/a.c")) {
+                    printf("FAIL DWARF%u a.c path %s\n", version,
+                        name);
+                    ++test_failcount;
+                }
+                dwarf_dealloc(dbg, name, DW_DLA_STRING);
+            }
+            res = dwarf_linesrc(lines[1], &name, &error);
+            CHECK(res == DW_DLV_OK);
+            if (res == DW_DLV_OK) {
+                if (strcmp(name, INC_DIR "/stdio.h")) {
+                    printf("FAIL DWARF%u stdio.h path %s\n", version,
+                        name);
+                    ++test_failcount;
+                }
+                dwarf_dealloc(dbg, name, DW_DLA_STRING);
+            }
+        }
+        dwarf_srclines_dealloc_b(context);
+    }
+    dwarf_dealloc(dbg, cu_die, DW_DLA_DIE);
+}
+
+int
+main(void)
+{
+    struct test_prodobj_s po;
+    struct bytes_s info;
+    struct bytes_s abbrev;
+    struct bytes_s line;
+    unsigned line5 = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+
+    memset(&po, 0, sizeof(po));
+    memset(&info, 0, sizeof(info));
+    memset(&abbrev, 0, sizeof(abbrev));
+    memset(&line, 0, sizeof(line));
+    put_abbrev(&abbrev);
+    put_line_table_v4(&line);
+    line5 = line.b_len;
+    put_line_table_v5(&line);
+    put_cu(&info, 4, 0);
+    put_cu(&info, 5, line5);
+    if (test_prodobj_add_section(&po, ".debug_info",
+            info.b_data, info.b_len) != DW_DLV_OK ||
+        test_prodobj_add_section(&po, ".debug_abbrev",
+            abbrev.b_data, abbrev.b_len) != DW_DLV_OK ||
+        test_prodobj_add_section(&po, ".debug_line",
+            line.b_data, line.b_len) != DW_DLV_OK) {
+        printf("FAIL building the sections\n");
+        return 1;
+    }
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL test_prodobj_open\n");
+        return 1;
+    }
+    check_cu(dbg, 4);
+    check_cu(dbg, 5);
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+    return test_report("test_line_dir_index");
+}
@@ -0,0 +1,395 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Builds the same CU, with line table, frame data and
+    relocations, with no job runner and with runners that
+    call the .debug_line job after and before the rest, for
+    DWARF2, 4 and 5 producers.  The sections and relocation
+    records must be byte for byte the same every time.
+    The DWARF5 producer writes no .debug_line, so there the
+    runner must not be called at all.
+    Also checks that PRO_DEBUG_FIELDS names every field of
+    Dwarf_P_Debug_s, so none can be added without deciding
+    whether the .debug_line job copies it.  */
+
+#include "config.h"
+#include "libdwarfdefs.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include <stddef.h>
+#include "pro_incl.h"
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "pro_opaque.h"
+#include "test_prodobj.h"
+
+static int failcount = 0;
+
+static void
+check(int cond, const char *msg, int line)
+{
+    if (!cond) {
+        printf("FAIL line %d: %s\n", line, msg);
+        ++failcount;
+    }
+}
+#define CHECK(c) check((c), #c, __LINE__)
+
+struct field_s {
+    const char *fd_name;
+    size_t fd_offset;
+    size_t fd_size;
+    /*  Zero where the compiler cannot tell us. */
+    size_t fd_align;
+};
+
+#ifdef __GNUC__
+#define FIELD_ALIGN(f) __alignof__(((struct Dwarf_P_Debug_s *)0)->f)
+#else
+#define FIELD_ALIGN(f) 0
+#endif
+#define FIELD(f) { #f, offsetof(struct Dwarf_P_Debug_s,f), \
+    sizeof(((struct Dwarf_P_Debug_s *)0)->f), FIELD_ALIGN(f) },
+
+static const struct field_s fields[] = {
+    PRO_DEBUG_FIELDS(FIELD,FIELD)
+};
+
+static size_t
+round_up(size_t v, size_t align)
+{
+    return align? (v + align - 1)/align*align : v;
+}
+
+/*  In declaration order each field must start where the
+    previous one ends, give or take the padding its
+    alignment needs, and the last must end the struct. */
+static void
+check_field_list(void)
+{
+    size_t count = sizeof(fields)/sizeof(fields[0]);
+    size_t end = 0;
+    size_t maxalign = 1;
+    size_t k = 0;
+
+    for (k = 0; k < count; ++k) {
+        const struct field_s *f = &fields[k];
+        int ok = 0;
+
+        if (f->fd_align) {
+            ok = f->fd_offset == round_up(end, f->fd_align);
+            if (f->fd_align > maxalign) {
+                maxalign = f->fd_align;
+            }
+        } else {
+            ok = f->fd_offset >= end && f->fd_offset - end < 16;
+        }
+        if (!ok) {
+            printf("FAIL PRO_DEBUG_FIELDS: %s at offset %lu, "
+                "previous field ends at %lu\n", f->fd_name,
+                (unsigned long)f->fd_offset, (unsigned long)end);
+            ++failcount;
+        }
+        end = f->fd_offset + f->fd_size;
+    }
+    if (fields[0].fd_align) {
+        CHECK(round_up(end, maxalign) ==
+            sizeof(struct Dwarf_P_Debug_s));
+    } else {
+        CHECK(end <= sizeof(struct Dwarf_P_Debug_s) &&
+            sizeof(struct Dwarf_P_Debug_s) - end < 16);
+    }
+}
+
+#define RUN_SERIAL  0
+#define RUN_FORWARD 1
+#define RUN_REVERSE 2
+
+struct runner_s {
+    int ru_order;
+    int ru_calls;
+};
+
+static void
+test_runner(void *user_data, unsigned count,
+    void (*job)(void *, unsigned), void *job_arg)
+{
+    struct runner_s *r = (struct runner_s *)user_data;
+    unsigned i = 0;
+
+    ++r->ru_calls;
+    for (i = 0; i < count; ++i) {
+        job(job_arg, r->ru_order == RUN_REVERSE? count-1-i : i);
+    }
+}
+
+#define MAXRELSECT 16
+#define MAXREL     64
+
+struct relsect_s {
+    Dwarf_Signed rs_sect;
+    Dwarf_Signed rs_link;
+    Dwarf_Unsigned rs_count;
+    struct Dwarf_Relocation_Data_s rs_rel[MAXREL];
+};
+
+struct output_s {
+    struct test_prodobj_s ou_po;
+    Dwarf_Unsigned ou_relcount;
+    struct relsect_s ou_rel[MAXRELSECT];
+};
+
+static void
+collect_relocations(Dwarf_P_Debug pdbg, struct output_s *out)
+{
+    Dwarf_Unsigned i = 0;
+    int drd_version = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_get_relocation_info_count(pdbg, &out->ou_relcount,
+        &drd_version, &error) == DW_DLV_OK);
+    CHECK(out->ou_relcount <= MAXRELSECT);
+    for (i = 0; i < out->ou_relcount && i < MAXRELSECT; ++i) {
+        struct relsect_s *rs = &out->ou_rel[i];
+        Dwarf_Relocation_Data data = 0;
+
+        CHECK(dwarf_get_relocation_info(pdbg, &rs->rs_sect,
+            &rs->rs_link, &rs->rs_count, &data, &error) ==
+            DW_DLV_OK);
+        CHECK(rs->rs_count <= MAXREL);
+        if (rs->rs_count <= MAXREL) {
+            memcpy(rs->rs_rel, data, rs->rs_count*sizeof(*data));
+        }
+    }
+}
+
+static void
+produce(struct output_s *out, const char *version,
+    int has_line, int order)
+{
+    Dwarf_P_Debug pdbg = 0;
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die die = 0;
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_P_Fde fde = 0;
+    Dwarf_Unsigned index = 0;
+    Dwarf_Unsigned cie = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Error error = 0;
+    struct runner_s runner;
+    Dwarf_Small cieinstrs[] = {0x0c,0x07,0x08,0x90,0x01};
+    Dwarf_Unsigned line = 0;
+
+    memset(&runner, 0, sizeof(runner));
+    runner.ru_order = order;
+    if (dwarf_producer_init(DW_DLC_WRITE | DW_DLC_POINTER64 |
+        DW_DLC_OFFSET32 | DW_DLC_SYMBOLIC_RELOCATIONS |
+        DW_DLC_TARGET_LITTLEENDIAN, test_prodobj_callback, 0, 0,
+        &out->ou_po, "x86_64", version, 0, &pdbg, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init %s\n", version);
+        exit(1);
+    }
+    if (order != RUN_SERIAL) {
+        CHECK(dwarf_pro_set_job_runner(pdbg, test_runner, &runner,
+            &error) == DW_DLV_OK);
+    }
+
+    CHECK(dwarf_new_die_a(pdbg, DW_TAG_compile_unit, 0, 0, 0, 0,
+        &cu, &error) == DW_DLV_OK);
+    CHECK(dwarf_add_AT_name_a(cu, "main.c", &attr, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_add_AT_comp_dir_a(cu, "/src", &attr, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_add_AT_targ_address_c(pdbg, cu, DW_AT_low_pc,
+        0x1000, 1, &attr, &error) == DW_DLV_OK);
+    CHECK(dwarf_new_die_a(pdbg, DW_TAG_subprogram, cu, 0, 0, 0,
+        &die, &error) == DW_DLV_OK);
+    CHECK(dwarf_add_AT_name_a(die, "main", &attr, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_add_AT_targ_address_c(pdbg, die, DW_AT_low_pc,
+        0x1000, 1, &attr, &error) == DW_DLV_OK);
+    CHECK(dwarf_new_die_a(pdbg, DW_TAG_subprogram, cu, 0, 0, 0,
+        &die, &error) == DW_DLV_OK);
+    CHECK(dwarf_add_AT_name_a(die, "helper", &attr, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_add_AT_targ_address_c(pdbg, die, DW_AT_low_pc,
+        0x1080, 1, &attr, &error) == DW_DLV_OK);
+    CHECK(dwarf_add_die_to_debug_a(pdbg, cu, &error) == DW_DLV_OK);
+
+    CHECK(dwarf_add_directory_decl_a(pdbg, "/src/include", &index,
+        &error) == DW_DLV_OK);
+    CHECK(dwarf_add_file_decl_a(pdbg, "main.c", 0, 0, 0, &index,
+        &error) == DW_DLV_OK);
+    CHECK(dwarf_add_file_decl_a(pdbg, "helper.h", 1, 0, 0, &index,
+        &error) == DW_DLV_OK);
+    CHECK(dwarf_lne_set_address_a(pdbg, 0x1000, 1, &error) ==
+        DW_DLV_OK);
+    for (line = 0; line < 8; ++line) {
+        CHECK(dwarf_add_line_entry_c(pdbg, (line < 4)? 1 : 2,
+            0x1000 + line*0x20, 10 + line*3, 1, 1, 0, 0, 0, 0, 0,
+            &error) == DW_DLV_OK);
+    }
+    CHECK(dwarf_lne_end_sequence_a(pdbg, 0x1100, &error) ==
+        DW_DLV_OK);
+
+    CHECK(dwarf_add_frame_cie_a(pdbg, "", 1, -8, 16, cieinstrs,
+        sizeof(cieinstrs), &cie, &error) == DW_DLV_OK);
+    CHECK(dwarf_new_fde_a(pdbg, &fde, &error) == DW_DLV_OK);
+    CHECK(dwarf_fde_cfa_offset_a(fde, 6, 2, &error) == DW_DLV_OK);
+    CHECK(dwarf_add_frame_fde_c(pdbg, fde, 0, cie, 0x1000, 0x80, 1,
+        0, 0, &index, &error) == DW_DLV_OK);
+
+    if (dwarf_transform_to_disk_form_a(pdbg, &count, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_transform_to_disk_form_a %s\n", version);
+        exit(1);
+    }
+    /*  Otherwise the line job was not split off and
+        nothing here was tested. */
+    CHECK(runner.ru_calls == (has_line && order != RUN_SERIAL));
+    CHECK(test_prodobj_collect(&out->ou_po, pdbg, count) ==
+        DW_DLV_OK);
+    collect_relocations(pdbg, out);
+    dwarf_producer_finish_a(pdbg, &error);
+}
+
+static int
+same_relocations(struct output_s *a, struct output_s *b)
+{
+    Dwarf_Unsigned i = 0;
+
+    if (a->ou_relcount != b->ou_relcount) {
+        return 0;
+    }
+    for (i = 0; i < a->ou_relcount && i < MAXRELSECT; ++i) {
+        struct relsect_s *ra = &a->ou_rel[i];
+        struct relsect_s *rb = &b->ou_rel[i];
+        Dwarf_Unsigned r = 0;
+
+        if (ra->rs_sect != rb->rs_sect ||
+            ra->rs_link != rb->rs_link ||
+            ra->rs_count != rb->rs_count) {
+            return 0;
+        }
+        for (r = 0; r < ra->rs_count && r < MAXREL; ++r) {
+            if (ra->rs_rel[r].drd_type != rb->rs_rel[r].drd_type ||
+                ra->rs_rel[r].drd_length !=
+                    rb->rs_rel[r].drd_length ||
+                ra->rs_rel[r].drd_offset !=
+                    rb->rs_rel[r].drd_offset ||
+                ra->rs_rel[r].drd_symbol_index !=
+                    rb->rs_rel[r].drd_symbol_index) {
+                return 0;
+            }
+        }
+    }
+    return 1;
+}
+
+static void
+compare(const char *version, const char *what,
+    struct output_s *serial, struct output_s *other)
+{
+    struct test_prodobj_s *a = &serial->ou_po;
+    struct test_prodobj_s *b = &other->ou_po;
+    unsigned n = 1;
+
+    if (a->po_count != b->po_count) {
+        printf("FAIL %s %s: %u sections, not %u\n", version, what,
+            b->po_count, a->po_count);
+        ++failcount;
+        return;
+    }
+    for ( ; n < a->po_count; ++n) {
+        struct test_prodobj_sect_s *sa = &a->po_sect[n];
+        struct test_prodobj_sect_s *sb = &b->po_sect[n];
+
+        if (strcmp(sa->ps_name, sb->ps_name) ||
+            sa->ps_size != sb->ps_size ||
+            (sa->ps_size &&
+            memcmp(sa->ps_data, sb->ps_data, sa->ps_size))) {
+            printf("FAIL %s %s: section %s differs\n", version, what,
+                sa->ps_name);
+            ++failcount;
+        }
+    }
+    if (!same_relocations(serial, other)) {
+        printf("FAIL %s %s: relocations differ\n", version, what);
+        ++failcount;
+    }
+}
+
+static void
+run(const char *version, int has_line)
+{
+    struct output_s *serial = 0;
+    struct output_s *other = 0;
+    Dwarf_Unsigned linesize = 0;
+
+    serial = (struct output_s *)calloc(1, sizeof(*serial));
+    other = (struct output_s *)calloc(1, sizeof(*other));
+    if (!serial || !other) {
+        printf("FAIL out of memory\n");
+        exit(1);
+    }
+    produce(serial, version, has_line, RUN_SERIAL);
+    CHECK((test_prodobj_section(&serial->ou_po, ".debug_line",
+        &linesize) != 0) == has_line);
+
+    produce(other, version, has_line, RUN_FORWARD);
+    compare(version, "forward runner", serial, other);
+    test_prodobj_free(&other->ou_po);
+    memset(other, 0, sizeof(*other));
+
+    produce(other, version, has_line, RUN_REVERSE);
+    compare(version, "reverse runner", serial, other);
+    test_prodobj_free(&other->ou_po);
+    test_prodobj_free(&serial->ou_po);
+    free(other);
+    free(serial);
+}
+
+int
+main(void)
+{
+    check_field_list();
+    run("V2", 1);
+    run("V4", 1);
+    run("V5", 0);
+    if (failcount) {
+        printf("FAIL test_line_job, %d failures\n", failcount);
+        exit(1);
+    }
+    printf("PASS test_line_job\n");
+    return 0;
+}
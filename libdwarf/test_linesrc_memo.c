@@ -0,0 +1,146 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  For every row of every line table in a DWARF4 and a
+    DWARF5 object, checks that dwarf_linesrc_b() and
+    dwarf_srclines_file_path() give the same path as
+    dwarf_linesrc(), and that it is computed once per
+    file entry: the same pointer for every row of a file. */
+
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+/*  Checks the rows of one line table.
+    Returns the number of rows compared. */
+static Dwarf_Unsigned
+check_rows(Dwarf_Debug dbg, Dwarf_Line_Context context,
+    unsigned version)
+{
+    Dwarf_Line *lines = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned compared = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_srclines_from_linecontext(context, &lines, &count,
+        &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return 0;
+    }
+    for (i = 0; i < count; ++i) {
+        char *name = 0;
+        const char *memo = 0;
+        const char *memo2 = 0;
+        const char *bypath = 0;
+        Dwarf_Unsigned fileno = 0;
+
+        res = dwarf_linesrc(lines[i], &name, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK) {
+            continue;
+        }
+        res = dwarf_linesrc_b(lines[i], &memo, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res == DW_DLV_OK && strcmp(name, memo)) {
+            printf("FAIL DWARF%u row %ld dwarf_linesrc %s "
+                "dwarf_linesrc_b %s\n", version, (long)i, name, memo);
+            ++test_failcount;
+        }
+        res = dwarf_linesrc_b(lines[i], &memo2, &error);
+        CHECK(res == DW_DLV_OK);
+        CHECK(memo2 == memo);
+        res = dwarf_line_srcfileno(lines[i], &fileno, &error);
+        CHECK(res == DW_DLV_OK);
+        res = dwarf_srclines_file_path(context, (Dwarf_Signed)fileno,
+            &bypath, &error);
+        CHECK(res == DW_DLV_OK);
+        CHECK(bypath == memo);
+        dwarf_dealloc(dbg, name, DW_DLA_STRING);
+        ++compared;
+    }
+    return compared;
+}
+
+static void
+check_object(Dwarf_Debug dbg, unsigned version)
+{
+    Dwarf_Unsigned compared = 0;
+    Dwarf_Error error = 0;
+
+    if (!dbg) {
+        return;
+    }
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned lineversion = 0;
+        Dwarf_Small table_count = 0;
+        Dwarf_Line_Context context = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        if (dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) !=
+            DW_DLV_OK) {
+            CHECK(0);
+            break;
+        }
+        res = dwarf_srclines_b(cu_die, &lineversion, &table_count,
+            &context, &error);
+        if (res == DW_DLV_OK) {
+            CHECK(lineversion == version);
+            compared += check_rows(dbg, context, version);
+            dwarf_srclines_dealloc_b(context);
+        } else {
+            CHECK(res == DW_DLV_NO_ENTRY);
+        }
+        dwarf_dealloc_die(cu_die);
+    }
+    CHECK(compared > 0);
+    dwarf_finish(dbg, &error);
+}
+
+int
+main(int argc, char **argv)
+{
+    check_object(test_open_fixture(argc, argv, 1,
+        "testobjO2DW4.elf"), 4);
+    check_object(test_open_fixture(argc, argv, 2,
+        "testobjO2DW5.elf"), 5);
+    return test_report("test_linesrc_memo");
+}
@@ -0,0 +1,379 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  For every location list checks dwarf_get_loclist_at_pc()
+    at each entry's first and last byte and just outside
+    each entry against a full dwarf_get_loclist_c() scan:
+    the first entry covering the pc, its cooked range
+    and its operators, else any DW_LLE_default_location
+    entry, or DW_DLV_NO_ENTRY.
+    A location expression must be returned for any pc.
+    Reads the .debug_loc of testobjO2DW4.elf, the
+    .debug_loclists of testobjO2DW5.elf and the split
+    testobjO2DW5split.dwo, tied to its executable so
+    DW_FORM_loclistx lists and DW_LLE_startx_length
+    entries are cooked through .debug_addr.
+    Each file must have location lists to check.
+    See testobjO2DW4.c.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+static int lists_checked = 0;
+static int pcs_checked = 0;
+static int pcs_uncovered = 0;
+static int exprs_checked = 0;
+static int lle_x_seen = 0;
+
+/*  Entry index of head with its cooked range and
+    expression. */
+static void
+get_entry(Dwarf_Loc_Head_c head, Dwarf_Unsigned index,
+    Dwarf_Small *lle, Dwarf_Addr *low, Dwarf_Addr *high,
+    Dwarf_Unsigned *opcount, Dwarf_Locdesc_c *desc,
+    Dwarf_Unsigned *exproff)
+{
+    Dwarf_Unsigned rawlow = 0;
+    Dwarf_Unsigned rawhigh = 0;
+    Dwarf_Bool unavailable = 0;
+    Dwarf_Small source = 0;
+    Dwarf_Unsigned locdesc_off = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_get_locdesc_entry_d(head, index, lle, &rawlow,
+        &rawhigh, &unavailable, low, high, opcount, desc, &source,
+        exproff, &locdesc_off, &error) == DW_DLV_OK);
+}
+
+/*  The operators of a and b must be the same. */
+static void
+compare_ops(Dwarf_Locdesc_c a, Dwarf_Locdesc_c b,
+    Dwarf_Unsigned count)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Small atom[2];
+        Dwarf_Unsigned op1[2], op2[2], op3[2], off[2];
+        Dwarf_Unsigned opd1 = 0;
+        Dwarf_Unsigned opd2 = 0;
+        Dwarf_Unsigned opd3 = 0;
+        Dwarf_Locdesc_c d[2];
+        int k = 0;
+
+        d[0] = a;
+        d[1] = b;
+        for (k = 0; k < 2; ++k) {
+            CHECK(dwarf_get_location_op_value_d(d[k], i, &atom[k],
+                &op1[k], &op2[k], &op3[k], &opd1, &opd2, &opd3, &off[k],
+                &error) == DW_DLV_OK);
+        }
+        CHECK(atom[0] == atom[1]);
+        CHECK(op1[0] == op1[1]);
+        CHECK(op2[0] == op2[1]);
+        CHECK(op3[0] == op3[1]);
+        CHECK(off[0] == off[1]);
+    }
+}
+
+/*  Entries that cover no addresses of their own.
+    The DW_LLEX and DW_LLE codes overlap, so the list
+    kind decides. */
+static int
+is_unbounded(unsigned int kind, Dwarf_Small lle)
+{
+    if (kind == DW_LKIND_loclists) {
+        return lle == DW_LLE_end_of_list ||
+            lle == DW_LLE_base_addressx ||
+            lle == DW_LLE_base_address ||
+            lle == DW_LLE_default_location;
+    }
+    return lle == DW_LLEX_base_address_selection_entry ||
+        lle == DW_LLEX_end_of_list_entry;
+}
+
+/*  The full scan answer: the first bounded entry of
+    head covering pc, else the first
+    DW_LLE_default_location entry, or -1. */
+static Dwarf_Signed
+reference_entry(Dwarf_Loc_Head_c head, unsigned int kind,
+    Dwarf_Unsigned count, Dwarf_Addr pc)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Signed deflt = -1;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Small lle = 0;
+        Dwarf_Addr low = 0;
+        Dwarf_Addr high = 0;
+        Dwarf_Unsigned opcount = 0;
+        Dwarf_Locdesc_c desc = 0;
+        Dwarf_Unsigned exproff = 0;
+
+        get_entry(head, i, &lle, &low, &high, &opcount, &desc,
+            &exproff);
+        if (kind == DW_LKIND_loclists &&
+            lle == DW_LLE_default_location) {
+            if (deflt < 0) {
+                deflt = (Dwarf_Signed)i;
+            }
+            continue;
+        }
+        if (is_unbounded(kind, lle)) {
+            continue;
+        }
+        if (low <= pc && pc < high) {
+            return (Dwarf_Signed)i;
+        }
+    }
+    return deflt;
+}
+
+static void
+check_pc(Dwarf_Attribute attr, Dwarf_Loc_Head_c head,
+    unsigned int kind, Dwarf_Unsigned count, Dwarf_Addr pc)
+{
+    Dwarf_Loc_Head_c onehead = 0;
+    Dwarf_Locdesc_c onedesc = 0;
+    Dwarf_Signed ref = reference_entry(head, kind, count, pc);
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    ++pcs_checked;
+    res = dwarf_get_loclist_at_pc(attr, pc, &onehead, &onedesc,
+        &error);
+    if (ref < 0) {
+        ++pcs_uncovered;
+        CHECK(res == DW_DLV_NO_ENTRY);
+        if (res == DW_DLV_OK) {
+            dwarf_loc_head_c_dealloc(onehead);
+        }
+        return;
+    }
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        Dwarf_Small lle[2];
+        Dwarf_Addr low[2], high[2];
+        Dwarf_Unsigned opcount[2], exproff[2];
+        Dwarf_Locdesc_c desc[2];
+
+        get_entry(head, (Dwarf_Unsigned)ref, &lle[0], &low[0],
+            &high[0], &opcount[0], &desc[0], &exproff[0]);
+        get_entry(onehead, 0, &lle[1], &low[1], &high[1],
+            &opcount[1], &desc[1], &exproff[1]);
+        CHECK(desc[1] == onedesc);
+        CHECK(lle[0] == lle[1]);
+        if (!(kind == DW_LKIND_loclists &&
+            lle[0] == DW_LLE_default_location)) {
+            CHECK(low[0] == low[1]);
+            CHECK(high[0] == high[1]);
+        }
+        CHECK(exproff[0] == exproff[1]);
+        CHECK(opcount[0] == opcount[1]);
+        if (opcount[0] == opcount[1]) {
+            compare_ops(desc[0], desc[1], opcount[0]);
+        }
+        dwarf_loc_head_c_dealloc(onehead);
+    }
+}
+
+static void
+check_attr(Dwarf_Attribute attr)
+{
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Unsigned count = 0;
+    unsigned int kind = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_get_loclist_c(attr, &head, &count, &error) !=
+        DW_DLV_OK) {
+        return;
+    }
+    CHECK(dwarf_get_loclist_head_kind(head, &kind, &error) ==
+        DW_DLV_OK);
+    if (kind == DW_LKIND_expression) {
+        Dwarf_Loc_Head_c onehead = 0;
+        Dwarf_Locdesc_c onedesc = 0;
+        Dwarf_Addr anypc[3] = {0, 0x1234, ~(Dwarf_Addr)0};
+        int k = 0;
+
+        for (k = 0; k < 3; ++k) {
+            CHECK(dwarf_get_loclist_at_pc(attr, anypc[k], &onehead,
+                &onedesc, &error) == DW_DLV_OK);
+            dwarf_loc_head_c_dealloc(onehead);
+            onehead = 0;
+        }
+        ++exprs_checked;
+    } else if (kind == DW_LKIND_loclist ||
+        kind == DW_LKIND_loclists) {
+        for (i = 0; i < count; ++i) {
+            Dwarf_Small lle = 0;
+            Dwarf_Addr low = 0;
+            Dwarf_Addr high = 0;
+            Dwarf_Unsigned opcount = 0;
+            Dwarf_Locdesc_c desc = 0;
+            Dwarf_Unsigned exproff = 0;
+
+            get_entry(head, i, &lle, &low, &high, &opcount, &desc,
+                &exproff);
+            if (kind == DW_LKIND_loclists &&
+                (lle == DW_LLE_startx_length ||
+                lle == DW_LLE_startx_endx ||
+                lle == DW_LLE_base_addressx)) {
+                ++lle_x_seen;
+            }
+            if (is_unbounded(kind, lle) || low >= high) {
+                continue;
+            }
+            check_pc(attr, head, kind, count, low);
+            check_pc(attr, head, kind, count, high - 1);
+            check_pc(attr, head, kind, count, high);
+            if (low) {
+                check_pc(attr, head, kind, count, low - 1);
+            }
+        }
+        check_pc(attr, head, kind, count, 0);
+        ++lists_checked;
+    }
+    dwarf_loc_head_c_dealloc(head);
+}
+
+static void
+walk(Dwarf_Debug dbg, Dwarf_Die die)
+{
+    Dwarf_Die cur = die;
+    Dwarf_Error error = 0;
+
+    for (;;) {
+        Dwarf_Attribute attr = 0;
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+
+        if (dwarf_attr(cur, DW_AT_location, &attr, &error) ==
+            DW_DLV_OK) {
+            check_attr(attr);
+            dwarf_dealloc_attribute(attr);
+        }
+        if (dwarf_attr(cur, DW_AT_frame_base, &attr, &error) ==
+            DW_DLV_OK) {
+            check_attr(attr);
+            dwarf_dealloc_attribute(attr);
+        }
+        if (dwarf_child(cur, &child, &error) == DW_DLV_OK) {
+            walk(dbg, child);
+        }
+        if (dwarf_siblingof_b(dbg, cur, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            break;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        cur = sib;
+    }
+    if (cur != die) {
+        dwarf_dealloc_die(cur);
+    }
+    dwarf_dealloc_die(die);
+}
+
+/*  Checks every list of dbg, returning the number
+    of lists checked. */
+static int
+check_file(Dwarf_Debug dbg)
+{
+    Dwarf_Error error = 0;
+
+    lists_checked = 0;
+    exprs_checked = 0;
+    pcs_checked = 0;
+    pcs_uncovered = 0;
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        if (dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) !=
+            DW_DLV_OK) {
+            CHECK(0);
+            break;
+        }
+        walk(dbg, cu_die);
+    }
+    CHECK(exprs_checked > 0);
+    CHECK(pcs_uncovered > 0);
+    CHECK(pcs_checked > pcs_uncovered);
+    return lists_checked;
+}
+
+int
+main(int argc, char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Debug exe = 0;
+    Dwarf_Error error = 0;
+
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(check_file(dbg) > 1);
+    dwarf_finish(dbg, &error);
+
+    /*  DWARF5 .debug_loclists, DW_FORM_sec_offset lists. */
+    dbg = test_open_fixture(argc, argv, 2, "testobjO2DW5.elf");
+    CHECK(check_file(dbg) > 1);
+    dwarf_finish(dbg, &error);
+
+    /*  A split unit: DW_FORM_loclistx lists in
+        .debug_loclists.dwo with addresses in the
+        executable's .debug_addr. */
+    lle_x_seen = 0;
+    exe = test_open_fixture(argc, argv, 3, "testobjO2DW5split.elf");
+    dbg = test_open_fixture(argc, argv, 4, "testobjO2DW5split.dwo");
+    CHECK(dwarf_set_tied_dbg(dbg, exe, &error) == DW_DLV_OK);
+    CHECK(check_file(dbg) > 1);
+    CHECK(lle_x_seen > 0);
+    dwarf_finish(dbg, &error);
+    dwarf_finish(exe, &error);
+
+    return test_report("test_loclist_at_pc");
+}
@@ -0,0 +1,536 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Builds .debug_info, .debug_abbrev, .debug_str and
+    .debug_macro by hand (the producer writes no
+    .debug_macro) and checks dwarf_get_macro_flattened():
+    imports expanded in place, a shared imported unit
+    giving the same entries for every CU, strings copied
+    out of .debug_macro, and an import loop reported as
+    DW_DLE_MACRO_IMPORT_LOOP without spoiling later calls.
+    Then, with .debug_macro compressed and a memory
+    budget set, that the decompressed copy is freed
+    only once no macro context pins it and the cached
+    units work on the copy decompressed again. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+#include "test_consumer.h"
+#ifdef HAVE_ZLIB
+#include "zlib.h"
+#endif /* HAVE_ZLIB */
+
+struct bytes_s {
+    unsigned char b_data[512];
+    unsigned      b_len;
+};
+
+static void
+put_byte(struct bytes_s *b, unsigned v)
+{
+    b->b_data[b->b_len++] = (unsigned char)v;
+}
+
+static void
+put_u16(struct bytes_s *b, unsigned v)
+{
+    put_byte(b, v & 0xff);
+    put_byte(b, (v >> 8) & 0xff);
+}
+
+static void
+put_u32(struct bytes_s *b, unsigned v)
+{
+    put_u16(b, v & 0xffff);
+    put_u16(b, (v >> 16) & 0xffff);
+}
+
+static void
+put_string(struct bytes_s *b, const char *s)
+{
+    size_t len = strlen(s) + 1;
+
+    memcpy(b->b_data + b->b_len, s, len);
+    b->b_len += (unsigned)len;
+}
+
+/*  A version 5 macro unit header, no line offset. */
+static unsigned
+begin_unit(struct bytes_s *b)
+{
+    unsigned offset = b->b_len;
+
+    put_u16(b, 5);
+    put_byte(b, 0);
+    return offset;
+}
+
+static void
+put_defundef(struct bytes_s *b, unsigned op, unsigned line,
+    const char *s)
+{
+    put_byte(b, op);
+    put_byte(b, line);
+    put_string(b, s);
+}
+
+static void
+put_import(struct bytes_s *b, unsigned target)
+{
+    put_byte(b, DW_MACRO_import);
+    put_u32(b, target);
+}
+
+/*  One DWARF4 CU with just DW_AT_macros, per unit offset. */
+static void
+put_cu(struct bytes_s *b, unsigned macro_offset)
+{
+    put_u32(b, 12);
+    put_u16(b, 4);
+    put_u32(b, 0);
+    put_byte(b, 8);
+    put_byte(b, 1);
+    put_u32(b, macro_offset);
+}
+
+static const char *expect_main[] = {
+    "M 1", "A 1", "B 2", "A", "S 7", 0 };
+static const Dwarf_Half expect_main_op[] = {
+    DW_MACRO_define, DW_MACRO_define, DW_MACRO_define,
+    DW_MACRO_undef, DW_MACRO_define };
+static const char *expect_second[] = {
+    "A 1", "B 2", "N 2", 0 };
+
+static void
+check_flat(Dwarf_Die cu_die, const char **expect,
+    const unsigned char *macro_data, Dwarf_Unsigned macro_size,
+    Dwarf_Unsigned shared_unit)
+{
+    Dwarf_Macro_Flat_Entry *entries = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_get_macro_flattened(cu_die, &entries, &count, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    for (i = 0; expect[i]; ++i) {
+        if (i >= count) {
+            break;
+        }
+        CHECK(!strcmp(entries[i].fe_string, expect[i]));
+        /*  Not a pointer into .debug_macro, which may
+            be evicted. */
+        CHECK((const unsigned char *)entries[i].fe_string <
+            macro_data ||
+            (const unsigned char *)entries[i].fe_string >=
+            macro_data + macro_size);
+        if (!strcmp(expect[i], "A 1") || !strcmp(expect[i], "B 2")) {
+            CHECK(entries[i].fe_unit_offset == shared_unit);
+        }
+    }
+    CHECK(i == count);
+    if (expect == expect_main) {
+        for (i = 0; i < count; ++i) {
+            CHECK(entries[i].fe_op == expect_main_op[i]);
+        }
+        CHECK(entries[0].fe_line == 1);
+        CHECK(entries[3].fe_line == 3);
+        CHECK(entries[4].fe_line == 4);
+    }
+    dwarf_dealloc_macro_flattened(entries);
+}
+
+/*  The macro context agrees with the flattened list
+    on the unit's own operators. */
+static void
+check_context(Dwarf_Debug dbg, Dwarf_Die cu_die)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Macro_Context mc = 0;
+    Dwarf_Unsigned unit_offset = 0;
+    Dwarf_Unsigned ops_count = 0;
+    Dwarf_Unsigned ops_len = 0;
+    Dwarf_Unsigned line = 0;
+    Dwarf_Unsigned index = 0;
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Half forms = 0;
+    const char *s = 0;
+    Dwarf_Unsigned target = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_get_macro_context(cu_die, &version, &mc,
+        &unit_offset, &ops_count, &ops_len, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    CHECK(version == 5);
+    /* define, import, undef, define_strp, the terminator */
+    CHECK(ops_count == 5);
+    res = dwarf_get_macro_defundef(mc, 0, &line, &index, &offset,
+        &forms, &s, &error);
+    CHECK(res == DW_DLV_OK && !strcmp(s, "M 1"));
+    res = dwarf_get_macro_import(mc, 1, &target, &error);
+    CHECK(res == DW_DLV_OK && target == 0);
+    res = dwarf_get_macro_defundef(mc, 3, &line, &index, &offset,
+        &forms, &s, &error);
+    CHECK(res == DW_DLV_OK && !strcmp(s, "S 7") && offset == 1);
+    dwarf_dealloc_macro_context(mc);
+    (void)dbg;
+}
+
+/*  Adds the sections to po.  With compress set
+    .debug_macro is written as .zdebug_macro: "ZLIB",
+    the size as 8 big-endian bytes, and the zlib data. */
+static int
+add_sections(struct test_prodobj_s *po, struct bytes_s *info,
+    struct bytes_s *abbrev, struct bytes_s *str,
+    struct bytes_s *mac, int compress)
+{
+    if (test_prodobj_add_section(po, ".debug_info",
+            info->b_data, info->b_len) != DW_DLV_OK ||
+        test_prodobj_add_section(po, ".debug_abbrev",
+            abbrev->b_data, abbrev->b_len) != DW_DLV_OK ||
+        test_prodobj_add_section(po, ".debug_str",
+            str->b_data, str->b_len) != DW_DLV_OK) {
+        return DW_DLV_ERROR;
+    }
+    if (!compress) {
+        return test_prodobj_add_section(po, ".debug_macro",
+            mac->b_data, mac->b_len);
+    }
+#ifdef HAVE_ZLIB
+    {
+        unsigned char z[12 + 1024];
+        uLongf zlen = sizeof(z) - 12;
+        int i = 0;
+
+        memcpy(z, "ZLIB", 4);
+        for (i = 0; i < 8; ++i) {
+            z[4 + i] = (unsigned char)
+                ((Dwarf_Unsigned)mac->b_len >> (8 * (7 - i)));
+        }
+        if (compress2(z + 12, &zlen, mac->b_data, mac->b_len,
+            Z_BEST_COMPRESSION) != Z_OK) {
+            return DW_DLV_ERROR;
+        }
+        return test_prodobj_add_section(po, ".zdebug_macro",
+            z, 12 + zlen);
+    }
+#else
+    return DW_DLV_ERROR;
+#endif /* HAVE_ZLIB */
+}
+
+/*  The DIEs of the three CUs. */
+static int
+get_cu_dies(Dwarf_Debug dbg, Dwarf_Die *cu_die)
+{
+    Dwarf_Unsigned next = 0;
+    Dwarf_Error error = 0;
+    int cus = 0;
+    int res = 0;
+
+    for (cus = 0; cus < 3; ++cus) {
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0,
+            0, 0, &next, 0, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_siblingof_b(dbg, 0, 1, &cu_die[cus], &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+    }
+    if (cus < 3) {
+        while (cus-- > 0) {
+            dwarf_dealloc(dbg, cu_die[cus], DW_DLA_DIE);
+        }
+        return DW_DLV_ERROR;
+    }
+    return DW_DLV_OK;
+}
+
+static void
+free_cu_dies(Dwarf_Debug dbg, Dwarf_Die *cu_die)
+{
+    int cus = 0;
+
+    for (cus = 0; cus < 3; ++cus) {
+        dwarf_dealloc(dbg, cu_die[cus], DW_DLA_DIE);
+    }
+}
+
+#ifdef HAVE_ZLIB
+static void
+get_evictions(Dwarf_Debug dbg, Dwarf_Unsigned *evictions,
+    Dwarf_Unsigned *reloads)
+{
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_get_section_memory_stats(dbg, 0, 0, evictions, 0,
+        reloads, &error) == DW_DLV_OK);
+}
+
+/*  Under a one byte budget the decompressed copy of
+    .debug_macro is freed once no Dwarf_Macro_Context
+    pins it, and decompressed again when next used. */
+static void
+check_budget(Dwarf_Debug dbg, Dwarf_Die *cu_die,
+    Dwarf_Unsigned shared, Dwarf_Unsigned macro_size)
+{
+    Dwarf_Unsigned version = 0;
+    Dwarf_Macro_Context mc = 0;
+    Dwarf_Unsigned unit_offset = 0;
+    Dwarf_Unsigned ops_count = 0;
+    Dwarf_Unsigned ops_len = 0;
+    Dwarf_Unsigned line = 0;
+    Dwarf_Unsigned index = 0;
+    Dwarf_Unsigned offset = 0;
+    Dwarf_Half forms = 0;
+    const char *s = 0;
+    Dwarf_Unsigned evictions = 0;
+    Dwarf_Unsigned reloads = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    check_flat(cu_die[0], expect_main, 0, 0, shared);
+    get_evictions(dbg, &evictions, &reloads);
+    CHECK(evictions == 0);
+
+    res = dwarf_get_macro_context(cu_die[0], &version, &mc,
+        &unit_offset, &ops_count, &ops_len, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    /*  Enforces the budget: the context pins the section. */
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    get_evictions(dbg, &evictions, &reloads);
+    CHECK(evictions == 0);
+    res = dwarf_get_macro_defundef(mc, 0, &line, &index, &offset,
+        &forms, &s, &error);
+    CHECK(res == DW_DLV_OK && !strcmp(s, "M 1"));
+    dwarf_dealloc_macro_context(mc);
+
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    get_evictions(dbg, &evictions, &reloads);
+    CHECK(evictions == 1);
+    CHECK(reloads == 0);
+
+    /*  The cached units hold offsets, so they work
+        on the reloaded copy. */
+    check_flat(cu_die[0], expect_main, 0, 0, shared);
+    check_flat(cu_die[1], expect_second, 0, 0, shared);
+    check_context(dbg, cu_die[0]);
+    get_evictions(dbg, &evictions, &reloads);
+    CHECK(reloads == 1);
+
+    for (;; ++i) {
+        const char *name = 0;
+        Dwarf_Unsigned loads = 0;
+        Dwarf_Unsigned decompressed = 0;
+
+        res = dwarf_get_section_perf_counters(dbg, i, &name, &loads,
+            0, &decompressed, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (!strcmp(name, ".zdebug_macro")) {
+            CHECK(loads == 2);
+            CHECK(decompressed == 2 * macro_size);
+            break;
+        }
+    }
+}
+#endif /* HAVE_ZLIB */
+
+int
+main(void)
+{
+    struct test_prodobj_s po;
+    struct bytes_s info;
+    struct bytes_s abbrev;
+    struct bytes_s str;
+    struct bytes_s mac;
+    unsigned shared = 0;
+    unsigned main_unit = 0;
+    unsigned second_unit = 0;
+    unsigned loop_d = 0;
+    unsigned loop_e = 0;
+    const unsigned char *macro_data = 0;
+    Dwarf_Unsigned macro_size = 0;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Die cu_die[3];
+    Dwarf_Macro_Flat_Entry *entries = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    memset(&po, 0, sizeof(po));
+    memset(&info, 0, sizeof(info));
+    memset(&abbrev, 0, sizeof(abbrev));
+    memset(&str, 0, sizeof(str));
+    memset(&mac, 0, sizeof(mac));
+
+    put_byte(&str, 0);
+    put_string(&str, "S 7");
+
+    /*  The common header unit imported by both CUs. */
+    shared = begin_unit(&mac);
+    put_defundef(&mac, DW_MACRO_define, 1, "A 1");
+    put_defundef(&mac, DW_MACRO_define, 2, "B 2");
+    put_byte(&mac, 0);
+
+    main_unit = begin_unit(&mac);
+    put_defundef(&mac, DW_MACRO_define, 1, "M 1");
+    put_import(&mac, shared);
+    put_defundef(&mac, DW_MACRO_undef, 3, "A");
+    put_byte(&mac, DW_MACRO_define_strp);
+    put_byte(&mac, 4);
+    put_u32(&mac, 1);
+    put_byte(&mac, 0);
+
+    second_unit = begin_unit(&mac);
+    put_import(&mac, shared);
+    put_defundef(&mac, DW_MACRO_define, 5, "N 2");
+    put_byte(&mac, 0);
+
+    /*  Two units importing each other.  A unit of
+        a header (3 bytes), one import (5) and the
+        terminator is 9 bytes long. */
+    loop_d = begin_unit(&mac);
+    put_import(&mac, loop_d + 9);
+    put_byte(&mac, 0);
+    loop_e = begin_unit(&mac);
+    put_import(&mac, loop_d);
+    put_byte(&mac, 0);
+    CHECK(loop_e == loop_d + 9);
+
+    put_byte(&abbrev, 1);
+    put_byte(&abbrev, DW_TAG_compile_unit);
+    put_byte(&abbrev, DW_CHILDREN_no);
+    put_byte(&abbrev, DW_AT_macros);
+    put_byte(&abbrev, DW_FORM_sec_offset);
+    put_byte(&abbrev, 0);
+    put_byte(&abbrev, 0);
+    put_byte(&abbrev, 0);
+
+    put_cu(&info, main_unit);
+    put_cu(&info, second_unit);
+    put_cu(&info, loop_d);
+
+    res = add_sections(&po, &info, &abbrev, &str, &mac, 0);
+    if (res != DW_DLV_OK) {
+        printf("FAIL building the sections\n");
+        return 1;
+    }
+    macro_data = test_prodobj_section(&po, ".debug_macro",
+        &macro_size);
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL test_prodobj_open\n");
+        return 1;
+    }
+    if (get_cu_dies(dbg, cu_die) == DW_DLV_OK) {
+        check_flat(cu_die[0], expect_main, macro_data, macro_size,
+            shared);
+        /*  The shared unit's list is remembered now. */
+        check_flat(cu_die[1], expect_second, macro_data, macro_size,
+            shared);
+        check_flat(cu_die[0], expect_main, macro_data, macro_size,
+            shared);
+        check_context(dbg, cu_die[0]);
+
+        res = dwarf_get_macro_flattened(cu_die[2], &entries, &count,
+            &error);
+        CHECK(res == DW_DLV_ERROR);
+        if (res == DW_DLV_ERROR) {
+            CHECK(dwarf_errno(error) == DW_DLE_MACRO_IMPORT_LOOP);
+            dwarf_dealloc(dbg, error, DW_DLA_ERROR);
+            error = 0;
+        }
+        /*  Again: the loop is found again, not
+            taken as a finished list. */
+        res = dwarf_get_macro_flattened(cu_die[2], &entries, &count,
+            &error);
+        CHECK(res == DW_DLV_ERROR);
+        if (res == DW_DLV_ERROR) {
+            CHECK(dwarf_errno(error) == DW_DLE_MACRO_IMPORT_LOOP);
+            dwarf_dealloc(dbg, error, DW_DLA_ERROR);
+            error = 0;
+        }
+        check_flat(cu_die[1], expect_second, macro_data, macro_size,
+            shared);
+        free_cu_dies(dbg, cu_die);
+    }
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+
+#ifdef HAVE_ZLIB
+    /*  The same with .debug_macro compressed, under
+        a budget. */
+    res = add_sections(&po, &info, &abbrev, &str, &mac, 1);
+    if (res != DW_DLV_OK) {
+        printf("FAIL building the compressed sections\n");
+        return 1;
+    }
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL test_prodobj_open compressed\n");
+        return 1;
+    }
+    if (get_cu_dies(dbg, cu_die) == DW_DLV_OK) {
+        check_budget(dbg, cu_die, shared, mac.b_len);
+        free_cu_dies(dbg, cu_die);
+    }
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+#endif /* HAVE_ZLIB */
+    return test_report("test_macro_flat");
+}
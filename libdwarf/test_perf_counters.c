@@ -0,0 +1,244 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Reads testobjO2DW4.elf (its DIEs, line tables and
+    frames) after dwarf_reset_perf_counters() and checks
+    the counters moved: CU contexts, abbreviations, line
+    programs, CIEs, FDEs and allocations, with the per
+    type allocation counts adding up to the total.  Then
+    that dwarf_get_perf_counters() honours pc_size, filling
+    in whole counters only up to it, and that a reset
+    zeroes everything again.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <stddef.h> /* For offsetof() */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+/*  Visits every DIE below die. */
+static void
+walk_children(Dwarf_Debug dbg, Dwarf_Die die)
+{
+    Dwarf_Die child = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_child(die, &child, &error) != DW_DLV_OK) {
+        return;
+    }
+    while (child) {
+        Dwarf_Die sib = 0;
+
+        walk_children(dbg, child);
+        if (dwarf_siblingof_b(dbg, child, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            sib = 0;
+        }
+        dwarf_dealloc_die(child);
+        child = sib;
+    }
+}
+
+/*  Reads every DIE and line table, then the frames. */
+static void
+run_library(Dwarf_Debug dbg)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Cie *cies = 0;
+    Dwarf_Signed ciecount = 0;
+    Dwarf_Fde *fdes = 0;
+    Dwarf_Signed fdecount = 0;
+    int res = 0;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned version = 0;
+        Dwarf_Small table_count = 0;
+        Dwarf_Line_Context context = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, &error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        res = dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK) {
+            continue;
+        }
+        walk_children(dbg, cu_die);
+        res = dwarf_srclines_b(cu_die, &version, &table_count,
+            &context, &error);
+        if (res == DW_DLV_OK) {
+            dwarf_srclines_dealloc_b(context);
+        }
+        dwarf_dealloc_die(cu_die);
+    }
+    res = dwarf_get_fde_list_eh(dbg, &cies, &ciecount, &fdes,
+        &fdecount, &error);
+    if (res == DW_DLV_NO_ENTRY) {
+        res = dwarf_get_fde_list(dbg, &cies, &ciecount, &fdes,
+            &fdecount, &error);
+    }
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        dwarf_fde_cie_list_dealloc(dbg, cies, ciecount, fdes,
+            fdecount);
+    }
+}
+
+static void
+get_counters(Dwarf_Debug dbg, Dwarf_Perf_Counters *pc)
+{
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    memset(pc, 0, sizeof(*pc));
+    pc->pc_size = sizeof(*pc);
+    res = dwarf_get_perf_counters(dbg, pc, &error);
+    CHECK(res == DW_DLV_OK);
+    CHECK(pc->pc_size == sizeof(*pc));
+}
+
+/*  The sum of the per type allocation counts. */
+static Dwarf_Unsigned
+sum_alloc_counts(Dwarf_Debug dbg, Dwarf_Unsigned *die_allocs)
+{
+    Dwarf_Unsigned sum = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    for (i = 0; ; ++i) {
+        Dwarf_Unsigned count = 0;
+
+        res = dwarf_get_perf_alloc_count(dbg, i, &count, &error);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        if (i == DW_DLA_DIE) {
+            *die_allocs = count;
+        }
+        sum += count;
+    }
+    CHECK(res == DW_DLV_NO_ENTRY);
+    /*  More DW_DLA types than libdwarf.h names. */
+    CHECK(i > DW_DLA_STR_OFFSETS);
+    return sum;
+}
+
+static void
+check_pc_size(Dwarf_Debug dbg, const Dwarf_Perf_Counters *full)
+{
+    Dwarf_Perf_Counters pc;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned sentinel = 0;
+    int res = 0;
+
+    memset(&sentinel, 0xa5, sizeof(sentinel));
+
+    /*  Room for three counters and part of a fourth. */
+    memset(&pc, 0xa5, sizeof(pc));
+    pc.pc_size = offsetof(Dwarf_Perf_Counters, pc_abbrev_decodes) + 3;
+    res = dwarf_get_perf_counters(dbg, &pc, &error);
+    CHECK(res == DW_DLV_OK);
+    CHECK(pc.pc_size ==
+        offsetof(Dwarf_Perf_Counters, pc_abbrev_decodes));
+    CHECK(pc.pc_sections_loaded == full->pc_sections_loaded);
+    CHECK(pc.pc_section_bytes_decompressed ==
+        full->pc_section_bytes_decompressed);
+    CHECK(pc.pc_abbrev_decodes == sentinel);
+    CHECK(pc.pc_allocs_total == sentinel);
+
+    /*  As from a caller with a larger struct. */
+    memset(&pc, 0, sizeof(pc));
+    pc.pc_size = 4 * sizeof(pc);
+    res = dwarf_get_perf_counters(dbg, &pc, &error);
+    CHECK(res == DW_DLV_OK);
+    CHECK(pc.pc_size == sizeof(pc));
+    CHECK(pc.pc_allocs_total == full->pc_allocs_total);
+
+    memset(&pc, 0, sizeof(pc));
+    pc.pc_size = sizeof(Dwarf_Unsigned) - 1;
+    res = dwarf_get_perf_counters(dbg, &pc, &error);
+    CHECK(res == DW_DLV_ERROR);
+    if (res == DW_DLV_ERROR) {
+        CHECK(dwarf_errno(error) == DW_DLE_PERF_COUNTERS_SIZE);
+        dwarf_dealloc_error(dbg, error);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Perf_Counters pc;
+    Dwarf_Unsigned die_allocs = 0;
+    Dwarf_Unsigned count = 0;
+
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_reset_perf_counters(dbg, &error) == DW_DLV_OK);
+    get_counters(dbg, &pc);
+    CHECK(pc.pc_cu_contexts_created == 0);
+    CHECK(pc.pc_allocs_total == 0);
+
+    run_library(dbg);
+    get_counters(dbg, &pc);
+    CHECK(pc.pc_sections_loaded > 0);
+    CHECK(pc.pc_section_bytes_loaded > 0);
+    CHECK(pc.pc_cu_contexts_created > 0);
+    CHECK(pc.pc_abbrev_decodes > 0);
+    CHECK(pc.pc_abbrev_hits > 0);
+    CHECK(pc.pc_line_programs_decoded > 0);
+    CHECK(pc.pc_cie_parses > 0);
+    CHECK(pc.pc_fde_parses > 0);
+    CHECK(pc.pc_tsearch_ops > 0);
+    CHECK(pc.pc_allocs_total > 0);
+    CHECK(sum_alloc_counts(dbg, &die_allocs) == pc.pc_allocs_total);
+    CHECK(die_allocs > 0);
+    check_pc_size(dbg, &pc);
+
+    CHECK(dwarf_reset_perf_counters(dbg, &error) == DW_DLV_OK);
+    get_counters(dbg, &pc);
+    CHECK(pc.pc_abbrev_decodes == 0);
+    CHECK(pc.pc_allocs_total == 0);
+    die_allocs = 1;
+    CHECK(sum_alloc_counts(dbg, &die_allocs) == 0);
+    CHECK(die_allocs == 0);
+    CHECK(dwarf_get_perf_alloc_count(dbg, ~(Dwarf_Unsigned)0, &count,
+        &error) == DW_DLV_NO_ENTRY);
+    dwarf_finish(dbg, &error);
+    return test_report("test_perf_counters");
+}
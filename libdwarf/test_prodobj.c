@@ -0,0 +1,245 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  See test_prodobj.h.  With symbolic relocations the
+    producer writes section offsets as plain values, and
+    every section is placed at address zero, so the bytes
+    need no relocating to be read back. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+
+int
+test_prodobj_callback(const char *name, int size,
+    Dwarf_Unsigned type, Dwarf_Unsigned flags,
+    Dwarf_Unsigned link, Dwarf_Unsigned info,
+    Dwarf_Unsigned *sect_name_index, void *user_data, int *error)
+{
+    struct test_prodobj_s *po = (struct test_prodobj_s *)user_data;
+    unsigned n = 0;
+
+    (void)size;
+    (void)type;
+    (void)flags;
+    (void)link;
+    (void)info;
+    if (po->po_count == 0) {
+        po->po_count = 1;
+    }
+    if (po->po_count >= TEST_PRODOBJ_MAXSECT) {
+        *error = DW_DLE_ELF_SECT_ERR;
+        return -1;
+    }
+    n = po->po_count++;
+    po->po_sect[n].ps_name = strdup(name);
+    *sect_name_index = n;
+    return (int)n;
+}
+
+int
+test_prodobj_collect(struct test_prodobj_s *po,
+    Dwarf_P_Debug pdbg, Dwarf_Signed count)
+{
+    Dwarf_Signed i = 0;
+
+    for (i = 0; i < count; ++i) {
+        Dwarf_Signed sect = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+        Dwarf_Error error = 0;
+        struct test_prodobj_sect_s *s = 0;
+        unsigned char *grown = 0;
+        int res = 0;
+
+        res = dwarf_get_section_bytes_a(pdbg, i, &sect, &len,
+            &bytes, &error);
+        if (res != DW_DLV_OK || sect <= 0 ||
+            sect >= (Dwarf_Signed)po->po_count) {
+            return DW_DLV_ERROR;
+        }
+        s = &po->po_sect[sect];
+        grown = (unsigned char *)realloc(s->ps_data,
+            s->ps_size + len + 1);
+        if (!grown) {
+            return DW_DLV_ERROR;
+        }
+        memcpy(grown + s->ps_size, bytes, len);
+        s->ps_data = grown;
+        s->ps_size += len;
+    }
+    return DW_DLV_OK;
+}
+
+const unsigned char *
+test_prodobj_section(struct test_prodobj_s *po,
+    const char *name, Dwarf_Unsigned *size_out)
+{
+    unsigned n = 1;
+
+    for ( ; n < po->po_count; ++n) {
+        if (po->po_sect[n].ps_data &&
+            !strcmp(po->po_sect[n].ps_name, name)) {
+            *size_out = po->po_sect[n].ps_size;
+            return po->po_sect[n].ps_data;
+        }
+    }
+    *size_out = 0;
+    return 0;
+}
+
+int
+test_prodobj_add_section(struct test_prodobj_s *po,
+    const char *name, const unsigned char *data,
+    Dwarf_Unsigned size)
+{
+    struct test_prodobj_sect_s *s = 0;
+
+    if (po->po_count == 0) {
+        po->po_count = 1;
+    }
+    if (po->po_count >= TEST_PRODOBJ_MAXSECT) {
+        return DW_DLV_ERROR;
+    }
+    s = &po->po_sect[po->po_count];
+    s->ps_name = strdup(name);
+    s->ps_data = (unsigned char *)malloc(size + 1);
+    if (!s->ps_name || !s->ps_data) {
+        return DW_DLV_ERROR;
+    }
+    memcpy(s->ps_data, data, size);
+    s->ps_size = size;
+    po->po_count++;
+    return DW_DLV_OK;
+}
+
+static int
+po_get_section_info(void *obj, Dwarf_Half section_index,
+    Dwarf_Obj_Access_Section *ret, int *error)
+{
+    struct test_prodobj_s *po = (struct test_prodobj_s *)obj;
+    struct test_prodobj_sect_s *s = 0;
+
+    if (section_index >= po->po_count) {
+        *error = DW_DLE_MDE;
+        return DW_DLV_ERROR;
+    }
+    s = &po->po_sect[section_index];
+    memset(ret, 0, sizeof(*ret));
+    /*  Sections with no bytes, the relocation
+        sections among them, are left unnamed
+        so libdwarf ignores them. */
+    ret->name = s->ps_data? s->ps_name : "";
+    ret->size = s->ps_size;
+    return DW_DLV_OK;
+}
+
+static Dwarf_Endianness
+po_get_byte_order(void *obj)
+{
+    (void)obj;
+    return DW_OBJECT_LSB;
+}
+
+static Dwarf_Small
+po_get_length_size(void *obj)
+{
+    (void)obj;
+    return 4;
+}
+
+static Dwarf_Small
+po_get_pointer_size(void *obj)
+{
+    (void)obj;
+    return 8;
+}
+
+static Dwarf_Unsigned
+po_get_section_count(void *obj)
+{
+    return ((struct test_prodobj_s *)obj)->po_count;
+}
+
+static int
+po_load_section(void *obj, Dwarf_Half section_index,
+    Dwarf_Small **return_data, int *error)
+{
+    struct test_prodobj_s *po = (struct test_prodobj_s *)obj;
+
+    if (section_index >= po->po_count) {
+        *error = DW_DLE_MDE;
+        return DW_DLV_ERROR;
+    }
+    if (!po->po_sect[section_index].ps_data) {
+        return DW_DLV_NO_ENTRY;
+    }
+    *return_data = po->po_sect[section_index].ps_data;
+    return DW_DLV_OK;
+}
+
+static const Dwarf_Obj_Access_Methods po_methods = {
+    po_get_section_info,
+    po_get_byte_order,
+    po_get_length_size,
+    po_get_pointer_size,
+    po_get_section_count,
+    po_load_section,
+    0 /* relocate_a_section */
+};
+
+int
+test_prodobj_open(struct test_prodobj_s *po, Dwarf_Debug *dbg_out)
+{
+    Dwarf_Error error = 0;
+
+    po->po_interface.object = po;
+    po->po_interface.methods = &po_methods;
+    return dwarf_object_init_b(&po->po_interface, 0, 0,
+        DW_GROUPNUMBER_ANY, dbg_out, &error);
+}
+
+void
+test_prodobj_free(struct test_prodobj_s *po)
+{
+    unsigned n = 0;
+
+    for ( ; n < po->po_count; ++n) {
+        free(po->po_sect[n].ps_name);
+        free(po->po_sect[n].ps_data);
+    }
+    memset(po, 0, sizeof(*po));
+}
@@ -0,0 +1,85 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+#ifndef TEST_PRODOBJ_H
+#define TEST_PRODOBJ_H
+
+/*  For the producer check programs: collects the sections
+    dwarf_transform_to_disk_form_a() generates and reads
+    them back through dwarf_object_init_b(), with no object
+    file in between.  The producer must be created with
+    DW_DLC_SYMBOLIC_RELOCATIONS, DW_DLC_TARGET_LITTLEENDIAN,
+    DW_DLC_POINTER64 and DW_DLC_OFFSET32, test_prodobj_callback
+    as its callback and the test_prodobj as its user_data.  */
+
+#define TEST_PRODOBJ_MAXSECT 64
+
+struct test_prodobj_sect_s {
+    char          *ps_name;
+    unsigned char *ps_data;
+    Dwarf_Unsigned ps_size;
+};
+
+struct test_prodobj_s {
+    /*  Indexed by the section number the callback
+        returned.  Entry 0 stays empty, as in Elf. */
+    struct test_prodobj_sect_s po_sect[TEST_PRODOBJ_MAXSECT];
+    unsigned po_count;
+    Dwarf_Obj_Access_Interface po_interface;
+};
+
+int test_prodobj_callback(const char *name, int size,
+    Dwarf_Unsigned type, Dwarf_Unsigned flags,
+    Dwarf_Unsigned link, Dwarf_Unsigned info,
+    Dwarf_Unsigned *sect_name_index, void *user_data, int *error);
+
+/*  Call after dwarf_transform_to_disk_form_a(), which
+    returned count. */
+int test_prodobj_collect(struct test_prodobj_s *po,
+    Dwarf_P_Debug pdbg, Dwarf_Signed count);
+
+/*  The bytes of the named section, or null. */
+const unsigned char *test_prodobj_section(struct test_prodobj_s *po,
+    const char *name, Dwarf_Unsigned *size_out);
+
+/*  Adds a section with a copy of the given bytes,
+    for sections the producer does not generate.
+    May be used with no producer at all. */
+int test_prodobj_add_section(struct test_prodobj_s *po,
+    const char *name, const unsigned char *data,
+    Dwarf_Unsigned size);
+
+/*  dwarf_finish() the returned dbg before
+    test_prodobj_free(). */
+int test_prodobj_open(struct test_prodobj_s *po, Dwarf_Debug *dbg_out);
+
+void test_prodobj_free(struct test_prodobj_s *po);
+
+#endif /* TEST_PRODOBJ_H */
@@ -0,0 +1,191 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Checks dwarf_pubnames_lookup() and
+    dwarf_pubnames_lookup_prefix() on the
+    .debug_gnu_pubnames of a split DWARF5 executable:
+    exact names, prefixes and names not there.  And that
+    both return DW_DLV_NO_ENTRY for an object with no
+    pubnames sections. */
+
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+/*  GDB index kind bytes: function, and static. */
+#define KIND_FUNCTION 0x30
+#define KIND_STATIC   0x80
+
+/*  The seven names of testobjO2DW5split.elf in
+    sorted order, with their offsets in the .dwo CU. */
+static const struct expect_s {
+    const char *e_name;
+    Dwarf_Off   e_die_offset;
+    Dwarf_Small e_flags;
+} expected[] = {
+{"coldf", 0x2bc, KIND_FUNCTION},
+{"helper",0x346, KIND_STATIC|KIND_FUNCTION},
+{"inner", 0x328, KIND_STATIC|KIND_FUNCTION},
+{"main",  0x209, KIND_FUNCTION},
+{"middle",0x303, KIND_STATIC|KIND_FUNCTION},
+{"other", 0x297, KIND_FUNCTION},
+{"work",  0x2de, KIND_FUNCTION}
+};
+#define EXPECTED_COUNT (sizeof(expected)/sizeof(expected[0]))
+
+static void
+check_match(const Dwarf_Pubname_Match *m, const struct expect_s *e)
+{
+    if (strcmp(m->pm_name, e->e_name)) {
+        printf("FAIL found %s, expected %s\n", m->pm_name, e->e_name);
+        ++test_failcount;
+        return;
+    }
+    CHECK(m->pm_cu_offset == 0);
+    CHECK(m->pm_die_offset == e->e_die_offset);
+    CHECK(m->pm_is_gnu);
+    CHECK(m->pm_gnu_flags == e->e_flags);
+}
+
+static void
+check_prefix(Dwarf_Debug dbg, const char *prefix,
+    unsigned first, unsigned count)
+{
+    const Dwarf_Pubname_Match *matches = 0;
+    Dwarf_Unsigned match_count = 0;
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    res = dwarf_pubnames_lookup_prefix(dbg, prefix, &matches,
+        &match_count, &error);
+    if (!count) {
+        CHECK(res == DW_DLV_NO_ENTRY);
+        return;
+    }
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    if (match_count != count) {
+        printf("FAIL prefix \"%s\" matched %lu, expected %u\n",
+            prefix, (unsigned long)match_count, count);
+        ++test_failcount;
+        return;
+    }
+    for (i = 0; i < count; ++i) {
+        check_match(matches + i, expected + first + i);
+    }
+}
+
+static void
+check_names(Dwarf_Debug dbg)
+{
+    const Dwarf_Pubname_Match *matches = 0;
+    Dwarf_Unsigned match_count = 0;
+    Dwarf_Error error = 0;
+    unsigned i = 0;
+    int res = 0;
+
+    for (i = 0; i < EXPECTED_COUNT; ++i) {
+        res = dwarf_pubnames_lookup(dbg, expected[i].e_name,
+            &matches, &match_count, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res == DW_DLV_OK) {
+            CHECK(match_count == 1);
+            check_match(matches, expected + i);
+        }
+    }
+    /*  Exact lookup does not match a prefix or a
+        longer name. */
+    CHECK(dwarf_pubnames_lookup(dbg, "mai", &matches, &match_count,
+        &error) == DW_DLV_NO_ENTRY);
+    CHECK(dwarf_pubnames_lookup(dbg, "mainly", &matches,
+        &match_count, &error) == DW_DLV_NO_ENTRY);
+    CHECK(dwarf_pubnames_lookup(dbg, "nosuchname", &matches,
+        &match_count, &error) == DW_DLV_NO_ENTRY);
+    CHECK(dwarf_pubnames_lookup(dbg, "", &matches, &match_count,
+        &error) == DW_DLV_NO_ENTRY);
+
+    check_prefix(dbg, "", 0, EXPECTED_COUNT);
+    check_prefix(dbg, "m", 3, 2);
+    check_prefix(dbg, "mid", 4, 1);
+    check_prefix(dbg, "main", 3, 1);
+    check_prefix(dbg, "w", 6, 1);
+    check_prefix(dbg, "c", 0, 1);
+    check_prefix(dbg, "a", 0, 0);
+    check_prefix(dbg, "mz", 0, 0);
+    check_prefix(dbg, "zz", 0, 0);
+    check_prefix(dbg, "mainly", 0, 0);
+}
+
+static void
+check_split(Dwarf_Debug dbg)
+{
+    Dwarf_Error error = 0;
+
+    if (!dbg) {
+        return;
+    }
+    check_names(dbg);
+    /*  A cleared index is built again on the next call. */
+    dwarf_pubnames_index_clear(dbg);
+    check_names(dbg);
+    dwarf_finish(dbg, &error);
+}
+
+static void
+check_empty(Dwarf_Debug dbg)
+{
+    const Dwarf_Pubname_Match *matches = 0;
+    Dwarf_Unsigned match_count = 0;
+    Dwarf_Error error = 0;
+
+    if (!dbg) {
+        return;
+    }
+    CHECK(dwarf_pubnames_lookup(dbg, "main", &matches, &match_count,
+        &error) == DW_DLV_NO_ENTRY);
+    CHECK(dwarf_pubnames_lookup_prefix(dbg, "", &matches,
+        &match_count, &error) == DW_DLV_NO_ENTRY);
+    dwarf_finish(dbg, &error);
+}
+
+int
+main(int argc, char **argv)
+{
+    check_split(test_open_fixture(argc, argv, 1,
+        "testobjO2DW5split.elf"));
+    check_empty(test_open_fixture(argc, argv, 2,
+        "testobjO2DW4.elf"));
+    return test_report("test_pubnames_lookup");
+}
@@ -0,0 +1,433 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Checks dwarf_range_iter_begin() and
+    dwarf_range_iter_next() for every DW_AT_ranges list
+    against dwarf_get_ranges_a() (DWARF4) or
+    dwarf_rnglists_get_rle_head() (DWARF5), with and
+    without the list cache, and with .debug_ranges
+    evicted (by reading a location list under a one
+    byte section budget) between next() calls.
+    Reads testobjO2DW4.elf, testobjO2DW5.elf and the
+    split testobjO2DW5split.dwo, tied to its executable
+    so DW_RLE_base_addressx and DW_RLE_startx_length
+    are cooked through .debug_addr.  See testobjO2DW4.c.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+#define MAXPAIRS 64
+
+static int listcount = 0;
+static int rle_x_seen = 0;
+
+static int
+add_pair(Dwarf_Addr *pairs, int n, Dwarf_Addr low, Dwarf_Addr high)
+{
+    if (low >= high) {
+        return n;
+    }
+    if (n < MAXPAIRS) {
+        pairs[2*n] = low;
+        pairs[2*n+1] = high;
+    }
+    return n+1;
+}
+
+/*  The cooked pairs of a .debug_ranges list, the long
+    way round.  Returns the pair count. */
+static int
+reference_ranges(Dwarf_Debug dbg, Dwarf_Die die,
+    Dwarf_Attribute attr, Dwarf_Addr *pairs)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Off cu_off = 0;
+    Dwarf_Die cu_die = 0;
+    Dwarf_Addr base = 0;
+    Dwarf_Ranges *ranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned bytes = 0;
+    Dwarf_Error error = 0;
+    int n = 0;
+
+    CHECK(dwarf_global_formref(attr, &off, &error) == DW_DLV_OK);
+    CHECK(dwarf_CU_dieoffset_given_die(die, &cu_off, &error) ==
+        DW_DLV_OK);
+    if (dwarf_offdie_b(dbg, cu_off, 1, &cu_die, &error) ==
+        DW_DLV_OK) {
+        if (dwarf_lowpc(cu_die, &base, &error) != DW_DLV_OK) {
+            base = 0;
+        }
+        dwarf_dealloc_die(cu_die);
+    }
+    if (dwarf_get_ranges_a(dbg, off, die, &ranges, &count,
+        &bytes, &error) != DW_DLV_OK) {
+        CHECK(0);
+        return 0;
+    }
+    for (i = 0; i < count; ++i) {
+        if (ranges[i].dwr_type == DW_RANGES_ADDRESS_SELECTION) {
+            base = ranges[i].dwr_addr2;
+            continue;
+        }
+        if (ranges[i].dwr_type != DW_RANGES_ENTRY) {
+            continue;
+        }
+        n = add_pair(pairs, n, ranges[i].dwr_addr1 + base,
+            ranges[i].dwr_addr2 + base);
+    }
+    dwarf_ranges_dealloc(dbg, ranges, count);
+    return n;
+}
+
+/*  The cooked pairs of a .debug_rnglists list, from
+    the entries dwarf_rnglists_get_rle_head() reads.
+    Returns the pair count. */
+static int
+reference_rnglists(Dwarf_Attribute attr, Dwarf_Addr *pairs)
+{
+    Dwarf_Half form = 0;
+    Dwarf_Unsigned value = 0;
+    Dwarf_Rnglists_Head head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned global_offset = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int n = 0;
+    int res = 0;
+
+    CHECK(dwarf_whatform(attr, &form, &error) == DW_DLV_OK);
+    if (form == DW_FORM_rnglistx) {
+        res = dwarf_formudata(attr, &value, &error);
+    } else {
+        Dwarf_Off off = 0;
+
+        res = dwarf_global_formref(attr, &off, &error);
+        value = off;
+    }
+    CHECK(res == DW_DLV_OK);
+    res = dwarf_rnglists_get_rle_head(attr, form, value, &head,
+        &count, &global_offset, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return 0;
+    }
+    for (i = 0; i < count; ++i) {
+        unsigned entrylen = 0;
+        unsigned code = 0;
+        Dwarf_Unsigned raw1 = 0;
+        Dwarf_Unsigned raw2 = 0;
+        Dwarf_Bool unavailable = 0;
+        Dwarf_Unsigned low = 0;
+        Dwarf_Unsigned high = 0;
+
+        res = dwarf_get_rnglists_entry_fields_a(head, i, &entrylen,
+            &code, &raw1, &raw2, &unavailable, &low, &high, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK || code == DW_RLE_end_of_list) {
+            break;
+        }
+        CHECK(!unavailable);
+        switch (code) {
+        case DW_RLE_base_addressx:
+        case DW_RLE_startx_endx:
+        case DW_RLE_startx_length:
+            ++rle_x_seen;
+            break;
+        default:
+            break;
+        }
+        if (code == DW_RLE_base_addressx ||
+            code == DW_RLE_base_address) {
+            continue;
+        }
+        n = add_pair(pairs, n, low, high);
+    }
+    dwarf_dealloc_rnglists_head(head);
+    return n;
+}
+
+static int
+reference_pairs(Dwarf_Debug dbg, Dwarf_Die die,
+    Dwarf_Attribute attr, Dwarf_Addr *pairs)
+{
+    Dwarf_Half version = 0;
+    Dwarf_Half offset_size = 0;
+
+    CHECK(dwarf_get_version_of_die(die, &version, &offset_size) ==
+        DW_DLV_OK);
+    if (version >= 5) {
+        return reference_rnglists(attr, pairs);
+    }
+    return reference_ranges(dbg, die, attr, pairs);
+}
+
+/*  Reads the location list of the DIE at loc_die_offset,
+    which loads .debug_loc and, under a one byte
+    budget, evicts .debug_ranges. */
+static void
+read_a_loclist(Dwarf_Debug dbg, Dwarf_Off loc_die_offset)
+{
+    Dwarf_Die die = 0;
+    Dwarf_Attribute attr = 0;
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_offdie_b(dbg, loc_die_offset, 1, &die, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_attr(die, DW_AT_location, &attr, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_get_loclist_c(attr, &head, &count, &error) ==
+        DW_DLV_OK);
+    dwarf_loc_head_c_dealloc(head);
+    dwarf_dealloc_attribute(attr);
+    dwarf_dealloc_die(die);
+}
+
+static Dwarf_Unsigned
+evictions_of(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned resident = 0;
+    Dwarf_Unsigned peak = 0;
+    Dwarf_Unsigned evictions = 0;
+    Dwarf_Unsigned bytes = 0;
+    Dwarf_Unsigned reloads = 0;
+    Dwarf_Error error = 0;
+
+    dwarf_get_section_memory_stats(dbg, &resident, &peak,
+        &evictions, &bytes, &reloads, &error);
+    return evictions;
+}
+
+static void
+check_die(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Off loc_die_offset)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Addr pairs[2*MAXPAIRS];
+    Dwarf_Range_Iter it;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Error error = 0;
+    int n = 0;
+    int k = 0;
+    int res = 0;
+
+    if (dwarf_attr(die, DW_AT_ranges, &attr, &error) != DW_DLV_OK) {
+        return;
+    }
+    n = reference_pairs(dbg, die, attr, pairs);
+    dwarf_dealloc_attribute(attr);
+    CHECK(n > 1 && n <= MAXPAIRS);
+    ++listcount;
+
+    res = dwarf_range_iter_begin(die, &it, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return;
+    }
+    while ((res = dwarf_range_iter_next(&it, &low, &high,
+        &error)) == DW_DLV_OK) {
+        CHECK(k < n && pairs[2*k] == low && pairs[2*k+1] == high);
+        ++k;
+        if (k == 1 && loc_die_offset) {
+            Dwarf_Unsigned before = evictions_of(dbg);
+
+            read_a_loclist(dbg, loc_die_offset);
+            CHECK(evictions_of(dbg) > before);
+        }
+    }
+    CHECK(res == DW_DLV_NO_ENTRY);
+    CHECK(k == n);
+}
+
+/*  Calls check_die() on die, its children, and its
+    later siblings.  Sets *first_loc_die, if not yet
+    set, to the offset of a DIE with a DW_AT_location
+    list. */
+static void
+walk(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Off loc_die_offset,
+    Dwarf_Off *first_loc_die)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Die cur = die;
+
+    while (cur) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        Dwarf_Attribute attr = 0;
+
+        if (!*first_loc_die &&
+            dwarf_attr(cur, DW_AT_location, &attr, &error) ==
+            DW_DLV_OK) {
+            Dwarf_Half form = 0;
+
+            dwarf_whatform(attr, &form, &error);
+            if (form == DW_FORM_sec_offset) {
+                dwarf_dieoffset(cur, first_loc_die, &error);
+            }
+            dwarf_dealloc_attribute(attr);
+        }
+        check_die(dbg, cur, loc_die_offset);
+        if (dwarf_child(cur, &child, &error) == DW_DLV_OK) {
+            walk(dbg, child, loc_die_offset, first_loc_die);
+            dwarf_dealloc_die(child);
+        }
+        if (dwarf_siblingof_b(dbg, cur, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            sib = 0;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        cur = sib;
+    }
+}
+
+static void
+walk_all(Dwarf_Debug dbg, Dwarf_Off loc_die_offset,
+    Dwarf_Off *first_loc_die)
+{
+    Dwarf_Error error = 0;
+
+    for (;;) {
+        Dwarf_Unsigned hlen = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_off = 0;
+        Dwarf_Half asize = 0;
+        Dwarf_Half osize = 0;
+        Dwarf_Half xsize = 0;
+        Dwarf_Sig8 sig;
+        Dwarf_Unsigned typeoff = 0;
+        Dwarf_Unsigned next = 0;
+        Dwarf_Half utype = 0;
+        Dwarf_Die cu_die = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, &hlen, &version,
+            &abbrev_off, &asize, &osize, &xsize, &sig, &typeoff,
+            &next, &utype, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        res = dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res == DW_DLV_OK) {
+            walk(dbg, cu_die, loc_die_offset, first_loc_die);
+            dwarf_dealloc_die(cu_die);
+        }
+    }
+}
+
+/*  Iterates every list of a DWARF5 object, plain and
+    through the list cache.  Returns the list count. */
+static int
+check_dwarf5(Dwarf_Debug dbg)
+{
+    Dwarf_Off loc_die = 0;
+    Dwarf_Error error = 0;
+    int lists = 0;
+
+    listcount = 0;
+    walk_all(dbg, 0, &loc_die);
+    lists = listcount;
+    CHECK(dwarf_range_cache_set_size(dbg, 4, &error) == DW_DLV_OK);
+    walk_all(dbg, 0, &loc_die);
+    walk_all(dbg, 0, &loc_die);
+    CHECK(listcount == 3*lists);
+    return lists;
+}
+
+int
+main(int argc, char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Debug exe = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Off loc_die = 0;
+    int lists = 0;
+
+    /*  Plain iteration, which also finds a DIE with
+        a location list. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    walk_all(dbg, 0, &loc_die);
+    lists = listcount;
+    CHECK(lists > 1);
+    CHECK(loc_die != 0);
+    dwarf_finish(dbg, &error);
+
+    /*  Through the list cache. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_range_cache_set_size(dbg, 4, &error) == DW_DLV_OK);
+    listcount = 0;
+    walk_all(dbg, 0, &loc_die);
+    walk_all(dbg, 0, &loc_die);
+    CHECK(listcount == 2*lists);
+    dwarf_finish(dbg, &error);
+
+    /*  .debug_ranges evicted after the first pair of
+        every list: the iterator must reload it. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    listcount = 0;
+    walk_all(dbg, loc_die, &loc_die);
+    CHECK(listcount == lists);
+    dwarf_finish(dbg, &error);
+
+    /*  DWARF5 .debug_rnglists, DW_FORM_sec_offset lists
+        with DW_RLE_offset_pair and DW_RLE_start_length. */
+    dbg = test_open_fixture(argc, argv, 2, "testobjO2DW5.elf");
+    CHECK(check_dwarf5(dbg) > 1);
+    dwarf_finish(dbg, &error);
+
+    /*  A split unit: DW_FORM_rnglistx lists in
+        .debug_rnglists.dwo with addresses in the
+        executable's .debug_addr. */
+    rle_x_seen = 0;
+    exe = test_open_fixture(argc, argv, 3, "testobjO2DW5split.elf");
+    dbg = test_open_fixture(argc, argv, 4, "testobjO2DW5split.dwo");
+    CHECK(dwarf_set_tied_dbg(dbg, exe, &error) == DW_DLV_OK);
+    CHECK(check_dwarf5(dbg) > 1);
+    CHECK(rle_x_seen > 0);
+    dwarf_finish(dbg, &error);
+    dwarf_finish(exe, &error);
+
+    return test_report("test_range_iter");
+}
@@ -0,0 +1,445 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Checks dwarf_set_section_memory_budget():
+    reading everything in .debug_loc, .debug_ranges
+    and .debug_aranges under a tiny budget gives the
+    same answers as with no budget while evicting
+    and reloading, a budget covering just the
+    evictable sections evicts nothing, data
+    handed out by dwarf_get_loclist_entry() stays
+    valid after .debug_loc would have been evicted,
+    and a dwarf_loclist_n() list keeps .debug_loc
+    loaded only till it is dealloc'd.
+    Reads testobjO2DW4.elf, see testobjO2DW4.c.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+/*  The .debug_loc offset of the first location list
+    seen, for dwarf_get_loclist_entry(). */
+static Dwarf_Off first_loclist_offset = 0;
+static int have_loclist_offset = 0;
+
+/*  Set to have sum_die_tree() keep the
+    dwarf_loclist_n() list of the first location
+    list attribute it sees. */
+static int hold_old_loclist = 0;
+static Dwarf_Locdesc **held_llbuf = 0;
+static Dwarf_Signed held_count = 0;
+
+/*  Mixes every value read into one number so two
+    passes can be compared. */
+static Dwarf_Unsigned
+mix(Dwarf_Unsigned sum, Dwarf_Unsigned v)
+{
+    return (sum * 1000003) ^ v;
+}
+
+static Dwarf_Unsigned
+sum_loclist(Dwarf_Attribute attr, Dwarf_Unsigned sum)
+{
+    Dwarf_Loc_Head_c head = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_get_loclist_c(attr, &head, &count, &error);
+    CHECK(res != DW_DLV_ERROR);
+    if (res != DW_DLV_OK) {
+        return sum;
+    }
+    for (i = 0; i < count; ++i) {
+        Dwarf_Small lle = 0;
+        Dwarf_Unsigned rawlo = 0;
+        Dwarf_Unsigned rawhi = 0;
+        Dwarf_Bool unavail = 0;
+        Dwarf_Addr lo = 0;
+        Dwarf_Addr hi = 0;
+        Dwarf_Unsigned opcount = 0;
+        Dwarf_Locdesc_c desc = 0;
+        Dwarf_Small source = 0;
+        Dwarf_Unsigned exproff = 0;
+        Dwarf_Unsigned descoff = 0;
+        Dwarf_Unsigned j = 0;
+
+        res = dwarf_get_locdesc_entry_d(head, i, &lle,
+            &rawlo, &rawhi, &unavail, &lo, &hi, &opcount,
+            &desc, &source, &exproff, &descoff, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res != DW_DLV_OK) {
+            break;
+        }
+        sum = mix(sum, lo);
+        sum = mix(sum, hi);
+        for (j = 0; j < opcount; ++j) {
+            Dwarf_Small op = 0;
+            Dwarf_Unsigned o1 = 0;
+            Dwarf_Unsigned o2 = 0;
+            Dwarf_Unsigned o3 = 0;
+            Dwarf_Unsigned offsetforbranch = 0;
+
+            res = dwarf_get_location_op_value_c(desc, j,
+                &op, &o1, &o2, &o3, &offsetforbranch, &error);
+            CHECK(res == DW_DLV_OK);
+            sum = mix(sum, op);
+            sum = mix(sum, o1);
+        }
+    }
+    dwarf_loc_head_c_dealloc(head);
+    return sum;
+}
+
+static Dwarf_Unsigned
+sum_ranges(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Attribute attr,
+    Dwarf_Unsigned sum)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Ranges *ranges = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Unsigned bytes = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_global_formref(attr, &off, &error);
+    CHECK(res == DW_DLV_OK);
+    res = dwarf_get_ranges_a(dbg, off, die, &ranges, &count,
+        &bytes, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        return sum;
+    }
+    for (i = 0; i < count; ++i) {
+        sum = mix(sum, ranges[i].dwr_addr1);
+        sum = mix(sum, ranges[i].dwr_addr2);
+    }
+    dwarf_ranges_dealloc(dbg, ranges, count);
+    return sum;
+}
+
+/*  Sums die, its children, and its later siblings.
+    The caller deallocs die itself. */
+static Dwarf_Unsigned
+sum_die_tree(Dwarf_Debug dbg, Dwarf_Die die, Dwarf_Unsigned sum)
+{
+    Dwarf_Error error = 0;
+    Dwarf_Die cur = die;
+
+    while (cur) {
+        Dwarf_Die child = 0;
+        Dwarf_Die sib = 0;
+        Dwarf_Attribute attr = 0;
+
+        if (dwarf_attr(cur, DW_AT_location, &attr, &error) ==
+            DW_DLV_OK) {
+            Dwarf_Half form = 0;
+
+            dwarf_whatform(attr, &form, &error);
+            if (form == DW_FORM_sec_offset) {
+                if (!have_loclist_offset &&
+                    dwarf_global_formref(attr,
+                    &first_loclist_offset, &error) == DW_DLV_OK) {
+                    have_loclist_offset = 1;
+                }
+                if (hold_old_loclist && !held_llbuf) {
+                    CHECK(dwarf_loclist_n(attr, &held_llbuf,
+                        &held_count, &error) == DW_DLV_OK);
+                }
+                sum = sum_loclist(attr, sum);
+            }
+            dwarf_dealloc_attribute(attr);
+        }
+        if (dwarf_attr(cur, DW_AT_ranges, &attr, &error) ==
+            DW_DLV_OK) {
+            sum = sum_ranges(dbg, cur, attr, sum);
+            dwarf_dealloc_attribute(attr);
+        }
+        if (dwarf_child(cur, &child, &error) == DW_DLV_OK) {
+            sum = sum_die_tree(dbg, child, sum);
+            dwarf_dealloc_die(child);
+        }
+        if (dwarf_siblingof_b(dbg, cur, 1, &sib, &error) !=
+            DW_DLV_OK) {
+            sib = 0;
+        }
+        if (cur != die) {
+            dwarf_dealloc_die(cur);
+        }
+        cur = sib;
+    }
+    return sum;
+}
+
+/*  Reads every location list, range list and arange
+    of dbg. */
+static Dwarf_Unsigned
+sum_everything(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned sum = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Arange *aranges = 0;
+    Dwarf_Signed acount = 0;
+    Dwarf_Signed i = 0;
+
+    for (;;) {
+        Dwarf_Unsigned hlen = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev_off = 0;
+        Dwarf_Half asize = 0;
+        Dwarf_Half osize = 0;
+        Dwarf_Half xsize = 0;
+        Dwarf_Sig8 sig;
+        Dwarf_Unsigned typeoff = 0;
+        Dwarf_Unsigned next = 0;
+        Dwarf_Half utype = 0;
+        Dwarf_Die cu_die = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, &hlen, &version,
+            &abbrev_off, &asize, &osize, &xsize, &sig, &typeoff,
+            &next, &utype, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        res = dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error);
+        CHECK(res == DW_DLV_OK);
+        if (res == DW_DLV_OK) {
+            sum = sum_die_tree(dbg, cu_die, sum);
+            dwarf_dealloc_die(cu_die);
+        }
+    }
+    if (dwarf_get_aranges(dbg, &aranges, &acount, &error) ==
+        DW_DLV_OK) {
+        for (i = 0; i < acount; ++i) {
+            Dwarf_Unsigned seg = 0;
+            Dwarf_Unsigned segsize = 0;
+            Dwarf_Addr start = 0;
+            Dwarf_Unsigned length = 0;
+            Dwarf_Off cuoff = 0;
+
+            dwarf_get_arange_info_b(aranges[i], &seg, &segsize,
+                &start, &length, &cuoff, &error);
+            sum = mix(sum, start);
+            sum = mix(sum, length);
+            dwarf_dealloc(dbg, aranges[i], DW_DLA_ARANGE);
+        }
+        dwarf_dealloc(dbg, aranges, DW_DLA_LIST);
+    }
+    return sum;
+}
+
+static Dwarf_Unsigned
+section_size(Dwarf_Debug dbg, const char *name)
+{
+    Dwarf_Addr addr = 0;
+    Dwarf_Unsigned size = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_get_section_info_by_name(dbg, name, &addr, &size,
+        &error) != DW_DLV_OK) {
+        return 0;
+    }
+    return size;
+}
+
+/*  How many times .debug_loc was read in. */
+static Dwarf_Unsigned
+loc_load_count(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+
+    for (;; ++i) {
+        const char *name = 0;
+        Dwarf_Unsigned loads = 0;
+
+        if (dwarf_get_section_perf_counters(dbg, i, &name, &loads,
+            0, 0, &error) != DW_DLV_OK) {
+            return 0;
+        }
+        if (!strcmp(name, ".debug_loc")) {
+            return loads;
+        }
+    }
+}
+
+static void
+free_held_loclist(Dwarf_Debug dbg)
+{
+    Dwarf_Signed i = 0;
+
+    for (i = 0; i < held_count; ++i) {
+        dwarf_dealloc(dbg, held_llbuf[i]->ld_s, DW_DLA_LOC_BLOCK);
+        dwarf_dealloc(dbg, held_llbuf[i], DW_DLA_LOCDESC);
+    }
+    dwarf_dealloc(dbg, held_llbuf, DW_DLA_LIST);
+    held_llbuf = 0;
+    held_count = 0;
+}
+
+static void
+get_stats(Dwarf_Debug dbg, Dwarf_Unsigned *evictions,
+    Dwarf_Unsigned *reloads)
+{
+    Dwarf_Unsigned resident = 0;
+    Dwarf_Unsigned peak = 0;
+    Dwarf_Unsigned evicted_bytes = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    res = dwarf_get_section_memory_stats(dbg, &resident, &peak,
+        evictions, &evicted_bytes, reloads, &error);
+    CHECK(res == DW_DLV_OK);
+}
+
+int
+main(int argc, char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Unsigned reference = 0;
+    Dwarf_Unsigned sum = 0;
+    Dwarf_Unsigned evictions = 0;
+    Dwarf_Unsigned reloads = 0;
+    Dwarf_Unsigned evictable = 0;
+    Dwarf_Unsigned loc_loads = 0;
+
+    /*  No budget: nothing is ever evicted. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    reference = sum_everything(dbg);
+    get_stats(dbg, &evictions, &reloads);
+    CHECK(evictions == 0);
+    CHECK(reloads == 0);
+    evictable = section_size(dbg, ".debug_loc") +
+        section_size(dbg, ".debug_macro") +
+        section_size(dbg, ".debug_str_offsets") +
+        section_size(dbg, ".debug_ranges") +
+        section_size(dbg, ".debug_aranges");
+    CHECK(section_size(dbg, ".debug_loc") != 0);
+    CHECK(section_size(dbg, ".debug_ranges") != 0);
+    dwarf_finish(dbg, &error);
+
+    /*  A one byte budget keeps at most one evictable
+        section loaded, yet every answer is the same. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    sum = sum_everything(dbg);
+    CHECK(sum == reference);
+    sum = sum_everything(dbg);
+    CHECK(sum == reference);
+    get_stats(dbg, &evictions, &reloads);
+    CHECK(evictions > 0);
+    CHECK(reloads > 0);
+    dwarf_finish(dbg, &error);
+
+    /*  Only the evictable sections count, so a budget
+        holding all of them evicts nothing however big
+        .debug_info and the rest are. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_set_section_memory_budget(dbg, evictable,
+        &error) == DW_DLV_OK);
+    sum = sum_everything(dbg);
+    CHECK(sum == reference);
+    get_stats(dbg, &evictions, &reloads);
+    CHECK(evictions == 0);
+    dwarf_finish(dbg, &error);
+
+    /*  dwarf_get_loclist_entry() returns a pointer into
+        .debug_loc with no dealloc, so that section must
+        stay loaded from then on. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    {
+        Dwarf_Addr hipc = 0;
+        Dwarf_Addr lopc = 0;
+        Dwarf_Ptr data = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Unsigned next = 0;
+        unsigned char copy[64];
+        int res = 0;
+
+        /*  Skip entries with an empty expression. */
+        CHECK(have_loclist_offset);
+        next = first_loclist_offset;
+        do {
+            res = dwarf_get_loclist_entry(dbg, next, &hipc, &lopc,
+                &data, &len, &next, &error);
+        } while (res == DW_DLV_OK && !len);
+        CHECK(res == DW_DLV_OK);
+        if (res == DW_DLV_OK) {
+            if (len > sizeof(copy)) {
+                len = sizeof(copy);
+            }
+            memcpy(copy, data, len);
+            sum = sum_everything(dbg);
+            CHECK(sum == reference);
+            CHECK(memcmp(copy, data, len) == 0);
+        }
+    }
+    dwarf_finish(dbg, &error);
+
+    /*  A Dwarf_Locdesc from dwarf_loclist_n() may point
+        into .debug_loc, which then stays loaded, but
+        only till the list is dealloc'd. */
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    CHECK(dwarf_set_section_memory_budget(dbg, 1, &error) ==
+        DW_DLV_OK);
+    hold_old_loclist = 1;
+    sum = sum_everything(dbg);
+    hold_old_loclist = 0;
+    CHECK(sum == reference);
+    CHECK(held_llbuf != 0);
+    loc_loads = loc_load_count(dbg);
+    CHECK(loc_loads > 0);
+    sum = sum_everything(dbg);
+    CHECK(sum == reference);
+    CHECK(loc_load_count(dbg) == loc_loads);
+    if (held_llbuf) {
+        free_held_loclist(dbg);
+    }
+    sum = sum_everything(dbg);
+    CHECK(sum == reference);
+    CHECK(loc_load_count(dbg) > loc_loads);
+    dwarf_finish(dbg, &error);
+
+    return test_report("test_section_budget");
+}
@@ -0,0 +1,243 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Builds a CU whose DW_FORM_strp names end one another
+    ("loop_counter", "op_counter", "counter", "nter"),
+    with and without dwarf_pro_set_string_tail_merge(),
+    and reads it back.
+    Every DIE must read back its own name either way.
+    With tail merging the strings that end a longer one
+    must be gone from .debug_str, which must be exactly
+    the remaining strings; without it every distinct
+    name must be there once.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+
+static int failcount = 0;
+
+static void
+check(int cond, const char *msg, int line)
+{
+    if (!cond) {
+        printf("FAIL line %d: %s\n", line, msg);
+        ++failcount;
+    }
+}
+#define CHECK(c) check((c), #c, __LINE__)
+
+/*  In DIE order after the CU DIE, which is "main.c".
+    "counter" is used twice to check interning as well.
+    Names shorter than a .debug_str offset are always
+    written as DW_FORM_string, so none is used here. */
+static const char *dienames[] = {
+    "counter", "loop_counter", "nter", "op_counter", "loop",
+    "event_counter", "counter", 0 };
+
+/*  Not the tail of any other name. */
+static const char *kept[] = {
+    "main.c", "loop_counter", "loop", "event_counter", 0 };
+
+/*  Every distinct name. */
+static const char *distinct[] = {
+    "main.c", "counter", "loop_counter", "nter", "op_counter",
+    "loop", "event_counter", 0 };
+
+static void
+produce(struct test_prodobj_s *po, int merge)
+{
+    Dwarf_P_Debug pdbg = 0;
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die die = 0;
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Error error = 0;
+    int i = 0;
+
+    if (dwarf_producer_init(DW_DLC_WRITE | DW_DLC_POINTER64 |
+        DW_DLC_OFFSET32 | DW_DLC_SYMBOLIC_RELOCATIONS |
+        DW_DLC_TARGET_LITTLEENDIAN, test_prodobj_callback, 0, 0,
+        po, "x86_64", "V4", 0, &pdbg, &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init\n");
+        exit(1);
+    }
+    CHECK(dwarf_pro_set_default_string_form(pdbg, DW_FORM_strp,
+        &error) == DW_DLV_OK);
+    CHECK(dwarf_pro_set_string_tail_merge(pdbg, merge, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_new_die_a(pdbg, DW_TAG_compile_unit, 0, 0, 0, 0,
+        &cu, &error) == DW_DLV_OK);
+    CHECK(dwarf_add_AT_name_a(cu, "main.c", &attr, &error) ==
+        DW_DLV_OK);
+    for (i = 0; dienames[i]; ++i) {
+        CHECK(dwarf_new_die_a(pdbg, DW_TAG_variable, cu, 0, 0, 0,
+            &die, &error) == DW_DLV_OK);
+        CHECK(dwarf_add_AT_name_a(die, (char *)dienames[i], &attr,
+            &error) == DW_DLV_OK);
+    }
+    CHECK(dwarf_add_die_to_debug_a(pdbg, cu, &error) == DW_DLV_OK);
+    if (dwarf_transform_to_disk_form_a(pdbg, &count, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_transform_to_disk_form_a\n");
+        exit(1);
+    }
+    CHECK(test_prodobj_collect(po, pdbg, count) == DW_DLV_OK);
+    dwarf_producer_finish_a(pdbg, &error);
+}
+
+static int
+in_list(const char **list, const char *s)
+{
+    for ( ; *list; ++list) {
+        if (!strcmp(*list, s)) {
+            return 1;
+        }
+    }
+    return 0;
+}
+
+/*  The names must read back in order, all DW_FORM_strp. */
+static void
+check_names(Dwarf_Debug dbg)
+{
+    Dwarf_Unsigned next_cu = 0;
+    Dwarf_Die cu = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Error error = 0;
+    char *name = 0;
+    int i = 0;
+    int res = 0;
+
+    res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        &next_cu, 0, &error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL no CU read back\n");
+        exit(1);
+    }
+    CHECK(dwarf_siblingof_b(dbg, 0, 1, &cu, &error) == DW_DLV_OK);
+    CHECK(dwarf_diename(cu, &name, &error) == DW_DLV_OK);
+    CHECK(!strcmp(name, "main.c"));
+    CHECK(dwarf_child(cu, &die, &error) == DW_DLV_OK);
+    for (i = 0; die; ++i) {
+        Dwarf_Die sib = 0;
+        Dwarf_Attribute attr = 0;
+        Dwarf_Half form = 0;
+
+        CHECK(dienames[i] != 0);
+        if (!dienames[i]) {
+            dwarf_dealloc_die(die);
+            break;
+        }
+        CHECK(dwarf_attr(die, DW_AT_name, &attr, &error) ==
+            DW_DLV_OK);
+        CHECK(dwarf_whatform(attr, &form, &error) == DW_DLV_OK);
+        CHECK(form == DW_FORM_strp);
+        dwarf_dealloc_attribute(attr);
+        CHECK(dwarf_diename(die, &name, &error) == DW_DLV_OK);
+        if (strcmp(name, dienames[i])) {
+            printf("FAIL DIE %d named %s, not %s\n", i, name,
+                dienames[i]);
+            ++failcount;
+        }
+        res = dwarf_siblingof_b(dbg, die, 1, &sib, &error);
+        CHECK(res != DW_DLV_ERROR);
+        dwarf_dealloc_die(die);
+        die = (res == DW_DLV_OK)? sib : 0;
+    }
+    CHECK(dienames[i] == 0);
+    dwarf_dealloc_die(cu);
+}
+
+/*  .debug_str must hold each string of expected once
+    and nothing else. */
+static void
+check_debug_str(Dwarf_Debug dbg, const char **expected)
+{
+    Dwarf_Off off = 0;
+    Dwarf_Unsigned total = 0;
+    int seen = 0;
+    int n = 0;
+    char *s = 0;
+    Dwarf_Signed len = 0;
+    Dwarf_Error error = 0;
+
+    for (n = 0; expected[n]; ++n) {
+        total += strlen(expected[n]) + 1;
+    }
+    while (dwarf_get_str(dbg, off, &s, &len, &error) == DW_DLV_OK) {
+        if (!in_list(expected, s)) {
+            printf("FAIL unexpected .debug_str string %s\n", s);
+            ++failcount;
+        }
+        ++seen;
+        off += len + 1;
+    }
+    CHECK(seen == n);
+    CHECK(off == total);
+}
+
+static void
+run(int merge)
+{
+    struct test_prodobj_s po;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+
+    memset(&po, 0, sizeof(po));
+    produce(&po, merge);
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL cannot read back the producer output\n");
+        exit(1);
+    }
+    check_names(dbg);
+    check_debug_str(dbg, merge? kept : distinct);
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+}
+
+int
+main(void)
+{
+    run(0);
+    run(1);
+    if (failcount) {
+        printf("FAIL test_str_tail_merge, %d failures\n", failcount);
+        exit(1);
+    }
+    printf("PASS test_str_tail_merge\n");
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Reads testobjO2DW4.elf and resolves every line table
+    address (and the byte after each) with one
+    dwarf_symbolize_pcs() call, the pcs given out of
+    order and each twice.  Each result must name the
+    innermost frame dwarf_inline_frames() reports and
+    the line of the row a linear scan of the line tables
+    finds covering the pc: the last row starting at or
+    before it whose successor starts after it.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+#define MAXCUS  16
+#define MAXPCS  4096
+
+struct cu_lines_s {
+    Dwarf_Line_Context cl_context;
+    Dwarf_Line        *cl_lines;
+    Dwarf_Signed       cl_count;
+};
+
+static struct cu_lines_s cus[MAXCUS];
+static int cucount = 0;
+
+/*  Loads the line table of every CU and collects its
+    addresses and the byte after each. */
+static Dwarf_Unsigned
+load_lines(Dwarf_Debug dbg, Dwarf_Addr *pcs)
+{
+    Dwarf_Unsigned n = 0;
+    Dwarf_Error error = 0;
+
+    for (;;) {
+        Dwarf_Die cu_die = 0;
+        Dwarf_Unsigned version = 0;
+        Dwarf_Small table_count = 0;
+        struct cu_lines_s *cl = cus + cucount;
+        Dwarf_Signed i = 0;
+        int res = 0;
+
+        res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0,
+            0, 0, 0, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        if (dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) !=
+            DW_DLV_OK) {
+            CHECK(0);
+            break;
+        }
+        if (cucount < MAXCUS &&
+            dwarf_srclines_b(cu_die, &version, &table_count,
+            &cl->cl_context, &error) == DW_DLV_OK) {
+            CHECK(dwarf_srclines_from_linecontext(cl->cl_context,
+                &cl->cl_lines, &cl->cl_count, &error) == DW_DLV_OK);
+            for (i = 0; i < cl->cl_count && n + 2 <= MAXPCS; ++i) {
+                Dwarf_Addr addr = 0;
+
+                CHECK(dwarf_lineaddr(cl->cl_lines[i], &addr,
+                    &error) == DW_DLV_OK);
+                pcs[n++] = addr;
+                pcs[n++] = addr + 1;
+            }
+            ++cucount;
+        }
+        dwarf_dealloc_die(cu_die);
+    }
+    return n;
+}
+
+/*  The row covering pc, the long way round. */
+static Dwarf_Line
+reference_row(Dwarf_Addr pc)
+{
+    Dwarf_Line best = 0;
+    Dwarf_Addr bestaddr = 0;
+    Dwarf_Error error = 0;
+    int c = 0;
+
+    for (c = 0; c < cucount; ++c) {
+        struct cu_lines_s *cl = cus + c;
+        Dwarf_Signed i = 0;
+
+        for (i = 0; i + 1 < cl->cl_count; ++i) {
+            Dwarf_Addr addr = 0;
+            Dwarf_Addr next = 0;
+            Dwarf_Bool end = 0;
+
+            CHECK(dwarf_lineendsequence(cl->cl_lines[i], &end,
+                &error) == DW_DLV_OK);
+            CHECK(dwarf_lineaddr(cl->cl_lines[i], &addr,
+                &error) == DW_DLV_OK);
+            CHECK(dwarf_lineaddr(cl->cl_lines[i+1], &next,
+                &error) == DW_DLV_OK);
+            if (end || next <= addr || pc < addr || pc >= next) {
+                continue;
+            }
+            if (!best || addr >= bestaddr) {
+                best = cl->cl_lines[i];
+                bestaddr = addr;
+            }
+        }
+    }
+    return best;
+}
+
+static void
+compare_result(Dwarf_Debug dbg, Dwarf_Addr pc,
+    Dwarf_Symbolized_Pc *sp, int *with_function)
+{
+    Dwarf_Inline_Frame frame;
+    Dwarf_Unsigned framecount = 0;
+    Dwarf_Line row = 0;
+    Dwarf_Error error = 0;
+    int fres = 0;
+
+    memset(&frame, 0, sizeof(frame));
+    fres = dwarf_inline_frames(dbg, pc, &frame, 1, &framecount,
+        &error);
+    CHECK(fres != DW_DLV_ERROR);
+    row = reference_row(pc);
+    if (fres != DW_DLV_OK && !row) {
+        CHECK(sp->sp_status == DW_DLV_NO_ENTRY);
+        CHECK(sp->sp_function == 0);
+        CHECK(sp->sp_file == 0);
+        CHECK(sp->sp_line == 0);
+        return;
+    }
+    CHECK(sp->sp_status == DW_DLV_OK);
+    if (fres == DW_DLV_OK) {
+        ++*with_function;
+        CHECK(sp->sp_function_die_offset == frame.if_die_offset);
+        CHECK(sp->sp_cu_die_offset == frame.if_cu_die_offset);
+        CHECK(sp->sp_function_lowpc == frame.if_lowpc);
+        CHECK(sp->sp_function && frame.if_name &&
+            !strcmp(sp->sp_function, frame.if_name));
+    } else {
+        CHECK(sp->sp_function == 0);
+    }
+    if (row) {
+        Dwarf_Unsigned line = 0;
+        Dwarf_Unsigned column = 0;
+        char *file = 0;
+
+        CHECK(dwarf_lineno(row, &line, &error) == DW_DLV_OK);
+        CHECK(dwarf_lineoff_b(row, &column, &error) == DW_DLV_OK);
+        CHECK(dwarf_linesrc(row, &file, &error) == DW_DLV_OK);
+        CHECK(sp->sp_line == line);
+        CHECK(sp->sp_column == column);
+        CHECK(sp->sp_file && file &&
+            !strcmp(sp->sp_file, file));
+        dwarf_dealloc(dbg, file, DW_DLA_STRING);
+    } else {
+        CHECK(sp->sp_file == 0);
+        CHECK(sp->sp_line == 0);
+    }
+}
+
+int
+main(int argc, char **argv)
+{
+    static Dwarf_Addr pcs[MAXPCS];
+    static Dwarf_Addr query[2*MAXPCS + 2];
+    static Dwarf_Symbolized_Pc results[2*MAXPCS + 2];
+    Dwarf_Debug dbg = 0;
+    Dwarf_Unsigned pccount = 0;
+    Dwarf_Unsigned qcount = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Error error = 0;
+    int with_function = 0;
+    int c = 0;
+
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    pccount = load_lines(dbg, pcs);
+    CHECK(pccount > 0);
+
+    /*  Descending, then ascending, then two addresses
+        nothing covers. */
+    for (i = pccount; i > 0; --i) {
+        query[qcount++] = pcs[i-1];
+    }
+    for (i = 0; i < pccount; ++i) {
+        query[qcount++] = pcs[i];
+    }
+    query[qcount++] = 0;
+    query[qcount++] = ~(Dwarf_Addr)0;
+    memset(results, 0, sizeof(results));
+    CHECK(dwarf_symbolize_pcs(dbg, query, qcount, results,
+        &error) == DW_DLV_OK);
+
+    for (i = 0; i < qcount; ++i) {
+        compare_result(dbg, query[i], results + i, &with_function);
+    }
+    /*  A repeated pc gets the same answer. */
+    for (i = 0; i < pccount; ++i) {
+        Dwarf_Symbolized_Pc *a = results + pccount - 1 - i;
+        Dwarf_Symbolized_Pc *b = results + pccount + i;
+
+        CHECK(a->sp_function == b->sp_function);
+        CHECK(a->sp_file == b->sp_file);
+        CHECK(a->sp_line == b->sp_line);
+    }
+    CHECK(results[qcount-2].sp_status == DW_DLV_NO_ENTRY);
+    CHECK(results[qcount-1].sp_status == DW_DLV_NO_ENTRY);
+    CHECK(with_function > 0);
+    CHECK(dwarf_symbolize_pcs(dbg, query, 0, results, &error) ==
+        DW_DLV_OK);
+
+    for (c = 0; c < cucount; ++c) {
+        dwarf_srclines_dealloc_b(cus[c].cl_context);
+    }
+    dwarf_finish(dbg, &error);
+    return test_report("test_symbolize");
+}
@@ -0,0 +1,406 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Builds a CU with repeated type subtrees, with and
+    without dwarf_pro_set_type_dedup(), and reads the
+    output back through the consumer.  With dedup the
+    variables that used identical copies must reference
+    one DIE, which must still be the right type; a
+    differing struct and a struct with a DIE marker must
+    stay separate; and every DW_AT_type in the CU must
+    reference the offset of a type DIE.  Without dedup
+    every copy must remain.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+
+static int failcount = 0;
+
+static void
+check(int cond, const char *msg, int line)
+{
+    if (!cond) {
+        printf("FAIL line %d: %s\n", line, msg);
+        ++failcount;
+    }
+}
+#define CHECK(c) check((c), #c, __LINE__)
+
+static Dwarf_P_Debug pdbg;
+
+static Dwarf_P_Die
+new_die(Dwarf_Half tag, Dwarf_P_Die parent, const char *name)
+{
+    Dwarf_P_Die die = 0;
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_new_die_a(pdbg, tag, parent, 0, 0, 0, &die,
+        &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_new_die_a\n");
+        exit(1);
+    }
+    if (name && dwarf_add_AT_name_a(die, (char *)name, &attr,
+        &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_add_AT_name_a %s\n", name);
+        exit(1);
+    }
+    return die;
+}
+
+static void
+add_ref(Dwarf_P_Die die, Dwarf_Half attrnum, Dwarf_P_Die target)
+{
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_add_AT_reference_c(pdbg, die, attrnum, target,
+        &attr, &error) == DW_DLV_OK);
+}
+
+static void
+add_const(Dwarf_P_Die die, Dwarf_Half attrnum, Dwarf_Unsigned val)
+{
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_add_AT_unsigned_const_a(pdbg, die, attrnum, val,
+        &attr, &error) == DW_DLV_OK);
+}
+
+static Dwarf_P_Die
+new_int(Dwarf_P_Die cu)
+{
+    Dwarf_P_Die die = new_die(DW_TAG_base_type, cu, "int");
+
+    add_const(die, DW_AT_byte_size, 4);
+    add_const(die, DW_AT_encoding, DW_ATE_signed);
+    return die;
+}
+
+/*  struct name { int member; } */
+static Dwarf_P_Die
+new_struct(Dwarf_P_Die cu, const char *name, const char *member,
+    Dwarf_P_Die inttype)
+{
+    Dwarf_P_Die st = new_die(DW_TAG_structure_type, cu, name);
+    Dwarf_P_Die mem = new_die(DW_TAG_member, st, member);
+
+    add_const(st, DW_AT_byte_size, 4);
+    add_ref(mem, DW_AT_type, inttype);
+    return st;
+}
+
+/*  struct List { struct List *next; } and the pointer,
+    which is returned. */
+static Dwarf_P_Die
+new_list(Dwarf_P_Die cu)
+{
+    Dwarf_P_Die st = new_die(DW_TAG_structure_type, cu, "List");
+    Dwarf_P_Die mem = new_die(DW_TAG_member, st, "next");
+    Dwarf_P_Die ptr = new_die(DW_TAG_pointer_type, cu, 0);
+
+    add_const(st, DW_AT_byte_size, 8);
+    add_const(ptr, DW_AT_byte_size, 8);
+    add_ref(ptr, DW_AT_type, st);
+    add_ref(mem, DW_AT_type, ptr);
+    return ptr;
+}
+
+static void
+new_var(Dwarf_P_Die cu, const char *name, Dwarf_P_Die type)
+{
+    Dwarf_P_Die var = new_die(DW_TAG_variable, cu, name);
+
+    add_ref(var, DW_AT_type, type);
+}
+
+static void
+produce(struct test_prodobj_s *po, int dedup)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die int_a = 0;
+    Dwarf_P_Die int_b = 0;
+    Dwarf_P_Die marked = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_producer_init(DW_DLC_WRITE | DW_DLC_POINTER64 |
+        DW_DLC_OFFSET32 | DW_DLC_SYMBOLIC_RELOCATIONS |
+        DW_DLC_TARGET_LITTLEENDIAN, test_prodobj_callback, 0, 0,
+        po, "x86_64", "V4", 0, &pdbg, &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init\n");
+        exit(1);
+    }
+    CHECK(dwarf_pro_set_type_dedup(pdbg, dedup, &error) ==
+        DW_DLV_OK);
+    cu = new_die(DW_TAG_compile_unit, 0, "t.c");
+    int_a = new_int(cu);
+    int_b = new_int(cu);
+    /*  The two S merge only once the two ints have. */
+    new_var(cu, "s1", new_struct(cu, "S", "x", int_a));
+    new_var(cu, "s2", new_struct(cu, "S", "x", int_b));
+    new_var(cu, "t1", new_struct(cu, "S", "y", int_a));
+    marked = new_struct(cu, "S", "x", int_a);
+    CHECK(dwarf_add_die_marker_a(pdbg, marked, 1, &error) ==
+        DW_DLV_OK);
+    new_var(cu, "m1", marked);
+    new_var(cu, "l1", new_list(cu));
+    new_var(cu, "l2", new_list(cu));
+    CHECK(dwarf_add_die_to_debug_a(pdbg, cu, &error) == DW_DLV_OK);
+    if (dwarf_transform_to_disk_form_a(pdbg, &count, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_transform_to_disk_form_a\n");
+        exit(1);
+    }
+    CHECK(test_prodobj_collect(po, pdbg, count) == DW_DLV_OK);
+    dwarf_producer_finish_a(pdbg, &error);
+}
+
+static int
+is_type_tag(Dwarf_Half tag)
+{
+    return tag == DW_TAG_base_type || tag == DW_TAG_structure_type ||
+        tag == DW_TAG_pointer_type;
+}
+
+/*  The target of DW_AT_type of die, which must
+    be a type DIE. 0 if there is none. */
+static Dwarf_Off
+type_of(Dwarf_Debug dbg, Dwarf_Die die)
+{
+    Dwarf_Attribute attr = 0;
+    Dwarf_Off off = 0;
+    Dwarf_Die target = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_attr(die, DW_AT_type, &attr, &error) != DW_DLV_OK) {
+        return 0;
+    }
+    CHECK(dwarf_global_formref(attr, &off, &error) == DW_DLV_OK);
+    dwarf_dealloc_attribute(attr);
+    if (dwarf_offdie_b(dbg, off, 1, &target, &error) != DW_DLV_OK) {
+        printf("FAIL DW_AT_type 0x%lx is not a DIE\n",
+            (unsigned long)off);
+        ++failcount;
+        return 0;
+    }
+    CHECK(dwarf_tag(target, &tag, &error) == DW_DLV_OK);
+    CHECK(is_type_tag(tag));
+    dwarf_dealloc_die(target);
+    return off;
+}
+
+static Dwarf_Die
+die_at(Dwarf_Debug dbg, Dwarf_Off off)
+{
+    Dwarf_Die die = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_offdie_b(dbg, off, 1, &die, &error) != DW_DLV_OK) {
+        printf("FAIL no DIE at 0x%lx\n", (unsigned long)off);
+        exit(1);
+    }
+    return die;
+}
+
+static int
+name_is(Dwarf_Die die, const char *name)
+{
+    char *n = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_diename(die, &n, &error) != DW_DLV_OK) {
+        return 0;
+    }
+    return !strcmp(n, name);
+}
+
+/*  The DW_AT_type of the first child. */
+static Dwarf_Off
+member_type(Dwarf_Debug dbg, Dwarf_Off structoff, const char *member)
+{
+    Dwarf_Die st = die_at(dbg, structoff);
+    Dwarf_Die mem = 0;
+    Dwarf_Error error = 0;
+    Dwarf_Off off = 0;
+
+    CHECK(dwarf_child(st, &mem, &error) == DW_DLV_OK);
+    if (mem) {
+        CHECK(name_is(mem, member));
+        off = type_of(dbg, mem);
+        dwarf_dealloc_die(mem);
+    }
+    dwarf_dealloc_die(st);
+    return off;
+}
+
+#define MAXVARS 8
+struct var_s {
+    const char *v_name;
+    Dwarf_Off   v_type;
+};
+
+/*  Checks every DW_AT_type under the CU, and records the
+    type of each variable and how many structs there are. */
+static void
+read_back(Dwarf_Debug dbg, struct var_s *vars, int *nstructs)
+{
+    Dwarf_Unsigned next_cu = 0;
+    Dwarf_Die cu = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    *nstructs = 0;
+    res = dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        &next_cu, 0, &error);
+    if (res != DW_DLV_OK) {
+        printf("FAIL no CU read back\n");
+        exit(1);
+    }
+    CHECK(dwarf_siblingof_b(dbg, 0, 1, &cu, &error) == DW_DLV_OK);
+    CHECK(dwarf_child(cu, &die, &error) == DW_DLV_OK);
+    while (die) {
+        Dwarf_Die sib = 0;
+        Dwarf_Half tag = 0;
+        Dwarf_Die mem = 0;
+
+        CHECK(dwarf_tag(die, &tag, &error) == DW_DLV_OK);
+        if (tag == DW_TAG_variable) {
+            int i = 0;
+
+            for ( ; i < MAXVARS && vars[i].v_name; ++i) {
+                if (name_is(die, vars[i].v_name)) {
+                    vars[i].v_type = type_of(dbg, die);
+                }
+            }
+        } else {
+            type_of(dbg, die);
+        }
+        if (tag == DW_TAG_structure_type) {
+            ++*nstructs;
+        }
+        if (dwarf_child(die, &mem, &error) == DW_DLV_OK) {
+            type_of(dbg, mem);
+            dwarf_dealloc_die(mem);
+        }
+        res = dwarf_siblingof_b(dbg, die, 1, &sib, &error);
+        CHECK(res != DW_DLV_ERROR);
+        dwarf_dealloc_die(die);
+        die = (res == DW_DLV_OK)? sib : 0;
+    }
+    dwarf_dealloc_die(cu);
+}
+
+static void
+run(int dedup)
+{
+    struct test_prodobj_s po;
+    struct var_s vars[MAXVARS] = {
+        {"s1",0}, {"s2",0}, {"t1",0}, {"m1",0},
+        {"l1",0}, {"l2",0}, {0,0}, {0,0} };
+    Dwarf_Debug dbg = 0;
+    Dwarf_Error error = 0;
+    int nstructs = 0;
+    int i = 0;
+
+    memset(&po, 0, sizeof(po));
+    produce(&po, dedup);
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL cannot read back the producer output\n");
+        exit(1);
+    }
+    read_back(dbg, vars, &nstructs);
+    for (i = 0; vars[i].v_name; ++i) {
+        CHECK(vars[i].v_type != 0);
+        if (!vars[i].v_type) {
+            printf("FAIL dedup %d: %s has no type\n", dedup,
+                vars[i].v_name);
+            exit(1);
+        }
+    }
+    /* s1 s2 t1 m1 are struct S, l1 l2 pointers. */
+    for (i = 0; i < 4; ++i) {
+        Dwarf_Die st = die_at(dbg, vars[i].v_type);
+
+        CHECK(name_is(st, "S"));
+        dwarf_dealloc_die(st);
+    }
+    CHECK(member_type(dbg, vars[0].v_type, "x") != 0);
+    CHECK(member_type(dbg, vars[2].v_type, "y") != 0);
+    CHECK(vars[0].v_type != vars[2].v_type);
+    CHECK(vars[0].v_type != vars[3].v_type);
+    if (dedup) {
+        Dwarf_Off ptr = vars[4].v_type;
+        Dwarf_Die pdie = die_at(dbg, ptr);
+        Dwarf_Off list = type_of(dbg, pdie);
+
+        dwarf_dealloc_die(pdie);
+        /* S, S with y, the marked S and List. */
+        CHECK(nstructs == 4);
+        CHECK(vars[0].v_type == vars[1].v_type);
+        CHECK(member_type(dbg, vars[0].v_type, "x") ==
+            member_type(dbg, vars[2].v_type, "y"));
+        CHECK(vars[4].v_type == vars[5].v_type);
+        /* The kept List points back at the kept pointer. */
+        CHECK(list != 0);
+        CHECK(member_type(dbg, list, "next") == ptr);
+    } else {
+        CHECK(nstructs == 6);
+        CHECK(vars[0].v_type != vars[1].v_type);
+        CHECK(member_type(dbg, vars[0].v_type, "x") !=
+            member_type(dbg, vars[1].v_type, "x"));
+        CHECK(vars[4].v_type != vars[5].v_type);
+    }
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+}
+
+int
+main(void)
+{
+    run(0);
+    run(1);
+    if (failcount) {
+        printf("FAIL test_type_dedup, %d failures\n", failcount);
+        exit(1);
+    }
+    printf("PASS test_type_dedup\n");
+    return 0;
+}
@@ -0,0 +1,336 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Builds a C CU whose variables have array, pointer and
+    function pointer types, in the shapes compilers emit
+    them, and checks the declarations dwarf_type_name()
+    formats for them.  A qualifier on an array qualifies
+    its elements, so it must print on the element type,
+    once.  */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_prodobj.h"
+#include "test_consumer.h"
+
+static Dwarf_P_Debug pdbg;
+
+struct expect_s {
+    const char *e_var;
+    const char *e_type;
+};
+
+static const struct expect_s expected[] = {
+    {"cpa",   "char *const [3][2]"},
+    {"ccpa",  "const char *const [3][2]"},
+    {"ca",    "const char[4]"},
+    {"cca",   "const char[4]"},
+    {"fpa",   "int (*[4])(int)"},
+    {"cfpa",  "int (*const [4])(int)"},
+    {"pa",    "int (*)[4]"},
+    {"pca",   "const int (*)[4]"},
+    {"ppa",   "int (**)[4]"},
+    {"fpra",  "int (*(*)(void))[4]"},
+    {0, 0} };
+
+static Dwarf_P_Die
+new_die(Dwarf_Half tag, Dwarf_P_Die parent, const char *name)
+{
+    Dwarf_P_Die die = 0;
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_new_die_a(pdbg, tag, parent, 0, 0, 0, &die,
+        &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_new_die_a\n");
+        exit(1);
+    }
+    if (name && dwarf_add_AT_name_a(die, (char *)name, &attr,
+        &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_add_AT_name_a %s\n", name);
+        exit(1);
+    }
+    return die;
+}
+
+static void
+add_ref(Dwarf_P_Die die, Dwarf_Half attrnum, Dwarf_P_Die target)
+{
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_add_AT_reference_c(pdbg, die, attrnum, target,
+        &attr, &error) == DW_DLV_OK);
+}
+
+static void
+add_const(Dwarf_P_Die die, Dwarf_Half attrnum, Dwarf_Unsigned val)
+{
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_add_AT_unsigned_const_a(pdbg, die, attrnum, val,
+        &attr, &error) == DW_DLV_OK);
+}
+
+static Dwarf_P_Die
+new_base(Dwarf_P_Die cu, const char *name, Dwarf_Unsigned size,
+    Dwarf_Unsigned encoding)
+{
+    Dwarf_P_Die die = new_die(DW_TAG_base_type, cu, name);
+
+    add_const(die, DW_AT_byte_size, size);
+    add_const(die, DW_AT_encoding, encoding);
+    return die;
+}
+
+/*  A pointer, const or other type modifier of target. */
+static Dwarf_P_Die
+new_mod(Dwarf_P_Die cu, Dwarf_Half tag, Dwarf_P_Die target)
+{
+    Dwarf_P_Die die = new_die(tag, cu, 0);
+
+    if (tag == DW_TAG_pointer_type) {
+        add_const(die, DW_AT_byte_size, 8);
+    }
+    if (target) {
+        add_ref(die, DW_AT_type, target);
+    }
+    return die;
+}
+
+/*  An array of elem with one or two dimensions
+    (dim2 zero for one). */
+static Dwarf_P_Die
+new_array(Dwarf_P_Die cu, Dwarf_P_Die elem, Dwarf_Unsigned dim1,
+    Dwarf_Unsigned dim2)
+{
+    Dwarf_P_Die arr = new_die(DW_TAG_array_type, cu, 0);
+    Dwarf_P_Die sub = new_die(DW_TAG_subrange_type, arr, 0);
+
+    add_ref(arr, DW_AT_type, elem);
+    add_const(sub, DW_AT_upper_bound, dim1 - 1);
+    if (dim2) {
+        sub = new_die(DW_TAG_subrange_type, arr, 0);
+        add_const(sub, DW_AT_upper_bound, dim2 - 1);
+    }
+    return arr;
+}
+
+/*  A prototyped function type returning ret, taking
+    one param or none. */
+static Dwarf_P_Die
+new_func(Dwarf_P_Die cu, Dwarf_P_Die ret, Dwarf_P_Die param)
+{
+    Dwarf_P_Die fn = new_die(DW_TAG_subroutine_type, cu, 0);
+    Dwarf_P_Attribute attr = 0;
+    Dwarf_Error error = 0;
+
+    CHECK(dwarf_add_AT_flag_a(pdbg, fn, DW_AT_prototyped, 1,
+        &attr, &error) == DW_DLV_OK);
+    add_ref(fn, DW_AT_type, ret);
+    if (param) {
+        Dwarf_P_Die p = new_die(DW_TAG_formal_parameter, fn, 0);
+
+        add_ref(p, DW_AT_type, param);
+    }
+    return fn;
+}
+
+static void
+new_var(Dwarf_P_Die cu, const char *name, Dwarf_P_Die type)
+{
+    Dwarf_P_Die var = new_die(DW_TAG_variable, cu, name);
+
+    add_ref(var, DW_AT_type, type);
+}
+
+static void
+produce(struct test_prodobj_s *po)
+{
+    Dwarf_P_Die cu = 0;
+    Dwarf_P_Die chr = 0;
+    Dwarf_P_Die cchr = 0;
+    Dwarf_P_Die intt = 0;
+    Dwarf_P_Die cint = 0;
+    Dwarf_P_Die cptr = 0;
+    Dwarf_P_Die fptr = 0;
+    Dwarf_P_Die int4 = 0;
+    Dwarf_P_Die ppa = 0;
+    Dwarf_Signed count = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_producer_init(DW_DLC_WRITE | DW_DLC_POINTER64 |
+        DW_DLC_OFFSET32 | DW_DLC_SYMBOLIC_RELOCATIONS |
+        DW_DLC_TARGET_LITTLEENDIAN, test_prodobj_callback, 0, 0,
+        po, "x86_64", "V4", 0, &pdbg, &error) != DW_DLV_OK) {
+        printf("FAIL dwarf_producer_init\n");
+        exit(1);
+    }
+    cu = new_die(DW_TAG_compile_unit, 0, "t.c");
+    add_const(cu, DW_AT_language, DW_LANG_C99);
+    chr = new_base(cu, "char", 1, DW_ATE_signed_char);
+    cchr = new_mod(cu, DW_TAG_const_type, chr);
+    intt = new_base(cu, "int", 4, DW_ATE_signed);
+    cint = new_mod(cu, DW_TAG_const_type, intt);
+
+    /*  char *const cpa[3][2] as GCC emits it, the const
+        on both the array and its elements. */
+    cptr = new_mod(cu, DW_TAG_const_type,
+        new_mod(cu, DW_TAG_pointer_type, chr));
+    new_var(cu, "cpa", new_mod(cu, DW_TAG_const_type,
+        new_array(cu, cptr, 3, 2)));
+    /*  const char *const ccpa[3][2] */
+    new_var(cu, "ccpa", new_mod(cu, DW_TAG_const_type,
+        new_array(cu, new_mod(cu, DW_TAG_const_type,
+        new_mod(cu, DW_TAG_pointer_type, cchr)), 3, 2)));
+    /*  const char ca[4], the const only on the array. */
+    new_var(cu, "ca", new_mod(cu, DW_TAG_const_type,
+        new_array(cu, chr, 4, 0)));
+    /*  const char cca[4], the const on both. */
+    new_var(cu, "cca", new_mod(cu, DW_TAG_const_type,
+        new_array(cu, cchr, 4, 0)));
+    /*  int (*fpa[4])(int) and the const array of them. */
+    fptr = new_mod(cu, DW_TAG_pointer_type,
+        new_func(cu, intt, intt));
+    new_var(cu, "fpa", new_array(cu, fptr, 4, 0));
+    new_var(cu, "cfpa", new_mod(cu, DW_TAG_const_type,
+        new_array(cu, fptr, 4, 0)));
+    /*  int (*pa)[4] and const int (*pca)[4], the const on
+        the array. */
+    int4 = new_array(cu, intt, 4, 0);
+    new_var(cu, "pa", new_mod(cu, DW_TAG_pointer_type, int4));
+    new_var(cu, "pca", new_mod(cu, DW_TAG_pointer_type,
+        new_mod(cu, DW_TAG_const_type, new_array(cu, cint, 4, 0))));
+    /*  int (**ppa)[4] */
+    ppa = new_mod(cu, DW_TAG_pointer_type,
+        new_mod(cu, DW_TAG_pointer_type, int4));
+    new_var(cu, "ppa", ppa);
+    /*  int (*(*fpra)(void))[4], a pointer to a function
+        returning a pointer to an array. */
+    new_var(cu, "fpra", new_mod(cu, DW_TAG_pointer_type,
+        new_func(cu, new_mod(cu, DW_TAG_pointer_type, int4), 0)));
+    CHECK(dwarf_add_die_to_debug_a(pdbg, cu, &error) == DW_DLV_OK);
+    if (dwarf_transform_to_disk_form_a(pdbg, &count, &error) !=
+        DW_DLV_OK) {
+        printf("FAIL dwarf_transform_to_disk_form_a\n");
+        exit(1);
+    }
+    CHECK(test_prodobj_collect(po, pdbg, count) == DW_DLV_OK);
+    dwarf_producer_finish_a(pdbg, &error);
+}
+
+/*  The formatted type of the variable var_die. */
+static void
+check_var(Dwarf_Debug dbg, Dwarf_Die var_die, int *seen)
+{
+    char *name = 0;
+    Dwarf_Off typeoff = 0;
+    const char *tname = 0;
+    Dwarf_Error error = 0;
+    int i = 0;
+
+    CHECK(dwarf_diename(var_die, &name, &error) == DW_DLV_OK);
+    CHECK(dwarf_dietype_offset(var_die, &typeoff, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_type_name(dbg, typeoff, 1, &tname,
+        &error) == DW_DLV_OK);
+    if (!name || !tname) {
+        return;
+    }
+    for (i = 0; expected[i].e_var; ++i) {
+        if (strcmp(name, expected[i].e_var)) {
+            continue;
+        }
+        ++*seen;
+        if (strcmp(tname, expected[i].e_type)) {
+            printf("FAIL %s is \"%s\", not \"%s\"\n", name, tname,
+                expected[i].e_type);
+            CHECK(0);
+        }
+    }
+}
+
+int
+main(void)
+{
+    struct test_prodobj_s po;
+    Dwarf_Debug dbg = 0;
+    Dwarf_Die cu_die = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Error error = 0;
+    int seen = 0;
+    int nexpected = 0;
+
+    memset(&po, 0, sizeof(po));
+    produce(&po);
+    if (test_prodobj_open(&po, &dbg) != DW_DLV_OK) {
+        printf("FAIL cannot read back the producer output\n");
+        exit(1);
+    }
+    CHECK(dwarf_next_cu_header_d(dbg, 1, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 0, &error) == DW_DLV_OK);
+    CHECK(dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error) ==
+        DW_DLV_OK);
+    if (cu_die && dwarf_child(cu_die, &die, &error) == DW_DLV_OK) {
+        for (;;) {
+            Dwarf_Half tag = 0;
+            Dwarf_Die sib = 0;
+
+            CHECK(dwarf_tag(die, &tag, &error) == DW_DLV_OK);
+            if (tag == DW_TAG_variable) {
+                check_var(dbg, die, &seen);
+            }
+            if (dwarf_siblingof_b(dbg, die, 1, &sib, &error) !=
+                DW_DLV_OK) {
+                break;
+            }
+            dwarf_dealloc_die(die);
+            die = sib;
+        }
+        dwarf_dealloc_die(die);
+    }
+    if (cu_die) {
+        dwarf_dealloc_die(cu_die);
+    }
+    while (expected[nexpected].e_var) {
+        ++nexpected;
+    }
+    CHECK(seen == nexpected);
+    dwarf_finish(dbg, &error);
+    test_prodobj_free(&po);
+    return test_report("test_type_name");
+}
@@ -0,0 +1,177 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+/*  Checks dwarf_get_unit_directory() against the unit
+    headers dwarf_next_cu_header_d() reads, for a DWARF4
+    object and one with DWARF5 skeleton units (which carry
+    a dwo_id), and that listing the units midway through
+    a dwarf_next_cu_header_d() walk does not move it. */
+
+#include "config.h"
+#include <stdio.h>
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+static void
+check_unit(Dwarf_Debug dbg, Dwarf_Unit_Entry *ue, Dwarf_Off offset,
+    Dwarf_Unsigned length, Dwarf_Half version, Dwarf_Off abbrev,
+    Dwarf_Half address_size, Dwarf_Half length_size,
+    Dwarf_Half extension_size, Dwarf_Sig8 *signature,
+    Dwarf_Unsigned typeoffset, Dwarf_Half unit_type)
+{
+    Dwarf_Die cu_die = 0;
+    Dwarf_Die die = 0;
+    Dwarf_Off die_offset = 0;
+    Dwarf_Half tag = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    CHECK(ue->ue_offset == offset);
+    CHECK(ue->ue_length == length);
+    CHECK(ue->ue_version == version);
+    CHECK(ue->ue_abbrev_offset == abbrev);
+    CHECK(ue->ue_address_size == address_size);
+    CHECK(ue->ue_length_size == length_size);
+    CHECK(ue->ue_extension_size == extension_size);
+    CHECK(ue->ue_unit_type == unit_type);
+    if (version >= 5 && unit_type == DW_UT_skeleton) {
+        CHECK(ue->ue_has_signature);
+        CHECK(!memcmp(&ue->ue_signature, signature,
+            sizeof(Dwarf_Sig8)));
+        CHECK(ue->ue_type_offset == typeoffset);
+    } else if (version < 5) {
+        CHECK(!ue->ue_has_signature);
+    }
+
+    /*  ue_die_offset is where the unit DIE is. */
+    res = dwarf_siblingof_b(dbg, 0, 1, &cu_die, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        res = dwarf_dieoffset(cu_die, &die_offset, &error);
+        CHECK(res == DW_DLV_OK);
+        CHECK(die_offset == ue->ue_die_offset);
+        dwarf_dealloc_die(cu_die);
+    }
+    res = dwarf_offdie_b(dbg, ue->ue_die_offset, 1, &die, &error);
+    CHECK(res == DW_DLV_OK);
+    if (res == DW_DLV_OK) {
+        res = dwarf_tag(die, &tag, &error);
+        CHECK(res == DW_DLV_OK);
+        CHECK(tag == DW_TAG_compile_unit ||
+            tag == DW_TAG_skeleton_unit);
+        dwarf_dealloc_die(die);
+    }
+}
+
+static void
+check_object(Dwarf_Debug dbg, Dwarf_Half expect_version)
+{
+    Dwarf_Unit_Entry *units = 0;
+    Dwarf_Unit_Entry *again = 0;
+    Dwarf_Unsigned count = 0;
+    Dwarf_Unsigned again_count = 0;
+    Dwarf_Unsigned i = 0;
+    Dwarf_Off offset = 0;
+    Dwarf_Error error = 0;
+    int res = 0;
+
+    if (!dbg) {
+        return;
+    }
+    res = dwarf_get_unit_directory(dbg, 1, &units, &count,
+        &error);
+    CHECK(res == DW_DLV_OK);
+    if (res != DW_DLV_OK) {
+        dwarf_finish(dbg, &error);
+        return;
+    }
+    CHECK(count > 0);
+    /*  Neither object has .debug_types. */
+    CHECK(dwarf_get_unit_directory(dbg, 0, &again, &again_count,
+        &error) == DW_DLV_NO_ENTRY);
+
+    for (i = 0; ; ++i) {
+        Dwarf_Unsigned length = 0;
+        Dwarf_Half version = 0;
+        Dwarf_Off abbrev = 0;
+        Dwarf_Half address_size = 0;
+        Dwarf_Half length_size = 0;
+        Dwarf_Half extension_size = 0;
+        Dwarf_Sig8 signature;
+        Dwarf_Unsigned typeoffset = 0;
+        Dwarf_Unsigned next = 0;
+        Dwarf_Half unit_type = 0;
+
+        memset(&signature, 0, sizeof(signature));
+        res = dwarf_next_cu_header_d(dbg, 1, &length, &version,
+            &abbrev, &address_size, &length_size, &extension_size,
+            &signature, &typeoffset, &next, &unit_type, &error);
+        if (res != DW_DLV_OK) {
+            CHECK(res == DW_DLV_NO_ENTRY);
+            break;
+        }
+        CHECK(i < count);
+        if (i >= count) {
+            break;
+        }
+        CHECK(version == expect_version);
+        check_unit(dbg, units + i, offset, length, version, abbrev,
+            address_size, length_size, extension_size, &signature,
+            typeoffset, unit_type);
+        offset = next;
+        if (i == 0) {
+            /*  Midway through the walk the list is the same
+                and the walk carries on from here. */
+            res = dwarf_get_unit_directory(dbg, 1, &again,
+                &again_count, &error);
+            CHECK(res == DW_DLV_OK);
+            if (res == DW_DLV_OK) {
+                CHECK(again_count == count);
+                CHECK(again_count != count || !memcmp(again, units,
+                    count * sizeof(Dwarf_Unit_Entry)));
+                dwarf_dealloc_unit_directory(again);
+            }
+        }
+    }
+    CHECK(i == count);
+    dwarf_dealloc_unit_directory(units);
+    dwarf_finish(dbg, &error);
+}
+
+int
+main(int argc, char **argv)
+{
+    check_object(test_open_fixture(argc, argv, 1,
+        "testobjO2DW4.elf"), 4);
+    check_object(test_open_fixture(argc, argv, 2,
+        "testobjsplit.elf"), 5);
+    return test_report("test_unit_directory");
+}
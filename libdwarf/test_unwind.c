@@ -0,0 +1,291 @@
+/*
+Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.  */
+
+/*  Reads the .eh_frame of testobjO2DW4.elf and builds a
+    synthetic x86_64 stack through several of its
+    functions: for each frame the CFA and the return
+    address slot come from the rows
+    dwarf_get_fde_info_for_cfa_reg3_b() and
+    dwarf_get_fde_info_for_reg3_b() report, looked up at
+    the pc itself for the innermost frame and at pc-1
+    for return addresses.  dwarf_unwind_stack() must
+    walk back exactly those pcs, with and without its
+    row cache, with a load bias, and cut short by
+    max_depth or a missing stack pointer. */
+
+#include "config.h"
+#include <stdio.h>
+#ifdef HAVE_STDLIB_H
+#include <stdlib.h>
+#endif /* HAVE_STDLIB_H */
+#include <string.h>
+#include "dwarf.h"
+#include "libdwarf.h"
+#include "test_consumer.h"
+
+/* x86_64 DWARF register numbers. */
+#define REG_SP   7
+#define REG_RA   16
+#define REGCOUNT 17
+
+#define MAXFRAMES 6
+#define STACKTOP  0x7fff0000
+
+struct memword_s {
+    Dwarf_Addr     mw_addr;
+    Dwarf_Unsigned mw_value;
+};
+
+/*  The return address slots of the synthetic stack,
+    the only memory it has. */
+struct stack_s {
+    struct memword_s st_words[MAXFRAMES];
+    unsigned         st_count;
+};
+
+static int
+read_memory(void *user_data, Dwarf_Addr addr, Dwarf_Unsigned size,
+    Dwarf_Unsigned *value_out)
+{
+    struct stack_s *st = (struct stack_s *)user_data;
+    unsigned i = 0;
+
+    if (size != 8) {
+        return DW_DLV_NO_ENTRY;
+    }
+    for (i = 0; i < st->st_count; ++i) {
+        if (st->st_words[i].mw_addr == addr) {
+            *value_out = st->st_words[i].mw_value;
+            return DW_DLV_OK;
+        }
+    }
+    return DW_DLV_NO_ENTRY;
+}
+
+/*  Sets the CFA offset from the stack pointer and the
+    return address offset from the CFA at pc.  Returns
+    0 unless both are plain offsets of that kind. */
+static int
+simple_row(Dwarf_Fde *fde_data, Dwarf_Addr pc,
+    Dwarf_Signed *cfa_off, Dwarf_Signed *ra_off)
+{
+    Dwarf_Fde fde = 0;
+    Dwarf_Addr low = 0;
+    Dwarf_Addr high = 0;
+    Dwarf_Small value_type = 0;
+    Dwarf_Signed offset_relevant = 0;
+    Dwarf_Signed reg = 0;
+    Dwarf_Ptr block = 0;
+    Dwarf_Addr row_pc = 0;
+    Dwarf_Bool more = 0;
+    Dwarf_Addr next_pc = 0;
+    Dwarf_Error error = 0;
+
+    if (dwarf_get_fde_at_pc(fde_data, pc, &fde, &low, &high,
+        &error) != DW_DLV_OK) {
+        return 0;
+    }
+    if (dwarf_get_fde_info_for_cfa_reg3_b(fde, pc, &value_type,
+        &offset_relevant, &reg, cfa_off, &block, &row_pc, &more,
+        &next_pc, &error) != DW_DLV_OK ||
+        value_type != DW_EXPR_OFFSET || !offset_relevant ||
+        reg != REG_SP) {
+        return 0;
+    }
+    if (dwarf_get_fde_info_for_reg3_b(fde, REG_RA, pc, &value_type,
+        &offset_relevant, &reg, ra_off, &block, &row_pc, &more,
+        &next_pc, &error) != DW_DLV_OK ||
+        value_type != DW_EXPR_OFFSET || !offset_relevant) {
+        return 0;
+    }
+    return 1;
+}
+
+/*  Picks, from distinct FDEs, pcs whose rows simple_row()
+    accepts, and lays out the stack of a call chain
+    through them, innermost first.  Returns the frame
+    count. */
+static unsigned
+build_stack(Dwarf_Debug dbg, Dwarf_Addr bias, Dwarf_Addr *chain,
+    struct stack_s *st)
+{
+    Dwarf_Cie *cie_data = 0;
+    Dwarf_Signed cie_count = 0;
+    Dwarf_Fde *fde_data = 0;
+    Dwarf_Signed fde_count = 0;
+    Dwarf_Signed i = 0;
+    Dwarf_Signed cfa_off[MAXFRAMES];
+    Dwarf_Signed ra_off[MAXFRAMES];
+    Dwarf_Addr sp = STACKTOP;
+    Dwarf_Error error = 0;
+    unsigned n = 0;
+    unsigned f = 0;
+
+    if (dwarf_get_fde_list_eh(dbg, &cie_data, &cie_count, &fde_data,
+        &fde_count, &error) != DW_DLV_OK) {
+        printf("FAIL no .eh_frame FDEs\n");
+        exit(1);
+    }
+    for (i = 0; i < fde_count && n < MAXFRAMES; ++i) {
+        Dwarf_Addr low = 0;
+        Dwarf_Unsigned len = 0;
+        Dwarf_Ptr bytes = 0;
+        Dwarf_Unsigned bytelen = 0;
+        Dwarf_Off cie_off = 0;
+        Dwarf_Signed cie_index = 0;
+        Dwarf_Off fde_off = 0;
+        Dwarf_Addr pc = 0;
+
+        CHECK(dwarf_get_fde_range(fde_data[i], &low, &len, &bytes,
+            &bytelen, &cie_off, &cie_index, &fde_off, &error) ==
+            DW_DLV_OK);
+        if (len < 8) {
+            continue;
+        }
+        /*  The middle of the function, past any
+            prologue pushes. */
+        pc = low + len/2;
+        if (!simple_row(fde_data, n? pc-1 : pc, &cfa_off[n],
+            &ra_off[n])) {
+            continue;
+        }
+        chain[n++] = pc + bias;
+    }
+    memset(st, 0, sizeof(*st));
+    for (f = 0; f < n; ++f) {
+        Dwarf_Addr cfa = sp + cfa_off[f];
+        struct memword_s *w = st->st_words + st->st_count++;
+
+        w->mw_addr = cfa + ra_off[f];
+        /* The outermost frame returns to zero. */
+        w->mw_value = f+1 < n? chain[f+1] : 0;
+        sp = cfa;
+    }
+    dwarf_fde_cie_list_dealloc(dbg, cie_data, cie_count, fde_data,
+        fde_count);
+    return n;
+}
+
+static Dwarf_Unsigned
+unwind(Dwarf_Unwinder uw, struct stack_s *st, Dwarf_Addr pc,
+    int sp_valid, Dwarf_Unsigned max_depth, Dwarf_Addr *pcs)
+{
+    Dwarf_Unwind_Callbacks cb;
+    Dwarf_Unsigned regs[REGCOUNT];
+    Dwarf_Small valid[REGCOUNT];
+    Dwarf_Unsigned count = 0;
+    Dwarf_Error error = 0;
+
+    memset(&cb, 0, sizeof(cb));
+    cb.uc_user_data = st;
+    cb.uc_read_memory = read_memory;
+    memset(regs, 0, sizeof(regs));
+    memset(valid, 0, sizeof(valid));
+    regs[REG_SP] = STACKTOP;
+    valid[REG_SP] = (Dwarf_Small)sp_valid;
+    CHECK(dwarf_unwind_stack(uw, &cb, pc, regs, valid, REGCOUNT,
+        max_depth, pcs, &count, &error) == DW_DLV_OK);
+    return count;
+}
+
+static void
+check_walk(Dwarf_Unwinder uw, struct stack_s *st,
+    const Dwarf_Addr *chain, unsigned n)
+{
+    Dwarf_Addr pcs[MAXFRAMES + 2];
+    Dwarf_Unsigned count = 0;
+    unsigned f = 0;
+
+    memset(pcs, 0, sizeof(pcs));
+    count = unwind(uw, st, chain[0], 1, MAXFRAMES + 2, pcs);
+    CHECK(count == n);
+    for (f = 0; f < n && f < count; ++f) {
+        CHECK(pcs[f] == chain[f]);
+    }
+    /*  Cut short by max_depth. */
+    memset(pcs, 0, sizeof(pcs));
+    CHECK(unwind(uw, st, chain[0], 1, 2, pcs) == 2);
+    CHECK(pcs[0] == chain[0]);
+    CHECK(pcs[1] == chain[1]);
+    CHECK(pcs[2] == 0);
+    /*  Without a stack pointer there is no CFA. */
+    CHECK(unwind(uw, st, chain[0], 0, MAXFRAMES, pcs) == 1);
+    CHECK(pcs[0] == chain[0]);
+}
+
+int
+main(int argc, char **argv)
+{
+    Dwarf_Debug dbg = 0;
+    Dwarf_Unwinder uw = 0;
+    Dwarf_Unwinder nocache = 0;
+    Dwarf_Addr chain[MAXFRAMES];
+    Dwarf_Addr pcs[MAXFRAMES];
+    struct stack_s st;
+    Dwarf_Unsigned hits = 0;
+    Dwarf_Unsigned misses = 0;
+    Dwarf_Addr bias = 0x10000000;
+    Dwarf_Error error = 0;
+    unsigned n = 0;
+
+    dbg = test_open_fixture(argc, argv, 1, "testobjO2DW4.elf");
+    n = build_stack(dbg, 0, chain, &st);
+    CHECK(n >= 3);
+    if (n < 3) {
+        printf("FAIL test_unwind, too few usable FDEs\n");
+        exit(1);
+    }
+    CHECK(dwarf_unwinder_create(dbg, REG_SP, 64, &uw, &error) ==
+        DW_DLV_OK);
+    CHECK(dwarf_unwinder_create(dbg, REG_SP, 0, &nocache, &error) ==
+        DW_DLV_OK);
+
+    check_walk(uw, &st, chain, n);
+    dwarf_unwinder_stats(uw, &hits, &misses);
+    CHECK(misses > 0);
+    CHECK(hits > 0);
+    check_walk(nocache, &st, chain, n);
+    dwarf_unwinder_stats(nocache, &hits, &misses);
+    CHECK(hits == 0);
+
+    /*  The same stack in a mapping relocated by bias. */
+    n = build_stack(dbg, bias, chain, &st);
+    dwarf_unwinder_set_load_bias(uw, bias);
+    check_walk(uw, &st, chain, n);
+
+    /*  No FDE covers the pc: just the pc itself. */
+    CHECK(unwind(uw, &st, bias + 1, 1, MAXFRAMES, pcs) == 1);
+    CHECK(pcs[0] == bias + 1);
+
+    dwarf_unwinder_dealloc(nocache);
+    dwarf_unwinder_dealloc(uw);
+    dwarf_finish(dbg, &error);
+    return test_report("test_unwind");
+}
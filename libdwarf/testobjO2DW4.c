@@ -0,0 +1,102 @@
+/*  This is the source of testobjO2DW4.elf, the object
+    the libdwarf check programs read.  It was built
+    on Linux x86_64 with gcc 12.2 as
+        gcc -O2 -gdwarf-4 -o testobjO2DW4.elf testobjO2DW4.c
+    so it has location lists in .debug_loc,
+    non-contiguous lexical blocks and inlined
+    subroutines described through .debug_ranges,
+    and a .debug_aranges.
+    The DWARF5 objects testobjO2DW5.elf and
+    testobjO2DW5split.elf, with testobjO2DW5split.dwo,
+    come from this same source, built in /tmp/dw5 as
+        gcc -O2 -gdwarf-5 -o testobjO2DW5.elf testobjO2DW4.c
+        gcc -c -O2 -gdwarf-5 -gsplit-dwarf \
+            -o testobjO2DW5split.o testobjO2DW4.c
+        gcc -o testobjO2DW5split.elf testobjO2DW5split.o
+    They have .debug_loclists and .debug_rnglists
+    instead, the split one with DW_FORM_rnglistx and
+    DW_FORM_loclistx lists in the .dwo whose addresses
+    are in the executable's .debug_addr.
+    These leading comments mean a recompile would
+    not exactly match line numbers in the DWARF. */
+#include <stdio.h>
+#include <stdlib.h>
+
+static int __attribute__((noinline))
+helper(int x)
+{
+    if (x > 1000) {
+        printf("big\n");
+        abort();
+    }
+    return x*3;
+}
+
+static inline int
+inner(int x, int i)
+{
+    if (i%7 == 3) {
+        return helper(i);
+    }
+    return x ^ i;
+}
+
+static inline int
+middle(int x)
+{
+    int r = 0;
+    int i = 0;
+
+    for (i = 0; i < x; i++) {
+        r += inner(r, i);
+    }
+    return r;
+}
+
+int
+work(int n)
+{
+    int s = 0;
+    int i = 0;
+
+    for (i = 0; i < n; i++) {
+        s += middle(i);
+        if (s < 0) {
+            fprintf(stderr, "neg\n");
+            exit(2);
+        }
+    }
+    return s;
+}
+
+__attribute__((cold)) void
+coldf(void)
+{
+    puts("cold");
+}
+
+int
+other(int a)
+{
+    int t = 0;
+    int i = 0;
+
+    for (i = 0; i < a; i++) {
+        if (i&1) {
+            t += i;
+        } else {
+            t -= a;
+        }
+    }
+    return t;
+}
+
+int
+main(int argc, char **argv)
+{
+    (void)argv;
+    if (argc > 5) {
+        coldf();
+    }
+    return (work(argc*10) + other(argc)) & 0xff;
+}
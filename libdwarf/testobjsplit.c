@@ -0,0 +1,36 @@
+/*  This is the source of testobjsplit.elf and its
+    testobjsplit1.dwo, testobjsplit2.dwo and
+    testobjsplit3.dwo, split DWARF without a .dwp for
+    the libdwarf check programs.  Each .dwo is the same
+    source built with a different PART.  It was built
+    on Linux x86_64 with gcc 12.2 as
+        for p in 1 2 3; do
+            gcc -O0 -gdwarf-5 -gsplit-dwarf -DPART=$p \
+                -c testobjsplit.c -o testobjsplit$p.o
+        done
+        gcc -o testobjsplit.elf testobjsplit1.o \
+            testobjsplit2.o testobjsplit3.o */
+
+#if PART == 1
+int part2(int);
+int part3(int);
+
+int
+main(int argc, char **argv)
+{
+    (void)argv;
+    return part2(argc) + part3(argc);
+}
+#elif PART == 2
+int
+part2(int x)
+{
+    return x*2;
+}
+#else
+int
+part3(int x)
+{
+    return x*3;
+}
+#endif
@@ -17,6 +17,8 @@
 
 /* Define to 1 if tsearch is based on the red-black algorithm. */
 /* #define TSEARCH_USE_RED 1 */
+/* Define to 1 if tsearch is based on the open addressing hash. */
+/* #define TSEARCH_USE_FLAT 1 */
 
 /* Assuming we have stdint.h and it has uintptr_t.
     Not intended to work everywhere, the tsearch
@@ -54,6 +54,8 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "dwarf_tsearchhash.c"
 #elif defined(TSEARCH_USE_RED)
 #include "dwarf_tsearchred.c"
+#elif defined(TSEARCH_USE_FLAT)
+#include "dwarf_tsearchflat.c"
 #else
 #error Missing tsearch algorithm
 #endif
@@ -0,0 +1,509 @@
+/* Copyright (C) 2026 The libdwarf contributors. All Rights Reserved.
+
+Redistribution and use in source and binary forms, with
+or without modification, are permitted provided that the
+following conditions are met:
+
+    Redistributions of source code must retain the above
+    copyright notice, this list of conditions and the following
+    disclaimer.
+
+    Redistributions in binary form must reproduce the above
+    copyright notice, this list of conditions and the following
+    disclaimer in the documentation and/or other materials
+    provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND
+CONTRIBUTORS "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES
+OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR
+CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL,
+SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT
+NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION)
+HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE,
+EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+/*  The interfaces follow tsearch (See the Single
+    Unix Specification) but the implementation is
+    written without reference to the source of any
+    version of tsearch or any hashing code.
+
+    Like dwarf_tsearchhash.c this is a hash table
+    (called a tree below, but that is a misnomer)
+    and needs dwarf_initialize_search_hash() to
+    supply the hash function.
+
+    Collision resolution is by open addressing
+    with linear probing.  The key pointers are held
+    inline in one array, so no space is allocated per
+    record, and a parallel array holds one tag byte
+    per slot: empty, deleted, or 0x80 plus seven bits
+    of the hash.  Probing scans the tag bytes, which are
+    contiguous, and only calls the comparison function
+    when a tag matches, so a lookup rarely touches a
+    key it does not want.
+    Plain bytes are compared rather than SIMD groups
+    to keep this portable C.
+
+    The table size is a power of two.  The user hash is
+    multiplied by a 64 bit constant (Fibonacci hashing)
+    and the top bits pick the slot, so weak hash functions
+    (such as returning the key value) still spread well.
+
+    As with the chained hash, a pointer returned by
+    dwarf_tsearch() or dwarf_tfind() is only good until
+    the next insertion or deletion, which may move
+    records.
+
+    twalk() and tdestroy() walk in a random order.
+    The 'preorder' etc labels mean nothing in a hash,
+    so everything is called a leaf.
+*/
+
+
+#include "config.h"
+#ifdef HAVE_UNUSED_ATTRIBUTE
+#define  UNUSEDARG __attribute__ ((unused))
+#else
+#define  UNUSEDARG
+#endif
+#include "stdlib.h" /* for free() etc */
+#include <stdio.h>  /* for printf() */
+#ifdef HAVE_STDINT_H
+#include <stdint.h> /* for uintptr_t */
+#endif /* HAVE_STDINT_H */
+/*  This must match the types and print options
+    found in libdwarf.h.  */
+#define Dwarf_Unsigned unsigned long long
+#if defined(_WIN32) && defined(HAVE_NONSTANDARD_PRINTF_64_FORMAT)
+#define DW_PR_DUx "I64x"
+#define DW_PR_DUu "I64u"
+#else
+#define DW_PR_DUx "llx"
+#define DW_PR_DUu "llu"
+#endif /* DW_PR defines */
+#include "dwarf_tsearch.h"
+
+#define FL_EMPTY   0
+#define FL_DELETED 1
+#define FL_USED    0x80
+
+#define FL_MIN_BITS 6
+/*  Largest table, 2^FL_MAX_BITS slots, but also
+    leaving room in an unsigned long. */
+#define FL_MAX_BITS ((sizeof(unsigned long)*8 - 2) < 40? \
+    (unsigned)(sizeof(unsigned long)*8 - 2):40)
+
+/*  2^64 divided by the golden ratio. */
+#define FL_MULTIPLIER 0x9e3779b97f4a7c15ULL
+
+struct fl_base {
+    /* tablesize_ is 1 << tablebits_ */
+    unsigned long tablesize_;
+    unsigned tablebits_;
+    /* Number of active records. */
+    unsigned long record_count_;
+    /* Number of FL_DELETED slots. */
+    unsigned long deleted_count_;
+    /*  Grow (or clean out deleted slots) before
+        record_count_+deleted_count_ exceeds this,
+        3/4 of the table. */
+    unsigned long allowed_fill_;
+    unsigned char *tags_;
+    const void **keys_;
+    DW_TSHASHTYPE (*hashfunc_)(const void *key);
+};
+
+static unsigned long
+fl_slot_of(const struct fl_base *h, Dwarf_Unsigned mixed)
+{
+    return (unsigned long)(mixed >> (64 - h->tablebits_));
+}
+
+static unsigned char
+fl_tag_of(const struct fl_base *h, Dwarf_Unsigned mixed)
+{
+    /*  The seven bits below those picking the slot,
+        so records colliding in a run seldom share a tag. */
+    return (unsigned char)(FL_USED |
+        ((mixed >> (64 - h->tablebits_ - 7)) & 0x7f));
+}
+
+static Dwarf_Unsigned
+fl_mix(const struct fl_base *h, const void *key)
+{
+    Dwarf_Unsigned v = (Dwarf_Unsigned)h->hashfunc_(key);
+
+    return v * FL_MULTIPLIER;
+}
+
+static int
+fl_allocate_table(struct fl_base *h, unsigned bits)
+{
+    unsigned long size = 1UL << bits;
+
+    h->tags_ = (unsigned char *)calloc(size,1);
+    if (!h->tags_) {
+        return 1;
+    }
+    h->keys_ = (const void **)calloc(size,sizeof(const void *));
+    if (!h->keys_) {
+        free(h->tags_);
+        h->tags_ = 0;
+        return 1;
+    }
+    h->tablesize_ = size;
+    h->tablebits_ = bits;
+    h->allowed_fill_ = size - size/4;
+    h->record_count_ = 0;
+    h->deleted_count_ = 0;
+    return 0;
+}
+
+/* Initialize the hash and pass in the hash function.
+   If the entry count needed is unknown, pass in  0 as a count estimate,
+   but if the number of hash entries needed can be estimated,
+   pass in the estimate, the table starts big enough
+   to hold that many without growing.
+   Return the tree base, or return NULL if insufficient memory. */
+void *
+dwarf_initialize_search_hash( void **treeptr,
+    DW_TSHASHTYPE(*hashfunc)(const void *key),
+    unsigned long size_estimate)
+{
+    struct fl_base *base = 0;
+    unsigned bits = FL_MIN_BITS;
+
+    base = *(struct fl_base **)treeptr;
+    if(base) {
+        /* initalized already. */
+        return base ;
+    }
+    while (((1UL << bits) - (1UL << bits)/4) < size_estimate) {
+        if (bits >= FL_MAX_BITS) {
+            /* Oops. Too large. */
+            return NULL;
+        }
+        ++bits;
+    }
+    base = calloc(sizeof(struct fl_base),1);
+    if(!base) {
+        /* Out of memory. */
+        return NULL ;
+    }
+    base->hashfunc_ = hashfunc;
+    if (fl_allocate_table(base,bits)) {
+        free(base);
+        return NULL;
+    }
+    *treeptr = base;
+    return base;
+}
+
+/*  Returns the slot holding key, or if not there
+    the slot an insertion should use (the first
+    deleted slot seen, else the empty slot ending
+    the probe).  *found says which. */
+static unsigned long
+fl_probe(const struct fl_base *h, const void *key,
+    int (*compar)(const void *, const void *),
+    int *found)
+{
+    Dwarf_Unsigned mixed = fl_mix(h,key);
+    unsigned char tag = fl_tag_of(h,mixed);
+    unsigned long mask = h->tablesize_ - 1;
+    unsigned long ix = fl_slot_of(h,mixed);
+    unsigned long reuse = h->tablesize_;
+    unsigned long probes = 0;
+
+    for ( ; probes < h->tablesize_; ++probes, ix = (ix+1) & mask) {
+        unsigned char t = h->tags_[ix];
+
+        if (t == tag) {
+            if (!compar(key,h->keys_[ix])) {
+                *found = 1;
+                return ix;
+            }
+            continue;
+        }
+        if (t == FL_EMPTY) {
+            break;
+        }
+        if (t == FL_DELETED && reuse == h->tablesize_) {
+            reuse = ix;
+        }
+    }
+    *found = 0;
+    if (reuse != h->tablesize_) {
+        return reuse;
+    }
+    /*  The table is never allowed to fill, so
+        the loop ended on an empty slot. */
+    return ix;
+}
+
+/*  Moves every record into a table with 1<<bits slots,
+    dropping deleted slots.  On failure leaves
+    the table as it was and returns 1. */
+static int
+fl_rehash(struct fl_base *h, unsigned bits)
+{
+    struct fl_base newhead;
+    unsigned long ix = 0;
+
+    newhead = *h;
+    if (fl_allocate_table(&newhead,bits)) {
+        return 1;
+    }
+    for (ix = 0; ix < h->tablesize_; ++ix) {
+        Dwarf_Unsigned mixed = 0;
+        unsigned long nx = 0;
+        unsigned long nmask = newhead.tablesize_ - 1;
+
+        if (!(h->tags_[ix] & FL_USED)) {
+            continue;
+        }
+        mixed = fl_mix(&newhead,h->keys_[ix]);
+        nx = fl_slot_of(&newhead,mixed);
+        while (newhead.tags_[nx] != FL_EMPTY) {
+            nx = (nx+1) & nmask;
+        }
+        newhead.tags_[nx] = fl_tag_of(&newhead,mixed);
+        newhead.keys_[nx] = h->keys_[ix];
+        newhead.record_count_++;
+    }
+    free(h->tags_);
+    free(h->keys_);
+    *h = newhead;
+    return 0;
+}
+
+/*  Makes room for one more record.  Returns 1 if
+    the table is full and cannot be grown. */
+static int
+fl_make_room(struct fl_base *h)
+{
+    unsigned bits = h->tablebits_;
+
+    if (h->record_count_ + h->deleted_count_ < h->allowed_fill_) {
+        return 0;
+    }
+    /*  Mostly deleted slots: clean them out in place
+        rather than doubling. */
+    if (h->record_count_ >= h->tablesize_/2) {
+        ++bits;
+    }
+    if (bits <= FL_MAX_BITS && !fl_rehash(h,bits)) {
+        return 0;
+    }
+    /*  Could not rehash. Carry on while there is
+        at least one empty slot to end a probe. */
+    if (h->record_count_ + h->deleted_count_ + 1 < h->tablesize_) {
+        return 0;
+    }
+    return 1;
+}
+
+/* For debugging */
+void
+dwarf_tdump(const void*headp_in,
+    char *(* keyprint)(const void *),
+    const char *msg)
+{
+    const struct fl_base *h = (const struct fl_base *)headp_in;
+    unsigned long ix = 0;
+    unsigned long maxdisplacement = 0;
+    Dwarf_Unsigned totaldisplacement = 0;
+
+    if(!h) {
+        printf("dumptree null tree ptr : %s\n",msg);
+        return;
+    }
+    printf("dumptree head ptr : 0x%08" DW_PR_DUx
+        " size %"    DW_PR_DUu
+        " entries %" DW_PR_DUu
+        " deleted %" DW_PR_DUu
+        " allowed %" DW_PR_DUu " %s\n",
+        (Dwarf_Unsigned)(uintptr_t)h,
+        (Dwarf_Unsigned)h->tablesize_,
+        (Dwarf_Unsigned)h->record_count_,
+        (Dwarf_Unsigned)h->deleted_count_,
+        (Dwarf_Unsigned)h->allowed_fill_,
+        msg);
+    for (ix = 0; ix < h->tablesize_; ++ix) {
+        unsigned long home = 0;
+        unsigned long displacement = 0;
+
+        if (!(h->tags_[ix] & FL_USED)) {
+            continue;
+        }
+        home = fl_slot_of(h,fl_mix(h,h->keys_[ix]));
+        displacement = (ix - home) & (h->tablesize_ - 1);
+        totaldisplacement += displacement;
+        if (displacement > maxdisplacement) {
+            maxdisplacement = displacement;
+        }
+        printf("[%4lu] tag 0x%02x <keyptr 0x%08" DW_PR_DUx
+            "> <key %s> displacement %lu\n",
+            ix, (unsigned)h->tags_[ix],
+            (Dwarf_Unsigned)(uintptr_t)h->keys_[ix],
+            keyprint(h->keys_[ix]),
+            displacement);
+    }
+    printf("Flat hashtable: %lu of %lu slots used.\n",
+        h->record_count_,h->tablesize_);
+    printf("Flat hashtable: %lu is maximum displacement.\n",
+        maxdisplacement);
+    printf("Flat hashtable: %" DW_PR_DUu " is total displacement.\n",
+        totaldisplacement);
+}
+
+/* Search and, if missing, insert. */
+void *
+dwarf_tsearch(const void *key, void **headin,
+    int (*compar)(const void *, const void *))
+{
+    struct fl_base **rootp = (struct fl_base **)headin;
+    struct fl_base *head = *rootp;
+    unsigned long ix = 0;
+    int found = 0;
+    unsigned char *oldtags = 0;
+
+    if (!head || !head->hashfunc_) {
+        /* something is wrong here, not initialized. */
+        return NULL;
+    }
+    ix = fl_probe(head,key,compar,&found);
+    if (found) {
+        return (void *)&head->keys_[ix];
+    }
+    oldtags = head->tags_;
+    if (fl_make_room(head)) {
+        return NULL;
+    }
+    if (head->tags_ != oldtags) {
+        /*  The table was rebuilt, find
+            the insertion slot again. */
+        ix = fl_probe(head,key,compar,&found);
+    }
+    if (head->tags_[ix] == FL_DELETED) {
+        head->deleted_count_--;
+    }
+    head->tags_[ix] = fl_tag_of(head,fl_mix(head,key));
+    head->keys_[ix] = key;
+    head->record_count_++;
+    return (void *)&head->keys_[ix];
+}
+
+
+/* Search. */
+void *
+dwarf_tfind(const void *key, void *const *rootp,
+    int (*compar)(const void *, const void *))
+{
+    struct fl_base *head = *(struct fl_base *const *)rootp;
+    unsigned long ix = 0;
+    int found = 0;
+
+    if (!head || !head->hashfunc_) {
+        return NULL;
+    }
+    ix = fl_probe(head,key,compar,&found);
+    if (!found) {
+        return NULL;
+    }
+    return (void *)&head->keys_[ix];
+}
+
+/*  Unlike the simple binary tree case,
+    a fully-empty hash situation does not null the *rootp.
+    There is no parent to return, so as in a standard
+    tsearch, returning NULL does not mean failure.
+*/
+void *
+dwarf_tdelete(const void *key, void **rootp,
+    int (*compar)(const void *, const void *))
+{
+    struct fl_base *head = *(struct fl_base **)rootp;
+    unsigned long ix = 0;
+    unsigned long mask = 0;
+    int found = 0;
+
+    if (!head || !head->hashfunc_) {
+        return NULL;
+    }
+    ix = fl_probe(head,key,compar,&found);
+    if (!found) {
+        return NULL;
+    }
+    mask = head->tablesize_ - 1;
+    head->keys_[ix] = 0;
+    head->record_count_--;
+    if (head->tags_[(ix+1) & mask] == FL_EMPTY) {
+        /*  Nothing probes past here, so this slot and
+            any deleted ones before it can be empty. */
+        head->tags_[ix] = FL_EMPTY;
+        ix = (ix - 1) & mask;
+        while (head->tags_[ix] == FL_DELETED) {
+            head->tags_[ix] = FL_EMPTY;
+            head->deleted_count_--;
+            ix = (ix - 1) & mask;
+        }
+    } else {
+        head->tags_[ix] = FL_DELETED;
+        head->deleted_count_++;
+    }
+    return NULL;
+}
+
+void
+dwarf_twalk(const void *rootp,
+    void (*action)(const void *nodep, const DW_VISIT which,
+        UNUSEDARG const int depth))
+{
+    const struct fl_base *head = (const struct fl_base *)rootp;
+    unsigned long ix = 0;
+
+    if(!head) {
+        return;
+    }
+    for (ix = 0; ix < head->tablesize_; ++ix) {
+        if (head->tags_[ix] & FL_USED) {
+            action((void *)(&head->keys_[ix]),dwarf_leaf,0);
+        }
+    }
+}
+
+/*  Walk the tree, freeing all space in the tree
+    and calling the user's callback function on each node.
+
+    It is up to the caller to zero out anything pointing to
+    head (ie, that has the value rootp holds) after this
+    returns.
+*/
+void
+dwarf_tdestroy(void *rootp, void (*free_node)(void *nodep))
+{
+    struct fl_base *head = (struct fl_base *)rootp;
+    unsigned long ix = 0;
+
+    if(!head) {
+        return;
+    }
+    if (free_node) {
+        for (ix = 0; ix < head->tablesize_; ++ix) {
+            if (head->tags_[ix] & FL_USED) {
+                free_node((void *)head->keys_[ix]);
+            }
+        }
+    }
+    free(head->tags_);
+    free(head->keys_);
+    free(head);
+}
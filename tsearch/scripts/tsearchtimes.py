@@ -0,0 +1,59 @@
+#!/usr/bin/env python3
+# Runs each tsearch_tester build on one test and prints
+# lines in the form of tsearchlibtimes.csv:
+#   lib,testcase,usertime,elapsed,maxmem
+# Run from the tsearch directory after 'make all'.
+# Usage:
+#   python3 scripts/tsearchtimes.py testcase [tester args]
+# For example
+#   python3 scripts/tsearchtimes.py rand1m -rand 1000000
+# Each tester runs once as is and once with -byvalue
+# (the -bv rows).
+
+import os
+import subprocess
+import sys
+import time
+
+apps = [("hash", "./hashsearch"),
+        ("flat", "./flatsearch"),
+        ("red", "./redblack"),
+        ("bal", "./balancedsearch"),
+        ("gnu", "./gnusearch"),
+        ("bin", "./binarysearch"),
+        ("epp", "./eppingerdel")]
+
+
+def runone(cmd):
+    start = time.time()
+    with open(os.devnull, "w") as devnull:
+        proc = subprocess.Popen(cmd, stdout=devnull)
+        pid, status, usage = os.wait4(proc.pid, 0)
+    elapsed = time.time() - start
+    if status != 0:
+        print("FAIL", " ".join(cmd), file=sys.stderr)
+    # ru_maxrss is in KB on Linux.
+    return (usage.ru_utime, elapsed, usage.ru_maxrss)
+
+
+def main():
+    if len(sys.argv) < 3:
+        print("Usage: tsearchtimes.py testcase [tester args]",
+              file=sys.stderr)
+        sys.exit(1)
+    testcase = sys.argv[1]
+    args = sys.argv[2:]
+    rows = []
+    for name, app in apps:
+        for bv in (True, False):
+            cmd = [app] + (["-byvalue"] if bv else []) + args
+            lib = name.capitalize() + "-bv" if bv else name
+            u, e, m = runone(cmd)
+            rows.append((u, lib, e, m))
+    rows.sort()
+    for u, lib, e, m in rows:
+        print("%s,%s,%.2f,%.2f,%d" % (lib, testcase, u, e, m))
+
+
+if __name__ == "__main__":
+    main()
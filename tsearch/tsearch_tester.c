@@ -46,6 +46,13 @@ EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
     If -showa is given then extra output is generated identifying
     some some add/delete actions.
 
+    If -rand count is given a generated test of 3*count actions
+    is run, standing in for an input file: count distinct keys
+    in scrambled order are added, every other one deleted and
+    added again, then all deleted.  This gives every
+    implementation the same timing workload without the
+    regression test data.
+
     If -byvalue is given then the tests are run using values not pointes.
     Run like this it is impossible to differentiate whether
     dwarf_tsearch() adds a new tree entry or just finds an existing one.
@@ -1110,6 +1117,78 @@ build_filetest(struct myacts **tout, char *pathout,
 }
 
 
+/*  Multiplying by an odd constant is a bijection
+    on 32 bit values, so keys are distinct but
+    arrive in no useful order. */
+static unsigned
+randtest_key(unsigned long i)
+{
+    return (unsigned)(((i+1) * 2654435761UL) & 0xffffffffUL);
+}
+
+static int
+build_randtest(struct myacts **tout, char *pathout,
+    unsigned long count)
+{
+    unsigned long i = 0;
+    unsigned long ixout = 0;
+    struct myacts *recordacts = 0;
+
+    /* Leave zeroed entry (at least one) at the end. */
+    recordacts = calloc(sizeof(struct myacts),count*3+2);
+    if (!recordacts) {
+        fprintf(stderr,"Unable to allocate %lu actions\n",count*3);
+        return 1;
+    }
+    for (i = 0; i < count; ++i) {
+        recordacts[ixout].action_ = 'a';
+        recordacts[ixout].addr_ = randtest_key(i);
+        ++ixout;
+    }
+    for (i = 0; i < count; i += 2) {
+        recordacts[ixout].action_ = 'd';
+        recordacts[ixout].addr_ = randtest_key(i);
+        ++ixout;
+    }
+    for (i = 0; i < count; i += 2) {
+        recordacts[ixout].action_ = 'a';
+        recordacts[ixout].addr_ = randtest_key(i);
+        ++ixout;
+    }
+    for (i = count; i > 0; --i) {
+        recordacts[ixout].action_ = 'd';
+        recordacts[ixout].addr_ = randtest_key(i-1);
+        ++ixout;
+    }
+    *tout = recordacts;
+    snprintf(pathout,2000,"random %lu",count);
+    return 0;
+}
+
+static int
+fill_in_randtest(const char *countstr)
+{
+    unsigned long count = 0;
+
+    if (getaddr(countstr,&count) || !count ||
+        count > 0xffffffffUL/4) {
+        fprintf(stderr,"Improper -rand count %s\n",countstr);
+        return 1;
+    }
+    if(!filetest1) {
+        return build_randtest(&filetest1,filetest1name,count);
+    } else if(!filetest2) {
+        return build_randtest(&filetest2,filetest2name,count);
+    } else if(!filetest3) {
+        return build_randtest(&filetest3,filetest3name,count);
+    } else if(!filetest4) {
+        return build_randtest(&filetest4,filetest4name,count);
+    }
+    printf("Exceeded limit on input files. -rand %s ignored\n",
+        countstr);
+    return 1;
+}
+
 static int
 fill_in_filetest(const char *filename)
 {
@@ -1143,7 +1222,7 @@ print_usage(const char *a, const char *b,const char *app)
 {
     fprintf(stderr,"%s : %s\n",a,b);
     fprintf(stderr,"run as\n");
-    fprintf(stderr,"  %s [-std] [samplefile]...\n",app);
+    fprintf(stderr,"  %s [-std] [-rand count] [samplefile]...\n",app);
     fprintf(stderr,"By default runs standard tests\n");
     fprintf(stderr,"with pathnames, standard tests are not run\n");
     fprintf(stderr,"unless -std passed in as first arg.\n");
@@ -1179,6 +1258,18 @@ readargs(int argc, char **argv)
             applyby = applybyvalue;
             continue;
         }
+        if(strcmp(a,"-rand") == 0) {
+            if (ix+1 >= argc) {
+                print_usage("Missing count after ",a,argv[0]);
+            }
+            ++ix;
+            defaultstd = 0;
+            if (fill_in_randtest(argv[ix])) {
+                print_usage("Failed in attempting to build ",
+                    "-rand test",argv[0]);
+            }
+            continue;
+        }
         resfail = fill_in_filetest(a);
         defaultstd = 0;
         if(resfail) {